@@ -0,0 +1,258 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by "Unix Makefiles" Generator, CMake Version 3.25
+
+# The generator used is:
+set(CMAKE_DEPENDS_GENERATOR "Unix Makefiles")
+
+# The top level Makefile was generated from the following files:
+set(CMAKE_MAKEFILE_DEPENDS
+  "CMakeCache.txt"
+  "/root/repo/CMakeLists.txt"
+  "CMakeFiles/3.25.1/CMakeCCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeCXXCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "/root/repo/benchmark/CMakeLists.txt"
+  "/root/repo/cmake/ncnnConfig.cmake.in"
+  "/root/repo/cmake/ncnn_add_layer.cmake"
+  "/root/repo/cmake/ncnn_add_shader.cmake"
+  "/root/repo/examples/CMakeLists.txt"
+  "/root/repo/src/CMakeLists.txt"
+  "/root/repo/src/layer_declaration.h.in"
+  "/root/repo/src/layer_registry.h.in"
+  "/root/repo/src/layer_shader_registry.h.in"
+  "/root/repo/src/layer_shader_spv_data.h.in"
+  "/root/repo/src/layer_shader_type_enum.h.in"
+  "/root/repo/src/layer_type_enum.h.in"
+  "/root/repo/src/ncnn.pc.in"
+  "/root/repo/src/platform.h.in"
+  "/root/repo/tests/CMakeLists.txt"
+  "/root/repo/tools/CMakeLists.txt"
+  "/root/repo/tools/caffe/CMakeLists.txt"
+  "/root/repo/tools/darknet/CMakeLists.txt"
+  "/root/repo/tools/mxnet/CMakeLists.txt"
+  "/root/repo/tools/onnx/CMakeLists.txt"
+  "/root/repo/tools/quantize/CMakeLists.txt"
+  "/usr/share/cmake-3.25/Modules/CMakeCInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCXXInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCheckCompilerFlagCommonPatterns.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCommonLanguageInclude.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeGenericSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeInitializeConfigs.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeLanguageInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeParseImplicitLinkInfo.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInitialize.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCCompilerFlag.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCXXCompilerFlag.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCXXSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckIncludeFile.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckLibraryExists.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/CMakeCommonCompilerMacros.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/FindOpenMP.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageHandleStandardArgs.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageMessage.cmake"
+  "/usr/share/cmake-3.25/Modules/FindProtobuf.cmake"
+  "/usr/share/cmake-3.25/Modules/FindThreads.cmake"
+  "/usr/share/cmake-3.25/Modules/GNUInstallDirs.cmake"
+  "/usr/share/cmake-3.25/Modules/GenerateExportHeader.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckCompilerFlag.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckFlagCommonConfig.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/UnixPaths.cmake"
+  "/usr/share/cmake-3.25/Modules/SelectLibraryConfigurations.cmake"
+  "/usr/share/cmake-3.25/Modules/exportheader.cmake.in"
+  )
+
+# The corresponding makefile is:
+set(CMAKE_MAKEFILE_OUTPUTS
+  "Makefile"
+  "CMakeFiles/cmake.check_cache"
+  )
+
+# Byproducts of CMake generate step:
+set(CMAKE_MAKEFILE_PRODUCTS
+  "CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/platform.h"
+  "src/layer_declaration.h"
+  "src/layer_registry.h"
+  "src/layer_type_enum.h"
+  "src/layer_shader_registry.h"
+  "src/layer_shader_spv_data.h"
+  "src/layer_shader_type_enum.h"
+  "src/ncnn_export.h"
+  "src/ncnnConfig.cmake"
+  "src/ncnn.pc"
+  "src/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "benchmark/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "examples/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "tools/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "tools/caffe/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "tools/mxnet/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "tools/onnx/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "tools/darknet/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "tools/quantize/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "tests/CMakeFiles/CMakeDirectoryInformation.cmake"
+  )
+
+# Dependency information for all targets:
+set(CMAKE_DEPEND_INFO_FILES
+  "src/CMakeFiles/ncnn-generate-spirv.dir/DependInfo.cmake"
+  "src/CMakeFiles/ncnn.dir/DependInfo.cmake"
+  "benchmark/CMakeFiles/benchncnn.dir/DependInfo.cmake"
+  "benchmark/CMakeFiles/benchallocator.dir/DependInfo.cmake"
+  "benchmark/CMakeFiles/benchattention.dir/DependInfo.cmake"
+  "benchmark/CMakeFiles/benchpixel.dir/DependInfo.cmake"
+  "benchmark/CMakeFiles/benchmat.dir/DependInfo.cmake"
+  "benchmark/CMakeFiles/benchnuma.dir/DependInfo.cmake"
+  "benchmark/CMakeFiles/benchbatch.dir/DependInfo.cmake"
+  "examples/CMakeFiles/batchserver.dir/DependInfo.cmake"
+  "tools/CMakeFiles/ncnn2mem.dir/DependInfo.cmake"
+  "tools/CMakeFiles/ncnnoptimize.dir/DependInfo.cmake"
+  "tools/CMakeFiles/ncnnmerge.dir/DependInfo.cmake"
+  "tools/caffe/CMakeFiles/caffe2ncnn.dir/DependInfo.cmake"
+  "tools/mxnet/CMakeFiles/mxnet2ncnn.dir/DependInfo.cmake"
+  "tools/onnx/CMakeFiles/onnx2ncnn.dir/DependInfo.cmake"
+  "tools/darknet/CMakeFiles/darknet2ncnn.dir/DependInfo.cmake"
+  "tools/quantize/CMakeFiles/ncnn2table.dir/DependInfo.cmake"
+  "tools/quantize/CMakeFiles/ncnn2mixed.dir/DependInfo.cmake"
+  "tools/quantize/CMakeFiles/ncnn2int8.dir/DependInfo.cmake"
+  "tests/CMakeFiles/ncnntestutil.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_mat_pixel_affine.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_mat_pixel_drawing.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_mat_pixel_rotate.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_mat_pixel_preprocess.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_mat_pixel_resize.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_mat_pixel.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_squeezenet.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_allocator.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_batchserver.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_c_api.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_cpu.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_cpupipelinecache.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_extract_batch.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_mat_normalize.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_profiler.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_absval.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_batchnorm.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_bias.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_binaryop.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_binaryop_1.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_binaryop_2.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_binaryop_3.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_bnll.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_cast.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_celu.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_clip.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_concat.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_concat_oom.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_convolution.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_convolution_1.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_convolution_2.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_convolution_3.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_convolution_oom.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_convolution1d.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_convolution3d.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_convolutiondepthwise.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_convolutiondepthwise_1.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_convolutiondepthwise1d.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_convolutiondepthwise3d.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_copyto.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_copyto_1.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_crop.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_crop_1.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_crop_2.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_cumulativesum.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_deconvolution.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_deconvolution1d.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_deconvolution3d.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_deconvolutiondepthwise.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_deconvolutiondepthwise_1.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_deconvolutiondepthwise1d.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_deconvolutiondepthwise3d.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_deepcopy.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_deformableconv2d.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_deformableconv2d_1.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_deformableconv2d_2.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_deformableconv2d_3.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_deformableconv2d_4.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_dequantize.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_diag.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_dropout.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_einsum.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_eltwise.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_elu.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_embed.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_erf.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_expanddims.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_flatten.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_fold.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_gelu.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_glu.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_gemm.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_gemm_1.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_gemm_2.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_gridsample.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_groupnorm.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_gru.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_hardsigmoid.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_hardswish.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_innerproduct.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_instancenorm.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_interp.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_layernorm.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_lrn.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_lstm.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_matmul.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_memorydata.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_mish.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_multiheadattention.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_multiheadattention_oom.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_noop.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_normalize.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_packing.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_padding.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_permute.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_pixelshuffle.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_pooling.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_pooling1d.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_pooling3d.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_power.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_prelu.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_priorbox.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_quantize.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_reduction.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_relu.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_reorg.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_requantize.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_reshape.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_reshape_1.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_rmsnorm.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_rnn.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_roipooling.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_roialign.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_scale.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_selu.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_shrink.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_shufflechannel.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_sigmoid.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_slice.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_slice_oom.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_softmax.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_softmax_oom.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_softplus.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_squeeze.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_swish.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_tanh.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_tile.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_unaryop.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_unfold.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_yolov3detectionoutput.dir/DependInfo.cmake"
+  )
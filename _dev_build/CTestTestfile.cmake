@@ -0,0 +1,11 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo
+# Build directory: /root/repo/_dev_build
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+subdirs("src")
+subdirs("benchmark")
+subdirs("examples")
+subdirs("tools")
+subdirs("tests")
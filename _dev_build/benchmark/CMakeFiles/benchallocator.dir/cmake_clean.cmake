@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/benchallocator.dir/benchallocator.cpp.o"
+  "CMakeFiles/benchallocator.dir/benchallocator.cpp.o.d"
+  "benchallocator"
+  "benchallocator.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/benchallocator.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/benchattention.dir/benchattention.cpp.o"
+  "CMakeFiles/benchattention.dir/benchattention.cpp.o.d"
+  "benchattention"
+  "benchattention.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/benchattention.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
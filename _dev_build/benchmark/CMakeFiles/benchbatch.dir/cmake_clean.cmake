@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/benchbatch.dir/benchbatch.cpp.o"
+  "CMakeFiles/benchbatch.dir/benchbatch.cpp.o.d"
+  "benchbatch"
+  "benchbatch.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/benchbatch.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/benchmat.dir/benchmat.cpp.o"
+  "CMakeFiles/benchmat.dir/benchmat.cpp.o.d"
+  "benchmat"
+  "benchmat.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/benchmat.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
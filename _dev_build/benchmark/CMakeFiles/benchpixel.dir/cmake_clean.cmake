@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/benchpixel.dir/benchpixel.cpp.o"
+  "CMakeFiles/benchpixel.dir/benchpixel.cpp.o.d"
+  "benchpixel"
+  "benchpixel.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/benchpixel.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
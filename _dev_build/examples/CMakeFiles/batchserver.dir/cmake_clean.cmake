@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/batchserver.dir/batchserver.cpp.o"
+  "CMakeFiles/batchserver.dir/batchserver.cpp.o.d"
+  "batchserver"
+  "batchserver.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/batchserver.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_binaryop.dir/test_binaryop.cpp.o"
+  "CMakeFiles/test_binaryop.dir/test_binaryop.cpp.o.d"
+  "test_binaryop"
+  "test_binaryop.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_binaryop.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_concat_oom.dir/test_concat_oom.cpp.o"
+  "CMakeFiles/test_concat_oom.dir/test_concat_oom.cpp.o.d"
+  "test_concat_oom"
+  "test_concat_oom.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_concat_oom.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
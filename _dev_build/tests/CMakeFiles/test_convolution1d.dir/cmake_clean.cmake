@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_convolution1d.dir/test_convolution1d.cpp.o"
+  "CMakeFiles/test_convolution1d.dir/test_convolution1d.cpp.o.d"
+  "test_convolution1d"
+  "test_convolution1d.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_convolution1d.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_convolution3d.dir/test_convolution3d.cpp.o"
+  "CMakeFiles/test_convolution3d.dir/test_convolution3d.cpp.o.d"
+  "test_convolution3d"
+  "test_convolution3d.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_convolution3d.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
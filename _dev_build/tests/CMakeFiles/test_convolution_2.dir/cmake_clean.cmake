@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_convolution_2.dir/test_convolution_2.cpp.o"
+  "CMakeFiles/test_convolution_2.dir/test_convolution_2.cpp.o.d"
+  "test_convolution_2"
+  "test_convolution_2.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_convolution_2.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_convolutiondepthwise.dir/test_convolutiondepthwise.cpp.o"
+  "CMakeFiles/test_convolutiondepthwise.dir/test_convolutiondepthwise.cpp.o.d"
+  "test_convolutiondepthwise"
+  "test_convolutiondepthwise.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_convolutiondepthwise.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_copyto.dir/test_copyto.cpp.o"
+  "CMakeFiles/test_copyto.dir/test_copyto.cpp.o.d"
+  "test_copyto"
+  "test_copyto.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_copyto.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_cpupipelinecache.dir/test_cpupipelinecache.cpp.o"
+  "CMakeFiles/test_cpupipelinecache.dir/test_cpupipelinecache.cpp.o.d"
+  "test_cpupipelinecache"
+  "test_cpupipelinecache.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_cpupipelinecache.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
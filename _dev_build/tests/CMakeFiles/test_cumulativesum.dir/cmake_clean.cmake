@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_cumulativesum.dir/test_cumulativesum.cpp.o"
+  "CMakeFiles/test_cumulativesum.dir/test_cumulativesum.cpp.o.d"
+  "test_cumulativesum"
+  "test_cumulativesum.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_cumulativesum.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
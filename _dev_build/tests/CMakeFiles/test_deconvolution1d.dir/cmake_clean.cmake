@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_deconvolution1d.dir/test_deconvolution1d.cpp.o"
+  "CMakeFiles/test_deconvolution1d.dir/test_deconvolution1d.cpp.o.d"
+  "test_deconvolution1d"
+  "test_deconvolution1d.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_deconvolution1d.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_deconvolutiondepthwise1d.dir/test_deconvolutiondepthwise1d.cpp.o"
+  "CMakeFiles/test_deconvolutiondepthwise1d.dir/test_deconvolutiondepthwise1d.cpp.o.d"
+  "test_deconvolutiondepthwise1d"
+  "test_deconvolutiondepthwise1d.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_deconvolutiondepthwise1d.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
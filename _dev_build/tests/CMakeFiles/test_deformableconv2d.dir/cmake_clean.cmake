@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_deformableconv2d.dir/test_deformableconv2d.cpp.o"
+  "CMakeFiles/test_deformableconv2d.dir/test_deformableconv2d.cpp.o.d"
+  "test_deformableconv2d"
+  "test_deformableconv2d.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_deformableconv2d.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
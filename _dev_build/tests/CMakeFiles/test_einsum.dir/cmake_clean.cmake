@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_einsum.dir/test_einsum.cpp.o"
+  "CMakeFiles/test_einsum.dir/test_einsum.cpp.o.d"
+  "test_einsum"
+  "test_einsum.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_einsum.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
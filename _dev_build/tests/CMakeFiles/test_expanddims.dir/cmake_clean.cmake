@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_expanddims.dir/test_expanddims.cpp.o"
+  "CMakeFiles/test_expanddims.dir/test_expanddims.cpp.o.d"
+  "test_expanddims"
+  "test_expanddims.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_expanddims.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_extract_batch.dir/test_extract_batch.cpp.o"
+  "CMakeFiles/test_extract_batch.dir/test_extract_batch.cpp.o.d"
+  "test_extract_batch"
+  "test_extract_batch.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_extract_batch.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_gridsample.dir/test_gridsample.cpp.o"
+  "CMakeFiles/test_gridsample.dir/test_gridsample.cpp.o.d"
+  "test_gridsample"
+  "test_gridsample.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_gridsample.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
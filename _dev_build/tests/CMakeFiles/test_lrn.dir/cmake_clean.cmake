@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_lrn.dir/test_lrn.cpp.o"
+  "CMakeFiles/test_lrn.dir/test_lrn.cpp.o.d"
+  "test_lrn"
+  "test_lrn.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_lrn.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_mat_pixel.dir/test_mat_pixel.cpp.o"
+  "CMakeFiles/test_mat_pixel.dir/test_mat_pixel.cpp.o.d"
+  "test_mat_pixel"
+  "test_mat_pixel.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_mat_pixel.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
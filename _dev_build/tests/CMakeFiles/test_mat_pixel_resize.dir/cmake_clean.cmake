@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_mat_pixel_resize.dir/test_mat_pixel_resize.cpp.o"
+  "CMakeFiles/test_mat_pixel_resize.dir/test_mat_pixel_resize.cpp.o.d"
+  "test_mat_pixel_resize"
+  "test_mat_pixel_resize.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_mat_pixel_resize.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
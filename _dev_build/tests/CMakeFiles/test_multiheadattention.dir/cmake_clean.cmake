@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_multiheadattention.dir/test_multiheadattention.cpp.o"
+  "CMakeFiles/test_multiheadattention.dir/test_multiheadattention.cpp.o.d"
+  "test_multiheadattention"
+  "test_multiheadattention.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_multiheadattention.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_padding.dir/test_padding.cpp.o"
+  "CMakeFiles/test_padding.dir/test_padding.cpp.o.d"
+  "test_padding"
+  "test_padding.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_padding.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_permute.dir/test_permute.cpp.o"
+  "CMakeFiles/test_permute.dir/test_permute.cpp.o.d"
+  "test_permute"
+  "test_permute.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_permute.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_pooling3d.dir/test_pooling3d.cpp.o"
+  "CMakeFiles/test_pooling3d.dir/test_pooling3d.cpp.o.d"
+  "test_pooling3d"
+  "test_pooling3d.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_pooling3d.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
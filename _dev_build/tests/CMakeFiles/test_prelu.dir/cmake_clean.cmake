@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_prelu.dir/test_prelu.cpp.o"
+  "CMakeFiles/test_prelu.dir/test_prelu.cpp.o.d"
+  "test_prelu"
+  "test_prelu.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_prelu.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
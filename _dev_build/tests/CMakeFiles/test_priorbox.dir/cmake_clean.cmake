@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_priorbox.dir/test_priorbox.cpp.o"
+  "CMakeFiles/test_priorbox.dir/test_priorbox.cpp.o.d"
+  "test_priorbox"
+  "test_priorbox.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_priorbox.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
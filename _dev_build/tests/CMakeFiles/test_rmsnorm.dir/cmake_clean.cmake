@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_rmsnorm.dir/test_rmsnorm.cpp.o"
+  "CMakeFiles/test_rmsnorm.dir/test_rmsnorm.cpp.o.d"
+  "test_rmsnorm"
+  "test_rmsnorm.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_rmsnorm.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_roipooling.dir/test_roipooling.cpp.o"
+  "CMakeFiles/test_roipooling.dir/test_roipooling.cpp.o.d"
+  "test_roipooling"
+  "test_roipooling.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_roipooling.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_shufflechannel.dir/test_shufflechannel.cpp.o"
+  "CMakeFiles/test_shufflechannel.dir/test_shufflechannel.cpp.o.d"
+  "test_shufflechannel"
+  "test_shufflechannel.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_shufflechannel.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_slice_oom.dir/test_slice_oom.cpp.o"
+  "CMakeFiles/test_slice_oom.dir/test_slice_oom.cpp.o.d"
+  "test_slice_oom"
+  "test_slice_oom.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_slice_oom.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
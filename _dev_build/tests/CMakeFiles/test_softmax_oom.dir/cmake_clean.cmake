@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_softmax_oom.dir/test_softmax_oom.cpp.o"
+  "CMakeFiles/test_softmax_oom.dir/test_softmax_oom.cpp.o.d"
+  "test_softmax_oom"
+  "test_softmax_oom.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_softmax_oom.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_squeezenet.dir/test_squeezenet.cpp.o"
+  "CMakeFiles/test_squeezenet.dir/test_squeezenet.cpp.o.d"
+  "test_squeezenet"
+  "test_squeezenet.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_squeezenet.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,266 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/tests
+# Build directory: /root/repo/_dev_build/tests
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(test_mat_pixel_affine "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_mat_pixel_affine" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_mat_pixel_affine PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;14;add_test;/root/repo/tests/CMakeLists.txt;44;ncnn_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_mat_pixel_drawing "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_mat_pixel_drawing" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_mat_pixel_drawing PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;14;add_test;/root/repo/tests/CMakeLists.txt;48;ncnn_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_mat_pixel_rotate "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_mat_pixel_rotate" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_mat_pixel_rotate PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;14;add_test;/root/repo/tests/CMakeLists.txt;52;ncnn_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_mat_pixel_preprocess "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_mat_pixel_preprocess" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_mat_pixel_preprocess PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;14;add_test;/root/repo/tests/CMakeLists.txt;56;ncnn_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_mat_pixel_resize "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_mat_pixel_resize" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_mat_pixel_resize PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;14;add_test;/root/repo/tests/CMakeLists.txt;57;ncnn_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_mat_pixel "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_mat_pixel" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_mat_pixel PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;14;add_test;/root/repo/tests/CMakeLists.txt;58;ncnn_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_squeezenet "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_squeezenet" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_squeezenet PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;14;add_test;/root/repo/tests/CMakeLists.txt;59;ncnn_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_allocator "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_allocator" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_allocator PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;14;add_test;/root/repo/tests/CMakeLists.txt;62;ncnn_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_batchserver "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_batchserver" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_batchserver PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;14;add_test;/root/repo/tests/CMakeLists.txt;63;ncnn_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_c_api "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_c_api" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_c_api PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;14;add_test;/root/repo/tests/CMakeLists.txt;64;ncnn_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_cpu "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_cpu" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_cpu PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;14;add_test;/root/repo/tests/CMakeLists.txt;65;ncnn_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_cpupipelinecache "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_cpupipelinecache" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_cpupipelinecache PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;14;add_test;/root/repo/tests/CMakeLists.txt;66;ncnn_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_extract_batch "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_extract_batch" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_extract_batch PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;14;add_test;/root/repo/tests/CMakeLists.txt;67;ncnn_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_mat_normalize "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_mat_normalize" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_mat_normalize PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;14;add_test;/root/repo/tests/CMakeLists.txt;68;ncnn_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_profiler "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_profiler" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_profiler PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;14;add_test;/root/repo/tests/CMakeLists.txt;69;ncnn_add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_absval "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_absval" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_absval PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;79;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_batchnorm "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_batchnorm" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_batchnorm PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;80;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_bias "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_bias" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_bias PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;81;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_binaryop "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_binaryop" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_binaryop PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;82;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_binaryop_1 "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_binaryop_1" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_binaryop_1 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;82;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_binaryop_2 "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_binaryop_2" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_binaryop_2 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;82;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_binaryop_3 "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_binaryop_3" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_binaryop_3 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;82;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_bnll "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_bnll" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_bnll PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;83;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_cast "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_cast" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_cast PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;84;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_celu "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_celu" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_celu PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;85;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_clip "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_clip" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_clip PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;86;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_concat "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_concat" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_concat PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;87;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_concat_oom "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_concat_oom" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_concat_oom PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;87;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_convolution "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_convolution" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_convolution PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;88;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_convolution_1 "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_convolution_1" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_convolution_1 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;88;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_convolution_2 "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_convolution_2" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_convolution_2 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;88;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_convolution_3 "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_convolution_3" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_convolution_3 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;88;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_convolution_oom "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_convolution_oom" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_convolution_oom PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;88;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_convolution1d "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_convolution1d" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_convolution1d PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;89;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_convolution3d "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_convolution3d" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_convolution3d PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;90;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_convolutiondepthwise "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_convolutiondepthwise" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_convolutiondepthwise PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;91;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_convolutiondepthwise_1 "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_convolutiondepthwise_1" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_convolutiondepthwise_1 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;91;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_convolutiondepthwise1d "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_convolutiondepthwise1d" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_convolutiondepthwise1d PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;92;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_convolutiondepthwise3d "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_convolutiondepthwise3d" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_convolutiondepthwise3d PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;93;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_copyto "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_copyto" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_copyto PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;94;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_copyto_1 "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_copyto_1" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_copyto_1 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;94;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_crop "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_crop" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_crop PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;95;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_crop_1 "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_crop_1" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_crop_1 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;95;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_crop_2 "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_crop_2" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_crop_2 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;95;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_cumulativesum "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_cumulativesum" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_cumulativesum PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;96;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_deconvolution "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_deconvolution" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_deconvolution PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;97;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_deconvolution1d "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_deconvolution1d" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_deconvolution1d PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;98;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_deconvolution3d "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_deconvolution3d" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_deconvolution3d PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;99;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_deconvolutiondepthwise "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_deconvolutiondepthwise" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_deconvolutiondepthwise PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;100;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_deconvolutiondepthwise_1 "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_deconvolutiondepthwise_1" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_deconvolutiondepthwise_1 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;100;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_deconvolutiondepthwise1d "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_deconvolutiondepthwise1d" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_deconvolutiondepthwise1d PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;101;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_deconvolutiondepthwise3d "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_deconvolutiondepthwise3d" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_deconvolutiondepthwise3d PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;102;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_deepcopy "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_deepcopy" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_deepcopy PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;103;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_deformableconv2d "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_deformableconv2d" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_deformableconv2d PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;104;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_deformableconv2d_1 "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_deformableconv2d_1" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_deformableconv2d_1 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;104;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_deformableconv2d_2 "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_deformableconv2d_2" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_deformableconv2d_2 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;104;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_deformableconv2d_3 "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_deformableconv2d_3" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_deformableconv2d_3 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;104;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_deformableconv2d_4 "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_deformableconv2d_4" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_deformableconv2d_4 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;104;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_dequantize "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_dequantize" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_dequantize PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;105;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_diag "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_diag" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_diag PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;106;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_dropout "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_dropout" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_dropout PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;107;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_einsum "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_einsum" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_einsum PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;108;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_eltwise "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_eltwise" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_eltwise PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;109;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_elu "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_elu" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_elu PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;110;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_embed "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_embed" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_embed PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;111;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_erf "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_erf" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_erf PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;112;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_expanddims "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_expanddims" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_expanddims PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;113;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_flatten "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_flatten" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_flatten PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;114;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_fold "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_fold" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_fold PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;115;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_gelu "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_gelu" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_gelu PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;116;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_glu "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_glu" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_glu PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;117;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_gemm "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_gemm" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_gemm PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;118;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_gemm_1 "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_gemm_1" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_gemm_1 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;118;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_gemm_2 "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_gemm_2" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_gemm_2 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;118;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_gridsample "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_gridsample" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_gridsample PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;119;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_groupnorm "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_groupnorm" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_groupnorm PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;120;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_gru "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_gru" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_gru PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;121;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_hardsigmoid "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_hardsigmoid" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_hardsigmoid PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;122;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_hardswish "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_hardswish" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_hardswish PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;123;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_innerproduct "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_innerproduct" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_innerproduct PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;124;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_instancenorm "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_instancenorm" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_instancenorm PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;125;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_interp "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_interp" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_interp PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;126;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_layernorm "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_layernorm" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_layernorm PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;127;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_lrn "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_lrn" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_lrn PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;128;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_lstm "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_lstm" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_lstm PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;129;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_matmul "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_matmul" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_matmul PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;130;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_memorydata "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_memorydata" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_memorydata PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;131;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_mish "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_mish" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_mish PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;132;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_multiheadattention "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_multiheadattention" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_multiheadattention PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;133;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_multiheadattention_oom "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_multiheadattention_oom" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_multiheadattention_oom PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;133;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_noop "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_noop" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_noop PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;134;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_normalize "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_normalize" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_normalize PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;135;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_packing "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_packing" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_packing PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;136;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_padding "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_padding" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_padding PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;137;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_permute "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_permute" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_permute PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;138;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_pixelshuffle "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_pixelshuffle" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_pixelshuffle PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;139;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_pooling "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_pooling" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_pooling PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;140;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_pooling1d "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_pooling1d" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_pooling1d PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;141;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_pooling3d "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_pooling3d" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_pooling3d PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;142;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_power "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_power" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_power PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;143;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_prelu "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_prelu" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_prelu PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;144;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_priorbox "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_priorbox" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_priorbox PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;145;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_quantize "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_quantize" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_quantize PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;146;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_reduction "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_reduction" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_reduction PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;147;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_relu "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_relu" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_relu PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;148;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_reorg "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_reorg" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_reorg PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;149;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_requantize "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_requantize" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_requantize PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;150;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_reshape "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_reshape" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_reshape PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;151;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_reshape_1 "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_reshape_1" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_reshape_1 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;151;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_rmsnorm "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_rmsnorm" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_rmsnorm PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;152;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_rnn "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_rnn" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_rnn PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;153;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_roipooling "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_roipooling" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_roipooling PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;154;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_roialign "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_roialign" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_roialign PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;155;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_scale "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_scale" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_scale PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;156;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_selu "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_selu" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_selu PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;157;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_shrink "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_shrink" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_shrink PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;158;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_shufflechannel "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_shufflechannel" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_shufflechannel PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;159;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_sigmoid "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_sigmoid" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_sigmoid PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;160;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_slice "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_slice" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_slice PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;161;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_slice_oom "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_slice_oom" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_slice_oom PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;161;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_softmax "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_softmax" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_softmax PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;162;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_softmax_oom "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_softmax_oom" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_softmax_oom PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;162;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_softplus "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_softplus" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_softplus PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;163;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_squeeze "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_squeeze" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_squeeze PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;164;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_swish "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_swish" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_swish PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;165;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_tanh "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_tanh" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_tanh PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;166;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_tile "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_tile" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_tile PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;167;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_unaryop "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_unaryop" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_unaryop PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;168;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_unfold "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_unfold" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_unfold PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;169;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_yolov3detectionoutput "/usr/bin/cmake" "-DTEST_EXECUTABLE=/root/repo/_dev_build/tests/test_yolov3detectionoutput" "-P" "/root/repo/tests/../cmake/run_test.cmake")
+set_tests_properties(test_yolov3detectionoutput PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;32;add_test;/root/repo/tests/CMakeLists.txt;170;ncnn_add_layer_test;/root/repo/tests/CMakeLists.txt;0;")
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ncnnmerge.dir/ncnnmerge.cpp.o"
+  "CMakeFiles/ncnnmerge.dir/ncnnmerge.cpp.o.d"
+  "ncnnmerge"
+  "ncnnmerge.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ncnnmerge.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
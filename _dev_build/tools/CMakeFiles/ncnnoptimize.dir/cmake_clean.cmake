@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ncnnoptimize.dir/ncnnoptimize.cpp.o"
+  "CMakeFiles/ncnnoptimize.dir/ncnnoptimize.cpp.o.d"
+  "ncnnoptimize"
+  "ncnnoptimize.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ncnnoptimize.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/mxnet2ncnn.dir/mxnet2ncnn.cpp.o"
+  "CMakeFiles/mxnet2ncnn.dir/mxnet2ncnn.cpp.o.d"
+  "mxnet2ncnn"
+  "mxnet2ncnn.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/mxnet2ncnn.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,26 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/_dev_build/tools/onnx/onnx.pb.cc" "tools/onnx/CMakeFiles/onnx2ncnn.dir/onnx.pb.cc.o" "gcc" "tools/onnx/CMakeFiles/onnx2ncnn.dir/onnx.pb.cc.o.d"
+  "/root/repo/tools/onnx/onnx2ncnn.cpp" "tools/onnx/CMakeFiles/onnx2ncnn.dir/onnx2ncnn.cpp.o" "gcc" "tools/onnx/CMakeFiles/onnx2ncnn.dir/onnx2ncnn.cpp.o.d"
+  )
+
+# Pairs of files generated by the same build rule.
+set(CMAKE_MULTIPLE_OUTPUT_PAIRS
+  "/root/repo/_dev_build/tools/onnx/onnx.pb.cc" "/root/repo/_dev_build/tools/onnx/onnx.pb.h"
+  )
+
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
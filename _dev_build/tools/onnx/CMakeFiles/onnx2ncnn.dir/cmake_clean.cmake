@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/onnx2ncnn.dir/onnx.pb.cc.o"
+  "CMakeFiles/onnx2ncnn.dir/onnx.pb.cc.o.d"
+  "CMakeFiles/onnx2ncnn.dir/onnx2ncnn.cpp.o"
+  "CMakeFiles/onnx2ncnn.dir/onnx2ncnn.cpp.o.d"
+  "onnx.pb.cc"
+  "onnx.pb.h"
+  "onnx2ncnn"
+  "onnx2ncnn.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/onnx2ncnn.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ncnn2int8.dir/ncnn2int8.cpp.o"
+  "CMakeFiles/ncnn2int8.dir/ncnn2int8.cpp.o.d"
+  "CMakeFiles/ncnn2int8.dir/netquantize.cpp.o"
+  "CMakeFiles/ncnn2int8.dir/netquantize.cpp.o.d"
+  "ncnn2int8"
+  "ncnn2int8.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ncnn2int8.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,22 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/tools/quantize/imreadwrite.cpp" "tools/quantize/CMakeFiles/ncnn2mixed.dir/imreadwrite.cpp.o" "gcc" "tools/quantize/CMakeFiles/ncnn2mixed.dir/imreadwrite.cpp.o.d"
+  "/root/repo/tools/quantize/ncnn2mixed.cpp" "tools/quantize/CMakeFiles/ncnn2mixed.dir/ncnn2mixed.cpp.o" "gcc" "tools/quantize/CMakeFiles/ncnn2mixed.dir/ncnn2mixed.cpp.o.d"
+  "/root/repo/tools/quantize/netquantize.cpp" "tools/quantize/CMakeFiles/ncnn2mixed.dir/netquantize.cpp.o" "gcc" "tools/quantize/CMakeFiles/ncnn2mixed.dir/netquantize.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_dev_build/src/CMakeFiles/ncnn.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
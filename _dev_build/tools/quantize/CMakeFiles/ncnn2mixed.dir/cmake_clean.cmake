@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ncnn2mixed.dir/imreadwrite.cpp.o"
+  "CMakeFiles/ncnn2mixed.dir/imreadwrite.cpp.o.d"
+  "CMakeFiles/ncnn2mixed.dir/ncnn2mixed.cpp.o"
+  "CMakeFiles/ncnn2mixed.dir/ncnn2mixed.cpp.o.d"
+  "CMakeFiles/ncnn2mixed.dir/netquantize.cpp.o"
+  "CMakeFiles/ncnn2mixed.dir/netquantize.cpp.o.d"
+  "ncnn2mixed"
+  "ncnn2mixed.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ncnn2mixed.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
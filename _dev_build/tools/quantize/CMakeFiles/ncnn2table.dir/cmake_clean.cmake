@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ncnn2table.dir/imreadwrite.cpp.o"
+  "CMakeFiles/ncnn2table.dir/imreadwrite.cpp.o.d"
+  "CMakeFiles/ncnn2table.dir/ncnn2table.cpp.o"
+  "CMakeFiles/ncnn2table.dir/ncnn2table.cpp.o.d"
+  "ncnn2table"
+  "ncnn2table.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ncnn2table.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
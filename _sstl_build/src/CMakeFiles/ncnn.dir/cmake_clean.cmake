@@ -0,0 +1,1173 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ncnn.dir/allocator.cpp.o"
+  "CMakeFiles/ncnn.dir/allocator.cpp.o.d"
+  "CMakeFiles/ncnn.dir/batchserver.cpp.o"
+  "CMakeFiles/ncnn.dir/batchserver.cpp.o.d"
+  "CMakeFiles/ncnn.dir/benchmark.cpp.o"
+  "CMakeFiles/ncnn.dir/benchmark.cpp.o.d"
+  "CMakeFiles/ncnn.dir/blob.cpp.o"
+  "CMakeFiles/ncnn.dir/blob.cpp.o.d"
+  "CMakeFiles/ncnn.dir/c_api.cpp.o"
+  "CMakeFiles/ncnn.dir/c_api.cpp.o.d"
+  "CMakeFiles/ncnn.dir/command.cpp.o"
+  "CMakeFiles/ncnn.dir/command.cpp.o.d"
+  "CMakeFiles/ncnn.dir/cpu.cpp.o"
+  "CMakeFiles/ncnn.dir/cpu.cpp.o.d"
+  "CMakeFiles/ncnn.dir/cpupipelinecache.cpp.o"
+  "CMakeFiles/ncnn.dir/cpupipelinecache.cpp.o.d"
+  "CMakeFiles/ncnn.dir/datareader.cpp.o"
+  "CMakeFiles/ncnn.dir/datareader.cpp.o.d"
+  "CMakeFiles/ncnn.dir/gpu.cpp.o"
+  "CMakeFiles/ncnn.dir/gpu.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer.cpp.o"
+  "CMakeFiles/ncnn.dir/layer.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/absval.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/absval.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/batchnorm.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/batchnorm.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/bias.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/bias.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/binaryop.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/binaryop.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/bnll.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/bnll.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/cast.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/cast.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/celu.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/celu.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/clip.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/clip.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/concat.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/concat.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/convolution.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/convolution.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/convolution1d.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/convolution1d.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/convolution3d.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/convolution3d.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/convolutiondepthwise.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/convolutiondepthwise.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/convolutiondepthwise1d.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/convolutiondepthwise1d.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/convolutiondepthwise3d.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/convolutiondepthwise3d.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/copyto.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/copyto.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/crop.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/crop.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/cumulativesum.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/cumulativesum.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/deconvolution.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/deconvolution.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/deconvolution1d.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/deconvolution1d.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/deconvolution3d.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/deconvolution3d.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/deconvolutiondepthwise.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/deconvolutiondepthwise.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/deconvolutiondepthwise1d.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/deconvolutiondepthwise1d.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/deconvolutiondepthwise3d.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/deconvolutiondepthwise3d.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/deepcopy.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/deepcopy.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/deformableconv2d.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/deformableconv2d.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/dequantize.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/dequantize.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/detectionoutput.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/detectionoutput.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/diag.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/diag.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/dropout.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/dropout.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/einsum.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/einsum.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/eltwise.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/eltwise.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/elu.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/elu.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/embed.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/embed.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/erf.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/erf.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/exp.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/exp.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/expanddims.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/expanddims.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/flatten.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/flatten.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/fold.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/fold.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/gelu.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/gelu.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/gemm.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/gemm.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/glu.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/glu.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/gridsample.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/gridsample.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/groupnorm.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/groupnorm.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/gru.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/gru.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/hardsigmoid.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/hardsigmoid.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/hardswish.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/hardswish.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/innerproduct.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/innerproduct.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/input.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/input.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/instancenorm.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/instancenorm.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/interp.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/interp.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/layernorm.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/layernorm.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/log.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/log.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/lrn.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/lrn.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/lstm.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/lstm.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/matmul.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/matmul.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/memorydata.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/memorydata.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/mish.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/mish.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/multiheadattention.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/multiheadattention.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/mvn.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/mvn.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/noop.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/noop.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/normalize.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/normalize.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/packing.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/packing.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/padding.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/padding.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/permute.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/permute.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/pixelshuffle.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/pixelshuffle.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/pooling.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/pooling.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/pooling1d.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/pooling1d.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/pooling3d.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/pooling3d.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/power.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/power.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/prelu.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/prelu.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/priorbox.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/priorbox.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/proposal.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/proposal.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/psroipooling.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/psroipooling.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/quantize.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/quantize.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/reduction.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/reduction.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/relu.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/relu.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/reorg.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/reorg.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/requantize.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/requantize.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/reshape.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/reshape.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/rmsnorm.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/rmsnorm.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/rnn.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/rnn.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/roialign.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/roialign.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/roipooling.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/roipooling.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/scale.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/scale.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/selu.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/selu.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/shrink.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/shrink.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/shufflechannel.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/shufflechannel.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/sigmoid.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/sigmoid.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/slice.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/slice.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/softmax.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/softmax.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/softplus.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/softplus.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/split.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/split.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/squeeze.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/squeeze.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/statisticspooling.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/statisticspooling.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/swish.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/swish.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/tanh.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/tanh.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/threshold.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/threshold.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/tile.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/tile.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/unaryop.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/unaryop.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/unfold.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/unfold.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/batchnorm_x86.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/batchnorm_x86.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/batchnorm_x86_avx.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/batchnorm_x86_avx.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/batchnorm_x86_avx512.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/batchnorm_x86_avx512.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/batchnorm_x86_fma.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/batchnorm_x86_fma.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/bias_x86.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/bias_x86.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/bias_x86_avx.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/bias_x86_avx.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/bias_x86_avx512.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/bias_x86_avx512.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/bias_x86_fma.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/bias_x86_fma.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/binaryop_x86.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/binaryop_x86.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/binaryop_x86_avx.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/binaryop_x86_avx.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/binaryop_x86_avx512.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/binaryop_x86_avx512.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/binaryop_x86_fma.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/binaryop_x86_fma.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/bnll_x86.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/bnll_x86.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/bnll_x86_avx.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/bnll_x86_avx.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/bnll_x86_avx512.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/bnll_x86_avx512.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/bnll_x86_fma.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/bnll_x86_fma.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/cast_x86.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/cast_x86.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/cast_x86_avx.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/cast_x86_avx.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/cast_x86_avx2.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/cast_x86_avx2.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/cast_x86_avx512.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/cast_x86_avx512.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/cast_x86_avx512bf16.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/cast_x86_avx512bf16.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/cast_x86_f16c.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/cast_x86_f16c.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/cast_x86_fma.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/cast_x86_fma.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/clip_x86.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/clip_x86.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/clip_x86_avx.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/clip_x86_avx.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/clip_x86_avx512.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/clip_x86_avx512.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/clip_x86_fma.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/clip_x86_fma.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/concat_x86.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/concat_x86.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/concat_x86_avx.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/concat_x86_avx.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/concat_x86_avx512.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/concat_x86_avx512.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/concat_x86_fma.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/concat_x86_fma.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/convolution1d_x86.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/convolution1d_x86.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/convolution1d_x86_avx.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/convolution1d_x86_avx.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/convolution1d_x86_avx512.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/convolution1d_x86_avx512.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/convolution1d_x86_fma.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/convolution1d_x86_fma.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/convolution_x86.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/convolution_x86.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/convolution_x86_avx.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/convolution_x86_avx.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/convolution_x86_avx2.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/convolution_x86_avx2.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/convolution_x86_avx512.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/convolution_x86_avx512.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/convolution_x86_avx512vnni.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/convolution_x86_avx512vnni.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/convolution_x86_avxvnni.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/convolution_x86_avxvnni.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/convolution_x86_fma.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/convolution_x86_fma.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/convolution_x86_xop.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/convolution_x86_xop.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/convolutiondepthwise_x86.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/convolutiondepthwise_x86.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/convolutiondepthwise_x86_avx.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/convolutiondepthwise_x86_avx.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/convolutiondepthwise_x86_avx512.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/convolutiondepthwise_x86_avx512.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/convolutiondepthwise_x86_fma.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/convolutiondepthwise_x86_fma.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/crop_x86.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/crop_x86.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/crop_x86_avx.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/crop_x86_avx.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/crop_x86_avx512.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/crop_x86_avx512.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/crop_x86_fma.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/crop_x86_fma.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/deconvolution_x86.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/deconvolution_x86.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/deconvolution_x86_avx.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/deconvolution_x86_avx.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/deconvolution_x86_avx512.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/deconvolution_x86_avx512.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/deconvolution_x86_fma.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/deconvolution_x86_fma.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/deconvolutiondepthwise_x86.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/deconvolutiondepthwise_x86.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/deconvolutiondepthwise_x86_avx.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/deconvolutiondepthwise_x86_avx.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/deconvolutiondepthwise_x86_avx512.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/deconvolutiondepthwise_x86_avx512.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/deconvolutiondepthwise_x86_fma.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/deconvolutiondepthwise_x86_fma.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/deformableconv2d_x86.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/deformableconv2d_x86.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/deformableconv2d_x86_avx.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/deformableconv2d_x86_avx.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/deformableconv2d_x86_avx512.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/deformableconv2d_x86_avx512.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/deformableconv2d_x86_fma.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/deformableconv2d_x86_fma.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/dequantize_x86.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/dequantize_x86.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/dequantize_x86_avx.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/dequantize_x86_avx.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/dequantize_x86_avx512.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/dequantize_x86_avx512.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/dequantize_x86_fma.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/dequantize_x86_fma.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/dropout_x86.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/dropout_x86.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/dropout_x86_avx.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/dropout_x86_avx.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/dropout_x86_avx512.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/dropout_x86_avx512.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/dropout_x86_fma.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/dropout_x86_fma.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/eltwise_x86.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/eltwise_x86.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/eltwise_x86_avx.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/eltwise_x86_avx.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/eltwise_x86_avx512.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/eltwise_x86_avx512.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/eltwise_x86_fma.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/eltwise_x86_fma.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/elu_x86.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/elu_x86.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/elu_x86_avx.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/elu_x86_avx.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/elu_x86_avx512.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/elu_x86_avx512.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/elu_x86_fma.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/elu_x86_fma.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/expanddims_x86.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/expanddims_x86.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/expanddims_x86_avx.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/expanddims_x86_avx.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/expanddims_x86_avx512.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/expanddims_x86_avx512.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/expanddims_x86_fma.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/expanddims_x86_fma.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/flatten_x86.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/flatten_x86.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/flatten_x86_avx.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/flatten_x86_avx.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/flatten_x86_avx512.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/flatten_x86_avx512.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/flatten_x86_fma.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/flatten_x86_fma.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/gelu_x86.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/gelu_x86.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/gelu_x86_avx.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/gelu_x86_avx.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/gelu_x86_avx512.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/gelu_x86_avx512.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/gelu_x86_fma.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/gelu_x86_fma.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/gemm_x86.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/gemm_x86.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/gemm_x86_avx.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/gemm_x86_avx.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/gemm_x86_avx2.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/gemm_x86_avx2.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/gemm_x86_avx512.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/gemm_x86_avx512.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/gemm_x86_avx512vnni.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/gemm_x86_avx512vnni.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/gemm_x86_avxvnni.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/gemm_x86_avxvnni.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/gemm_x86_fma.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/gemm_x86_fma.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/gridsample_x86.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/gridsample_x86.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/gridsample_x86_avx.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/gridsample_x86_avx.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/gridsample_x86_avx512.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/gridsample_x86_avx512.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/gridsample_x86_fma.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/gridsample_x86_fma.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/groupnorm_x86.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/groupnorm_x86.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/groupnorm_x86_avx.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/groupnorm_x86_avx.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/groupnorm_x86_avx512.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/groupnorm_x86_avx512.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/groupnorm_x86_fma.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/groupnorm_x86_fma.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/gru_x86.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/gru_x86.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/gru_x86_avx.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/gru_x86_avx.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/gru_x86_avx2.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/gru_x86_avx2.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/gru_x86_avx512.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/gru_x86_avx512.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/gru_x86_avx512vnni.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/gru_x86_avx512vnni.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/gru_x86_fma.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/gru_x86_fma.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/hardsigmoid_x86.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/hardsigmoid_x86.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/hardsigmoid_x86_avx.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/hardsigmoid_x86_avx.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/hardsigmoid_x86_avx512.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/hardsigmoid_x86_avx512.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/hardsigmoid_x86_fma.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/hardsigmoid_x86_fma.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/hardswish_x86.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/hardswish_x86.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/hardswish_x86_avx.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/hardswish_x86_avx.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/hardswish_x86_avx512.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/hardswish_x86_avx512.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/hardswish_x86_fma.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/hardswish_x86_fma.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/innerproduct_x86.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/innerproduct_x86.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/innerproduct_x86_avx.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/innerproduct_x86_avx.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/innerproduct_x86_avx512.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/innerproduct_x86_avx512.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/innerproduct_x86_avx512bf16.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/innerproduct_x86_avx512bf16.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/innerproduct_x86_f16c.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/innerproduct_x86_f16c.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/innerproduct_x86_fma.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/innerproduct_x86_fma.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/interp_x86.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/interp_x86.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/interp_x86_avx.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/interp_x86_avx.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/interp_x86_avx512.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/interp_x86_avx512.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/interp_x86_fma.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/interp_x86_fma.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/layernorm_x86.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/layernorm_x86.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/layernorm_x86_avx.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/layernorm_x86_avx.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/layernorm_x86_avx512.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/layernorm_x86_avx512.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/layernorm_x86_fma.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/layernorm_x86_fma.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/lrn_x86.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/lrn_x86.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/lrn_x86_avx.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/lrn_x86_avx.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/lrn_x86_avx512.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/lrn_x86_avx512.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/lrn_x86_fma.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/lrn_x86_fma.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/lstm_x86.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/lstm_x86.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/lstm_x86_avx.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/lstm_x86_avx.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/lstm_x86_avx2.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/lstm_x86_avx2.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/lstm_x86_avx512.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/lstm_x86_avx512.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/lstm_x86_avx512vnni.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/lstm_x86_avx512vnni.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/lstm_x86_avxvnni.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/lstm_x86_avxvnni.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/lstm_x86_fma.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/lstm_x86_fma.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/lstm_x86_xop.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/lstm_x86_xop.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/matmul_x86.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/matmul_x86.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/matmul_x86_avx.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/matmul_x86_avx.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/matmul_x86_avx512.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/matmul_x86_avx512.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/matmul_x86_fma.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/matmul_x86_fma.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/mish_x86.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/mish_x86.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/mish_x86_avx.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/mish_x86_avx.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/mish_x86_avx512.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/mish_x86_avx512.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/mish_x86_fma.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/mish_x86_fma.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/multiheadattention_x86.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/multiheadattention_x86.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/multiheadattention_x86_avx.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/multiheadattention_x86_avx.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/multiheadattention_x86_avx512.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/multiheadattention_x86_avx512.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/multiheadattention_x86_fma.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/multiheadattention_x86_fma.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/packing_x86.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/packing_x86.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/packing_x86_avx.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/packing_x86_avx.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/packing_x86_avx512.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/packing_x86_avx512.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/packing_x86_fma.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/packing_x86_fma.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/padding_x86.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/padding_x86.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/padding_x86_avx.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/padding_x86_avx.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/padding_x86_avx512.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/padding_x86_avx512.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/padding_x86_fma.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/padding_x86_fma.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/permute_x86.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/permute_x86.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/permute_x86_avx.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/permute_x86_avx.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/permute_x86_avx512.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/permute_x86_avx512.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/permute_x86_fma.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/permute_x86_fma.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/pixelshuffle_x86.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/pixelshuffle_x86.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/pixelshuffle_x86_avx.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/pixelshuffle_x86_avx.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/pixelshuffle_x86_avx512.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/pixelshuffle_x86_avx512.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/pixelshuffle_x86_fma.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/pixelshuffle_x86_fma.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/pooling_x86.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/pooling_x86.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/pooling_x86_avx.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/pooling_x86_avx.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/pooling_x86_avx512.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/pooling_x86_avx512.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/pooling_x86_fma.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/pooling_x86_fma.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/prelu_x86.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/prelu_x86.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/prelu_x86_avx.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/prelu_x86_avx.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/prelu_x86_avx512.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/prelu_x86_avx512.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/prelu_x86_fma.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/prelu_x86_fma.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/quantize_x86.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/quantize_x86.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/quantize_x86_avx.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/quantize_x86_avx.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/quantize_x86_avx512.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/quantize_x86_avx512.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/quantize_x86_fma.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/quantize_x86_fma.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/reduction_x86.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/reduction_x86.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/reduction_x86_avx.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/reduction_x86_avx.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/reduction_x86_avx512.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/reduction_x86_avx512.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/reduction_x86_fma.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/reduction_x86_fma.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/relu_x86.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/relu_x86.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/relu_x86_avx.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/relu_x86_avx.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/relu_x86_avx512.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/relu_x86_avx512.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/relu_x86_fma.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/relu_x86_fma.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/requantize_x86.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/requantize_x86.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/requantize_x86_avx.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/requantize_x86_avx.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/requantize_x86_avx512.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/requantize_x86_avx512.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/requantize_x86_fma.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/requantize_x86_fma.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/reshape_x86.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/reshape_x86.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/reshape_x86_avx.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/reshape_x86_avx.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/reshape_x86_avx512.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/reshape_x86_avx512.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/reshape_x86_fma.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/reshape_x86_fma.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/rmsnorm_x86.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/rmsnorm_x86.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/rmsnorm_x86_avx.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/rmsnorm_x86_avx.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/rmsnorm_x86_avx512.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/rmsnorm_x86_avx512.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/rmsnorm_x86_fma.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/rmsnorm_x86_fma.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/rnn_x86.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/rnn_x86.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/rnn_x86_avx.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/rnn_x86_avx.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/rnn_x86_avx2.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/rnn_x86_avx2.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/rnn_x86_avx512.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/rnn_x86_avx512.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/rnn_x86_avx512vnni.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/rnn_x86_avx512vnni.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/rnn_x86_fma.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/rnn_x86_fma.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/roialign_x86.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/roialign_x86.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/roialign_x86_avx.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/roialign_x86_avx.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/roialign_x86_avx512.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/roialign_x86_avx512.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/roialign_x86_fma.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/roialign_x86_fma.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/scale_x86.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/scale_x86.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/scale_x86_avx.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/scale_x86_avx.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/scale_x86_avx512.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/scale_x86_avx512.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/scale_x86_fma.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/scale_x86_fma.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/selu_x86.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/selu_x86.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/selu_x86_avx.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/selu_x86_avx.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/selu_x86_avx512.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/selu_x86_avx512.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/selu_x86_fma.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/selu_x86_fma.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/shufflechannel_x86.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/shufflechannel_x86.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/shufflechannel_x86_avx.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/shufflechannel_x86_avx.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/shufflechannel_x86_avx512.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/shufflechannel_x86_avx512.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/shufflechannel_x86_fma.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/shufflechannel_x86_fma.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/sigmoid_x86.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/sigmoid_x86.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/sigmoid_x86_avx.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/sigmoid_x86_avx.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/sigmoid_x86_avx512.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/sigmoid_x86_avx512.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/sigmoid_x86_fma.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/sigmoid_x86_fma.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/slice_x86.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/slice_x86.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/slice_x86_avx.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/slice_x86_avx.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/slice_x86_avx512.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/slice_x86_avx512.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/slice_x86_fma.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/slice_x86_fma.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/softmax_x86.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/softmax_x86.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/softmax_x86_avx.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/softmax_x86_avx.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/softmax_x86_avx512.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/softmax_x86_avx512.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/softmax_x86_fma.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/softmax_x86_fma.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/squeeze_x86.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/squeeze_x86.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/squeeze_x86_avx.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/squeeze_x86_avx.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/squeeze_x86_avx512.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/squeeze_x86_avx512.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/squeeze_x86_fma.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/squeeze_x86_fma.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/swish_x86.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/swish_x86.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/swish_x86_avx.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/swish_x86_avx.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/swish_x86_avx512.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/swish_x86_avx512.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/swish_x86_fma.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/swish_x86_fma.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/tanh_x86.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/tanh_x86.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/tanh_x86_avx.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/tanh_x86_avx.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/tanh_x86_avx512.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/tanh_x86_avx512.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/tanh_x86_fma.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/tanh_x86_fma.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/tile_x86.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/tile_x86.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/tile_x86_avx.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/tile_x86_avx.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/tile_x86_avx512.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/tile_x86_avx512.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/tile_x86_fma.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/tile_x86_fma.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/unaryop_x86.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/unaryop_x86.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/unaryop_x86_avx.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/unaryop_x86_avx.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/unaryop_x86_avx512.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/unaryop_x86_avx512.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/unaryop_x86_fma.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/unaryop_x86_fma.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/yolov3detectionoutput_x86.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/yolov3detectionoutput_x86.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/yolov3detectionoutput_x86_avx.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/yolov3detectionoutput_x86_avx.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/yolov3detectionoutput_x86_avx512.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/yolov3detectionoutput_x86_avx512.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/x86/yolov3detectionoutput_x86_fma.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/x86/yolov3detectionoutput_x86_fma.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/yolodetectionoutput.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/yolodetectionoutput.cpp.o.d"
+  "CMakeFiles/ncnn.dir/layer/yolov3detectionoutput.cpp.o"
+  "CMakeFiles/ncnn.dir/layer/yolov3detectionoutput.cpp.o.d"
+  "CMakeFiles/ncnn.dir/mat.cpp.o"
+  "CMakeFiles/ncnn.dir/mat.cpp.o.d"
+  "CMakeFiles/ncnn.dir/mat_pixel.cpp.o"
+  "CMakeFiles/ncnn.dir/mat_pixel.cpp.o.d"
+  "CMakeFiles/ncnn.dir/mat_pixel_affine.cpp.o"
+  "CMakeFiles/ncnn.dir/mat_pixel_affine.cpp.o.d"
+  "CMakeFiles/ncnn.dir/mat_pixel_drawing.cpp.o"
+  "CMakeFiles/ncnn.dir/mat_pixel_drawing.cpp.o.d"
+  "CMakeFiles/ncnn.dir/mat_pixel_preprocess.cpp.o"
+  "CMakeFiles/ncnn.dir/mat_pixel_preprocess.cpp.o.d"
+  "CMakeFiles/ncnn.dir/mat_pixel_resize.cpp.o"
+  "CMakeFiles/ncnn.dir/mat_pixel_resize.cpp.o.d"
+  "CMakeFiles/ncnn.dir/mat_pixel_rotate.cpp.o"
+  "CMakeFiles/ncnn.dir/mat_pixel_rotate.cpp.o.d"
+  "CMakeFiles/ncnn.dir/mat_pixel_x86_avx2.cpp.o"
+  "CMakeFiles/ncnn.dir/mat_pixel_x86_avx2.cpp.o.d"
+  "CMakeFiles/ncnn.dir/mat_pixel_x86_avx512.cpp.o"
+  "CMakeFiles/ncnn.dir/mat_pixel_x86_avx512.cpp.o.d"
+  "CMakeFiles/ncnn.dir/modelbin.cpp.o"
+  "CMakeFiles/ncnn.dir/modelbin.cpp.o.d"
+  "CMakeFiles/ncnn.dir/net.cpp.o"
+  "CMakeFiles/ncnn.dir/net.cpp.o.d"
+  "CMakeFiles/ncnn.dir/option.cpp.o"
+  "CMakeFiles/ncnn.dir/option.cpp.o.d"
+  "CMakeFiles/ncnn.dir/paramdict.cpp.o"
+  "CMakeFiles/ncnn.dir/paramdict.cpp.o.d"
+  "CMakeFiles/ncnn.dir/pipeline.cpp.o"
+  "CMakeFiles/ncnn.dir/pipeline.cpp.o.d"
+  "CMakeFiles/ncnn.dir/pipelinecache.cpp.o"
+  "CMakeFiles/ncnn.dir/pipelinecache.cpp.o.d"
+  "CMakeFiles/ncnn.dir/profiler.cpp.o"
+  "CMakeFiles/ncnn.dir/profiler.cpp.o.d"
+  "CMakeFiles/ncnn.dir/simplemath.cpp.o"
+  "CMakeFiles/ncnn.dir/simplemath.cpp.o.d"
+  "CMakeFiles/ncnn.dir/simpleocv.cpp.o"
+  "CMakeFiles/ncnn.dir/simpleocv.cpp.o.d"
+  "CMakeFiles/ncnn.dir/simpleomp.cpp.o"
+  "CMakeFiles/ncnn.dir/simpleomp.cpp.o.d"
+  "CMakeFiles/ncnn.dir/simplestl.cpp.o"
+  "CMakeFiles/ncnn.dir/simplestl.cpp.o.d"
+  "CMakeFiles/ncnn.dir/simplevk.cpp.o"
+  "CMakeFiles/ncnn.dir/simplevk.cpp.o.d"
+  "layer/x86/batchnorm_x86_avx.cpp"
+  "layer/x86/batchnorm_x86_avx.h"
+  "layer/x86/batchnorm_x86_avx512.cpp"
+  "layer/x86/batchnorm_x86_avx512.h"
+  "layer/x86/batchnorm_x86_fma.cpp"
+  "layer/x86/batchnorm_x86_fma.h"
+  "layer/x86/bias_x86_avx.cpp"
+  "layer/x86/bias_x86_avx.h"
+  "layer/x86/bias_x86_avx512.cpp"
+  "layer/x86/bias_x86_avx512.h"
+  "layer/x86/bias_x86_fma.cpp"
+  "layer/x86/bias_x86_fma.h"
+  "layer/x86/binaryop_x86_avx.cpp"
+  "layer/x86/binaryop_x86_avx.h"
+  "layer/x86/binaryop_x86_avx512.cpp"
+  "layer/x86/binaryop_x86_avx512.h"
+  "layer/x86/binaryop_x86_fma.cpp"
+  "layer/x86/binaryop_x86_fma.h"
+  "layer/x86/bnll_x86_avx.cpp"
+  "layer/x86/bnll_x86_avx.h"
+  "layer/x86/bnll_x86_avx512.cpp"
+  "layer/x86/bnll_x86_avx512.h"
+  "layer/x86/bnll_x86_fma.cpp"
+  "layer/x86/bnll_x86_fma.h"
+  "layer/x86/cast_x86_avx.cpp"
+  "layer/x86/cast_x86_avx.h"
+  "layer/x86/cast_x86_avx512.cpp"
+  "layer/x86/cast_x86_avx512.h"
+  "layer/x86/cast_x86_fma.cpp"
+  "layer/x86/cast_x86_fma.h"
+  "layer/x86/clip_x86_avx.cpp"
+  "layer/x86/clip_x86_avx.h"
+  "layer/x86/clip_x86_avx512.cpp"
+  "layer/x86/clip_x86_avx512.h"
+  "layer/x86/clip_x86_fma.cpp"
+  "layer/x86/clip_x86_fma.h"
+  "layer/x86/concat_x86_avx.cpp"
+  "layer/x86/concat_x86_avx.h"
+  "layer/x86/concat_x86_avx512.cpp"
+  "layer/x86/concat_x86_avx512.h"
+  "layer/x86/concat_x86_fma.cpp"
+  "layer/x86/concat_x86_fma.h"
+  "layer/x86/convolution1d_x86_avx.cpp"
+  "layer/x86/convolution1d_x86_avx.h"
+  "layer/x86/convolution1d_x86_avx512.cpp"
+  "layer/x86/convolution1d_x86_avx512.h"
+  "layer/x86/convolution1d_x86_fma.cpp"
+  "layer/x86/convolution1d_x86_fma.h"
+  "layer/x86/convolution_x86_avx.cpp"
+  "layer/x86/convolution_x86_avx.h"
+  "layer/x86/convolution_x86_avx512.cpp"
+  "layer/x86/convolution_x86_avx512.h"
+  "layer/x86/convolution_x86_fma.cpp"
+  "layer/x86/convolution_x86_fma.h"
+  "layer/x86/convolutiondepthwise_x86_avx.cpp"
+  "layer/x86/convolutiondepthwise_x86_avx.h"
+  "layer/x86/convolutiondepthwise_x86_avx512.cpp"
+  "layer/x86/convolutiondepthwise_x86_avx512.h"
+  "layer/x86/convolutiondepthwise_x86_fma.cpp"
+  "layer/x86/convolutiondepthwise_x86_fma.h"
+  "layer/x86/crop_x86_avx.cpp"
+  "layer/x86/crop_x86_avx.h"
+  "layer/x86/crop_x86_avx512.cpp"
+  "layer/x86/crop_x86_avx512.h"
+  "layer/x86/crop_x86_fma.cpp"
+  "layer/x86/crop_x86_fma.h"
+  "layer/x86/deconvolution_x86_avx.cpp"
+  "layer/x86/deconvolution_x86_avx.h"
+  "layer/x86/deconvolution_x86_avx512.cpp"
+  "layer/x86/deconvolution_x86_avx512.h"
+  "layer/x86/deconvolution_x86_fma.cpp"
+  "layer/x86/deconvolution_x86_fma.h"
+  "layer/x86/deconvolutiondepthwise_x86_avx.cpp"
+  "layer/x86/deconvolutiondepthwise_x86_avx.h"
+  "layer/x86/deconvolutiondepthwise_x86_avx512.cpp"
+  "layer/x86/deconvolutiondepthwise_x86_avx512.h"
+  "layer/x86/deconvolutiondepthwise_x86_fma.cpp"
+  "layer/x86/deconvolutiondepthwise_x86_fma.h"
+  "layer/x86/deformableconv2d_x86_avx.cpp"
+  "layer/x86/deformableconv2d_x86_avx.h"
+  "layer/x86/deformableconv2d_x86_avx512.cpp"
+  "layer/x86/deformableconv2d_x86_avx512.h"
+  "layer/x86/deformableconv2d_x86_fma.cpp"
+  "layer/x86/deformableconv2d_x86_fma.h"
+  "layer/x86/dequantize_x86_avx.cpp"
+  "layer/x86/dequantize_x86_avx.h"
+  "layer/x86/dequantize_x86_avx512.cpp"
+  "layer/x86/dequantize_x86_avx512.h"
+  "layer/x86/dequantize_x86_fma.cpp"
+  "layer/x86/dequantize_x86_fma.h"
+  "layer/x86/dropout_x86_avx.cpp"
+  "layer/x86/dropout_x86_avx.h"
+  "layer/x86/dropout_x86_avx512.cpp"
+  "layer/x86/dropout_x86_avx512.h"
+  "layer/x86/dropout_x86_fma.cpp"
+  "layer/x86/dropout_x86_fma.h"
+  "layer/x86/eltwise_x86_avx.cpp"
+  "layer/x86/eltwise_x86_avx.h"
+  "layer/x86/eltwise_x86_avx512.cpp"
+  "layer/x86/eltwise_x86_avx512.h"
+  "layer/x86/eltwise_x86_fma.cpp"
+  "layer/x86/eltwise_x86_fma.h"
+  "layer/x86/elu_x86_avx.cpp"
+  "layer/x86/elu_x86_avx.h"
+  "layer/x86/elu_x86_avx512.cpp"
+  "layer/x86/elu_x86_avx512.h"
+  "layer/x86/elu_x86_fma.cpp"
+  "layer/x86/elu_x86_fma.h"
+  "layer/x86/expanddims_x86_avx.cpp"
+  "layer/x86/expanddims_x86_avx.h"
+  "layer/x86/expanddims_x86_avx512.cpp"
+  "layer/x86/expanddims_x86_avx512.h"
+  "layer/x86/expanddims_x86_fma.cpp"
+  "layer/x86/expanddims_x86_fma.h"
+  "layer/x86/flatten_x86_avx.cpp"
+  "layer/x86/flatten_x86_avx.h"
+  "layer/x86/flatten_x86_avx512.cpp"
+  "layer/x86/flatten_x86_avx512.h"
+  "layer/x86/flatten_x86_fma.cpp"
+  "layer/x86/flatten_x86_fma.h"
+  "layer/x86/gelu_x86_avx.cpp"
+  "layer/x86/gelu_x86_avx.h"
+  "layer/x86/gelu_x86_avx512.cpp"
+  "layer/x86/gelu_x86_avx512.h"
+  "layer/x86/gelu_x86_fma.cpp"
+  "layer/x86/gelu_x86_fma.h"
+  "layer/x86/gemm_x86_avx.cpp"
+  "layer/x86/gemm_x86_avx.h"
+  "layer/x86/gemm_x86_avx512.cpp"
+  "layer/x86/gemm_x86_avx512.h"
+  "layer/x86/gemm_x86_fma.cpp"
+  "layer/x86/gemm_x86_fma.h"
+  "layer/x86/gridsample_x86_avx.cpp"
+  "layer/x86/gridsample_x86_avx.h"
+  "layer/x86/gridsample_x86_avx512.cpp"
+  "layer/x86/gridsample_x86_avx512.h"
+  "layer/x86/gridsample_x86_fma.cpp"
+  "layer/x86/gridsample_x86_fma.h"
+  "layer/x86/groupnorm_x86_avx.cpp"
+  "layer/x86/groupnorm_x86_avx.h"
+  "layer/x86/groupnorm_x86_avx512.cpp"
+  "layer/x86/groupnorm_x86_avx512.h"
+  "layer/x86/groupnorm_x86_fma.cpp"
+  "layer/x86/groupnorm_x86_fma.h"
+  "layer/x86/gru_x86_avx.cpp"
+  "layer/x86/gru_x86_avx.h"
+  "layer/x86/gru_x86_avx512.cpp"
+  "layer/x86/gru_x86_avx512.h"
+  "layer/x86/gru_x86_fma.cpp"
+  "layer/x86/gru_x86_fma.h"
+  "layer/x86/hardsigmoid_x86_avx.cpp"
+  "layer/x86/hardsigmoid_x86_avx.h"
+  "layer/x86/hardsigmoid_x86_avx512.cpp"
+  "layer/x86/hardsigmoid_x86_avx512.h"
+  "layer/x86/hardsigmoid_x86_fma.cpp"
+  "layer/x86/hardsigmoid_x86_fma.h"
+  "layer/x86/hardswish_x86_avx.cpp"
+  "layer/x86/hardswish_x86_avx.h"
+  "layer/x86/hardswish_x86_avx512.cpp"
+  "layer/x86/hardswish_x86_avx512.h"
+  "layer/x86/hardswish_x86_fma.cpp"
+  "layer/x86/hardswish_x86_fma.h"
+  "layer/x86/innerproduct_x86_avx.cpp"
+  "layer/x86/innerproduct_x86_avx.h"
+  "layer/x86/innerproduct_x86_avx512.cpp"
+  "layer/x86/innerproduct_x86_avx512.h"
+  "layer/x86/innerproduct_x86_fma.cpp"
+  "layer/x86/innerproduct_x86_fma.h"
+  "layer/x86/interp_x86_avx.cpp"
+  "layer/x86/interp_x86_avx.h"
+  "layer/x86/interp_x86_avx512.cpp"
+  "layer/x86/interp_x86_avx512.h"
+  "layer/x86/interp_x86_fma.cpp"
+  "layer/x86/interp_x86_fma.h"
+  "layer/x86/layernorm_x86_avx.cpp"
+  "layer/x86/layernorm_x86_avx.h"
+  "layer/x86/layernorm_x86_avx512.cpp"
+  "layer/x86/layernorm_x86_avx512.h"
+  "layer/x86/layernorm_x86_fma.cpp"
+  "layer/x86/layernorm_x86_fma.h"
+  "layer/x86/lrn_x86_avx.cpp"
+  "layer/x86/lrn_x86_avx.h"
+  "layer/x86/lrn_x86_avx512.cpp"
+  "layer/x86/lrn_x86_avx512.h"
+  "layer/x86/lrn_x86_fma.cpp"
+  "layer/x86/lrn_x86_fma.h"
+  "layer/x86/lstm_x86_avx.cpp"
+  "layer/x86/lstm_x86_avx.h"
+  "layer/x86/lstm_x86_avx512.cpp"
+  "layer/x86/lstm_x86_avx512.h"
+  "layer/x86/lstm_x86_fma.cpp"
+  "layer/x86/lstm_x86_fma.h"
+  "layer/x86/matmul_x86_avx.cpp"
+  "layer/x86/matmul_x86_avx.h"
+  "layer/x86/matmul_x86_avx512.cpp"
+  "layer/x86/matmul_x86_avx512.h"
+  "layer/x86/matmul_x86_fma.cpp"
+  "layer/x86/matmul_x86_fma.h"
+  "layer/x86/mish_x86_avx.cpp"
+  "layer/x86/mish_x86_avx.h"
+  "layer/x86/mish_x86_avx512.cpp"
+  "layer/x86/mish_x86_avx512.h"
+  "layer/x86/mish_x86_fma.cpp"
+  "layer/x86/mish_x86_fma.h"
+  "layer/x86/multiheadattention_x86_avx.cpp"
+  "layer/x86/multiheadattention_x86_avx.h"
+  "layer/x86/multiheadattention_x86_avx512.cpp"
+  "layer/x86/multiheadattention_x86_avx512.h"
+  "layer/x86/multiheadattention_x86_fma.cpp"
+  "layer/x86/multiheadattention_x86_fma.h"
+  "layer/x86/packing_x86_avx.cpp"
+  "layer/x86/packing_x86_avx.h"
+  "layer/x86/packing_x86_avx512.cpp"
+  "layer/x86/packing_x86_avx512.h"
+  "layer/x86/packing_x86_fma.cpp"
+  "layer/x86/packing_x86_fma.h"
+  "layer/x86/padding_x86_avx.cpp"
+  "layer/x86/padding_x86_avx.h"
+  "layer/x86/padding_x86_avx512.cpp"
+  "layer/x86/padding_x86_avx512.h"
+  "layer/x86/padding_x86_fma.cpp"
+  "layer/x86/padding_x86_fma.h"
+  "layer/x86/permute_x86_avx.cpp"
+  "layer/x86/permute_x86_avx.h"
+  "layer/x86/permute_x86_avx512.cpp"
+  "layer/x86/permute_x86_avx512.h"
+  "layer/x86/permute_x86_fma.cpp"
+  "layer/x86/permute_x86_fma.h"
+  "layer/x86/pixelshuffle_x86_avx.cpp"
+  "layer/x86/pixelshuffle_x86_avx.h"
+  "layer/x86/pixelshuffle_x86_avx512.cpp"
+  "layer/x86/pixelshuffle_x86_avx512.h"
+  "layer/x86/pixelshuffle_x86_fma.cpp"
+  "layer/x86/pixelshuffle_x86_fma.h"
+  "layer/x86/pooling_x86_avx.cpp"
+  "layer/x86/pooling_x86_avx.h"
+  "layer/x86/pooling_x86_avx512.cpp"
+  "layer/x86/pooling_x86_avx512.h"
+  "layer/x86/pooling_x86_fma.cpp"
+  "layer/x86/pooling_x86_fma.h"
+  "layer/x86/prelu_x86_avx.cpp"
+  "layer/x86/prelu_x86_avx.h"
+  "layer/x86/prelu_x86_avx512.cpp"
+  "layer/x86/prelu_x86_avx512.h"
+  "layer/x86/prelu_x86_fma.cpp"
+  "layer/x86/prelu_x86_fma.h"
+  "layer/x86/quantize_x86_avx.cpp"
+  "layer/x86/quantize_x86_avx.h"
+  "layer/x86/quantize_x86_avx512.cpp"
+  "layer/x86/quantize_x86_avx512.h"
+  "layer/x86/quantize_x86_fma.cpp"
+  "layer/x86/quantize_x86_fma.h"
+  "layer/x86/reduction_x86_avx.cpp"
+  "layer/x86/reduction_x86_avx.h"
+  "layer/x86/reduction_x86_avx512.cpp"
+  "layer/x86/reduction_x86_avx512.h"
+  "layer/x86/reduction_x86_fma.cpp"
+  "layer/x86/reduction_x86_fma.h"
+  "layer/x86/relu_x86_avx.cpp"
+  "layer/x86/relu_x86_avx.h"
+  "layer/x86/relu_x86_avx512.cpp"
+  "layer/x86/relu_x86_avx512.h"
+  "layer/x86/relu_x86_fma.cpp"
+  "layer/x86/relu_x86_fma.h"
+  "layer/x86/requantize_x86_avx.cpp"
+  "layer/x86/requantize_x86_avx.h"
+  "layer/x86/requantize_x86_avx512.cpp"
+  "layer/x86/requantize_x86_avx512.h"
+  "layer/x86/requantize_x86_fma.cpp"
+  "layer/x86/requantize_x86_fma.h"
+  "layer/x86/reshape_x86_avx.cpp"
+  "layer/x86/reshape_x86_avx.h"
+  "layer/x86/reshape_x86_avx512.cpp"
+  "layer/x86/reshape_x86_avx512.h"
+  "layer/x86/reshape_x86_fma.cpp"
+  "layer/x86/reshape_x86_fma.h"
+  "layer/x86/rmsnorm_x86_avx.cpp"
+  "layer/x86/rmsnorm_x86_avx.h"
+  "layer/x86/rmsnorm_x86_avx512.cpp"
+  "layer/x86/rmsnorm_x86_avx512.h"
+  "layer/x86/rmsnorm_x86_fma.cpp"
+  "layer/x86/rmsnorm_x86_fma.h"
+  "layer/x86/rnn_x86_avx.cpp"
+  "layer/x86/rnn_x86_avx.h"
+  "layer/x86/rnn_x86_avx512.cpp"
+  "layer/x86/rnn_x86_avx512.h"
+  "layer/x86/rnn_x86_fma.cpp"
+  "layer/x86/rnn_x86_fma.h"
+  "layer/x86/roialign_x86_avx.cpp"
+  "layer/x86/roialign_x86_avx.h"
+  "layer/x86/roialign_x86_avx512.cpp"
+  "layer/x86/roialign_x86_avx512.h"
+  "layer/x86/roialign_x86_fma.cpp"
+  "layer/x86/roialign_x86_fma.h"
+  "layer/x86/scale_x86_avx.cpp"
+  "layer/x86/scale_x86_avx.h"
+  "layer/x86/scale_x86_avx512.cpp"
+  "layer/x86/scale_x86_avx512.h"
+  "layer/x86/scale_x86_fma.cpp"
+  "layer/x86/scale_x86_fma.h"
+  "layer/x86/selu_x86_avx.cpp"
+  "layer/x86/selu_x86_avx.h"
+  "layer/x86/selu_x86_avx512.cpp"
+  "layer/x86/selu_x86_avx512.h"
+  "layer/x86/selu_x86_fma.cpp"
+  "layer/x86/selu_x86_fma.h"
+  "layer/x86/shufflechannel_x86_avx.cpp"
+  "layer/x86/shufflechannel_x86_avx.h"
+  "layer/x86/shufflechannel_x86_avx512.cpp"
+  "layer/x86/shufflechannel_x86_avx512.h"
+  "layer/x86/shufflechannel_x86_fma.cpp"
+  "layer/x86/shufflechannel_x86_fma.h"
+  "layer/x86/sigmoid_x86_avx.cpp"
+  "layer/x86/sigmoid_x86_avx.h"
+  "layer/x86/sigmoid_x86_avx512.cpp"
+  "layer/x86/sigmoid_x86_avx512.h"
+  "layer/x86/sigmoid_x86_fma.cpp"
+  "layer/x86/sigmoid_x86_fma.h"
+  "layer/x86/slice_x86_avx.cpp"
+  "layer/x86/slice_x86_avx.h"
+  "layer/x86/slice_x86_avx512.cpp"
+  "layer/x86/slice_x86_avx512.h"
+  "layer/x86/slice_x86_fma.cpp"
+  "layer/x86/slice_x86_fma.h"
+  "layer/x86/softmax_x86_avx.cpp"
+  "layer/x86/softmax_x86_avx.h"
+  "layer/x86/softmax_x86_avx512.cpp"
+  "layer/x86/softmax_x86_avx512.h"
+  "layer/x86/softmax_x86_fma.cpp"
+  "layer/x86/softmax_x86_fma.h"
+  "layer/x86/squeeze_x86_avx.cpp"
+  "layer/x86/squeeze_x86_avx.h"
+  "layer/x86/squeeze_x86_avx512.cpp"
+  "layer/x86/squeeze_x86_avx512.h"
+  "layer/x86/squeeze_x86_fma.cpp"
+  "layer/x86/squeeze_x86_fma.h"
+  "layer/x86/swish_x86_avx.cpp"
+  "layer/x86/swish_x86_avx.h"
+  "layer/x86/swish_x86_avx512.cpp"
+  "layer/x86/swish_x86_avx512.h"
+  "layer/x86/swish_x86_fma.cpp"
+  "layer/x86/swish_x86_fma.h"
+  "layer/x86/tanh_x86_avx.cpp"
+  "layer/x86/tanh_x86_avx.h"
+  "layer/x86/tanh_x86_avx512.cpp"
+  "layer/x86/tanh_x86_avx512.h"
+  "layer/x86/tanh_x86_fma.cpp"
+  "layer/x86/tanh_x86_fma.h"
+  "layer/x86/tile_x86_avx.cpp"
+  "layer/x86/tile_x86_avx.h"
+  "layer/x86/tile_x86_avx512.cpp"
+  "layer/x86/tile_x86_avx512.h"
+  "layer/x86/tile_x86_fma.cpp"
+  "layer/x86/tile_x86_fma.h"
+  "layer/x86/unaryop_x86_avx.cpp"
+  "layer/x86/unaryop_x86_avx.h"
+  "layer/x86/unaryop_x86_avx512.cpp"
+  "layer/x86/unaryop_x86_avx512.h"
+  "layer/x86/unaryop_x86_fma.cpp"
+  "layer/x86/unaryop_x86_fma.h"
+  "layer/x86/yolov3detectionoutput_x86_avx.cpp"
+  "layer/x86/yolov3detectionoutput_x86_avx.h"
+  "layer/x86/yolov3detectionoutput_x86_avx512.cpp"
+  "layer/x86/yolov3detectionoutput_x86_avx512.h"
+  "layer/x86/yolov3detectionoutput_x86_fma.cpp"
+  "layer/x86/yolov3detectionoutput_x86_fma.h"
+  "libncnn.a"
+  "libncnn.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ncnn.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,33 @@
+// JasonZhang892 is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2022 JasonZhang892 <zqhy_0929@163.com>. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef LAYER_BNLL_X86_AVX_H
+#define LAYER_BNLL_X86_AVX_H
+
+#include "bnll.h"
+
+namespace ncnn {
+
+class BNLL_x86_avx : public BNLL
+{
+public:
+    BNLL_x86_avx();
+    virtual int forward_inplace(Mat& bottom_top_blob, const Option& opt) const;
+
+public:
+};
+
+} // namespace ncnn
+
+#endif // LAYER_BNLL_H
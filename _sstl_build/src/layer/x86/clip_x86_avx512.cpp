@@ -0,0 +1,119 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2017 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "clip_x86_avx512.h"
+
+#if __SSE2__
+#include <emmintrin.h>
+#if __AVX__
+#include <immintrin.h>
+#endif // __AVX__
+#endif // __SSE2__
+
+#include "x86_activation.h"
+
+namespace ncnn {
+
+Clip_x86_avx512::Clip_x86_avx512()
+{
+#if __SSE2__
+    support_packing = true;
+#endif // __SSE2__
+#if NCNN_BF16
+    support_bf16_storage = true;
+#endif
+}
+
+int Clip_x86_avx512::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
+{
+#if NCNN_BF16
+    if (opt.use_bf16_storage && bottom_top_blob.elembits() == 16)
+        return forward_inplace_bf16s(bottom_top_blob, opt);
+#endif
+
+    int w = bottom_top_blob.w;
+    int h = bottom_top_blob.h;
+    int d = bottom_top_blob.d;
+    int channels = bottom_top_blob.c;
+    int elempack = bottom_top_blob.elempack;
+    int size = w * h * d * elempack;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < channels; q++)
+    {
+        float* ptr = bottom_top_blob.channel(q);
+
+        int i = 0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+        __m512 _min_avx512 = _mm512_set1_ps(min);
+        __m512 _max_avx512 = _mm512_set1_ps(max);
+        for (; i + 15 < size; i += 16)
+        {
+            __m512 _p = _mm512_loadu_ps(ptr);
+            _p = _mm512_max_ps(_p, _min_avx512);
+            _p = _mm512_min_ps(_p, _max_avx512);
+            _mm512_storeu_ps(ptr, _p);
+            ptr += 16;
+        }
+#endif // __AVX512F__
+        __m256 _min_avx = _mm256_set1_ps(min);
+        __m256 _max_avx = _mm256_set1_ps(max);
+        for (; i + 7 < size; i += 8)
+        {
+            __m256 _p = _mm256_loadu_ps(ptr);
+            _p = _mm256_max_ps(_p, _min_avx);
+            _p = _mm256_min_ps(_p, _max_avx);
+            _mm256_storeu_ps(ptr, _p);
+            ptr += 8;
+        }
+#endif // __AVX__
+        __m128 _min = _mm_set1_ps(min);
+        __m128 _max = _mm_set1_ps(max);
+        for (; i + 3 < size; i += 4)
+        {
+            __m128 _p = _mm_load_ps(ptr);
+            _p = _mm_max_ps(_p, _min);
+            _p = _mm_min_ps(_p, _max);
+            _mm_store_ps(ptr, _p);
+            ptr += 4;
+        }
+#endif // __SSE2__
+        for (; i < size; i++)
+        {
+            if (*ptr < min)
+                *ptr = min;
+            if (*ptr > max)
+                *ptr = max;
+            ptr++;
+        }
+    }
+
+    return 0;
+}
+
+#if NCNN_BF16
+int Clip_x86_avx512::forward_inplace_bf16s(Mat& bottom_top_blob, const Option& opt) const
+{
+    Mat activation_params(2);
+    activation_params[0] = min;
+    activation_params[1] = max;
+    activation_inplace_bf16s(bottom_top_blob, 3, activation_params, opt);
+
+    return 0;
+}
+#endif // NCNN_BF16
+
+} //namespace ncnn
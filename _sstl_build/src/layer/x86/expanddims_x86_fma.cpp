@@ -0,0 +1,100 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "expanddims_x86_fma.h"
+
+namespace ncnn {
+
+ExpandDims_x86_fma::ExpandDims_x86_fma()
+{
+#if __SSE2__
+    support_packing = true;
+#endif // __SSE2__
+#if NCNN_BF16
+    support_bf16_storage = true;
+#endif
+}
+
+int ExpandDims_x86_fma::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    int dims = bottom_blob.dims;
+    int elempack = bottom_blob.elempack;
+
+    if (elempack == 1)
+        return ExpandDims::forward(bottom_blob, top_blob, opt);
+
+    bool _expand_w = false;
+    bool _expand_h = false;
+    bool _expand_d = false;
+    bool _expand_c = false;
+
+    if (axes.empty())
+    {
+        _expand_w = expand_w;
+        _expand_h = expand_h;
+        _expand_d = expand_d;
+        _expand_c = expand_c;
+    }
+    else
+    {
+        const int* axes_ptr = axes;
+        for (int i = 0; i < axes.w; i++)
+        {
+            int axis = axes_ptr[i];
+            if (axis < 0)
+                axis = dims + 1 + axis;
+
+            if (dims == 1 && axis == 0)
+                _expand_h = true;
+            if (dims == 1 && axis == 1)
+                _expand_w = true;
+            if (dims == 2 && axis == 0)
+                _expand_c = true;
+            if (dims == 2 && axis == 1)
+                _expand_h = true;
+            if (dims == 2 && axis == 2)
+                _expand_w = true;
+            if (dims == 3 && axis == 0)
+                _expand_c = true;
+            if (dims == 3 && axis == 1)
+                _expand_d = true;
+            if (dims == 3 && axis == 2)
+                _expand_h = true;
+            if (dims == 3 && axis == 3)
+                _expand_w = true;
+        }
+    }
+
+    // the packed axis is the outermost one, a new outermost axis pushes it inward
+    // any other new axis is a plain reshape that keeps the packing
+    bool expand_outer = false;
+    if (dims == 1)
+        expand_outer = _expand_h;
+    if (dims == 2)
+        expand_outer = _expand_c && !_expand_w && !_expand_h;
+    if (dims == 3)
+        expand_outer = _expand_c && !_expand_w && !_expand_h && !_expand_d;
+
+    if (!expand_outer)
+        return ExpandDims::forward(bottom_blob, top_blob, opt);
+
+    Mat bottom_blob_unpacked;
+    convert_packing(bottom_blob, bottom_blob_unpacked, 1, opt);
+    if (bottom_blob_unpacked.empty())
+        return -100;
+
+    return ExpandDims::forward(bottom_blob_unpacked, top_blob, opt);
+}
+
+} // namespace ncnn
@@ -0,0 +1,702 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "gru_x86_avx.h"
+
+#if __SSE2__
+#include <emmintrin.h>
+#include "sse_mathfun.h"
+#if __AVX__
+#include <immintrin.h>
+#include "avx_mathfun.h"
+#if __AVX512F__
+#include "avx512_mathfun.h"
+#endif // __AVX512F__
+#endif // __AVX__
+#endif // __SSE2__
+
+#include "x86_activation.h"
+#include "x86_usability.h"
+
+#include "cpu.h"
+
+namespace ncnn {
+
+#include "gru_int8.h"
+
+GRU_x86_avx::GRU_x86_avx()
+{
+    one_blob_only = false;
+    support_inplace = false;
+}
+
+static int gru_group_width(int q, int num_output)
+{
+    // hidden units are packed in groups of the widest float vector that still fits
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    if (q + 15 < num_output)
+        return 16;
+#endif // __AVX512F__
+    if (q + 7 < num_output)
+        return 8;
+#endif // __AVX__
+    if (q + 3 < num_output)
+        return 4;
+#endif // __SSE2__
+    return 1;
+}
+
+int GRU_x86_avx::create_pipeline(const Option& opt)
+{
+#if NCNN_INT8
+    if (int8_scale_term)
+    {
+        return create_pipeline_int8(opt);
+    }
+#endif
+
+    // pack RUN
+    // a group of n hidden units holds
+    //   xc  for each input    R n U n N n
+    //   hc  for each hidden   R n U n N n
+    //   bias                  R n U n BN n WN n
+    // so the group starting at hidden unit q is found at row q
+    const int num_directions = direction == 2 ? 2 : 1;
+    const int size = weight_data_size / num_directions / num_output / 3;
+
+    weight_xc_data_packed.create(size * 3, num_output, num_directions);
+    bias_c_data_packed.create(4, num_output, num_directions);
+    weight_hc_data_packed.create(num_output * 3, num_output, num_directions);
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int dr = 0; dr < num_directions; dr++)
+    {
+        const Mat weight_xc = weight_xc_data.channel(dr);
+        const Mat bias_c = bias_c_data.channel(dr);
+        const Mat weight_hc = weight_hc_data.channel(dr);
+
+        Mat weight_xc_data_packed_dr = weight_xc_data_packed.channel(dr);
+        Mat bias_c_data_packed_dr = bias_c_data_packed.channel(dr);
+        Mat weight_hc_data_packed_dr = weight_hc_data_packed.channel(dr);
+
+        const float* bias_c_R = bias_c.row(0);
+        const float* bias_c_U = bias_c.row(1);
+        const float* bias_c_WN = bias_c.row(2);
+        const float* bias_c_BN = bias_c.row(3);
+
+        for (int q = 0; q < num_output;)
+        {
+            const int n = gru_group_width(q, num_output);
+
+            float* bias_c_RUBNWN = bias_c_data_packed_dr.row(q);
+            float* weight_xc_RUN = weight_xc_data_packed_dr.row(q);
+            float* weight_hc_RUN = weight_hc_data_packed_dr.row(q);
+
+            for (int j = 0; j < n; j++)
+            {
+                bias_c_RUBNWN[j] = bias_c_R[q + j];
+                bias_c_RUBNWN[n + j] = bias_c_U[q + j];
+                bias_c_RUBNWN[n * 2 + j] = bias_c_BN[q + j];
+                bias_c_RUBNWN[n * 3 + j] = bias_c_WN[q + j];
+            }
+
+            for (int i = 0; i < size; i++)
+            {
+                for (int g = 0; g < 3; g++)
+                {
+                    for (int j = 0; j < n; j++)
+                    {
+                        weight_xc_RUN[j] = weight_xc.row(num_output * g + q + j)[i];
+                    }
+                    weight_xc_RUN += n;
+                }
+            }
+
+            for (int i = 0; i < num_output; i++)
+            {
+                for (int g = 0; g < 3; g++)
+                {
+                    for (int j = 0; j < n; j++)
+                    {
+                        weight_hc_RUN[j] = weight_hc.row(num_output * g + q + j)[i];
+                    }
+                    weight_hc_RUN += n;
+                }
+            }
+
+            q += n;
+        }
+    }
+
+    if (opt.lightmode)
+    {
+        weight_xc_data.release();
+        bias_c_data.release();
+        weight_hc_data.release();
+    }
+
+    return 0;
+}
+
+static int gru(const Mat& bottom_blob, Mat& top_blob, int reverse, const Mat& weight_xc, const Mat& bias_c, const Mat& weight_hc, Mat& hidden_state, const Option& opt)
+{
+    int size = bottom_blob.w;
+    int T = bottom_blob.h;
+
+    int num_output = top_blob.w;
+
+    // U and N of each hidden unit
+    Mat gates(num_output, 2, 4u, opt.workspace_allocator);
+    if (gates.empty())
+        return -100;
+
+    // unroll
+    for (int t = 0; t < T; t++)
+    {
+        int ti = reverse ? T - 1 - t : t;
+
+        const float* x = bottom_blob.row(ti);
+        const float* hidden_ptr = hidden_state;
+        float* gates_U = gates.row(0);
+        float* gates_N = gates.row(1);
+
+        // every group reads the whole input and hidden state and writes only its own gates
+        int remain_num_output_start = 0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+        int nn_num_output = num_output >> 4;
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int qq = 0; qq < nn_num_output; qq++)
+        {
+            const int q = qq * 16;
+
+            const float* bias_c_RUBNWN = bias_c.row(q);
+            const float* weight_xc_RUN = weight_xc.row(q);
+            const float* weight_hc_RUN = weight_hc.row(q);
+
+            __m512 _R = _mm512_loadu_ps(bias_c_RUBNWN);
+            __m512 _U = _mm512_loadu_ps(bias_c_RUBNWN + 16);
+            __m512 _Nh = _mm512_loadu_ps(bias_c_RUBNWN + 32);
+            __m512 _Nx = _mm512_loadu_ps(bias_c_RUBNWN + 48);
+
+            for (int i = 0; i < size; i++)
+            {
+                __m512 _xi = _mm512_set1_ps(x[i]);
+                _R = _mm512_fmadd_ps(_mm512_loadu_ps(weight_xc_RUN), _xi, _R);
+                _U = _mm512_fmadd_ps(_mm512_loadu_ps(weight_xc_RUN + 16), _xi, _U);
+                _Nx = _mm512_fmadd_ps(_mm512_loadu_ps(weight_xc_RUN + 32), _xi, _Nx);
+                weight_xc_RUN += 48;
+            }
+
+            for (int i = 0; i < num_output; i++)
+            {
+                __m512 _h_cont = _mm512_set1_ps(hidden_ptr[i]);
+                _R = _mm512_fmadd_ps(_mm512_loadu_ps(weight_hc_RUN), _h_cont, _R);
+                _U = _mm512_fmadd_ps(_mm512_loadu_ps(weight_hc_RUN + 16), _h_cont, _U);
+                _Nh = _mm512_fmadd_ps(_mm512_loadu_ps(weight_hc_RUN + 32), _h_cont, _Nh);
+                weight_hc_RUN += 48;
+            }
+
+            // sigmoid(R)
+            // sigmoid(U)
+            // tanh(N)
+            _R = sigmoid_avx512(_R);
+            _U = sigmoid_avx512(_U);
+            __m512 _N = tanh_avx512(_mm512_fmadd_ps(_R, _Nh, _Nx));
+
+            _mm512_storeu_ps(gates_U + q, _U);
+            _mm512_storeu_ps(gates_N + q, _N);
+        }
+
+        remain_num_output_start += nn_num_output << 4;
+#endif // __AVX512F__
+        int nn_num_output_8 = (num_output - remain_num_output_start) >> 3;
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int qq = 0; qq < nn_num_output_8; qq++)
+        {
+            const int q = remain_num_output_start + qq * 8;
+
+            const float* bias_c_RUBNWN = bias_c.row(q);
+            const float* weight_xc_RUN = weight_xc.row(q);
+            const float* weight_hc_RUN = weight_hc.row(q);
+
+            __m256 _R = _mm256_loadu_ps(bias_c_RUBNWN);
+            __m256 _U = _mm256_loadu_ps(bias_c_RUBNWN + 8);
+            __m256 _Nh = _mm256_loadu_ps(bias_c_RUBNWN + 16);
+            __m256 _Nx = _mm256_loadu_ps(bias_c_RUBNWN + 24);
+
+            for (int i = 0; i < size; i++)
+            {
+                __m256 _xi = _mm256_set1_ps(x[i]);
+                _R = _mm256_comp_fmadd_ps(_mm256_loadu_ps(weight_xc_RUN), _xi, _R);
+                _U = _mm256_comp_fmadd_ps(_mm256_loadu_ps(weight_xc_RUN + 8), _xi, _U);
+                _Nx = _mm256_comp_fmadd_ps(_mm256_loadu_ps(weight_xc_RUN + 16), _xi, _Nx);
+                weight_xc_RUN += 24;
+            }
+
+            for (int i = 0; i < num_output; i++)
+            {
+                __m256 _h_cont = _mm256_set1_ps(hidden_ptr[i]);
+                _R = _mm256_comp_fmadd_ps(_mm256_loadu_ps(weight_hc_RUN), _h_cont, _R);
+                _U = _mm256_comp_fmadd_ps(_mm256_loadu_ps(weight_hc_RUN + 8), _h_cont, _U);
+                _Nh = _mm256_comp_fmadd_ps(_mm256_loadu_ps(weight_hc_RUN + 16), _h_cont, _Nh);
+                weight_hc_RUN += 24;
+            }
+
+            _R = sigmoid_avx(_R);
+            _U = sigmoid_avx(_U);
+            __m256 _N = tanh_avx(_mm256_comp_fmadd_ps(_R, _Nh, _Nx));
+
+            _mm256_storeu_ps(gates_U + q, _U);
+            _mm256_storeu_ps(gates_N + q, _N);
+        }
+
+        remain_num_output_start += nn_num_output_8 << 3;
+#endif // __AVX__
+        int nn_num_output_4 = (num_output - remain_num_output_start) >> 2;
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int qq = 0; qq < nn_num_output_4; qq++)
+        {
+            const int q = remain_num_output_start + qq * 4;
+
+            const float* bias_c_RUBNWN = bias_c.row(q);
+            const float* weight_xc_RUN = weight_xc.row(q);
+            const float* weight_hc_RUN = weight_hc.row(q);
+
+            __m128 _R = _mm_loadu_ps(bias_c_RUBNWN);
+            __m128 _U = _mm_loadu_ps(bias_c_RUBNWN + 4);
+            __m128 _Nh = _mm_loadu_ps(bias_c_RUBNWN + 8);
+            __m128 _Nx = _mm_loadu_ps(bias_c_RUBNWN + 12);
+
+            for (int i = 0; i < size; i++)
+            {
+                __m128 _xi = _mm_set1_ps(x[i]);
+                _R = _mm_comp_fmadd_ps(_mm_loadu_ps(weight_xc_RUN), _xi, _R);
+                _U = _mm_comp_fmadd_ps(_mm_loadu_ps(weight_xc_RUN + 4), _xi, _U);
+                _Nx = _mm_comp_fmadd_ps(_mm_loadu_ps(weight_xc_RUN + 8), _xi, _Nx);
+                weight_xc_RUN += 12;
+            }
+
+            for (int i = 0; i < num_output; i++)
+            {
+                __m128 _h_cont = _mm_set1_ps(hidden_ptr[i]);
+                _R = _mm_comp_fmadd_ps(_mm_loadu_ps(weight_hc_RUN), _h_cont, _R);
+                _U = _mm_comp_fmadd_ps(_mm_loadu_ps(weight_hc_RUN + 4), _h_cont, _U);
+                _Nh = _mm_comp_fmadd_ps(_mm_loadu_ps(weight_hc_RUN + 8), _h_cont, _Nh);
+                weight_hc_RUN += 12;
+            }
+
+            _R = sigmoid_sse(_R);
+            _U = sigmoid_sse(_U);
+            __m128 _N = tanh_sse(_mm_comp_fmadd_ps(_R, _Nh, _Nx));
+
+            _mm_storeu_ps(gates_U + q, _U);
+            _mm_storeu_ps(gates_N + q, _N);
+        }
+
+        remain_num_output_start += nn_num_output_4 << 2;
+#endif // __SSE2__
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int q = remain_num_output_start; q < num_output; q++)
+        {
+            const float* bias_c_RUBNWN = bias_c.row(q);
+            const float* weight_xc_RUN = weight_xc.row(q);
+            const float* weight_hc_RUN = weight_hc.row(q);
+
+            float R = bias_c_RUBNWN[0];
+            float U = bias_c_RUBNWN[1];
+            float Nh = bias_c_RUBNWN[2];
+            float Nx = bias_c_RUBNWN[3];
+
+            for (int i = 0; i < size; i++)
+            {
+                float xi = x[i];
+
+                R += weight_xc_RUN[0] * xi;
+                U += weight_xc_RUN[1] * xi;
+                Nx += weight_xc_RUN[2] * xi;
+
+                weight_xc_RUN += 3;
+            }
+
+            for (int i = 0; i < num_output; i++)
+            {
+                float h_cont = hidden_ptr[i];
+
+                R += weight_hc_RUN[0] * h_cont;
+                U += weight_hc_RUN[1] * h_cont;
+                Nh += weight_hc_RUN[2] * h_cont;
+
+                weight_hc_RUN += 3;
+            }
+
+            R = 1.f / (1.f + expf(-R));
+            U = 1.f / (1.f + expf(-U));
+            float N = tanhf(Nx + R * Nh);
+
+            gates_U[q] = U;
+            gates_N[q] = N;
+        }
+
+        // h_t := (1 - update) .* new + update .* h_{t-1}
+        gru_gate_output(gates, hidden_state, top_blob.row(ti));
+    }
+
+    return 0;
+}
+
+int GRU_x86_avx::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+#if NCNN_INT8
+    if (int8_scale_term)
+    {
+        return forward_int8(bottom_blob, top_blob, opt);
+    }
+#endif
+
+    int T = bottom_blob.h;
+
+    int num_directions = direction == 2 ? 2 : 1;
+
+    // initial hidden state
+    Mat hidden(num_output, 4u, opt.workspace_allocator);
+    if (hidden.empty())
+        return -100;
+    hidden.fill(0.f);
+
+    top_blob.create(num_output * num_directions, T, 4u, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    // Uni directional
+    if (direction == 0 || direction == 1)
+    {
+        int ret = gru(bottom_blob, top_blob, direction, weight_xc_data_packed.channel(0), bias_c_data_packed.channel(0), weight_hc_data_packed.channel(0), hidden, opt);
+        if (ret != 0)
+            return ret;
+    }
+
+    if (direction == 2)
+    {
+        Mat top_blob_forward(num_output, T, 4u, opt.workspace_allocator);
+        if (top_blob_forward.empty())
+            return -100;
+
+        Mat top_blob_reverse(num_output, T, 4u, opt.workspace_allocator);
+        if (top_blob_reverse.empty())
+            return -100;
+
+        {
+            int ret = gru(bottom_blob, top_blob_forward, 0, weight_xc_data_packed.channel(0), bias_c_data_packed.channel(0), weight_hc_data_packed.channel(0), hidden, opt);
+            if (ret != 0)
+                return ret;
+        }
+
+        hidden.fill(0.0f);
+
+        {
+            int ret = gru(bottom_blob, top_blob_reverse, 1, weight_xc_data_packed.channel(1), bias_c_data_packed.channel(1), weight_hc_data_packed.channel(1), hidden, opt);
+            if (ret != 0)
+                return ret;
+        }
+
+        // concat w
+        for (int i = 0; i < T; i++)
+        {
+            const float* pf = top_blob_forward.row(i);
+            const float* pr = top_blob_reverse.row(i);
+            float* ptr = top_blob.row(i);
+
+            memcpy(ptr, pf, num_output * sizeof(float));
+            memcpy(ptr + num_output, pr, num_output * sizeof(float));
+        }
+    }
+
+    return 0;
+}
+
+int GRU_x86_avx::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+{
+#if NCNN_INT8
+    if (int8_scale_term)
+    {
+        return forward_int8(bottom_blobs, top_blobs, opt);
+    }
+#endif
+
+    const Mat& bottom_blob = bottom_blobs[0];
+    int T = bottom_blob.h;
+    int num_directions = direction == 2 ? 2 : 1;
+
+    Mat hidden;
+    Allocator* hidden_allocator = top_blobs.size() == 2 ? opt.blob_allocator : opt.workspace_allocator;
+    if (bottom_blobs.size() == 2)
+    {
+        hidden = bottom_blobs[1].clone(hidden_allocator);
+    }
+    else
+    {
+        hidden.create(num_output, num_directions, 4u, hidden_allocator);
+        if (hidden.empty())
+            return -100;
+        hidden.fill(0.f);
+    }
+
+    Mat& top_blob = top_blobs[0];
+    top_blob.create(num_output * num_directions, T, 4u, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    // Uni directional
+    if (direction == 0 || direction == 1)
+    {
+        int ret = gru(bottom_blob, top_blob, direction, weight_xc_data_packed.channel(0), bias_c_data_packed.channel(0), weight_hc_data_packed.channel(0), hidden, opt);
+        if (ret != 0)
+            return ret;
+    }
+
+    if (direction == 2)
+    {
+        Mat top_blob_forward(num_output, T, 4u, opt.workspace_allocator);
+        if (top_blob_forward.empty())
+            return -100;
+
+        Mat top_blob_reverse(num_output, T, 4u, opt.workspace_allocator);
+        if (top_blob_reverse.empty())
+            return -100;
+
+        Mat hidden0 = hidden.row_range(0, 1);
+        {
+            int ret = gru(bottom_blob, top_blob_forward, 0, weight_xc_data_packed.channel(0), bias_c_data_packed.channel(0), weight_hc_data_packed.channel(0), hidden0, opt);
+            if (ret != 0)
+                return ret;
+        }
+
+        Mat hidden1 = hidden.row_range(1, 1);
+        {
+            int ret = gru(bottom_blob, top_blob_reverse, 1, weight_xc_data_packed.channel(1), bias_c_data_packed.channel(1), weight_hc_data_packed.channel(1), hidden1, opt);
+            if (ret != 0)
+                return ret;
+        }
+
+        // concat w
+        for (int i = 0; i < T; i++)
+        {
+            const float* pf = top_blob_forward.row(i);
+            const float* pr = top_blob_reverse.row(i);
+            float* ptr = top_blob.row(i);
+
+            memcpy(ptr, pf, num_output * sizeof(float));
+            memcpy(ptr + num_output, pr, num_output * sizeof(float));
+        }
+    }
+
+    if (top_blobs.size() == 2)
+    {
+        top_blobs[1] = hidden;
+    }
+
+    return 0;
+}
+
+#if NCNN_INT8
+int GRU_x86_avx::create_pipeline_int8(const Option& opt)
+{
+    // pack RUN
+    const int num_directions = direction == 2 ? 2 : 1;
+    const int size = weight_data_size / num_directions / num_output / 3;
+
+    gru_transform_weight_int8(weight_xc_data, weight_xc_data_int8_scales, weight_hc_data, weight_hc_data_int8_scales, bias_c_data, weight_data_tm, weight_data_tm_int8_descales, bias_c_data_packed, size, num_output, num_directions, opt);
+
+    if (opt.lightmode)
+    {
+        weight_xc_data.release();
+        bias_c_data.release();
+        weight_hc_data.release();
+        weight_xc_data_int8_scales.release();
+        weight_hc_data_int8_scales.release();
+    }
+
+    return 0;
+}
+
+static int gru_dynamic_quantize(const Mat& bottom_blob, Mat& bottom_blob_int8, Mat& bottom_blob_int8_descales, const Option& opt)
+{
+    int size = bottom_blob.w;
+    int T = bottom_blob.h;
+
+    // int8 range values widened to int16, the operand type of pmaddwd
+    bottom_blob_int8.create((size + 1) / 2 * 2, T, (size_t)2u, 1, opt.workspace_allocator);
+    if (bottom_blob_int8.empty())
+        return -100;
+
+    bottom_blob_int8_descales.create(T, (size_t)4u, 1, opt.workspace_allocator);
+    if (bottom_blob_int8_descales.empty())
+        return -100;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int t = 0; t < T; t++)
+    {
+        bottom_blob_int8_descales[t] = gru_dynamic_quantize_row(bottom_blob.row(t), size, bottom_blob_int8.row<short>(t));
+    }
+
+    return 0;
+}
+
+int GRU_x86_avx::forward_int8(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    int T = bottom_blob.h;
+
+    int num_directions = direction == 2 ? 2 : 1;
+
+    // initial hidden state
+    Mat hidden(num_output, 4u, opt.workspace_allocator);
+    if (hidden.empty())
+        return -100;
+    hidden.fill(0.f);
+
+    top_blob.create(num_output * num_directions, T, 4u, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    // dynamic quantize bottom_blob
+    Mat bottom_blob_int8;
+    Mat bottom_blob_int8_descales;
+    {
+        int ret = gru_dynamic_quantize(bottom_blob, bottom_blob_int8, bottom_blob_int8_descales, opt);
+        if (ret != 0)
+            return ret;
+    }
+
+    // Uni directional
+    if (direction == 0 || direction == 1)
+    {
+        gru_int8(bottom_blob_int8, bottom_blob_int8_descales, top_blob, direction, weight_data_tm.channel(0), weight_data_tm_int8_descales.channel(0), bias_c_data_packed.channel(0), hidden, opt);
+    }
+
+    if (direction == 2)
+    {
+        Mat top_blob_forward(num_output, T, 4u, opt.workspace_allocator);
+        if (top_blob_forward.empty())
+            return -100;
+
+        Mat top_blob_reverse(num_output, T, 4u, opt.workspace_allocator);
+        if (top_blob_reverse.empty())
+            return -100;
+
+        gru_int8(bottom_blob_int8, bottom_blob_int8_descales, top_blob_forward, 0, weight_data_tm.channel(0), weight_data_tm_int8_descales.channel(0), bias_c_data_packed.channel(0), hidden, opt);
+
+        hidden.fill(0.f);
+
+        gru_int8(bottom_blob_int8, bottom_blob_int8_descales, top_blob_reverse, 1, weight_data_tm.channel(1), weight_data_tm_int8_descales.channel(1), bias_c_data_packed.channel(1), hidden, opt);
+
+        // concat w
+        for (int i = 0; i < T; i++)
+        {
+            const float* pf = top_blob_forward.row(i);
+            const float* pr = top_blob_reverse.row(i);
+            float* ptr = top_blob.row(i);
+
+            memcpy(ptr, pf, num_output * sizeof(float));
+            memcpy(ptr + num_output, pr, num_output * sizeof(float));
+        }
+    }
+
+    return 0;
+}
+
+int GRU_x86_avx::forward_int8(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+{
+    const Mat& bottom_blob = bottom_blobs[0];
+    int T = bottom_blob.h;
+    int num_directions = direction == 2 ? 2 : 1;
+
+    Mat hidden;
+    Allocator* hidden_allocator = top_blobs.size() == 2 ? opt.blob_allocator : opt.workspace_allocator;
+    if (bottom_blobs.size() == 2)
+    {
+        hidden = bottom_blobs[1].clone(hidden_allocator);
+    }
+    else
+    {
+        hidden.create(num_output, num_directions, 4u, hidden_allocator);
+        if (hidden.empty())
+            return -100;
+        hidden.fill(0.f);
+    }
+
+    Mat& top_blob = top_blobs[0];
+    top_blob.create(num_output * num_directions, T, 4u, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    // dynamic quantize bottom_blob
+    Mat bottom_blob_int8;
+    Mat bottom_blob_int8_descales;
+    {
+        int ret = gru_dynamic_quantize(bottom_blob, bottom_blob_int8, bottom_blob_int8_descales, opt);
+        if (ret != 0)
+            return ret;
+    }
+
+    // Uni directional
+    if (direction == 0 || direction == 1)
+    {
+        gru_int8(bottom_blob_int8, bottom_blob_int8_descales, top_blob, direction, weight_data_tm.channel(0), weight_data_tm_int8_descales.channel(0), bias_c_data_packed.channel(0), hidden, opt);
+    }
+
+    if (direction == 2)
+    {
+        Mat top_blob_forward(num_output, T, 4u, opt.workspace_allocator);
+        if (top_blob_forward.empty())
+            return -100;
+
+        Mat top_blob_reverse(num_output, T, 4u, opt.workspace_allocator);
+        if (top_blob_reverse.empty())
+            return -100;
+
+        Mat hidden0 = hidden.row_range(0, 1);
+        gru_int8(bottom_blob_int8, bottom_blob_int8_descales, top_blob_forward, 0, weight_data_tm.channel(0), weight_data_tm_int8_descales.channel(0), bias_c_data_packed.channel(0), hidden0, opt);
+
+        Mat hidden1 = hidden.row_range(1, 1);
+        gru_int8(bottom_blob_int8, bottom_blob_int8_descales, top_blob_reverse, 1, weight_data_tm.channel(1), weight_data_tm_int8_descales.channel(1), bias_c_data_packed.channel(1), hidden1, opt);
+
+        // concat w
+        for (int i = 0; i < T; i++)
+        {
+            const float* pf = top_blob_forward.row(i);
+            const float* pr = top_blob_reverse.row(i);
+            float* ptr = top_blob.row(i);
+
+            memcpy(ptr, pf, num_output * sizeof(float));
+            memcpy(ptr + num_output, pr, num_output * sizeof(float));
+        }
+    }
+
+    if (top_blobs.size() == 2)
+    {
+        top_blobs[1] = hidden;
+    }
+
+    return 0;
+}
+#endif // NCNN_INT8
+
+} // namespace ncnn
@@ -0,0 +1,389 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "permute_x86_avx512.h"
+
+#if __SSE2__
+#include <emmintrin.h>
+#if __AVX__
+#include <immintrin.h>
+#endif // __AVX__
+#endif // __SSE2__
+
+#include "x86_usability.h"
+
+namespace ncnn {
+
+// the source axis of every output axis, axes are numbered w h d c from the innermost
+// the last one is the outermost axis, which is the packed axis of a packed blob
+static const int permute_order_2d[2][2] = {
+    {0, 1}, // w h
+    {1, 0}, // h w
+};
+
+static const int permute_order_3d[6][3] = {
+    {0, 1, 2}, // w h c
+    {1, 0, 2}, // h w c
+    {0, 2, 1}, // w c h
+    {2, 0, 1}, // c w h
+    {1, 2, 0}, // h c w
+    {2, 1, 0}, // c h w
+};
+
+static const int permute_order_4d[24][4] = {
+    {0, 1, 2, 3}, // w h d c
+    {1, 0, 2, 3}, // h w d c
+    {0, 2, 1, 3}, // w d h c
+    {2, 0, 1, 3}, // d w h c
+    {1, 2, 0, 3}, // h d w c
+    {2, 1, 0, 3}, // d h w c
+    {0, 1, 3, 2}, // w h c d
+    {1, 0, 3, 2}, // h w c d
+    {0, 3, 1, 2}, // w c h d
+    {3, 0, 1, 2}, // c w h d
+    {1, 3, 0, 2}, // h c w d
+    {3, 1, 0, 2}, // c h w d
+    {0, 2, 3, 1}, // w d c h
+    {2, 0, 3, 1}, // d w c h
+    {0, 3, 2, 1}, // w c d h
+    {3, 0, 2, 1}, // c w d h
+    {2, 3, 0, 1}, // d c w h
+    {3, 2, 0, 1}, // c d w h
+    {1, 2, 3, 0}, // h d c w
+    {2, 1, 3, 0}, // d h c w
+    {1, 3, 2, 0}, // h c d w
+    {3, 1, 2, 0}, // c h d w
+    {2, 3, 1, 0}, // d c h w
+    {3, 2, 1, 0}, // c d h w
+};
+
+Permute_x86_avx512::Permute_x86_avx512()
+{
+#if __SSE2__
+    support_packing = true;
+#endif // __SSE2__
+}
+
+static void permute_transpose_pack(const float* ptr, int stride, float* outptr, int outstride, int elempack)
+{
+    // read elempack vectors of elempack channels, stride apart
+    // write elempack vectors of elempack outer positions, outstride apart
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    if (elempack == 16)
+    {
+        __m512 _r0 = _mm512_loadu_ps(ptr);
+        __m512 _r1 = _mm512_loadu_ps(ptr + stride);
+        __m512 _r2 = _mm512_loadu_ps(ptr + stride * 2);
+        __m512 _r3 = _mm512_loadu_ps(ptr + stride * 3);
+        __m512 _r4 = _mm512_loadu_ps(ptr + stride * 4);
+        __m512 _r5 = _mm512_loadu_ps(ptr + stride * 5);
+        __m512 _r6 = _mm512_loadu_ps(ptr + stride * 6);
+        __m512 _r7 = _mm512_loadu_ps(ptr + stride * 7);
+        __m512 _r8 = _mm512_loadu_ps(ptr + stride * 8);
+        __m512 _r9 = _mm512_loadu_ps(ptr + stride * 9);
+        __m512 _ra = _mm512_loadu_ps(ptr + stride * 10);
+        __m512 _rb = _mm512_loadu_ps(ptr + stride * 11);
+        __m512 _rc = _mm512_loadu_ps(ptr + stride * 12);
+        __m512 _rd = _mm512_loadu_ps(ptr + stride * 13);
+        __m512 _re = _mm512_loadu_ps(ptr + stride * 14);
+        __m512 _rf = _mm512_loadu_ps(ptr + stride * 15);
+        transpose16x16_ps(_r0, _r1, _r2, _r3, _r4, _r5, _r6, _r7, _r8, _r9, _ra, _rb, _rc, _rd, _re, _rf);
+        _mm512_storeu_ps(outptr, _r0);
+        _mm512_storeu_ps(outptr + outstride, _r1);
+        _mm512_storeu_ps(outptr + outstride * 2, _r2);
+        _mm512_storeu_ps(outptr + outstride * 3, _r3);
+        _mm512_storeu_ps(outptr + outstride * 4, _r4);
+        _mm512_storeu_ps(outptr + outstride * 5, _r5);
+        _mm512_storeu_ps(outptr + outstride * 6, _r6);
+        _mm512_storeu_ps(outptr + outstride * 7, _r7);
+        _mm512_storeu_ps(outptr + outstride * 8, _r8);
+        _mm512_storeu_ps(outptr + outstride * 9, _r9);
+        _mm512_storeu_ps(outptr + outstride * 10, _ra);
+        _mm512_storeu_ps(outptr + outstride * 11, _rb);
+        _mm512_storeu_ps(outptr + outstride * 12, _rc);
+        _mm512_storeu_ps(outptr + outstride * 13, _rd);
+        _mm512_storeu_ps(outptr + outstride * 14, _re);
+        _mm512_storeu_ps(outptr + outstride * 15, _rf);
+        return;
+    }
+#endif // __AVX512F__
+    if (elempack == 8)
+    {
+        __m256 _r0 = _mm256_loadu_ps(ptr);
+        __m256 _r1 = _mm256_loadu_ps(ptr + stride);
+        __m256 _r2 = _mm256_loadu_ps(ptr + stride * 2);
+        __m256 _r3 = _mm256_loadu_ps(ptr + stride * 3);
+        __m256 _r4 = _mm256_loadu_ps(ptr + stride * 4);
+        __m256 _r5 = _mm256_loadu_ps(ptr + stride * 5);
+        __m256 _r6 = _mm256_loadu_ps(ptr + stride * 6);
+        __m256 _r7 = _mm256_loadu_ps(ptr + stride * 7);
+        transpose8x8_ps(_r0, _r1, _r2, _r3, _r4, _r5, _r6, _r7);
+        _mm256_storeu_ps(outptr, _r0);
+        _mm256_storeu_ps(outptr + outstride, _r1);
+        _mm256_storeu_ps(outptr + outstride * 2, _r2);
+        _mm256_storeu_ps(outptr + outstride * 3, _r3);
+        _mm256_storeu_ps(outptr + outstride * 4, _r4);
+        _mm256_storeu_ps(outptr + outstride * 5, _r5);
+        _mm256_storeu_ps(outptr + outstride * 6, _r6);
+        _mm256_storeu_ps(outptr + outstride * 7, _r7);
+        return;
+    }
+#endif // __AVX__
+    if (elempack == 4)
+    {
+        __m128 _r0 = _mm_loadu_ps(ptr);
+        __m128 _r1 = _mm_loadu_ps(ptr + stride);
+        __m128 _r2 = _mm_loadu_ps(ptr + stride * 2);
+        __m128 _r3 = _mm_loadu_ps(ptr + stride * 3);
+        _MM_TRANSPOSE4_PS(_r0, _r1, _r2, _r3);
+        _mm_storeu_ps(outptr, _r0);
+        _mm_storeu_ps(outptr + outstride, _r1);
+        _mm_storeu_ps(outptr + outstride * 2, _r2);
+        _mm_storeu_ps(outptr + outstride * 3, _r3);
+        return;
+    }
+#endif // __SSE2__
+
+    for (int i = 0; i < elempack; i++)
+    {
+        for (int j = 0; j < elempack; j++)
+        {
+            outptr[i * outstride + j] = ptr[j * stride + i];
+        }
+    }
+}
+
+static void permute_copy_pack(const float* ptr, float* outptr, int elempack)
+{
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    if (elempack == 16)
+    {
+        _mm512_storeu_ps(outptr, _mm512_loadu_ps(ptr));
+        return;
+    }
+#endif // __AVX512F__
+    if (elempack == 8)
+    {
+        _mm256_storeu_ps(outptr, _mm256_loadu_ps(ptr));
+        return;
+    }
+#endif // __AVX__
+    if (elempack == 4)
+    {
+        _mm_storeu_ps(outptr, _mm_loadu_ps(ptr));
+        return;
+    }
+#endif // __SSE2__
+
+    for (int i = 0; i < elempack; i++)
+    {
+        outptr[i] = ptr[i];
+    }
+}
+
+int Permute_x86_avx512::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    const int dims = bottom_blob.dims;
+    const int elempack = bottom_blob.elempack;
+
+    if (dims == 1 || order_type == 0)
+    {
+        top_blob = bottom_blob;
+        return 0;
+    }
+
+    const int* order = dims == 2 ? permute_order_2d[order_type] : dims == 3 ? permute_order_3d[order_type] : permute_order_4d[order_type];
+
+    // the unpacked shape and the float stride of every axis
+    // the packed axis has no plain stride, its packs are cstep apart and its lanes are adjacent
+    int shape[4];
+    size_t stride[4];
+    size_t cstep;
+    if (dims == 2)
+    {
+        shape[0] = bottom_blob.w;
+        shape[1] = bottom_blob.h * elempack;
+        stride[0] = elempack;
+        cstep = (size_t)bottom_blob.w * elempack;
+    }
+    else
+    {
+        shape[0] = bottom_blob.w;
+        shape[1] = bottom_blob.h;
+        shape[2] = bottom_blob.d;
+        shape[dims - 1] = bottom_blob.c * elempack;
+        stride[0] = elempack;
+        stride[1] = (size_t)bottom_blob.w * elempack;
+        stride[2] = (size_t)bottom_blob.w * bottom_blob.h * elempack;
+        cstep = bottom_blob.cstep * elempack;
+    }
+
+    int outshape[4];
+    for (int i = 0; i < dims; i++)
+    {
+        outshape[i] = shape[order[i]];
+    }
+
+    const int outer_axis = order[dims - 1];
+    const int outer = outshape[dims - 1];
+
+    int out_elempack = 1;
+#if __SSE2__
+    if (opt.use_packing_layout)
+    {
+#if __AVX512F__
+        out_elempack = outer % 16 == 0 ? 16 : outer % 8 == 0 ? 8 : outer % 4 == 0 ? 4 : 1;
+#elif __AVX__
+        out_elempack = outer % 8 == 0 ? 8 : outer % 4 == 0 ? 4 : 1;
+#else
+        out_elempack = outer % 4 == 0 ? 4 : 1;
+#endif
+    }
+#endif // __SSE2__
+
+    // the packed axis stays outermost, move whole packs around
+    if (outer_axis == dims - 1)
+        out_elempack = elempack;
+
+    if (elempack == 1 && out_elempack == 1)
+        return Permute::forward(bottom_blob, top_blob, opt);
+
+    const size_t out_elemsize = 4u * out_elempack;
+
+    if (dims == 2)
+        top_blob.create(outshape[0], outer / out_elempack, out_elemsize, out_elempack, opt.blob_allocator);
+    else if (dims == 3)
+        top_blob.create(outshape[0], outshape[1], outer / out_elempack, out_elemsize, out_elempack, opt.blob_allocator);
+    else // if (dims == 4)
+        top_blob.create(outshape[0], outshape[1], outshape[2], outer / out_elempack, out_elemsize, out_elempack, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    const size_t out_cstep = dims == 2 ? (size_t)outshape[0] * out_elempack : top_blob.cstep * out_elempack;
+
+    // walk the output inner axes as x y z, unused axes have extent 1
+    int n[3] = {1, 1, 1};
+    size_t in_stride[3] = {0, 0, 0};
+    int packed_axis = -1; // the output inner axis that reads the input packed axis
+    for (int i = 0; i < dims - 1; i++)
+    {
+        n[i] = outshape[i];
+        if (order[i] == dims - 1)
+            packed_axis = i;
+        else
+            in_stride[i] = stride[order[i]];
+    }
+
+    const int outer_size = outer / out_elempack;
+
+    if (packed_axis == -1)
+    {
+        // w h d shuffle with the packed axis kept outermost
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int qo = 0; qo < outer_size; qo++)
+        {
+            const float* ptr = (const float*)bottom_blob.data + qo * cstep;
+            float* outptr = (float*)top_blob.data + qo * out_cstep;
+
+            for (int z = 0; z < n[2]; z++)
+            {
+                for (int y = 0; y < n[1]; y++)
+                {
+                    const float* ptr1 = ptr + z * in_stride[2] + y * in_stride[1];
+
+                    for (int x = 0; x < n[0]; x++)
+                    {
+                        permute_copy_pack(ptr1 + x * in_stride[0], outptr, elempack);
+                        outptr += elempack;
+                    }
+                }
+            }
+        }
+
+        return 0;
+    }
+
+    const size_t outer_stride = stride[outer_axis];
+
+    size_t out_stride[3];
+    out_stride[0] = out_elempack;
+    out_stride[1] = (size_t)n[0] * out_elempack;
+    out_stride[2] = (size_t)n[0] * n[1] * out_elempack;
+
+    if (elempack == out_elempack)
+    {
+        // elempack x elempack tiles of outer positions and channels, transposed in registers
+        int step[3] = {1, 1, 1};
+        step[packed_axis] = elempack;
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int qo = 0; qo < outer_size; qo++)
+        {
+            const float* ptr = (const float*)bottom_blob.data + qo * elempack * outer_stride;
+            float* outptr = (float*)top_blob.data + qo * out_cstep;
+
+            for (int z = 0; z < n[2]; z += step[2])
+            {
+                for (int y = 0; y < n[1]; y += step[1])
+                {
+                    for (int x = 0; x < n[0]; x += step[0])
+                    {
+                        const int idx[3] = {x, y, z};
+                        const float* ptr1 = ptr + (idx[packed_axis] / elempack) * cstep + z * in_stride[2] + y * in_stride[1] + x * in_stride[0];
+                        float* outptr1 = outptr + z * out_stride[2] + y * out_stride[1] + x * out_stride[0];
+
+                        permute_transpose_pack(ptr1, (int)outer_stride, outptr1, (int)out_stride[packed_axis], elempack);
+                    }
+                }
+            }
+        }
+
+        return 0;
+    }
+
+    // packing changes size, gather lane by lane
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int qo = 0; qo < outer_size; qo++)
+    {
+        const float* ptr = (const float*)bottom_blob.data + qo * out_elempack * outer_stride;
+        float* outptr = (float*)top_blob.data + qo * out_cstep;
+
+        for (int z = 0; z < n[2]; z++)
+        {
+            for (int y = 0; y < n[1]; y++)
+            {
+                for (int x = 0; x < n[0]; x++)
+                {
+                    const int idx[3] = {x, y, z};
+                    const int ic = idx[packed_axis];
+                    const float* ptr1 = ptr + (ic / elempack) * cstep + ic % elempack + z * in_stride[2] + y * in_stride[1] + x * in_stride[0];
+
+                    for (int l = 0; l < out_elempack; l++)
+                    {
+                        outptr[l] = ptr1[l * outer_stride];
+                    }
+                    outptr += out_elempack;
+                }
+            }
+        }
+    }
+
+    return 0;
+}
+
+} // namespace ncnn
@@ -0,0 +1,300 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "pixelshuffle_x86_avx.h"
+
+#if __SSE2__
+#include <emmintrin.h>
+#if __AVX__
+#include <immintrin.h>
+#endif // __AVX__
+#endif // __SSE2__
+
+#include "x86_usability.h"
+
+namespace ncnn {
+
+PixelShuffle_x86_avx::PixelShuffle_x86_avx()
+{
+#if __SSE2__
+    support_packing = true;
+#endif // __SSE2__
+}
+
+int PixelShuffle_x86_avx::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    int w = bottom_blob.w;
+    int h = bottom_blob.h;
+    int channels = bottom_blob.c;
+    int elempack = bottom_blob.elempack;
+
+    const int upscale_factor2 = upscale_factor * upscale_factor;
+
+    int outw = w * upscale_factor;
+    int outh = h * upscale_factor;
+    int outc = channels * elempack / upscale_factor2;
+
+    int out_elempack = 1;
+#if __SSE2__
+    if (opt.use_packing_layout)
+    {
+#if __AVX512F__
+        out_elempack = outc % 16 == 0 ? 16 : outc % 8 == 0 ? 8 : outc % 4 == 0 ? 4 : 1;
+#elif __AVX__
+        out_elempack = outc % 8 == 0 ? 8 : outc % 4 == 0 ? 4 : 1;
+#else
+        out_elempack = outc % 4 == 0 ? 4 : 1;
+#endif
+    }
+#endif // __SSE2__
+
+    if (elempack == 1 && out_elempack == 1)
+        return PixelShuffle::forward(bottom_blob, top_blob, opt);
+
+    top_blob.create(outw, outh, outc / out_elempack, 4u * out_elempack, out_elempack, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    if (mode == 1 && elempack == out_elempack)
+    {
+        // q = (sh * upscale_factor + sw) * outc + p
+        // the lanes of an output pack are the lanes of one input pack
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int p = 0; p < outc / out_elempack; p++)
+        {
+            Mat m = top_blob.channel(p);
+
+            for (int sh = 0; sh < upscale_factor; sh++)
+            {
+                for (int sw = 0; sw < upscale_factor; sw++)
+                {
+                    const int q = (sh * upscale_factor + sw) * (outc / elempack) + p;
+
+                    const float* sptr = bottom_blob.channel(q);
+
+                    for (int i = 0; i < h; i++)
+                    {
+                        float* outptr = m.row(i * upscale_factor + sh) + sw * elempack;
+
+                        int j = 0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+                        if (elempack == 16)
+                        {
+                            for (; j < w; j++)
+                            {
+                                _mm512_storeu_ps(outptr, _mm512_loadu_ps(sptr));
+                                sptr += 16;
+                                outptr += upscale_factor * 16;
+                            }
+                        }
+#endif // __AVX512F__
+                        if (elempack == 8)
+                        {
+                            for (; j < w; j++)
+                            {
+                                _mm256_storeu_ps(outptr, _mm256_loadu_ps(sptr));
+                                sptr += 8;
+                                outptr += upscale_factor * 8;
+                            }
+                        }
+#endif // __AVX__
+                        if (elempack == 4)
+                        {
+                            for (; j < w; j++)
+                            {
+                                _mm_storeu_ps(outptr, _mm_loadu_ps(sptr));
+                                sptr += 4;
+                                outptr += upscale_factor * 4;
+                            }
+                        }
+#endif // __SSE2__
+                    }
+                }
+            }
+        }
+
+        return 0;
+    }
+
+    if (mode == 0 && elempack == out_elempack && upscale_factor2 % elempack == 0)
+    {
+        // q = p * upscale_factor2 + s
+        // one input pack holds elempack neighbouring s of one p, transpose elempack packs of consecutive p
+        const int nn_s = upscale_factor2 / elempack;
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int p = 0; p < outc / out_elempack; p++)
+        {
+            Mat m = top_blob.channel(p);
+
+            for (int ss = 0; ss < nn_s; ss++)
+            {
+                const float* sptr = bottom_blob.channel(p * elempack * nn_s + ss);
+                const int stride = (int)(bottom_blob.cstep * elempack * nn_s);
+
+                int out_offset[16];
+                for (int k = 0; k < elempack; k++)
+                {
+                    const int s = ss * elempack + k;
+                    const int sh = s / upscale_factor;
+                    const int sw = s % upscale_factor;
+                    out_offset[k] = (sh * outw + sw) * elempack;
+                }
+
+                for (int i = 0; i < h; i++)
+                {
+                    for (int j = 0; j < w; j++)
+                    {
+                        float* outptr0 = m.row(i * upscale_factor) + j * upscale_factor * elempack;
+
+                        float* outptr[16];
+                        for (int k = 0; k < elempack; k++)
+                        {
+                            outptr[k] = outptr0 + out_offset[k];
+                        }
+
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+                        if (elempack == 16)
+                        {
+                            __m512 _r0 = _mm512_loadu_ps(sptr);
+                            __m512 _r1 = _mm512_loadu_ps(sptr + stride);
+                            __m512 _r2 = _mm512_loadu_ps(sptr + stride * 2);
+                            __m512 _r3 = _mm512_loadu_ps(sptr + stride * 3);
+                            __m512 _r4 = _mm512_loadu_ps(sptr + stride * 4);
+                            __m512 _r5 = _mm512_loadu_ps(sptr + stride * 5);
+                            __m512 _r6 = _mm512_loadu_ps(sptr + stride * 6);
+                            __m512 _r7 = _mm512_loadu_ps(sptr + stride * 7);
+                            __m512 _r8 = _mm512_loadu_ps(sptr + stride * 8);
+                            __m512 _r9 = _mm512_loadu_ps(sptr + stride * 9);
+                            __m512 _ra = _mm512_loadu_ps(sptr + stride * 10);
+                            __m512 _rb = _mm512_loadu_ps(sptr + stride * 11);
+                            __m512 _rc = _mm512_loadu_ps(sptr + stride * 12);
+                            __m512 _rd = _mm512_loadu_ps(sptr + stride * 13);
+                            __m512 _re = _mm512_loadu_ps(sptr + stride * 14);
+                            __m512 _rf = _mm512_loadu_ps(sptr + stride * 15);
+                            transpose16x16_ps(_r0, _r1, _r2, _r3, _r4, _r5, _r6, _r7, _r8, _r9, _ra, _rb, _rc, _rd, _re, _rf);
+                            _mm512_storeu_ps(outptr[0], _r0);
+                            _mm512_storeu_ps(outptr[1], _r1);
+                            _mm512_storeu_ps(outptr[2], _r2);
+                            _mm512_storeu_ps(outptr[3], _r3);
+                            _mm512_storeu_ps(outptr[4], _r4);
+                            _mm512_storeu_ps(outptr[5], _r5);
+                            _mm512_storeu_ps(outptr[6], _r6);
+                            _mm512_storeu_ps(outptr[7], _r7);
+                            _mm512_storeu_ps(outptr[8], _r8);
+                            _mm512_storeu_ps(outptr[9], _r9);
+                            _mm512_storeu_ps(outptr[10], _ra);
+                            _mm512_storeu_ps(outptr[11], _rb);
+                            _mm512_storeu_ps(outptr[12], _rc);
+                            _mm512_storeu_ps(outptr[13], _rd);
+                            _mm512_storeu_ps(outptr[14], _re);
+                            _mm512_storeu_ps(outptr[15], _rf);
+                        }
+#endif // __AVX512F__
+                        if (elempack == 8)
+                        {
+                            __m256 _r0 = _mm256_loadu_ps(sptr);
+                            __m256 _r1 = _mm256_loadu_ps(sptr + stride);
+                            __m256 _r2 = _mm256_loadu_ps(sptr + stride * 2);
+                            __m256 _r3 = _mm256_loadu_ps(sptr + stride * 3);
+                            __m256 _r4 = _mm256_loadu_ps(sptr + stride * 4);
+                            __m256 _r5 = _mm256_loadu_ps(sptr + stride * 5);
+                            __m256 _r6 = _mm256_loadu_ps(sptr + stride * 6);
+                            __m256 _r7 = _mm256_loadu_ps(sptr + stride * 7);
+                            transpose8x8_ps(_r0, _r1, _r2, _r3, _r4, _r5, _r6, _r7);
+                            _mm256_storeu_ps(outptr[0], _r0);
+                            _mm256_storeu_ps(outptr[1], _r1);
+                            _mm256_storeu_ps(outptr[2], _r2);
+                            _mm256_storeu_ps(outptr[3], _r3);
+                            _mm256_storeu_ps(outptr[4], _r4);
+                            _mm256_storeu_ps(outptr[5], _r5);
+                            _mm256_storeu_ps(outptr[6], _r6);
+                            _mm256_storeu_ps(outptr[7], _r7);
+                        }
+#endif // __AVX__
+                        if (elempack == 4)
+                        {
+                            __m128 _r0 = _mm_loadu_ps(sptr);
+                            __m128 _r1 = _mm_loadu_ps(sptr + stride);
+                            __m128 _r2 = _mm_loadu_ps(sptr + stride * 2);
+                            __m128 _r3 = _mm_loadu_ps(sptr + stride * 3);
+                            _MM_TRANSPOSE4_PS(_r0, _r1, _r2, _r3);
+                            _mm_storeu_ps(outptr[0], _r0);
+                            _mm_storeu_ps(outptr[1], _r1);
+                            _mm_storeu_ps(outptr[2], _r2);
+                            _mm_storeu_ps(outptr[3], _r3);
+                        }
+#endif // __SSE2__
+
+                        sptr += elempack;
+                    }
+                }
+            }
+        }
+
+        return 0;
+    }
+
+    // packing changes size, gather lane by lane
+    const size_t cstep = bottom_blob.cstep * elempack;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int p = 0; p < outc / out_elempack; p++)
+    {
+        Mat m = top_blob.channel(p);
+
+        for (int sh = 0; sh < upscale_factor; sh++)
+        {
+            for (int sw = 0; sw < upscale_factor; sw++)
+            {
+                const float* sptr[16];
+                for (int k = 0; k < out_elempack; k++)
+                {
+                    int q;
+                    if (mode == 0)
+                        q = (p * out_elempack + k) * upscale_factor2 + sh * upscale_factor + sw;
+                    else // if (mode == 1)
+                        q = (sh * upscale_factor + sw) * outc + p * out_elempack + k;
+
+                    sptr[k] = (const float*)bottom_blob.data + (q / elempack) * cstep + q % elempack;
+                }
+
+                for (int i = 0; i < h; i++)
+                {
+                    float* outptr = m.row(i * upscale_factor + sh) + sw * out_elempack;
+
+                    for (int j = 0; j < w; j++)
+                    {
+                        const int offset = (i * w + j) * elempack;
+
+                        for (int k = 0; k < out_elempack; k++)
+                        {
+                            outptr[k] = sptr[k][offset];
+                        }
+
+                        outptr += upscale_factor * out_elempack;
+                    }
+                }
+            }
+        }
+    }
+
+    return 0;
+}
+
+} // namespace ncnn
@@ -0,0 +1,880 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "reduction_x86_fma.h"
+
+#include <float.h>
+
+#if __SSE2__
+#include <emmintrin.h>
+#include "sse_mathfun.h"
+#if __AVX__
+#include <immintrin.h>
+#include "avx_mathfun.h"
+#if __AVX512F__
+#include "avx512_mathfun.h"
+#endif // __AVX512F__
+#endif // __AVX__
+#endif // __SSE2__
+
+#include "x86_usability.h"
+
+namespace ncnn {
+
+Reduction_x86_fma::Reduction_x86_fma()
+{
+#if __SSE2__
+    support_packing = true;
+#endif // __SSE2__
+}
+
+struct reduction_op_add
+{
+    NCNN_FORCEINLINE float func(const float& x, const float& y) const
+    {
+        return x + y;
+    }
+#if __SSE2__
+    NCNN_FORCEINLINE __m128 func_pack4(const __m128& x, const __m128& y) const
+    {
+        return _mm_add_ps(x, y);
+    }
+#if __AVX__
+    NCNN_FORCEINLINE __m256 func_pack8(const __m256& x, const __m256& y) const
+    {
+        return _mm256_add_ps(x, y);
+    }
+#if __AVX512F__
+    NCNN_FORCEINLINE __m512 func_pack16(const __m512& x, const __m512& y) const
+    {
+        return _mm512_add_ps(x, y);
+    }
+#endif // __AVX512F__
+#endif // __AVX__
+#endif // __SSE2__
+};
+
+struct reduction_op_mul
+{
+    NCNN_FORCEINLINE float func(const float& x, const float& y) const
+    {
+        return x * y;
+    }
+#if __SSE2__
+    NCNN_FORCEINLINE __m128 func_pack4(const __m128& x, const __m128& y) const
+    {
+        return _mm_mul_ps(x, y);
+    }
+#if __AVX__
+    NCNN_FORCEINLINE __m256 func_pack8(const __m256& x, const __m256& y) const
+    {
+        return _mm256_mul_ps(x, y);
+    }
+#if __AVX512F__
+    NCNN_FORCEINLINE __m512 func_pack16(const __m512& x, const __m512& y) const
+    {
+        return _mm512_mul_ps(x, y);
+    }
+#endif // __AVX512F__
+#endif // __AVX__
+#endif // __SSE2__
+};
+
+struct reduction_op_asum
+{
+    NCNN_FORCEINLINE float func(const float& x, const float& y) const
+    {
+        return x + fabsf(y);
+    }
+#if __SSE2__
+    NCNN_FORCEINLINE __m128 func_pack4(const __m128& x, const __m128& y) const
+    {
+        return _mm_add_ps(x, _mm_andnot_ps(_mm_set1_ps(-0.f), y));
+    }
+#if __AVX__
+    NCNN_FORCEINLINE __m256 func_pack8(const __m256& x, const __m256& y) const
+    {
+        return _mm256_add_ps(x, _mm256_andnot_ps(_mm256_set1_ps(-0.f), y));
+    }
+#if __AVX512F__
+    NCNN_FORCEINLINE __m512 func_pack16(const __m512& x, const __m512& y) const
+    {
+        return _mm512_add_ps(x, _mm512_abs_ps(y));
+    }
+#endif // __AVX512F__
+#endif // __AVX__
+#endif // __SSE2__
+};
+
+struct reduction_op_sumsq
+{
+    NCNN_FORCEINLINE float func(const float& x, const float& y) const
+    {
+        return x + y * y;
+    }
+#if __SSE2__
+    NCNN_FORCEINLINE __m128 func_pack4(const __m128& x, const __m128& y) const
+    {
+        return _mm_comp_fmadd_ps(y, y, x);
+    }
+#if __AVX__
+    NCNN_FORCEINLINE __m256 func_pack8(const __m256& x, const __m256& y) const
+    {
+        return _mm256_comp_fmadd_ps(y, y, x);
+    }
+#if __AVX512F__
+    NCNN_FORCEINLINE __m512 func_pack16(const __m512& x, const __m512& y) const
+    {
+        return _mm512_fmadd_ps(y, y, x);
+    }
+#endif // __AVX512F__
+#endif // __AVX__
+#endif // __SSE2__
+};
+
+struct reduction_op_sumsexp
+{
+    NCNN_FORCEINLINE float func(const float& x, const float& y) const
+    {
+        return x + expf(y);
+    }
+#if __SSE2__
+    NCNN_FORCEINLINE __m128 func_pack4(const __m128& x, const __m128& y) const
+    {
+        return _mm_add_ps(x, exp_ps(y));
+    }
+#if __AVX__
+    NCNN_FORCEINLINE __m256 func_pack8(const __m256& x, const __m256& y) const
+    {
+        return _mm256_add_ps(x, exp256_ps(y));
+    }
+#if __AVX512F__
+    NCNN_FORCEINLINE __m512 func_pack16(const __m512& x, const __m512& y) const
+    {
+        return _mm512_add_ps(x, exp512_ps(y));
+    }
+#endif // __AVX512F__
+#endif // __AVX__
+#endif // __SSE2__
+};
+
+struct reduction_op_max
+{
+    NCNN_FORCEINLINE float func(const float& x, const float& y) const
+    {
+        return std::max(x, y);
+    }
+#if __SSE2__
+    NCNN_FORCEINLINE __m128 func_pack4(const __m128& x, const __m128& y) const
+    {
+        return _mm_max_ps(x, y);
+    }
+#if __AVX__
+    NCNN_FORCEINLINE __m256 func_pack8(const __m256& x, const __m256& y) const
+    {
+        return _mm256_max_ps(x, y);
+    }
+#if __AVX512F__
+    NCNN_FORCEINLINE __m512 func_pack16(const __m512& x, const __m512& y) const
+    {
+        return _mm512_max_ps(x, y);
+    }
+#endif // __AVX512F__
+#endif // __AVX__
+#endif // __SSE2__
+};
+
+struct reduction_op_min
+{
+    NCNN_FORCEINLINE float func(const float& x, const float& y) const
+    {
+        return std::min(x, y);
+    }
+#if __SSE2__
+    NCNN_FORCEINLINE __m128 func_pack4(const __m128& x, const __m128& y) const
+    {
+        return _mm_min_ps(x, y);
+    }
+#if __AVX__
+    NCNN_FORCEINLINE __m256 func_pack8(const __m256& x, const __m256& y) const
+    {
+        return _mm256_min_ps(x, y);
+    }
+#if __AVX512F__
+    NCNN_FORCEINLINE __m512 func_pack16(const __m512& x, const __m512& y) const
+    {
+        return _mm512_min_ps(x, y);
+    }
+#endif // __AVX512F__
+#endif // __AVX__
+#endif // __SSE2__
+};
+
+struct post_process_identity
+{
+    NCNN_FORCEINLINE float func(const float& x) const
+    {
+        return x;
+    }
+#if __SSE2__
+    NCNN_FORCEINLINE __m128 func_pack4(const __m128& x) const
+    {
+        return x;
+    }
+#if __AVX__
+    NCNN_FORCEINLINE __m256 func_pack8(const __m256& x) const
+    {
+        return x;
+    }
+#if __AVX512F__
+    NCNN_FORCEINLINE __m512 func_pack16(const __m512& x) const
+    {
+        return x;
+    }
+#endif // __AVX512F__
+#endif // __AVX__
+#endif // __SSE2__
+};
+
+struct post_process_sqrt
+{
+    // flush subnormal input to zero like the reference implementation does
+    NCNN_FORCEINLINE float func(const float& x) const
+    {
+        return sqrtf(x < FLT_MIN ? 0.f : x);
+    }
+#if __SSE2__
+    NCNN_FORCEINLINE __m128 func_pack4(const __m128& x) const
+    {
+        return _mm_sqrt_ps(_mm_and_ps(x, _mm_cmpge_ps(x, _mm_set1_ps(FLT_MIN))));
+    }
+#if __AVX__
+    NCNN_FORCEINLINE __m256 func_pack8(const __m256& x) const
+    {
+        return _mm256_sqrt_ps(_mm256_and_ps(x, _mm256_cmp_ps(x, _mm256_set1_ps(FLT_MIN), _CMP_GE_OQ)));
+    }
+#if __AVX512F__
+    NCNN_FORCEINLINE __m512 func_pack16(const __m512& x) const
+    {
+        return _mm512_sqrt_ps(_mm512_maskz_mov_ps(_mm512_cmp_ps_mask(x, _mm512_set1_ps(FLT_MIN), _CMP_GE_OQ), x));
+    }
+#endif // __AVX512F__
+#endif // __AVX__
+#endif // __SSE2__
+};
+
+struct post_process_log
+{
+    NCNN_FORCEINLINE float func(const float& x) const
+    {
+        return logf(x);
+    }
+#if __SSE2__
+    NCNN_FORCEINLINE __m128 func_pack4(const __m128& x) const
+    {
+        return log_ps(x);
+    }
+#if __AVX__
+    NCNN_FORCEINLINE __m256 func_pack8(const __m256& x) const
+    {
+        return log256_ps(x);
+    }
+#if __AVX512F__
+    NCNN_FORCEINLINE __m512 func_pack16(const __m512& x) const
+    {
+        return log512_ps(x);
+    }
+#endif // __AVX512F__
+#endif // __AVX__
+#endif // __SSE2__
+};
+
+template<typename Op2>
+static void reduction_fold_scalar(const float* tmp, int n, float* outptr)
+{
+    Op2 op2;
+
+    float sum = outptr[0];
+    for (int i = 0; i < n; i++)
+    {
+        sum = op2.func(sum, tmp[i]);
+    }
+    outptr[0] = sum;
+}
+
+#if __SSE2__
+template<typename Op2>
+static void reduction_fold_pack4(__m128 _sum, int elempack, float* outptr)
+{
+    Op2 op2;
+
+    if (elempack == 4)
+    {
+        _mm_storeu_ps(outptr, op2.func_pack4(_mm_loadu_ps(outptr), _sum));
+        return;
+    }
+
+    // elempack == 1
+    float tmp[4];
+    _mm_storeu_ps(tmp, _sum);
+    reduction_fold_scalar<Op2>(tmp, 4, outptr);
+}
+
+#if __AVX__
+template<typename Op2>
+static void reduction_fold_pack8(__m256 _sum, int elempack, float* outptr)
+{
+    Op2 op2;
+
+    if (elempack == 8)
+    {
+        _mm256_storeu_ps(outptr, op2.func_pack8(_mm256_loadu_ps(outptr), _sum));
+        return;
+    }
+
+    reduction_fold_pack4<Op2>(op2.func_pack4(_mm256_castps256_ps128(_sum), _mm256_extractf128_ps(_sum, 1)), elempack, outptr);
+}
+
+#if __AVX512F__
+template<typename Op2>
+static void reduction_fold_pack16(__m512 _sum, int elempack, float* outptr)
+{
+    Op2 op2;
+
+    if (elempack == 16)
+    {
+        _mm512_storeu_ps(outptr, op2.func_pack16(_mm512_loadu_ps(outptr), _sum));
+        return;
+    }
+
+    reduction_fold_pack8<Op2>(op2.func_pack8(_mm512_castps512_ps256(_sum), _mm256_castpd_ps(_mm512_extractf64x4_pd(_mm512_castps_pd(_sum), 1))), elempack, outptr);
+}
+#endif // __AVX512F__
+#endif // __AVX__
+#endif // __SSE2__
+
+template<typename Op, typename Op2>
+static void reduction_row(const float* ptr, int size, int elempack, float v0, float* outptr)
+{
+    // reduce size floats of elempack interleaved lanes, then merge the lanes into outptr[0..elempack)
+    Op op;
+    Op2 op2;
+
+    int i = 0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    if (size >= 16)
+    {
+        __m512 _sum0 = _mm512_set1_ps(v0);
+        if (size >= 64)
+        {
+            // independent accumulators hide the latency of the dependency chain
+            __m512 _sum1 = _sum0;
+            __m512 _sum2 = _sum0;
+            __m512 _sum3 = _sum0;
+            for (; i + 63 < size; i += 64)
+            {
+                _sum0 = op.func_pack16(_sum0, _mm512_loadu_ps(ptr + i));
+                _sum1 = op.func_pack16(_sum1, _mm512_loadu_ps(ptr + i + 16));
+                _sum2 = op.func_pack16(_sum2, _mm512_loadu_ps(ptr + i + 32));
+                _sum3 = op.func_pack16(_sum3, _mm512_loadu_ps(ptr + i + 48));
+            }
+            _sum0 = op2.func_pack16(op2.func_pack16(_sum0, _sum1), op2.func_pack16(_sum2, _sum3));
+        }
+        for (; i + 15 < size; i += 16)
+        {
+            _sum0 = op.func_pack16(_sum0, _mm512_loadu_ps(ptr + i));
+        }
+        reduction_fold_pack16<Op2>(_sum0, elempack, outptr);
+    }
+#endif // __AVX512F__
+    if (size - i >= 8)
+    {
+        __m256 _sum0 = _mm256_set1_ps(v0);
+        if (size - i >= 32)
+        {
+            __m256 _sum1 = _sum0;
+            __m256 _sum2 = _sum0;
+            __m256 _sum3 = _sum0;
+            for (; i + 31 < size; i += 32)
+            {
+                _sum0 = op.func_pack8(_sum0, _mm256_loadu_ps(ptr + i));
+                _sum1 = op.func_pack8(_sum1, _mm256_loadu_ps(ptr + i + 8));
+                _sum2 = op.func_pack8(_sum2, _mm256_loadu_ps(ptr + i + 16));
+                _sum3 = op.func_pack8(_sum3, _mm256_loadu_ps(ptr + i + 24));
+            }
+            _sum0 = op2.func_pack8(op2.func_pack8(_sum0, _sum1), op2.func_pack8(_sum2, _sum3));
+        }
+        for (; i + 7 < size; i += 8)
+        {
+            _sum0 = op.func_pack8(_sum0, _mm256_loadu_ps(ptr + i));
+        }
+        reduction_fold_pack8<Op2>(_sum0, elempack, outptr);
+    }
+#endif // __AVX__
+    if (size - i >= 4)
+    {
+        __m128 _sum0 = _mm_set1_ps(v0);
+        if (size - i >= 16)
+        {
+            __m128 _sum1 = _sum0;
+            __m128 _sum2 = _sum0;
+            __m128 _sum3 = _sum0;
+            for (; i + 15 < size; i += 16)
+            {
+                _sum0 = op.func_pack4(_sum0, _mm_loadu_ps(ptr + i));
+                _sum1 = op.func_pack4(_sum1, _mm_loadu_ps(ptr + i + 4));
+                _sum2 = op.func_pack4(_sum2, _mm_loadu_ps(ptr + i + 8));
+                _sum3 = op.func_pack4(_sum3, _mm_loadu_ps(ptr + i + 12));
+            }
+            _sum0 = op2.func_pack4(op2.func_pack4(_sum0, _sum1), op2.func_pack4(_sum2, _sum3));
+        }
+        for (; i + 3 < size; i += 4)
+        {
+            _sum0 = op.func_pack4(_sum0, _mm_loadu_ps(ptr + i));
+        }
+        reduction_fold_pack4<Op2>(_sum0, elempack, outptr);
+    }
+#endif // __SSE2__
+    if (i < size)
+    {
+        // only reachable with elempack == 1
+        float sum = v0;
+        for (; i < size; i++)
+        {
+            sum = op.func(sum, ptr[i]);
+        }
+        outptr[0] = op2.func(outptr[0], sum);
+    }
+}
+
+template<typename Op>
+static void reduction_accumulate_row(const float* ptr, int size, float* outptr)
+{
+    // outptr[i] = op(outptr[i], ptr[i])
+    Op op;
+
+    int i = 0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    for (; i + 15 < size; i += 16)
+    {
+        _mm512_storeu_ps(outptr + i, op.func_pack16(_mm512_loadu_ps(outptr + i), _mm512_loadu_ps(ptr + i)));
+    }
+#endif // __AVX512F__
+    for (; i + 7 < size; i += 8)
+    {
+        _mm256_storeu_ps(outptr + i, op.func_pack8(_mm256_loadu_ps(outptr + i), _mm256_loadu_ps(ptr + i)));
+    }
+#endif // __AVX__
+    for (; i + 3 < size; i += 4)
+    {
+        _mm_storeu_ps(outptr + i, op.func_pack4(_mm_loadu_ps(outptr + i), _mm_loadu_ps(ptr + i)));
+    }
+#endif // __SSE2__
+    for (; i < size; i++)
+    {
+        outptr[i] = op.func(outptr[i], ptr[i]);
+    }
+}
+
+template<typename Op2>
+static void reduction_tree_combine(Mat& partials, const Option& opt)
+{
+    // pairwise merge the partial rows, the result lands in row 0
+    // every level runs its merges in parallel and keeps the summation error logarithmic
+    const int size = partials.w;
+    const int n = partials.h;
+
+    for (int step = 1; step < n; step *= 2)
+    {
+        const int nn = (n - step + step * 2 - 1) / (step * 2);
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int ii = 0; ii < nn; ii++)
+        {
+            const int q = ii * step * 2;
+            reduction_accumulate_row<Op2>(partials.row(q + step), size, partials.row(q));
+        }
+    }
+}
+
+template<typename Op, typename Op2>
+static void reduction_channel(const float* ptr, float* outptr, int w, int h, int d, int elempack, float v0, bool reduce_w, bool reduce_h, bool reduce_d)
+{
+    const int outw = reduce_w ? 1 : w;
+    const int outh = reduce_h ? 1 : h;
+    const int outd = reduce_d ? 1 : d;
+    const int outsize = outw * outh * outd * elempack;
+
+    for (int i = 0; i < outsize; i++)
+    {
+        outptr[i] = v0;
+    }
+
+    for (int z = 0; z < d; z++)
+    {
+        for (int y = 0; y < h; y++)
+        {
+            const float* rowptr = ptr + (z * h + y) * w * elempack;
+            float* outrowptr = outptr + ((reduce_d ? 0 : z) * outh + (reduce_h ? 0 : y)) * outw * elempack;
+
+            if (reduce_w)
+                reduction_row<Op, Op2>(rowptr, w * elempack, elempack, v0, outrowptr);
+            else
+                reduction_accumulate_row<Op>(rowptr, w * elempack, outrowptr);
+        }
+    }
+}
+
+template<typename Op, typename Op2>
+static int reduction_op(const Mat& a, Mat& b, float v0, int w, int h, int d, int channels, int elempack, size_t cstep, bool reduce_w, bool reduce_h, bool reduce_d, bool reduce_c, const Option& opt)
+{
+    if (reduce_w && reduce_h && reduce_d && reduce_c)
+    {
+        // split every channel into fixed size chunks so that even a single huge channel
+        // is reduced by all threads, the chunk partials are then merged as a tree
+        // the chunking does not depend on num_threads, the result is reproducible
+        const int size = w * h * d * elempack;
+        const int chunk = 16384;
+        const int nn_chunk = (size + chunk - 1) / chunk;
+        const int nn = channels * nn_chunk;
+
+        Mat partials(1, nn, 4u, opt.workspace_allocator);
+        if (partials.empty())
+            return -100;
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int ii = 0; ii < nn; ii++)
+        {
+            const int q = ii / nn_chunk;
+            const int k = (ii % nn_chunk) * chunk;
+
+            const float* ptr = (const float*)a.data + q * cstep + k;
+            float* outptr = partials.row(ii);
+
+            outptr[0] = v0;
+            reduction_row<Op, Op2>(ptr, std::min(chunk, size - k), 1, v0, outptr);
+        }
+
+        reduction_tree_combine<Op2>(partials, opt);
+
+        b[0] = partials[0];
+
+        return 0;
+    }
+
+    const int outsize = (reduce_w ? 1 : w) * (reduce_h ? 1 : h) * (reduce_d ? 1 : d);
+
+    if (!reduce_c)
+    {
+        // the packed axis survives, reduce every lane independently and keep elempack
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int q = 0; q < channels; q++)
+        {
+            const float* ptr = (const float*)a.data + q * cstep;
+            float* outptr = b.dims >= 3 ? b.channel(q) : (float*)b.data + q * outsize * elempack;
+
+            reduction_channel<Op, Op2>(ptr, outptr, w, h, d, elempack, v0, reduce_w, reduce_h, reduce_d);
+        }
+
+        return 0;
+    }
+
+    Mat partials(outsize * elempack, channels, 4u, opt.workspace_allocator);
+    if (partials.empty())
+        return -100;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < channels; q++)
+    {
+        const float* ptr = (const float*)a.data + q * cstep;
+
+        reduction_channel<Op, Op2>(ptr, partials.row(q), w, h, d, elempack, v0, reduce_w, reduce_h, reduce_d);
+    }
+
+    reduction_tree_combine<Op2>(partials, opt);
+
+    // merge the lanes of the packed channels
+    Op2 op2;
+
+    const float* ptr = partials.row(0);
+    const int outc = b.dims >= 3 ? b.c : 1;
+    const int plane = outsize / outc;
+
+    for (int q = 0; q < outc; q++)
+    {
+        float* outptr = b.dims >= 3 ? b.channel(q) : b;
+
+        for (int i = 0; i < plane; i++)
+        {
+            const float* p = ptr + (q * plane + i) * elempack;
+
+            float sum = p[0];
+            for (int l = 1; l < elempack; l++)
+            {
+                sum = op2.func(sum, p[l]);
+            }
+            outptr[i] = sum;
+        }
+    }
+
+    return 0;
+}
+
+template<typename MathOp>
+static void reduction_post_process_row(float* ptr, int size, float coeff)
+{
+    MathOp mathop;
+
+    int i = 0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    __m512 _coeff_avx512 = _mm512_set1_ps(coeff);
+    for (; i + 15 < size; i += 16)
+    {
+        _mm512_storeu_ps(ptr + i, _mm512_mul_ps(mathop.func_pack16(_mm512_loadu_ps(ptr + i)), _coeff_avx512));
+    }
+#endif // __AVX512F__
+    __m256 _coeff_avx = _mm256_set1_ps(coeff);
+    for (; i + 7 < size; i += 8)
+    {
+        _mm256_storeu_ps(ptr + i, _mm256_mul_ps(mathop.func_pack8(_mm256_loadu_ps(ptr + i)), _coeff_avx));
+    }
+#endif // __AVX__
+    __m128 _coeff = _mm_set1_ps(coeff);
+    for (; i + 3 < size; i += 4)
+    {
+        _mm_storeu_ps(ptr + i, _mm_mul_ps(mathop.func_pack4(_mm_loadu_ps(ptr + i)), _coeff));
+    }
+#endif // __SSE2__
+    for (; i < size; i++)
+    {
+        ptr[i] = mathop.func(ptr[i]) * coeff;
+    }
+}
+
+template<typename MathOp>
+static void reduction_post_process(Mat& a, float coeff, const Option& opt)
+{
+    if (a.dims < 3)
+    {
+        reduction_post_process_row<MathOp>(a, a.w * a.h * a.elempack, coeff);
+        return;
+    }
+
+    const int size = a.w * a.h * a.d * a.elempack;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < a.c; q++)
+    {
+        reduction_post_process_row<MathOp>(a.channel(q), size, coeff);
+    }
+}
+
+template<typename Op, typename Op2, typename Op3>
+static int reduction(const Mat& a, Mat& b, float v0, int w, int h, int d, int channels, int elempack, size_t cstep, bool reduce_w, bool reduce_h, bool reduce_d, bool reduce_c, bool post_process, float coeff, const Option& opt)
+{
+    int ret = reduction_op<Op, Op2>(a, b, v0, w, h, d, channels, elempack, cstep, reduce_w, reduce_h, reduce_d, reduce_c, opt);
+    if (ret != 0)
+        return -100;
+
+    if (post_process || fabsf(coeff - 1.f) > FLT_EPSILON)
+    {
+        reduction_post_process<Op3>(b, coeff, opt);
+    }
+
+    return 0;
+}
+
+int Reduction_x86_fma::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    const int dims = bottom_blob.dims;
+    const int elempack = bottom_blob.elempack;
+
+    // axis flags in the outer-to-inner order of the unpacked blob
+    int axes_flag[4] = {0};
+    if (reduce_all)
+    {
+        axes_flag[0] = 1;
+        axes_flag[1] = 1;
+        axes_flag[2] = 1;
+        axes_flag[3] = 1;
+    }
+    else
+    {
+        const int* axes_ptr = axes;
+        for (int i = 0; i < axes.w; i++)
+        {
+            int axis = axes_ptr[i];
+            // handle negative axis
+            if (axis < 0)
+                axis += dims;
+            axes_flag[axis] = 1;
+        }
+    }
+
+    if (dims == 1)
+        axes_flag[0] = 1;
+
+    int shape[4];
+    if (dims == 1)
+    {
+        shape[0] = bottom_blob.w * elempack;
+    }
+    else if (dims == 2)
+    {
+        shape[0] = bottom_blob.h * elempack;
+        shape[1] = bottom_blob.w;
+    }
+    else if (dims == 3)
+    {
+        shape[0] = bottom_blob.c * elempack;
+        shape[1] = bottom_blob.h;
+        shape[2] = bottom_blob.w;
+    }
+    else // if (dims == 4)
+    {
+        shape[0] = bottom_blob.c * elempack;
+        shape[1] = bottom_blob.d;
+        shape[2] = bottom_blob.h;
+        shape[3] = bottom_blob.w;
+    }
+
+    // view the blob as packed channels of d-h-w, the outermost axis is always the packed one
+    int w = 1;
+    int h = 1;
+    int d = 1;
+    int channels = 1;
+    int view_elempack = elempack;
+    size_t cstep = 0;
+    bool reduce_w = true;
+    bool reduce_h = true;
+    bool reduce_d = true;
+    bool reduce_c = axes_flag[0] == 1;
+    if (dims == 1)
+    {
+        w = bottom_blob.w * elempack;
+        view_elempack = 1;
+        cstep = w;
+    }
+    else if (dims == 2)
+    {
+        w = bottom_blob.w;
+        channels = bottom_blob.h;
+        cstep = (size_t)w * elempack;
+        reduce_w = axes_flag[1] == 1;
+    }
+    else if (dims == 3)
+    {
+        w = bottom_blob.w;
+        h = bottom_blob.h;
+        channels = bottom_blob.c;
+        cstep = bottom_blob.cstep * elempack;
+        reduce_h = axes_flag[1] == 1;
+        reduce_w = axes_flag[2] == 1;
+    }
+    else // if (dims == 4)
+    {
+        w = bottom_blob.w;
+        h = bottom_blob.h;
+        d = bottom_blob.d;
+        channels = bottom_blob.c;
+        cstep = bottom_blob.cstep * elempack;
+        reduce_d = axes_flag[1] == 1;
+        reduce_h = axes_flag[2] == 1;
+        reduce_w = axes_flag[3] == 1;
+    }
+
+    // output shape follows the reference implementation, the packed axis keeps its packing when it is not reduced
+    int outshape[4];
+    int outdims = 0;
+    for (int i = 0; i < dims; i++)
+    {
+        if (keepdims)
+            outshape[outdims++] = axes_flag[i] ? 1 : shape[i];
+        else if (!axes_flag[i])
+            outshape[outdims++] = shape[i];
+    }
+    if (outdims == 0)
+        outshape[outdims++] = 1;
+
+    const int out_elempack = reduce_c ? 1 : view_elempack;
+    const size_t out_elemsize = 4u * out_elempack;
+    outshape[0] /= out_elempack;
+
+    if (outdims == 1)
+        top_blob.create(outshape[0], out_elemsize, out_elempack, opt.blob_allocator);
+    else if (outdims == 2)
+        top_blob.create(outshape[1], outshape[0], out_elemsize, out_elempack, opt.blob_allocator);
+    else if (outdims == 3)
+        top_blob.create(outshape[2], outshape[1], outshape[0], out_elemsize, out_elempack, opt.blob_allocator);
+    else // if (outdims == 4)
+        top_blob.create(outshape[3], outshape[2], outshape[1], outshape[0], out_elemsize, out_elempack, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    const Mat& a = bottom_blob;
+    Mat& b = top_blob;
+
+    if (operation == ReductionOp_SUM)
+        return reduction<reduction_op_add, reduction_op_add, post_process_identity>(a, b, 0.f, w, h, d, channels, view_elempack, cstep, reduce_w, reduce_h, reduce_d, reduce_c, false, coeff, opt);
+
+    if (operation == ReductionOp_ASUM)
+        return reduction<reduction_op_asum, reduction_op_add, post_process_identity>(a, b, 0.f, w, h, d, channels, view_elempack, cstep, reduce_w, reduce_h, reduce_d, reduce_c, false, coeff, opt);
+
+    if (operation == ReductionOp_SUMSQ)
+        return reduction<reduction_op_sumsq, reduction_op_add, post_process_identity>(a, b, 0.f, w, h, d, channels, view_elempack, cstep, reduce_w, reduce_h, reduce_d, reduce_c, false, coeff, opt);
+
+    if (operation == ReductionOp_MEAN)
+    {
+        int scale = 1;
+        for (int i = 0; i < dims; i++)
+        {
+            if (axes_flag[i])
+                scale *= shape[i];
+        }
+
+        float coeff_mean = coeff / scale;
+        return reduction<reduction_op_add, reduction_op_add, post_process_identity>(a, b, 0.f, w, h, d, channels, view_elempack, cstep, reduce_w, reduce_h, reduce_d, reduce_c, true, coeff_mean, opt);
+    }
+
+    if (operation == ReductionOp_MAX)
+        return reduction<reduction_op_max, reduction_op_max, post_process_identity>(a, b, -FLT_MAX, w, h, d, channels, view_elempack, cstep, reduce_w, reduce_h, reduce_d, reduce_c, false, coeff, opt);
+
+    if (operation == ReductionOp_MIN)
+        return reduction<reduction_op_min, reduction_op_min, post_process_identity>(a, b, FLT_MAX, w, h, d, channels, view_elempack, cstep, reduce_w, reduce_h, reduce_d, reduce_c, false, coeff, opt);
+
+    if (operation == ReductionOp_PROD)
+        return reduction<reduction_op_mul, reduction_op_mul, post_process_identity>(a, b, 1.f, w, h, d, channels, view_elempack, cstep, reduce_w, reduce_h, reduce_d, reduce_c, false, coeff, opt);
+
+    if (operation == ReductionOp_L1)
+        return reduction<reduction_op_asum, reduction_op_add, post_process_identity>(a, b, 0.f, w, h, d, channels, view_elempack, cstep, reduce_w, reduce_h, reduce_d, reduce_c, false, 1.f, opt);
+
+    if (operation == ReductionOp_L2)
+        return reduction<reduction_op_sumsq, reduction_op_add, post_process_sqrt>(a, b, 0.f, w, h, d, channels, view_elempack, cstep, reduce_w, reduce_h, reduce_d, reduce_c, true, 1.f, opt);
+
+    if (operation == ReductionOp_LogSum)
+        return reduction<reduction_op_add, reduction_op_add, post_process_log>(a, b, 0.f, w, h, d, channels, view_elempack, cstep, reduce_w, reduce_h, reduce_d, reduce_c, true, 1.f, opt);
+
+    if (operation == ReductionOp_LogSumExp)
+        return reduction<reduction_op_sumsexp, reduction_op_add, post_process_log>(a, b, 0.f, w, h, d, channels, view_elempack, cstep, reduce_w, reduce_h, reduce_d, reduce_c, true, 1.f, opt);
+
+    return 0;
+}
+
+} // namespace ncnn
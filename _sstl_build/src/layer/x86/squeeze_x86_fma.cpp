@@ -0,0 +1,112 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "squeeze_x86_fma.h"
+
+namespace ncnn {
+
+Squeeze_x86_fma::Squeeze_x86_fma()
+{
+#if __SSE2__
+    support_packing = true;
+#endif // __SSE2__
+#if NCNN_BF16
+    support_bf16_storage = true;
+#endif
+}
+
+int Squeeze_x86_fma::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    int w = bottom_blob.w;
+    int h = bottom_blob.h;
+    int d = bottom_blob.d;
+    int channels = bottom_blob.c;
+    int dims = bottom_blob.dims;
+    int elempack = bottom_blob.elempack;
+
+    if (elempack == 1)
+        return Squeeze::forward(bottom_blob, top_blob, opt);
+
+    // the packed outermost axis holds at least elempack elements and never squeezes
+    // dropping any inner axis is a plain reshape that keeps the packing
+    bool _squeeze_w = false;
+    bool _squeeze_h = false;
+    bool _squeeze_d = false;
+
+    if (axes.empty())
+    {
+        _squeeze_w = w == 1 && squeeze_w;
+        _squeeze_h = h == 1 && squeeze_h;
+        _squeeze_d = d == 1 && squeeze_d;
+    }
+    else
+    {
+        const int* axes_ptr = axes;
+        for (int i = 0; i < axes.w; i++)
+        {
+            int axis = axes_ptr[i];
+            if (axis < 0)
+                axis = dims + axis;
+
+            if (dims == 2 && axis == 1)
+                _squeeze_w = w == 1;
+            if (dims == 3 && axis == 1)
+                _squeeze_h = h == 1;
+            if (dims == 3 && axis == 2)
+                _squeeze_w = w == 1;
+            if (dims == 4 && axis == 1)
+                _squeeze_d = d == 1;
+            if (dims == 4 && axis == 2)
+                _squeeze_h = h == 1;
+            if (dims == 4 && axis == 3)
+                _squeeze_w = w == 1;
+        }
+    }
+
+    if (dims == 1)
+    {
+        top_blob = bottom_blob;
+        return 0;
+    }
+
+    // the remaining axes from the innermost, the packed one last
+    int shape[4];
+    int outdims = 0;
+    if (!_squeeze_w)
+        shape[outdims++] = w;
+    if (dims >= 3 && !_squeeze_h)
+        shape[outdims++] = h;
+    if (dims == 4 && !_squeeze_d)
+        shape[outdims++] = d;
+    shape[outdims++] = dims == 2 ? h : channels;
+
+    if (outdims == dims)
+    {
+        top_blob = bottom_blob;
+        return 0;
+    }
+
+    if (outdims == 1)
+        top_blob = bottom_blob.reshape(shape[0], opt.blob_allocator);
+    if (outdims == 2)
+        top_blob = bottom_blob.reshape(shape[0], shape[1], opt.blob_allocator);
+    if (outdims == 3)
+        top_blob = bottom_blob.reshape(shape[0], shape[1], shape[2], opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    return 0;
+}
+
+} // namespace ncnn
@@ -0,0 +1,224 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tile_x86_avx.h"
+
+#include <string.h>
+
+namespace ncnn {
+
+Tile_x86_avx::Tile_x86_avx()
+{
+#if __SSE2__
+    support_packing = true;
+#endif // __SSE2__
+#if NCNN_BF16
+    support_bf16_storage = true;
+#endif
+}
+
+int Tile_x86_avx::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    int dims = bottom_blob.dims;
+    int elempack = bottom_blob.elempack;
+
+    const int repeats_num = repeats.w;
+    const int outdims = std::max(dims, repeats_num);
+
+    if (elempack == 1 && bottom_blob.elembits() == 32)
+        return Tile::forward(bottom_blob, top_blob, opt);
+
+    if (outdims != dims)
+    {
+        // new outer axes push the packed axis inward, unpack first
+        Mat bottom_blob_unpacked = bottom_blob;
+        if (elempack != 1)
+        {
+            Option opt_pack = opt;
+            opt_pack.blob_allocator = opt.workspace_allocator;
+
+            convert_packing(bottom_blob, bottom_blob_unpacked, 1, opt_pack);
+            if (bottom_blob_unpacked.empty())
+                return -100;
+        }
+
+        if (bottom_blob_unpacked.elembits() == 32)
+            return Tile::forward(bottom_blob_unpacked, top_blob, opt);
+
+        return forward_tile(bottom_blob_unpacked, top_blob, outdims, opt);
+    }
+
+    return forward_tile(bottom_blob, top_blob, outdims, opt);
+}
+
+int Tile_x86_avx::forward_tile(const Mat& bottom_blob, Mat& top_blob, int outdims, const Option& opt) const
+{
+    // the outermost axis is the packed one, tiling it repeats whole packs
+    // so everything is moved in units of elemsize, which also covers bf16 storage
+    int dims = bottom_blob.dims;
+    int repeat_w = 1;
+    int repeat_h = 1;
+    int repeat_d = 1;
+    int repeat_c = 1;
+
+    const int repeats_num = repeats.w;
+
+    if (repeats.empty())
+    {
+        if (dims == 1) // axis == 0
+        {
+            repeat_w = tiles;
+        }
+        else if (dims == 2)
+        {
+            if (axis == 0) repeat_h = tiles;
+            if (axis == 1) repeat_w = tiles;
+        }
+        else if (dims == 3)
+        {
+            if (axis == 0) repeat_c = tiles;
+            if (axis == 1) repeat_h = tiles;
+            if (axis == 2) repeat_w = tiles;
+        }
+        else if (dims == 4)
+        {
+            if (axis == 0) repeat_c = tiles;
+            if (axis == 1) repeat_d = tiles;
+            if (axis == 2) repeat_h = tiles;
+            if (axis == 3) repeat_w = tiles;
+        }
+    }
+    else
+    {
+        // numpy style tile
+        const int* repeats_ptr = repeats;
+
+        if (repeats_num == 1)
+        {
+            repeat_w = repeats_ptr[0];
+        }
+        if (repeats_num == 2)
+        {
+            repeat_h = repeats_ptr[0];
+            repeat_w = repeats_ptr[1];
+        }
+        if (repeats_num == 3)
+        {
+            if (dims == 4)
+            {
+                repeat_d = repeats_ptr[0];
+                repeat_h = repeats_ptr[1];
+                repeat_w = repeats_ptr[2];
+            }
+            else
+            {
+                repeat_c = repeats_ptr[0];
+                repeat_h = repeats_ptr[1];
+                repeat_w = repeats_ptr[2];
+            }
+        }
+        if (repeats_num == 4)
+        {
+            repeat_c = repeats_ptr[0];
+            repeat_d = repeats_ptr[1];
+            repeat_h = repeats_ptr[2];
+            repeat_w = repeats_ptr[3];
+        }
+    }
+
+    if (repeat_w == 1 && repeat_h == 1 && repeat_d == 1 && repeat_c == 1 && outdims == dims)
+    {
+        top_blob = bottom_blob;
+        return 0;
+    }
+
+    int w = bottom_blob.w;
+    int h = bottom_blob.h;
+    int d = bottom_blob.d;
+    int channels = bottom_blob.c;
+    size_t elemsize = bottom_blob.elemsize;
+    int elempack = bottom_blob.elempack;
+
+    if (outdims == 1)
+        top_blob.create(w * repeat_w, elemsize, elempack, opt.blob_allocator);
+    if (outdims == 2)
+        top_blob.create(w * repeat_w, h * repeat_h, elemsize, elempack, opt.blob_allocator);
+    if (outdims == 3)
+        top_blob.create(w * repeat_w, h * repeat_h, channels * repeat_c, elemsize, elempack, opt.blob_allocator);
+    if (outdims == 4)
+        top_blob.create(w * repeat_w, h * repeat_h, d * repeat_d, channels * repeat_c, elemsize, elempack, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < channels; q++)
+    {
+        // repeat 0-w
+        for (int z = 0; z < d; z++)
+        {
+            for (int y = 0; y < h; y++)
+            {
+                const unsigned char* ptr = bottom_blob.channel(q).depth(z).row<const unsigned char>(y);
+                unsigned char* outptr = top_blob.channel(q).depth(z).row<unsigned char>(y);
+
+                for (int p = 0; p < repeat_w; p++)
+                {
+                    memcpy(outptr, ptr, w * elemsize);
+                    outptr += w * elemsize;
+                }
+            }
+        }
+
+        // repeat 1-h
+        for (int z = 0; z < d; z++)
+        {
+            const unsigned char* ptr = top_blob.channel(q).depth(z);
+            unsigned char* outptr = top_blob.channel(q).depth(z).row<unsigned char>(h);
+
+            const size_t size = w * repeat_w * h * elemsize;
+            for (int p = 1; p < repeat_h; p++)
+            {
+                memcpy(outptr, ptr, size);
+                outptr += size;
+            }
+        }
+
+        // repeat 1-d
+        {
+            const unsigned char* ptr = top_blob.channel(q);
+            unsigned char* outptr = top_blob.channel(q).depth(d);
+
+            const size_t size = w * repeat_w * h * repeat_h * d * elemsize;
+            for (int p = 1; p < repeat_d; p++)
+            {
+                memcpy(outptr, ptr, size);
+                outptr += size;
+            }
+        }
+    }
+
+    // repeat 1-c
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int p = 1; p < repeat_c; p++)
+    {
+        const unsigned char* ptr = top_blob.channel_range(0, channels);
+        unsigned char* outptr = top_blob.channel_range(p * channels, channels);
+
+        memcpy(outptr, ptr, top_blob.cstep * channels * elemsize);
+    }
+
+    return 0;
+}
+
+} // namespace ncnn
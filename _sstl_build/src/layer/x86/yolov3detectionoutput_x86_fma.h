@@ -0,0 +1,32 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef LAYER_YOLOV3DETECTIONOUTPUT_X86_FMA_H
+#define LAYER_YOLOV3DETECTIONOUTPUT_X86_FMA_H
+
+#include "yolov3detectionoutput.h"
+
+namespace ncnn {
+
+class Yolov3DetectionOutput_x86_fma : public Yolov3DetectionOutput
+{
+public:
+    Yolov3DetectionOutput_x86_fma();
+
+    virtual int forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const;
+};
+
+} // namespace ncnn
+
+#endif // LAYER_YOLOV3DETECTIONOUTPUT_X86_FMA_H
@@ -0,0 +1,5 @@
+// Layer Shader Registry header
+//
+// This file is auto-generated by cmake, don't edit it.
+
+
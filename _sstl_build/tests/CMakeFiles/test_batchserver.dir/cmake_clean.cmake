@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_batchserver.dir/test_batchserver.cpp.o"
+  "CMakeFiles/test_batchserver.dir/test_batchserver.cpp.o.d"
+  "test_batchserver"
+  "test_batchserver.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_batchserver.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_bnll.dir/test_bnll.cpp.o"
+  "CMakeFiles/test_bnll.dir/test_bnll.cpp.o.d"
+  "test_bnll"
+  "test_bnll.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_bnll.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
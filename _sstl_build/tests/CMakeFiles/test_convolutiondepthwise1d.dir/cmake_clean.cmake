@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_convolutiondepthwise1d.dir/test_convolutiondepthwise1d.cpp.o"
+  "CMakeFiles/test_convolutiondepthwise1d.dir/test_convolutiondepthwise1d.cpp.o.d"
+  "test_convolutiondepthwise1d"
+  "test_convolutiondepthwise1d.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_convolutiondepthwise1d.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_deconvolutiondepthwise3d.dir/test_deconvolutiondepthwise3d.cpp.o"
+  "CMakeFiles/test_deconvolutiondepthwise3d.dir/test_deconvolutiondepthwise3d.cpp.o.d"
+  "test_deconvolutiondepthwise3d"
+  "test_deconvolutiondepthwise3d.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_deconvolutiondepthwise3d.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
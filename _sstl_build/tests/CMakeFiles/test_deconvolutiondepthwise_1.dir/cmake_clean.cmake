@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_deconvolutiondepthwise_1.dir/test_deconvolutiondepthwise_1.cpp.o"
+  "CMakeFiles/test_deconvolutiondepthwise_1.dir/test_deconvolutiondepthwise_1.cpp.o.d"
+  "test_deconvolutiondepthwise_1"
+  "test_deconvolutiondepthwise_1.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_deconvolutiondepthwise_1.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
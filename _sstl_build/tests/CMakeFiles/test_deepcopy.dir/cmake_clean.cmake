@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_deepcopy.dir/test_deepcopy.cpp.o"
+  "CMakeFiles/test_deepcopy.dir/test_deepcopy.cpp.o.d"
+  "test_deepcopy"
+  "test_deepcopy.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_deepcopy.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
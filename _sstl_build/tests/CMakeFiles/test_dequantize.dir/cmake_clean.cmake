@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_dequantize.dir/test_dequantize.cpp.o"
+  "CMakeFiles/test_dequantize.dir/test_dequantize.cpp.o.d"
+  "test_dequantize"
+  "test_dequantize.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_dequantize.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
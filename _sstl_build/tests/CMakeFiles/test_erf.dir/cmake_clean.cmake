@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_erf.dir/test_erf.cpp.o"
+  "CMakeFiles/test_erf.dir/test_erf.cpp.o.d"
+  "test_erf"
+  "test_erf.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_erf.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
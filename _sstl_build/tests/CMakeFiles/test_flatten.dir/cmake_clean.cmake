@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_flatten.dir/test_flatten.cpp.o"
+  "CMakeFiles/test_flatten.dir/test_flatten.cpp.o.d"
+  "test_flatten"
+  "test_flatten.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_flatten.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_gelu.dir/test_gelu.cpp.o"
+  "CMakeFiles/test_gelu.dir/test_gelu.cpp.o.d"
+  "test_gelu"
+  "test_gelu.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_gelu.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_gemm_2.dir/test_gemm_2.cpp.o"
+  "CMakeFiles/test_gemm_2.dir/test_gemm_2.cpp.o.d"
+  "test_gemm_2"
+  "test_gemm_2.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_gemm_2.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_glu.dir/test_glu.cpp.o"
+  "CMakeFiles/test_glu.dir/test_glu.cpp.o.d"
+  "test_glu"
+  "test_glu.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_glu.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
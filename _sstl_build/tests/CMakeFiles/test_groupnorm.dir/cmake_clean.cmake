@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_groupnorm.dir/test_groupnorm.cpp.o"
+  "CMakeFiles/test_groupnorm.dir/test_groupnorm.cpp.o.d"
+  "test_groupnorm"
+  "test_groupnorm.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_groupnorm.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
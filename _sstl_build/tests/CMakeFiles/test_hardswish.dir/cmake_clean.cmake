@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_hardswish.dir/test_hardswish.cpp.o"
+  "CMakeFiles/test_hardswish.dir/test_hardswish.cpp.o.d"
+  "test_hardswish"
+  "test_hardswish.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_hardswish.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_innerproduct.dir/test_innerproduct.cpp.o"
+  "CMakeFiles/test_innerproduct.dir/test_innerproduct.cpp.o.d"
+  "test_innerproduct"
+  "test_innerproduct.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_innerproduct.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_mat_normalize.dir/test_mat_normalize.cpp.o"
+  "CMakeFiles/test_mat_normalize.dir/test_mat_normalize.cpp.o.d"
+  "test_mat_normalize"
+  "test_mat_normalize.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_mat_normalize.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
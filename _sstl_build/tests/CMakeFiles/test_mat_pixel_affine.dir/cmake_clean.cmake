@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_mat_pixel_affine.dir/test_mat_pixel_affine.cpp.o"
+  "CMakeFiles/test_mat_pixel_affine.dir/test_mat_pixel_affine.cpp.o.d"
+  "test_mat_pixel_affine"
+  "test_mat_pixel_affine.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_mat_pixel_affine.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
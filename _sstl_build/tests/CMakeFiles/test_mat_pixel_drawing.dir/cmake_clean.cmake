@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_mat_pixel_drawing.dir/test_mat_pixel_drawing.cpp.o"
+  "CMakeFiles/test_mat_pixel_drawing.dir/test_mat_pixel_drawing.cpp.o.d"
+  "test_mat_pixel_drawing"
+  "test_mat_pixel_drawing.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_mat_pixel_drawing.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
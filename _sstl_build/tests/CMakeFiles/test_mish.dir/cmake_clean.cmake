@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_mish.dir/test_mish.cpp.o"
+  "CMakeFiles/test_mish.dir/test_mish.cpp.o.d"
+  "test_mish"
+  "test_mish.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_mish.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
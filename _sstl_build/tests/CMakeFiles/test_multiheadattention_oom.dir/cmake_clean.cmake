@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_multiheadattention_oom.dir/test_multiheadattention_oom.cpp.o"
+  "CMakeFiles/test_multiheadattention_oom.dir/test_multiheadattention_oom.cpp.o.d"
+  "test_multiheadattention_oom"
+  "test_multiheadattention_oom.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_multiheadattention_oom.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
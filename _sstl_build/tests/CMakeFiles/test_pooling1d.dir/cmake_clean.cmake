@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_pooling1d.dir/test_pooling1d.cpp.o"
+  "CMakeFiles/test_pooling1d.dir/test_pooling1d.cpp.o.d"
+  "test_pooling1d"
+  "test_pooling1d.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_pooling1d.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
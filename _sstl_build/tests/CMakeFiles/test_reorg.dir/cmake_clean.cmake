@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_reorg.dir/test_reorg.cpp.o"
+  "CMakeFiles/test_reorg.dir/test_reorg.cpp.o.d"
+  "test_reorg"
+  "test_reorg.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_reorg.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_roialign.dir/test_roialign.cpp.o"
+  "CMakeFiles/test_roialign.dir/test_roialign.cpp.o.d"
+  "test_roialign"
+  "test_roialign.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_roialign.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_shrink.dir/test_shrink.cpp.o"
+  "CMakeFiles/test_shrink.dir/test_shrink.cpp.o.d"
+  "test_shrink"
+  "test_shrink.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_shrink.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_softplus.dir/test_softplus.cpp.o"
+  "CMakeFiles/test_softplus.dir/test_softplus.cpp.o.d"
+  "test_softplus"
+  "test_softplus.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_softplus.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
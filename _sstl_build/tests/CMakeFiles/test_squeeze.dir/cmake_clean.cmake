@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_squeeze.dir/test_squeeze.cpp.o"
+  "CMakeFiles/test_squeeze.dir/test_squeeze.cpp.o.d"
+  "test_squeeze"
+  "test_squeeze.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_squeeze.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
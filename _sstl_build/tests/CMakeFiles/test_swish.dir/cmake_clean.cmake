@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_swish.dir/test_swish.cpp.o"
+  "CMakeFiles/test_swish.dir/test_swish.cpp.o.d"
+  "test_swish"
+  "test_swish.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_swish.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
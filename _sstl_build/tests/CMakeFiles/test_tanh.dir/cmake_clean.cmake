@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_tanh.dir/test_tanh.cpp.o"
+  "CMakeFiles/test_tanh.dir/test_tanh.cpp.o.d"
+  "test_tanh"
+  "test_tanh.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_tanh.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_unaryop.dir/test_unaryop.cpp.o"
+  "CMakeFiles/test_unaryop.dir/test_unaryop.cpp.o.d"
+  "test_unaryop"
+  "test_unaryop.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_unaryop.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_yolov3detectionoutput.dir/test_yolov3detectionoutput.cpp.o"
+  "CMakeFiles/test_yolov3detectionoutput.dir/test_yolov3detectionoutput.cpp.o.d"
+  "test_yolov3detectionoutput"
+  "test_yolov3detectionoutput.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_yolov3detectionoutput.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
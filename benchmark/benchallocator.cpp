@@ -0,0 +1,193 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "allocator.h"
+#include "benchmark.h"
+#include "cpu.h"
+
+#ifndef NCNN_SIMPLESTL
+#include <vector>
+#endif
+
+// multi-threaded allocator stress test
+// every thread replays inference-like allocation sequences against one shared allocator
+
+class HeapAllocator : public ncnn::Allocator
+{
+public:
+    virtual void* fastMalloc(size_t size)
+    {
+        return ncnn::fastMalloc(size);
+    }
+    virtual void fastFree(void* ptr)
+    {
+        ncnn::fastFree(ptr);
+    }
+};
+
+struct StressArgs
+{
+    ncnn::Allocator* allocator;
+    int thread_id;
+    int loop_count;
+    int errors;
+};
+
+// feature map sizes of a typical mobile network, from tiny vectors to large activations
+static const size_t g_sizes[] = {
+    64, 256, 1000, 4096, 12544, 50176, 100352, 200704, 401408, 802816, 1605632, 3211264
+};
+
+static const int g_size_count = sizeof(g_sizes) / sizeof(g_sizes[0]);
+
+static void* stress_thread(void* _args)
+{
+    StressArgs* args = (StressArgs*)_args;
+
+    unsigned int seed = 7767517 + args->thread_id;
+
+    const int slot_count = 32;
+    void* ptrs[slot_count];
+    size_t sizes[slot_count];
+    for (int i = 0; i < slot_count; i++)
+    {
+        ptrs[i] = 0;
+        sizes[i] = 0;
+    }
+
+    for (int i = 0; i < args->loop_count; i++)
+    {
+        // allocate a burst, like the blobs of one layer chain
+        for (int j = 0; j < slot_count; j++)
+        {
+            seed = seed * 1664525 + 1013904223;
+            if (ptrs[j] && (seed >> 24) % 2 == 0)
+                continue;
+
+            if (ptrs[j])
+            {
+                const unsigned char tag = (unsigned char)(j + args->thread_id);
+                if (((unsigned char*)ptrs[j])[0] != tag || ((unsigned char*)ptrs[j])[sizes[j] - 1] != tag)
+                    args->errors++;
+
+                args->allocator->fastFree(ptrs[j]);
+            }
+
+            sizes[j] = g_sizes[(seed >> 8) % g_size_count] + (seed >> 16) % 64;
+            ptrs[j] = args->allocator->fastMalloc(sizes[j]);
+            if (!ptrs[j])
+            {
+                args->errors++;
+                continue;
+            }
+
+            const unsigned char tag = (unsigned char)(j + args->thread_id);
+            ((unsigned char*)ptrs[j])[0] = tag;
+            ((unsigned char*)ptrs[j])[sizes[j] - 1] = tag;
+        }
+    }
+
+    for (int j = 0; j < slot_count; j++)
+    {
+        if (ptrs[j])
+            args->allocator->fastFree(ptrs[j]);
+    }
+
+    return 0;
+}
+
+static double stress(ncnn::Allocator* allocator, int thread_count, int loop_count, int* errors)
+{
+    std::vector<StressArgs> args(thread_count);
+    std::vector<ncnn::Thread*> threads(thread_count);
+
+    double start = ncnn::get_current_time();
+
+    for (int i = 0; i < thread_count; i++)
+    {
+        args[i].allocator = allocator;
+        args[i].thread_id = i;
+        args[i].loop_count = loop_count;
+        args[i].errors = 0;
+        threads[i] = new ncnn::Thread(stress_thread, &args[i]);
+    }
+
+    *errors = 0;
+    for (int i = 0; i < thread_count; i++)
+    {
+        threads[i]->join();
+        delete threads[i];
+        *errors += args[i].errors;
+    }
+
+    double end = ncnn::get_current_time();
+
+    return end - start;
+}
+
+int main(int argc, char** argv)
+{
+    int thread_count = ncnn::get_cpu_count();
+    int loop_count = 2000;
+
+    if (argc >= 2)
+    {
+        thread_count = atoi(argv[1]);
+    }
+    if (argc >= 3)
+    {
+        loop_count = atoi(argv[2]);
+    }
+
+    fprintf(stderr, "thread_count = %d\n", thread_count);
+    fprintf(stderr, "loop_count = %d\n", loop_count);
+
+    int ret = 0;
+
+    {
+        HeapAllocator allocator;
+        int errors = 0;
+        double time = stress(&allocator, thread_count, loop_count, &errors);
+        fprintf(stderr, "%24s  time = %8.2f ms  errors = %d\n", "heap", time, errors);
+        ret |= errors;
+    }
+
+    {
+        ncnn::PoolAllocator allocator;
+        int errors = 0;
+        double time = stress(&allocator, thread_count, loop_count, &errors);
+        fprintf(stderr, "%24s  time = %8.2f ms  errors = %d\n", "PoolAllocator", time, errors);
+        ret |= errors;
+    }
+
+    {
+        ncnn::SizeClassPoolAllocator allocator;
+        int errors = 0;
+        double time = stress(&allocator, thread_count, loop_count, &errors);
+        fprintf(stderr, "%24s  time = %8.2f ms  errors = %d\n", "SizeClassPoolAllocator", time, errors);
+
+        const size_t hit_count = allocator.hit_count();
+        const size_t miss_count = allocator.miss_count();
+        fprintf(stderr, "%24s  hit = %lu  miss = %lu  hit rate = %.2f%%  cached = %lu KB  in use = %lu KB\n", "",
+                (unsigned long)hit_count, (unsigned long)miss_count, hit_count * 100.0 / (hit_count + miss_count),
+                (unsigned long)(allocator.bytes_cached() / 1024), (unsigned long)(allocator.bytes_in_use() / 1024));
+        ret |= errors;
+    }
+
+    return ret == 0 ? 0 : 1;
+}
@@ -0,0 +1,206 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <float.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+
+#include "allocator.h"
+#include "benchmark.h"
+#include "cpu.h"
+#include "layer.h"
+#include "mat.h"
+
+// MultiHeadAttention self attention across sequence lengths
+// reports the average time and the peak memory of blobs and workspace
+
+class PeakAllocator : public ncnn::Allocator
+{
+public:
+    PeakAllocator()
+    {
+        current = 0;
+        peak = 0;
+    }
+
+    virtual void* fastMalloc(size_t size)
+    {
+        ncnn::MutexLockGuard guard(lock);
+
+        size_t* ptr = (size_t*)ncnn::fastMalloc(size + NCNN_MALLOC_ALIGN);
+        if (!ptr)
+            return 0;
+
+        ptr[0] = size;
+        current += size;
+        if (current > peak)
+            peak = current;
+
+        return (unsigned char*)ptr + NCNN_MALLOC_ALIGN;
+    }
+
+    virtual void fastFree(void* ptr)
+    {
+        ncnn::MutexLockGuard guard(lock);
+
+        size_t* p = (size_t*)((unsigned char*)ptr - NCNN_MALLOC_ALIGN);
+        current -= p[0];
+
+        ncnn::fastFree(p);
+    }
+
+public:
+    ncnn::Mutex lock;
+    size_t current;
+    size_t peak;
+};
+
+static ncnn::Mat RandomMat(int w, int h)
+{
+    ncnn::Mat m(w, h);
+    float* p = m;
+    for (int i = 0; i < w * h; i++)
+    {
+        p[i] = (rand() % 2000 - 1000) / 1000.f;
+    }
+    return m;
+}
+
+static int bench_attention(int seqlen, int embed_dim, int num_heads, int loop_count, const ncnn::Option& _opt)
+{
+    ncnn::Layer* op = ncnn::create_layer("MultiHeadAttention");
+
+    ncnn::ParamDict pd;
+    pd.set(0, embed_dim);
+    pd.set(1, num_heads);
+    pd.set(2, embed_dim * embed_dim);
+    op->load_param(pd);
+
+    ncnn::Mat weights[8];
+    weights[0] = RandomMat(embed_dim * embed_dim, 1);
+    weights[1] = RandomMat(embed_dim, 1);
+    weights[2] = RandomMat(embed_dim * embed_dim, 1);
+    weights[3] = RandomMat(embed_dim, 1);
+    weights[4] = RandomMat(embed_dim * embed_dim, 1);
+    weights[5] = RandomMat(embed_dim, 1);
+    weights[6] = RandomMat(embed_dim * embed_dim, 1);
+    weights[7] = RandomMat(embed_dim, 1);
+    op->load_model(ncnn::ModelBinFromMatArray(weights));
+
+    PeakAllocator allocator;
+
+    ncnn::Option opt = _opt;
+    opt.blob_allocator = &allocator;
+    opt.workspace_allocator = &allocator;
+
+    op->create_pipeline(opt);
+
+    std::vector<ncnn::Mat> bottom_blobs(1);
+    bottom_blobs[0] = RandomMat(embed_dim, seqlen);
+
+    double time_min = DBL_MAX;
+    double time_max = -DBL_MAX;
+    double time_avg = 0;
+
+    int ret = 0;
+    for (int i = 0; i < loop_count + 1; i++)
+    {
+        std::vector<ncnn::Mat> top_blobs(1);
+
+        double start = ncnn::get_current_time();
+
+        ret = op->forward(bottom_blobs, top_blobs, opt);
+
+        double end = ncnn::get_current_time();
+
+        if (ret != 0)
+            break;
+
+        // the first run warms up
+        if (i == 0)
+            continue;
+
+        double time = end - start;
+        time_min = std::min(time_min, time);
+        time_max = std::max(time_max, time);
+        time_avg += time;
+    }
+
+    op->destroy_pipeline(opt);
+    delete op;
+
+    if (ret != 0)
+    {
+        fprintf(stderr, "seqlen = %d forward failed %d\n", seqlen, ret);
+        return ret;
+    }
+
+    time_avg /= loop_count;
+
+    // what a materialized score matrix of all heads would take
+    const double qk_mb = (double)seqlen * seqlen * num_heads * sizeof(float) / 1024 / 1024;
+
+    fprintf(stderr, "seqlen = %5d  min = %9.2f  max = %9.2f  avg = %9.2f  peak = %8.2f MB  qk = %8.2f MB\n", seqlen, time_min, time_max, time_avg, allocator.peak / 1024.0 / 1024.0, qk_mb);
+
+    return 0;
+}
+
+int main(int argc, char** argv)
+{
+    int loop_count = 4;
+    int num_threads = ncnn::get_physical_big_cpu_count();
+    int embed_dim = 768;
+    int num_heads = 12;
+
+    if (argc >= 2)
+    {
+        loop_count = atoi(argv[1]);
+    }
+    if (argc >= 3)
+    {
+        num_threads = atoi(argv[2]);
+    }
+    if (argc >= 4)
+    {
+        embed_dim = atoi(argv[3]);
+    }
+    if (argc >= 5)
+    {
+        num_heads = atoi(argv[4]);
+    }
+
+    ncnn::Option opt;
+    opt.lightmode = true;
+    opt.num_threads = num_threads;
+
+    fprintf(stderr, "loop_count = %d\n", loop_count);
+    fprintf(stderr, "num_threads = %d\n", num_threads);
+    fprintf(stderr, "embed_dim = %d\n", embed_dim);
+    fprintf(stderr, "num_heads = %d\n", num_heads);
+
+    // vit 224 patch16, then long sequences
+    static const int seqlens[] = {197, 256, 512, 1024, 2048, 4096};
+
+    for (int i = 0; i < (int)(sizeof(seqlens) / sizeof(seqlens[0])); i++)
+    {
+        int ret = bench_attention(seqlens[i], embed_dim, num_heads, loop_count, opt);
+        if (ret != 0)
+            return ret;
+    }
+
+    return 0;
+}
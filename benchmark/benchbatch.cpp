@@ -0,0 +1,225 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+// load generator for examples/batchserver on the local unix domain socket
+//
+// usage: benchbatch socket_path [connection_count] [request_count] [w] [h] [c] [inflight]
+//
+// every connection sends request_count requests and keeps inflight of them outstanding
+// latency is measured from sending a request to receiving its response
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "benchmark.h"
+
+struct ClientArgs
+{
+    const char* socket_path;
+    int request_count;
+    int w;
+    int h;
+    int c;
+    int inflight;
+
+    std::vector<float> latencies;
+    int errors;
+};
+
+static bool read_all(int fd, void* buf, size_t size)
+{
+    unsigned char* p = (unsigned char*)buf;
+    while (size > 0)
+    {
+        ssize_t n = read(fd, p, size);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return false;
+        p += n;
+        size -= n;
+    }
+    return true;
+}
+
+static bool write_all(int fd, const void* buf, size_t size)
+{
+    const unsigned char* p = (const unsigned char*)buf;
+    while (size > 0)
+    {
+        ssize_t n = write(fd, p, size);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return false;
+        p += n;
+        size -= n;
+    }
+    return true;
+}
+
+static bool send_request(int fd, int id, const ClientArgs* args, const std::vector<float>& data)
+{
+    int header[4] = {id, args->w, args->h, args->c};
+    return write_all(fd, header, sizeof(header)) && write_all(fd, data.data(), data.size() * sizeof(float));
+}
+
+static void* client_main(void* _args)
+{
+    ClientArgs* args = (ClientArgs*)_args;
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, args->socket_path, sizeof(addr.sun_path) - 1);
+
+    if (fd < 0 || connect(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0)
+    {
+        fprintf(stderr, "connect %s failed %d\n", args->socket_path, errno);
+        args->errors = args->request_count;
+        if (fd >= 0)
+            close(fd);
+        return 0;
+    }
+
+    std::vector<float> data((size_t)args->w * args->h * args->c, 0.01f);
+    std::vector<double> send_times(args->request_count);
+    std::vector<float> out;
+
+    int sent = 0;
+    int received = 0;
+    bool ok = true;
+
+    for (; sent < std::min(args->inflight, args->request_count) && ok; sent++)
+    {
+        send_times[sent] = ncnn::get_current_time();
+        ok = send_request(fd, sent, args, data);
+    }
+
+    while (received < sent && ok)
+    {
+        int header[5];
+        ok = read_all(fd, header, sizeof(header));
+        if (!ok)
+            break;
+
+        const int id = header[0];
+        const int ret = header[1];
+        const size_t size = (size_t)header[2] * header[3] * header[4];
+
+        out.resize(size);
+        ok = read_all(fd, out.data(), size * sizeof(float));
+        if (!ok)
+            break;
+
+        if (id < 0 || id >= sent || ret != 0)
+        {
+            args->errors++;
+        }
+        else
+        {
+            args->latencies.push_back((float)(ncnn::get_current_time() - send_times[id]));
+        }
+
+        received++;
+
+        if (sent < args->request_count)
+        {
+            send_times[sent] = ncnn::get_current_time();
+            ok = send_request(fd, sent, args, data);
+            sent++;
+        }
+    }
+
+    args->errors += args->request_count - received;
+
+    close(fd);
+
+    return 0;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        fprintf(stderr, "Usage: %s socket_path [connection_count] [request_count] [w] [h] [c] [inflight]\n", argv[0]);
+        return -1;
+    }
+
+    const char* socket_path = argv[1];
+    int connection_count = argc > 2 ? atoi(argv[2]) : 8;
+    int request_count = argc > 3 ? atoi(argv[3]) : 100;
+    int w = argc > 4 ? atoi(argv[4]) : 227;
+    int h = argc > 5 ? atoi(argv[5]) : 227;
+    int c = argc > 6 ? atoi(argv[6]) : 3;
+    int inflight = argc > 7 ? atoi(argv[7]) : 1;
+
+    fprintf(stderr, "connection_count = %d\n", connection_count);
+    fprintf(stderr, "request_count = %d\n", request_count);
+    fprintf(stderr, "input = %d x %d x %d\n", w, h, c);
+    fprintf(stderr, "inflight = %d\n", inflight);
+
+    std::vector<ClientArgs> args(connection_count);
+    std::vector<pthread_t> threads(connection_count);
+
+    double start = ncnn::get_current_time();
+
+    for (int i = 0; i < connection_count; i++)
+    {
+        args[i].socket_path = socket_path;
+        args[i].request_count = request_count;
+        args[i].w = w;
+        args[i].h = h;
+        args[i].c = c;
+        args[i].inflight = std::max(inflight, 1);
+        args[i].errors = 0;
+        pthread_create(&threads[i], 0, client_main, &args[i]);
+    }
+
+    std::vector<float> latencies;
+    int errors = 0;
+    for (int i = 0; i < connection_count; i++)
+    {
+        pthread_join(threads[i], 0);
+        latencies.insert(latencies.end(), args[i].latencies.begin(), args[i].latencies.end());
+        errors += args[i].errors;
+    }
+
+    double end = ncnn::get_current_time();
+
+    if (latencies.empty())
+    {
+        fprintf(stderr, "no response, errors = %d\n", errors);
+        return -1;
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+
+    const int n = (int)latencies.size();
+    fprintf(stderr, "throughput = %8.2f/s  p50 = %7.2f ms  p99 = %7.2f ms  max = %7.2f ms  errors = %d\n",
+            n * 1000.0 / (end - start), latencies[(n - 1) / 2], latencies[(int)((n - 1) * 0.99)], latencies[n - 1], errors);
+
+    return errors == 0 ? 0 : 1;
+}
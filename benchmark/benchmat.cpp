@@ -0,0 +1,231 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <float.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "benchmark.h"
+#include "cpu.h"
+#include "mat.h"
+
+// Mat utilities on segmentation and super-resolution sized blobs
+// reports the average time of each routine for 1 to 32 threads
+
+static int g_loop_count = 10;
+
+struct MatCase
+{
+    virtual ~MatCase()
+    {
+    }
+
+    virtual void run(const ncnn::Option& opt) = 0;
+};
+
+static double bench(MatCase& c, const ncnn::Option& opt)
+{
+    double time_avg = 0;
+
+    for (int i = 0; i < g_loop_count + 1; i++)
+    {
+        double start = ncnn::get_current_time();
+
+        c.run(opt);
+
+        double end = ncnn::get_current_time();
+
+        // the first run warms up
+        if (i == 0)
+            continue;
+
+        time_avg += end - start;
+    }
+
+    return time_avg / g_loop_count;
+}
+
+struct SubstractMeanNormalize : public MatCase
+{
+    SubstractMeanNormalize(const ncnn::Mat& _m)
+        : m(_m)
+    {
+        mean_vals.resize(m.c * m.elempack, 0.5f);
+        norm_vals.resize(m.c * m.elempack, 2.f);
+    }
+
+    virtual void run(const ncnn::Option& opt)
+    {
+        m.substract_mean_normalize(mean_vals.data(), norm_vals.data(), opt);
+    }
+
+    ncnn::Mat m;
+    std::vector<float> mean_vals;
+    std::vector<float> norm_vals;
+};
+
+struct FromFloat16 : public MatCase
+{
+    FromFloat16(const ncnn::Mat& _m)
+        : m(_m)
+    {
+    }
+
+    virtual void run(const ncnn::Option& opt)
+    {
+        ncnn::Mat out = ncnn::Mat::from_float16(m, m.w, opt);
+    }
+
+    ncnn::Mat m;
+};
+
+struct CastFloat32ToFloat16 : public MatCase
+{
+    CastFloat32ToFloat16(const ncnn::Mat& _m)
+        : m(_m)
+    {
+    }
+
+    virtual void run(const ncnn::Option& opt)
+    {
+        ncnn::Mat out;
+        ncnn::cast_float32_to_float16(m, out, opt);
+    }
+
+    ncnn::Mat m;
+};
+
+struct CastFloat16ToFloat32 : public MatCase
+{
+    CastFloat16ToFloat32(const ncnn::Mat& _m)
+        : m(_m)
+    {
+    }
+
+    virtual void run(const ncnn::Option& opt)
+    {
+        ncnn::Mat out;
+        ncnn::cast_float16_to_float32(m, out, opt);
+    }
+
+    ncnn::Mat m;
+};
+
+struct ConvertPacking : public MatCase
+{
+    ConvertPacking(const ncnn::Mat& _m, int _elempack)
+        : m(_m), elempack(_elempack)
+    {
+    }
+
+    virtual void run(const ncnn::Option& opt)
+    {
+        ncnn::Mat out;
+        ncnn::convert_packing(m, out, elempack, opt);
+    }
+
+    ncnn::Mat m;
+    int elempack;
+};
+
+static void bench_threads(const char* name, MatCase& c)
+{
+    static const int threads[] = {1, 2, 4, 8, 16, 32};
+
+    fprintf(stderr, "%24s", name);
+
+    double time_1 = 0;
+    for (int i = 0; i < 6; i++)
+    {
+        ncnn::Option opt;
+        opt.num_threads = threads[i];
+
+        const double time = bench(c, opt);
+        if (i == 0)
+            time_1 = time;
+
+        fprintf(stderr, "  %2d: %7.2f (%4.1fx)", threads[i], time, time_1 / time);
+    }
+
+    fprintf(stderr, "\n");
+}
+
+static void bench_mat(int w, int h, int c)
+{
+    fprintf(stderr, "%d x %d x %d\n", w, h, c);
+
+    ncnn::Mat m(w, h, c);
+    m.fill(0.3f);
+
+    const int elempack = c % 16 == 0 && ncnn::cpu_support_x86_avx512() ? 16 : c % 8 == 0 && ncnn::cpu_support_x86_avx() ? 8 : c % 4 == 0 ? 4 : 1;
+
+    ncnn::Mat mp;
+    ncnn::convert_packing(m, mp, elempack);
+
+    ncnn::Mat m16;
+    ncnn::cast_float32_to_float16(m, m16);
+
+    ncnn::Mat v16 = m16.reshape(w * h * c);
+
+    {
+        SubstractMeanNormalize bc(m);
+        bench_threads("substract_mean_normalize", bc);
+    }
+    {
+        SubstractMeanNormalize bc(mp);
+        bench_threads("  packed", bc);
+    }
+    {
+        FromFloat16 bc(v16);
+        bench_threads("from_float16", bc);
+    }
+    {
+        CastFloat32ToFloat16 bc(m);
+        bench_threads("cast fp32 to fp16", bc);
+    }
+    {
+        CastFloat16ToFloat32 bc(m16);
+        bench_threads("cast fp16 to fp32", bc);
+    }
+    {
+        ConvertPacking bc(m, elempack);
+        bench_threads("convert_packing", bc);
+    }
+    {
+        ConvertPacking bc(mp, 1);
+        bench_threads("  unpack", bc);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc >= 2)
+    {
+        g_loop_count = atoi(argv[1]);
+    }
+
+    fprintf(stderr, "loop_count = %d\n", g_loop_count);
+    fprintf(stderr, "cpu_count = %d\n", ncnn::get_cpu_count());
+
+    // segmentation logits and super-resolution features
+    bench_mat(512, 512, 32);
+    bench_mat(1920, 1080, 3);
+    bench_mat(960, 540, 64);
+
+    return 0;
+}
@@ -23,6 +23,8 @@
 #include "benchmark.h"
 #include "cpu.h"
 #include "datareader.h"
+#include "layer.h"
+#include "layer_type.h"
 #include "net.h"
 #include "gpu.h"
 
@@ -51,6 +53,9 @@ static bool g_enable_cooling_down = true;
 static ncnn::UnlockedPoolAllocator g_blob_pool_allocator;
 static ncnn::PoolAllocator g_workspace_pool_allocator;
 
+// layers may run concurrently in parallel graph mode
+static ncnn::PoolAllocator g_blob_locked_pool_allocator;
+
 #if NCNN_VULKAN
 static ncnn::VulkanDevice* g_vkdev = 0;
 static ncnn::VkAllocator* g_blob_vkallocator = 0;
@@ -61,6 +66,7 @@ void benchmark(const char* comment, const std::vector<ncnn::Mat>& _in, const ncn
 {
     g_blob_pool_allocator.clear();
     g_workspace_pool_allocator.clear();
+    g_blob_locked_pool_allocator.clear();
 
 #if NCNN_VULKAN
     if (opt.use_vulkan_compute)
@@ -183,11 +189,67 @@ void benchmark(const char* comment, const ncnn::Mat& _in, const ncnn::Option& op
     return benchmark(comment, inputs, opt, fixed_path);
 }
 
+// per-region threading overhead, one tiny layer is nearly all fork and join
+void benchmark_forkjoin(const ncnn::Option& opt)
+{
+    ncnn::Option opt1 = opt;
+    opt1.use_packing_layout = false;
+
+    ncnn::Layer* op = ncnn::create_layer_cpu(ncnn::LayerType::ReLU);
+    op->create_pipeline(opt1);
+
+    // one channel per thread
+    ncnn::Mat m(16, 1, opt1.num_threads);
+    m.fill(1.f);
+
+    const int region_count = 1000;
+
+    ncnn::set_kmp_blocktime(opt1.openmp_blocktime);
+
+    // warm up
+    for (int i = 0; i < region_count; i++)
+    {
+        op->forward_inplace(m, opt1);
+    }
+
+    double time_min = DBL_MAX;
+    double time_max = -DBL_MAX;
+    double time_avg = 0;
+
+    for (int i = 0; i < g_loop_count; i++)
+    {
+        double start = ncnn::get_current_time();
+
+        for (int j = 0; j < region_count; j++)
+        {
+            op->forward_inplace(m, opt1);
+        }
+
+        double end = ncnn::get_current_time();
+
+        // microseconds per region
+        double time = (end - start) * 1000 / region_count;
+
+        time_min = std::min(time_min, time);
+        time_max = std::max(time_max, time);
+        time_avg += time;
+    }
+
+    time_avg /= g_loop_count;
+
+    fprintf(stderr, "%20s  min = %7.2f  max = %7.2f  avg = %7.2f\n", "forkjoin (us)", time_min, time_max, time_avg);
+
+    op->destroy_pipeline(opt1);
+    delete op;
+}
+
 void show_usage()
 {
     fprintf(stderr, "Usage: benchncnn [loop count] [num threads] [powersave] [gpu device] [cooling down] [(key=value)...]\n");
     fprintf(stderr, "  param=model.param\n");
     fprintf(stderr, "  shape=[227,227,3],...\n");
+    fprintf(stderr, "  parallel_graph=0|1\n");
+    fprintf(stderr, "  fp16_weight=0|1\n");
 }
 
 static std::vector<ncnn::Mat> parse_shape_list(char* s)
@@ -259,6 +321,8 @@ int main(int argc, char** argv)
     int powersave = 2;
     int gpu_device = -1;
     int cooling_down = 1;
+    int parallel_graph = 0;
+    int fp16_weight = 0;
     char* model = 0;
     std::vector<ncnn::Mat> inputs;
 
@@ -319,6 +383,10 @@ int main(int argc, char** argv)
             model = value;
         if (strcmp(key, "shape") == 0)
             inputs = parse_shape_list(value);
+        if (strcmp(key, "parallel_graph") == 0)
+            parallel_graph = atoi(value);
+        if (strcmp(key, "fp16_weight") == 0)
+            fp16_weight = atoi(value);
     }
 
     if (model && inputs.empty())
@@ -341,6 +409,7 @@ int main(int argc, char** argv)
 
     g_blob_pool_allocator.set_size_compare_ratio(0.f);
     g_workspace_pool_allocator.set_size_compare_ratio(0.f);
+    g_blob_locked_pool_allocator.set_size_compare_ratio(0.f);
 
 #if NCNN_VULKAN
     if (use_vulkan_compute)
@@ -363,7 +432,7 @@ int main(int argc, char** argv)
     ncnn::Option opt;
     opt.lightmode = true;
     opt.num_threads = num_threads;
-    opt.blob_allocator = &g_blob_pool_allocator;
+    opt.blob_allocator = parallel_graph ? (ncnn::Allocator*)&g_blob_locked_pool_allocator : (ncnn::Allocator*)&g_blob_pool_allocator;
     opt.workspace_allocator = &g_workspace_pool_allocator;
 #if NCNN_VULKAN
     opt.blob_vkallocator = g_blob_vkallocator;
@@ -382,12 +451,16 @@ int main(int argc, char** argv)
     opt.use_packing_layout = true;
     opt.use_shader_pack8 = false;
     opt.use_image_storage = false;
+    opt.use_parallel_graph = parallel_graph != 0;
+    opt.use_fp16_weight_storage = fp16_weight != 0;
 
     fprintf(stderr, "loop_count = %d\n", g_loop_count);
     fprintf(stderr, "num_threads = %d\n", num_threads);
     fprintf(stderr, "powersave = %d\n", ncnn::get_cpu_powersave());
     fprintf(stderr, "gpu_device = %d\n", gpu_device);
     fprintf(stderr, "cooling_down = %d\n", (int)g_enable_cooling_down);
+    fprintf(stderr, "parallel_graph = %d\n", parallel_graph);
+    fprintf(stderr, "fp16_weight = %d\n", fp16_weight);
 
     if (model != 0)
     {
@@ -396,6 +469,11 @@ int main(int argc, char** argv)
     }
     else
     {
+        if (!use_vulkan_compute)
+        {
+            benchmark_forkjoin(opt);
+        }
+
         // run default cases
         benchmark("squeezenet", ncnn::Mat(227, 227, 3), opt);
 
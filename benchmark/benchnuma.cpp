@@ -0,0 +1,224 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "benchmark.h"
+#include "cpu.h"
+#include "datareader.h"
+#include "net.h"
+
+#ifndef NCNN_SIMPLESTL
+#include <vector>
+#endif
+
+// throughput of independent extractors, one per numa node
+// shared  = every extractor runs on one net loaded by the main thread, threads float across nodes
+// replica = every node loads its own net copy and the extractor threads are pinned to that node
+
+class DataReaderFromEmpty : public ncnn::DataReader
+{
+public:
+    virtual int scan(const char* format, void* p) const
+    {
+        return 0;
+    }
+    virtual size_t read(void* buf, size_t size) const
+    {
+        memset(buf, 0, size);
+        return size;
+    }
+};
+
+struct WorkerArgs
+{
+    const ncnn::Net* net;
+    int numa_node;
+    int input_size;
+    int loop_count;
+    int errors;
+};
+
+static void* worker_thread(void* _args)
+{
+    WorkerArgs* args = (WorkerArgs*)_args;
+
+    const ncnn::Net* net = args->net;
+
+    const char* input_name = net->input_names()[0];
+    const char* output_name = net->output_names()[0];
+
+    ncnn::Mat in(args->input_size, args->input_size, 3);
+    in.fill(0.01f);
+
+    for (int i = 0; i < args->loop_count; i++)
+    {
+        ncnn::Extractor ex = net->create_extractor();
+        ex.input(input_name, in);
+
+        ncnn::Mat out;
+        int ret = ex.extract(output_name, out);
+        if (ret != 0)
+            args->errors++;
+    }
+
+    // release the node binding of this thread
+    if (args->numa_node >= 0)
+        ncnn::set_cpu_thread_numa_node(-1);
+
+    return 0;
+}
+
+static int load_net(ncnn::Net& net, const char* parampath, const ncnn::Option& opt)
+{
+    net.opt = opt;
+
+    int ret = net.load_param(parampath);
+    if (ret != 0)
+        return ret;
+
+    DataReaderFromEmpty dr;
+    return net.load_model(dr);
+}
+
+static double run(const std::vector<ncnn::Net*>& nets, const std::vector<int>& numa_nodes, int input_size, int loop_count, int* errors)
+{
+    const int worker_count = (int)nets.size();
+
+    std::vector<WorkerArgs> args(worker_count);
+    std::vector<ncnn::Thread*> threads(worker_count);
+
+    double start = ncnn::get_current_time();
+
+    for (int i = 0; i < worker_count; i++)
+    {
+        args[i].net = nets[i];
+        args[i].numa_node = numa_nodes[i];
+        args[i].input_size = input_size;
+        args[i].loop_count = loop_count;
+        args[i].errors = 0;
+        threads[i] = new ncnn::Thread(worker_thread, &args[i]);
+    }
+
+    *errors = 0;
+    for (int i = 0; i < worker_count; i++)
+    {
+        threads[i]->join();
+        delete threads[i];
+        *errors += args[i].errors;
+    }
+
+    double end = ncnn::get_current_time();
+
+    return end - start;
+}
+
+int main(int argc, char** argv)
+{
+    const char* parampath = "squeezenet.param";
+    int input_size = 227;
+    int loop_count = 32;
+    int num_threads = 0;
+
+    if (argc >= 2)
+    {
+        parampath = argv[1];
+    }
+    if (argc >= 3)
+    {
+        input_size = atoi(argv[2]);
+    }
+    if (argc >= 4)
+    {
+        loop_count = atoi(argv[3]);
+    }
+    if (argc >= 5)
+    {
+        num_threads = atoi(argv[4]);
+    }
+
+    const int numa_node_count = ncnn::get_cpu_numa_node_count();
+
+    if (num_threads <= 0)
+    {
+        // one full node per extractor
+        num_threads = ncnn::get_cpu_numa_node_affinity_mask(0).num_enabled();
+    }
+
+    fprintf(stderr, "numa_node_count = %d\n", numa_node_count);
+    for (int i = 0; i < numa_node_count; i++)
+    {
+        fprintf(stderr, "numa_node %d cpu_count = %d\n", i, ncnn::get_cpu_numa_node_affinity_mask(i).num_enabled());
+    }
+    fprintf(stderr, "num_threads = %d\n", num_threads);
+    fprintf(stderr, "loop_count = %d\n", loop_count);
+
+    ncnn::Option opt;
+    opt.num_threads = num_threads;
+
+    int ret = 0;
+
+    {
+        ncnn::Net net;
+        if (load_net(net, parampath, opt) != 0)
+        {
+            fprintf(stderr, "load %s failed\n", parampath);
+            return -1;
+        }
+
+        std::vector<ncnn::Net*> nets(numa_node_count, &net);
+        std::vector<int> numa_nodes(numa_node_count, -1);
+
+        int errors = 0;
+        double time = run(nets, numa_nodes, input_size, loop_count, &errors);
+        fprintf(stderr, "%8s  time = %8.2f ms  throughput = %8.2f/s  errors = %d\n", "shared", time, numa_node_count * loop_count * 1000.0 / time, errors);
+        ret |= errors;
+    }
+
+    {
+        std::vector<ncnn::Net*> nets(numa_node_count);
+        std::vector<int> numa_nodes(numa_node_count);
+
+        for (int i = 0; i < numa_node_count; i++)
+        {
+            ncnn::Option opt_node = opt;
+            opt_node.numa_node = i;
+
+            nets[i] = new ncnn::Net;
+            numa_nodes[i] = i;
+            if (load_net(*nets[i], parampath, opt_node) != 0)
+            {
+                fprintf(stderr, "load %s failed\n", parampath);
+                ret = -1;
+            }
+        }
+
+        if (ret == 0)
+        {
+            int errors = 0;
+            double time = run(nets, numa_nodes, input_size, loop_count, &errors);
+            fprintf(stderr, "%8s  time = %8.2f ms  throughput = %8.2f/s  errors = %d\n", "replica", time, numa_node_count * loop_count * 1000.0 / time, errors);
+            ret |= errors;
+        }
+
+        for (int i = 0; i < numa_node_count; i++)
+        {
+            delete nets[i];
+        }
+    }
+
+    return ret == 0 ? 0 : 1;
+}
@@ -0,0 +1,350 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <float.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "benchmark.h"
+#include "cpu.h"
+#include "mat.h"
+
+// image preprocessing routines at camera resolutions
+// reports the average time and the throughput in megapixels per second
+
+#if NCNN_PIXEL
+static int g_loop_count = 10;
+
+static std::vector<unsigned char> RandomPixels(int size)
+{
+    std::vector<unsigned char> pixels(size);
+    for (int i = 0; i < size; i++)
+    {
+        pixels[i] = rand() % 256;
+    }
+    return pixels;
+}
+
+struct PixelCase
+{
+    virtual ~PixelCase()
+    {
+    }
+
+    virtual void run() = 0;
+};
+
+static void bench(const char* name, int w, int h, PixelCase& c)
+{
+    double time_min = DBL_MAX;
+    double time_max = -DBL_MAX;
+    double time_avg = 0;
+
+    for (int i = 0; i < g_loop_count + 1; i++)
+    {
+        double start = ncnn::get_current_time();
+
+        c.run();
+
+        double end = ncnn::get_current_time();
+
+        // the first run warms up
+        if (i == 0)
+            continue;
+
+        double time = end - start;
+        time_min = std::min(time_min, time);
+        time_max = std::max(time_max, time);
+        time_avg += time;
+    }
+
+    time_avg /= g_loop_count;
+
+    const double mpps = w * h / time_avg / 1000;
+
+    fprintf(stderr, "%24s  %4dx%-4d  min = %7.2f  max = %7.2f  avg = %7.2f  %8.2f MP/s\n", name, w, h, time_min, time_max, time_avg, mpps);
+}
+
+struct FromPixels : public PixelCase
+{
+    FromPixels(const unsigned char* _pixels, int _type, int _w, int _h)
+        : pixels(_pixels), type(_type), w(_w), h(_h)
+    {
+    }
+
+    virtual void run()
+    {
+        m = ncnn::Mat::from_pixels(pixels, type, w, h);
+    }
+
+    const unsigned char* pixels;
+    int type;
+    int w;
+    int h;
+    ncnn::Mat m;
+};
+
+struct ToPixels : public PixelCase
+{
+    ToPixels(const ncnn::Mat& _m, unsigned char* _pixels, int _type)
+        : m(_m), pixels(_pixels), type(_type)
+    {
+    }
+
+    virtual void run()
+    {
+        m.to_pixels(pixels, type);
+    }
+
+    ncnn::Mat m;
+    unsigned char* pixels;
+    int type;
+};
+
+struct YUV420sp2RGB : public PixelCase
+{
+    YUV420sp2RGB(const unsigned char* _yuv, int _w, int _h, unsigned char* _rgb)
+        : yuv(_yuv), w(_w), h(_h), rgb(_rgb)
+    {
+    }
+
+    virtual void run()
+    {
+        ncnn::yuv420sp2rgb(yuv, w, h, rgb);
+    }
+
+    const unsigned char* yuv;
+    int w;
+    int h;
+    unsigned char* rgb;
+};
+
+struct ResizeNormalize : public PixelCase
+{
+    ResizeNormalize(const unsigned char* _pixels, int _w, int _h, int _target_width, int _target_height)
+        : pixels(_pixels), w(_w), h(_h), target_width(_target_width), target_height(_target_height)
+    {
+    }
+
+    virtual void run()
+    {
+        const float mean_vals[3] = {0.f, 0.f, 0.f};
+        const float norm_vals[3] = {1 / 255.f, 1 / 255.f, 1 / 255.f};
+
+        m = ncnn::Mat::from_pixels_resize(pixels, ncnn::Mat::PIXEL_BGR2RGB, w, h, target_width, target_height);
+        m.substract_mean_normalize(mean_vals, norm_vals);
+    }
+
+    const unsigned char* pixels;
+    int w;
+    int h;
+    int target_width;
+    int target_height;
+    ncnn::Mat m;
+};
+
+struct Preprocess : public PixelCase
+{
+    Preprocess(const unsigned char* _pixels, int _type, int _w, int _h, const ncnn::PixelPreprocess& _pp, const ncnn::Option& _opt)
+        : pixels(_pixels), type(_type), w(_w), h(_h), pp(_pp), opt(_opt)
+    {
+    }
+
+    virtual void run()
+    {
+        m = ncnn::Mat::from_pixels_preprocess(pixels, type, w, h, pp, opt);
+    }
+
+    const unsigned char* pixels;
+    int type;
+    int w;
+    int h;
+    ncnn::PixelPreprocess pp;
+    ncnn::Option opt;
+    ncnn::Mat m;
+};
+
+#if NCNN_PIXEL_ROTATE
+struct KannaRotate : public PixelCase
+{
+    KannaRotate(const unsigned char* _src, int _w, int _h, int _c, unsigned char* _dst, int _type)
+        : src(_src), w(_w), h(_h), c(_c), dst(_dst), type(_type)
+    {
+    }
+
+    virtual void run()
+    {
+        const int outw = type >= 5 ? h : w;
+        const int outh = type >= 5 ? w : h;
+
+        if (c == 1) ncnn::kanna_rotate_c1(src, w, h, dst, outw, outh, type);
+        if (c == 3) ncnn::kanna_rotate_c3(src, w, h, dst, outw, outh, type);
+        if (c == 4) ncnn::kanna_rotate_c4(src, w, h, dst, outw, outh, type);
+    }
+
+    const unsigned char* src;
+    int w;
+    int h;
+    int c;
+    unsigned char* dst;
+    int type;
+};
+#endif // NCNN_PIXEL_ROTATE
+
+#if NCNN_PIXEL_AFFINE
+struct WarpAffine : public PixelCase
+{
+    WarpAffine(const unsigned char* _src, int _w, int _h, unsigned char* _dst)
+        : src(_src), w(_w), h(_h), dst(_dst)
+    {
+        ncnn::get_rotation_matrix(15.f, 1.2f, w / 2.f, h / 2.f, tm);
+    }
+
+    virtual void run()
+    {
+        ncnn::warpaffine_bilinear_c3(src, w, h, dst, w, h, tm);
+    }
+
+    const unsigned char* src;
+    int w;
+    int h;
+    unsigned char* dst;
+    float tm[6];
+};
+#endif // NCNN_PIXEL_AFFINE
+
+static void bench_pixel(int w, int h, int num_threads)
+{
+    std::vector<unsigned char> src = RandomPixels(w * h * 4);
+    std::vector<unsigned char> dst(w * h * 4);
+
+    {
+        FromPixels c(src.data(), ncnn::Mat::PIXEL_RGB, w, h);
+        bench("from_pixels rgb", w, h, c);
+    }
+    {
+        FromPixels c(src.data(), ncnn::Mat::PIXEL_BGR2RGB, w, h);
+        bench("from_pixels bgr2rgb", w, h, c);
+    }
+    {
+        FromPixels c(src.data(), ncnn::Mat::PIXEL_RGBA2RGB, w, h);
+        bench("from_pixels rgba2rgb", w, h, c);
+    }
+    {
+        FromPixels c(src.data(), ncnn::Mat::PIXEL_GRAY, w, h);
+        bench("from_pixels gray", w, h, c);
+    }
+
+    ncnn::Mat m = ncnn::Mat::from_pixels(src.data(), ncnn::Mat::PIXEL_RGB, w, h);
+    {
+        ToPixels c(m, dst.data(), ncnn::Mat::PIXEL_RGB);
+        bench("to_pixels rgb", w, h, c);
+    }
+    {
+        ToPixels c(m, dst.data(), ncnn::Mat::PIXEL_RGB2RGBA);
+        bench("to_pixels rgb2rgba", w, h, c);
+    }
+    {
+        YUV420sp2RGB c(src.data(), w, h, dst.data());
+        bench("yuv420sp2rgb", w, h, c);
+    }
+
+    {
+        ResizeNormalize c(src.data(), w, h, 640, 360);
+        bench("resize + normalize", w, h, c);
+    }
+    {
+        ncnn::PixelPreprocess pp;
+        pp.target_width = 640;
+        pp.target_height = 360;
+        pp.norm_vals[0] = 1 / 255.f;
+        pp.norm_vals[1] = 1 / 255.f;
+        pp.norm_vals[2] = 1 / 255.f;
+
+        ncnn::Option opt;
+        opt.num_threads = 1;
+
+        Preprocess c(src.data(), ncnn::Mat::PIXEL_BGR2RGB, w, h, pp, opt);
+        bench("preprocess", w, h, c);
+
+        opt.num_threads = num_threads;
+
+        Preprocess c2(src.data(), ncnn::Mat::PIXEL_BGR2RGB, w, h, pp, opt);
+        bench("preprocess mt", w, h, c2);
+
+        pp.target_height = 640;
+        pp.letterbox = true;
+        pp.pad_value = 114.f;
+
+        Preprocess c3(src.data(), ncnn::Mat::PIXEL_NV212RGB, w, h, pp, opt);
+        bench("preprocess nv21 letterbox", w, h, c3);
+    }
+
+#if NCNN_PIXEL_ROTATE
+    static const int channels[] = {1, 3, 4};
+    static const int types[] = {2, 3, 5, 6, 7, 8};
+    for (int i = 0; i < 3; i++)
+    {
+        for (int j = 0; j < 6; j++)
+        {
+            char name[64];
+            sprintf(name, "kanna_rotate_c%d type %d", channels[i], types[j]);
+
+            KannaRotate c(src.data(), w, h, channels[i], dst.data(), types[j]);
+            bench(name, w, h, c);
+        }
+    }
+#endif // NCNN_PIXEL_ROTATE
+
+#if NCNN_PIXEL_AFFINE
+    {
+        WarpAffine c(src.data(), w, h, dst.data());
+        bench("warpaffine_bilinear_c3", w, h, c);
+    }
+#endif // NCNN_PIXEL_AFFINE
+}
+#endif // NCNN_PIXEL
+
+int main(int argc, char** argv)
+{
+#if NCNN_PIXEL
+    int num_threads = ncnn::get_physical_big_cpu_count();
+
+    if (argc >= 2)
+    {
+        g_loop_count = atoi(argv[1]);
+    }
+    if (argc >= 3)
+    {
+        num_threads = atoi(argv[2]);
+    }
+
+    fprintf(stderr, "loop_count = %d\n", g_loop_count);
+    fprintf(stderr, "num_threads = %d\n", num_threads);
+
+    // 1080p and 4k
+    bench_pixel(1920, 1080, num_threads);
+    bench_pixel(3840, 2160, num_threads);
+#else
+    (void)argc;
+    (void)argv;
+    fprintf(stderr, "benchpixel requires NCNN_PIXEL\n");
+#endif // NCNN_PIXEL
+
+    return 0;
+}
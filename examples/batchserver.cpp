@@ -0,0 +1,302 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+// serve a net on a unix domain socket with dynamic micro-batching
+//
+// usage: batchserver model.param model.bin socket_path [max_batch_size] [max_delay_ms] [worker_count] [num_threads]
+//
+// protocol, native endian int32 and float32, requests may be pipelined on one connection
+//   request   id w h c, then w*h*c floats
+//   response  id ret w h c, then w*h*c floats, in completion order
+//
+// benchmark/benchbatch is a load generator for it
+// server stats are printed every 5 seconds
+
+#include "batchserver.h"
+#include "benchmark.h"
+#include "cpu.h"
+#include "net.h"
+
+#include <errno.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+struct Connection
+{
+    int fd;
+    ncnn::BatchServer* server;
+
+    // responses of different batches are written from different workers
+    pthread_mutex_t write_lock;
+
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    int pending_count;
+};
+
+struct PendingRequest
+{
+    Connection* conn;
+    int id;
+};
+
+static bool read_all(int fd, void* buf, size_t size)
+{
+    unsigned char* p = (unsigned char*)buf;
+    while (size > 0)
+    {
+        ssize_t n = read(fd, p, size);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return false;
+        p += n;
+        size -= n;
+    }
+    return true;
+}
+
+static bool write_all(int fd, const void* buf, size_t size)
+{
+    const unsigned char* p = (const unsigned char*)buf;
+    while (size > 0)
+    {
+        ssize_t n = write(fd, p, size);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return false;
+        p += n;
+        size -= n;
+    }
+    return true;
+}
+
+static void on_done(int ret, const ncnn::Mat& out, void* userdata)
+{
+    PendingRequest* request = (PendingRequest*)userdata;
+    Connection* conn = request->conn;
+
+    // drop the channel padding
+    ncnn::Mat flat = out.empty() ? out : out.reshape(out.w * out.h * out.d * out.c);
+
+    int header[5] = {request->id, ret, out.w, out.h * out.d, out.c};
+    if (flat.empty())
+    {
+        header[2] = 0;
+        header[3] = 0;
+        header[4] = 0;
+    }
+
+    pthread_mutex_lock(&conn->write_lock);
+    write_all(conn->fd, header, sizeof(header));
+    if (!flat.empty())
+        write_all(conn->fd, flat.data, flat.w * sizeof(float));
+    pthread_mutex_unlock(&conn->write_lock);
+
+    pthread_mutex_lock(&conn->lock);
+    conn->pending_count--;
+    pthread_cond_signal(&conn->cond);
+    pthread_mutex_unlock(&conn->lock);
+
+    delete request;
+}
+
+static void* connection_main(void* args)
+{
+    Connection* conn = (Connection*)args;
+
+    for (;;)
+    {
+        int header[4];
+        if (!read_all(conn->fd, header, sizeof(header)))
+            break;
+
+        const int id = header[0];
+        const int w = header[1];
+        const int h = header[2];
+        const int c = header[3];
+        if (w <= 0 || h <= 0 || c <= 0 || (long long)w * h * c > 64 * 1024 * 1024)
+        {
+            fprintf(stderr, "bad request shape %d %d %d\n", w, h, c);
+            break;
+        }
+
+        ncnn::Mat in;
+        if (h == 1 && c == 1)
+            in.create(w);
+        else if (c == 1)
+            in.create(w, h);
+        else
+            in.create(w, h, c);
+
+        bool ok = true;
+        for (int q = 0; q < c && ok; q++)
+        {
+            ok = read_all(conn->fd, in.channel(q), w * h * sizeof(float));
+        }
+        if (!ok)
+            break;
+
+        PendingRequest* request = new PendingRequest;
+        request->conn = conn;
+        request->id = id;
+
+        pthread_mutex_lock(&conn->lock);
+        conn->pending_count++;
+        pthread_mutex_unlock(&conn->lock);
+
+        if (conn->server->submit(in, on_done, request) != 0)
+        {
+            on_done(-1, ncnn::Mat(), request);
+        }
+    }
+
+    // the responses still on the way need the socket
+    pthread_mutex_lock(&conn->lock);
+    while (conn->pending_count > 0)
+    {
+        pthread_cond_wait(&conn->cond, &conn->lock);
+    }
+    pthread_mutex_unlock(&conn->lock);
+
+    close(conn->fd);
+
+    pthread_mutex_destroy(&conn->write_lock);
+    pthread_mutex_destroy(&conn->lock);
+    pthread_cond_destroy(&conn->cond);
+    delete conn;
+
+    return 0;
+}
+
+static void* stats_main(void* args)
+{
+    ncnn::BatchServer* server = (ncnn::BatchServer*)args;
+
+    for (;;)
+    {
+        ncnn::sleep(5000);
+
+        ncnn::BatchServerStats stats = server->stats();
+        server->reset_stats();
+
+        if (stats.request_count == 0)
+            continue;
+
+        fprintf(stderr, "requests = %6d  batches = %6d  avg batch = %5.2f  throughput = %8.2f/s  p50 = %7.2f ms  p99 = %7.2f ms  max = %7.2f ms\n",
+                stats.request_count, stats.batch_count, (float)stats.request_count / stats.batch_count,
+                stats.throughput, stats.latency_p50, stats.latency_p99, stats.latency_max);
+    }
+
+    return 0;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 4)
+    {
+        fprintf(stderr, "Usage: %s model.param model.bin socket_path [max_batch_size] [max_delay_ms] [worker_count] [num_threads]\n", argv[0]);
+        return -1;
+    }
+
+    const char* parampath = argv[1];
+    const char* modelpath = argv[2];
+    const char* socket_path = argv[3];
+    int max_batch_size = argc > 4 ? atoi(argv[4]) : 8;
+    double max_delay = argc > 5 ? atof(argv[5]) : 2.0;
+    int worker_count = argc > 6 ? atoi(argv[6]) : 1;
+    int num_threads = argc > 7 ? atoi(argv[7]) : ncnn::get_physical_big_cpu_count();
+
+    // a client going away must not kill the server
+    signal(SIGPIPE, SIG_IGN);
+
+    ncnn::Net net;
+    net.opt.num_threads = num_threads;
+
+    if (net.load_param(parampath) != 0 || net.load_model(modelpath) != 0)
+    {
+        fprintf(stderr, "load %s %s failed\n", parampath, modelpath);
+        return -1;
+    }
+
+    ncnn::BatchServer server(&net);
+    server.set_max_batch_size(max_batch_size);
+    server.set_max_delay(max_delay);
+    server.set_worker_count(worker_count);
+    if (server.start() != 0)
+        return -1;
+
+    int listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listen_fd < 0)
+    {
+        fprintf(stderr, "socket failed %d\n", errno);
+        return -1;
+    }
+
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, socket_path, sizeof(addr.sun_path) - 1);
+
+    unlink(socket_path);
+    if (bind(listen_fd, (struct sockaddr*)&addr, sizeof(addr)) != 0 || listen(listen_fd, 64) != 0)
+    {
+        fprintf(stderr, "bind %s failed %d\n", socket_path, errno);
+        close(listen_fd);
+        return -1;
+    }
+
+    fprintf(stderr, "serving on %s  max_batch_size = %d  max_delay = %.2f ms  worker_count = %d  num_threads = %d\n",
+            socket_path, max_batch_size, max_delay, worker_count, num_threads);
+
+    pthread_t stats_thread;
+    pthread_create(&stats_thread, 0, stats_main, &server);
+    pthread_detach(stats_thread);
+
+    for (;;)
+    {
+        int fd = accept(listen_fd, 0, 0);
+        if (fd < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            fprintf(stderr, "accept failed %d\n", errno);
+            break;
+        }
+
+        Connection* conn = new Connection;
+        conn->fd = fd;
+        conn->server = &server;
+        conn->pending_count = 0;
+        pthread_mutex_init(&conn->write_lock, 0);
+        pthread_mutex_init(&conn->lock, 0);
+        pthread_cond_init(&conn->cond, 0);
+
+        pthread_t thread;
+        pthread_create(&thread, 0, connection_main, conn);
+        pthread_detach(thread);
+    }
+
+    close(listen_fd);
+    unlink(socket_path);
+
+    return 0;
+}
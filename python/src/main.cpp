@@ -24,6 +24,7 @@
 #include <option.h>
 #include <blob.h>
 #include <paramdict.h>
+#include <profiler.h>
 
 #include "pybind11_mat.h"
 #include "pybind11_datareader.h"
@@ -115,6 +116,42 @@ LayerFactoryDefine(7);
 LayerFactoryDefine(8);
 LayerFactoryDefine(9);
 
+// keeps the extractor and the python callback alive until the extraction is done
+struct ExtractAsyncCallback
+{
+    py::object ex;
+    py::function callback;
+};
+
+static void ExtractAsyncCallbackFunc(int ret, const ncnn::Mat& feat, void* userdata)
+{
+    py::gil_scoped_acquire gil;
+
+    ExtractAsyncCallback* cb = (ExtractAsyncCallback*)userdata;
+    try
+    {
+        cb->callback(ret, feat.clone());
+    }
+    catch (py::error_already_set& e)
+    {
+        // no caller to raise to on the worker thread
+        e.restore();
+        PyErr_WriteUnraisable(cb->callback.ptr());
+    }
+
+    delete cb;
+}
+
+template<typename T>
+static int extract_async(py::object ex, T blob, py::function callback, int type)
+{
+    ExtractAsyncCallback* cb = new ExtractAsyncCallback{ex, callback};
+    int ret = ex.cast<Extractor&>().extract_async(blob, ExtractAsyncCallbackFunc, cb, type);
+    if (ret != 0)
+        delete cb;
+    return ret;
+}
+
 PYBIND11_MODULE(ncnn, m)
 {
     auto atexit = py::module_::import("atexit");
@@ -139,6 +176,15 @@ PYBIND11_MODULE(ncnn, m)
     .def("clear", &UnlockedPoolAllocator::clear)
     .def("fastMalloc", &UnlockedPoolAllocator::fastMalloc, py::arg("size"))
     .def("fastFree", &UnlockedPoolAllocator::fastFree, py::arg("ptr"));
+    py::class_<SizeClassPoolAllocator, Allocator, PyAllocatorOther<SizeClassPoolAllocator> >(m, "SizeClassPoolAllocator")
+    .def(py::init<>())
+    .def("clear", &SizeClassPoolAllocator::clear)
+    .def("hit_count", &SizeClassPoolAllocator::hit_count)
+    .def("miss_count", &SizeClassPoolAllocator::miss_count)
+    .def("bytes_cached", &SizeClassPoolAllocator::bytes_cached)
+    .def("bytes_in_use", &SizeClassPoolAllocator::bytes_in_use)
+    .def("fastMalloc", &SizeClassPoolAllocator::fastMalloc, py::arg("size"))
+    .def("fastFree", &SizeClassPoolAllocator::fastFree, py::arg("ptr"));
 
     py::class_<DataReader, PyDataReader<> >(m, "DataReader")
     .def(py::init<>())
@@ -219,7 +265,11 @@ PYBIND11_MODULE(ncnn, m)
     .def_readwrite("use_subgroup_ballot", &Option::use_subgroup_ballot)
     .def_readwrite("use_subgroup_shuffle", &Option::use_subgroup_shuffle)
     .def_readwrite("use_image_storage", &Option::use_image_storage)
-    .def_readwrite("use_tensor_storage", &Option::use_tensor_storage);
+    .def_readwrite("use_tensor_storage", &Option::use_tensor_storage)
+    .def_readwrite("use_parallel_graph", &Option::use_parallel_graph)
+    .def_readwrite("use_memory_plan", &Option::use_memory_plan)
+    .def_readwrite("use_fp16_weight_storage", &Option::use_fp16_weight_storage)
+    .def_readwrite("numa_node", &Option::numa_node);
 
     py::class_<Mat> mat(m, "Mat", py::buffer_protocol());
     mat.def(py::init<>())
@@ -849,6 +899,30 @@ PYBIND11_MODULE(ncnn, m)
     .value("PIXEL_BGRA2GRAY", ncnn::Mat::PixelType::PIXEL_BGRA2GRAY)
     .value("PIXEL_BGRA2RGBA", ncnn::Mat::PixelType::PIXEL_BGRA2RGBA);
 
+    py::class_<ProfilerRecord>(m, "ProfilerRecord")
+    .def_readonly("layer_index", &ProfilerRecord::layer_index)
+#if NCNN_STRING
+    .def_readonly("type", &ProfilerRecord::type)
+    .def_readonly("name", &ProfilerRecord::name)
+#endif // NCNN_STRING
+    .def_property_readonly("kernel", [](const ProfilerRecord& r) {
+        return std::string(r.kernel);
+    })
+    .def_readonly("start", &ProfilerRecord::start)
+    .def_readonly("end", &ProfilerRecord::end)
+    .def_readonly("thread", &ProfilerRecord::thread)
+    .def_readonly("bottom_shapes", &ProfilerRecord::bottom_shapes)
+    .def_readonly("top_shapes", &ProfilerRecord::top_shapes)
+    .def_readonly("bytes_allocated", &ProfilerRecord::bytes_allocated);
+
+    py::class_<Profiler>(m, "Profiler")
+    .def(py::init<>())
+    .def("clear", &Profiler::clear)
+    .def("records", &Profiler::records)
+    .def("save_chrome_trace", &Profiler::save_chrome_trace, py::arg("path"))
+    .def("save_summary", &Profiler::save_summary, py::arg("path"))
+    .def("print_summary", &Profiler::print_summary);
+
     py::class_<Extractor>(m, "Extractor")
     .def("__enter__", [](Extractor& ex) -> Extractor& { return ex; })
     .def("__exit__", [](Extractor& ex, pybind11::args) {
@@ -859,6 +933,7 @@ PYBIND11_MODULE(ncnn, m)
     .def("set_num_threads", &Extractor::set_num_threads, py::arg("num_threads"))
     .def("set_blob_allocator", &Extractor::set_blob_allocator, py::arg("allocator"))
     .def("set_workspace_allocator", &Extractor::set_workspace_allocator, py::arg("allocator"))
+    .def("set_profiler", &Extractor::set_profiler, py::arg("profiler"))
 #if NCNN_STRING
     .def("input", (int (Extractor::*)(const char*, const Mat&)) & Extractor::input, py::arg("blob_name"), py::arg("in"))
     .def("extract", (int (Extractor::*)(const char*, Mat&, int)) & Extractor::extract, py::arg("blob_name"), py::arg("feat"), py::arg("type") = 0)
@@ -869,6 +944,19 @@ PYBIND11_MODULE(ncnn, m)
         return py::make_tuple(ret, feat.clone());
     },
     py::arg("blob_name"), py::arg("type") = 0)
+    .def("input_batch", (int (Extractor::*)(const char*, const std::vector<Mat>&)) & Extractor::input_batch, py::arg("blob_name"), py::arg("in"))
+    .def(
+    "extract_batch", [](Extractor& ex, const char* blob_name, int type) {
+        std::vector<ncnn::Mat> feats;
+        int ret = ex.extract_batch(blob_name, feats, type);
+        for (size_t i = 0; i < feats.size(); i++)
+        {
+            feats[i] = feats[i].clone();
+        }
+        return py::make_tuple(ret, feats);
+    },
+    py::arg("blob_name"), py::arg("type") = 0)
+    .def("extract_async", &extract_async<const char*>, py::arg("blob_name"), py::arg("callback"), py::arg("type") = 0)
 #endif
     .def("input", (int (Extractor::*)(int, const Mat&)) & Extractor::input)
     .def("extract", (int (Extractor::*)(int, Mat&, int)) & Extractor::extract, py::arg("blob_index"), py::arg("feat"), py::arg("type") = 0)
@@ -878,7 +966,20 @@ PYBIND11_MODULE(ncnn, m)
         int ret = ex.extract(blob_index, feat, type);
         return py::make_tuple(ret, feat.clone());
     },
-    py::arg("blob_index"), py::arg("type") = 0);
+    py::arg("blob_index"), py::arg("type") = 0)
+    .def("input_batch", (int (Extractor::*)(int, const std::vector<Mat>&)) & Extractor::input_batch, py::arg("blob_index"), py::arg("in"))
+    .def(
+    "extract_batch", [](Extractor& ex, int blob_index, int type) {
+        std::vector<ncnn::Mat> feats;
+        int ret = ex.extract_batch(blob_index, feats, type);
+        for (size_t i = 0; i < feats.size(); i++)
+        {
+            feats[i] = feats[i].clone();
+        }
+        return py::make_tuple(ret, feats);
+    },
+    py::arg("blob_index"), py::arg("type") = 0)
+    .def("extract_async", &extract_async<int>, py::arg("blob_index"), py::arg("callback"), py::arg("type") = 0);
 
     py::class_<Layer, PyLayer>(m, "Layer")
     .def(py::init<>())
@@ -970,6 +1071,7 @@ PYBIND11_MODULE(ncnn, m)
 #endif // NCNN_STRING
     .def("load_param_bin", (int (Net::*)(const char*)) & Net::load_param_bin, py::arg("protopath"))
     .def("load_model", (int (Net::*)(const char*)) & Net::load_model, py::arg("modelpath"))
+    .def("load_model_mmap", &Net::load_model_mmap, py::arg("modelpath"))
     .def(
     "load_model_mem", [](Net& net, const char* mem) {
         const unsigned char* _mem = (const unsigned char*)mem;
@@ -979,7 +1081,7 @@ PYBIND11_MODULE(ncnn, m)
     py::arg("mem"))
 #endif // NCNN_STDIO
 
-    .def("clear", &Net::clear)
+    .def("clear", &Net::clear, py::call_guard<py::gil_scoped_release>()) // pending extract_async callbacks need the gil
     .def("create_extractor", &Net::create_extractor, py::keep_alive<0, 1>()) //net should be kept alive until retuned ex is freed by gc
 
     .def("input_indexes", &Net::input_indexes, py::return_value_policy::reference)
@@ -1009,6 +1111,9 @@ PYBIND11_MODULE(ncnn, m)
     m.def("get_physical_big_cpu_count", &get_physical_big_cpu_count);
     m.def("get_cpu_powersave", &get_cpu_powersave);
     m.def("set_cpu_powersave", &set_cpu_powersave, py::arg("powersave"));
+    m.def("get_cpu_numa_node_count", &get_cpu_numa_node_count);
+    m.def("get_cpu_thread_numa_node", &get_cpu_thread_numa_node);
+    m.def("set_cpu_thread_numa_node", &set_cpu_thread_numa_node, py::arg("node"));
     m.def("get_omp_num_threads", &get_omp_num_threads);
     m.def("set_omp_num_threads", &set_omp_num_threads, py::arg("num_threads"));
     m.def("get_omp_dynamic", &get_omp_dynamic);
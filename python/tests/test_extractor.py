@@ -12,6 +12,8 @@
 # CONDITIONS OF ANY KIND, either express or implied. See the License for the
 # specific language governing permissions and limitations under the License.
 
+import threading
+
 import pytest
 
 import ncnn
@@ -84,3 +86,38 @@ def test_extractor_index():
 
     # not use with sentence, call clear manually to ensure ex destruct before net
     ex.clear()
+
+
+def test_extractor_async():
+    dr = ncnn.DataReaderFromEmpty()
+
+    net = ncnn.Net()
+    net.load_param("tests/test.param")
+    net.load_model(dr)
+
+    results = {}
+    done = threading.Event()
+
+    def make_callback(key):
+        def callback(ret, out_mat):
+            results[key] = (ret, out_mat)
+            if len(results) == 2:
+                done.set()
+
+        return callback
+
+    in_mat = ncnn.Mat((227, 227, 3))
+    ex0 = net.create_extractor()
+    ex0.input("data", in_mat)
+    ex1 = net.create_extractor()
+    ex1.input(0, in_mat)
+
+    assert ex0.extract_async("output", make_callback("name")) == 0
+    assert ex1.extract_async(2, make_callback("index")) == 0
+
+    assert done.wait(60)
+    for ret, out_mat in results.values():
+        assert ret == 0 and out_mat.dims == 1 and out_mat.w == 1
+
+    ex0.clear()
+    ex1.clear()
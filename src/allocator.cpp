@@ -17,6 +17,8 @@
 #include "gpu.h"
 #include "pipeline.h"
 
+#include <string.h>
+
 #if __ANDROID_API__ >= 26
 #include <android/hardware_buffer.h>
 #endif // __ANDROID_API__ >= 26
@@ -357,6 +359,866 @@ void UnlockedPoolAllocator::fastFree(void* ptr)
     ncnn::fastFree(ptr);
 }
 
+class MemoryPlanAllocatorPrivate
+{
+public:
+    struct Slot
+    {
+        size_t size;
+        size_t offset;
+        int alloc_event;
+        int free_event;
+    };
+
+    struct Event
+    {
+        int slot;
+        bool is_free;
+    };
+
+    struct Payout
+    {
+        void* ptr;
+        // -1 for allocations out of the current inference
+        int slot;
+        // the arena this allocation comes from, 0 for heap
+        unsigned char* arena;
+    };
+
+    void build_plan();
+
+    void diverge();
+
+    Mutex lock;
+
+    // recorded allocation trace
+    std::vector<Slot> slots;
+    std::vector<Event> events;
+
+    // 0 = idle, 1 = recording, 2 = replaying
+    int state;
+    bool plan_valid;
+    bool diverged;
+    int event_index;
+
+    unsigned char* arena;
+    size_t arena_size;
+    std::vector<unsigned char*> retired_arenas;
+
+    size_t heap_allocation_count;
+
+    std::vector<Payout> payouts;
+};
+
+static bool slot_size_greater(const std::pair<size_t, int>& a, const std::pair<size_t, int>& b)
+{
+    return a.first > b.first || (a.first == b.first && a.second < b.second);
+}
+
+static bool slot_offset_less(const std::pair<size_t, size_t>& a, const std::pair<size_t, size_t>& b)
+{
+    return a.first < b.first;
+}
+
+void MemoryPlanAllocatorPrivate::build_plan()
+{
+    // allocations still alive at the end of inference could not be planned
+    // place the larger ones first, each at the lowest offset not overlapping
+    // any placed allocation whose lifetime intersects, aka. interval graph coloring
+    std::vector<std::pair<size_t, int> > order;
+    for (size_t i = 0; i < slots.size(); i++)
+    {
+        slots[i].offset = (size_t)-1;
+        if (slots[i].free_event == -1)
+            continue;
+
+        order.push_back(std::make_pair(alignSize(slots[i].size, NCNN_MALLOC_ALIGN), (int)i));
+    }
+
+    std::partial_sort(order.begin(), order.end(), order.end(), slot_size_greater);
+
+    size_t total_size = 0;
+    std::vector<int> placed;
+    std::vector<std::pair<size_t, size_t> > conflicts;
+    for (size_t i = 0; i < order.size(); i++)
+    {
+        const size_t size = order[i].first;
+        Slot& slot = slots[order[i].second];
+
+        conflicts.clear();
+        for (size_t j = 0; j < placed.size(); j++)
+        {
+            const Slot& s = slots[placed[j]];
+            if (s.alloc_event < slot.free_event && slot.alloc_event < s.free_event)
+            {
+                conflicts.push_back(std::make_pair(s.offset, s.offset + alignSize(s.size, NCNN_MALLOC_ALIGN)));
+            }
+        }
+
+        std::partial_sort(conflicts.begin(), conflicts.end(), conflicts.end(), slot_offset_less);
+
+        // first fit gap
+        size_t offset = 0;
+        for (size_t j = 0; j < conflicts.size(); j++)
+        {
+            if (conflicts[j].first >= offset + size)
+                break;
+
+            offset = std::max(offset, conflicts[j].second);
+        }
+
+        slot.offset = offset;
+        placed.push_back(order[i].second);
+
+        total_size = std::max(total_size, offset + size);
+    }
+
+    if (arena)
+    {
+        bool arena_in_use = false;
+        for (size_t i = 0; i < payouts.size(); i++)
+        {
+            if (payouts[i].arena == arena)
+            {
+                arena_in_use = true;
+                break;
+            }
+        }
+
+        // keep the old arena until destruction if someone still holds it
+        if (arena_in_use)
+            retired_arenas.push_back(arena);
+        else
+            ncnn::fastFree(arena);
+
+        arena = 0;
+    }
+
+    arena_size = total_size;
+    if (arena_size > 0)
+    {
+        arena = (unsigned char*)ncnn::fastMalloc(arena_size);
+    }
+
+    plan_valid = arena_size == 0 || arena != 0;
+}
+
+void MemoryPlanAllocatorPrivate::diverge()
+{
+    // the trace differs from the recorded one
+    // serve the rest of this inference from heap and plan again next time
+    diverged = true;
+    plan_valid = false;
+}
+
+MemoryPlanAllocator::MemoryPlanAllocator()
+    : Allocator(), d(new MemoryPlanAllocatorPrivate)
+{
+    d->state = 0;
+    d->plan_valid = false;
+    d->diverged = false;
+    d->event_index = 0;
+    d->arena = 0;
+    d->arena_size = 0;
+    d->heap_allocation_count = 0;
+}
+
+MemoryPlanAllocator::~MemoryPlanAllocator()
+{
+    if (!d->payouts.empty())
+    {
+        NCNN_LOGE("FATAL ERROR! memory plan allocator destroyed too early");
+#if NCNN_STDIO
+        for (size_t i = 0; i < d->payouts.size(); i++)
+        {
+            NCNN_LOGE("%p still in use", d->payouts[i].ptr);
+        }
+#endif
+    }
+
+    if (d->arena)
+    {
+        ncnn::fastFree(d->arena);
+    }
+
+    for (size_t i = 0; i < d->retired_arenas.size(); i++)
+    {
+        ncnn::fastFree(d->retired_arenas[i]);
+    }
+
+    delete d;
+}
+
+MemoryPlanAllocator::MemoryPlanAllocator(const MemoryPlanAllocator&)
+    : d(0)
+{
+}
+
+MemoryPlanAllocator& MemoryPlanAllocator::operator=(const MemoryPlanAllocator&)
+{
+    return *this;
+}
+
+void MemoryPlanAllocator::begin()
+{
+    MutexLockGuard guard(d->lock);
+
+    // anything still alive belongs to the previous inference
+    for (size_t i = 0; i < d->payouts.size(); i++)
+    {
+        d->payouts[i].slot = -1;
+    }
+
+    d->diverged = false;
+    d->event_index = 0;
+    d->heap_allocation_count = 0;
+
+    if (d->plan_valid)
+    {
+        d->state = 2;
+    }
+    else
+    {
+        d->state = 1;
+        d->slots.clear();
+        d->events.clear();
+    }
+}
+
+void MemoryPlanAllocator::end()
+{
+    MutexLockGuard guard(d->lock);
+
+    if (d->state == 1)
+    {
+        d->build_plan();
+    }
+    else if (d->state == 2)
+    {
+        if (!d->diverged && d->event_index != (int)d->events.size())
+        {
+            d->diverge();
+        }
+    }
+
+    d->state = 0;
+}
+
+size_t MemoryPlanAllocator::arena_size() const
+{
+    MutexLockGuard guard(d->lock);
+
+    return d->arena_size;
+}
+
+size_t MemoryPlanAllocator::heap_allocation_count() const
+{
+    MutexLockGuard guard(d->lock);
+
+    return d->heap_allocation_count;
+}
+
+void* MemoryPlanAllocator::fastMalloc(size_t size)
+{
+    MutexLockGuard guard(d->lock);
+
+    MemoryPlanAllocatorPrivate::Payout payout;
+    payout.ptr = 0;
+    payout.slot = -1;
+    payout.arena = 0;
+
+    if (d->state == 1)
+    {
+        MemoryPlanAllocatorPrivate::Slot slot;
+        slot.size = size;
+        slot.offset = (size_t)-1;
+        slot.alloc_event = (int)d->events.size();
+        slot.free_event = -1;
+
+        MemoryPlanAllocatorPrivate::Event event;
+        event.slot = (int)d->slots.size();
+        event.is_free = false;
+
+        d->slots.push_back(slot);
+        d->events.push_back(event);
+
+        payout.slot = event.slot;
+    }
+    else if (d->state == 2 && !d->diverged)
+    {
+        const int i = d->event_index;
+        if (i < (int)d->events.size() && !d->events[i].is_free && d->slots[d->events[i].slot].size == size)
+        {
+            const MemoryPlanAllocatorPrivate::Slot& slot = d->slots[d->events[i].slot];
+            if (slot.offset != (size_t)-1)
+            {
+                payout.ptr = d->arena + slot.offset;
+                payout.arena = d->arena;
+            }
+
+            payout.slot = d->events[i].slot;
+            d->event_index++;
+        }
+        else
+        {
+            d->diverge();
+        }
+    }
+
+    if (!payout.ptr)
+    {
+        payout.ptr = ncnn::fastMalloc(size);
+        d->heap_allocation_count++;
+    }
+
+    d->payouts.push_back(payout);
+
+    return payout.ptr;
+}
+
+void MemoryPlanAllocator::fastFree(void* ptr)
+{
+    MutexLockGuard guard(d->lock);
+
+    // the most recent allocations are usually released first
+    int index = -1;
+    for (int i = (int)d->payouts.size() - 1; i >= 0; i--)
+    {
+        if (d->payouts[i].ptr == ptr)
+        {
+            index = i;
+            break;
+        }
+    }
+
+    if (index == -1)
+    {
+        NCNN_LOGE("FATAL ERROR! memory plan allocator get wild %p", ptr);
+        ncnn::fastFree(ptr);
+        return;
+    }
+
+    const MemoryPlanAllocatorPrivate::Payout payout = d->payouts[index];
+    d->payouts.erase(d->payouts.begin() + index);
+
+    if (payout.slot != -1)
+    {
+        if (d->state == 1)
+        {
+            MemoryPlanAllocatorPrivate::Event event;
+            event.slot = payout.slot;
+            event.is_free = true;
+
+            d->slots[payout.slot].free_event = (int)d->events.size();
+            d->events.push_back(event);
+        }
+        else if (d->state == 2 && !d->diverged)
+        {
+            const int i = d->event_index;
+            if (i < (int)d->events.size() && d->events[i].is_free && d->events[i].slot == payout.slot)
+            {
+                d->event_index++;
+            }
+            else
+            {
+                d->diverge();
+            }
+        }
+    }
+
+    if (!payout.arena)
+    {
+        ncnn::fastFree(ptr);
+    }
+}
+
+// shared free list primitives
+// pushing a chain and grabbing the whole list are both free of the ABA problem
+#if NCNN_THREADS && (defined __GNUC__ || defined __clang__) && !(defined __riscv && !defined __riscv_atomic)
+#define NCNN_SIZE_CLASS_LOCKFREE 1
+static NCNN_FORCEINLINE void* atomic_load_ptr(void* const* p)
+{
+    return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+
+static NCNN_FORCEINLINE bool atomic_cas_ptr(void** p, void** expected, void* desired)
+{
+    return __atomic_compare_exchange_n(p, expected, desired, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED);
+}
+
+static NCNN_FORCEINLINE void* atomic_exchange_ptr(void** p, void* value)
+{
+    return __atomic_exchange_n(p, value, __ATOMIC_ACQ_REL);
+}
+
+static NCNN_FORCEINLINE size_t atomic_load_size(const size_t* p)
+{
+    return __atomic_load_n(p, __ATOMIC_RELAXED);
+}
+
+static NCNN_FORCEINLINE void atomic_store_size(size_t* p, size_t value)
+{
+    __atomic_store_n(p, value, __ATOMIC_RELAXED);
+}
+
+static NCNN_FORCEINLINE void atomic_add_size(size_t* p, size_t delta)
+{
+    __atomic_fetch_add(p, delta, __ATOMIC_RELAXED);
+}
+#elif NCNN_THREADS && defined _MSC_VER
+#define NCNN_SIZE_CLASS_LOCKFREE 1
+static NCNN_FORCEINLINE void* atomic_load_ptr(void* const* p)
+{
+    return *(void* const volatile*)p;
+}
+
+static NCNN_FORCEINLINE bool atomic_cas_ptr(void** p, void** expected, void* desired)
+{
+    void* old = InterlockedCompareExchangePointer(p, desired, *expected);
+    if (old == *expected)
+        return true;
+
+    *expected = old;
+    return false;
+}
+
+static NCNN_FORCEINLINE void* atomic_exchange_ptr(void** p, void* value)
+{
+    return InterlockedExchangePointer(p, value);
+}
+
+static NCNN_FORCEINLINE size_t atomic_load_size(const size_t* p)
+{
+    return *(const volatile size_t*)p;
+}
+
+static NCNN_FORCEINLINE void atomic_store_size(size_t* p, size_t value)
+{
+    *(volatile size_t*)p = value;
+}
+
+static NCNN_FORCEINLINE void atomic_add_size(size_t* p, size_t delta)
+{
+#if _WIN64
+    InterlockedExchangeAdd64((LONG64 volatile*)p, (LONG64)delta);
+#else
+    InterlockedExchangeAdd((LONG volatile*)p, (LONG)delta);
+#endif
+}
+#else
+// no atomics, the shared free lists are guarded by a mutex
+#define NCNN_SIZE_CLASS_LOCKFREE 0
+static NCNN_FORCEINLINE void* atomic_load_ptr(void* const* p)
+{
+    return *p;
+}
+
+static NCNN_FORCEINLINE bool atomic_cas_ptr(void** p, void** expected, void* desired)
+{
+    if (*p != *expected)
+    {
+        *expected = *p;
+        return false;
+    }
+
+    *p = desired;
+    return true;
+}
+
+static NCNN_FORCEINLINE void* atomic_exchange_ptr(void** p, void* value)
+{
+    void* old = *p;
+    *p = value;
+    return old;
+}
+
+static NCNN_FORCEINLINE size_t atomic_load_size(const size_t* p)
+{
+    return *p;
+}
+
+static NCNN_FORCEINLINE void atomic_store_size(size_t* p, size_t value)
+{
+    *p = value;
+}
+
+static NCNN_FORCEINLINE void atomic_add_size(size_t* p, size_t delta)
+{
+    *p += delta;
+}
+#endif
+
+// 64 bytes, then four classes for each power of two up to 2G
+#define NCNN_SIZE_CLASS_COUNT 101
+
+// keep this many bytes per size class in each thread before sharing the rest
+#define NCNN_SIZE_CLASS_THREAD_CACHE_BYTES (4 * 1024 * 1024)
+
+static int size_class_index(size_t size, size_t* class_size)
+{
+    if (size <= 64)
+    {
+        *class_size = 64;
+        return 0;
+    }
+
+    // size lies in (2^e, 2^(e+1)]
+    int e = 0;
+    size_t v = size - 1;
+    while (v >>= 1)
+        e++;
+
+    if (e >= 31)
+        return -1;
+
+    const size_t base = (size_t)1 << e;
+    const size_t step = base >> 2;
+    const int k = (int)((size - 1 - base) / step) + 1;
+
+    *class_size = base + k * step;
+    return (e - 6) * 4 + k;
+}
+
+static int size_class_thread_cache_limit(size_t class_size)
+{
+    if (class_size * 2 >= NCNN_SIZE_CLASS_THREAD_CACHE_BYTES)
+        return 2;
+
+    int limit = (int)(NCNN_SIZE_CLASS_THREAD_CACHE_BYTES / class_size);
+    return limit > 256 ? 256 : limit;
+}
+
+// lives in front of each block, the user pointer follows the aligned header
+struct size_class_block
+{
+    size_class_block* next;
+    size_t size;
+    int size_class;
+};
+
+static const size_t size_class_header_size = (sizeof(size_class_block) + NCNN_MALLOC_ALIGN - 1) / NCNN_MALLOC_ALIGN * NCNN_MALLOC_ALIGN;
+
+struct size_class_thread_cache
+{
+    size_class_block* lists[NCNN_SIZE_CLASS_COUNT];
+    int counts[NCNN_SIZE_CLASS_COUNT];
+
+    // written by the owner thread only
+    size_t hit_count;
+    size_t miss_count;
+    size_t bytes_cached;
+    size_t bytes_in_use; // may wrap when blocks are freed in another thread, the sum is exact
+};
+
+class SizeClassPoolAllocatorPrivate
+{
+public:
+    size_class_thread_cache* get_thread_cache();
+
+    void push_shared(int size_class, size_class_block* head, size_class_block* tail, size_t bytes);
+
+    size_class_block* grab_shared(int size_class);
+
+    ThreadLocalStorage tls;
+
+    Mutex caches_lock;
+    std::vector<size_class_thread_cache*> caches;
+
+    void* shared_lists[NCNN_SIZE_CLASS_COUNT];
+    size_t shared_bytes_cached;
+#if !NCNN_SIZE_CLASS_LOCKFREE
+    Mutex shared_lock;
+#endif
+};
+
+static NCNN_FORCEINLINE void counter_add(size_t* p, size_t delta)
+{
+    // single writer, plain read-modify-write is enough
+    atomic_store_size(p, atomic_load_size(p) + delta);
+}
+
+size_class_thread_cache* SizeClassPoolAllocatorPrivate::get_thread_cache()
+{
+    size_class_thread_cache* tc = (size_class_thread_cache*)tls.get();
+    if (tc)
+        return tc;
+
+    tc = new size_class_thread_cache;
+    memset(tc, 0, sizeof(size_class_thread_cache));
+
+    {
+        MutexLockGuard lock(caches_lock);
+        caches.push_back(tc);
+    }
+
+    tls.set(tc);
+
+    return tc;
+}
+
+void SizeClassPoolAllocatorPrivate::push_shared(int size_class, size_class_block* head, size_class_block* tail, size_t bytes)
+{
+#if !NCNN_SIZE_CLASS_LOCKFREE
+    MutexLockGuard lock(shared_lock);
+#endif
+
+    void* expected = atomic_load_ptr(&shared_lists[size_class]);
+    do
+    {
+        tail->next = (size_class_block*)expected;
+    } while (!atomic_cas_ptr(&shared_lists[size_class], &expected, head));
+
+    atomic_add_size(&shared_bytes_cached, bytes);
+}
+
+size_class_block* SizeClassPoolAllocatorPrivate::grab_shared(int size_class)
+{
+    if (!atomic_load_ptr(&shared_lists[size_class]))
+        return 0;
+
+#if !NCNN_SIZE_CLASS_LOCKFREE
+    MutexLockGuard lock(shared_lock);
+#endif
+
+    return (size_class_block*)atomic_exchange_ptr(&shared_lists[size_class], 0);
+}
+
+SizeClassPoolAllocator::SizeClassPoolAllocator()
+    : Allocator(), d(new SizeClassPoolAllocatorPrivate)
+{
+    for (int i = 0; i < NCNN_SIZE_CLASS_COUNT; i++)
+    {
+        d->shared_lists[i] = 0;
+    }
+
+    d->shared_bytes_cached = 0;
+}
+
+SizeClassPoolAllocator::~SizeClassPoolAllocator()
+{
+    clear();
+
+    if (bytes_in_use() != 0)
+    {
+        NCNN_LOGE("FATAL ERROR! size class pool allocator destroyed too early");
+#if NCNN_STDIO
+        NCNN_LOGE("%lu bytes still in use", (unsigned long)bytes_in_use());
+#endif
+    }
+
+    for (size_t i = 0; i < d->caches.size(); i++)
+    {
+        delete d->caches[i];
+    }
+
+    delete d;
+}
+
+SizeClassPoolAllocator::SizeClassPoolAllocator(const SizeClassPoolAllocator&)
+    : d(0)
+{
+}
+
+SizeClassPoolAllocator& SizeClassPoolAllocator::operator=(const SizeClassPoolAllocator&)
+{
+    return *this;
+}
+
+void SizeClassPoolAllocator::clear()
+{
+    MutexLockGuard lock(d->caches_lock);
+
+    for (size_t i = 0; i < d->caches.size(); i++)
+    {
+        size_class_thread_cache* tc = d->caches[i];
+        for (int j = 0; j < NCNN_SIZE_CLASS_COUNT; j++)
+        {
+            size_class_block* block = tc->lists[j];
+            while (block)
+            {
+                size_class_block* next = block->next;
+                ncnn::fastFree(block);
+                block = next;
+            }
+
+            tc->lists[j] = 0;
+            tc->counts[j] = 0;
+        }
+
+        atomic_store_size(&tc->bytes_cached, 0);
+    }
+
+    for (int j = 0; j < NCNN_SIZE_CLASS_COUNT; j++)
+    {
+        size_class_block* block = d->grab_shared(j);
+        while (block)
+        {
+            size_class_block* next = block->next;
+            ncnn::fastFree(block);
+            block = next;
+        }
+    }
+
+    atomic_store_size(&d->shared_bytes_cached, 0);
+}
+
+size_t SizeClassPoolAllocator::hit_count() const
+{
+    MutexLockGuard lock(d->caches_lock);
+
+    size_t count = 0;
+    for (size_t i = 0; i < d->caches.size(); i++)
+    {
+        count += atomic_load_size(&d->caches[i]->hit_count);
+    }
+
+    return count;
+}
+
+size_t SizeClassPoolAllocator::miss_count() const
+{
+    MutexLockGuard lock(d->caches_lock);
+
+    size_t count = 0;
+    for (size_t i = 0; i < d->caches.size(); i++)
+    {
+        count += atomic_load_size(&d->caches[i]->miss_count);
+    }
+
+    return count;
+}
+
+size_t SizeClassPoolAllocator::bytes_cached() const
+{
+    MutexLockGuard lock(d->caches_lock);
+
+    size_t bytes = atomic_load_size(&d->shared_bytes_cached);
+    for (size_t i = 0; i < d->caches.size(); i++)
+    {
+        bytes += atomic_load_size(&d->caches[i]->bytes_cached);
+    }
+
+    return bytes;
+}
+
+size_t SizeClassPoolAllocator::bytes_in_use() const
+{
+    MutexLockGuard lock(d->caches_lock);
+
+    size_t bytes = 0;
+    for (size_t i = 0; i < d->caches.size(); i++)
+    {
+        bytes += atomic_load_size(&d->caches[i]->bytes_in_use);
+    }
+
+    return bytes;
+}
+
+void* SizeClassPoolAllocator::fastMalloc(size_t size)
+{
+    size_class_thread_cache* tc = d->get_thread_cache();
+
+    size_t class_size = size;
+    const int size_class = size_class_index(size, &class_size);
+
+    size_class_block* block = 0;
+    if (size_class != -1)
+    {
+        block = tc->lists[size_class];
+        if (!block)
+        {
+            // refill from the blocks other threads gave up
+            block = d->grab_shared(size_class);
+
+            int count = 0;
+            for (size_class_block* b = block; b; b = b->next)
+                count++;
+
+            if (count)
+            {
+                atomic_add_size(&d->shared_bytes_cached, (size_t)0 - count * class_size);
+                counter_add(&tc->bytes_cached, count * class_size);
+                tc->counts[size_class] += count;
+            }
+        }
+
+        if (block)
+        {
+            tc->lists[size_class] = block->next;
+            tc->counts[size_class] -= 1;
+            counter_add(&tc->bytes_cached, (size_t)0 - class_size);
+            counter_add(&tc->hit_count, 1);
+        }
+    }
+
+    if (!block)
+    {
+        block = (size_class_block*)ncnn::fastMalloc(size_class_header_size + class_size);
+        if (!block)
+            return 0;
+
+        block->size = class_size;
+        block->size_class = size_class;
+        counter_add(&tc->miss_count, 1);
+    }
+
+    block->next = 0;
+    counter_add(&tc->bytes_in_use, class_size);
+
+    return (unsigned char*)block + size_class_header_size;
+}
+
+void SizeClassPoolAllocator::fastFree(void* ptr)
+{
+    if (!ptr)
+        return;
+
+    size_class_thread_cache* tc = d->get_thread_cache();
+
+    size_class_block* block = (size_class_block*)((unsigned char*)ptr - size_class_header_size);
+    const int size_class = block->size_class;
+    const size_t class_size = block->size;
+
+    counter_add(&tc->bytes_in_use, (size_t)0 - class_size);
+
+    if (size_class == -1)
+    {
+        ncnn::fastFree(block);
+        return;
+    }
+
+    block->next = tc->lists[size_class];
+    tc->lists[size_class] = block;
+    tc->counts[size_class] += 1;
+    counter_add(&tc->bytes_cached, class_size);
+
+    const int limit = size_class_thread_cache_limit(class_size);
+    if (tc->counts[size_class] > limit)
+    {
+        // hand the older half over to the shared list
+        const int keep = limit / 2;
+
+        size_class_block* last_kept = tc->lists[size_class];
+        for (int i = 1; i < keep; i++)
+            last_kept = last_kept->next;
+
+        size_class_block* head = last_kept->next;
+        size_class_block* tail = head;
+        int count = 1;
+        while (tail->next)
+        {
+            tail = tail->next;
+            count++;
+        }
+
+        last_kept->next = 0;
+        tc->counts[size_class] = keep;
+        counter_add(&tc->bytes_cached, (size_t)0 - count * class_size);
+
+        d->push_shared(size_class, head, tail, count * class_size);
+    }
+}
+
 #if NCNN_VULKAN
 VkAllocator::VkAllocator(const VulkanDevice* _vkdev)
     : vkdev(_vkdev)
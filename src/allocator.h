@@ -216,6 +216,79 @@ private:
     UnlockedPoolAllocatorPrivate* const d;
 };
 
+class MemoryPlanAllocatorPrivate;
+class NCNN_EXPORT MemoryPlanAllocator : public Allocator
+{
+public:
+    MemoryPlanAllocator();
+    ~MemoryPlanAllocator();
+
+    // mark the start of one inference
+    void begin();
+
+    // mark the end of one inference
+    // the allocation trace of the first inference is planned into one arena
+    // lifetime-overlapping allocations never share bytes, others reuse them
+    // later inferences with the identical trace are served from the arena
+    // any mismatch falls back to heap and triggers planning again
+    void end();
+
+    // bytes of the arena, the exact peak footprint of one planned inference
+    size_t arena_size() const;
+
+    // allocations not served from the arena since the last begin()
+    size_t heap_allocation_count() const;
+
+    virtual void* fastMalloc(size_t size);
+    virtual void fastFree(void* ptr);
+
+private:
+    MemoryPlanAllocator(const MemoryPlanAllocator&);
+    MemoryPlanAllocator& operator=(const MemoryPlanAllocator&);
+
+private:
+    MemoryPlanAllocatorPrivate* const d;
+};
+
+// size class bucketed pool allocator
+// requests are rounded up to one of the size classes, four per power of two
+// each thread keeps private free lists, the overflow goes to shared lock-free
+// free lists, so many extractors could share one allocator without contention
+class SizeClassPoolAllocatorPrivate;
+class NCNN_EXPORT SizeClassPoolAllocator : public Allocator
+{
+public:
+    SizeClassPoolAllocator();
+    ~SizeClassPoolAllocator();
+
+    // release all cached blocks
+    // must not be called while other threads are using the allocator
+    void clear();
+
+    // the counters are approximate while other threads are allocating
+    // allocations served from cached blocks
+    size_t hit_count() const;
+
+    // allocations served from system heap
+    size_t miss_count() const;
+
+    // bytes of the blocks cached for reuse
+    size_t bytes_cached() const;
+
+    // bytes of the blocks handed out and not freed yet
+    size_t bytes_in_use() const;
+
+    virtual void* fastMalloc(size_t size);
+    virtual void fastFree(void* ptr);
+
+private:
+    SizeClassPoolAllocator(const SizeClassPoolAllocator&);
+    SizeClassPoolAllocator& operator=(const SizeClassPoolAllocator&);
+
+private:
+    SizeClassPoolAllocatorPrivate* const d;
+};
+
 #if NCNN_VULKAN
 
 class VulkanDevice;
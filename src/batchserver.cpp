@@ -0,0 +1,524 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "batchserver.h"
+
+#if NCNN_THREADS
+
+#include "allocator.h"
+#include "benchmark.h"
+
+namespace ncnn {
+
+// the latest latencies kept for percentiles
+static const int BATCHSERVER_LATENCY_WINDOW = 65536;
+
+BatchServerStats::BatchServerStats()
+{
+    request_count = 0;
+    batch_count = 0;
+    throughput = 0;
+    latency_p50 = 0;
+    latency_p99 = 0;
+    latency_max = 0;
+}
+
+struct BatchServerRequest
+{
+    Mat in;
+    extract_callback_func callback;
+    void* userdata;
+    double submit_time;
+};
+
+class BatchServerPrivate;
+class BatchServerWorker
+{
+public:
+    BatchServerPrivate* server;
+    Thread* thread;
+
+    // reused by every batch of this worker
+    PoolAllocator blob_allocator;
+    PoolAllocator workspace_allocator;
+};
+
+class BatchServerPrivate
+{
+public:
+    BatchServerPrivate(const Net* _net);
+
+    // wait for the next batch, empty if quit and nothing left
+    void take_batch(std::vector<BatchServerRequest>& batch);
+
+    void run_batch(BatchServerWorker* worker, std::vector<BatchServerRequest>& batch);
+
+    static void* worker_main(void* args);
+
+    const Net* net;
+
+    int max_batch_size;
+    double max_delay;
+    int worker_count;
+    int input_index;
+    int output_index;
+
+    bool started;
+    std::vector<BatchServerWorker*> workers;
+
+    Mutex lock;
+    ConditionVariable cond;
+    std::vector<BatchServerRequest> queue;
+    bool quit;
+
+    mutable Mutex stats_lock;
+    double stats_start;
+    int request_count;
+    int batch_count;
+    std::vector<float> latencies;
+};
+
+BatchServerPrivate::BatchServerPrivate(const Net* _net)
+    : net(_net)
+{
+    max_batch_size = 8;
+    max_delay = 2.0;
+    worker_count = 1;
+    input_index = net->input_indexes().empty() ? -1 : net->input_indexes()[0];
+    output_index = net->output_indexes().empty() ? -1 : net->output_indexes()[0];
+
+    started = false;
+    quit = false;
+
+    stats_start = get_current_time();
+    request_count = 0;
+    batch_count = 0;
+}
+
+static void qsort_ascent_inplace(std::vector<float>& datas, int left, int right)
+{
+    int i = left;
+    int j = right;
+    float p = datas[(left + right) / 2];
+
+    while (i <= j)
+    {
+        while (datas[i] < p)
+            i++;
+
+        while (datas[j] > p)
+            j--;
+
+        if (i <= j)
+        {
+            // swap
+            std::swap(datas[i], datas[j]);
+
+            i++;
+            j--;
+        }
+    }
+
+    if (left < j)
+        qsort_ascent_inplace(datas, left, j);
+
+    if (i < right)
+        qsort_ascent_inplace(datas, i, right);
+}
+
+static bool same_shape(const Mat& a, const Mat& b)
+{
+    return a.dims == b.dims && a.w == b.w && a.h == b.h && a.d == b.d && a.c == b.c && a.elemsize == b.elemsize && a.elempack == b.elempack;
+}
+
+void BatchServerPrivate::take_batch(std::vector<BatchServerRequest>& batch)
+{
+    batch.clear();
+
+    lock.lock();
+    for (;;)
+    {
+        while (queue.empty() && !quit)
+        {
+            cond.wait(lock);
+        }
+
+        if (queue.empty())
+            break;
+
+        // let the batch fill until the oldest request is due, no more waiting on quit
+        // every submit wakes one worker to check the batch size again
+        if ((int)queue.size() < max_batch_size && !quit)
+        {
+            const double wait_ms = queue[0].submit_time + max_delay - get_current_time();
+            if (wait_ms > 0)
+            {
+                cond.timedwait(lock, (int)(wait_ms * 1000) + 1);
+                continue;
+            }
+        }
+
+        // the oldest request and the following ones of the same shape
+        std::vector<BatchServerRequest> remaining;
+        for (size_t i = 0; i < queue.size(); i++)
+        {
+            if ((int)batch.size() < max_batch_size && (batch.empty() || same_shape(queue[i].in, batch[0].in)))
+            {
+                batch.push_back(queue[i]);
+            }
+            else
+            {
+                remaining.push_back(queue[i]);
+            }
+        }
+        queue = remaining;
+
+        break;
+    }
+    lock.unlock();
+}
+
+void BatchServerPrivate::run_batch(BatchServerWorker* worker, std::vector<BatchServerRequest>& batch)
+{
+    const int batch_size = (int)batch.size();
+
+    std::vector<Mat> outs(batch_size);
+    int ret = 0;
+    {
+        Extractor ex = net->create_extractor();
+        ex.set_blob_allocator(&worker->blob_allocator);
+        ex.set_workspace_allocator(&worker->workspace_allocator);
+
+        if (batch_size == 1)
+        {
+            ret = ex.input(input_index, batch[0].in);
+            if (ret == 0)
+                ret = ex.extract(output_index, outs[0]);
+        }
+        else
+        {
+            std::vector<Mat> ins(batch_size);
+            for (int i = 0; i < batch_size; i++)
+            {
+                ins[i] = batch[i].in;
+            }
+
+            ret = ex.input_batch(input_index, ins);
+            if (ret == 0)
+                ret = ex.extract_batch(output_index, outs);
+        }
+
+        outs.resize(batch_size);
+
+        // the worker allocators are reused by the next batch
+        for (int i = 0; i < batch_size; i++)
+        {
+            if (outs[i].empty())
+                continue;
+
+            outs[i] = outs[i].clone();
+            if (outs[i].empty())
+                ret = -100;
+        }
+    }
+
+    const double end = get_current_time();
+
+    stats_lock.lock();
+    for (int i = 0; i < batch_size; i++)
+    {
+        const float latency = (float)(end - batch[i].submit_time);
+        if ((int)latencies.size() < BATCHSERVER_LATENCY_WINDOW)
+            latencies.push_back(latency);
+        else
+            latencies[request_count % BATCHSERVER_LATENCY_WINDOW] = latency;
+        request_count++;
+    }
+    batch_count++;
+    stats_lock.unlock();
+
+    for (int i = 0; i < batch_size; i++)
+    {
+        batch[i].callback(ret, outs[i], batch[i].userdata);
+    }
+}
+
+void* BatchServerPrivate::worker_main(void* args)
+{
+    BatchServerWorker* worker = (BatchServerWorker*)args;
+    BatchServerPrivate* server = worker->server;
+
+    std::vector<BatchServerRequest> batch;
+    for (;;)
+    {
+        server->take_batch(batch);
+        if (batch.empty())
+            break;
+
+        server->run_batch(worker, batch);
+    }
+
+    return 0;
+}
+
+BatchServer::BatchServer(const Net* net)
+    : d(new BatchServerPrivate(net))
+{
+}
+
+BatchServer::~BatchServer()
+{
+    d->lock.lock();
+    d->quit = true;
+    d->cond.broadcast();
+    d->lock.unlock();
+
+    for (size_t i = 0; i < d->workers.size(); i++)
+    {
+        d->workers[i]->thread->join();
+        delete d->workers[i]->thread;
+        delete d->workers[i];
+    }
+
+    delete d;
+}
+
+BatchServer::BatchServer(const BatchServer&)
+    : d(0)
+{
+}
+
+BatchServer& BatchServer::operator=(const BatchServer&)
+{
+    return *this;
+}
+
+void BatchServer::set_max_batch_size(int max_batch_size)
+{
+    if (d->started)
+    {
+        NCNN_LOGE("BatchServer set_max_batch_size after start is ignored");
+        return;
+    }
+
+    d->max_batch_size = std::max(max_batch_size, 1);
+}
+
+void BatchServer::set_max_delay(double max_delay)
+{
+    if (d->started)
+    {
+        NCNN_LOGE("BatchServer set_max_delay after start is ignored");
+        return;
+    }
+
+    d->max_delay = std::max(max_delay, 0.0);
+}
+
+void BatchServer::set_worker_count(int worker_count)
+{
+    if (d->started)
+    {
+        NCNN_LOGE("BatchServer set_worker_count after start is ignored");
+        return;
+    }
+
+    d->worker_count = std::max(worker_count, 1);
+}
+
+#if NCNN_STRING
+int BatchServer::set_input_output(const char* input_name, const char* output_name)
+{
+    int input_index = -1;
+    int output_index = -1;
+
+    const std::vector<Blob>& blobs = d->net->blobs();
+    for (size_t i = 0; i < blobs.size(); i++)
+    {
+        if (blobs[i].name == input_name)
+            input_index = (int)i;
+        if (blobs[i].name == output_name)
+            output_index = (int)i;
+    }
+
+    if (input_index == -1 || output_index == -1)
+    {
+        NCNN_LOGE("BatchServer blob %s not found", input_index == -1 ? input_name : output_name);
+        return -1;
+    }
+
+    return set_input_output(input_index, output_index);
+}
+#endif // NCNN_STRING
+
+int BatchServer::set_input_output(int input_index, int output_index)
+{
+    if (d->started)
+    {
+        NCNN_LOGE("BatchServer set_input_output after start is ignored");
+        return -1;
+    }
+
+    const int blob_count = (int)d->net->blobs().size();
+    if (input_index < 0 || input_index >= blob_count || output_index < 0 || output_index >= blob_count)
+    {
+        NCNN_LOGE("BatchServer blob index %d %d out of range", input_index, output_index);
+        return -1;
+    }
+
+    d->input_index = input_index;
+    d->output_index = output_index;
+
+    return 0;
+}
+
+int BatchServer::start()
+{
+    if (d->started)
+        return 0;
+
+    if (d->input_index == -1 || d->output_index == -1)
+    {
+        NCNN_LOGE("BatchServer net has no input or output");
+        return -1;
+    }
+
+    d->started = true;
+
+    reset_stats();
+
+    d->workers.resize(d->worker_count);
+    for (int i = 0; i < d->worker_count; i++)
+    {
+        BatchServerWorker* worker = new BatchServerWorker;
+        worker->server = d;
+        worker->thread = new Thread(BatchServerPrivate::worker_main, (void*)worker);
+        d->workers[i] = worker;
+    }
+
+    return 0;
+}
+
+int BatchServer::submit(const Mat& in, extract_callback_func callback, void* userdata)
+{
+    if (!d->started)
+    {
+        NCNN_LOGE("BatchServer submit before start");
+        return -1;
+    }
+
+    if (in.empty() || !callback)
+        return -1;
+
+    BatchServerRequest request;
+    // external data may be gone before the batch runs
+    request.in = in.refcount ? in : in.clone();
+    request.callback = callback;
+    request.userdata = userdata;
+    request.submit_time = get_current_time();
+
+    if (request.in.empty())
+        return -100;
+
+    d->lock.lock();
+    d->queue.push_back(request);
+    d->cond.signal();
+    d->lock.unlock();
+
+    return 0;
+}
+
+struct BatchServerWaiter
+{
+    Mutex lock;
+    ConditionVariable cond;
+    bool done;
+    int ret;
+    Mat out;
+};
+
+static void batchserver_waiter_callback(int ret, const Mat& feat, void* userdata)
+{
+    BatchServerWaiter* waiter = (BatchServerWaiter*)userdata;
+
+    waiter->lock.lock();
+    waiter->ret = ret;
+    waiter->out = feat;
+    waiter->done = true;
+    waiter->cond.signal();
+    waiter->lock.unlock();
+}
+
+int BatchServer::run(const Mat& in, Mat& out)
+{
+    BatchServerWaiter waiter;
+    waiter.done = false;
+    waiter.ret = 0;
+
+    int ret = submit(in, batchserver_waiter_callback, &waiter);
+    if (ret != 0)
+        return ret;
+
+    waiter.lock.lock();
+    while (!waiter.done)
+    {
+        waiter.cond.wait(waiter.lock);
+    }
+    waiter.lock.unlock();
+
+    out = waiter.out;
+
+    return waiter.ret;
+}
+
+BatchServerStats BatchServer::stats() const
+{
+    BatchServerStats s;
+
+    d->stats_lock.lock();
+    std::vector<float> latencies = d->latencies;
+    s.request_count = d->request_count;
+    s.batch_count = d->batch_count;
+    const double elapsed = get_current_time() - d->stats_start;
+    d->stats_lock.unlock();
+
+    if (elapsed > 0)
+        s.throughput = s.request_count * 1000.0 / elapsed;
+
+    if (!latencies.empty())
+    {
+        qsort_ascent_inplace(latencies, 0, (int)latencies.size() - 1);
+
+        const int n = (int)latencies.size();
+        s.latency_p50 = latencies[(n - 1) / 2];
+        s.latency_p99 = latencies[(int)((n - 1) * 0.99)];
+        s.latency_max = latencies[n - 1];
+    }
+
+    return s;
+}
+
+void BatchServer::reset_stats()
+{
+    d->stats_lock.lock();
+    d->stats_start = get_current_time();
+    d->request_count = 0;
+    d->batch_count = 0;
+    d->latencies.clear();
+    d->stats_lock.unlock();
+}
+
+} // namespace ncnn
+
+#endif // NCNN_THREADS
@@ -0,0 +1,107 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef NCNN_BATCHSERVER_H
+#define NCNN_BATCHSERVER_H
+
+#include "platform.h"
+
+#if NCNN_THREADS
+
+#include "mat.h"
+#include "net.h"
+
+namespace ncnn {
+
+// served requests since start or the last reset_stats
+class NCNN_EXPORT BatchServerStats
+{
+public:
+    BatchServerStats();
+
+    int request_count;
+    int batch_count;
+
+    // requests per second
+    double throughput;
+
+    // milliseconds from submit to callback, over the latest 65536 requests
+    double latency_p50;
+    double latency_p99;
+    double latency_max;
+};
+
+// serve one input and one output of a shared net under load
+// queued samples of the same shape are grouped into micro-batches and run with extract_batch
+// a batch runs once it is full or its oldest request has waited max_delay
+// every worker runs one batch at a time with its own pooled allocators
+class BatchServerPrivate;
+class NCNN_EXPORT BatchServer
+{
+public:
+    // net must be loaded and outlive the server
+    BatchServer(const Net* net);
+
+    // finish all queued requests, then stop the workers
+    ~BatchServer();
+
+    // max samples in one batch, default 8
+    void set_max_batch_size(int max_batch_size);
+
+    // milliseconds the oldest queued request may wait for the batch to fill, default 2
+    void set_max_delay(double max_delay);
+
+    // batches running at the same time, default 1
+    // each runs with net.opt.num_threads
+    void set_worker_count(int worker_count);
+
+#if NCNN_STRING
+    // served blobs by name
+    // return 0 if success
+    int set_input_output(const char* input_name, const char* output_name);
+#endif // NCNN_STRING
+
+    // served blobs by index, default the first input and the first output of net
+    // return 0 if success
+    int set_input_output(int input_index, int output_index);
+
+    // start the workers, settings above are fixed from now on
+    // return 0 if success
+    int start();
+
+    // queue one sample, callback is called on a worker thread with its output
+    // the output does not reference any server allocator
+    // return 0 if queued
+    int submit(const Mat& in, extract_callback_func callback, void* userdata = 0);
+
+    // queue one sample and wait for its output
+    // return 0 if success
+    int run(const Mat& in, Mat& out);
+
+    BatchServerStats stats() const;
+    void reset_stats();
+
+private:
+    BatchServer(const BatchServer&);
+    BatchServer& operator=(const BatchServer&);
+
+private:
+    BatchServerPrivate* const d;
+};
+
+} // namespace ncnn
+
+#endif // NCNN_THREADS
+
+#endif // NCNN_BATCHSERVER_H
@@ -1441,6 +1441,45 @@ int ncnn_extractor_extract_index(ncnn_extractor_t ex, int index, ncnn_mat_t* mat
     return ret;
 }
 
+struct ExtractorCallback_c_api
+{
+    ncnn_extractor_callback_t callback;
+    void* userdata;
+};
+
+static void __ncnn_Extractor_callback(int ret, const Mat& feat, void* userdata)
+{
+    ExtractorCallback_c_api* cb = (ExtractorCallback_c_api*)userdata;
+    cb->callback(ret, (ncnn_mat_t)(new Mat(feat)), cb->userdata);
+    delete cb;
+}
+
+#if NCNN_STRING
+int ncnn_extractor_extract_async(ncnn_extractor_t ex, const char* name, ncnn_extractor_callback_t callback, void* userdata)
+{
+    ExtractorCallback_c_api* cb = new ExtractorCallback_c_api;
+    cb->callback = callback;
+    cb->userdata = userdata;
+
+    int ret = ((Extractor*)ex)->extract_async(name, __ncnn_Extractor_callback, cb);
+    if (ret != 0)
+        delete cb;
+    return ret;
+}
+#endif /* NCNN_STRING */
+
+int ncnn_extractor_extract_index_async(ncnn_extractor_t ex, int index, ncnn_extractor_callback_t callback, void* userdata)
+{
+    ExtractorCallback_c_api* cb = new ExtractorCallback_c_api;
+    cb->callback = callback;
+    cb->userdata = userdata;
+
+    int ret = ((Extractor*)ex)->extract_async(index, __ncnn_Extractor_callback, cb);
+    if (ret != 0)
+        delete cb;
+    return ret;
+}
+
 void ncnn_copy_make_border(const ncnn_mat_t src, ncnn_mat_t dst, int top, int bottom, int left, int right, int type, float v, const ncnn_option_t opt)
 {
     const Option _opt = opt ? *((const Option*)opt) : Option();
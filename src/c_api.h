@@ -332,6 +332,15 @@ NCNN_EXPORT int ncnn_extractor_extract(ncnn_extractor_t ex, const char* name, nc
 NCNN_EXPORT int ncnn_extractor_input_index(ncnn_extractor_t ex, int index, const ncnn_mat_t mat);
 NCNN_EXPORT int ncnn_extractor_extract_index(ncnn_extractor_t ex, int index, ncnn_mat_t* mat);
 
+/* called on an ncnn worker thread when the extraction is done, destroy mat with ncnn_mat_destroy */
+typedef void (*ncnn_extractor_callback_t)(int ret, ncnn_mat_t mat, void* userdata);
+
+/* return immediately, ex must stay untouched until callback */
+#if NCNN_STRING
+NCNN_EXPORT int ncnn_extractor_extract_async(ncnn_extractor_t ex, const char* name, ncnn_extractor_callback_t callback, void* userdata);
+#endif /* NCNN_STRING */
+NCNN_EXPORT int ncnn_extractor_extract_index_async(ncnn_extractor_t ex, int index, ncnn_extractor_callback_t callback, void* userdata);
+
 /* mat process api */
 #define NCNN_BORDER_CONSTANT    0
 #define NCNN_BORDER_REPLICATE   1
@@ -22,6 +22,7 @@
 #include <signal.h>
 #endif // __wasi__
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 #ifdef _OPENMP
@@ -140,6 +141,7 @@ static int g_powersave;
 static ncnn::CpuSet g_cpu_affinity_mask_all;
 static ncnn::CpuSet g_cpu_affinity_mask_little;
 static ncnn::CpuSet g_cpu_affinity_mask_big;
+static std::vector<ncnn::CpuSet> g_cpu_affinity_mask_numa_nodes;
 
 // isa info
 #if defined _WIN32
@@ -1545,6 +1547,90 @@ static void initialize_cpu_thread_affinity_mask(ncnn::CpuSet& mask_all, ncnn::Cp
 #endif
 }
 
+#if defined __ANDROID__ || defined __linux__
+static int read_sysfs_id_list(const char* path, std::vector<int>& ids)
+{
+    ids.clear();
+
+    FILE* fp = fopen(path, "rb");
+    if (!fp)
+        return -1;
+
+    // the list format looks like 0-3,8,10-11
+    char line[4096];
+    char* s = fgets(line, 4096, fp);
+    fclose(fp);
+
+    if (!s)
+        return -1;
+
+    const char* p = line;
+    while (*p)
+    {
+        if (!isdigit(*p))
+        {
+            p++;
+            continue;
+        }
+
+        char* end = 0;
+        int id0 = (int)strtol(p, &end, 10);
+        int id1 = id0;
+        p = end;
+        if (*p == '-')
+        {
+            id1 = (int)strtol(p + 1, &end, 10);
+            p = end;
+        }
+
+        for (int id = id0; id <= id1; id++)
+        {
+            ids.push_back(id);
+        }
+    }
+
+    return 0;
+}
+#endif // defined __ANDROID__ || defined __linux__
+
+static void initialize_cpu_numa_node_affinity_mask(std::vector<ncnn::CpuSet>& node_masks)
+{
+    node_masks.clear();
+
+#if defined __ANDROID__ || defined __linux__
+    std::vector<int> node_ids;
+    read_sysfs_id_list("/sys/devices/system/node/online", node_ids);
+
+    for (size_t i = 0; i < node_ids.size(); i++)
+    {
+        char path[256];
+        sprintf(path, "/sys/devices/system/node/node%d/cpulist", node_ids[i]);
+
+        std::vector<int> cpu_ids;
+        read_sysfs_id_list(path, cpu_ids);
+
+        ncnn::CpuSet node_mask;
+        for (size_t j = 0; j < cpu_ids.size(); j++)
+        {
+            if (cpu_ids[j] < g_cpucount)
+                node_mask.enable(cpu_ids[j]);
+        }
+
+        // skip memory-only nodes
+        if (node_mask.num_enabled() == 0)
+            continue;
+
+        node_masks.push_back(node_mask);
+    }
+#endif // defined __ANDROID__ || defined __linux__
+
+    if (node_masks.empty())
+    {
+        // no numa info, treat all cpus as one node
+        node_masks.push_back(g_cpu_affinity_mask_all);
+    }
+}
+
 #if defined __ANDROID__ || defined __linux__
 #if __aarch64__
 union midr_info_t
@@ -1867,6 +1953,7 @@ static void initialize_global_cpu_info()
     g_physical_cpucount = get_physical_cpucount();
     g_powersave = 0;
     initialize_cpu_thread_affinity_mask(g_cpu_affinity_mask_all, g_cpu_affinity_mask_little, g_cpu_affinity_mask_big);
+    initialize_cpu_numa_node_affinity_mask(g_cpu_affinity_mask_numa_nodes);
 
 #if (defined _WIN32 && (__aarch64__ || __arm__))
     if (!is_being_debugged())
@@ -2683,9 +2770,15 @@ const CpuSet& get_cpu_thread_affinity_mask(int powersave)
     return g_cpu_affinity_mask_all;
 }
 
+static ncnn::ThreadLocalStorage tls_numa_node;
+
 int set_cpu_thread_affinity(const CpuSet& thread_affinity_mask)
 {
     try_initialize_global_cpu_info();
+
+    // the thread leaves any numa node binding
+    tls_numa_node.set(0);
+
 #if defined __ANDROID__ || defined __linux__ || defined _WIN32
 #ifdef _OPENMP
     int num_threads = thread_affinity_mask.num_enabled();
@@ -2765,6 +2858,217 @@ int set_cpu_thread_affinity(const CpuSet& thread_affinity_mask)
 #endif
 }
 
+int get_cpu_thread_affinity(CpuSet& thread_affinity_mask)
+{
+    try_initialize_global_cpu_info();
+
+#if defined __ANDROID__ || defined __linux__
+#if defined(__BIONIC__) && !defined(__OHOS__)
+    pid_t pid = gettid();
+#else
+    pid_t pid = syscall(SYS_gettid);
+#endif
+
+    thread_affinity_mask.disable_all();
+
+    int syscallret = syscall(__NR_sched_getaffinity, pid, sizeof(cpu_set_t), &thread_affinity_mask.cpu_set);
+    if (syscallret < 0)
+        return -1;
+
+    return 0;
+#elif defined _WIN32
+    // there is no getter, swap in the process mask and put the previous one back
+    DWORD_PTR process_mask = 0;
+    DWORD_PTR system_mask = 0;
+    if (!GetProcessAffinityMask(GetCurrentProcess(), &process_mask, &system_mask))
+        return -1;
+
+    DWORD_PTR prev_mask = SetThreadAffinityMask(GetCurrentThread(), process_mask);
+    if (prev_mask == 0)
+        return -1;
+
+    SetThreadAffinityMask(GetCurrentThread(), prev_mask);
+
+    thread_affinity_mask.mask = prev_mask;
+    return 0;
+#else
+    // TODO
+    (void)thread_affinity_mask;
+    return -1;
+#endif
+}
+
+int get_cpu_numa_node_count()
+{
+    try_initialize_global_cpu_info();
+    return (int)g_cpu_affinity_mask_numa_nodes.size();
+}
+
+const CpuSet& get_cpu_numa_node_affinity_mask(int node)
+{
+    try_initialize_global_cpu_info();
+    if (node >= 0 && node < (int)g_cpu_affinity_mask_numa_nodes.size())
+        return g_cpu_affinity_mask_numa_nodes[node];
+
+    NCNN_LOGE("numa node %d not available", node);
+
+    // fallback to all cores anyway
+    return g_cpu_affinity_mask_all;
+}
+
+int get_cpu_thread_numa_node()
+{
+    // stored as node + 1 so that the zero initial value means unbound
+    return (int)reinterpret_cast<size_t>(tls_numa_node.get()) - 1;
+}
+
+int set_cpu_thread_numa_node(int node)
+{
+    try_initialize_global_cpu_info();
+    if (node < -1 || node >= (int)g_cpu_affinity_mask_numa_nodes.size())
+    {
+        NCNN_LOGE("numa node %d not available", node);
+        return -1;
+    }
+
+    if (node == get_cpu_thread_numa_node())
+        return 0;
+
+    const CpuSet& thread_affinity_mask = node == -1 ? get_cpu_thread_affinity_mask(g_powersave) : g_cpu_affinity_mask_numa_nodes[node];
+
+    int ret = set_cpu_thread_affinity(thread_affinity_mask);
+    if (ret != 0)
+        return ret;
+
+    tls_numa_node.set(reinterpret_cast<void*>((size_t)(node + 1)));
+
+    return 0;
+}
+
+class CpuSchedulerPrivate
+{
+public:
+    void init(const CpuSet& thread_affinity_mask);
+
+    Mutex lock;
+    std::vector<int> cpus;
+
+    // extractions running on each cpu
+    std::vector<int> cpu_users;
+    int in_flight;
+};
+
+void CpuSchedulerPrivate::init(const CpuSet& thread_affinity_mask)
+{
+    for (int i = 0; i < g_cpucount; i++)
+    {
+        if (thread_affinity_mask.is_enabled(i))
+            cpus.push_back(i);
+    }
+
+    if (cpus.empty())
+    {
+        NCNN_LOGE("CpuScheduler empty thread_affinity_mask, fallback to all cpus");
+        for (int i = 0; i < g_cpucount; i++)
+        {
+            cpus.push_back(i);
+        }
+    }
+
+    cpu_users.resize(cpus.size(), 0);
+    in_flight = 0;
+}
+
+CpuScheduler::CpuScheduler()
+    : d(new CpuSchedulerPrivate)
+{
+    try_initialize_global_cpu_info();
+    d->init(g_cpu_affinity_mask_big.num_enabled() ? g_cpu_affinity_mask_big : g_cpu_affinity_mask_all);
+}
+
+CpuScheduler::CpuScheduler(const CpuSet& thread_affinity_mask)
+    : d(new CpuSchedulerPrivate)
+{
+    try_initialize_global_cpu_info();
+    d->init(thread_affinity_mask);
+}
+
+CpuScheduler::~CpuScheduler()
+{
+    delete d;
+}
+
+CpuScheduler::CpuScheduler(const CpuScheduler&)
+    : d(0)
+{
+}
+
+CpuScheduler& CpuScheduler::operator=(const CpuScheduler&)
+{
+    return *this;
+}
+
+int CpuScheduler::acquire(CpuSet& thread_affinity_mask, int max_threads)
+{
+    thread_affinity_mask.disable_all();
+
+    d->lock.lock();
+
+    d->in_flight++;
+
+    const int cpu_count = (int)d->cpus.size();
+
+    int idle_cpu_count = 0;
+    for (int i = 0; i < cpu_count; i++)
+    {
+        if (d->cpu_users[i] == 0)
+            idle_cpu_count++;
+    }
+
+    // a fair share, but do not pile onto busy cpus when some are idle
+    // busy cpus are only shared when nothing is idle, and then only one of them
+    int share = std::max(1, std::min(cpu_count / d->in_flight, idle_cpu_count));
+    if (max_threads > 0)
+        share = std::min(share, max_threads);
+
+    for (int k = 0; k < share; k++)
+    {
+        // least used cpu not taken yet
+        int best = -1;
+        for (int i = 0; i < cpu_count; i++)
+        {
+            if (thread_affinity_mask.is_enabled(d->cpus[i]))
+                continue;
+
+            if (best == -1 || d->cpu_users[i] < d->cpu_users[best])
+                best = i;
+        }
+
+        d->cpu_users[best]++;
+        thread_affinity_mask.enable(d->cpus[best]);
+    }
+
+    d->lock.unlock();
+
+    return share;
+}
+
+void CpuScheduler::release(const CpuSet& thread_affinity_mask)
+{
+    d->lock.lock();
+
+    const int cpu_count = (int)d->cpus.size();
+    for (int i = 0; i < cpu_count; i++)
+    {
+        if (thread_affinity_mask.is_enabled(d->cpus[i]) && d->cpu_users[i] > 0)
+            d->cpu_users[i]--;
+    }
+
+    d->in_flight--;
+
+    d->lock.unlock();
+}
+
 int is_current_thread_running_on_a53_a55()
 {
     try_initialize_global_cpu_info();
@@ -2868,7 +3172,7 @@ int get_omp_thread_num()
 
 int get_kmp_blocktime()
 {
-#if defined(_OPENMP) && (__clang__ || defined(_OPENMP_LLVM_RUNTIME))
+#if defined(_OPENMP) && (__clang__ || defined(_OPENMP_LLVM_RUNTIME) || NCNN_SIMPLEOMP)
     return kmp_get_blocktime();
 #else
     return 0;
@@ -2877,7 +3181,7 @@ int get_kmp_blocktime()
 
 void set_kmp_blocktime(int time_ms)
 {
-#if defined(_OPENMP) && (__clang__ || defined(_OPENMP_LLVM_RUNTIME))
+#if defined(_OPENMP) && (__clang__ || defined(_OPENMP_LLVM_RUNTIME) || NCNN_SIMPLEOMP)
     kmp_set_blocktime(time_ms);
 #else
     (void)time_ms;
@@ -149,6 +149,53 @@ NCNN_EXPORT const CpuSet& get_cpu_thread_affinity_mask(int powersave);
 // set explicit thread affinity
 NCNN_EXPORT int set_cpu_thread_affinity(const CpuSet& thread_affinity_mask);
 
+// get the affinity of the current thread
+// return 0 if success, -1 if the platform can not tell
+NCNN_EXPORT int get_cpu_thread_affinity(CpuSet& thread_affinity_mask);
+
+// numa node info
+// nodes without any cpu are skipped, so node index may differ from the kernel node id
+// there is always at least one node holding all cpus if numa is not available
+NCNN_EXPORT int get_cpu_numa_node_count();
+NCNN_EXPORT const CpuSet& get_cpu_numa_node_affinity_mask(int node);
+
+// bind the current thread and its openmp workers to the cpus of one numa node
+// memory first touched by these threads is then placed on that node by the kernel
+// -1 = unbound, restore the powersave affinity (default)
+// the binding is remembered per thread, binding to the same node again is cheap
+// return 0 if success for setter function
+NCNN_EXPORT int get_cpu_thread_numa_node();
+NCNN_EXPORT int set_cpu_thread_numa_node(int node);
+
+// share cpus between concurrent extractions so that their threads do not oversubscribe the cores
+// every extraction takes the least used cpus when it starts and gives them back when it ends
+// the share is cpu count / extractions in flight, limited to idle cpus, and at least one cpu
+class CpuSchedulerPrivate;
+class NCNN_EXPORT CpuScheduler
+{
+public:
+    // schedule on big cpus
+    CpuScheduler();
+    // schedule on the cpus of thread_affinity_mask
+    explicit CpuScheduler(const CpuSet& thread_affinity_mask);
+    ~CpuScheduler();
+
+    // take a share of at most max_threads cpus, thread_affinity_mask receives the cpus
+    // max_threads 0 for no limit
+    // return the number of threads for the share
+    int acquire(CpuSet& thread_affinity_mask, int max_threads = 0);
+
+    // give back a share taken by acquire
+    void release(const CpuSet& thread_affinity_mask);
+
+private:
+    CpuScheduler(const CpuScheduler&);
+    CpuScheduler& operator=(const CpuScheduler&);
+
+private:
+    CpuSchedulerPrivate* const d;
+};
+
 // runtime thread affinity info
 NCNN_EXPORT int is_current_thread_running_on_a53_a55();
 
@@ -0,0 +1,544 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "cpupipelinecache.h"
+
+#include "cpu.h"
+#include "datareader.h"
+
+#include <string.h>
+
+#if NCNN_STDIO
+#include <stdio.h>
+#endif
+
+namespace ncnn {
+
+// https://en.wikipedia.org/wiki/MurmurHash
+static uint32_t murmur3_32(const unsigned char* data, size_t size)
+{
+    uint32_t h = 0;
+
+    const size_t nblocks = size / 4;
+    for (size_t i = 0; i < nblocks; i++)
+    {
+        uint32_t k;
+        memcpy(&k, data + i * 4, 4);
+
+        k *= 0xcc9e2d51;
+        k = (k << 15) | (k >> (32 - 15));
+        k *= 0x1b873593;
+
+        h ^= k;
+        h = (h << 13) | (h >> (32 - 13));
+        h = (h * 5) + 0xe6546b64;
+    }
+
+    // tail
+    const unsigned char* tail = data + nblocks * 4;
+    uint32_t k = 0;
+    switch (size & 3)
+    {
+    case 3:
+        k ^= tail[2] << 16;
+    // fallthrough
+    case 2:
+        k ^= tail[1] << 8;
+    // fallthrough
+    case 1:
+        k ^= tail[0];
+        k *= 0xcc9e2d51;
+        k = (k << 15) | (k >> (32 - 15));
+        k *= 0x1b873593;
+        h ^= k;
+    }
+
+    h ^= (uint32_t)size;
+
+    h ^= h >> 16;
+    h *= 0x85ebca6b;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35;
+    h ^= h >> 16;
+
+    return h;
+}
+
+// https://en.wikipedia.org/wiki/Fowler%E2%80%93Noll%E2%80%93Vo_hash_function#FNV-1a_hash
+static uint32_t fnv1a_32(const unsigned char* data, size_t size)
+{
+    uint32_t h = 0x811c9dc5;
+
+    for (size_t i = 0; i < size; i++)
+    {
+        h ^= (uint32_t)*data++;
+        h *= 0x01000193;
+    }
+
+    return h;
+}
+
+class CpuPipelineCachePrivate
+{
+public:
+    // digest -> artifact
+    struct cpu_pipeline_cache_digest
+    {
+        cpu_pipeline_cache_digest();
+        cpu_pipeline_cache_digest(int typeindex, const std::vector<int>& params, const Mat& weight_data, const Option& opt);
+
+        bool operator==(const cpu_pipeline_cache_digest& rhs) const
+        {
+            return typeindex == rhs.typeindex
+                   && params_murmur3 == rhs.params_murmur3 && params_fnv1a == rhs.params_fnv1a
+                   && weight_murmur3 == rhs.weight_murmur3 && weight_fnv1a == rhs.weight_fnv1a && weight_size == rhs.weight_size;
+        }
+
+        int typeindex;
+        uint32_t params_murmur3;
+        uint32_t params_fnv1a;
+        uint32_t weight_murmur3;
+        uint32_t weight_fnv1a;
+        uint32_t weight_size;
+    };
+
+    int find(const cpu_pipeline_cache_digest& key) const;
+
+    std::vector<cpu_pipeline_cache_digest> cache_digests;
+    std::vector<std::vector<Mat> > cache_artifacts;
+    mutable Mutex cache_lock;
+
+    mutable int hits;
+    mutable int misses;
+
+#if NCNN_STDIO
+    // keep the mappings alive for the cached weights referencing them
+    std::vector<DataReaderFromMmap*> mmap_readers;
+#endif // NCNN_STDIO
+};
+
+CpuPipelineCachePrivate::cpu_pipeline_cache_digest::cpu_pipeline_cache_digest()
+{
+    typeindex = -1;
+    params_murmur3 = 0;
+    params_fnv1a = 0;
+    weight_murmur3 = 0;
+    weight_fnv1a = 0;
+    weight_size = 0;
+}
+
+CpuPipelineCachePrivate::cpu_pipeline_cache_digest::cpu_pipeline_cache_digest(int _typeindex, const std::vector<int>& params, const Mat& weight_data, const Option& opt)
+{
+    typeindex = _typeindex;
+
+    // the transform depends on layer params, the isa selected at runtime,
+    // the cache size used for tiling and the options picking the algorithm
+    std::vector<int> env = params;
+    env.push_back(cpu_support_x86_avx());
+    env.push_back(cpu_support_x86_fma());
+    env.push_back(cpu_support_x86_xop());
+    env.push_back(cpu_support_x86_f16c());
+    env.push_back(cpu_support_x86_avx2());
+    env.push_back(cpu_support_x86_avx_vnni());
+    env.push_back(cpu_support_x86_avx512());
+    env.push_back(cpu_support_x86_avx512_vnni());
+    env.push_back(cpu_support_x86_avx512_bf16());
+    env.push_back(cpu_support_x86_avx512_fp16());
+    env.push_back(cpu_support_arm_neon());
+    env.push_back(cpu_support_arm_vfpv4());
+    env.push_back(cpu_support_arm_asimdhp());
+    env.push_back(cpu_support_arm_asimddp());
+    env.push_back(cpu_support_arm_asimdfhm());
+    env.push_back(cpu_support_arm_bf16());
+    env.push_back(cpu_support_arm_i8mm());
+    env.push_back(cpu_support_arm_sve());
+    env.push_back(cpu_support_arm_sve2());
+    env.push_back(cpu_support_loongarch_lsx());
+    env.push_back(cpu_support_loongarch_lasx());
+    env.push_back(cpu_support_mips_msa());
+    env.push_back(cpu_support_loongson_mmi());
+    env.push_back(cpu_support_riscv_v());
+    env.push_back(cpu_support_riscv_zfh());
+    env.push_back(cpu_riscv_vlenb());
+    env.push_back(get_cpu_level2_cache_size());
+    env.push_back(get_cpu_level3_cache_size());
+    env.push_back(opt.num_threads);
+    env.push_back(opt.use_winograd_convolution);
+    env.push_back(opt.use_winograd23_convolution);
+    env.push_back(opt.use_winograd43_convolution);
+    env.push_back(opt.use_winograd63_convolution);
+    env.push_back(opt.use_sgemm_convolution);
+    env.push_back(opt.use_packing_layout);
+    env.push_back(opt.use_fp16_packed);
+    env.push_back(opt.use_fp16_storage);
+    env.push_back(opt.use_fp16_arithmetic);
+    env.push_back(opt.use_bf16_storage);
+    env.push_back(opt.use_int8_packed);
+    env.push_back(opt.use_int8_storage);
+    env.push_back(opt.use_int8_arithmetic);
+    env.push_back(opt.use_int8_inference);
+    env.push_back(opt.use_a53_a55_optimized_kernel);
+    env.push_back(opt.use_fp16_weight_storage);
+
+    const unsigned char* env_data = (const unsigned char*)&env[0];
+    const size_t env_size = env.size() * sizeof(int);
+    params_murmur3 = murmur3_32(env_data, env_size);
+    params_fnv1a = fnv1a_32(env_data, env_size);
+
+    // two independent hashes so that a weight collision needs both to collide
+    const size_t weight_data_size = weight_data.total() * weight_data.elemsize;
+    weight_murmur3 = weight_data_size ? murmur3_32((const unsigned char*)weight_data.data, weight_data_size) : 0;
+    weight_fnv1a = weight_data_size ? fnv1a_32((const unsigned char*)weight_data.data, weight_data_size) : 0;
+    weight_size = (uint32_t)weight_data_size;
+}
+
+int CpuPipelineCachePrivate::find(const cpu_pipeline_cache_digest& key) const
+{
+    for (size_t i = 0; i < cache_digests.size(); i++)
+    {
+        if (cache_digests[i] == key)
+            return (int)i;
+    }
+
+    return -1;
+}
+
+CpuPipelineCache::CpuPipelineCache()
+    : d(new CpuPipelineCachePrivate)
+{
+    d->hits = 0;
+    d->misses = 0;
+}
+
+CpuPipelineCache::~CpuPipelineCache()
+{
+    clear();
+
+#if NCNN_STDIO
+    for (size_t i = 0; i < d->mmap_readers.size(); i++)
+    {
+        delete d->mmap_readers[i];
+    }
+#endif // NCNN_STDIO
+
+    delete d;
+}
+
+CpuPipelineCache::CpuPipelineCache(const CpuPipelineCache&)
+    : d(0)
+{
+}
+
+CpuPipelineCache& CpuPipelineCache::operator=(const CpuPipelineCache&)
+{
+    return *this;
+}
+
+void CpuPipelineCache::clear()
+{
+    MutexLockGuard lock(d->cache_lock);
+
+    d->cache_digests.clear();
+    d->cache_artifacts.clear();
+}
+
+int CpuPipelineCache::get(int typeindex, const std::vector<int>& params, const Mat& weight_data, const Option& opt, std::vector<Mat>& artifacts) const
+{
+    const CpuPipelineCachePrivate::cpu_pipeline_cache_digest key(typeindex, params, weight_data, opt);
+
+    MutexLockGuard lock(d->cache_lock);
+
+    int index = d->find(key);
+    if (index == -1)
+    {
+        d->misses++;
+        return -1;
+    }
+
+    d->hits++;
+
+    artifacts = d->cache_artifacts[index];
+
+    return 0;
+}
+
+int CpuPipelineCache::hit_count() const
+{
+    MutexLockGuard lock(d->cache_lock);
+
+    return d->hits;
+}
+
+int CpuPipelineCache::miss_count() const
+{
+    MutexLockGuard lock(d->cache_lock);
+
+    return d->misses;
+}
+
+int CpuPipelineCache::put(int typeindex, const std::vector<int>& params, const Mat& weight_data, const Option& opt, const std::vector<Mat>& artifacts)
+{
+    const CpuPipelineCachePrivate::cpu_pipeline_cache_digest key(typeindex, params, weight_data, opt);
+
+    MutexLockGuard lock(d->cache_lock);
+
+    int index = d->find(key);
+    if (index != -1)
+    {
+        d->cache_artifacts[index] = artifacts;
+        return 0;
+    }
+
+    d->cache_digests.push_back(key);
+    d->cache_artifacts.push_back(artifacts);
+
+    return 0;
+}
+
+#if NCNN_STDIO
+// file layout
+//   header   magic version entry_count
+//   entry    digest artifact_count
+//   artifact dims w h d c elempack elemsize cstep data_size, data aligned to 64 bytes
+static const uint32_t CPU_PIPELINE_CACHE_MAGIC = 0x4370636e; // "ncpC"
+static const uint32_t CPU_PIPELINE_CACHE_VERSION = 2;
+
+struct cpu_pipeline_cache_artifact_header
+{
+    int dims;
+    int w;
+    int h;
+    int d;
+    int c;
+    int elempack;
+    uint32_t elemsize;
+    uint32_t reserved;
+    uint64_t cstep;
+    uint64_t data_size;
+};
+
+static size_t padding_size(size_t offset)
+{
+    return alignSize(offset, 64) - offset;
+}
+
+int CpuPipelineCache::load(const char* path)
+{
+    DataReaderFromMmap* dr = new DataReaderFromMmap(path);
+    if (!dr->is_mapped())
+    {
+        NCNN_LOGE("CpuPipelineCache load %s failed", path);
+        delete dr;
+        return -1;
+    }
+
+    std::vector<CpuPipelineCachePrivate::cpu_pipeline_cache_digest> digests;
+    std::vector<std::vector<Mat> > artifacts;
+
+    size_t offset = 0;
+    uint32_t header[3];
+    if (dr->read(header, sizeof(header)) != sizeof(header) || header[0] != CPU_PIPELINE_CACHE_MAGIC || header[1] != CPU_PIPELINE_CACHE_VERSION)
+    {
+        NCNN_LOGE("CpuPipelineCache load %s invalid header", path);
+        delete dr;
+        return -1;
+    }
+    offset += sizeof(header);
+
+    const uint32_t entry_count = header[2];
+
+    bool failed = false;
+    for (uint32_t i = 0; i < entry_count && !failed; i++)
+    {
+        CpuPipelineCachePrivate::cpu_pipeline_cache_digest digest;
+        uint32_t artifact_count = 0;
+        if (dr->read(&digest, sizeof(digest)) != sizeof(digest) || dr->read(&artifact_count, sizeof(uint32_t)) != sizeof(uint32_t))
+        {
+            failed = true;
+            break;
+        }
+        offset += sizeof(digest) + sizeof(uint32_t);
+
+        std::vector<Mat> mats(artifact_count);
+        for (uint32_t j = 0; j < artifact_count; j++)
+        {
+            cpu_pipeline_cache_artifact_header ah;
+            if (dr->read(&ah, sizeof(ah)) != sizeof(ah))
+            {
+                failed = true;
+                break;
+            }
+            offset += sizeof(ah);
+
+            if (ah.dims == 0)
+                continue;
+
+            // skip padding
+            unsigned char pad[64];
+            const size_t pad_size = padding_size(offset);
+            if (dr->read(pad, pad_size) != pad_size)
+            {
+                failed = true;
+                break;
+            }
+            offset += pad_size;
+
+            Mat& m = mats[j];
+
+            const void* refbuf = 0;
+            if (dr->reference((size_t)ah.data_size, &refbuf) == (size_t)ah.data_size)
+            {
+                // weights are read only, so reference the mapping directly
+                void* data = (void*)refbuf;
+                if (ah.dims == 1)
+                    m = Mat(ah.w, data, (size_t)ah.elemsize, ah.elempack);
+                if (ah.dims == 2)
+                    m = Mat(ah.w, ah.h, data, (size_t)ah.elemsize, ah.elempack);
+                if (ah.dims == 3)
+                    m = Mat(ah.w, ah.h, ah.c, data, (size_t)ah.elemsize, ah.elempack);
+                if (ah.dims == 4)
+                    m = Mat(ah.w, ah.h, ah.d, ah.c, data, (size_t)ah.elemsize, ah.elempack);
+            }
+            else
+            {
+                if (ah.dims == 1)
+                    m.create(ah.w, (size_t)ah.elemsize, ah.elempack);
+                if (ah.dims == 2)
+                    m.create(ah.w, ah.h, (size_t)ah.elemsize, ah.elempack);
+                if (ah.dims == 3)
+                    m.create(ah.w, ah.h, ah.c, (size_t)ah.elemsize, ah.elempack);
+                if (ah.dims == 4)
+                    m.create(ah.w, ah.h, ah.d, ah.c, (size_t)ah.elemsize, ah.elempack);
+
+                if (m.empty() || m.total() * m.elemsize < ah.data_size || dr->read(m.data, (size_t)ah.data_size) != (size_t)ah.data_size)
+                {
+                    failed = true;
+                    break;
+                }
+            }
+            offset += (size_t)ah.data_size;
+
+            m.cstep = (size_t)ah.cstep;
+        }
+
+        digests.push_back(digest);
+        artifacts.push_back(mats);
+    }
+
+    if (failed)
+    {
+        NCNN_LOGE("CpuPipelineCache load %s truncated", path);
+        artifacts.clear();
+        delete dr;
+        return -1;
+    }
+
+    MutexLockGuard lock(d->cache_lock);
+
+    for (size_t i = 0; i < digests.size(); i++)
+    {
+        int index = d->find(digests[i]);
+        if (index != -1)
+        {
+            d->cache_artifacts[index] = artifacts[i];
+            continue;
+        }
+
+        d->cache_digests.push_back(digests[i]);
+        d->cache_artifacts.push_back(artifacts[i]);
+    }
+
+    d->mmap_readers.push_back(dr);
+
+    return 0;
+}
+
+int CpuPipelineCache::save(const char* path) const
+{
+    FILE* fp = fopen(path, "wb");
+    if (!fp)
+    {
+        NCNN_LOGE("fopen %s failed", path);
+        return -1;
+    }
+
+    MutexLockGuard lock(d->cache_lock);
+
+    static const unsigned char zeros[64] = {0};
+
+    size_t offset = 0;
+    uint32_t header[3];
+    header[0] = CPU_PIPELINE_CACHE_MAGIC;
+    header[1] = CPU_PIPELINE_CACHE_VERSION;
+    header[2] = (uint32_t)d->cache_digests.size();
+
+    bool write_ok = fwrite(header, sizeof(header), 1, fp) == 1;
+    offset += sizeof(header);
+
+    for (size_t i = 0; i < d->cache_digests.size(); i++)
+    {
+        const std::vector<Mat>& mats = d->cache_artifacts[i];
+        const uint32_t artifact_count = (uint32_t)mats.size();
+
+        write_ok = write_ok && fwrite(&d->cache_digests[i], sizeof(CpuPipelineCachePrivate::cpu_pipeline_cache_digest), 1, fp) == 1;
+        write_ok = write_ok && fwrite(&artifact_count, sizeof(uint32_t), 1, fp) == 1;
+        offset += sizeof(CpuPipelineCachePrivate::cpu_pipeline_cache_digest) + sizeof(uint32_t);
+
+        for (size_t j = 0; j < mats.size(); j++)
+        {
+            const Mat& m = mats[j];
+
+            cpu_pipeline_cache_artifact_header ah;
+            ah.dims = m.empty() ? 0 : m.dims;
+            ah.w = m.w;
+            ah.h = m.h;
+            ah.d = m.d;
+            ah.c = m.c;
+            ah.elempack = m.elempack;
+            ah.elemsize = (uint32_t)m.elemsize;
+            ah.reserved = 0;
+            ah.cstep = m.cstep;
+            ah.data_size = m.empty() ? 0 : m.total() * m.elemsize;
+
+            write_ok = write_ok && fwrite(&ah, sizeof(ah), 1, fp) == 1;
+            offset += sizeof(ah);
+
+            if (ah.dims == 0)
+                continue;
+
+            const size_t pad_size = padding_size(offset);
+            if (pad_size)
+            {
+                write_ok = write_ok && fwrite(zeros, pad_size, 1, fp) == 1;
+                offset += pad_size;
+            }
+
+            write_ok = write_ok && fwrite(m.data, (size_t)ah.data_size, 1, fp) == 1;
+            offset += (size_t)ah.data_size;
+        }
+    }
+
+    fclose(fp);
+
+    if (!write_ok)
+    {
+        NCNN_LOGE("CpuPipelineCache save %s failed", path);
+        return -1;
+    }
+
+    return 0;
+}
+#endif // NCNN_STDIO
+
+} // namespace ncnn
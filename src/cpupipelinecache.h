@@ -0,0 +1,74 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef NCNN_CPUPIPELINECACHE_H
+#define NCNN_CPUPIPELINECACHE_H
+
+#include "platform.h"
+
+#include "mat.h"
+#include "option.h"
+
+namespace ncnn {
+
+// transformed weight cache for cpu layers
+// create_pipeline looks up the cache before repacking weights
+// entries are keyed by layer type, layer parameters, weight content,
+// cpu isa, cache size and the option bits deciding the transform
+// the cache must be retained while networks loaded with it are in use
+class CpuPipelineCachePrivate;
+class NCNN_EXPORT CpuPipelineCache
+{
+public:
+    CpuPipelineCache();
+
+    virtual ~CpuPipelineCache();
+
+    void clear();
+
+    // look up transformed weights
+    // return 0 if found
+    int get(int typeindex, const std::vector<int>& params, const Mat& weight_data, const Option& opt, std::vector<Mat>& artifacts) const;
+
+    // store transformed weights
+    // artifacts are referenced, not copied
+    // return 0 if success
+    int put(int typeindex, const std::vector<int>& params, const Mat& weight_data, const Option& opt, const std::vector<Mat>& artifacts);
+
+    // number of lookups that found or missed an entry since construction
+    int hit_count() const;
+    int miss_count() const;
+
+#if NCNN_STDIO
+    // load cache file with read-only memory mapping
+    // cached weights reference the mapping directly
+    // return 0 if success
+    int load(const char* path);
+
+    // save all entries to cache file
+    // return 0 if success
+    int save(const char* path) const;
+#endif // NCNN_STDIO
+
+private:
+    CpuPipelineCache(const CpuPipelineCache&);
+    CpuPipelineCache& operator=(const CpuPipelineCache&);
+
+private:
+    CpuPipelineCachePrivate* const d;
+};
+
+} // namespace ncnn
+
+#endif // NCNN_CPUPIPELINECACHE_H
@@ -16,6 +16,18 @@
 
 #include <string.h>
 
+#if NCNN_STDIO
+#if defined _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#endif // NCNN_STDIO
+
 namespace ncnn {
 
 DataReader::DataReader()
@@ -85,6 +97,132 @@ size_t DataReaderFromStdio::read(void* buf, size_t size) const
 {
     return fread(buf, 1, size, d->fp);
 }
+
+class DataReaderFromMmapPrivate
+{
+public:
+    DataReaderFromMmapPrivate()
+        : mem(0), length(0), pos(0)
+    {
+#if defined _WIN32
+        file = INVALID_HANDLE_VALUE;
+        mapping = 0;
+#endif
+    }
+
+    const unsigned char* mem;
+    size_t length;
+    mutable size_t pos;
+
+#if defined _WIN32
+    HANDLE file;
+    HANDLE mapping;
+#endif
+};
+
+DataReaderFromMmap::DataReaderFromMmap(const char* path)
+    : DataReader(), d(new DataReaderFromMmapPrivate)
+{
+#if defined _WIN32
+    d->file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (d->file == INVALID_HANDLE_VALUE)
+        return;
+
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(d->file, &file_size) || file_size.QuadPart == 0)
+        return;
+
+    d->mapping = CreateFileMappingA(d->file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (!d->mapping)
+        return;
+
+    d->mem = (const unsigned char*)MapViewOfFile(d->mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!d->mem)
+        return;
+
+    d->length = (size_t)file_size.QuadPart;
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd == -1)
+        return;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0)
+    {
+        close(fd);
+        return;
+    }
+
+    // shared read-only mapping, so that processes serving the same model share physical pages
+    void* mem = mmap(0, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+
+    // the mapping holds its own reference to the file
+    close(fd);
+
+    if (mem == MAP_FAILED)
+        return;
+
+    d->mem = (const unsigned char*)mem;
+    d->length = (size_t)st.st_size;
+#endif
+}
+
+DataReaderFromMmap::~DataReaderFromMmap()
+{
+#if defined _WIN32
+    if (d->mem)
+        UnmapViewOfFile(d->mem);
+    if (d->mapping)
+        CloseHandle(d->mapping);
+    if (d->file != INVALID_HANDLE_VALUE)
+        CloseHandle(d->file);
+#else
+    if (d->mem)
+        munmap((void*)d->mem, d->length);
+#endif
+
+    delete d;
+}
+
+DataReaderFromMmap::DataReaderFromMmap(const DataReaderFromMmap&)
+    : d(0)
+{
+}
+
+DataReaderFromMmap& DataReaderFromMmap::operator=(const DataReaderFromMmap&)
+{
+    return *this;
+}
+
+bool DataReaderFromMmap::is_mapped() const
+{
+    return d->mem != 0;
+}
+
+size_t DataReaderFromMmap::read(void* buf, size_t size) const
+{
+    if (!d->mem)
+        return 0;
+
+    size_t nread = size < d->length - d->pos ? size : d->length - d->pos;
+    memcpy(buf, d->mem + d->pos, nread);
+    d->pos += nread;
+    return nread;
+}
+
+size_t DataReaderFromMmap::reference(size_t size, const void** buf) const
+{
+    if (!d->mem || size > d->length - d->pos)
+        return 0;
+
+    // the mapping is page aligned, unaligned weight goes through read and gets its own aligned storage
+    if (d->pos % 4 != 0)
+        return 0;
+
+    *buf = d->mem + d->pos;
+    d->pos += size;
+    return size;
+}
 #endif // NCNN_STDIO
 
 class DataReaderFromMemoryPrivate
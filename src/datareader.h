@@ -70,6 +70,32 @@ private:
 private:
     DataReaderFromStdioPrivate* const d;
 };
+
+class DataReaderFromMmapPrivate;
+class NCNN_EXPORT DataReaderFromMmap : public DataReader
+{
+public:
+    // map the whole file read-only
+    // the mapping lives as long as the reader
+    explicit DataReaderFromMmap(const char* path);
+    virtual ~DataReaderFromMmap();
+
+    // return true if the file is mapped
+    bool is_mapped() const;
+
+    virtual size_t read(void* buf, size_t size) const;
+
+    // reference data in the mapping
+    // only 32-bit aligned offset could be referenced, otherwise return 0 and fallback to read
+    virtual size_t reference(size_t size, const void** buf) const;
+
+private:
+    DataReaderFromMmap(const DataReaderFromMmap&);
+    DataReaderFromMmap& operator=(const DataReaderFromMmap&);
+
+private:
+    DataReaderFromMmapPrivate* const d;
+};
 #endif // NCNN_STDIO
 
 class DataReaderFromMemoryPrivate;
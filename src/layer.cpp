@@ -35,7 +35,7 @@ Layer::Layer()
     support_image_storage = false;
     support_tensor_storage = false;
 
-    support_reserved_00 = false;
+    support_batch = false;
 
     typeindex = -1;
 
@@ -108,6 +108,19 @@ int Layer::forward_inplace(Mat& /*bottom_top_blob*/, const Option& /*opt*/) cons
     return -1;
 }
 
+int Layer::forward_batch(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+{
+    top_blobs.resize(bottom_blobs.size());
+    for (size_t i = 0; i < bottom_blobs.size(); i++)
+    {
+        int ret = forward(bottom_blobs[i], top_blobs[i], opt);
+        if (ret != 0)
+            return ret;
+    }
+
+    return 0;
+}
+
 #if NCNN_VULKAN
 int Layer::upload_model(VkTransfer& /*cmd*/, const Option& /*opt*/)
 {
@@ -282,6 +295,7 @@ public:
         support_bf16_storage = layer_cpu->support_bf16_storage;
         support_fp16_storage = layer_cpu->support_fp16_storage;
         support_int8_storage = layer_cpu->support_int8_storage;
+        support_batch = layer_cpu->support_batch;
 
         support_vulkan = 0;
         support_image_storage = 0;
@@ -413,6 +427,11 @@ public:
         return layer_cpu->forward_inplace(bottom_top_blob, opt);
     }
 
+    virtual int forward_batch(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+    {
+        return layer_cpu->forward_batch(bottom_blobs, top_blobs, opt);
+    }
+
 #if NCNN_VULKAN
 public:
     virtual int upload_model(VkTransfer& cmd, const Option& opt)
@@ -80,7 +80,9 @@ public:
     // shader tensor storage
     bool support_tensor_storage;
 
-    bool support_reserved_00;
+    // process a batch of samples in one forward_batch call
+    // InnerProduct, Gemm with constant B and 1x1 stride 1 Convolution for now
+    bool support_batch;
 
     bool support_reserved_0;
     bool support_reserved_1;
@@ -107,6 +109,12 @@ public:
     virtual int forward_inplace(std::vector<Mat>& bottom_top_blobs, const Option& opt) const;
     virtual int forward_inplace(Mat& bottom_top_blob, const Option& opt) const;
 
+    // implement batch inference for one_blob_only layer
+    // bottom_blobs and top_blobs hold one blob for each sample
+    // the default implementation forwards each sample in turn
+    // return 0 if success
+    virtual int forward_batch(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const;
+
 #if NCNN_VULKAN
 public:
     // upload weight blob from host to device
@@ -5598,6 +5598,8 @@ static int conv3x3s1_winograd23(const Mat& bottom_blob, Mat& top_blob, const Mat
     int TILE_M, TILE_N, TILE_K;
     conv3x3s1_winograd_get_optimal_tile_mnk(M, N, K, B, TILE_M, TILE_N, TILE_K, nT);
 
+    nT = std::min(nT, opt.num_threads);
+
     const int nn_M = (M + TILE_M - 1) / TILE_M;
     const int nn_N = (N + TILE_N - 1) / TILE_N;
     const int nn_K = (K + TILE_K - 1) / TILE_K;
@@ -7286,6 +7288,8 @@ static int conv3x3s1_winograd43(const Mat& bottom_blob, Mat& top_blob, const Mat
     int TILE_M, TILE_N, TILE_K;
     conv3x3s1_winograd_get_optimal_tile_mnk(M, N, K, B, TILE_M, TILE_N, TILE_K, nT);
 
+    nT = std::min(nT, opt.num_threads);
+
     const int nn_M = (M + TILE_M - 1) / TILE_M;
     const int nn_N = (N + TILE_N - 1) / TILE_N;
     const int nn_K = (K + TILE_K - 1) / TILE_K;
@@ -9332,6 +9336,8 @@ static int conv3x3s1_winograd63(const Mat& bottom_blob, Mat& top_blob, const Mat
     int TILE_M, TILE_N, TILE_K;
     conv3x3s1_winograd_get_optimal_tile_mnk(M, N, K, B, TILE_M, TILE_N, TILE_K, nT);
 
+    nT = std::min(nT, opt.num_threads);
+
     const int nn_M = (M + TILE_M - 1) / TILE_M;
     const int nn_N = (N + TILE_N - 1) / TILE_N;
     const int nn_K = (K + TILE_K - 1) / TILE_K;
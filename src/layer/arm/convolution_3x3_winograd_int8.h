@@ -4277,6 +4277,8 @@ static int conv3x3s1_winograd23_int8(Mat& bottom_blob, Mat& top_blob, const Mat&
     int TILE_M, TILE_N, TILE_K;
     get_optimal_tile_mnk_int8(M, N, K, TILE_M, TILE_N, TILE_K, nT);
 
+    nT = std::min(nT, opt.num_threads);
+
     const int nn_M = (M + TILE_M - 1) / TILE_M;
     const int nn_N = (N + TILE_N - 1) / TILE_N;
     const int nn_K = (K + TILE_K - 1) / TILE_K;
@@ -5634,6 +5636,8 @@ static int conv3x3s1_winograd43_int8(Mat& bottom_blob, Mat& top_blob, const Mat&
     int TILE_M, TILE_N, TILE_K;
     get_optimal_tile_mnk_int8(M, N, K, TILE_M, TILE_N, TILE_K, nT);
 
+    nT = std::min(nT, opt.num_threads);
+
     const int nn_M = (M + TILE_M - 1) / TILE_M;
     const int nn_N = (N + TILE_N - 1) / TILE_N;
     const int nn_K = (K + TILE_K - 1) / TILE_K;
@@ -365,10 +365,10 @@ int Convolution_arm::forward_fp16sa(const Mat& bottom_blob, Mat& top_blob, const
         // NCNN_LOGE("prefer_winograd %d %d %d", prefer_winograd23, prefer_winograd43, prefer_winograd63);
 
         int _nT = nT ? nT : opt.num_threads;
-        if (nT != 0 && opt.num_threads != nT)
+        if (nT != 0 && opt.num_threads > nT)
         {
-            // force num_threads the same as in create_pipeline
-            // so we could use pre-packed A/B from the same tile config
+            // pre-packed A/B comes from the tile config in create_pipeline
+            // so we could not use more threads than the load-time value
             NCNN_LOGE("opt.num_threads %d changed, convolution winograd will use load-time value %d", opt.num_threads, nT);
         }
 
@@ -467,10 +467,10 @@ int Convolution_arm::forward_fp16sa(const Mat& bottom_blob, Mat& top_blob, const
     if ((opt.use_sgemm_convolution && prefer_sgemm) || (kernel_w == 1 && kernel_h == 1))
     {
         int _nT = nT ? nT : opt.num_threads;
-        if (nT != 0 && opt.num_threads != nT)
+        if (nT != 0 && opt.num_threads > nT)
         {
-            // force num_threads the same as in create_pipeline
-            // so we could use pre-packed A/B from the same tile config
+            // pre-packed A/B comes from the tile config in create_pipeline
+            // so we could not use more threads than the load-time value
             NCNN_LOGE("opt.num_threads %d changed, convolution gemm will use load-time value %d", opt.num_threads, nT);
         }
 
@@ -10969,6 +10969,8 @@ static int convolution_im2col_gemm_int8(const Mat& bottom_blob, Mat& top_blob, c
     int TILE_M, TILE_N, TILE_K;
     convolution_im2col_gemm_get_optimal_tile_mnk_int8(M, N, K, TILE_M, TILE_N, TILE_K, nT);
 
+    nT = std::min(nT, opt.num_threads);
+
     const int nn_M = (M + TILE_M - 1) / TILE_M;
     const int nn_N = (N + TILE_N - 1) / TILE_N;
     const int nn_K = (K + TILE_K - 1) / TILE_K;
@@ -281,10 +281,12 @@ int MultiHeadAttention_arm::destroy_pipeline(const Option& _opt)
 
 int MultiHeadAttention_arm::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& _opt) const
 {
+    const int input_count = kv_cache ? (int)bottom_blobs.size() - 2 : (int)bottom_blobs.size();
+
     const Mat& q_blob = bottom_blobs[0];
-    const Mat& k_blob = (bottom_blobs.size() == 1 || (bottom_blobs.size() == 2 && attn_mask)) ? q_blob : bottom_blobs[1];
-    const Mat& v_blob = (bottom_blobs.size() == 1 || (bottom_blobs.size() == 2 && attn_mask)) ? q_blob : (bottom_blobs.size() == 2 || (bottom_blobs.size() == 3 && attn_mask)) ? k_blob : bottom_blobs[2];
-    const Mat& attn_mask_blob = attn_mask ? bottom_blobs[bottom_blobs.size() - 1] : Mat();
+    const Mat& k_blob = (input_count == 1 || (input_count == 2 && attn_mask)) ? q_blob : bottom_blobs[1];
+    const Mat& v_blob = (input_count == 1 || (input_count == 2 && attn_mask)) ? q_blob : (input_count == 2 || (input_count == 3 && attn_mask)) ? k_blob : bottom_blobs[2];
+    const Mat& attn_mask_blob = attn_mask ? bottom_blobs[input_count - 1] : Mat();
 
     Option opt = _opt;
     opt.use_fp16_storage &= support_fp16_storage;
@@ -304,7 +306,6 @@ int MultiHeadAttention_arm::forward(const std::vector<Mat>& bottom_blobs, std::v
 
     const int embed_dim_per_head = embed_dim / num_heads;
     const int src_seqlen = q_blob.h * q_blob.elempack;
-    const int dst_seqlen = k_blob.h * k_blob.elempack;
 
     // const int elembits = q_blob.elembits();
 
@@ -320,6 +321,17 @@ int MultiHeadAttention_arm::forward(const std::vector<Mat>& bottom_blobs, std::v
     if (retk != 0)
         return retk;
 
+    if (kv_cache)
+    {
+        int retkc = concat_kv_cache(bottom_blobs[input_count], k_affine, top_blobs[1], opt);
+        if (retkc != 0)
+            return retkc;
+
+        k_affine = top_blobs[1];
+    }
+
+    const int dst_seqlen = k_affine.w;
+
     Mat qk_cross(dst_seqlen, src_seqlen * num_heads, elemsize, opt.blob_allocator);
     if (qk_cross.empty())
         return -100;
@@ -361,6 +373,15 @@ int MultiHeadAttention_arm::forward(const std::vector<Mat>& bottom_blobs, std::v
     if (retv != 0)
         return retv;
 
+    if (kv_cache)
+    {
+        int retvc = concat_kv_cache(bottom_blobs[input_count + 1], v_affine, top_blobs[2], opt);
+        if (retvc != 0)
+            return retvc;
+
+        v_affine = top_blobs[2];
+    }
+
     Mat qkv_cross(src_seqlen, embed_dim_per_head * num_heads, elemsize, opt.blob_allocator);
     if (qkv_cross.empty())
         return -100;
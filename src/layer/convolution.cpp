@@ -53,6 +53,12 @@ int Convolution::load_param(const ParamDict& pd)
         one_blob_only = false;
     }
 
+    // 1x1 stride 1 convolution maps each input row to the same output row
+    // so that samples with the same width could be stacked along h
+    // negative pads are SAME_UPPER / SAME_LOWER, which resolve to zero here
+    support_batch = !dynamic_weight && kernel_w == 1 && kernel_h == 1 && stride_w == 1 && stride_h == 1
+                    && pad_left <= 0 && pad_right <= 0 && pad_top <= 0 && pad_bottom <= 0;
+
     if (int8_scale_term)
     {
 #if NCNN_INT8
@@ -373,6 +379,89 @@ void Convolution::make_padding(const Mat& bottom_blob, Mat& bottom_blob_bordered
     }
 }
 
+int Convolution::forward_batch(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+{
+    // only 1x1 stride 1 convolution stacks, kxk kernels would mix rows across sample borders
+    if (!support_batch)
+        return Layer::forward_batch(bottom_blobs, top_blobs, opt);
+
+    const int batch = (int)bottom_blobs.size();
+
+    const int w = bottom_blobs[0].w;
+    const int channels = bottom_blobs[0].c;
+    const size_t elemsize = bottom_blobs[0].elemsize;
+    const int elempack = bottom_blobs[0].elempack;
+
+    int total_h = 0;
+    for (int b = 0; b < batch; b++)
+    {
+        const Mat& bottom_blob = bottom_blobs[b];
+        // samples of different width or layout run one by one
+        if (bottom_blob.dims != 3 || bottom_blob.w != w || bottom_blob.c != channels || bottom_blob.elemsize != elemsize || bottom_blob.elempack != elempack)
+            return Layer::forward_batch(bottom_blobs, top_blobs, opt);
+
+        total_h += bottom_blob.h;
+    }
+
+    // stack samples along h, the whole batch goes through one gemm
+    Mat bottom_blob_stacked(w, total_h, channels, elemsize, elempack, opt.workspace_allocator);
+    if (bottom_blob_stacked.empty())
+        return -100;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < channels; q++)
+    {
+        unsigned char* outptr = bottom_blob_stacked.channel(q);
+
+        for (int b = 0; b < batch; b++)
+        {
+            const Mat& bottom_blob = bottom_blobs[b];
+            const size_t size = (size_t)w * bottom_blob.h * elemsize;
+
+            memcpy(outptr, (const unsigned char*)bottom_blob.channel(q), size);
+            outptr += size;
+        }
+    }
+
+    Option opt_b = opt;
+    opt_b.blob_allocator = opt.workspace_allocator;
+
+    Mat top_blob_stacked;
+    int ret = forward(bottom_blob_stacked, top_blob_stacked, opt_b);
+    if (ret != 0)
+        return ret;
+
+    const int outw = top_blob_stacked.w;
+    const int outc = top_blob_stacked.c;
+    const size_t out_elemsize = top_blob_stacked.elemsize;
+    const int out_elempack = top_blob_stacked.elempack;
+
+    top_blobs.resize(batch);
+    for (int b = 0; b < batch; b++)
+    {
+        top_blobs[b].create(outw, bottom_blobs[b].h, outc, out_elemsize, out_elempack, opt.blob_allocator);
+        if (top_blobs[b].empty())
+            return -100;
+    }
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < outc; q++)
+    {
+        const unsigned char* ptr = top_blob_stacked.channel(q);
+
+        for (int b = 0; b < batch; b++)
+        {
+            Mat& top_blob = top_blobs[b];
+            const size_t size = (size_t)outw * top_blob.h * out_elemsize;
+
+            memcpy((unsigned char*)top_blob.channel(q), ptr, size);
+            ptr += size;
+        }
+    }
+
+    return 0;
+}
+
 #if NCNN_INT8
 static inline signed char float2int8(float v)
 {
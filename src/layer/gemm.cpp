@@ -16,6 +16,16 @@
 
 namespace ncnn {
 
+#if NCNN_INT8
+static inline signed char float2int8(float v)
+{
+    int int32 = static_cast<int>(round(v));
+    if (int32 > 127) return 127;
+    if (int32 < -127) return -127;
+    return (signed char)int32;
+}
+#endif // NCNN_INT8
+
 Gemm::Gemm()
 {
     one_blob_only = false;
@@ -39,6 +49,7 @@ int Gemm::load_param(const ParamDict& pd)
     output_elempack = pd.get(12, 0);
     output_elemtype = pd.get(13, 0);
     output_transpose = pd.get(14, 0);
+    int8_scale_term = pd.get(18, 0);
     constant_TILE_M = pd.get(20, 0);
     constant_TILE_N = pd.get(21, 0);
     constant_TILE_K = pd.get(22, 0);
@@ -61,6 +72,16 @@ int Gemm::load_param(const ParamDict& pd)
         return -1;
     }
 
+    if (int8_scale_term)
+    {
+#if NCNN_INT8
+        support_int8_storage = true;
+#else
+        NCNN_LOGE("please build ncnn with NCNN_INT8 enabled for int8 inference");
+        return -1;
+#endif
+    }
+
     if (constantA == 0 && constantB == 1 && constantC == 1)
         one_blob_only = true;
 
@@ -70,6 +91,13 @@ int Gemm::load_param(const ParamDict& pd)
     if (constantA == 1 && constantB == 1 && constantC == 0)
         one_blob_only = true;
 
+    // rows of A are independent when B is constant and C does not vary along M
+    // so that samples could be stacked along M
+    if (one_blob_only && constantA == 0 && constantB == 1 && transA == 0 && output_transpose == 0 && output_N1M == 0)
+    {
+        support_batch = constant_broadcast_type_C == -1 || constant_broadcast_type_C == 0 || constant_broadcast_type_C == 4;
+    }
+
     return 0;
 }
 
@@ -111,6 +139,105 @@ int Gemm::load_model(const ModelBin& mb)
             return -100;
     }
 
+#if NCNN_INT8
+    if (int8_scale_term)
+    {
+        if (constantA == 1)
+        {
+            A_data_int8_scales = mb.load(constantM, 1);
+            if (A_data_int8_scales.empty())
+                return -100;
+        }
+
+        if (constantB == 1)
+        {
+            Mat B_data_int8_scales = mb.load(1, 1);
+            if (B_data_int8_scales.empty())
+                return -100;
+
+            B_data_int8_scale = B_data_int8_scales[0];
+        }
+
+        if (int8_scale_term == 3)
+        {
+            // calibrated scales of the non-constant inputs
+            if (constantA == 0)
+            {
+                A_data_int8_scales = mb.load(1, 1);
+                if (A_data_int8_scales.empty())
+                    return -100;
+            }
+
+            if (constantB == 0)
+            {
+                Mat B_data_int8_scales = mb.load(1, 1);
+                if (B_data_int8_scales.empty())
+                    return -100;
+
+                B_data_int8_scale = B_data_int8_scales[0];
+            }
+        }
+    }
+#endif // NCNN_INT8
+
+    return 0;
+}
+
+int Gemm::create_pipeline(const Option& opt)
+{
+#if NCNN_INT8
+    if (!opt.use_int8_inference || !int8_scale_term)
+        return 0;
+
+    // runtime quantize the constant A
+    if (constantA == 1 && A_data.elemsize == (size_t)4u)
+    {
+        Mat A_data_int8;
+        if (transA == 0)
+        {
+            Option opt_q;
+            opt_q.num_threads = 1;
+            opt_q.use_packing_layout = false;
+            quantize_to_int8(A_data, A_data_int8, A_data_int8_scales, opt_q);
+        }
+        else
+        {
+            // the scale goes along w for transposed A
+            A_data_int8.create(constantM, constantK, (size_t)1u);
+            if (!A_data_int8.empty())
+            {
+                for (int k = 0; k < constantK; k++)
+                {
+                    const float* ptr = A_data.row(k);
+                    signed char* outptr = A_data_int8.row<signed char>(k);
+                    for (int i = 0; i < constantM; i++)
+                    {
+                        outptr[i] = float2int8(ptr[i] * A_data_int8_scales[i]);
+                    }
+                }
+            }
+        }
+        if (A_data_int8.empty())
+            return -100;
+
+        A_data = A_data_int8;
+    }
+
+    // runtime quantize the constant B
+    if (constantB == 1 && B_data.elemsize == (size_t)4u)
+    {
+        Mat B_data_int8;
+        Option opt_q;
+        opt_q.num_threads = 1;
+        opt_q.use_packing_layout = false;
+        quantize_to_int8(B_data, B_data_int8, Mat(1, (void*)&B_data_int8_scale), opt_q);
+        if (B_data_int8.empty())
+            return -100;
+
+        B_data = B_data_int8;
+    }
+#endif // NCNN_INT8
+
     return 0;
 }
 
@@ -123,8 +250,95 @@ int Gemm::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) cons
     return ret;
 }
 
+int Gemm::forward_batch(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+{
+    const int batch = (int)bottom_blobs.size();
+    const size_t elemsize = bottom_blobs[0].elemsize / bottom_blobs[0].elempack;
+
+    int total_M = 0;
+    for (int b = 0; b < batch; b++)
+    {
+        const Mat& A = bottom_blobs[b];
+        if (A.dims != 2 || A.w != constantK || A.elemsize / A.elempack != elemsize)
+            return Layer::forward_batch(bottom_blobs, top_blobs, opt);
+
+        total_M += A.h * A.elempack;
+    }
+
+    Option opt_b = opt;
+    opt_b.blob_allocator = opt.workspace_allocator;
+
+    // stack samples along M, the whole batch goes through one gemm
+    Mat A_stacked(constantK, total_M, elemsize, opt.workspace_allocator);
+    if (A_stacked.empty())
+        return -100;
+
+    unsigned char* outptr = A_stacked;
+    for (int b = 0; b < batch; b++)
+    {
+        Mat A = bottom_blobs[b];
+        if (A.elempack != 1)
+        {
+            Mat A_unpacked;
+            convert_packing(A, A_unpacked, 1, opt_b);
+            if (A_unpacked.empty())
+                return -100;
+
+            A = A_unpacked;
+        }
+
+        const size_t size = (size_t)A.w * A.h * elemsize;
+        memcpy(outptr, A.data, size);
+        outptr += size;
+    }
+
+    Mat top_blob_stacked;
+    int ret = forward(A_stacked, top_blob_stacked, opt_b);
+    if (ret != 0)
+        return ret;
+
+    if (top_blob_stacked.elempack != 1)
+    {
+        Mat top_blob_unpacked;
+        convert_packing(top_blob_stacked, top_blob_unpacked, 1, opt_b);
+        if (top_blob_unpacked.empty())
+            return -100;
+
+        top_blob_stacked = top_blob_unpacked;
+    }
+
+    const int N = top_blob_stacked.w;
+    const size_t out_elemsize = top_blob_stacked.elemsize;
+
+    top_blobs.resize(batch);
+
+    const unsigned char* ptr = top_blob_stacked;
+    for (int b = 0; b < batch; b++)
+    {
+        const int M = bottom_blobs[b].h * bottom_blobs[b].elempack;
+
+        Mat& top_blob = top_blobs[b];
+        top_blob.create(N, M, out_elemsize, opt.blob_allocator);
+        if (top_blob.empty())
+            return -100;
+
+        const size_t size = (size_t)N * M * out_elemsize;
+        memcpy(top_blob.data, ptr, size);
+        ptr += size;
+    }
+
+    return 0;
+}
+
 int Gemm::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
 {
+#if NCNN_INT8
+    if (opt.use_int8_inference && int8_scale_term)
+    {
+        return forward_int8(bottom_blobs, top_blobs, opt);
+    }
+#endif
+
     const Mat& A0 = constantA ? A_data : bottom_blobs[0];
     const Mat& B0 = constantB ? B_data : constantA ? bottom_blobs[0] : bottom_blobs[1];
 
@@ -322,4 +536,266 @@ int Gemm::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_bl
     return 0;
 }
 
+#if NCNN_INT8
+int Gemm::forward_int8(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+{
+    const Mat& A0 = constantA ? A_data : bottom_blobs[0];
+    const Mat& B0 = constantB ? B_data : constantA ? bottom_blobs[0] : bottom_blobs[1];
+
+    const int A0_hstep = A0.dims == 3 ? (int)A0.cstep : A0.w;
+    const int B0_hstep = B0.dims == 3 ? (int)B0.cstep : B0.w;
+
+    const int M = transA ? A0.w : (A0.dims == 3 ? A0.c : A0.h);
+    const int K = transA ? (A0.dims == 3 ? A0.c : A0.h) : A0.w;
+    const int N = transB ? (B0.dims == 3 ? B0.c : B0.h) : B0.w;
+
+    // quantize A to row-major int8 with per-row scales
+    Mat A(K, M, (size_t)1u, opt.workspace_allocator);
+    Mat A_int8_scales(M, (size_t)4u, opt.workspace_allocator);
+    if (A.empty() || A_int8_scales.empty())
+        return -100;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int i = 0; i < M; i++)
+    {
+        signed char* outptr = A.row<signed char>(i);
+
+        if (constantA)
+        {
+            const signed char* ptr = A0;
+            for (int k = 0; k < K; k++)
+            {
+                outptr[k] = transA ? ptr[k * A0_hstep + i] : ptr[i * A0_hstep + k];
+            }
+
+            A_int8_scales[i] = A_data_int8_scales[i];
+            continue;
+        }
+
+        const float* ptr = A0;
+
+        float scale;
+        if (int8_scale_term == 3)
+        {
+            scale = A_data_int8_scales[0];
+        }
+        else
+        {
+            float absmax = 0.f;
+            for (int k = 0; k < K; k++)
+            {
+                const float v = transA ? ptr[k * A0_hstep + i] : ptr[i * A0_hstep + k];
+                absmax = std::max(absmax, (float)fabs(v));
+            }
+
+            scale = absmax == 0.f ? 1.f : 127.f / absmax;
+        }
+
+        for (int k = 0; k < K; k++)
+        {
+            const float v = transA ? ptr[k * A0_hstep + i] : ptr[i * A0_hstep + k];
+            outptr[k] = float2int8(v * scale);
+        }
+
+        A_int8_scales[i] = scale;
+    }
+
+    // quantize B to col-major int8 with one scale
+    Mat B(K, N, (size_t)1u, opt.workspace_allocator);
+    if (B.empty())
+        return -100;
+
+    float B_int8_scale;
+    if (constantB || int8_scale_term == 3)
+    {
+        B_int8_scale = B_data_int8_scale;
+    }
+    else
+    {
+        const float* ptr = B0;
+
+        float absmax = 0.f;
+        for (int k = 0; k < (transB ? N : K); k++)
+        {
+            for (int j = 0; j < (transB ? K : N); j++)
+            {
+                absmax = std::max(absmax, (float)fabs(ptr[k * B0_hstep + j]));
+            }
+        }
+
+        B_int8_scale = absmax == 0.f ? 1.f : 127.f / absmax;
+    }
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int j = 0; j < N; j++)
+    {
+        signed char* outptr = B.row<signed char>(j);
+
+        if (constantB)
+        {
+            const signed char* ptr = B0;
+            for (int k = 0; k < K; k++)
+            {
+                outptr[k] = transB ? ptr[j * B0_hstep + k] : ptr[k * B0_hstep + j];
+            }
+        }
+        else
+        {
+            const float* ptr = B0;
+            for (int k = 0; k < K; k++)
+            {
+                const float v = transB ? ptr[j * B0_hstep + k] : ptr[k * B0_hstep + j];
+                outptr[k] = float2int8(v * B_int8_scale);
+            }
+        }
+    }
+
+    const float* ptrC = 0;
+    int broadcast_type_C = 0;
+    if (constantC)
+    {
+        ptrC = C_data;
+        broadcast_type_C = constant_broadcast_type_C;
+    }
+    else
+    {
+        if (constantA && constantB)
+        {
+            ptrC = bottom_blobs.size() == 1 ? bottom_blobs[0] : 0;
+        }
+        else if (constantA)
+        {
+            ptrC = bottom_blobs.size() == 2 ? bottom_blobs[1] : 0;
+        }
+        else if (constantB)
+        {
+            ptrC = bottom_blobs.size() == 2 ? bottom_blobs[1] : 0;
+        }
+        else
+        {
+            ptrC = bottom_blobs.size() == 3 ? bottom_blobs[2] : 0;
+        }
+
+        if (ptrC)
+        {
+            const Mat& C = bottom_blobs[bottom_blobs.size() - 1];
+
+            if (C.dims == 1 && C.w == 1)
+            {
+                // scalar
+                broadcast_type_C = 0;
+            }
+            if (C.dims == 1 && C.w == M)
+            {
+                // M
+                // auto broadcast from h to w is the ncnn-style convention
+                broadcast_type_C = 1;
+            }
+            if (C.dims == 1 && C.w == N)
+            {
+                // N
+                broadcast_type_C = 4;
+            }
+            if (C.dims == 2 && C.w == 1 && C.h == M)
+            {
+                // Mx1
+                broadcast_type_C = 2;
+            }
+            if (C.dims == 2 && C.w == N && C.h == M)
+            {
+                // MxN
+                broadcast_type_C = 3;
+            }
+            if (C.dims == 2 && C.w == N && C.h == 1)
+            {
+                // 1xN
+                broadcast_type_C = 4;
+            }
+        }
+    }
+
+    Mat& top_blob = top_blobs[0];
+    if (output_transpose)
+    {
+        if (output_N1M)
+            top_blob.create(M, 1, N, 4u, opt.blob_allocator);
+        else
+            top_blob.create(M, N, 4u, opt.blob_allocator);
+    }
+    else
+    {
+        if (output_N1M)
+            top_blob.create(N, 1, M, 4u, opt.blob_allocator);
+        else
+            top_blob.create(N, M, 4u, opt.blob_allocator);
+    }
+    if (top_blob.empty())
+        return -100;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int i = 0; i < M; i++)
+    {
+        const int out_hstep = top_blob.dims == 3 ? (int)top_blob.cstep : top_blob.w;
+
+        const signed char* ptrA = A.row<const signed char>(i);
+
+        // dequantize
+        const float descale = 1.f / (A_int8_scales[i] * B_int8_scale);
+
+        for (int j = 0; j < N; j++)
+        {
+            const signed char* ptrB = B.row<const signed char>(j);
+
+            int sum = 0;
+            for (int k = 0; k < K; k++)
+            {
+                sum += ptrA[k] * ptrB[k];
+            }
+
+            float sumfp32 = sum * descale;
+
+            if (ptrC)
+            {
+                float c = 0.f;
+                if (broadcast_type_C == 0)
+                {
+                    c = ptrC[0];
+                }
+                if (broadcast_type_C == 1)
+                {
+                    c = ptrC[i];
+                }
+                if (broadcast_type_C == 2)
+                {
+                    c = ptrC[i];
+                }
+                if (broadcast_type_C == 3)
+                {
+                    c = ptrC[i * N + j];
+                }
+                if (broadcast_type_C == 4)
+                {
+                    c = ptrC[j];
+                }
+
+                sumfp32 += c * beta;
+            }
+
+            sumfp32 *= alpha;
+
+            if (output_transpose)
+            {
+                top_blob[j * out_hstep + i] = sumfp32;
+            }
+            else
+            {
+                top_blob[i * out_hstep + j] = sumfp32;
+            }
+        }
+    }
+
+    return 0;
+}
+#endif // NCNN_INT8
+
 } // namespace ncnn
@@ -28,10 +28,19 @@ public:
 
     virtual int load_model(const ModelBin& mb);
 
+    virtual int create_pipeline(const Option& opt);
+
     virtual int forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
 
     virtual int forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const;
 
+    virtual int forward_batch(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const;
+
+protected:
+#if NCNN_INT8
+    int forward_int8(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const;
+#endif
+
 public:
     float alpha;
     float beta;
@@ -50,6 +59,11 @@ public:
     int output_elemtype; // 0=auto 1=fp32
     int output_transpose;
 
+    // 0=fp32
+    // 2=int8, constant A/B are int8, inputs are quantized dynamically
+    // 3=int8, inputs are quantized with the calibrated scales
+    int int8_scale_term;
+
     int constant_TILE_M;
     int constant_TILE_N;
     int constant_TILE_K;
@@ -58,6 +72,13 @@ public:
     Mat A_data;
     Mat B_data;
     Mat C_data;
+
+#if NCNN_INT8
+    // per-row scales of constant A, or the calibrated scale of input A
+    Mat A_data_int8_scales;
+    // scale of constant B, or the calibrated scale of input B
+    float B_data_int8_scale;
+#endif
 };
 
 } // namespace ncnn
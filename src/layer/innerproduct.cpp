@@ -35,6 +35,9 @@ int InnerProduct::load_param(const ParamDict& pd)
     activation_type = pd.get(9, 0);
     activation_params = pd.get(10, Mat());
 
+    // 1d samples could be stacked into the rows of one 2d blob
+    support_batch = true;
+
     if (int8_scale_term)
     {
 #if NCNN_INT8
@@ -174,6 +177,65 @@ int InnerProduct::forward(const Mat& bottom_blob, Mat& top_blob, const Option& o
     return 0;
 }
 
+int InnerProduct::forward_batch(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+{
+    const int num_input = weight_data_size / num_output;
+
+    const int batch = (int)bottom_blobs.size();
+    const size_t elemsize = bottom_blobs[0].elemsize / bottom_blobs[0].elempack;
+
+    // packed 1d blob shares the same memory layout as the unpacked one
+    for (int b = 0; b < batch; b++)
+    {
+        const Mat& bottom_blob = bottom_blobs[b];
+        if (bottom_blob.dims != 1 || bottom_blob.w * bottom_blob.elempack != num_input || bottom_blob.elemsize / bottom_blob.elempack != elemsize)
+            return Layer::forward_batch(bottom_blobs, top_blobs, opt);
+    }
+
+    // stack samples as rows, the whole batch goes through the gemm path
+    Mat bottom_blob_stacked(num_input, batch, elemsize, opt.workspace_allocator);
+    if (bottom_blob_stacked.empty())
+        return -100;
+
+    for (int b = 0; b < batch; b++)
+    {
+        memcpy(bottom_blob_stacked.row<unsigned char>(b), bottom_blobs[b].data, num_input * elemsize);
+    }
+
+    Option opt_b = opt;
+    opt_b.blob_allocator = opt.workspace_allocator;
+
+    Mat top_blob_stacked;
+    int ret = forward(bottom_blob_stacked, top_blob_stacked, opt_b);
+    if (ret != 0)
+        return ret;
+
+    if (top_blob_stacked.elempack != 1)
+    {
+        Mat top_blob_unpacked;
+        convert_packing(top_blob_stacked, top_blob_unpacked, 1, opt_b);
+        if (top_blob_unpacked.empty())
+            return -100;
+
+        top_blob_stacked = top_blob_unpacked;
+    }
+
+    const size_t out_elemsize = top_blob_stacked.elemsize;
+
+    top_blobs.resize(batch);
+    for (int b = 0; b < batch; b++)
+    {
+        Mat& top_blob = top_blobs[b];
+        top_blob.create(num_output, out_elemsize, opt.blob_allocator);
+        if (top_blob.empty())
+            return -100;
+
+        memcpy(top_blob.data, top_blob_stacked.row<const unsigned char>(b), num_output * out_elemsize);
+    }
+
+    return 0;
+}
+
 #if NCNN_INT8
 int InnerProduct::forward_int8(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
 {
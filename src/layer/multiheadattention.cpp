@@ -15,6 +15,7 @@
 #include "multiheadattention.h"
 
 #include <float.h>
+#include <string.h>
 
 namespace ncnn {
 
@@ -31,6 +32,7 @@ int MultiHeadAttention::load_param(const ParamDict& pd)
     vdim = pd.get(4, embed_dim);
     attn_mask = pd.get(5, 0);
     scale = pd.get(6, 1.f / sqrtf(embed_dim / num_heads));
+    kv_cache = pd.get(7, 0);
 
     return 0;
 }
@@ -77,13 +79,26 @@ int MultiHeadAttention::load_model(const ModelBin& mb)
 // refers to https://pytorch.org/docs/stable/generated/torch.nn.MultiheadAttention.html
 int MultiHeadAttention::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
 {
+    const int input_count = kv_cache ? (int)bottom_blobs.size() - 2 : (int)bottom_blobs.size();
+
     const Mat& q_blob = bottom_blobs[0];
-    const Mat& k_blob = (bottom_blobs.size() == 1 || (bottom_blobs.size() == 2 && attn_mask)) ? q_blob : bottom_blobs[1];
-    const Mat& v_blob = (bottom_blobs.size() == 1 || (bottom_blobs.size() == 2 && attn_mask)) ? q_blob : (bottom_blobs.size() == 2 || (bottom_blobs.size() == 3 && attn_mask)) ? k_blob : bottom_blobs[2];
-    const Mat& attn_mask_blob = attn_mask ? bottom_blobs[bottom_blobs.size() - 1] : Mat();
+    const Mat& k_blob = (input_count == 1 || (input_count == 2 && attn_mask)) ? q_blob : bottom_blobs[1];
+    const Mat& v_blob = (input_count == 1 || (input_count == 2 && attn_mask)) ? q_blob : (input_count == 2 || (input_count == 3 && attn_mask)) ? k_blob : bottom_blobs[2];
+    const Mat& attn_mask_blob = attn_mask ? bottom_blobs[input_count - 1] : Mat();
+    const Mat& past_k_blob = kv_cache ? bottom_blobs[input_count] : Mat();
+    const Mat& past_v_blob = kv_cache ? bottom_blobs[input_count + 1] : Mat();
+
+    // the past caches are empty or zero sized on the first decoding step
+    const int past_seqlen = past_k_blob.empty() ? 0 : past_k_blob.w;
+    if (past_seqlen != 0 && (past_k_blob.h != embed_dim || past_v_blob.w != past_seqlen || past_v_blob.h != embed_dim))
+    {
+        NCNN_LOGE("MultiHeadAttention kv cache shape mismatch %d x %d, %d x %d", past_k_blob.w, past_k_blob.h, past_v_blob.w, past_v_blob.h);
+        return -1;
+    }
 
     const int src_seqlen = q_blob.h;
-    const int dst_seqlen = k_blob.h;
+    const int cur_seqlen = k_blob.h;
+    const int dst_seqlen = past_seqlen + cur_seqlen;
     const int embed_dim_per_head = embed_dim / num_heads;
     const int qdim = weight_data_size / embed_dim;
 
@@ -94,6 +109,17 @@ int MultiHeadAttention::forward(const std::vector<Mat>& bottom_blobs, std::vecto
     if (top_blob.empty())
         return -100;
 
+    if (kv_cache)
+    {
+        top_blobs[1].create(dst_seqlen, embed_dim, 4u, opt.blob_allocator);
+        if (top_blobs[1].empty())
+            return -100;
+
+        top_blobs[2].create(dst_seqlen, embed_dim, 4u, opt.blob_allocator);
+        if (top_blobs[2].empty())
+            return -100;
+    }
+
     Mat xq(embed_dim_per_head, src_seqlen, num_heads, 4u, opt.workspace_allocator);
     if (xq.empty())
         return -100;
@@ -139,14 +165,24 @@ int MultiHeadAttention::forward(const std::vector<Mat>& bottom_blobs, std::vecto
             }
         }
 
-        // xk = affine(k)
+        // xk = concat(past_k, affine(k))
         {
             Mat outm = xk.channel(q);
 
-            for (int i = 0; i < dst_seqlen; i++)
+            for (int i = 0; i < past_seqlen; i++)
             {
                 float* outptr = outm.row(i);
 
+                for (int j = 0; j < embed_dim_per_head; j++)
+                {
+                    outptr[j] = past_k_blob.row(q * embed_dim_per_head + j)[i];
+                }
+            }
+
+            for (int i = 0; i < cur_seqlen; i++)
+            {
+                float* outptr = outm.row(past_seqlen + i);
+
                 for (int j = 0; j < embed_dim_per_head; j++)
                 {
                     const float* ptr = k_blob.row(i);
@@ -163,13 +199,23 @@ int MultiHeadAttention::forward(const std::vector<Mat>& bottom_blobs, std::vecto
             }
         }
 
-        // xv = affine(v)
+        // xv = concat(past_v, affine(v))
         {
             Mat outm = xv.channel(q);
 
             for (int i = 0; i < embed_dim_per_head; i++)
             {
-                for (int j = 0; j < dst_seqlen; j++)
+                float* outptr = outm.row(i);
+
+                for (int j = 0; j < past_seqlen; j++)
+                {
+                    outptr[j] = past_v_blob.row(q * embed_dim_per_head + i)[j];
+                }
+            }
+
+            for (int i = 0; i < embed_dim_per_head; i++)
+            {
+                for (int j = 0; j < cur_seqlen; j++)
                 {
                     const float* ptr = v_blob.row(j);
                     const float* kptr = (const float*)v_weight_data + vdim * (q * embed_dim_per_head + i);
@@ -182,7 +228,26 @@ int MultiHeadAttention::forward(const std::vector<Mat>& bottom_blobs, std::vecto
 
                     float* outptr = outm.row(i);
 
-                    outptr[j] = sum;
+                    outptr[past_seqlen + j] = sum;
+                }
+            }
+        }
+
+        // new_k = xk, new_v = xv
+        if (kv_cache)
+        {
+            const Mat xkm = xk.channel(q);
+            const Mat xvm = xv.channel(q);
+
+            for (int i = 0; i < embed_dim_per_head; i++)
+            {
+                float* kcptr = top_blobs[1].row(q * embed_dim_per_head + i);
+                float* vcptr = top_blobs[2].row(q * embed_dim_per_head + i);
+
+                for (int j = 0; j < dst_seqlen; j++)
+                {
+                    kcptr[j] = xkm.row(j)[i];
+                    vcptr[j] = xvm.row(i)[j];
                 }
             }
         }
@@ -316,4 +381,51 @@ int MultiHeadAttention::forward(const std::vector<Mat>& bottom_blobs, std::vecto
     return 0;
 }
 
+int MultiHeadAttention::concat_kv_cache(const Mat& past_blob, const Mat& cur_blob, Mat& cache_blob, const Option& opt)
+{
+    // the past cache is empty or zero sized on the first decoding step
+    if (past_blob.empty())
+    {
+        cache_blob = cur_blob;
+        return 0;
+    }
+
+    Mat past_blob_unpacked;
+    if (past_blob.elempack != 1)
+    {
+        convert_packing(past_blob, past_blob_unpacked, 1, opt);
+        if (past_blob_unpacked.empty())
+            return -100;
+    }
+    else
+    {
+        past_blob_unpacked = past_blob;
+    }
+
+    if (past_blob_unpacked.h != cur_blob.h || past_blob_unpacked.elemsize != cur_blob.elemsize)
+    {
+        NCNN_LOGE("MultiHeadAttention kv cache shape mismatch %d x %d", past_blob_unpacked.w, past_blob_unpacked.h);
+        return -1;
+    }
+
+    const int past_seqlen = past_blob_unpacked.w;
+    const int cur_seqlen = cur_blob.w;
+    const size_t elemsize = cur_blob.elemsize;
+
+    cache_blob.create(past_seqlen + cur_seqlen, cur_blob.h, elemsize, opt.blob_allocator);
+    if (cache_blob.empty())
+        return -100;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int i = 0; i < cur_blob.h; i++)
+    {
+        unsigned char* outptr = cache_blob.row<unsigned char>(i);
+
+        memcpy(outptr, past_blob_unpacked.row<const unsigned char>(i), past_seqlen * elemsize);
+        memcpy(outptr + past_seqlen * elemsize, cur_blob.row<const unsigned char>(i), cur_seqlen * elemsize);
+    }
+
+    return 0;
+}
+
 } // namespace ncnn
@@ -30,6 +30,10 @@ public:
 
     virtual int forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const;
 
+protected:
+    // append the projected keys or values of this step to the past cache, for the optimized kv_cache path
+    static int concat_kv_cache(const Mat& past_blob, const Mat& cur_blob, Mat& cache_blob, const Option& opt);
+
 public:
     int embed_dim;
     int num_heads;
@@ -39,6 +43,12 @@ public:
     int attn_mask;
     float scale;
 
+    // incremental decoding, past key and value caches are the last two inputs
+    // and the updated caches are the second and third outputs
+    // cache blob is w = seqlen, h = embed_dim, holding the projected keys or values
+    // feed zero sized Mat(0, embed_dim) as the past caches on the first step
+    int kv_cache;
+
     Mat q_weight_data;
     Mat q_bias_data;
     Mat k_weight_data;
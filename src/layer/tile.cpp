@@ -138,7 +138,7 @@ int Tile::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) cons
         if (outdims == 4)
             top_blob.create(w * repeat_w, h * repeat_h, d, channels * repeat_c, elemsize, opt.blob_allocator);
     }
-    else if (repeat_d != 1 && repeat_c != 1)
+    else if (repeat_d != 1)
     {
         if (outdims == 4)
             top_blob.create(w * repeat_w, h * repeat_h, d * repeat_d, channels * repeat_c, elemsize, opt.blob_allocator);
@@ -26,6 +26,8 @@
 #endif // __AVX__
 #endif // __SSE2__
 
+#include "x86_usability.h"
+
 namespace ncnn {
 
 BinaryOp_x86::BinaryOp_x86()
@@ -33,6 +35,9 @@ BinaryOp_x86::BinaryOp_x86()
 #if __SSE2__
     support_packing = true;
 #endif // __SSE2__
+#if NCNN_BF16
+    support_bf16_storage = true;
+#endif
 }
 
 template<typename Op>
@@ -811,6 +816,62 @@ static void binary_op_vector(const float* ptr, const float* ptr1, float* outptr,
     // should never reach here
 }
 
+#if NCNN_BF16
+static void binary_op_vector(const unsigned short* ptr, const unsigned short* ptr1, unsigned short* outptr, int aw, int bw, int ap, int bp, int op_type)
+{
+    // widen a run of positions of both operands, apply the fp32 kernel and narrow the result
+    const int w = std::max(aw, bw);
+    const int elempack = std::max(ap, bp);
+    const int tile_w = 256 / elempack;
+
+    float tmp[256];
+    float tmp1[256];
+    float tmpout[256];
+
+    for (int x = 0; x < w; x += tile_w)
+    {
+        const int n = std::min(w - x, tile_w);
+        const int an = aw == 1 ? 1 : n;
+        const int bn = bw == 1 ? 1 : n;
+
+        bfloat2float_row(aw == 1 ? ptr : ptr + x * ap, tmp, an * ap);
+        bfloat2float_row(bw == 1 ? ptr1 : ptr1 + x * bp, tmp1, bn * bp);
+
+        binary_op_vector(tmp, tmp1, tmpout, an, bn, ap, bp, op_type);
+
+        float2bfloat_row(tmpout, outptr + x * elempack, n * elempack);
+    }
+}
+
+static void binary_op_vector(const unsigned short* ptr, const float* ptr1, unsigned short* outptr, int size, int bw, int ap, int bp, int op_type)
+{
+    // bf16 a with a fp32 scalar b
+    float tmp[256];
+
+    for (int x = 0; x < size; x += 256)
+    {
+        const int n = std::min(size - x, 256);
+
+        bfloat2float_row(ptr + x, tmp, n);
+
+        binary_op_vector(tmp, ptr1, tmp, n, bw, ap, bp, op_type);
+
+        float2bfloat_row(tmp, outptr + x, n);
+    }
+}
+#endif // NCNN_BF16
+
+static float binary_op_scalar_value(const Mat& b)
+{
+#if NCNN_BF16
+    if (b.elembits() == 16)
+        return bfloat16_to_float32(((const unsigned short*)b.data)[0]);
+#endif // NCNN_BF16
+
+    return b[0];
+}
+
+template<typename T>
 static void binary_op_scalar(const Mat& a, float b, Mat& c, int op_type, const Option& opt)
 {
     const int channels = a.c;
@@ -819,13 +880,14 @@ static void binary_op_scalar(const Mat& a, float b, Mat& c, int op_type, const O
     #pragma omp parallel for num_threads(opt.num_threads)
     for (int q = 0; q < channels; q++)
     {
-        const float* ptr = a.channel(q);
-        float* outptr = c.channel(q);
+        const T* ptr = a.channel(q);
+        T* outptr = c.channel(q);
 
         binary_op_vector(ptr, &b, outptr, size, 1, 1, 1, op_type);
     }
 }
 
+template<typename T>
 static void binary_op_no_broadcast(const Mat& a, const Mat& b, Mat& c, int op_type, const Option& opt)
 {
     const int channels = a.c;
@@ -834,24 +896,25 @@ static void binary_op_no_broadcast(const Mat& a, const Mat& b, Mat& c, int op_ty
     #pragma omp parallel for num_threads(opt.num_threads)
     for (int q = 0; q < channels; q++)
     {
-        const float* ptr = a.channel(q);
-        const float* ptr1 = b.channel(q);
-        float* outptr = c.channel(q);
+        const T* ptr = a.channel(q);
+        const T* ptr1 = b.channel(q);
+        T* outptr = c.channel(q);
 
         binary_op_vector(ptr, ptr1, outptr, size, size, 1, 1, op_type);
     }
 }
 
+template<typename T>
 static void binary_op_broadcast(const Mat& a, const Mat& b, Mat& c, int op_type, const Option& opt)
 {
     if (b.w * b.h * b.d * b.c * b.elempack == 1)
     {
-        return binary_op_scalar(a, b[0], c, op_type, opt);
+        return binary_op_scalar<T>(a, binary_op_scalar_value(b), c, op_type, opt);
     }
 
     if (a.dims == b.dims && a.w == b.w && a.h == b.h && a.d == b.d && a.c == b.c && a.elempack == b.elempack)
     {
-        return binary_op_no_broadcast(a, b, c, op_type, opt);
+        return binary_op_no_broadcast<T>(a, b, c, op_type, opt);
     }
 
     const int dims = c.dims;
@@ -866,9 +929,9 @@ static void binary_op_broadcast(const Mat& a, const Mat& b, Mat& c, int op_type,
             const int y0 = std::min(y, a.h - 1);
             const int y1 = std::min(y, b.h - 1);
 
-            const float* ptr = a.row(y0);
-            const float* ptr1 = b.row(y1);
-            float* outptr = c.row(y);
+            const T* ptr = a.row<const T>(y0);
+            const T* ptr1 = b.row<const T>(y1);
+            T* outptr = c.row<T>(y);
 
             binary_op_vector(ptr, ptr1, outptr, a.w, b.w, a.elempack, b.elempack, op_type);
         }
@@ -886,9 +949,9 @@ static void binary_op_broadcast(const Mat& a, const Mat& b, Mat& c, int op_type,
 
             if (b.d * b.h * b.w == 1)
             {
-                const float* ptr = a.channel(q0);
-                const float* ptr1 = b.channel(q1);
-                float* outptr = c.channel(q);
+                const T* ptr = a.channel(q0);
+                const T* ptr1 = b.channel(q1);
+                T* outptr = c.channel(q);
 
                 binary_op_vector(ptr, ptr1, outptr, a.w * a.h * a.d, 1, a.elempack, b.elempack, op_type);
                 continue;
@@ -901,9 +964,9 @@ static void binary_op_broadcast(const Mat& a, const Mat& b, Mat& c, int op_type,
                     const int z0 = std::min(z, a.d - 1);
                     const int z1 = std::min(z, b.d - 1);
 
-                    const float* ptr = a.channel(q0).depth(z0);
-                    const float* ptr1 = b.channel(q1).depth(z1);
-                    float* outptr = c.channel(q).depth(z);
+                    const T* ptr = a.channel(q0).depth(z0);
+                    const T* ptr1 = b.channel(q1).depth(z1);
+                    T* outptr = c.channel(q).depth(z);
 
                     binary_op_vector(ptr, ptr1, outptr, a.w * a.h, 1, a.elempack, b.elempack, op_type);
                 }
@@ -920,9 +983,9 @@ static void binary_op_broadcast(const Mat& a, const Mat& b, Mat& c, int op_type,
                     const int y0 = std::min(y, a.h - 1);
                     const int y1 = std::min(y, b.h - 1);
 
-                    const float* ptr = a.channel(q0).depth(z0).row(y0);
-                    const float* ptr1 = b.channel(q1).depth(z1).row(y1);
-                    float* outptr = c.channel(q).depth(z).row(y);
+                    const T* ptr = a.channel(q0).depth(z0).row<const T>(y0);
+                    const T* ptr1 = b.channel(q1).depth(z1).row<const T>(y1);
+                    T* outptr = c.channel(q).depth(z).row<T>(y);
 
                     binary_op_vector(ptr, ptr1, outptr, a.w, b.w, a.elempack, b.elempack, op_type);
                 }
@@ -931,6 +994,7 @@ static void binary_op_broadcast(const Mat& a, const Mat& b, Mat& c, int op_type,
     }
 }
 
+template<typename T>
 static void binary_op_scalar_inplace(Mat& a, float b, int op_type, const Option& opt)
 {
     const int channels = a.c;
@@ -939,7 +1003,7 @@ static void binary_op_scalar_inplace(Mat& a, float b, int op_type, const Option&
     #pragma omp parallel for num_threads(opt.num_threads)
     for (int q = 0; q < channels; q++)
     {
-        float* ptr = a.channel(q);
+        T* ptr = a.channel(q);
 
         binary_op_vector(ptr, &b, ptr, size, 1, 1, 1, op_type);
     }
@@ -1092,24 +1156,41 @@ int BinaryOp_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>
     if (top_blob.empty())
         return -100;
 
+    int op_type_r = op_type;
+
     const bool a_pack_is_lower = A2.elempack < B2.elempack;
     const bool a_pack_is_equal = A2.elempack == B2.elempack;
     const bool a_size_is_lower = A2.w * A2.h * A2.d * A2.c * A2.elempack < B2.w * B2.h * B2.d * B2.c * B2.elempack;
     if (a_pack_is_lower || (a_pack_is_equal && a_size_is_lower))
     {
-        binary_op_broadcast(B2, A2, top_blob, get_reverse_op_type(op_type), opt);
+        std::swap(A2, B2);
+        op_type_r = get_reverse_op_type(op_type);
     }
-    else
+
+#if NCNN_BF16
+    if (opt.use_bf16_storage && top_blob.elembits() == 16)
     {
-        binary_op_broadcast(A2, B2, top_blob, op_type, opt);
+        binary_op_broadcast<unsigned short>(A2, B2, top_blob, op_type_r, opt);
+        return 0;
     }
+#endif // NCNN_BF16
+
+    binary_op_broadcast<float>(A2, B2, top_blob, op_type_r, opt);
 
     return 0;
 }
 
 int BinaryOp_x86::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
 {
-    binary_op_scalar_inplace(bottom_top_blob, b, op_type, opt);
+#if NCNN_BF16
+    if (opt.use_bf16_storage && bottom_top_blob.elembits() == 16)
+    {
+        binary_op_scalar_inplace<unsigned short>(bottom_top_blob, b, op_type, opt);
+        return 0;
+    }
+#endif // NCNN_BF16
+
+    binary_op_scalar_inplace<float>(bottom_top_blob, b, op_type, opt);
 
     return 0;
 }
@@ -21,6 +21,8 @@
 #endif // __AVX__
 #endif // __SSE2__
 
+#include "x86_activation.h"
+
 namespace ncnn {
 
 Clip_x86::Clip_x86()
@@ -28,10 +30,18 @@ Clip_x86::Clip_x86()
 #if __SSE2__
     support_packing = true;
 #endif // __SSE2__
+#if NCNN_BF16
+    support_bf16_storage = true;
+#endif
 }
 
 int Clip_x86::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
 {
+#if NCNN_BF16
+    if (opt.use_bf16_storage && bottom_top_blob.elembits() == 16)
+        return forward_inplace_bf16s(bottom_top_blob, opt);
+#endif
+
     int w = bottom_top_blob.w;
     int h = bottom_top_blob.h;
     int d = bottom_top_blob.d;
@@ -94,4 +104,16 @@ int Clip_x86::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
     return 0;
 }
 
+#if NCNN_BF16
+int Clip_x86::forward_inplace_bf16s(Mat& bottom_top_blob, const Option& opt) const
+{
+    Mat activation_params(2);
+    activation_params[0] = min;
+    activation_params[1] = max;
+    activation_inplace_bf16s(bottom_top_blob, 3, activation_params, opt);
+
+    return 0;
+}
+#endif // NCNN_BF16
+
 } //namespace ncnn
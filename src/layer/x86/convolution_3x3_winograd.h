@@ -3155,6 +3155,8 @@ static int conv3x3s1_winograd23(const Mat& bottom_blob, Mat& top_blob, const Mat
     int TILE_M, TILE_N, TILE_K;
     get_optimal_tile_mnk(M, N, K, TILE_M, TILE_N, TILE_K, nT);
 
+    nT = std::min(nT, opt.num_threads);
+
     const int nn_M = (M + TILE_M - 1) / TILE_M;
     const int nn_N = (N + TILE_N - 1) / TILE_N;
     const int nn_K = (K + TILE_K - 1) / TILE_K;
@@ -5007,6 +5009,8 @@ static int conv3x3s1_winograd43(const Mat& bottom_blob, Mat& top_blob, const Mat
     int TILE_M, TILE_N, TILE_K;
     get_optimal_tile_mnk(M, N, K, TILE_M, TILE_N, TILE_K, nT);
 
+    nT = std::min(nT, opt.num_threads);
+
     const int nn_M = (M + TILE_M - 1) / TILE_M;
     const int nn_N = (N + TILE_N - 1) / TILE_N;
     const int nn_K = (K + TILE_K - 1) / TILE_K;
@@ -7307,6 +7311,8 @@ static int conv3x3s1_winograd63(const Mat& bottom_blob, Mat& top_blob, const Mat
     int TILE_M, TILE_N, TILE_K;
     get_optimal_tile_mnk(M, N, K, TILE_M, TILE_N, TILE_K, nT);
 
+    nT = std::min(nT, opt.num_threads);
+
     const int nn_M = (M + TILE_M - 1) / TILE_M;
     const int nn_N = (N + TILE_N - 1) / TILE_N;
     const int nn_K = (K + TILE_K - 1) / TILE_K;
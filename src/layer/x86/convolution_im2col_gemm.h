@@ -4617,6 +4617,8 @@ static int convolution_im2col_gemm(const Mat& bottom_blob, Mat& top_blob, const
     int TILE_M, TILE_N, TILE_K;
     convolution_im2col_gemm_get_optimal_tile_mnk(M, N, K, TILE_M, TILE_N, TILE_K, nT);
 
+    nT = std::min(nT, opt.num_threads);
+
     const int nn_M = (M + TILE_M - 1) / TILE_M;
     const int nn_N = (N + TILE_N - 1) / TILE_N;
     const int nn_K = (K + TILE_K - 1) / TILE_K;
@@ -4647,6 +4649,14 @@ static int convolution_im2col_gemm(const Mat& bottom_blob, Mat& top_blob, const
         convolution_im2col_input_tile(bottom_blob, BT_tile, j, max_jj, k, max_kk, kernel_w, kernel_h, dilation_w, dilation_h, stride_w, stride_h);
     }
 
+    Mat ATX;
+    if (AT.elembits() == 16)
+    {
+        ATX.create(TILE_K * TILE_M, nn_K, nT, 4u, opt.workspace_allocator);
+        if (ATX.empty())
+            return -100;
+    }
+
     Mat topT_tileX;
     if (K > TILE_K)
     {
@@ -4666,6 +4676,20 @@ static int convolution_im2col_gemm(const Mat& bottom_blob, Mat& top_blob, const
 
         const int max_ii = std::min((M - i), TILE_M);
 
+        Mat AT_panel = AT.channel(i / TILE_M);
+        if (AT.elembits() == 16)
+        {
+            // widen the fp16 weight panel once, it is reused for every j tile
+            Mat AT_panel_fp32 = ATX.channel(get_omp_thread_num());
+            for (int k = 0; k < K; k += TILE_K)
+            {
+                const int max_kk = std::min((K - k), TILE_K);
+
+                float16_to_float32_row(AT_panel.row<const unsigned short>(k / TILE_K), AT_panel_fp32.row(k / TILE_K), max_ii * max_kk);
+            }
+            AT_panel = AT_panel_fp32;
+        }
+
         for (int j = 0; j < N; j += TILE_N)
         {
             const int max_jj = std::min((N - j), TILE_N);
@@ -4674,7 +4698,7 @@ static int convolution_im2col_gemm(const Mat& bottom_blob, Mat& top_blob, const
             {
                 const int max_kk = std::min((K - k), TILE_K);
 
-                const Mat AT_tile = AT.channel(i / TILE_M).row_range(k / TILE_K, 1);
+                const Mat AT_tile = AT_panel.row_range(k / TILE_K, 1);
 
                 const Mat BT_tile = BT.channel(j / TILE_N).row_range(k / TILE_K, 1);
 
@@ -0,0 +1,190 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+static void convolution_im2col_widen_tile_bf16s(const Mat& bottom_blob, Mat& tile, int q, int y, int pad_left, int pad_top, float pad_value)
+{
+    // channels [q, q + tile.c) and bordered rows [y, y + tile.h) of the bf16 bottom_blob as fp32
+    // the border is filled on the fly, so the bf16 blob is never padded
+    const int w = bottom_blob.w;
+    const int h = bottom_blob.h;
+    const int elempack = bottom_blob.elempack;
+
+    // the tile may stop short of the right border, or of the input itself
+    const int left = std::min(pad_left, tile.w) * elempack;
+    const int size = std::max(std::min(w, tile.w - pad_left), 0) * elempack;
+    const int right = tile.w * elempack - left - size;
+
+    for (int p = 0; p < tile.c; p++)
+    {
+        const Mat img = bottom_blob.channel(q + p);
+
+        for (int i = 0; i < tile.h; i++)
+        {
+            float* outptr = tile.channel(p).row(i);
+
+            const int sy = y + i - pad_top;
+            if (sy < 0 || sy >= h)
+            {
+                for (int x = 0; x < tile.w * elempack; x++)
+                {
+                    outptr[x] = pad_value;
+                }
+                continue;
+            }
+
+            for (int x = 0; x < left; x++)
+            {
+                outptr[x] = pad_value;
+            }
+
+            bfloat2float_row(img.row<const unsigned short>(sy), outptr + left, size);
+
+            outptr += left + size;
+            for (int x = 0; x < right; x++)
+            {
+                outptr[x] = pad_value;
+            }
+        }
+    }
+}
+
+static int convolution_im2col_gemm_bf16s(const Mat& bottom_blob, Mat& top_blob, const Mat& AT, const Mat& bias, int kernel_w, int kernel_h, int dilation_w, int dilation_h, int stride_w, int stride_h, int pad_left, int pad_top, float pad_value, int activation_type, const Mat& activation_params, int nT, const Option& opt)
+{
+    // unpadded bf16 bottom_blob, fp32 AT, bf16 top_blob
+    // the input is widened and bordered one im2col tile at a time,
+    // the accumulated tile is activated and narrowed to bf16 in one pass
+    const int maxk = kernel_w * kernel_h;
+    const int elempack = bottom_blob.elempack;
+
+    const int M = top_blob.c * top_blob.elempack;
+    const int N = top_blob.w * top_blob.h;
+    const int K = bottom_blob.c * elempack * maxk;
+
+    // the bordered input extent
+    const int outw = top_blob.w;
+    const int outh = top_blob.h;
+    const int kernel_extent_w = dilation_w * (kernel_w - 1) + 1;
+    const int kernel_extent_h = dilation_h * (kernel_h - 1) + 1;
+    const int w = (outw - 1) * stride_w + kernel_extent_w;
+
+    int TILE_M, TILE_N, TILE_K;
+    convolution_im2col_gemm_get_optimal_tile_mnk(M, N, K, TILE_M, TILE_N, TILE_K, nT);
+
+    nT = std::min(nT, opt.num_threads);
+
+    const int nn_M = (M + TILE_M - 1) / TILE_M;
+    const int nn_N = (N + TILE_N - 1) / TILE_N;
+    const int nn_K = (K + TILE_K - 1) / TILE_K;
+
+    Mat BT(TILE_K * TILE_N, (K + TILE_K - 1) / TILE_K, (N + TILE_N - 1) / TILE_N, 4u, opt.workspace_allocator);
+    if (BT.empty())
+        return -100;
+
+    // the largest input window one tile reads
+    const int max_tile_outh = std::min(outh, (TILE_N + outw - 2) / outw + 1);
+    const int max_tile_h = (max_tile_outh - 1) * stride_h + kernel_extent_h;
+    const int max_tile_c = std::min(bottom_blob.c, (TILE_K / elempack - 1) / maxk + 2);
+    const size_t max_tile_cstep = alignSize((size_t)w * max_tile_h * elempack * 4u, 16) / 4;
+
+    Mat tileX((int)(max_tile_cstep * max_tile_c), 1, nT, 4u, opt.workspace_allocator);
+    if (tileX.empty())
+        return -100;
+
+    const int nn_NK = nn_N * nn_K;
+
+    #pragma omp parallel for num_threads(nT)
+    for (int ppjk = 0; ppjk < nn_NK; ppjk++)
+    {
+        const int ppj = ppjk / nn_K;
+        const int ppk = ppjk % nn_K;
+
+        const int j = ppj * TILE_N;
+        const int k = ppk * TILE_K;
+
+        const int max_jj = std::min((N - j), TILE_N);
+        const int max_kk = std::min((K - k), TILE_K);
+
+        Mat BT_tile = BT.channel(j / TILE_N).row_range(k / TILE_K, 1);
+
+        // the channels and bordered rows this tile reads
+        const int q0 = (k / elempack) / maxk;
+        const int q1 = (k / elempack + max_kk / elempack - 1) / maxk;
+        const int dy0 = j / outw;
+        const int dy1 = (j + max_jj - 1) / outw;
+        const int tile_h = (dy1 - dy0) * stride_h + kernel_extent_h;
+
+        Mat tile(w, tile_h, q1 - q0 + 1, (void*)tileX.channel(get_omp_thread_num()), 4u * elempack, elempack);
+
+        convolution_im2col_widen_tile_bf16s(bottom_blob, tile, q0, dy0 * stride_h, pad_left, pad_top, pad_value);
+
+        // im2col
+        convolution_im2col_input_tile(tile, BT_tile, j - dy0 * outw, max_jj, k - q0 * maxk * elempack, max_kk, kernel_w, kernel_h, dilation_w, dilation_h, stride_w, stride_h);
+    }
+
+    Mat ATX;
+    if (AT.elembits() == 16)
+    {
+        ATX.create(TILE_K * TILE_M, nn_K, nT, 4u, opt.workspace_allocator);
+        if (ATX.empty())
+            return -100;
+    }
+
+    Mat topT_tileX(TILE_N * TILE_M, 1, nT, 4u, opt.workspace_allocator);
+    if (topT_tileX.empty())
+        return -100;
+
+    #pragma omp parallel for num_threads(nT)
+    for (int ppj = 0; ppj < nn_M; ppj++)
+    {
+        const int i = ppj * TILE_M;
+
+        Mat topT_tile = topT_tileX.channel(get_omp_thread_num());
+
+        const int max_ii = std::min((M - i), TILE_M);
+
+        Mat AT_panel = AT.channel(i / TILE_M);
+        if (AT.elembits() == 16)
+        {
+            // widen the fp16 weight panel once, it is reused for every j tile
+            Mat AT_panel_fp32 = ATX.channel(get_omp_thread_num());
+            for (int k = 0; k < K; k += TILE_K)
+            {
+                const int max_kk = std::min((K - k), TILE_K);
+
+                float16_to_float32_row(AT_panel.row<const unsigned short>(k / TILE_K), AT_panel_fp32.row(k / TILE_K), max_ii * max_kk);
+            }
+            AT_panel = AT_panel_fp32;
+        }
+
+        for (int j = 0; j < N; j += TILE_N)
+        {
+            const int max_jj = std::min((N - j), TILE_N);
+
+            for (int k = 0; k < K; k += TILE_K)
+            {
+                const int max_kk = std::min((K - k), TILE_K);
+
+                const Mat AT_tile = AT_panel.row_range(k / TILE_K, 1);
+
+                const Mat BT_tile = BT.channel(j / TILE_N).row_range(k / TILE_K, 1);
+
+                convolution_gemm_transB_packed_tile(AT_tile, BT_tile, bias, topT_tile, top_blob, i, max_ii, j, max_jj, k, max_kk, false);
+            }
+
+            unpack_output_tile_bf16s(topT_tile, top_blob, i, max_ii, j, max_jj, activation_type, activation_params);
+        }
+    }
+
+    return 0;
+}
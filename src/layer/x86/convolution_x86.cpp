@@ -31,7 +31,9 @@
 
 #include "benchmark.h"
 #include "cpu.h"
+#include "cpupipelinecache.h"
 #include "layer_type.h"
+#include "profiler.h"
 
 namespace ncnn {
 
@@ -41,6 +43,8 @@ namespace ncnn {
 #include "convolution_3x3_winograd.h"
 #include "convolution_packed.h"
 #include "convolution_im2col_gemm.h"
+#include "gemm_bf16s.h"
+#include "convolution_im2col_gemm_bf16s.h"
 
 #if NCNN_INT8
 #include "convolution_3x3_int8.h"
@@ -71,6 +75,9 @@ Convolution_x86::Convolution_x86()
 #if __SSE2__
     support_packing = true;
 #endif // __SSE2__
+#if NCNN_BF16
+    support_bf16_storage = true;
+#endif
 
     activation = 0;
     nT = 0;
@@ -277,10 +284,60 @@ static bool test_prefer_winograd23(int num_input, int num_output, int w, int h)
     return false;
 }
 
+static std::vector<int> convolution_pipeline_cache_params(const Convolution& op)
+{
+    std::vector<int> params;
+    params.push_back(op.num_output);
+    params.push_back(op.kernel_w);
+    params.push_back(op.kernel_h);
+    params.push_back(op.dilation_w);
+    params.push_back(op.dilation_h);
+    params.push_back(op.stride_w);
+    params.push_back(op.stride_h);
+    params.push_back(op.pad_left);
+    params.push_back(op.pad_right);
+    params.push_back(op.pad_top);
+    params.push_back(op.pad_bottom);
+    params.push_back(op.weight_data_size);
+    params.push_back(op.int8_scale_term);
+
+    // winograd tile selection depends on the shape hint
+    params.push_back(op.bottom_shapes.empty() ? 0 : op.bottom_shapes[0].w);
+    params.push_back(op.bottom_shapes.empty() ? 0 : op.bottom_shapes[0].h);
+    params.push_back(op.top_shapes.empty() ? 0 : op.top_shapes[0].w);
+    params.push_back(op.top_shapes.empty() ? 0 : op.top_shapes[0].h);
+
+    // the weight layout of this isa variant
+#if __AVX512F__
+    params.push_back(16);
+#elif __AVX__
+    params.push_back(8);
+#elif __SSE2__
+    params.push_back(4);
+#else
+    params.push_back(1);
+#endif
+#if __FMA__
+    params.push_back(1);
+#else
+    params.push_back(0);
+#endif
+#if __AVX512VNNI__ || __AVXVNNI__ || __XOP__
+    params.push_back(1);
+#else
+    params.push_back(0);
+#endif
+
+    return params;
+}
+
 int Convolution_x86::create_pipeline(const Option& opt)
 {
     if (dynamic_weight)
+    {
+        support_bf16_storage = false;
         return 0;
+    }
 
     activation = create_activation_layer(activation_type, activation_params, opt);
     nT = opt.num_threads;
@@ -288,6 +345,7 @@ int Convolution_x86::create_pipeline(const Option& opt)
 #if NCNN_INT8
     if (opt.use_int8_inference && weight_data.elemsize == (size_t)1u)
     {
+        support_bf16_storage = false;
         return create_pipeline_int8_x86(opt);
     }
 #endif
@@ -359,6 +417,30 @@ int Convolution_x86::create_pipeline(const Option& opt)
     }
 #endif // __SSE2__
 
+    std::vector<int> cache_params;
+    if (opt.cpu_pipeline_cache)
+    {
+        cache_params = convolution_pipeline_cache_params(*this);
+
+        std::vector<Mat> artifacts;
+        if (opt.cpu_pipeline_cache->get(LayerType::Convolution, cache_params, weight_data, opt, artifacts) == 0 && artifacts.size() == 5)
+        {
+            weight_data_tm = artifacts[0];
+            weight_sgemm_data = artifacts[1];
+            weight_winograd23_data = artifacts[2];
+            weight_winograd43_data = artifacts[3];
+            weight_winograd63_data = artifacts[4];
+
+            if (opt.lightmode)
+                weight_data.release();
+
+            return 0;
+        }
+    }
+
+    int l2_cache_size = get_cpu_level2_cache_size();
+    bool prefer_sgemm = num_input * num_output * kernel_w * kernel_h * dilation_w * dilation_h * stride_w * stride_h * (int)sizeof(float) * 2 > l2_cache_size || (num_input > 16 || num_output > 16);
+
     bool prefer_winograd = (opt.use_winograd23_convolution || opt.use_winograd43_convolution || opt.use_winograd63_convolution) && (num_input > 8 || num_output > 8);
 
     if (opt.use_winograd_convolution && prefer_winograd && kernel_w == 3 && kernel_h == 3 && dilation_w == 1 && dilation_h == 1 && stride_w == 1 && stride_h == 1)
@@ -451,27 +533,22 @@ int Convolution_x86::create_pipeline(const Option& opt)
                 // should never reach here
             }
         }
-
-        if (opt.lightmode)
-            weight_data.release();
-
-        return 0;
     }
-
-    int l2_cache_size = get_cpu_level2_cache_size();
-    bool prefer_sgemm = num_input * num_output * kernel_w * kernel_h * dilation_w * dilation_h * stride_w * stride_h * (int)sizeof(float) * 2 > l2_cache_size || (num_input > 16 || num_output > 16);
-
-    if ((opt.use_sgemm_convolution && prefer_sgemm) || (kernel_w == 1 && kernel_h == 1))
+    else if ((opt.use_sgemm_convolution && prefer_sgemm) || (kernel_w == 1 && kernel_h == 1))
     {
         convolution_im2col_gemm_transform_kernel(weight_data, weight_sgemm_data, num_input, num_output, kernel_w, kernel_h, opt);
 
-        if (opt.lightmode)
-            weight_data.release();
-
-        return 0;
+#if NCNN_F16C && __F16C__
+        if (opt.use_fp16_storage && opt.use_fp16_weight_storage)
+        {
+            // keep the gemm weights in fp16, forward widens them panel by panel
+            Mat weight_sgemm_data_fp16;
+            cast_float32_to_float16(weight_sgemm_data, weight_sgemm_data_fp16, opt);
+            weight_sgemm_data = weight_sgemm_data_fp16;
+        }
+#endif
     }
-
-    if ((elempack == 16 && out_elempack == 1 && kernel_w == 3 && kernel_h == 3 && dilation_w == 1 && dilation_h == 1 && stride_w == 1 && stride_h == 1)
+    else if ((elempack == 16 && out_elempack == 1 && kernel_w == 3 && kernel_h == 3 && dilation_w == 1 && dilation_h == 1 && stride_w == 1 && stride_h == 1)
             || (elempack == 8 && out_elempack == 8 && kernel_w == 3 && kernel_h == 3 && dilation_w == 1 && dilation_h == 1 && stride_w == 1 && stride_h == 1)
             || (elempack == 8 && out_elempack == 8 && kernel_w == 2 && kernel_h == 2 && dilation_w == 1 && dilation_h == 1 && stride_w == 1 && stride_h == 1)
             || (elempack == 1 && out_elempack == 8 && kernel_w == 3 && kernel_h == 3 && dilation_w == 1 && dilation_h == 1 && stride_w == 1 && stride_h == 1)
@@ -487,6 +564,17 @@ int Convolution_x86::create_pipeline(const Option& opt)
         convolution_transform_kernel_packed(weight_data, weight_data_tm, num_input, num_output, kernel_w, kernel_h);
     }
 
+    if (opt.cpu_pipeline_cache)
+    {
+        std::vector<Mat> artifacts(5);
+        artifacts[0] = weight_data_tm;
+        artifacts[1] = weight_sgemm_data;
+        artifacts[2] = weight_winograd23_data;
+        artifacts[3] = weight_winograd43_data;
+        artifacts[4] = weight_winograd63_data;
+        opt.cpu_pipeline_cache->put(LayerType::Convolution, cache_params, weight_data, opt, artifacts);
+    }
+
     if (opt.lightmode)
         weight_data.release();
 
@@ -565,6 +653,11 @@ int Convolution_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option
         return 0;
     }
 
+#if NCNN_BF16
+    if (opt.use_bf16_storage)
+        return forward_bf16s(bottom_blob, top_blob, opt);
+#endif
+
     int w = bottom_blob.w;
     int h = bottom_blob.h;
     int channels = bottom_blob.c;
@@ -650,24 +743,30 @@ int Convolution_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option
         }
 
         int _nT = nT ? nT : opt.num_threads;
-        if (nT != 0 && opt.num_threads != nT)
+        if (nT != 0 && opt.num_threads > nT)
         {
-            // force num_threads the same as in create_pipeline
-            // so we could use pre-packed A/B from the same tile config
+            // pre-packed A/B comes from the tile config in create_pipeline
+            // so we could not use more threads than the load-time value
             NCNN_LOGE("opt.num_threads %d changed, convolution winograd will use load-time value %d", opt.num_threads, nT);
         }
 
         int ret = 0;
         if (prefer_winograd23)
         {
+            if (opt.profiler)
+                opt.profiler->note_kernel("winograd23");
             ret = conv3x3s1_winograd23(bottom_blob_bordered, top_blob, weight_winograd23_data, bias_data, _nT, opt);
         }
         else if (prefer_winograd43)
         {
+            if (opt.profiler)
+                opt.profiler->note_kernel("winograd43");
             ret = conv3x3s1_winograd43(bottom_blob_bordered, top_blob, weight_winograd43_data, bias_data, _nT, opt);
         }
         else if (prefer_winograd63)
         {
+            if (opt.profiler)
+                opt.profiler->note_kernel("winograd63");
             ret = conv3x3s1_winograd63(bottom_blob_bordered, top_blob, weight_winograd63_data, bias_data, _nT, opt);
         }
         else
@@ -690,13 +789,15 @@ int Convolution_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option
     if ((opt.use_sgemm_convolution && prefer_sgemm) || (kernel_w == 1 && kernel_h == 1))
     {
         int _nT = nT ? nT : opt.num_threads;
-        if (nT != 0 && opt.num_threads != nT)
+        if (nT != 0 && opt.num_threads > nT)
         {
-            // force num_threads the same as in create_pipeline
-            // so we could use pre-packed A/B from the same tile config
+            // pre-packed A/B comes from the tile config in create_pipeline
+            // so we could not use more threads than the load-time value
             NCNN_LOGE("opt.num_threads %d changed, convolution gemm will use load-time value %d", opt.num_threads, nT);
         }
 
+        if (opt.profiler)
+            opt.profiler->note_kernel("im2col_gemm");
         int ret = convolution_im2col_gemm(bottom_blob_bordered, top_blob, weight_sgemm_data, bias_data, kernel_w, kernel_h, dilation_w, dilation_h, stride_w, stride_h, _nT, opt);
         if (ret != 0)
             return ret;
@@ -715,6 +816,8 @@ int Convolution_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option
     {
         if (kernel_w == 3 && kernel_h == 3 && dilation_w == 1 && dilation_h == 1 && stride_w == 1 && stride_h == 1)
         {
+            if (opt.profiler)
+                opt.profiler->note_kernel("conv3x3s1_pack16to1");
             conv3x3s1_pack16to1_avx512(bottom_blob_bordered, top_blob, weight_data_tm, bias_data, opt);
 
             if (activation)
@@ -730,6 +833,8 @@ int Convolution_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option
     {
         if (kernel_w == 3 && kernel_h == 3 && dilation_w == 1 && dilation_h == 1 && stride_w == 1 && stride_h == 1)
         {
+            if (opt.profiler)
+                opt.profiler->note_kernel("conv3x3s1_pack8");
             conv3x3s1_pack8_avx(bottom_blob_bordered, top_blob, weight_data_tm, bias_data, opt);
 
             if (activation)
@@ -740,6 +845,8 @@ int Convolution_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option
         }
         if (kernel_w == 2 && kernel_h == 2 && dilation_w == 1 && dilation_h == 1 && stride_w == 1 && stride_h == 1)
         {
+            if (opt.profiler)
+                opt.profiler->note_kernel("conv2x2s1_pack8");
             conv2x2s1_pack8_avx(bottom_blob_bordered, top_blob, weight_data_tm, bias_data, opt);
 
             if (activation)
@@ -754,6 +861,8 @@ int Convolution_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option
     {
         if (kernel_w == 3 && kernel_h == 3 && dilation_w == 1 && dilation_h == 1 && stride_w == 1 && stride_h == 1)
         {
+            if (opt.profiler)
+                opt.profiler->note_kernel("conv3x3s1_pack1to8");
             conv3x3s1_pack1to8_avx(bottom_blob_bordered, top_blob, weight_data_tm, bias_data, opt);
 
             if (activation)
@@ -764,6 +873,8 @@ int Convolution_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option
         }
         if (kernel_w == 3 && kernel_h == 3 && dilation_w == 1 && dilation_h == 1 && stride_w == 2 && stride_h == 2)
         {
+            if (opt.profiler)
+                opt.profiler->note_kernel("conv3x3s2_pack1to8");
             conv3x3s2_pack1to8_avx(bottom_blob_bordered, top_blob, weight_data_tm, bias_data, opt);
 
             if (activation)
@@ -778,6 +889,8 @@ int Convolution_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option
     {
         if (kernel_w == 3 && kernel_h == 3 && dilation_w == 1 && dilation_h == 1 && stride_w == 1 && stride_h == 1)
         {
+            if (opt.profiler)
+                opt.profiler->note_kernel("conv3x3s1_pack8to1");
             conv3x3s1_pack8to1_avx(bottom_blob_bordered, top_blob, weight_data_tm, bias_data, opt);
 
             if (activation)
@@ -793,6 +906,8 @@ int Convolution_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option
     {
         if (kernel_w == 3 && kernel_h == 3 && dilation_w == 1 && dilation_h == 1 && stride_w == 1 && stride_h == 1)
         {
+            if (opt.profiler)
+                opt.profiler->note_kernel("conv3x3s1_pack1to4");
             conv3x3s1_pack1to4_sse(bottom_blob_bordered, top_blob, weight_data_tm, bias_data, opt);
 
             if (activation)
@@ -803,6 +918,8 @@ int Convolution_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option
         }
         if (kernel_w == 3 && kernel_h == 3 && dilation_w == 1 && dilation_h == 1 && stride_w == 2 && stride_h == 2)
         {
+            if (opt.profiler)
+                opt.profiler->note_kernel("conv3x3s2_pack1to4");
             conv3x3s2_pack1to4_sse(bottom_blob_bordered, top_blob, weight_data_tm, bias_data, opt);
 
             if (activation)
@@ -814,6 +931,8 @@ int Convolution_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option
     }
 #endif // __SSE2__
 
+    if (opt.profiler)
+        opt.profiler->note_kernel("packed");
     convolution_packed(bottom_blob_bordered, top_blob, weight_data_tm, bias_data, kernel_w, kernel_h, dilation_w, dilation_h, stride_w, stride_h, activation_type, activation_params, opt);
 
     return 0;
@@ -893,15 +1012,131 @@ int Convolution_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<M
     return 0;
 }
 
+#if NCNN_BF16
+int Convolution_x86::forward_bf16s(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    // the pipeline is the fp32 one, only the blobs are bf16
+    Option opt_fp32 = opt;
+    opt_fp32.use_bf16_storage = false;
+
+    // composite layers may still feed fp32 blobs into a bf16 pipeline
+    if (bottom_blob.elembits() != 16)
+        return forward(bottom_blob, top_blob, opt_fp32);
+
+    if (weight_sgemm_data.empty())
+    {
+        // winograd, packed and dilation kernels read fp32 rows, widen the input and narrow the output
+        Option opt_cast = opt;
+        opt_cast.blob_allocator = opt.workspace_allocator;
+
+        Mat bottom_blob_fp32;
+        cast_bfloat16_to_float32(bottom_blob, bottom_blob_fp32, opt_cast);
+        if (bottom_blob_fp32.empty())
+            return -100;
+
+        Mat top_blob_fp32;
+        opt_fp32.blob_allocator = opt.workspace_allocator;
+        int ret = forward(bottom_blob_fp32, top_blob_fp32, opt_fp32);
+        if (ret != 0)
+            return ret;
+
+        cast_float32_to_bfloat16(top_blob_fp32, top_blob, opt);
+        if (top_blob.empty())
+            return -100;
+
+        return 0;
+    }
+
+    // im2col gemm widens and borders the input per tile
+    const int w = bottom_blob.w;
+    const int h = bottom_blob.h;
+
+    const int kernel_extent_w = dilation_w * (kernel_w - 1) + 1;
+    const int kernel_extent_h = dilation_h * (kernel_h - 1) + 1;
+
+    int pl = 0;
+    int pr = 0;
+    int pt = 0;
+    int pb = 0;
+    if (pad_left > 0 || pad_right > 0 || pad_top > 0 || pad_bottom > 0)
+    {
+        pl = pad_left;
+        pr = pad_right;
+        pt = pad_top;
+        pb = pad_bottom;
+    }
+    else if ((pad_left == -233 && pad_right == -233 && pad_top == -233 && pad_bottom == -233) || (pad_left == -234 && pad_right == -234 && pad_top == -234 && pad_bottom == -234))
+    {
+        // tensorflow padding=SAME or onnx padding=SAME_UPPER/SAME_LOWER
+        const int wpad = std::max(kernel_extent_w + (w - 1) / stride_w * stride_w - w, 0);
+        const int hpad = std::max(kernel_extent_h + (h - 1) / stride_h * stride_h - h, 0);
+        pl = pad_left == -233 ? wpad / 2 : wpad - wpad / 2;
+        pr = wpad - pl;
+        pt = pad_top == -233 ? hpad / 2 : hpad - hpad / 2;
+        pb = hpad - pt;
+    }
+
+    const int outw = (w + pl + pr - kernel_extent_w) / stride_w + 1;
+    const int outh = (h + pt + pb - kernel_extent_h) / stride_h + 1;
+    int out_elempack = 1;
+#if __SSE2__
+    if (opt.use_packing_layout)
+    {
+#if __AVX512F__
+        out_elempack = num_output % 16 == 0 ? 16 : num_output % 8 == 0 ? 8 : num_output % 4 == 0 ? 4 : 1;
+#elif __AVX__
+        out_elempack = num_output % 8 == 0 ? 8 : num_output % 4 == 0 ? 4 : 1;
+#else
+        out_elempack = num_output % 4 == 0 ? 4 : 1;
+#endif
+    }
+#endif // __SSE2__
+    const size_t out_elemsize = 2u * out_elempack;
+
+    top_blob.create(outw, outh, num_output / out_elempack, out_elemsize, out_elempack, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    int _nT = nT ? nT : opt.num_threads;
+    if (nT != 0 && opt.num_threads > nT)
+    {
+        // pre-packed A/B comes from the tile config in create_pipeline
+        // so we could not use more threads than the load-time value
+        NCNN_LOGE("opt.num_threads %d changed, convolution gemm will use load-time value %d", opt.num_threads, nT);
+    }
+
+    if (opt.profiler)
+        opt.profiler->note_kernel("im2col_gemm_bf16s");
+
+    return convolution_im2col_gemm_bf16s(bottom_blob, top_blob, weight_sgemm_data, bias_data, kernel_w, kernel_h, dilation_w, dilation_h, stride_w, stride_h, pl, pt, pad_value, activation_type, activation_params, _nT, opt);
+}
+#endif // NCNN_BF16
+
 #if NCNN_INT8
 int Convolution_x86::create_pipeline_int8_x86(const Option& opt)
 {
     const int maxk = kernel_w * kernel_h;
     const int num_input = weight_data_size / maxk / num_output;
 
+    std::vector<int> cache_params;
+    std::vector<Mat> artifacts;
+    bool cached = false;
+    if (opt.cpu_pipeline_cache)
+    {
+        cache_params = convolution_pipeline_cache_params(*this);
+        cached = opt.cpu_pipeline_cache->get(LayerType::Convolution, cache_params, weight_data, opt, artifacts) == 0 && artifacts.size() == 4;
+    }
+
     bool prefer_winograd = (opt.use_winograd23_convolution || opt.use_winograd43_convolution) && (num_input > 8 || num_output > 8);
 
-    if (opt.use_winograd_convolution && prefer_winograd && kernel_w == 3 && kernel_h == 3 && dilation_w == 1 && dilation_h == 1 && stride_w == 1 && stride_h == 1)
+    if (cached)
+    {
+        weight_data_tm = artifacts[0];
+        weight_sgemm_data = artifacts[1];
+        weight_winograd23_data = artifacts[2];
+        weight_winograd43_data = artifacts[3];
+    }
+    else if (opt.use_winograd_convolution && prefer_winograd && kernel_w == 3 && kernel_h == 3 && dilation_w == 1 && dilation_h == 1 && stride_w == 1 && stride_h == 1)
     {
         if (opt.use_winograd43_convolution)
             conv3x3s1_winograd43_transform_kernel_int8(weight_data, weight_winograd43_data, num_input, num_output, opt);
@@ -917,6 +1152,16 @@ int Convolution_x86::create_pipeline_int8_x86(const Option& opt)
         convolution_transform_kernel_packed_int8(weight_data, weight_data_tm, num_input, num_output, kernel_w, kernel_h);
     }
 
+    if (opt.cpu_pipeline_cache && !cached)
+    {
+        artifacts.resize(4);
+        artifacts[0] = weight_data_tm;
+        artifacts[1] = weight_sgemm_data;
+        artifacts[2] = weight_winograd23_data;
+        artifacts[3] = weight_winograd43_data;
+        opt.cpu_pipeline_cache->put(LayerType::Convolution, cache_params, weight_data, opt, artifacts);
+    }
+
     scale_in_data.create(num_output);
     for (int p = 0; p < num_output; p++)
     {
@@ -1005,10 +1250,10 @@ int Convolution_x86::forward_int8_x86(const Mat& bottom_blob, Mat& top_blob, con
     bool prefer_winograd = (opt.use_winograd23_convolution || opt.use_winograd43_convolution) && (num_input > 8 || num_output > 8);
 
     int _nT = nT ? nT : opt.num_threads;
-    if (nT != 0 && opt.num_threads != nT)
+    if (nT != 0 && opt.num_threads > nT)
     {
-        // force num_threads the same as in create_pipeline
-        // so we could use pre-packed A/B from the same tile config
+        // pre-packed A/B comes from the tile config in create_pipeline
+        // so we could not use more threads than the load-time value
         NCNN_LOGE("opt.num_threads %d changed, convolution gemm will use load-time value %d", opt.num_threads, nT);
     }
 
@@ -1016,16 +1261,28 @@ int Convolution_x86::forward_int8_x86(const Mat& bottom_blob, Mat& top_blob, con
     if (opt.use_winograd_convolution && prefer_winograd && kernel_w == 3 && kernel_h == 3 && dilation_w == 1 && dilation_h == 1 && stride_w == 1 && stride_h == 1)
     {
         if (opt.use_winograd43_convolution && !weight_winograd43_data.empty())
+        {
+            if (opt.profiler)
+                opt.profiler->note_kernel("winograd43_int8");
             ret = conv3x3s1_winograd43_int8(bottom_blob_bordered, top_blob_int32, weight_winograd43_data, _nT, opt);
+        }
         else
+        {
+            if (opt.profiler)
+                opt.profiler->note_kernel("winograd23_int8");
             ret = conv3x3s1_winograd23_int8(bottom_blob_bordered, top_blob_int32, weight_winograd23_data, _nT, opt);
+        }
     }
     else if (opt.use_sgemm_convolution)
     {
+        if (opt.profiler)
+            opt.profiler->note_kernel("im2col_gemm_int8");
         ret = convolution_im2col_gemm_int8(bottom_blob_bordered, top_blob_int32, weight_sgemm_data, kernel_w, kernel_h, dilation_w, dilation_h, stride_w, stride_h, _nT, opt);
     }
     else
     {
+        if (opt.profiler)
+            opt.profiler->note_kernel("packed_int8");
         convolution_packed_int8(bottom_blob_bordered, top_blob_int32, weight_data_tm, kernel_w, kernel_h, dilation_w, dilation_h, stride_w, stride_h, opt);
     }
     if (ret != 0)
@@ -37,6 +37,9 @@ protected:
     int forward_int8_x86(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
 #endif
     int forwardDilation_x86(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
+#if NCNN_BF16
+    int forward_bf16s(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
+#endif
 
 public:
     Layer* activation;
@@ -0,0 +1,163 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+static void convolutiondepthwise_bf16s(const Mat& bottom_blob, Mat& top_blob, const Mat& weight_data_tm, const Mat& bias_data, int kernel_w, int kernel_h, int dilation_w, int dilation_h, int stride_w, int stride_h, int activation_type, const Mat& activation_params, const Option& opt)
+{
+    // fp32 bordered bottom_blob, fp32 or bf16 top_blob in the same packing
+    const int w = bottom_blob.w;
+    const int channels = bottom_blob.c;
+    const int elempack = bottom_blob.elempack;
+
+    const int outw = top_blob.w;
+    const int outh = top_blob.h;
+    const bool output_bf16 = top_blob.elembits() == 16;
+
+    const int maxk = kernel_w * kernel_h;
+
+    // kernel offsets
+    std::vector<int> _space_ofs(maxk);
+    int* space_ofs = &_space_ofs[0];
+    {
+        int p1 = 0;
+        int p2 = 0;
+        int gap = w * dilation_h - kernel_w * dilation_w;
+        for (int i = 0; i < kernel_h; i++)
+        {
+            for (int j = 0; j < kernel_w; j++)
+            {
+                space_ofs[p1] = p2;
+                p1++;
+                p2 += dilation_w;
+            }
+            p2 += gap;
+        }
+    }
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int g = 0; g < channels; g++)
+    {
+        float* outptr = top_blob.channel(g);
+        unsigned short* outptr_bf16 = top_blob.channel(g);
+        const float* kptr = (const float*)weight_data_tm + maxk * g * elempack;
+        const float* bptr = bias_data.empty() ? 0 : (const float*)bias_data + g * elempack;
+        const Mat m = bottom_blob.channel(g);
+
+        for (int i = 0; i < outh; i++)
+        {
+            for (int j = 0; j < outw; j++)
+            {
+                const float* sptr = m.row(i * stride_h) + j * stride_w * elempack;
+
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+                if (elempack == 16)
+                {
+                    __m512 _sum = bptr ? _mm512_loadu_ps(bptr) : _mm512_setzero_ps();
+
+                    for (int k = 0; k < maxk; k++)
+                    {
+                        __m512 _val = _mm512_loadu_ps(sptr + space_ofs[k] * 16);
+                        __m512 _w = _mm512_loadu_ps(kptr + k * 16);
+                        _sum = _mm512_fmadd_ps(_val, _w, _sum);
+                    }
+
+                    _sum = activation_avx512(_sum, activation_type, activation_params);
+
+                    if (output_bf16)
+                    {
+                        _mm256_storeu_si256((__m256i*)outptr_bf16, float2bfloat_avx512(_sum));
+                        outptr_bf16 += 16;
+                    }
+                    else
+                    {
+                        _mm512_storeu_ps(outptr, _sum);
+                        outptr += 16;
+                    }
+                }
+#endif // __AVX512F__
+                if (elempack == 8)
+                {
+                    __m256 _sum = bptr ? _mm256_loadu_ps(bptr) : _mm256_setzero_ps();
+
+                    for (int k = 0; k < maxk; k++)
+                    {
+                        __m256 _val = _mm256_loadu_ps(sptr + space_ofs[k] * 8);
+                        __m256 _w = _mm256_loadu_ps(kptr + k * 8);
+                        _sum = _mm256_comp_fmadd_ps(_val, _w, _sum);
+                    }
+
+                    _sum = activation_avx(_sum, activation_type, activation_params);
+
+                    if (output_bf16)
+                    {
+                        _mm_storeu_si128((__m128i*)outptr_bf16, float2bfloat_avx(_sum));
+                        outptr_bf16 += 8;
+                    }
+                    else
+                    {
+                        _mm256_storeu_ps(outptr, _sum);
+                        outptr += 8;
+                    }
+                }
+#endif // __AVX__
+                if (elempack == 4)
+                {
+                    __m128 _sum = bptr ? _mm_loadu_ps(bptr) : _mm_setzero_ps();
+
+                    for (int k = 0; k < maxk; k++)
+                    {
+                        __m128 _val = _mm_loadu_ps(sptr + space_ofs[k] * 4);
+                        __m128 _w = _mm_loadu_ps(kptr + k * 4);
+                        _sum = _mm_comp_fmadd_ps(_val, _w, _sum);
+                    }
+
+                    _sum = activation_sse(_sum, activation_type, activation_params);
+
+                    if (output_bf16)
+                    {
+                        _mm_storel_epi64((__m128i*)outptr_bf16, float2bfloat_sse(_sum, _sum));
+                        outptr_bf16 += 4;
+                    }
+                    else
+                    {
+                        _mm_storeu_ps(outptr, _sum);
+                        outptr += 4;
+                    }
+                }
+#endif // __SSE2__
+                if (elempack == 1)
+                {
+                    float sum = bptr ? bptr[0] : 0.f;
+
+                    for (int k = 0; k < maxk; k++)
+                    {
+                        sum += sptr[space_ofs[k]] * kptr[k];
+                    }
+
+                    sum = activation_ss(sum, activation_type, activation_params);
+
+                    if (output_bf16)
+                    {
+                        *outptr_bf16++ = float32_to_bfloat16(sum);
+                    }
+                    else
+                    {
+                        *outptr++ = sum;
+                    }
+                }
+            }
+        }
+    }
+}
@@ -25,6 +25,7 @@
 #include "x86_usability.h"
 
 #include "layer_type.h"
+#include "profiler.h"
 
 namespace ncnn {
 
@@ -41,6 +42,7 @@ namespace ncnn {
 #endif // __AVX__
 #endif // __SSE2__
 #include "convolutiondepthwise_3x3.h"
+#include "convolutiondepthwise_bf16s.h"
 
 #if NCNN_INT8
 #include "convolutiondepthwise_3x3_int8.h"
@@ -51,19 +53,26 @@ ConvolutionDepthWise_x86::ConvolutionDepthWise_x86()
 #if __SSE2__
     support_packing = true;
 #endif // __SSE2__
+#if NCNN_BF16
+    support_bf16_storage = true;
+#endif
     activation = 0;
 }
 
 int ConvolutionDepthWise_x86::create_pipeline(const Option& opt)
 {
     if (dynamic_weight)
+    {
+        support_bf16_storage = false;
         return 0;
+    }
 
     activation = create_activation_layer(activation_type, activation_params, opt);
 
 #if NCNN_INT8
     if (opt.use_int8_inference && weight_data.elemsize == (size_t)1u)
     {
+        support_bf16_storage = false;
         return create_pipeline_int8_x86(opt);
     }
 #endif
@@ -126,6 +135,13 @@ int ConvolutionDepthWise_x86::create_pipeline(const Option& opt)
             {
                 weight_data_tm = weight_data;
             }
+#if NCNN_BF16
+            else if (opt.use_bf16_storage)
+            {
+                // bf16 storage runs the generic depth-wise kernel
+                weight_data_tm = weight_data;
+            }
+#endif
             else
             {
                 create_group_ops(opt);
@@ -139,6 +155,7 @@ int ConvolutionDepthWise_x86::create_pipeline(const Option& opt)
     }
 
     // group convolution
+    support_bf16_storage = false;
     create_group_ops(opt);
 
     if (opt.lightmode)
@@ -272,6 +289,11 @@ int ConvolutionDepthWise_x86::forward(const Mat& bottom_blob, Mat& top_blob, con
     }
 #endif
 
+#if NCNN_BF16
+    if (opt.use_bf16_storage && bottom_blob.c * bottom_blob.elempack == group && group == num_output)
+        return forward_bf16s(bottom_blob, top_blob, opt);
+#endif
+
     int w = bottom_blob.w;
     int h = bottom_blob.h;
     int channels = bottom_blob.c;
@@ -320,6 +342,8 @@ int ConvolutionDepthWise_x86::forward(const Mat& bottom_blob, Mat& top_blob, con
         {
             if (kernel_w == 3 && kernel_h == 3 && dilation_w == 1 && dilation_h == 1 && stride_w == 1 && stride_h == 1)
             {
+                if (opt.profiler)
+                    opt.profiler->note_kernel("convdw3x3s1_pack16");
                 convdw3x3s1_pack16_avx512(bottom_blob_bordered, top_blob, weight_data_tm, bias_data, opt);
 
                 if (activation)
@@ -331,6 +355,8 @@ int ConvolutionDepthWise_x86::forward(const Mat& bottom_blob, Mat& top_blob, con
             }
             if (kernel_w == 3 && kernel_h == 3 && dilation_w == 1 && dilation_h == 1 && stride_w == 2 && stride_h == 2)
             {
+                if (opt.profiler)
+                    opt.profiler->note_kernel("convdw3x3s2_pack16");
                 convdw3x3s2_pack16_avx512(bottom_blob_bordered, top_blob, weight_data_tm, bias_data, opt);
 
                 if (activation)
@@ -342,6 +368,8 @@ int ConvolutionDepthWise_x86::forward(const Mat& bottom_blob, Mat& top_blob, con
             }
             if (kernel_w == 5 && kernel_h == 5 && dilation_w == 1 && dilation_h == 1 && stride_w == 1 && stride_h == 1)
             {
+                if (opt.profiler)
+                    opt.profiler->note_kernel("convdw5x5s1_pack16");
                 convdw5x5s1_pack16_avx512(bottom_blob_bordered, top_blob, weight_data_tm, bias_data, opt);
 
                 if (activation)
@@ -353,6 +381,8 @@ int ConvolutionDepthWise_x86::forward(const Mat& bottom_blob, Mat& top_blob, con
             }
             if (kernel_w == 5 && kernel_h == 5 && dilation_w == 1 && dilation_h == 1 && stride_w == 2 && stride_h == 2)
             {
+                if (opt.profiler)
+                    opt.profiler->note_kernel("convdw5x5s2_pack16");
                 convdw5x5s2_pack16_avx512(bottom_blob_bordered, top_blob, weight_data_tm, bias_data, opt);
 
                 if (activation)
@@ -431,6 +461,8 @@ int ConvolutionDepthWise_x86::forward(const Mat& bottom_blob, Mat& top_blob, con
         {
             if (kernel_w == 3 && kernel_h == 3 && dilation_w == 1 && dilation_h == 1 && stride_w == 1 && stride_h == 1)
             {
+                if (opt.profiler)
+                    opt.profiler->note_kernel("convdw3x3s1_pack8");
                 convdw3x3s1_pack8_avx(bottom_blob_bordered, top_blob, weight_data_tm, bias_data, opt);
 
                 if (activation)
@@ -442,6 +474,8 @@ int ConvolutionDepthWise_x86::forward(const Mat& bottom_blob, Mat& top_blob, con
             }
             if (kernel_w == 3 && kernel_h == 3 && dilation_w == 1 && dilation_h == 1 && stride_w == 2 && stride_h == 2)
             {
+                if (opt.profiler)
+                    opt.profiler->note_kernel("convdw3x3s2_pack8");
                 convdw3x3s2_pack8_avx(bottom_blob_bordered, top_blob, weight_data_tm, bias_data, opt);
 
                 if (activation)
@@ -453,6 +487,8 @@ int ConvolutionDepthWise_x86::forward(const Mat& bottom_blob, Mat& top_blob, con
             }
             if (kernel_w == 5 && kernel_h == 5 && dilation_w == 1 && dilation_h == 1 && stride_w == 1 && stride_h == 1)
             {
+                if (opt.profiler)
+                    opt.profiler->note_kernel("convdw5x5s1_pack8");
                 convdw5x5s1_pack8_avx(bottom_blob_bordered, top_blob, weight_data_tm, bias_data, opt);
 
                 if (activation)
@@ -464,6 +500,8 @@ int ConvolutionDepthWise_x86::forward(const Mat& bottom_blob, Mat& top_blob, con
             }
             if (kernel_w == 5 && kernel_h == 5 && dilation_w == 1 && dilation_h == 1 && stride_w == 2 && stride_h == 2)
             {
+                if (opt.profiler)
+                    opt.profiler->note_kernel("convdw5x5s2_pack8");
                 convdw5x5s2_pack8_avx(bottom_blob_bordered, top_blob, weight_data_tm, bias_data, opt);
 
                 if (activation)
@@ -544,6 +582,8 @@ int ConvolutionDepthWise_x86::forward(const Mat& bottom_blob, Mat& top_blob, con
         {
             if (kernel_w == 3 && kernel_h == 3 && dilation_w == 1 && dilation_h == 1 && stride_w == 1 && stride_h == 1)
             {
+                if (opt.profiler)
+                    opt.profiler->note_kernel("convdw3x3s1_pack4");
                 convdw3x3s1_pack4_sse(bottom_blob_bordered, top_blob, weight_data_tm, bias_data, opt);
 
                 if (activation)
@@ -555,6 +595,8 @@ int ConvolutionDepthWise_x86::forward(const Mat& bottom_blob, Mat& top_blob, con
             }
             if (kernel_w == 3 && kernel_h == 3 && dilation_w == 1 && dilation_h == 1 && stride_w == 2 && stride_h == 2)
             {
+                if (opt.profiler)
+                    opt.profiler->note_kernel("convdw3x3s2_pack4");
                 convdw3x3s2_pack4_sse(bottom_blob_bordered, top_blob, weight_data_tm, bias_data, opt);
 
                 if (activation)
@@ -566,6 +608,8 @@ int ConvolutionDepthWise_x86::forward(const Mat& bottom_blob, Mat& top_blob, con
             }
             if (kernel_w == 5 && kernel_h == 5 && dilation_w == 1 && dilation_h == 1 && stride_w == 1 && stride_h == 1)
             {
+                if (opt.profiler)
+                    opt.profiler->note_kernel("convdw5x5s1_pack4");
                 convdw5x5s1_pack4_sse(bottom_blob_bordered, top_blob, weight_data_tm, bias_data, opt);
 
                 if (activation)
@@ -577,6 +621,8 @@ int ConvolutionDepthWise_x86::forward(const Mat& bottom_blob, Mat& top_blob, con
             }
             if (kernel_w == 5 && kernel_h == 5 && dilation_w == 1 && dilation_h == 1 && stride_w == 2 && stride_h == 2)
             {
+                if (opt.profiler)
+                    opt.profiler->note_kernel("convdw5x5s2_pack4");
                 convdw5x5s2_pack4_sse(bottom_blob_bordered, top_blob, weight_data_tm, bias_data, opt);
 
                 if (activation)
@@ -653,6 +699,8 @@ int ConvolutionDepthWise_x86::forward(const Mat& bottom_blob, Mat& top_blob, con
         {
             if (kernel_w == 3 && kernel_h == 3 && dilation_w == 1 && dilation_h == 1 && stride_w == 1 && stride_h == 1)
             {
+                if (opt.profiler)
+                    opt.profiler->note_kernel("convdw3x3s1");
                 convdw3x3s1_sse(bottom_blob_bordered, top_blob, weight_data_tm, bias_data, opt);
 
                 if (activation)
@@ -664,6 +712,8 @@ int ConvolutionDepthWise_x86::forward(const Mat& bottom_blob, Mat& top_blob, con
             }
             if (kernel_w == 3 && kernel_h == 3 && dilation_w == 1 && dilation_h == 1 && stride_w == 2 && stride_h == 2)
             {
+                if (opt.profiler)
+                    opt.profiler->note_kernel("convdw3x3s2");
                 convdw3x3s2_sse(bottom_blob_bordered, top_blob, weight_data_tm, bias_data, opt);
 
                 if (activation)
@@ -823,6 +873,69 @@ int ConvolutionDepthWise_x86::forward(const std::vector<Mat>& bottom_blobs, std:
     return 0;
 }
 
+#if NCNN_BF16
+int ConvolutionDepthWise_x86::forward_bf16s(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    // composite layers may still feed fp32 blobs into a bf16 pipeline
+    const bool input_bf16 = bottom_blob.elembits() == 16;
+
+    int out_elempack = 1;
+#if __SSE2__
+    if (opt.use_packing_layout)
+    {
+#if __AVX512F__
+        out_elempack = num_output % 16 == 0 ? 16 : num_output % 8 == 0 ? 8 : num_output % 4 == 0 ? 4 : 1;
+#elif __AVX__
+        out_elempack = num_output % 8 == 0 ? 8 : num_output % 4 == 0 ? 4 : 1;
+#else
+        out_elempack = num_output % 4 == 0 ? 4 : 1;
+#endif
+    }
+#endif // __SSE2__
+
+    Option opt_ws = opt;
+    opt_ws.blob_allocator = opt.workspace_allocator;
+
+    // the kernel reads fp32 in the output packing, widen the input once before padding
+    Mat bottom_blob_fp32 = bottom_blob;
+    if (input_bf16)
+    {
+        cast_bfloat16_to_float32(bottom_blob, bottom_blob_fp32, opt_ws);
+        if (bottom_blob_fp32.empty())
+            return -100;
+    }
+    if (bottom_blob_fp32.elempack != out_elempack)
+    {
+        Mat bottom_blob_packed;
+        convert_packing(bottom_blob_fp32, bottom_blob_packed, out_elempack, opt_ws);
+        if (bottom_blob_packed.empty())
+            return -100;
+
+        bottom_blob_fp32 = bottom_blob_packed;
+    }
+
+    const int kernel_extent_w = dilation_w * (kernel_w - 1) + 1;
+    const int kernel_extent_h = dilation_h * (kernel_h - 1) + 1;
+
+    Mat bottom_blob_bordered;
+    make_padding(bottom_blob_fp32, bottom_blob_bordered, opt);
+    if (bottom_blob_bordered.empty())
+        return -100;
+
+    const int outw = (bottom_blob_bordered.w - kernel_extent_w) / stride_w + 1;
+    const int outh = (bottom_blob_bordered.h - kernel_extent_h) / stride_h + 1;
+    const size_t out_elemsize = (input_bf16 ? 2u : 4u) * out_elempack;
+
+    top_blob.create(outw, outh, num_output / out_elempack, out_elemsize, out_elempack, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    convolutiondepthwise_bf16s(bottom_blob_bordered, top_blob, weight_data_tm, bias_data, kernel_w, kernel_h, dilation_w, dilation_h, stride_w, stride_h, activation_type, activation_params, opt);
+
+    return 0;
+}
+#endif // NCNN_BF16
+
 #if NCNN_INT8
 int ConvolutionDepthWise_x86::create_pipeline_int8_x86(const Option& opt)
 {
@@ -1070,6 +1183,8 @@ int ConvolutionDepthWise_x86::forward_int8_x86(const Mat& bottom_blob, Mat& top_
                         requantize_scales.push_back(scale_out);
                     }
 
+                    if (opt.profiler)
+                        opt.profiler->note_kernel("convdw3x3s1_int8_requant");
                     convdw3x3s1_int8_requant_sse(bottom_blob_bordered, top_blob, weight_data_tm, bias_data, requantize_scales, opt);
                 }
                 else
@@ -1082,6 +1197,8 @@ int ConvolutionDepthWise_x86::forward_int8_x86(const Mat& bottom_blob, Mat& top_
                         dequantize_scales.push_back(top_rescale);
                     }
 
+                    if (opt.profiler)
+                        opt.profiler->note_kernel("convdw3x3s1_int8_dequant");
                     convdw3x3s1_int8_dequant_sse(bottom_blob_bordered, top_blob, weight_data_tm, bias_data, dequantize_scales, opt);
                 }
 
@@ -1109,6 +1226,8 @@ int ConvolutionDepthWise_x86::forward_int8_x86(const Mat& bottom_blob, Mat& top_
                         requantize_scales.push_back(scale_out);
                     }
 
+                    if (opt.profiler)
+                        opt.profiler->note_kernel("convdw3x3s2_int8_requant");
                     convdw3x3s2_int8_requant_sse(bottom_blob_bordered, top_blob, weight_data_tm, bias_data, requantize_scales, opt);
                 }
                 else
@@ -1121,6 +1240,8 @@ int ConvolutionDepthWise_x86::forward_int8_x86(const Mat& bottom_blob, Mat& top_
                         dequantize_scales.push_back(top_rescale);
                     }
 
+                    if (opt.profiler)
+                        opt.profiler->note_kernel("convdw3x3s2_int8_dequant");
                     convdw3x3s2_int8_dequant_sse(bottom_blob_bordered, top_blob, weight_data_tm, bias_data, dequantize_scales, opt);
                 }
 
@@ -0,0 +1,210 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+// bf16 storage helpers for the fp32 tiled gemm kernels
+// operands are widened one tile at a time and the accumulated tile is narrowed on the way out,
+// so no full fp32 copy of a bf16 blob is ever made
+
+static Mat bfloat2float_tile(const Mat& A, int i, int max_ii, int k, int max_kk, float* tmp)
+{
+    // rows [i, i + max_ii) and columns [k, k + max_kk) of a bf16 matrix as fp32
+    // the packing is kept when the row range is aligned, otherwise the tile is unpacked
+    const int elempack = A.elempack;
+    const int A_hstep = A.dims == 3 ? (int)A.cstep : A.w;
+
+    const int tile_elempack = (i % elempack == 0 && max_ii % elempack == 0) ? elempack : 1;
+
+    Mat tile(max_kk, max_ii / tile_elempack, (void*)tmp, 4u * tile_elempack, tile_elempack);
+
+    if (tile_elempack == elempack)
+    {
+        for (int ii = 0; ii < max_ii / elempack; ii++)
+        {
+            const unsigned short* p0 = (const unsigned short*)A + (i / elempack + ii) * A_hstep * elempack + k * elempack;
+
+            bfloat2float_row(p0, tile.row(ii), max_kk * elempack);
+        }
+    }
+    else
+    {
+        for (int ii = 0; ii < max_ii; ii++)
+        {
+            const unsigned short* p0 = (const unsigned short*)A + (i + ii) / elempack * A_hstep * elempack + k * elempack + (i + ii) % elempack;
+
+            float* pp = tile.row(ii);
+            for (int kk = 0; kk < max_kk; kk++)
+            {
+                pp[kk] = bfloat16_to_float32(p0[kk * elempack]);
+            }
+        }
+    }
+
+    return tile;
+}
+
+static void unpack_output_block_bf16s(const float* pp, Mat& top_blob, int i, int max_ii, int j, int max_jj, int activation_type, const Mat& activation_params)
+{
+    // pp holds max_jj columns of max_ii contiguous rows
+    const int out_elempack = top_blob.elempack;
+    const int out_hstep = top_blob.dims == 3 ? (int)top_blob.cstep : top_blob.w;
+
+    if (out_elempack == 1 || i % out_elempack != 0 || max_ii % out_elempack != 0)
+    {
+        for (int ii = 0; ii < max_ii; ii++)
+        {
+            unsigned short* p0 = (unsigned short*)top_blob + (i + ii) / out_elempack * out_hstep * out_elempack + j * out_elempack + (i + ii) % out_elempack;
+
+            for (int jj = 0; jj < max_jj; jj++)
+            {
+                float v = activation_ss(pp[jj * max_ii + ii], activation_type, activation_params);
+                p0[jj * out_elempack] = float32_to_bfloat16(v);
+            }
+        }
+        return;
+    }
+
+    for (int ii = 0; ii < max_ii; ii += out_elempack)
+    {
+        unsigned short* p0 = (unsigned short*)top_blob + (i + ii) / out_elempack * out_hstep * out_elempack + j * out_elempack;
+
+        const float* p = pp + ii;
+
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+        if (out_elempack == 16)
+        {
+            for (int jj = 0; jj < max_jj; jj++)
+            {
+                __m512 _v = _mm512_loadu_ps(p + jj * max_ii);
+                _v = activation_avx512(_v, activation_type, activation_params);
+                _mm256_storeu_si256((__m256i*)(p0 + jj * 16), float2bfloat_avx512(_v));
+            }
+        }
+#endif // __AVX512F__
+        if (out_elempack == 8)
+        {
+            for (int jj = 0; jj < max_jj; jj++)
+            {
+                __m256 _v = _mm256_loadu_ps(p + jj * max_ii);
+                _v = activation_avx(_v, activation_type, activation_params);
+                _mm_storeu_si128((__m128i*)(p0 + jj * 8), float2bfloat_avx(_v));
+            }
+        }
+#endif // __AVX__
+        if (out_elempack == 4)
+        {
+            for (int jj = 0; jj < max_jj; jj++)
+            {
+                __m128 _v = _mm_loadu_ps(p + jj * max_ii);
+                _v = activation_sse(_v, activation_type, activation_params);
+                _mm_storel_epi64((__m128i*)(p0 + jj * 4), float2bfloat_sse(_v, _v));
+            }
+        }
+#endif // __SSE2__
+    }
+}
+
+static void unpack_output_tile_bf16s(const Mat& topT, Mat& top_blob, int i, int max_ii, int j, int max_jj, int activation_type, const Mat& activation_params)
+{
+    // topT comes from the fp32 packed tile kernel, blocks of rows in the kernel register width
+    const float* pp = topT;
+
+    int ii = 0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    for (; ii + 15 < max_ii; ii += 16)
+    {
+        unpack_output_block_bf16s(pp, top_blob, i + ii, 16, j, max_jj, activation_type, activation_params);
+        pp += 16 * max_jj;
+    }
+#endif // __AVX512F__
+    for (; ii + 7 < max_ii; ii += 8)
+    {
+        unpack_output_block_bf16s(pp, top_blob, i + ii, 8, j, max_jj, activation_type, activation_params);
+        pp += 8 * max_jj;
+    }
+#endif // __AVX__
+    for (; ii + 3 < max_ii; ii += 4)
+    {
+        unpack_output_block_bf16s(pp, top_blob, i + ii, 4, j, max_jj, activation_type, activation_params);
+        pp += 4 * max_jj;
+    }
+#endif // __SSE2__
+    for (; ii + 1 < max_ii; ii += 2)
+    {
+        unpack_output_block_bf16s(pp, top_blob, i + ii, 2, j, max_jj, activation_type, activation_params);
+        pp += 2 * max_jj;
+    }
+    for (; ii < max_ii; ii += 1)
+    {
+        unpack_output_block_bf16s(pp, top_blob, i + ii, 1, j, max_jj, activation_type, activation_params);
+        pp += max_jj;
+    }
+}
+
+static void transpose_unpack_output_block_bf16s(const float* pp, Mat& top_blob, int i, int max_ii, int j, int max_jj)
+{
+    const int out_elempack = top_blob.elempack;
+    const int out_hstep = top_blob.dims == 3 ? (int)top_blob.cstep : top_blob.w;
+
+    for (int jj = 0; jj < max_jj; jj++)
+    {
+        unsigned short* p0 = (unsigned short*)top_blob + (j + jj) / out_elempack * out_hstep * out_elempack + i * out_elempack + (j + jj) % out_elempack;
+
+        for (int ii = 0; ii < max_ii; ii++)
+        {
+            p0[ii * out_elempack] = float32_to_bfloat16(pp[jj * max_ii + ii]);
+        }
+    }
+}
+
+static void transpose_unpack_output_tile_bf16s(const Mat& topT, Mat& top_blob, int i, int max_ii, int j, int max_jj)
+{
+    const float* pp = topT;
+
+    int ii = 0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    for (; ii + 15 < max_ii; ii += 16)
+    {
+        transpose_unpack_output_block_bf16s(pp, top_blob, i + ii, 16, j, max_jj);
+        pp += 16 * max_jj;
+    }
+#endif // __AVX512F__
+    for (; ii + 7 < max_ii; ii += 8)
+    {
+        transpose_unpack_output_block_bf16s(pp, top_blob, i + ii, 8, j, max_jj);
+        pp += 8 * max_jj;
+    }
+#endif // __AVX__
+    for (; ii + 3 < max_ii; ii += 4)
+    {
+        transpose_unpack_output_block_bf16s(pp, top_blob, i + ii, 4, j, max_jj);
+        pp += 4 * max_jj;
+    }
+#endif // __SSE2__
+    for (; ii + 1 < max_ii; ii += 2)
+    {
+        transpose_unpack_output_block_bf16s(pp, top_blob, i + ii, 2, j, max_jj);
+        pp += 2 * max_jj;
+    }
+    for (; ii < max_ii; ii += 1)
+    {
+        transpose_unpack_output_block_bf16s(pp, top_blob, i + ii, 1, j, max_jj);
+        pp += max_jj;
+    }
+}
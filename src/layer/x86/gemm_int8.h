@@ -0,0 +1,498 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#if NCNN_RUNTIME_CPU && NCNN_AVX512VNNI && __AVX512F__ && !__AVX512VNNI__
+void gemm_int8_dot_tile_avx512vnni(const signed char* pA, int A_hstep, int max_ii, const unsigned char* pB, int KK, int* outptr);
+#endif
+
+#if NCNN_RUNTIME_CPU && NCNN_AVXVNNI && __AVX2__ && !__AVX512F__ && !__AVXVNNI__ && !__AVX512VNNI__
+void gemm_int8_dot_tile_avxvnni(const signed char* pA, int A_hstep, int max_ii, const unsigned char* pB, int KK, int* outptr);
+#endif
+
+#if NCNN_RUNTIME_CPU && NCNN_AVX2 && __AVX__ && !__AVX2__ && !__AVXVNNI__ && !__AVX512VNNI__
+void gemm_int8_dot_tile_avx2(const signed char* pA, int A_hstep, int max_ii, const unsigned char* pB, int KK, int* outptr);
+#endif
+
+// int8 gemm layout
+//   A is row-major int8, K padded to a multiple of 4 with zero
+//   B is packed into panels of 16 columns, each k4 group holds 16 columns x 4 k as uint8
+//   B is stored with +127 shift so that vnni dpbusd takes it as the unsigned operand,
+//   the shift is taken back by the 127 * row sum of A
+
+static void gemm_int8_dot_tile(const signed char* pA, int A_hstep, int max_ii, const unsigned char* pB, int KK, int* outptr)
+{
+#if NCNN_RUNTIME_CPU && NCNN_AVX512VNNI && __AVX512F__ && !__AVX512VNNI__
+    if (ncnn::cpu_support_x86_avx512_vnni())
+    {
+        gemm_int8_dot_tile_avx512vnni(pA, A_hstep, max_ii, pB, KK, outptr);
+        return;
+    }
+#endif
+
+#if NCNN_RUNTIME_CPU && NCNN_AVXVNNI && __AVX2__ && !__AVX512F__ && !__AVXVNNI__ && !__AVX512VNNI__
+    if (ncnn::cpu_support_x86_avx_vnni())
+    {
+        gemm_int8_dot_tile_avxvnni(pA, A_hstep, max_ii, pB, KK, outptr);
+        return;
+    }
+#endif
+
+#if NCNN_RUNTIME_CPU && NCNN_AVX2 && __AVX__ && !__AVX2__ && !__AVXVNNI__ && !__AVX512VNNI__
+    if (ncnn::cpu_support_x86_avx2())
+    {
+        gemm_int8_dot_tile_avx2(pA, A_hstep, max_ii, pB, KK, outptr);
+        return;
+    }
+#endif
+
+    int ii = 0;
+#if __AVX512VNNI__
+    for (; ii + 3 < max_ii; ii += 4)
+    {
+        const int* p0 = (const int*)(pA + ii * A_hstep);
+        const int* p1 = (const int*)(pA + (ii + 1) * A_hstep);
+        const int* p2 = (const int*)(pA + (ii + 2) * A_hstep);
+        const int* p3 = (const int*)(pA + (ii + 3) * A_hstep);
+        const unsigned char* pb = pB;
+
+        __m512i _sum0 = _mm512_setzero_si512();
+        __m512i _sum1 = _mm512_setzero_si512();
+        __m512i _sum2 = _mm512_setzero_si512();
+        __m512i _sum3 = _mm512_setzero_si512();
+
+        for (int kk = 0; kk < KK; kk++)
+        {
+            __m512i _b = _mm512_loadu_si512((const __m512i*)pb);
+
+            _sum0 = _mm512_dpbusd_epi32(_sum0, _b, _mm512_set1_epi32(p0[kk]));
+            _sum1 = _mm512_dpbusd_epi32(_sum1, _b, _mm512_set1_epi32(p1[kk]));
+            _sum2 = _mm512_dpbusd_epi32(_sum2, _b, _mm512_set1_epi32(p2[kk]));
+            _sum3 = _mm512_dpbusd_epi32(_sum3, _b, _mm512_set1_epi32(p3[kk]));
+
+            pb += 64;
+        }
+
+        _mm512_storeu_si512((__m512i*)(outptr + ii * 16), _sum0);
+        _mm512_storeu_si512((__m512i*)(outptr + (ii + 1) * 16), _sum1);
+        _mm512_storeu_si512((__m512i*)(outptr + (ii + 2) * 16), _sum2);
+        _mm512_storeu_si512((__m512i*)(outptr + (ii + 3) * 16), _sum3);
+    }
+    for (; ii < max_ii; ii++)
+    {
+        const int* p0 = (const int*)(pA + ii * A_hstep);
+        const unsigned char* pb = pB;
+
+        __m512i _sum0 = _mm512_setzero_si512();
+
+        for (int kk = 0; kk < KK; kk++)
+        {
+            __m512i _b = _mm512_loadu_si512((const __m512i*)pb);
+
+            _sum0 = _mm512_dpbusd_epi32(_sum0, _b, _mm512_set1_epi32(p0[kk]));
+
+            pb += 64;
+        }
+
+        _mm512_storeu_si512((__m512i*)(outptr + ii * 16), _sum0);
+    }
+#elif __AVXVNNI__
+    for (; ii + 3 < max_ii; ii += 4)
+    {
+        const int* p0 = (const int*)(pA + ii * A_hstep);
+        const int* p1 = (const int*)(pA + (ii + 1) * A_hstep);
+        const int* p2 = (const int*)(pA + (ii + 2) * A_hstep);
+        const int* p3 = (const int*)(pA + (ii + 3) * A_hstep);
+        const unsigned char* pb = pB;
+
+        __m256i _sum00 = _mm256_setzero_si256();
+        __m256i _sum01 = _mm256_setzero_si256();
+        __m256i _sum10 = _mm256_setzero_si256();
+        __m256i _sum11 = _mm256_setzero_si256();
+        __m256i _sum20 = _mm256_setzero_si256();
+        __m256i _sum21 = _mm256_setzero_si256();
+        __m256i _sum30 = _mm256_setzero_si256();
+        __m256i _sum31 = _mm256_setzero_si256();
+
+        for (int kk = 0; kk < KK; kk++)
+        {
+            __m256i _b0 = _mm256_loadu_si256((const __m256i*)pb);
+            __m256i _b1 = _mm256_loadu_si256((const __m256i*)(pb + 32));
+
+            __m256i _a0 = _mm256_set1_epi32(p0[kk]);
+            __m256i _a1 = _mm256_set1_epi32(p1[kk]);
+            __m256i _a2 = _mm256_set1_epi32(p2[kk]);
+            __m256i _a3 = _mm256_set1_epi32(p3[kk]);
+
+            _sum00 = _mm256_dpbusd_epi32(_sum00, _b0, _a0);
+            _sum01 = _mm256_dpbusd_epi32(_sum01, _b1, _a0);
+            _sum10 = _mm256_dpbusd_epi32(_sum10, _b0, _a1);
+            _sum11 = _mm256_dpbusd_epi32(_sum11, _b1, _a1);
+            _sum20 = _mm256_dpbusd_epi32(_sum20, _b0, _a2);
+            _sum21 = _mm256_dpbusd_epi32(_sum21, _b1, _a2);
+            _sum30 = _mm256_dpbusd_epi32(_sum30, _b0, _a3);
+            _sum31 = _mm256_dpbusd_epi32(_sum31, _b1, _a3);
+
+            pb += 64;
+        }
+
+        _mm256_storeu_si256((__m256i*)(outptr + ii * 16), _sum00);
+        _mm256_storeu_si256((__m256i*)(outptr + ii * 16 + 8), _sum01);
+        _mm256_storeu_si256((__m256i*)(outptr + (ii + 1) * 16), _sum10);
+        _mm256_storeu_si256((__m256i*)(outptr + (ii + 1) * 16 + 8), _sum11);
+        _mm256_storeu_si256((__m256i*)(outptr + (ii + 2) * 16), _sum20);
+        _mm256_storeu_si256((__m256i*)(outptr + (ii + 2) * 16 + 8), _sum21);
+        _mm256_storeu_si256((__m256i*)(outptr + (ii + 3) * 16), _sum30);
+        _mm256_storeu_si256((__m256i*)(outptr + (ii + 3) * 16 + 8), _sum31);
+    }
+    for (; ii < max_ii; ii++)
+    {
+        const int* p0 = (const int*)(pA + ii * A_hstep);
+        const unsigned char* pb = pB;
+
+        __m256i _sum00 = _mm256_setzero_si256();
+        __m256i _sum01 = _mm256_setzero_si256();
+
+        for (int kk = 0; kk < KK; kk++)
+        {
+            __m256i _b0 = _mm256_loadu_si256((const __m256i*)pb);
+            __m256i _b1 = _mm256_loadu_si256((const __m256i*)(pb + 32));
+
+            __m256i _a0 = _mm256_set1_epi32(p0[kk]);
+
+            _sum00 = _mm256_dpbusd_epi32(_sum00, _b0, _a0);
+            _sum01 = _mm256_dpbusd_epi32(_sum01, _b1, _a0);
+
+            pb += 64;
+        }
+
+        _mm256_storeu_si256((__m256i*)(outptr + ii * 16), _sum00);
+        _mm256_storeu_si256((__m256i*)(outptr + ii * 16 + 8), _sum01);
+    }
+#elif __AVX2__
+    // widen to int16 and madd, each int32 lane holds half of the k4 group
+    // hadd the two halves at the end
+    for (; ii + 1 < max_ii; ii += 2)
+    {
+        const int* p0 = (const int*)(pA + ii * A_hstep);
+        const int* p1 = (const int*)(pA + (ii + 1) * A_hstep);
+        const unsigned char* pb = pB;
+
+        __m256i _sum00 = _mm256_setzero_si256();
+        __m256i _sum01 = _mm256_setzero_si256();
+        __m256i _sum02 = _mm256_setzero_si256();
+        __m256i _sum03 = _mm256_setzero_si256();
+        __m256i _sum10 = _mm256_setzero_si256();
+        __m256i _sum11 = _mm256_setzero_si256();
+        __m256i _sum12 = _mm256_setzero_si256();
+        __m256i _sum13 = _mm256_setzero_si256();
+
+        for (int kk = 0; kk < KK; kk++)
+        {
+            __m256i _b0 = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)pb));
+            __m256i _b1 = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(pb + 16)));
+            __m256i _b2 = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(pb + 32)));
+            __m256i _b3 = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(pb + 48)));
+
+            __m256i _a0 = _mm256_broadcastq_epi64(_mm_cvtepi8_epi16(_mm_cvtsi32_si128(p0[kk])));
+            __m256i _a1 = _mm256_broadcastq_epi64(_mm_cvtepi8_epi16(_mm_cvtsi32_si128(p1[kk])));
+
+            _sum00 = _mm256_add_epi32(_sum00, _mm256_madd_epi16(_b0, _a0));
+            _sum01 = _mm256_add_epi32(_sum01, _mm256_madd_epi16(_b1, _a0));
+            _sum02 = _mm256_add_epi32(_sum02, _mm256_madd_epi16(_b2, _a0));
+            _sum03 = _mm256_add_epi32(_sum03, _mm256_madd_epi16(_b3, _a0));
+            _sum10 = _mm256_add_epi32(_sum10, _mm256_madd_epi16(_b0, _a1));
+            _sum11 = _mm256_add_epi32(_sum11, _mm256_madd_epi16(_b1, _a1));
+            _sum12 = _mm256_add_epi32(_sum12, _mm256_madd_epi16(_b2, _a1));
+            _sum13 = _mm256_add_epi32(_sum13, _mm256_madd_epi16(_b3, _a1));
+
+            pb += 64;
+        }
+
+        // 0 0 1 1 2 2 3 3 + 4 4 5 5 6 6 7 7 -> 0 1 4 5 2 3 6 7 -> 0 1 2 3 4 5 6 7
+        _sum00 = _mm256_permute4x64_epi64(_mm256_hadd_epi32(_sum00, _sum01), _MM_SHUFFLE(3, 1, 2, 0));
+        _sum02 = _mm256_permute4x64_epi64(_mm256_hadd_epi32(_sum02, _sum03), _MM_SHUFFLE(3, 1, 2, 0));
+        _sum10 = _mm256_permute4x64_epi64(_mm256_hadd_epi32(_sum10, _sum11), _MM_SHUFFLE(3, 1, 2, 0));
+        _sum12 = _mm256_permute4x64_epi64(_mm256_hadd_epi32(_sum12, _sum13), _MM_SHUFFLE(3, 1, 2, 0));
+
+        _mm256_storeu_si256((__m256i*)(outptr + ii * 16), _sum00);
+        _mm256_storeu_si256((__m256i*)(outptr + ii * 16 + 8), _sum02);
+        _mm256_storeu_si256((__m256i*)(outptr + (ii + 1) * 16), _sum10);
+        _mm256_storeu_si256((__m256i*)(outptr + (ii + 1) * 16 + 8), _sum12);
+    }
+    for (; ii < max_ii; ii++)
+    {
+        const int* p0 = (const int*)(pA + ii * A_hstep);
+        const unsigned char* pb = pB;
+
+        __m256i _sum00 = _mm256_setzero_si256();
+        __m256i _sum01 = _mm256_setzero_si256();
+        __m256i _sum02 = _mm256_setzero_si256();
+        __m256i _sum03 = _mm256_setzero_si256();
+
+        for (int kk = 0; kk < KK; kk++)
+        {
+            __m256i _b0 = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)pb));
+            __m256i _b1 = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(pb + 16)));
+            __m256i _b2 = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(pb + 32)));
+            __m256i _b3 = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(pb + 48)));
+
+            __m256i _a0 = _mm256_broadcastq_epi64(_mm_cvtepi8_epi16(_mm_cvtsi32_si128(p0[kk])));
+
+            _sum00 = _mm256_add_epi32(_sum00, _mm256_madd_epi16(_b0, _a0));
+            _sum01 = _mm256_add_epi32(_sum01, _mm256_madd_epi16(_b1, _a0));
+            _sum02 = _mm256_add_epi32(_sum02, _mm256_madd_epi16(_b2, _a0));
+            _sum03 = _mm256_add_epi32(_sum03, _mm256_madd_epi16(_b3, _a0));
+
+            pb += 64;
+        }
+
+        _sum00 = _mm256_permute4x64_epi64(_mm256_hadd_epi32(_sum00, _sum01), _MM_SHUFFLE(3, 1, 2, 0));
+        _sum02 = _mm256_permute4x64_epi64(_mm256_hadd_epi32(_sum02, _sum03), _MM_SHUFFLE(3, 1, 2, 0));
+
+        _mm256_storeu_si256((__m256i*)(outptr + ii * 16), _sum00);
+        _mm256_storeu_si256((__m256i*)(outptr + ii * 16 + 8), _sum02);
+    }
+#endif // __AVX512VNNI__ || __AVXVNNI__ || __AVX2__
+    for (; ii < max_ii; ii++)
+    {
+        const signed char* p0 = pA + ii * A_hstep;
+
+        for (int jj = 0; jj < 16; jj++)
+        {
+            const unsigned char* pb = pB + jj * 4;
+
+            int sum = 0;
+            for (int kk = 0; kk < KK; kk++)
+            {
+                sum += p0[kk * 4] * pb[kk * 64];
+                sum += p0[kk * 4 + 1] * pb[kk * 64 + 1];
+                sum += p0[kk * 4 + 2] * pb[kk * 64 + 2];
+                sum += p0[kk * 4 + 3] * pb[kk * 64 + 3];
+            }
+
+            outptr[ii * 16 + jj] = sum;
+        }
+    }
+}
+
+static void gemm_int8_quantize_A(const Mat& A, Mat& AT, Mat& AT_sums, Mat& AT_scales, int transA, int M, int K, float scale_A, const Option& opt)
+{
+    // A is int8 already if it is the constant one, otherwise fp32 to quantize per row
+    // a non-zero scale_A is the calibrated scale for all rows
+    const int A_hstep = A.dims == 3 ? (int)A.cstep : A.w;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int i = 0; i < M; i++)
+    {
+        signed char* outptr = AT.row<signed char>(i);
+
+        if (A.elemsize == 1u)
+        {
+            const signed char* ptr = A;
+            for (int k = 0; k < K; k++)
+            {
+                outptr[k] = transA ? ptr[k * A_hstep + i] : ptr[i * A_hstep + k];
+            }
+        }
+        else
+        {
+            const float* ptr = A;
+
+            float scale = scale_A;
+            if (scale == 0.f)
+            {
+                float absmax = 0.f;
+                if (transA)
+                {
+                    for (int k = 0; k < K; k++)
+                    {
+                        absmax = std::max(absmax, (float)fabs(ptr[k * A_hstep + i]));
+                    }
+                }
+                else
+                {
+                    const float* p = ptr + i * A_hstep;
+
+                    int k = 0;
+#if __AVX__
+                    const __m256 _signmask = _mm256_set1_ps(-0.f);
+                    __m256 _absmax = _mm256_setzero_ps();
+                    for (; k + 7 < K; k += 8)
+                    {
+                        _absmax = _mm256_max_ps(_absmax, _mm256_andnot_ps(_signmask, _mm256_loadu_ps(p + k)));
+                    }
+                    absmax = std::max(absmax, _mm256_reduce_max_ps(_absmax));
+#endif // __AVX__
+                    for (; k < K; k++)
+                    {
+                        absmax = std::max(absmax, (float)fabs(p[k]));
+                    }
+                }
+
+                scale = absmax == 0.f ? 1.f : 127.f / absmax;
+            }
+
+            for (int k = 0; k < K; k++)
+            {
+                const float v = transA ? ptr[k * A_hstep + i] : ptr[i * A_hstep + k];
+                outptr[k] = float2int8(v * scale);
+            }
+
+            AT_scales[i] = scale;
+        }
+
+        // zero padding to the k4 group
+        for (int k = K; k < AT.w; k++)
+        {
+            outptr[k] = 0;
+        }
+
+        int sum = 0;
+        for (int k = 0; k < K; k++)
+        {
+            sum += outptr[k];
+        }
+
+        ((int*)AT_sums)[i] = sum * 127;
+    }
+}
+
+static float gemm_int8_absmax_B(const Mat& B, int transB, int N, int K, const Option& opt)
+{
+    const int B_hstep = B.dims == 3 ? (int)B.cstep : B.w;
+
+    const int rows = transB ? N : K;
+    const int cols = transB ? K : N;
+
+    std::vector<float> absmaxs(rows, 0.f);
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int y = 0; y < rows; y++)
+    {
+        const float* ptr = (const float*)B + y * B_hstep;
+
+        float absmax = 0.f;
+        for (int x = 0; x < cols; x++)
+        {
+            absmax = std::max(absmax, (float)fabs(ptr[x]));
+        }
+
+        absmaxs[y] = absmax;
+    }
+
+    float absmax = 0.f;
+    for (int y = 0; y < rows; y++)
+    {
+        absmax = std::max(absmax, absmaxs[y]);
+    }
+
+    return absmax;
+}
+
+static void gemm_int8_pack_B(const Mat& B, Mat& BT, int transB, int N, int K, float scale_B, const Option& opt)
+{
+    // B is int8 already if it is the constant one, otherwise fp32 to quantize with scale_B
+    const int B_hstep = B.dims == 3 ? (int)B.cstep : B.w;
+
+    const int KK = BT.w / 64;
+    const int nn_N = BT.h;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int ppj = 0; ppj < nn_N; ppj++)
+    {
+        unsigned char* pb = BT.row<unsigned char>(ppj);
+
+        for (int jj = 0; jj < 16; jj++)
+        {
+            const int j = ppj * 16 + jj;
+
+            for (int k = 0; k < KK * 4; k++)
+            {
+                int v = 0;
+                if (j < N && k < K)
+                {
+                    const int offset = transB ? j * B_hstep + k : k * B_hstep + j;
+                    if (B.elemsize == 1u)
+                        v = ((const signed char*)B)[offset];
+                    else
+                        v = float2int8(((const float*)B)[offset] * scale_B);
+                }
+
+                pb[(k / 4) * 64 + jj * 4 + k % 4] = (unsigned char)(v + 127);
+            }
+        }
+    }
+}
+
+static int gemm_int8_x86(const Mat& AT, const Mat& AT_sums, const Mat& AT_scales, const Mat& BT, float scale_B, const Mat& C, Mat& top_blob, int broadcast_type_C, int M, int N, float alpha, int output_transpose, int nT)
+{
+    const int KK = AT.w / 4;
+    const int nn_N = BT.h;
+
+    // rows of A sharing one panel of B
+    const int TILE_M = 32;
+    const int nn_M = (M + TILE_M - 1) / TILE_M;
+
+    const int out_elempack = top_blob.elempack;
+    const int out_hstep = (top_blob.dims == 3 ? (int)top_blob.cstep : top_blob.w) * out_elempack;
+
+    const float* pC = C;
+
+    #pragma omp parallel for num_threads(nT)
+    for (int ppij = 0; ppij < nn_M * nn_N; ppij++)
+    {
+        const int ppi = ppij / nn_N;
+        const int ppj = ppij % nn_N;
+
+        const int i = ppi * TILE_M;
+        const int j = ppj * 16;
+
+        const int max_ii = std::min((M - i), TILE_M);
+        const int max_jj = std::min((N - j), 16);
+
+        int sums[TILE_M * 16];
+
+        gemm_int8_dot_tile(AT.row<const signed char>(i), AT.w, max_ii, BT.row<const unsigned char>(ppj), KK, sums);
+
+        for (int ii = 0; ii < max_ii; ii++)
+        {
+            const int* ps = sums + ii * 16;
+            const int sum_shift = ((const int*)AT_sums)[i + ii];
+            const float descale = alpha / (AT_scales[i + ii] * scale_B);
+
+            for (int jj = 0; jj < max_jj; jj++)
+            {
+                float v = (ps[jj] - sum_shift) * descale;
+
+                if (pC)
+                {
+                    if (broadcast_type_C == 0)
+                        v += pC[0] * alpha;
+                    if (broadcast_type_C == 1 || broadcast_type_C == 2)
+                        v += pC[i + ii] * alpha;
+                    if (broadcast_type_C == 3)
+                        v += pC[(i + ii) * N + j + jj] * alpha;
+                    if (broadcast_type_C == 4)
+                        v += pC[j + jj] * alpha;
+                }
+
+                const int r = output_transpose ? j + jj : i + ii;
+                const int c = output_transpose ? i + ii : j + jj;
+                ((float*)top_blob)[(r / out_elempack) * out_hstep + c * out_elempack + r % out_elempack] = v;
+            }
+        }
+    }
+
+    return 0;
+}
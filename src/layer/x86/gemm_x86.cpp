@@ -20,17 +20,28 @@
 #include <immintrin.h>
 #endif // __AVX__
 #endif // __SSE2__
+#include "x86_activation.h"
 #include "x86_usability.h"
 
 #include "cpu.h"
+#include "profiler.h"
 
 namespace ncnn {
 
+#if NCNN_INT8
+#include "gemm_int8.h"
+#endif
+
+#include "gemm_bf16s.h"
+
 Gemm_x86::Gemm_x86()
 {
 #if __SSE2__
     support_packing = true;
 #endif // __SSE2__
+#if NCNN_BF16
+    support_bf16_storage = true;
+#endif
 
     nT = 0;
 }
@@ -6852,8 +6863,13 @@ static int gemm_x86(const Mat& A, const Mat& B, const Mat& C, Mat& top_blob, int
     int TILE_M, TILE_N, TILE_K;
     get_optimal_tile_mnk(M, N, K, constant_TILE_M, constant_TILE_N, constant_TILE_K, TILE_M, TILE_N, TILE_K, nT);
 
+    nT = std::min(nT, opt.num_threads);
+
     // NCNN_LOGE("TILE M/N/K = %d %d %d", TILE_M, TILE_N, TILE_K);
 
+    // bf16 output goes through the fp32 topT tile
+    const bool output_bf16 = top_blob.elembits() == 16;
+
     int nn_M = (M + TILE_M - 1) / TILE_M;
     int nn_N = (N + TILE_N - 1) / TILE_N;
     int nn_K = (K + TILE_K - 1) / TILE_K;
@@ -6861,12 +6877,28 @@ static int gemm_x86(const Mat& A, const Mat& B, const Mat& C, Mat& top_blob, int
     Mat ATX(TILE_K * TILE_M, (K + TILE_K - 1) / TILE_K, nT, 4u, opt.workspace_allocator);
     if (ATX.empty())
         return -100;
+
+    Mat AX;
+    if (A.elembits() == 16)
+    {
+        AX.create(TILE_K * TILE_M, 1, nT, 4u, opt.workspace_allocator);
+        if (AX.empty())
+            return -100;
+    }
     Mat BT(TILE_K * TILE_N, (K + TILE_K - 1) / TILE_K, (N + TILE_N - 1) / TILE_N, 4u, opt.workspace_allocator);
     if (BT.empty())
         return -100;
 
     const int nn_NK = nn_N * nn_K;
 
+    Mat BX;
+    if (B.elembits() == 16)
+    {
+        BX.create(TILE_K * TILE_N, 1, nT, 4u, opt.workspace_allocator);
+        if (BX.empty())
+            return -100;
+    }
+
     // pack B
     #pragma omp parallel for num_threads(nT)
     for (int ppjk = 0; ppjk < nn_NK; ppjk++)
@@ -6882,7 +6914,20 @@ static int gemm_x86(const Mat& A, const Mat& B, const Mat& C, Mat& top_blob, int
 
         Mat BT_tile = BT.channel(j / TILE_N).row_range(k / TILE_K, 1);
 
-        if (transB)
+        if (B.elembits() == 16)
+        {
+            float* tmp = BX.channel(get_omp_thread_num());
+
+            if (transB)
+            {
+                pack_B_tile(bfloat2float_tile(B, j, max_jj, k, max_kk, tmp), BT_tile, 0, max_jj, 0, max_kk);
+            }
+            else
+            {
+                transpose_pack_B_tile(bfloat2float_tile(B, k, max_kk, j, max_jj, tmp), BT_tile, 0, max_jj, 0, max_kk);
+            }
+        }
+        else if (transB)
         {
             pack_B_tile(B, BT_tile, j, max_jj, k, max_kk);
         }
@@ -6893,7 +6938,7 @@ static int gemm_x86(const Mat& A, const Mat& B, const Mat& C, Mat& top_blob, int
     }
 
     Mat topT;
-    if (K > TILE_K || broadcast_type_C == 3 || output_transpose)
+    if (K > TILE_K || broadcast_type_C == 3 || output_transpose || output_bf16)
     {
         topT.create(TILE_N * TILE_M, 1, nT, 4u, opt.workspace_allocator);
         if (topT.empty())
@@ -6912,7 +6957,7 @@ static int gemm_x86(const Mat& A, const Mat& B, const Mat& C, Mat& top_blob, int
         const int max_ii = std::min((M - i), TILE_M);
 
         Mat topT_tile;
-        if (K > TILE_K || broadcast_type_C == 3 || output_transpose)
+        if (K > TILE_K || broadcast_type_C == 3 || output_transpose || output_bf16)
             topT_tile = topT.channel(get_omp_thread_num());
 
         for (int j = 0; j < N; j += TILE_N)
@@ -6938,7 +6983,20 @@ static int gemm_x86(const Mat& A, const Mat& B, const Mat& C, Mat& top_blob, int
 
                 if (j == 0)
                 {
-                    if (transA)
+                    if (A.elembits() == 16)
+                    {
+                        float* tmp = AX.channel(get_omp_thread_num());
+
+                        if (transA)
+                        {
+                            transpose_pack_A_tile(bfloat2float_tile(A, k, max_kk, i, max_ii, tmp), AT_tile, 0, max_ii, 0, max_kk);
+                        }
+                        else
+                        {
+                            pack_A_tile(bfloat2float_tile(A, i, max_ii, k, max_kk, tmp), AT_tile, 0, max_ii, 0, max_kk);
+                        }
+                    }
+                    else if (transA)
                     {
                         transpose_pack_A_tile(A, AT_tile, i, max_ii, k, max_kk);
                     }
@@ -6948,12 +7006,23 @@ static int gemm_x86(const Mat& A, const Mat& B, const Mat& C, Mat& top_blob, int
                     }
                 }
 
-                bool k_end = !output_transpose && k + TILE_K >= K;
+                bool k_end = !output_transpose && !output_bf16 && k + TILE_K >= K;
 
                 gemm_transB_packed_tile(AT_tile, BT_tile, CT_tile, topT_tile, top_blob, broadcast_type_C, i, max_ii, j, max_jj, k, max_kk, k_end);
             }
 
-            if (output_transpose)
+            if (output_bf16)
+            {
+                if (output_transpose)
+                {
+                    transpose_unpack_output_tile_bf16s(topT_tile, top_blob, i, max_ii, j, max_jj);
+                }
+                else
+                {
+                    unpack_output_tile_bf16s(topT_tile, top_blob, i, max_ii, j, max_jj, 0, Mat());
+                }
+            }
+            else if (output_transpose)
             {
                 transpose_unpack_output_tile(topT_tile, top_blob, i, max_ii, j, max_jj);
             }
@@ -6972,8 +7041,13 @@ static int gemm_AT_x86(const Mat& AT, const Mat& B, const Mat& C, Mat& top_blob,
     int TILE_M, TILE_N, TILE_K;
     get_optimal_tile_mnk(M, N, K, constant_TILE_M, constant_TILE_N, constant_TILE_K, TILE_M, TILE_N, TILE_K, nT);
 
+    nT = std::min(nT, opt.num_threads);
+
     // NCNN_LOGE("TILE M/N/K = %d %d %d", TILE_M, TILE_N, TILE_K);
 
+    // bf16 output goes through the fp32 topT tile
+    const bool output_bf16 = top_blob.elembits() == 16;
+
     int nn_M = (M + TILE_M - 1) / TILE_M;
     int nn_N = (N + TILE_N - 1) / TILE_N;
     int nn_K = (K + TILE_K - 1) / TILE_K;
@@ -6984,6 +7058,14 @@ static int gemm_AT_x86(const Mat& AT, const Mat& B, const Mat& C, Mat& top_blob,
 
     const int nn_NK = nn_N * nn_K;
 
+    Mat BX;
+    if (B.elembits() == 16)
+    {
+        BX.create(TILE_K * TILE_N, 1, nT, 4u, opt.workspace_allocator);
+        if (BX.empty())
+            return -100;
+    }
+
     // pack B
     #pragma omp parallel for num_threads(nT)
     for (int ppjk = 0; ppjk < nn_NK; ppjk++)
@@ -6999,7 +7081,20 @@ static int gemm_AT_x86(const Mat& AT, const Mat& B, const Mat& C, Mat& top_blob,
 
         Mat BT_tile = BT.channel(j / TILE_N).row_range(k / TILE_K, 1);
 
-        if (transB)
+        if (B.elembits() == 16)
+        {
+            float* tmp = BX.channel(get_omp_thread_num());
+
+            if (transB)
+            {
+                pack_B_tile(bfloat2float_tile(B, j, max_jj, k, max_kk, tmp), BT_tile, 0, max_jj, 0, max_kk);
+            }
+            else
+            {
+                transpose_pack_B_tile(bfloat2float_tile(B, k, max_kk, j, max_jj, tmp), BT_tile, 0, max_jj, 0, max_kk);
+            }
+        }
+        else if (transB)
         {
             pack_B_tile(B, BT_tile, j, max_jj, k, max_kk);
         }
@@ -7009,8 +7104,16 @@ static int gemm_AT_x86(const Mat& AT, const Mat& B, const Mat& C, Mat& top_blob,
         }
     }
 
+    Mat ATX;
+    if (AT.elembits() == 16)
+    {
+        ATX.create(TILE_K * TILE_M, (K + TILE_K - 1) / TILE_K, nT, 4u, opt.workspace_allocator);
+        if (ATX.empty())
+            return -100;
+    }
+
     Mat topT;
-    if (K > TILE_K || broadcast_type_C == 3 || output_transpose)
+    if (K > TILE_K || broadcast_type_C == 3 || output_transpose || output_bf16)
     {
         topT.create(TILE_N * TILE_M, 1, nT, 4u, opt.workspace_allocator);
         if (topT.empty())
@@ -7025,9 +7128,23 @@ static int gemm_AT_x86(const Mat& AT, const Mat& B, const Mat& C, Mat& top_blob,
         const int max_ii = std::min((M - i), TILE_M);
 
         Mat topT_tile;
-        if (K > TILE_K || broadcast_type_C == 3 || output_transpose)
+        if (K > TILE_K || broadcast_type_C == 3 || output_transpose || output_bf16)
             topT_tile = topT.channel(get_omp_thread_num());
 
+        Mat AT_panel = AT.channel(i / TILE_M);
+        if (AT.elembits() == 16)
+        {
+            // widen the fp16 weight panel once, it is reused for every j tile
+            Mat AT_panel_fp32 = ATX.channel(get_omp_thread_num());
+            for (int k = 0; k < K; k += TILE_K)
+            {
+                const int max_kk = std::min((K - k), TILE_K);
+
+                float16_to_float32_row(AT_panel.row<const unsigned short>(k / TILE_K), AT_panel_fp32.row(k / TILE_K), max_ii * max_kk);
+            }
+            AT_panel = AT_panel_fp32;
+        }
+
         for (int j = 0; j < N; j += TILE_N)
         {
             const int max_jj = std::min((N - j), TILE_N);
@@ -7045,16 +7162,27 @@ static int gemm_AT_x86(const Mat& AT, const Mat& B, const Mat& C, Mat& top_blob,
 
                 // NCNN_LOGE("max_ii/jj/kk = %d %d %d", max_ii, max_jj, max_kk);
 
-                Mat AT_tile = AT.channel(i / TILE_M).row_range(k / TILE_K, 1);
+                Mat AT_tile = AT_panel.row_range(k / TILE_K, 1);
 
                 Mat BT_tile = BT.channel(j / TILE_N).row_range(k / TILE_K, 1);
 
-                bool k_end = !output_transpose && k + TILE_K >= K;
+                bool k_end = !output_transpose && !output_bf16 && k + TILE_K >= K;
 
                 gemm_transB_packed_tile(AT_tile, BT_tile, CT_tile, topT_tile, top_blob, broadcast_type_C, i, max_ii, j, max_jj, k, max_kk, k_end);
             }
 
-            if (output_transpose)
+            if (output_bf16)
+            {
+                if (output_transpose)
+                {
+                    transpose_unpack_output_tile_bf16s(topT_tile, top_blob, i, max_ii, j, max_jj);
+                }
+                else
+                {
+                    unpack_output_tile_bf16s(topT_tile, top_blob, i, max_ii, j, max_jj, 0, Mat());
+                }
+            }
+            else if (output_transpose)
             {
                 transpose_unpack_output_tile(topT_tile, top_blob, i, max_ii, j, max_jj);
             }
@@ -7073,8 +7201,13 @@ static int gemm_BT_x86(const Mat& A, const Mat& BT, const Mat& C, Mat& top_blob,
     int TILE_M, TILE_N, TILE_K;
     get_optimal_tile_mnk(M, N, K, constant_TILE_M, constant_TILE_N, constant_TILE_K, TILE_M, TILE_N, TILE_K, nT);
 
+    nT = std::min(nT, opt.num_threads);
+
     // NCNN_LOGE("TILE M/N/K = %d %d %d", TILE_M, TILE_N, TILE_K);
 
+    // bf16 output goes through the fp32 topT tile
+    const bool output_bf16 = top_blob.elembits() == 16;
+
     int nn_M = (M + TILE_M - 1) / TILE_M;
     // int nn_N = (N + TILE_N - 1) / TILE_N;
 
@@ -7082,8 +7215,24 @@ static int gemm_BT_x86(const Mat& A, const Mat& BT, const Mat& C, Mat& top_blob,
     if (ATX.empty())
         return -100;
 
+    Mat AX;
+    if (A.elembits() == 16)
+    {
+        AX.create(TILE_K * TILE_M, 1, nT, 4u, opt.workspace_allocator);
+        if (AX.empty())
+            return -100;
+    }
+
+    Mat BTX;
+    if (BT.elembits() == 16)
+    {
+        BTX.create(TILE_K * TILE_N, 1, nT, 4u, opt.workspace_allocator);
+        if (BTX.empty())
+            return -100;
+    }
+
     Mat topT;
-    if (K > TILE_K || broadcast_type_C == 3 || output_transpose)
+    if (K > TILE_K || broadcast_type_C == 3 || output_transpose || output_bf16)
     {
         topT.create(TILE_N * TILE_M, 1, nT, 4u, opt.workspace_allocator);
         if (topT.empty())
@@ -7102,7 +7251,7 @@ static int gemm_BT_x86(const Mat& A, const Mat& BT, const Mat& C, Mat& top_blob,
         const int max_ii = std::min((M - i), TILE_M);
 
         Mat topT_tile;
-        if (K > TILE_K || broadcast_type_C == 3 || output_transpose)
+        if (K > TILE_K || broadcast_type_C == 3 || output_transpose || output_bf16)
             topT_tile = topT.channel(get_omp_thread_num());
 
         for (int j = 0; j < N; j += TILE_N)
@@ -7125,10 +7274,30 @@ static int gemm_BT_x86(const Mat& A, const Mat& BT, const Mat& C, Mat& top_blob,
                 Mat AT_tile = ATX.channel(get_omp_thread_num()).row_range(k / TILE_K, 1);
 
                 Mat BT_tile = BT.channel(j / TILE_N).row_range(k / TILE_K, 1);
+                if (BT.elembits() == 16)
+                {
+                    // fp16 weights are widened one panel at a time, no fp32 copy of the whole B is made
+                    Mat BT_tile_fp32 = BTX.channel(get_omp_thread_num());
+                    float16_to_float32_row(BT_tile, BT_tile_fp32, max_jj * max_kk);
+                    BT_tile = BT_tile_fp32;
+                }
 
                 if (j == 0)
                 {
-                    if (transA)
+                    if (A.elembits() == 16)
+                    {
+                        float* tmp = AX.channel(get_omp_thread_num());
+
+                        if (transA)
+                        {
+                            transpose_pack_A_tile(bfloat2float_tile(A, k, max_kk, i, max_ii, tmp), AT_tile, 0, max_ii, 0, max_kk);
+                        }
+                        else
+                        {
+                            pack_A_tile(bfloat2float_tile(A, i, max_ii, k, max_kk, tmp), AT_tile, 0, max_ii, 0, max_kk);
+                        }
+                    }
+                    else if (transA)
                     {
                         transpose_pack_A_tile(A, AT_tile, i, max_ii, k, max_kk);
                     }
@@ -7138,12 +7307,23 @@ static int gemm_BT_x86(const Mat& A, const Mat& BT, const Mat& C, Mat& top_blob,
                     }
                 }
 
-                bool k_end = !output_transpose && k + TILE_K >= K;
+                bool k_end = !output_transpose && !output_bf16 && k + TILE_K >= K;
 
                 gemm_transB_packed_tile(AT_tile, BT_tile, CT_tile, topT_tile, top_blob, broadcast_type_C, i, max_ii, j, max_jj, k, max_kk, k_end);
             }
 
-            if (output_transpose)
+            if (output_bf16)
+            {
+                if (output_transpose)
+                {
+                    transpose_unpack_output_tile_bf16s(topT_tile, top_blob, i, max_ii, j, max_jj);
+                }
+                else
+                {
+                    unpack_output_tile_bf16s(topT_tile, top_blob, i, max_ii, j, max_jj, 0, Mat());
+                }
+            }
+            else if (output_transpose)
             {
                 transpose_unpack_output_tile(topT_tile, top_blob, i, max_ii, j, max_jj);
             }
@@ -7160,13 +7340,34 @@ static int gemm_AT_BT_x86(const Mat& AT, const Mat& BT, const Mat& C, Mat& top_b
     int TILE_M, TILE_N, TILE_K;
     get_optimal_tile_mnk(M, N, K, constant_TILE_M, constant_TILE_N, constant_TILE_K, TILE_M, TILE_N, TILE_K, nT);
 
+    nT = std::min(nT, opt.num_threads);
+
     // NCNN_LOGE("TILE M/N/K = %d %d %d", TILE_M, TILE_N, TILE_K);
 
+    // bf16 output goes through the fp32 topT tile
+    const bool output_bf16 = top_blob.elembits() == 16;
+
     int nn_M = (M + TILE_M - 1) / TILE_M;
     // int nn_N = (N + TILE_N - 1) / TILE_N;
 
+    Mat ATX;
+    if (AT.elembits() == 16)
+    {
+        ATX.create(TILE_K * TILE_M, (K + TILE_K - 1) / TILE_K, nT, 4u, opt.workspace_allocator);
+        if (ATX.empty())
+            return -100;
+    }
+
+    Mat BTX;
+    if (BT.elembits() == 16)
+    {
+        BTX.create(TILE_K * TILE_N, 1, nT, 4u, opt.workspace_allocator);
+        if (BTX.empty())
+            return -100;
+    }
+
     Mat topT;
-    if (K > TILE_K || broadcast_type_C == 3 || output_transpose)
+    if (K > TILE_K || broadcast_type_C == 3 || output_transpose || output_bf16)
     {
         topT.create(TILE_N * TILE_M, 1, nT, 4u, opt.workspace_allocator);
         if (topT.empty())
@@ -7181,9 +7382,23 @@ static int gemm_AT_BT_x86(const Mat& AT, const Mat& BT, const Mat& C, Mat& top_b
         const int max_ii = std::min((M - i), TILE_M);
 
         Mat topT_tile;
-        if (K > TILE_K || broadcast_type_C == 3 || output_transpose)
+        if (K > TILE_K || broadcast_type_C == 3 || output_transpose || output_bf16)
             topT_tile = topT.channel(get_omp_thread_num());
 
+        Mat AT_panel = AT.channel(i / TILE_M);
+        if (AT.elembits() == 16)
+        {
+            // widen the fp16 weight panel once, it is reused for every j tile
+            Mat AT_panel_fp32 = ATX.channel(get_omp_thread_num());
+            for (int k = 0; k < K; k += TILE_K)
+            {
+                const int max_kk = std::min((K - k), TILE_K);
+
+                float16_to_float32_row(AT_panel.row<const unsigned short>(k / TILE_K), AT_panel_fp32.row(k / TILE_K), max_ii * max_kk);
+            }
+            AT_panel = AT_panel_fp32;
+        }
+
         for (int j = 0; j < N; j += TILE_N)
         {
             const int max_jj = std::min((N - j), TILE_N);
@@ -7201,16 +7416,34 @@ static int gemm_AT_BT_x86(const Mat& AT, const Mat& BT, const Mat& C, Mat& top_b
 
                 // NCNN_LOGE("max_ii/jj/kk = %d %d %d", max_ii, max_jj, max_kk);
 
-                Mat AT_tile = AT.channel(i / TILE_M).row_range(k / TILE_K, 1);
+                Mat AT_tile = AT_panel.row_range(k / TILE_K, 1);
 
                 Mat BT_tile = BT.channel(j / TILE_N).row_range(k / TILE_K, 1);
+                if (BT.elembits() == 16)
+                {
+                    // fp16 weights are widened one panel at a time, no fp32 copy of the whole B is made
+                    Mat BT_tile_fp32 = BTX.channel(get_omp_thread_num());
+                    float16_to_float32_row(BT_tile, BT_tile_fp32, max_jj * max_kk);
+                    BT_tile = BT_tile_fp32;
+                }
 
-                bool k_end = !output_transpose && k + TILE_K >= K;
+                bool k_end = !output_transpose && !output_bf16 && k + TILE_K >= K;
 
                 gemm_transB_packed_tile(AT_tile, BT_tile, CT_tile, topT_tile, top_blob, broadcast_type_C, i, max_ii, j, max_jj, k, max_kk, k_end);
             }
 
-            if (output_transpose)
+            if (output_bf16)
+            {
+                if (output_transpose)
+                {
+                    transpose_unpack_output_tile_bf16s(topT_tile, top_blob, i, max_ii, j, max_jj);
+                }
+                else
+                {
+                    unpack_output_tile_bf16s(topT_tile, top_blob, i, max_ii, j, max_jj, 0, Mat());
+                }
+            }
+            else if (output_transpose)
             {
                 transpose_unpack_output_tile(topT_tile, top_blob, i, max_ii, j, max_jj);
             }
@@ -7222,6 +7455,20 @@ static int gemm_AT_BT_x86(const Mat& AT, const Mat& BT, const Mat& C, Mat& top_b
 
 int Gemm_x86::create_pipeline(const Option& opt)
 {
+#if NCNN_INT8
+    if (opt.use_int8_inference && int8_scale_term)
+    {
+        support_bf16_storage = false;
+
+        // quantize the fp32 constant A/B
+        int ret = Gemm::create_pipeline(opt);
+        if (ret != 0)
+            return ret;
+
+        return create_pipeline_int8(opt);
+    }
+#endif
+
     if (constantA)
     {
         const int M = constantM;
@@ -7259,6 +7506,16 @@ int Gemm_x86::create_pipeline(const Option& opt)
             }
         }
 
+#if NCNN_F16C && __F16C__
+        if (opt.use_fp16_storage && opt.use_fp16_weight_storage)
+        {
+            // keep the packed weights in fp16, forward widens them panel by panel
+            Mat AT_data_fp16;
+            cast_float32_to_float16(AT_data, AT_data_fp16, opt);
+            AT_data = AT_data_fp16;
+        }
+#endif
+
         if (opt.lightmode)
             A_data.release();
     }
@@ -7304,6 +7561,16 @@ int Gemm_x86::create_pipeline(const Option& opt)
             }
         }
 
+#if NCNN_F16C && __F16C__
+        if (opt.use_fp16_storage && opt.use_fp16_weight_storage)
+        {
+            // keep the packed weights in fp16, forward widens them panel by panel
+            Mat BT_data_fp16;
+            cast_float32_to_float16(BT_data, BT_data_fp16, opt);
+            BT_data = BT_data_fp16;
+        }
+#endif
+
         if (opt.lightmode)
             B_data.release();
     }
@@ -7355,6 +7622,13 @@ int Gemm_x86::create_pipeline(const Option& opt)
 
 int Gemm_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
 {
+#if NCNN_INT8
+    if (opt.use_int8_inference && int8_scale_term)
+    {
+        return forward_int8(bottom_blobs, top_blobs, opt);
+    }
+#endif
+
     int M;
     int N;
     if (constantA && constantB)
@@ -7408,6 +7682,16 @@ int Gemm_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& to
             C = bottom_blobs.size() == 3 ? bottom_blobs[2] : Mat();
         }
 
+        if (!C.empty() && C.elembits() == 16)
+        {
+            Mat C_fp32;
+            cast_bfloat16_to_float32(C, C_fp32, opt);
+            if (C_fp32.empty())
+                return -100;
+
+            C = C_fp32;
+        }
+
         if (!C.empty())
         {
             if (C.dims == 1 && C.w == 1)
@@ -7476,6 +7760,10 @@ int Gemm_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& to
     if (output_elempack)
         out_elempack = output_elempack;
     size_t out_elemsize = 4u * out_elempack;
+#if NCNN_BF16
+    if (opt.use_bf16_storage && !bottom_blobs.empty() && bottom_blobs[0].elembits() == 16)
+        out_elemsize = 2u * out_elempack;
+#endif
 
     Mat& top_blob = top_blobs[0];
     if (output_transpose)
@@ -7496,39 +7784,59 @@ int Gemm_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& to
         return -100;
 
     int _nT = nT ? nT : opt.num_threads;
-    if (nT != 0 && opt.num_threads != nT)
+    if (nT != 0 && opt.num_threads > nT)
     {
-        // force num_threads the same as in create_pipeline
-        // so we could use pre-packed A/B from the same tile config
+        // pre-packed A/B comes from the tile config in create_pipeline
+        // so we could not use more threads than the load-time value
         NCNN_LOGE("opt.num_threads %d changed, gemm will use load-time value %d", opt.num_threads, nT);
     }
 
     int ret = 0;
     if (constantA && constantB)
     {
+        if (opt.profiler)
+            opt.profiler->note_kernel("gemm_AT_BT");
         ret = gemm_AT_BT_x86(AT_data, BT_data, C, top_blob, broadcast_type_C, constantM, constantN, constantK, output_transpose, constant_TILE_M, constant_TILE_N, constant_TILE_K, _nT, opt);
     }
     else if (constantA)
     {
         const Mat& B = bottom_blobs[0];
+        if (opt.profiler)
+            opt.profiler->note_kernel("gemm_AT");
         ret = gemm_AT_x86(AT_data, B, C, top_blob, broadcast_type_C, constantM, constantK, transB, output_transpose, constant_TILE_M, constant_TILE_N, constant_TILE_K, _nT, opt);
     }
     else if (constantB)
     {
         const Mat& A = bottom_blobs[0];
+        if (opt.profiler)
+            opt.profiler->note_kernel("gemm_BT");
         ret = gemm_BT_x86(A, BT_data, C, top_blob, broadcast_type_C, constantN, constantK, transA, output_transpose, constant_TILE_M, constant_TILE_N, constant_TILE_K, _nT, opt);
     }
     else
     {
         const Mat& A = bottom_blobs[0];
         const Mat& B = bottom_blobs[1];
+        if (opt.profiler)
+            opt.profiler->note_kernel("gemm");
         ret = gemm_x86(A, B, C, top_blob, broadcast_type_C, transA, transB, output_transpose, constant_TILE_M, constant_TILE_N, constant_TILE_K, _nT, opt);
     }
     if (ret != 0)
         return ret;
 
     // multiply top_blob with alpha
-    if (alpha != 1.f)
+    if (alpha != 1.f && top_blob.elembits() == 16)
+    {
+        const int size = top_blob.total() * out_elempack;
+
+        unsigned short* ptr = top_blob;
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int i = 0; i < size; i++)
+        {
+            ptr[i] = float32_to_bfloat16(bfloat16_to_float32(ptr[i]) * alpha);
+        }
+    }
+    else if (alpha != 1.f)
     {
         const int size = top_blob.total() * out_elempack;
 
@@ -7542,4 +7850,267 @@ int Gemm_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& to
     return 0;
 }
 
+#if NCNN_INT8
+int Gemm_x86::create_pipeline_int8(const Option& opt)
+{
+    if (constantA)
+    {
+        const int M = constantM;
+        const int K = constantK;
+
+        AT_data.create((K + 3) / 4 * 4, M, (size_t)1u, (Allocator*)0);
+        AT_int8_sums.create(M, (size_t)4u, (Allocator*)0);
+        if (AT_data.empty() || AT_int8_sums.empty())
+            return -100;
+
+        gemm_int8_quantize_A(A_data, AT_data, AT_int8_sums, A_data_int8_scales, transA, M, K, 0.f, opt);
+
+        if (opt.lightmode)
+            A_data.release();
+    }
+
+    if (constantB)
+    {
+        const int N = constantN;
+        const int K = constantK;
+
+        BT_data.create((K + 3) / 4 * 64, (N + 15) / 16, (size_t)1u, (Allocator*)0);
+        if (BT_data.empty())
+            return -100;
+
+        gemm_int8_pack_B(B_data, BT_data, transB, N, K, B_data_int8_scale, opt);
+
+        if (opt.lightmode)
+            B_data.release();
+    }
+
+    if (constantC && constant_broadcast_type_C != -1)
+    {
+        CT_data = C_data;
+
+        // pre-multiply C with beta
+        if (beta != 1.f)
+        {
+            Mat C2;
+            C2.create_like(CT_data);
+
+            const int size = CT_data.total() * CT_data.elempack;
+            for (int i = 0; i < size; i++)
+            {
+                C2[i] = CT_data[i] * beta;
+            }
+
+            CT_data = C2;
+        }
+
+        if (opt.lightmode)
+            C_data.release();
+    }
+
+    if (constantA || constantB || constantC)
+    {
+        nT = opt.num_threads;
+    }
+
+    return 0;
+}
+
+int Gemm_x86::forward_int8(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+{
+    Option opt_unpack = opt;
+    opt_unpack.blob_allocator = opt.workspace_allocator;
+
+    // the int8 kernel reads plain fp32 inputs
+    Mat A0;
+    Mat B0;
+    if (!constantA)
+    {
+        convert_packing(bottom_blobs[0], A0, 1, opt_unpack);
+        if (A0.empty())
+            return -100;
+    }
+    if (!constantB)
+    {
+        convert_packing(constantA ? bottom_blobs[0] : bottom_blobs[1], B0, 1, opt_unpack);
+        if (B0.empty())
+            return -100;
+    }
+
+    const int M = constantA ? constantM : transA ? A0.w : (A0.dims == 3 ? A0.c : A0.h);
+    const int K = constantA ? constantK : transA ? (A0.dims == 3 ? A0.c : A0.h) : A0.w;
+    const int N = constantB ? constantN : transB ? (B0.dims == 3 ? B0.c : B0.h) : B0.w;
+
+    Mat AT;
+    Mat AT_sums;
+    Mat AT_scales;
+    if (constantA)
+    {
+        AT = AT_data;
+        AT_sums = AT_int8_sums;
+        AT_scales = A_data_int8_scales;
+    }
+    else
+    {
+        AT.create((K + 3) / 4 * 4, M, (size_t)1u, opt.workspace_allocator);
+        AT_sums.create(M, (size_t)4u, opt.workspace_allocator);
+        AT_scales.create(M, (size_t)4u, opt.workspace_allocator);
+        if (AT.empty() || AT_sums.empty() || AT_scales.empty())
+            return -100;
+
+        const float scale_A = int8_scale_term == 3 ? A_data_int8_scales[0] : 0.f;
+        gemm_int8_quantize_A(A0, AT, AT_sums, AT_scales, transA, M, K, scale_A, opt);
+    }
+
+    Mat BT;
+    float scale_B = B_data_int8_scale;
+    if (constantB)
+    {
+        BT = BT_data;
+    }
+    else
+    {
+        if (int8_scale_term != 3)
+        {
+            const float absmax = gemm_int8_absmax_B(B0, transB, N, K, opt);
+            scale_B = absmax == 0.f ? 1.f : 127.f / absmax;
+        }
+
+        BT.create((K + 3) / 4 * 64, (N + 15) / 16, (size_t)1u, opt.workspace_allocator);
+        if (BT.empty())
+            return -100;
+
+        gemm_int8_pack_B(B0, BT, transB, N, K, scale_B, opt);
+    }
+
+    Mat C;
+    int broadcast_type_C = 0;
+    if (constantC)
+    {
+        C = CT_data;
+        broadcast_type_C = constant_broadcast_type_C;
+    }
+    else
+    {
+        if (constantA && constantB)
+        {
+            C = bottom_blobs.size() == 1 ? bottom_blobs[0] : Mat();
+        }
+        else if (constantA)
+        {
+            C = bottom_blobs.size() == 2 ? bottom_blobs[1] : Mat();
+        }
+        else if (constantB)
+        {
+            C = bottom_blobs.size() == 2 ? bottom_blobs[1] : Mat();
+        }
+        else
+        {
+            C = bottom_blobs.size() == 3 ? bottom_blobs[2] : Mat();
+        }
+
+        if (!C.empty())
+        {
+            if (C.elempack != 1)
+            {
+                Mat C_unpacked;
+                convert_packing(C, C_unpacked, 1, opt_unpack);
+                if (C_unpacked.empty())
+                    return -100;
+
+                C = C_unpacked;
+            }
+
+            if (C.dims == 1 && C.w == 1)
+            {
+                // scalar
+                broadcast_type_C = 0;
+            }
+            if (C.dims == 1 && C.w == M)
+            {
+                // M
+                // auto broadcast from h to w is the ncnn-style convention
+                broadcast_type_C = 1;
+            }
+            if (C.dims == 1 && C.w == N)
+            {
+                // N
+                broadcast_type_C = 4;
+            }
+            if (C.dims == 2 && C.w == 1 && C.h == M)
+            {
+                // Mx1
+                broadcast_type_C = 2;
+            }
+            if (C.dims == 2 && C.w == N && C.h == M)
+            {
+                // MxN
+                broadcast_type_C = 3;
+            }
+            if (C.dims == 2 && C.w == N && C.h == 1)
+            {
+                // 1xN
+                broadcast_type_C = 4;
+            }
+
+            // pre-multiply C with beta
+            if (beta != 1.f)
+            {
+                Mat C2;
+                C2.create_like(C, opt.workspace_allocator);
+
+                const int size = C.total();
+                for (int i = 0; i < size; i++)
+                {
+                    C2[i] = C[i] * beta;
+                }
+
+                C = C2;
+            }
+        }
+    }
+
+    int out_elempack = 1;
+#if __SSE2__
+    if (opt.use_packing_layout)
+    {
+        int outh = output_transpose ? N : M;
+#if __AVX512F__
+        out_elempack = outh % 16 == 0 ? 16 : outh % 8 == 0 ? 8 : outh % 4 == 0 ? 4 : 1;
+#elif __AVX__
+        out_elempack = outh % 8 == 0 ? 8 : outh % 4 == 0 ? 4 : 1;
+#else
+        out_elempack = outh % 4 == 0 ? 4 : 1;
+#endif
+    }
+#endif // __SSE2__
+    if (output_elempack)
+        out_elempack = output_elempack;
+    size_t out_elemsize = 4u * out_elempack;
+
+    Mat& top_blob = top_blobs[0];
+    if (output_transpose)
+    {
+        if (output_N1M)
+            top_blob.create(M, 1, N / out_elempack, out_elemsize, out_elempack, opt.blob_allocator);
+        else
+            top_blob.create(M, N / out_elempack, out_elemsize, out_elempack, opt.blob_allocator);
+    }
+    else
+    {
+        if (output_N1M)
+            top_blob.create(N, 1, M / out_elempack, out_elemsize, out_elempack, opt.blob_allocator);
+        else
+            top_blob.create(N, M / out_elempack, out_elemsize, out_elempack, opt.blob_allocator);
+    }
+    if (top_blob.empty())
+        return -100;
+
+    int _nT = nT ? nT : opt.num_threads;
+
+    if (opt.profiler)
+        opt.profiler->note_kernel("gemm_int8");
+    return gemm_int8_x86(AT, AT_sums, AT_scales, BT, scale_B, C, top_blob, broadcast_type_C, M, N, alpha, output_transpose, _nT);
+}
+#endif // NCNN_INT8
+
 } // namespace ncnn
@@ -28,11 +28,22 @@ public:
 
     virtual int forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const;
 
+protected:
+#if NCNN_INT8
+    int create_pipeline_int8(const Option& opt);
+    int forward_int8(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const;
+#endif
+
 public:
     int nT;
     Mat AT_data;
     Mat BT_data;
     Mat CT_data;
+
+#if NCNN_INT8
+    // 127 * row sums of int8 A
+    Mat AT_int8_sums;
+#endif
 };
 
 } // namespace ncnn
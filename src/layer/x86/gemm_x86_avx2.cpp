@@ -0,0 +1,28 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "cpu.h"
+#include "mat.h"
+#include "x86_usability.h"
+
+namespace ncnn {
+
+#include "gemm_int8.h"
+
+void gemm_int8_dot_tile_avx2(const signed char* pA, int A_hstep, int max_ii, const unsigned char* pB, int KK, int* outptr)
+{
+    gemm_int8_dot_tile(pA, A_hstep, max_ii, pB, KK, outptr);
+}
+
+} // namespace ncnn
@@ -0,0 +1,570 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#if NCNN_RUNTIME_CPU && NCNN_AVX512VNNI && __AVX512F__ && !__AVX512VNNI__
+void gru_int8_avx512vnni(const Mat& bottom_blob_int8, const Mat& bottom_blob_int8_descales, Mat& top_blob, int reverse, const Mat& weight_data_tm, const Mat& weight_data_tm_int8_descales, const Mat& bias_c, Mat& hidden_state, const Option& opt);
+#endif
+
+#if NCNN_RUNTIME_CPU && NCNN_AVX2 && __AVX__ && !__AVX2__
+void gru_transform_weight_int8_avx2(const Mat& weight_xc, const Mat& weight_xc_int8_scales, const Mat& weight_hc, const Mat& weight_hc_int8_scales, const Mat& bias_c, Mat& weight_data_tm, Mat& weight_data_tm_int8_descales, Mat& bias_c_tm, int size, int num_output, int num_directions, const Option& opt);
+void gru_int8_avx2(const Mat& bottom_blob_int8, const Mat& bottom_blob_int8_descales, Mat& top_blob, int reverse, const Mat& weight_data_tm, const Mat& weight_data_tm_int8_descales, const Mat& bias_c, Mat& hidden_state, const Option& opt);
+#endif
+
+static int gru_int8_group_width(int q, int num_output)
+{
+    // hidden units are packed in groups of the widest int32 vector that still fits
+#if __SSE2__
+#if __AVX2__
+#if __AVX512F__
+    if (q + 15 < num_output)
+        return 16;
+#endif // __AVX512F__
+    if (q + 7 < num_output)
+        return 8;
+#endif // __AVX2__
+    if (q + 3 < num_output)
+        return 4;
+#endif // __SSE2__
+    return 1;
+}
+
+static void gru_transform_weight_int8(const Mat& weight_xc, const Mat& weight_xc_int8_scales, const Mat& weight_hc, const Mat& weight_hc_int8_scales, const Mat& bias_c, Mat& weight_data_tm, Mat& weight_data_tm_int8_descales, Mat& bias_c_tm, int size, int num_output, int num_directions, const Option& opt)
+{
+#if NCNN_RUNTIME_CPU && NCNN_AVX2 && __AVX__ && !__AVX2__
+    if (ncnn::cpu_support_x86_avx2())
+    {
+        gru_transform_weight_int8_avx2(weight_xc, weight_xc_int8_scales, weight_hc, weight_hc_int8_scales, bias_c, weight_data_tm, weight_data_tm_int8_descales, bias_c_tm, size, num_output, num_directions, opt);
+        return;
+    }
+#endif
+
+    // a group of n hidden units holds
+    //   xc  for each input pair    R n*2 U n*2 N n*2
+    //   hc  for each hidden pair   R n*2 U n*2 N n*2
+    // the two weights of one unit for neighbouring inputs sit together, which is the operand order of pmaddwd
+    const int size2 = (size + 1) / 2;
+    const int num_output2 = (num_output + 1) / 2;
+
+    weight_data_tm.create((size2 + num_output2) * 2 * 3, num_output, num_directions, 1u, 1);
+    weight_data_tm_int8_descales.create(6, num_output, num_directions);
+    bias_c_tm.create(4, num_output, num_directions);
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int dr = 0; dr < num_directions; dr++)
+    {
+        const Mat weight_xc_dr = weight_xc.channel(dr);
+        const Mat weight_hc_dr = weight_hc.channel(dr);
+        const Mat bias_c_dr = bias_c.channel(dr);
+        const float* weight_xc_int8_scales_ptr = weight_xc_int8_scales.row(dr);
+        const float* weight_hc_int8_scales_ptr = weight_hc_int8_scales.row(dr);
+
+        Mat weight_data_tm_dr = weight_data_tm.channel(dr);
+        Mat bias_c_tm_dr = bias_c_tm.channel(dr);
+        Mat weight_data_tm_int8_descales_dr = weight_data_tm_int8_descales.channel(dr);
+
+        const float* bias_c_R = bias_c_dr.row(0);
+        const float* bias_c_U = bias_c_dr.row(1);
+        const float* bias_c_WN = bias_c_dr.row(2);
+        const float* bias_c_BN = bias_c_dr.row(3);
+
+        for (int q = 0; q < num_output;)
+        {
+            const int n = gru_int8_group_width(q, num_output);
+
+            float* bias_c_RUBNWN = bias_c_tm_dr.row(q);
+            float* descales_ptr = weight_data_tm_int8_descales_dr.row(q);
+            signed char* kptr = weight_data_tm_dr.row<signed char>(q);
+
+            for (int j = 0; j < n; j++)
+            {
+                bias_c_RUBNWN[j] = bias_c_R[q + j];
+                bias_c_RUBNWN[n + j] = bias_c_U[q + j];
+                bias_c_RUBNWN[n * 2 + j] = bias_c_BN[q + j];
+                bias_c_RUBNWN[n * 3 + j] = bias_c_WN[q + j];
+
+                descales_ptr[j] = 1.f / weight_xc_int8_scales_ptr[num_output * 0 + q + j];
+                descales_ptr[n + j] = 1.f / weight_xc_int8_scales_ptr[num_output * 1 + q + j];
+                descales_ptr[n * 2 + j] = 1.f / weight_xc_int8_scales_ptr[num_output * 2 + q + j];
+                descales_ptr[n * 3 + j] = 1.f / weight_hc_int8_scales_ptr[num_output * 0 + q + j];
+                descales_ptr[n * 4 + j] = 1.f / weight_hc_int8_scales_ptr[num_output * 1 + q + j];
+                descales_ptr[n * 5 + j] = 1.f / weight_hc_int8_scales_ptr[num_output * 2 + q + j];
+            }
+
+            for (int i = 0; i < size2; i++)
+            {
+                for (int g = 0; g < 3; g++)
+                {
+                    for (int j = 0; j < n; j++)
+                    {
+                        const signed char* weight_xc_ptr = weight_xc_dr.row<const signed char>(num_output * g + q + j);
+
+                        kptr[0] = weight_xc_ptr[i * 2];
+                        kptr[1] = i * 2 + 1 < size ? weight_xc_ptr[i * 2 + 1] : 0;
+                        kptr += 2;
+                    }
+                }
+            }
+
+            for (int i = 0; i < num_output2; i++)
+            {
+                for (int g = 0; g < 3; g++)
+                {
+                    for (int j = 0; j < n; j++)
+                    {
+                        const signed char* weight_hc_ptr = weight_hc_dr.row<const signed char>(num_output * g + q + j);
+
+                        kptr[0] = weight_hc_ptr[i * 2];
+                        kptr[1] = i * 2 + 1 < num_output ? weight_hc_ptr[i * 2 + 1] : 0;
+                        kptr += 2;
+                    }
+                }
+            }
+
+            q += n;
+        }
+    }
+}
+
+static float gru_dynamic_quantize_row(const float* ptr, int size, short* outptr)
+{
+    // quantize to int8 range and widen to int16, zero padded to an even length
+    // returns the descale
+    float absmax = 0.f;
+
+    int i = 0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    __m512 _absmax_avx512 = _mm512_setzero_ps();
+    for (; i + 15 < size; i += 16)
+    {
+        _absmax_avx512 = _mm512_max_ps(_absmax_avx512, abs512_ps(_mm512_loadu_ps(ptr + i)));
+    }
+    absmax = std::max(absmax, _mm512_comp_reduce_max_ps(_absmax_avx512));
+#endif // __AVX512F__
+    __m256 _absmax_avx = _mm256_setzero_ps();
+    for (; i + 7 < size; i += 8)
+    {
+        _absmax_avx = _mm256_max_ps(_absmax_avx, abs256_ps(_mm256_loadu_ps(ptr + i)));
+    }
+    absmax = std::max(absmax, _mm256_reduce_max_ps(_absmax_avx));
+#endif // __AVX__
+    __m128 _absmax = _mm_setzero_ps();
+    for (; i + 3 < size; i += 4)
+    {
+        _absmax = _mm_max_ps(_absmax, abs_ps(_mm_loadu_ps(ptr + i)));
+    }
+    absmax = std::max(absmax, _mm_reduce_max_ps(_absmax));
+#endif // __SSE2__
+    for (; i < size; i++)
+    {
+        absmax = std::max(absmax, (float)fabs(ptr[i]));
+    }
+
+    if (absmax == 0.f)
+    {
+        memset(outptr, 0, (size + 1) / 2 * 2 * sizeof(short));
+        return 1.f;
+    }
+
+    const float scale = 127.f / absmax;
+    for (i = 0; i < size; i++)
+    {
+        outptr[i] = float2int8(ptr[i] * scale);
+    }
+    if (size % 2)
+    {
+        outptr[size] = 0;
+    }
+
+    return absmax / 127.f;
+}
+
+static void gru_gate_output(const Mat& gates, Mat& hidden_state, float* output_data)
+{
+    const int num_output = hidden_state.w;
+
+    const float* gates_U = gates.row(0);
+    const float* gates_N = gates.row(1);
+    float* hidden_ptr = hidden_state;
+
+    int q = 0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    for (; q + 15 < num_output; q += 16)
+    {
+        __m512 _U = _mm512_loadu_ps(gates_U + q);
+        __m512 _N = _mm512_loadu_ps(gates_N + q);
+        __m512 _H = _mm512_fmadd_ps(_U, _mm512_sub_ps(_mm512_loadu_ps(hidden_ptr + q), _N), _N);
+        _mm512_storeu_ps(hidden_ptr + q, _H);
+        _mm512_storeu_ps(output_data + q, _H);
+    }
+#endif // __AVX512F__
+    for (; q + 7 < num_output; q += 8)
+    {
+        __m256 _U = _mm256_loadu_ps(gates_U + q);
+        __m256 _N = _mm256_loadu_ps(gates_N + q);
+        __m256 _H = _mm256_comp_fmadd_ps(_U, _mm256_sub_ps(_mm256_loadu_ps(hidden_ptr + q), _N), _N);
+        _mm256_storeu_ps(hidden_ptr + q, _H);
+        _mm256_storeu_ps(output_data + q, _H);
+    }
+#endif // __AVX__
+    for (; q + 3 < num_output; q += 4)
+    {
+        __m128 _U = _mm_loadu_ps(gates_U + q);
+        __m128 _N = _mm_loadu_ps(gates_N + q);
+        __m128 _H = _mm_comp_fmadd_ps(_U, _mm_sub_ps(_mm_loadu_ps(hidden_ptr + q), _N), _N);
+        _mm_storeu_ps(hidden_ptr + q, _H);
+        _mm_storeu_ps(output_data + q, _H);
+    }
+#endif // __SSE2__
+    for (; q < num_output; q++)
+    {
+        float U = gates_U[q];
+        float N = gates_N[q];
+
+        float H = (1 - U) * N + U * hidden_ptr[q];
+
+        hidden_ptr[q] = H;
+        output_data[q] = H;
+    }
+}
+
+static void gru_int8(const Mat& bottom_blob_int8, const Mat& bottom_blob_int8_descales, Mat& top_blob, int reverse, const Mat& weight_data_tm, const Mat& weight_data_tm_int8_descales, const Mat& bias_c, Mat& hidden_state, const Option& opt)
+{
+#if NCNN_RUNTIME_CPU && NCNN_AVX512VNNI && __AVX512F__ && !__AVX512VNNI__
+    if (ncnn::cpu_support_x86_avx512_vnni())
+    {
+        gru_int8_avx512vnni(bottom_blob_int8, bottom_blob_int8_descales, top_blob, reverse, weight_data_tm, weight_data_tm_int8_descales, bias_c, hidden_state, opt);
+        return;
+    }
+#endif
+
+#if NCNN_RUNTIME_CPU && NCNN_AVX2 && __AVX__ && !__AVX2__
+    if (ncnn::cpu_support_x86_avx2())
+    {
+        gru_int8_avx2(bottom_blob_int8, bottom_blob_int8_descales, top_blob, reverse, weight_data_tm, weight_data_tm_int8_descales, bias_c, hidden_state, opt);
+        return;
+    }
+#endif
+
+    // bottom_blob_int8 rows hold int8 range values widened to int16
+    const int size2 = bottom_blob_int8.w / 2;
+    const int T = bottom_blob_int8.h;
+
+    const int num_output = top_blob.w;
+    const int num_output2 = (num_output + 1) / 2;
+
+    // U and N of each hidden unit
+    Mat gates(num_output, 2, 4u, opt.workspace_allocator);
+
+    Mat hidden_state_int8(num_output2 * 2, (size_t)2u, 1, opt.workspace_allocator);
+
+    // unroll
+    for (int t = 0; t < T; t++)
+    {
+        int ti = reverse ? T - 1 - t : t;
+
+        const float descale_h = gru_dynamic_quantize_row(hidden_state, num_output, hidden_state_int8);
+
+        const int* x = bottom_blob_int8.row<const int>(ti);
+        const int* hs = hidden_state_int8;
+        const float descale_x = bottom_blob_int8_descales[ti];
+
+        float* gates_U = gates.row(0);
+        float* gates_N = gates.row(1);
+
+        int remain_num_output_start = 0;
+#if __SSE2__
+#if __AVX2__
+#if __AVX512F__
+        int nn_num_output = num_output >> 4;
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int qq = 0; qq < nn_num_output; qq++)
+        {
+            const int q = qq * 16;
+
+            const signed char* kptr = weight_data_tm.row<const signed char>(q);
+            const float* descales_ptr = weight_data_tm_int8_descales.row(q);
+            const float* bias_c_RUBNWN = bias_c.row(q);
+
+            __m512i _Rx = _mm512_setzero_si512();
+            __m512i _Ux = _mm512_setzero_si512();
+            __m512i _Nx = _mm512_setzero_si512();
+            for (int i = 0; i < size2; i++)
+            {
+                __m512i _xi = _mm512_set1_epi32(x[i]);
+                __m512i _w0 = _mm512_cvtepi8_epi16(_mm256_loadu_si256((const __m256i*)kptr));
+                __m512i _w1 = _mm512_cvtepi8_epi16(_mm256_loadu_si256((const __m256i*)(kptr + 32)));
+                __m512i _w2 = _mm512_cvtepi8_epi16(_mm256_loadu_si256((const __m256i*)(kptr + 64)));
+#if __AVX512VNNI__
+                _Rx = _mm512_dpwssd_epi32(_Rx, _w0, _xi);
+                _Ux = _mm512_dpwssd_epi32(_Ux, _w1, _xi);
+                _Nx = _mm512_dpwssd_epi32(_Nx, _w2, _xi);
+#else
+                _Rx = _mm512_add_epi32(_Rx, _mm512_madd_epi16(_w0, _xi));
+                _Ux = _mm512_add_epi32(_Ux, _mm512_madd_epi16(_w1, _xi));
+                _Nx = _mm512_add_epi32(_Nx, _mm512_madd_epi16(_w2, _xi));
+#endif // __AVX512VNNI__
+                kptr += 96;
+            }
+
+            __m512i _Rh = _mm512_setzero_si512();
+            __m512i _Uh = _mm512_setzero_si512();
+            __m512i _Nh = _mm512_setzero_si512();
+            for (int i = 0; i < num_output2; i++)
+            {
+                __m512i _hi = _mm512_set1_epi32(hs[i]);
+                __m512i _w0 = _mm512_cvtepi8_epi16(_mm256_loadu_si256((const __m256i*)kptr));
+                __m512i _w1 = _mm512_cvtepi8_epi16(_mm256_loadu_si256((const __m256i*)(kptr + 32)));
+                __m512i _w2 = _mm512_cvtepi8_epi16(_mm256_loadu_si256((const __m256i*)(kptr + 64)));
+#if __AVX512VNNI__
+                _Rh = _mm512_dpwssd_epi32(_Rh, _w0, _hi);
+                _Uh = _mm512_dpwssd_epi32(_Uh, _w1, _hi);
+                _Nh = _mm512_dpwssd_epi32(_Nh, _w2, _hi);
+#else
+                _Rh = _mm512_add_epi32(_Rh, _mm512_madd_epi16(_w0, _hi));
+                _Uh = _mm512_add_epi32(_Uh, _mm512_madd_epi16(_w1, _hi));
+                _Nh = _mm512_add_epi32(_Nh, _mm512_madd_epi16(_w2, _hi));
+#endif // __AVX512VNNI__
+                kptr += 96;
+            }
+
+            __m512 _descale_x = _mm512_set1_ps(descale_x);
+            __m512 _descale_h = _mm512_set1_ps(descale_h);
+
+            __m512 _R = _mm512_loadu_ps(bias_c_RUBNWN);
+            __m512 _U = _mm512_loadu_ps(bias_c_RUBNWN + 16);
+            __m512 _N = _mm512_loadu_ps(bias_c_RUBNWN + 32);
+            _R = _mm512_fmadd_ps(_mm512_cvtepi32_ps(_Rx), _mm512_mul_ps(_descale_x, _mm512_loadu_ps(descales_ptr)), _R);
+            _U = _mm512_fmadd_ps(_mm512_cvtepi32_ps(_Ux), _mm512_mul_ps(_descale_x, _mm512_loadu_ps(descales_ptr + 16)), _U);
+            _R = _mm512_fmadd_ps(_mm512_cvtepi32_ps(_Rh), _mm512_mul_ps(_descale_h, _mm512_loadu_ps(descales_ptr + 48)), _R);
+            _U = _mm512_fmadd_ps(_mm512_cvtepi32_ps(_Uh), _mm512_mul_ps(_descale_h, _mm512_loadu_ps(descales_ptr + 64)), _U);
+            _N = _mm512_fmadd_ps(_mm512_cvtepi32_ps(_Nh), _mm512_mul_ps(_descale_h, _mm512_loadu_ps(descales_ptr + 80)), _N);
+
+            _R = sigmoid_avx512(_R);
+            _U = sigmoid_avx512(_U);
+
+            _N = _mm512_fmadd_ps(_R, _N, _mm512_loadu_ps(bias_c_RUBNWN + 48));
+            _N = _mm512_fmadd_ps(_mm512_cvtepi32_ps(_Nx), _mm512_mul_ps(_descale_x, _mm512_loadu_ps(descales_ptr + 32)), _N);
+            _N = tanh_avx512(_N);
+
+            _mm512_storeu_ps(gates_U + q, _U);
+            _mm512_storeu_ps(gates_N + q, _N);
+        }
+
+        remain_num_output_start += nn_num_output << 4;
+#endif // __AVX512F__
+        int nn_num_output_8 = (num_output - remain_num_output_start) >> 3;
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int qq = 0; qq < nn_num_output_8; qq++)
+        {
+            const int q = remain_num_output_start + qq * 8;
+
+            const signed char* kptr = weight_data_tm.row<const signed char>(q);
+            const float* descales_ptr = weight_data_tm_int8_descales.row(q);
+            const float* bias_c_RUBNWN = bias_c.row(q);
+
+            __m256i _Rx = _mm256_setzero_si256();
+            __m256i _Ux = _mm256_setzero_si256();
+            __m256i _Nx = _mm256_setzero_si256();
+            for (int i = 0; i < size2; i++)
+            {
+                __m256i _xi = _mm256_set1_epi32(x[i]);
+                __m256i _w0 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)kptr));
+                __m256i _w1 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)(kptr + 16)));
+                __m256i _w2 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)(kptr + 32)));
+                _Rx = _mm256_add_epi32(_Rx, _mm256_madd_epi16(_w0, _xi));
+                _Ux = _mm256_add_epi32(_Ux, _mm256_madd_epi16(_w1, _xi));
+                _Nx = _mm256_add_epi32(_Nx, _mm256_madd_epi16(_w2, _xi));
+                kptr += 48;
+            }
+
+            __m256i _Rh = _mm256_setzero_si256();
+            __m256i _Uh = _mm256_setzero_si256();
+            __m256i _Nh = _mm256_setzero_si256();
+            for (int i = 0; i < num_output2; i++)
+            {
+                __m256i _hi = _mm256_set1_epi32(hs[i]);
+                __m256i _w0 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)kptr));
+                __m256i _w1 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)(kptr + 16)));
+                __m256i _w2 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)(kptr + 32)));
+                _Rh = _mm256_add_epi32(_Rh, _mm256_madd_epi16(_w0, _hi));
+                _Uh = _mm256_add_epi32(_Uh, _mm256_madd_epi16(_w1, _hi));
+                _Nh = _mm256_add_epi32(_Nh, _mm256_madd_epi16(_w2, _hi));
+                kptr += 48;
+            }
+
+            __m256 _descale_x = _mm256_set1_ps(descale_x);
+            __m256 _descale_h = _mm256_set1_ps(descale_h);
+
+            __m256 _R = _mm256_loadu_ps(bias_c_RUBNWN);
+            __m256 _U = _mm256_loadu_ps(bias_c_RUBNWN + 8);
+            __m256 _N = _mm256_loadu_ps(bias_c_RUBNWN + 16);
+            _R = _mm256_comp_fmadd_ps(_mm256_cvtepi32_ps(_Rx), _mm256_mul_ps(_descale_x, _mm256_loadu_ps(descales_ptr)), _R);
+            _U = _mm256_comp_fmadd_ps(_mm256_cvtepi32_ps(_Ux), _mm256_mul_ps(_descale_x, _mm256_loadu_ps(descales_ptr + 8)), _U);
+            _R = _mm256_comp_fmadd_ps(_mm256_cvtepi32_ps(_Rh), _mm256_mul_ps(_descale_h, _mm256_loadu_ps(descales_ptr + 24)), _R);
+            _U = _mm256_comp_fmadd_ps(_mm256_cvtepi32_ps(_Uh), _mm256_mul_ps(_descale_h, _mm256_loadu_ps(descales_ptr + 32)), _U);
+            _N = _mm256_comp_fmadd_ps(_mm256_cvtepi32_ps(_Nh), _mm256_mul_ps(_descale_h, _mm256_loadu_ps(descales_ptr + 40)), _N);
+
+            _R = sigmoid_avx(_R);
+            _U = sigmoid_avx(_U);
+
+            _N = _mm256_comp_fmadd_ps(_R, _N, _mm256_loadu_ps(bias_c_RUBNWN + 24));
+            _N = _mm256_comp_fmadd_ps(_mm256_cvtepi32_ps(_Nx), _mm256_mul_ps(_descale_x, _mm256_loadu_ps(descales_ptr + 16)), _N);
+            _N = tanh_avx(_N);
+
+            _mm256_storeu_ps(gates_U + q, _U);
+            _mm256_storeu_ps(gates_N + q, _N);
+        }
+
+        remain_num_output_start += nn_num_output_8 << 3;
+#endif // __AVX2__
+        int nn_num_output_4 = (num_output - remain_num_output_start) >> 2;
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int qq = 0; qq < nn_num_output_4; qq++)
+        {
+            const int q = remain_num_output_start + qq * 4;
+
+            const signed char* kptr = weight_data_tm.row<const signed char>(q);
+            const float* descales_ptr = weight_data_tm_int8_descales.row(q);
+            const float* bias_c_RUBNWN = bias_c.row(q);
+
+            __m128i _Rx = _mm_setzero_si128();
+            __m128i _Ux = _mm_setzero_si128();
+            __m128i _Nx = _mm_setzero_si128();
+            for (int i = 0; i < size2; i++)
+            {
+                __m128i _xi = _mm_set1_epi32(x[i]);
+                __m128i _w0 = _mm_loadl_epi64((const __m128i*)kptr);
+                __m128i _w1 = _mm_loadl_epi64((const __m128i*)(kptr + 8));
+                __m128i _w2 = _mm_loadl_epi64((const __m128i*)(kptr + 16));
+#if __SSE4_1__
+                _w0 = _mm_cvtepi8_epi16(_w0);
+                _w1 = _mm_cvtepi8_epi16(_w1);
+                _w2 = _mm_cvtepi8_epi16(_w2);
+#else
+                _w0 = _mm_unpacklo_epi8(_w0, _mm_cmpgt_epi8(_mm_setzero_si128(), _w0));
+                _w1 = _mm_unpacklo_epi8(_w1, _mm_cmpgt_epi8(_mm_setzero_si128(), _w1));
+                _w2 = _mm_unpacklo_epi8(_w2, _mm_cmpgt_epi8(_mm_setzero_si128(), _w2));
+#endif
+                _Rx = _mm_add_epi32(_Rx, _mm_madd_epi16(_w0, _xi));
+                _Ux = _mm_add_epi32(_Ux, _mm_madd_epi16(_w1, _xi));
+                _Nx = _mm_add_epi32(_Nx, _mm_madd_epi16(_w2, _xi));
+                kptr += 24;
+            }
+
+            __m128i _Rh = _mm_setzero_si128();
+            __m128i _Uh = _mm_setzero_si128();
+            __m128i _Nh = _mm_setzero_si128();
+            for (int i = 0; i < num_output2; i++)
+            {
+                __m128i _hi = _mm_set1_epi32(hs[i]);
+                __m128i _w0 = _mm_loadl_epi64((const __m128i*)kptr);
+                __m128i _w1 = _mm_loadl_epi64((const __m128i*)(kptr + 8));
+                __m128i _w2 = _mm_loadl_epi64((const __m128i*)(kptr + 16));
+#if __SSE4_1__
+                _w0 = _mm_cvtepi8_epi16(_w0);
+                _w1 = _mm_cvtepi8_epi16(_w1);
+                _w2 = _mm_cvtepi8_epi16(_w2);
+#else
+                _w0 = _mm_unpacklo_epi8(_w0, _mm_cmpgt_epi8(_mm_setzero_si128(), _w0));
+                _w1 = _mm_unpacklo_epi8(_w1, _mm_cmpgt_epi8(_mm_setzero_si128(), _w1));
+                _w2 = _mm_unpacklo_epi8(_w2, _mm_cmpgt_epi8(_mm_setzero_si128(), _w2));
+#endif
+                _Rh = _mm_add_epi32(_Rh, _mm_madd_epi16(_w0, _hi));
+                _Uh = _mm_add_epi32(_Uh, _mm_madd_epi16(_w1, _hi));
+                _Nh = _mm_add_epi32(_Nh, _mm_madd_epi16(_w2, _hi));
+                kptr += 24;
+            }
+
+            __m128 _descale_x = _mm_set1_ps(descale_x);
+            __m128 _descale_h = _mm_set1_ps(descale_h);
+
+            __m128 _R = _mm_loadu_ps(bias_c_RUBNWN);
+            __m128 _U = _mm_loadu_ps(bias_c_RUBNWN + 4);
+            __m128 _N = _mm_loadu_ps(bias_c_RUBNWN + 8);
+            _R = _mm_comp_fmadd_ps(_mm_cvtepi32_ps(_Rx), _mm_mul_ps(_descale_x, _mm_loadu_ps(descales_ptr)), _R);
+            _U = _mm_comp_fmadd_ps(_mm_cvtepi32_ps(_Ux), _mm_mul_ps(_descale_x, _mm_loadu_ps(descales_ptr + 4)), _U);
+            _R = _mm_comp_fmadd_ps(_mm_cvtepi32_ps(_Rh), _mm_mul_ps(_descale_h, _mm_loadu_ps(descales_ptr + 12)), _R);
+            _U = _mm_comp_fmadd_ps(_mm_cvtepi32_ps(_Uh), _mm_mul_ps(_descale_h, _mm_loadu_ps(descales_ptr + 16)), _U);
+            _N = _mm_comp_fmadd_ps(_mm_cvtepi32_ps(_Nh), _mm_mul_ps(_descale_h, _mm_loadu_ps(descales_ptr + 20)), _N);
+
+            _R = sigmoid_sse(_R);
+            _U = sigmoid_sse(_U);
+
+            _N = _mm_comp_fmadd_ps(_R, _N, _mm_loadu_ps(bias_c_RUBNWN + 12));
+            _N = _mm_comp_fmadd_ps(_mm_cvtepi32_ps(_Nx), _mm_mul_ps(_descale_x, _mm_loadu_ps(descales_ptr + 8)), _N);
+            _N = tanh_sse(_N);
+
+            _mm_storeu_ps(gates_U + q, _U);
+            _mm_storeu_ps(gates_N + q, _N);
+        }
+
+        remain_num_output_start += nn_num_output_4 << 2;
+#endif // __SSE2__
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int q = remain_num_output_start; q < num_output; q++)
+        {
+            const signed char* kptr = weight_data_tm.row<const signed char>(q);
+            const float* descales_ptr = weight_data_tm_int8_descales.row(q);
+            const float* bias_c_RUBNWN = bias_c.row(q);
+
+            const short* x16 = (const short*)x;
+            const short* hs16 = (const short*)hs;
+
+            int Rx = 0;
+            int Ux = 0;
+            int Nx = 0;
+            for (int i = 0; i < size2; i++)
+            {
+                Rx += kptr[0] * x16[i * 2] + kptr[1] * x16[i * 2 + 1];
+                Ux += kptr[2] * x16[i * 2] + kptr[3] * x16[i * 2 + 1];
+                Nx += kptr[4] * x16[i * 2] + kptr[5] * x16[i * 2 + 1];
+                kptr += 6;
+            }
+
+            int Rh = 0;
+            int Uh = 0;
+            int Nh = 0;
+            for (int i = 0; i < num_output2; i++)
+            {
+                Rh += kptr[0] * hs16[i * 2] + kptr[1] * hs16[i * 2 + 1];
+                Uh += kptr[2] * hs16[i * 2] + kptr[3] * hs16[i * 2 + 1];
+                Nh += kptr[4] * hs16[i * 2] + kptr[5] * hs16[i * 2 + 1];
+                kptr += 6;
+            }
+
+            float R = bias_c_RUBNWN[0] + Rx * (descale_x * descales_ptr[0]) + Rh * (descale_h * descales_ptr[3]);
+            float U = bias_c_RUBNWN[1] + Ux * (descale_x * descales_ptr[1]) + Uh * (descale_h * descales_ptr[4]);
+
+            R = 1.f / (1.f + expf(-R));
+            U = 1.f / (1.f + expf(-U));
+
+            float N = bias_c_RUBNWN[2] + Nh * (descale_h * descales_ptr[5]);
+            N = bias_c_RUBNWN[3] + R * N + Nx * (descale_x * descales_ptr[2]);
+            N = tanhf(N);
+
+            gates_U[q] = U;
+            gates_N[q] = N;
+        }
+
+        // h_t := (1 - update) .* new + update .* h_{t-1}
+        gru_gate_output(gates, hidden_state, top_blob.row(ti));
+    }
+}
@@ -21,6 +21,7 @@
 #endif // __AVX__
 #endif // __SSE2__
 
+#include "x86_activation.h"
 #include "x86_usability.h"
 
 namespace ncnn {
@@ -30,10 +31,18 @@ HardSwish_x86::HardSwish_x86()
 #if __SSE2__
     support_packing = true;
 #endif // __SSE2__
+#if NCNN_BF16
+    support_bf16_storage = true;
+#endif
 }
 
 int HardSwish_x86::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
 {
+#if NCNN_BF16
+    if (opt.use_bf16_storage && bottom_top_blob.elembits() == 16)
+        return forward_inplace_bf16s(bottom_top_blob, opt);
+#endif
+
     int w = bottom_top_blob.w;
     int h = bottom_top_blob.h;
     int d = bottom_top_blob.d;
@@ -107,4 +116,16 @@ int HardSwish_x86::forward_inplace(Mat& bottom_top_blob, const Option& opt) cons
     return 0;
 }
 
+#if NCNN_BF16
+int HardSwish_x86::forward_inplace_bf16s(Mat& bottom_top_blob, const Option& opt) const
+{
+    Mat activation_params(2);
+    activation_params[0] = alpha;
+    activation_params[1] = beta;
+    activation_inplace_bf16s(bottom_top_blob, 6, activation_params, opt);
+
+    return 0;
+}
+#endif // NCNN_BF16
+
 } // namespace ncnn
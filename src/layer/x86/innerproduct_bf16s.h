@@ -0,0 +1,236 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#if NCNN_RUNTIME_CPU && NCNN_AVX512BF16 && __AVX512F__ && !__AVX512BF16__
+void innerproduct_gemm_bf16s_sse_avx512bf16(const Mat& bottom_blob, Mat& top_blob, const Mat& weight_data_tm, const Mat& bias_data, int activation_type, const Mat& activation_params, const Option& opt);
+#endif
+
+static void innerproduct_transform_kernel_bf16s_sse(const Mat& weight_data, Mat& weight_data_tm, int num_input, int num_output, int out_elempack, const Option& opt)
+{
+    // src = inch-outch
+    // dst = pb-inch/2-outch/pb-2 for pb > 1, inch-outch for pb == 1
+    // the bf16 pairs of two neighbouring inputs sit together, which is the operand order of dpbf16ps
+    Mat weight_data_bf16;
+    cast_float32_to_bfloat16(weight_data, weight_data_bf16, opt);
+
+    const unsigned short* kptr = weight_data_bf16;
+
+    if (out_elempack == 1)
+    {
+        weight_data_tm = weight_data_bf16.reshape(num_input, num_output);
+        return;
+    }
+
+    const int num_input2 = (num_input + 1) / 2;
+
+    weight_data_tm.create(num_input2 * 2, num_output / out_elempack, (size_t)2u * out_elempack, out_elempack);
+
+    for (int q = 0; q + (out_elempack - 1) < num_output; q += out_elempack)
+    {
+        unsigned short* g0 = weight_data_tm.row<unsigned short>(q / out_elempack);
+
+        for (int p = 0; p < num_input2; p++)
+        {
+            for (int j = 0; j < out_elempack; j++)
+            {
+                const unsigned short* k0 = kptr + (q + j) * num_input + p * 2;
+
+                g0[0] = k0[0];
+                g0[1] = p * 2 + 1 < num_input ? k0[1] : 0;
+                g0 += 2;
+            }
+        }
+    }
+}
+
+static void innerproduct_gemm_bf16s_sse(const Mat& bottom_blob, Mat& top_blob, const Mat& weight_data_tm, const Mat& bias_data, int activation_type, const Mat& activation_params, const Option& opt)
+{
+#if NCNN_RUNTIME_CPU && NCNN_AVX512BF16 && __AVX512F__ && !__AVX512BF16__
+    if (ncnn::cpu_support_x86_avx512_bf16())
+    {
+        innerproduct_gemm_bf16s_sse_avx512bf16(bottom_blob, top_blob, weight_data_tm, bias_data, activation_type, activation_params, opt);
+        return;
+    }
+#endif
+
+    // bottom_blob h rows of num_input bf16, top_blob h rows of num_output bf16
+    const int num_input = bottom_blob.w;
+    const int h = bottom_blob.h;
+    const int num_output = top_blob.w;
+    const int out_elempack = weight_data_tm.elempack;
+
+    const float* bias_data_ptr = bias_data;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < num_output / out_elempack; q++)
+    {
+        for (int y = 0; y < h; y++)
+        {
+            const unsigned short* m = bottom_blob.row<const unsigned short>(y);
+            const unsigned short* kptr = weight_data_tm.row<const unsigned short>(q);
+            unsigned short* outptr = top_blob.row<unsigned short>(y) + q * out_elempack;
+
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+            if (out_elempack == 16)
+            {
+                __m512 _sum = bias_data_ptr ? _mm512_loadu_ps(bias_data_ptr + q * 16) : _mm512_setzero_ps();
+
+                int i = 0;
+                for (; i + 1 < num_input; i += 2)
+                {
+                    __m512i _w = _mm512_loadu_si512((const __m512i*)kptr);
+#if __AVX512BF16__
+                    __m512i _val = _mm512_set1_epi32((int)(m[i] | ((unsigned int)m[i + 1] << 16)));
+                    _sum = _mm512_dpbf16_ps(_sum, (__m512bh)_w, (__m512bh)_val);
+#else
+                    __m512 _w0 = _mm512_castsi512_ps(_mm512_slli_epi32(_w, 16));
+                    __m512 _w1 = _mm512_castsi512_ps(_mm512_and_si512(_w, _mm512_set1_epi32((int)0xffff0000)));
+                    _sum = _mm512_fmadd_ps(_w0, _mm512_set1_ps(bfloat16_to_float32(m[i])), _sum);
+                    _sum = _mm512_fmadd_ps(_w1, _mm512_set1_ps(bfloat16_to_float32(m[i + 1])), _sum);
+#endif
+                    kptr += 32;
+                }
+                if (i < num_input)
+                {
+                    __m512 _w0 = _mm512_castsi512_ps(_mm512_slli_epi32(_mm512_loadu_si512((const __m512i*)kptr), 16));
+                    _sum = _mm512_fmadd_ps(_w0, _mm512_set1_ps(bfloat16_to_float32(m[i])), _sum);
+                }
+
+                _sum = activation_avx512(_sum, activation_type, activation_params);
+
+                _mm256_storeu_si256((__m256i*)outptr, float2bfloat_avx512(_sum));
+            }
+#endif // __AVX512F__
+            if (out_elempack == 8)
+            {
+                __m256 _sum = bias_data_ptr ? _mm256_loadu_ps(bias_data_ptr + q * 8) : _mm256_setzero_ps();
+
+                int i = 0;
+                for (; i + 1 < num_input; i += 2)
+                {
+#if __AVX512BF16__
+                    __m256i _w = _mm256_loadu_si256((const __m256i*)kptr);
+                    __m256i _val = _mm256_set1_epi32((int)(m[i] | ((unsigned int)m[i + 1] << 16)));
+                    _sum = _mm256_dpbf16_ps(_sum, (__m256bh)_w, (__m256bh)_val);
+#else
+                    __m128i _wl = _mm_loadu_si128((const __m128i*)kptr);
+                    __m128i _wh = _mm_loadu_si128((const __m128i*)(kptr + 8));
+                    __m128i _mask = _mm_set1_epi32((int)0xffff0000);
+                    __m256 _w0 = _mm256_castsi256_ps(_mm256_insertf128_si256(_mm256_castsi128_si256(_mm_slli_epi32(_wl, 16)), _mm_slli_epi32(_wh, 16), 1));
+                    __m256 _w1 = _mm256_castsi256_ps(_mm256_insertf128_si256(_mm256_castsi128_si256(_mm_and_si128(_wl, _mask)), _mm_and_si128(_wh, _mask), 1));
+                    _sum = _mm256_comp_fmadd_ps(_w0, _mm256_set1_ps(bfloat16_to_float32(m[i])), _sum);
+                    _sum = _mm256_comp_fmadd_ps(_w1, _mm256_set1_ps(bfloat16_to_float32(m[i + 1])), _sum);
+#endif
+                    kptr += 16;
+                }
+                if (i < num_input)
+                {
+                    __m128i _wl = _mm_loadu_si128((const __m128i*)kptr);
+                    __m128i _wh = _mm_loadu_si128((const __m128i*)(kptr + 8));
+                    __m256 _w0 = _mm256_castsi256_ps(_mm256_insertf128_si256(_mm256_castsi128_si256(_mm_slli_epi32(_wl, 16)), _mm_slli_epi32(_wh, 16), 1));
+                    _sum = _mm256_comp_fmadd_ps(_w0, _mm256_set1_ps(bfloat16_to_float32(m[i])), _sum);
+                }
+
+                _sum = activation_avx(_sum, activation_type, activation_params);
+
+                _mm_storeu_si128((__m128i*)outptr, float2bfloat_avx(_sum));
+            }
+#endif // __AVX__
+            if (out_elempack == 4)
+            {
+                __m128 _sum = bias_data_ptr ? _mm_loadu_ps(bias_data_ptr + q * 4) : _mm_setzero_ps();
+
+                int i = 0;
+                for (; i + 1 < num_input; i += 2)
+                {
+                    __m128i _w = _mm_loadu_si128((const __m128i*)kptr);
+#if __AVX512BF16__
+                    __m128i _val = _mm_set1_epi32((int)(m[i] | ((unsigned int)m[i + 1] << 16)));
+                    _sum = _mm_dpbf16_ps(_sum, (__m128bh)_w, (__m128bh)_val);
+#else
+                    __m128 _w0 = _mm_castsi128_ps(_mm_slli_epi32(_w, 16));
+                    __m128 _w1 = _mm_castsi128_ps(_mm_and_si128(_w, _mm_set1_epi32((int)0xffff0000)));
+                    _sum = _mm_comp_fmadd_ps(_w0, _mm_set1_ps(bfloat16_to_float32(m[i])), _sum);
+                    _sum = _mm_comp_fmadd_ps(_w1, _mm_set1_ps(bfloat16_to_float32(m[i + 1])), _sum);
+#endif
+                    kptr += 8;
+                }
+                if (i < num_input)
+                {
+                    __m128 _w0 = _mm_castsi128_ps(_mm_slli_epi32(_mm_loadu_si128((const __m128i*)kptr), 16));
+                    _sum = _mm_comp_fmadd_ps(_w0, _mm_set1_ps(bfloat16_to_float32(m[i])), _sum);
+                }
+
+                _sum = activation_sse(_sum, activation_type, activation_params);
+
+                _mm_storel_epi64((__m128i*)outptr, float2bfloat_sse(_sum, _sum));
+            }
+#endif // __SSE2__
+            if (out_elempack == 1)
+            {
+                float sum = bias_data_ptr ? bias_data_ptr[q] : 0.f;
+
+                int i = 0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+                __m512 _sum512 = _mm512_setzero_ps();
+#if __AVX512BF16__
+                for (; i + 31 < num_input; i += 32)
+                {
+                    __m512i _val = _mm512_loadu_si512((const __m512i*)(m + i));
+                    __m512i _w = _mm512_loadu_si512((const __m512i*)(kptr + i));
+                    _sum512 = _mm512_dpbf16_ps(_sum512, (__m512bh)_val, (__m512bh)_w);
+                }
+#endif // __AVX512BF16__
+                for (; i + 15 < num_input; i += 16)
+                {
+                    __m512 _val = bfloat2float_avx512(_mm256_loadu_si256((const __m256i*)(m + i)));
+                    __m512 _w = bfloat2float_avx512(_mm256_loadu_si256((const __m256i*)(kptr + i)));
+                    _sum512 = _mm512_fmadd_ps(_val, _w, _sum512);
+                }
+                sum += _mm512_comp_reduce_add_ps(_sum512);
+#endif // __AVX512F__
+                __m256 _sum256 = _mm256_setzero_ps();
+                for (; i + 7 < num_input; i += 8)
+                {
+                    __m256 _val = bfloat2float_avx(_mm_loadu_si128((const __m128i*)(m + i)));
+                    __m256 _w = bfloat2float_avx(_mm_loadu_si128((const __m128i*)(kptr + i)));
+                    _sum256 = _mm256_comp_fmadd_ps(_val, _w, _sum256);
+                }
+                sum += _mm256_reduce_add_ps(_sum256);
+#endif // __AVX__
+                __m128 _sum128 = _mm_setzero_ps();
+                for (; i + 3 < num_input; i += 4)
+                {
+                    __m128 _val = bfloat2float_sse(_mm_loadl_epi64((const __m128i*)(m + i)));
+                    __m128 _w = bfloat2float_sse(_mm_loadl_epi64((const __m128i*)(kptr + i)));
+                    _sum128 = _mm_comp_fmadd_ps(_val, _w, _sum128);
+                }
+                sum += _mm_reduce_add_ps(_sum128);
+#endif // __SSE2__
+                for (; i < num_input; i++)
+                {
+                    sum += bfloat16_to_float32(m[i]) * bfloat16_to_float32(kptr[i]);
+                }
+
+                sum = activation_ss(sum, activation_type, activation_params);
+
+                outptr[0] = float32_to_bfloat16(sum);
+            }
+        }
+    }
+}
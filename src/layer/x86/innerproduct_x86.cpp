@@ -27,6 +27,7 @@
 #include "layer_type.h"
 
 #include "cpu.h"
+#include "profiler.h"
 
 namespace ncnn {
 
@@ -40,11 +41,18 @@ namespace ncnn {
 #undef NCNN_IMPL_FP16S
 #endif
 
+#if NCNN_BF16
+#include "innerproduct_bf16s.h"
+#endif
+
 InnerProduct_x86::InnerProduct_x86()
 {
 #if __SSE2__
     support_packing = true;
 #endif // __SSE2__
+#if NCNN_BF16
+    support_bf16_storage = true;
+#endif
 
     flatten = 0;
 }
@@ -65,10 +73,18 @@ int InnerProduct_x86::create_pipeline(const Option& opt)
 #if NCNN_INT8
     if (opt.use_int8_inference && weight_data.elemsize == (size_t)1u)
     {
+        support_bf16_storage = false;
         return create_pipeline_int8_x86(opt);
     }
 #endif
 
+#if NCNN_BF16
+    if (opt.use_bf16_storage)
+    {
+        return create_pipeline_bf16s(opt);
+    }
+#endif
+
 #if NCNN_F16C && __AVX__
     if (cpu_support_x86_f16c() && opt.use_fp16_storage)
     {
@@ -107,6 +123,13 @@ int InnerProduct_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Optio
     }
 #endif
 
+#if NCNN_BF16
+    if (opt.use_bf16_storage)
+    {
+        return forward_bf16s(bottom_blob, top_blob, opt);
+    }
+#endif
+
 #if NCNN_F16C && __AVX__
     if (cpu_support_x86_f16c() && opt.use_fp16_storage)
     {
@@ -127,6 +150,8 @@ int InnerProduct_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Optio
         if (top_blob.empty())
             return -100;
 
+        if (opt.profiler)
+            opt.profiler->note_kernel("gemm");
         innerproduct_gemm_sse(bottom_blob, top_blob, weight_data_tm, bias_data, activation_type, activation_params, opt);
 
         return 0;
@@ -166,6 +191,8 @@ int InnerProduct_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Optio
     if (top_blob.empty())
         return -100;
 
+    if (opt.profiler)
+        opt.profiler->note_kernel("gemv");
     innerproduct_sse(bottom_blob_flattened, top_blob, weight_data_tm, bias_data, activation_type, activation_params, opt);
 
     return 0;
@@ -199,6 +226,8 @@ int InnerProduct_x86::forward_fp16s(const Mat& bottom_blob, Mat& top_blob, const
         if (top_blob.empty())
             return -100;
 
+        if (opt.profiler)
+            opt.profiler->note_kernel("gemm_fp16s");
         innerproduct_gemm_fp16s_sse(bottom_blob, top_blob, weight_data_tm, bias_data, activation_type, activation_params, opt);
 
         return 0;
@@ -234,12 +263,120 @@ int InnerProduct_x86::forward_fp16s(const Mat& bottom_blob, Mat& top_blob, const
     if (top_blob.empty())
         return -100;
 
+    if (opt.profiler)
+        opt.profiler->note_kernel("gemv_fp16s");
     innerproduct_fp16s_sse(bottom_blob_flattened, top_blob, weight_data_tm, bias_data, activation_type, activation_params, opt);
 
     return 0;
 }
 #endif // NCNN_F16C && __AVX__
 
+#if NCNN_BF16
+int InnerProduct_x86::create_pipeline_bf16s(const Option& opt)
+{
+    const int num_input = weight_data_size / num_output;
+
+    int out_elempack = 1;
+#if __SSE2__
+    if (opt.use_packing_layout)
+    {
+#if __AVX512F__
+        out_elempack = num_output % 16 == 0 ? 16 : num_output % 8 == 0 ? 8 : num_output % 4 == 0 ? 4 : 1;
+#elif __AVX__
+        out_elempack = num_output % 8 == 0 ? 8 : num_output % 4 == 0 ? 4 : 1;
+#else
+        out_elempack = num_output % 4 == 0 ? 4 : 1;
+#endif
+    }
+#endif // __SSE2__
+
+    innerproduct_transform_kernel_bf16s_sse(weight_data, weight_data_tm, num_input, num_output, out_elempack, opt);
+
+    if (opt.lightmode)
+        weight_data.release();
+
+    return 0;
+}
+
+int InnerProduct_x86::forward_bf16s(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    const int num_input = weight_data_size / num_output;
+
+    Option opt_ws = opt;
+    opt_ws.blob_allocator = opt.workspace_allocator;
+
+    if (bottom_blob.elembits() != 16)
+    {
+        // composite layers may still feed fp32 blobs into a bf16 pipeline
+        Mat bottom_blob_bf16;
+        cast_float32_to_bfloat16(bottom_blob, bottom_blob_bf16, opt_ws);
+        if (bottom_blob_bf16.empty())
+            return -100;
+
+        Mat top_blob_bf16;
+        int ret = forward_bf16s(bottom_blob_bf16, top_blob_bf16, opt_ws);
+        if (ret != 0)
+            return ret;
+
+        cast_bfloat16_to_float32(top_blob_bf16, top_blob, opt);
+        if (top_blob.empty())
+            return -100;
+
+        return 0;
+    }
+
+    // the kernel reads plain rows of bf16
+    Mat bottom_blob_unpacked = bottom_blob;
+    if (bottom_blob.dims != 1 && bottom_blob.elempack != 1)
+    {
+        convert_packing(bottom_blob, bottom_blob_unpacked, 1, opt_ws);
+        if (bottom_blob_unpacked.empty())
+            return -100;
+    }
+
+    if (bottom_blob.dims == 2 && bottom_blob.w == num_input)
+    {
+        // gemm
+        int h = bottom_blob_unpacked.h;
+
+        top_blob.create(num_output, h, 2u, 1, opt.blob_allocator);
+        if (top_blob.empty())
+            return -100;
+
+        if (opt.profiler)
+            opt.profiler->note_kernel("gemm_bf16s");
+        innerproduct_gemm_bf16s_sse(bottom_blob_unpacked, top_blob, weight_data_tm, bias_data, activation_type, activation_params, opt);
+
+        return 0;
+    }
+
+    // flatten, a packed 1d blob is already in element order
+    Mat bottom_blob_flattened = bottom_blob_unpacked;
+    if (bottom_blob.dims != 1)
+    {
+        bottom_blob_flattened = bottom_blob_unpacked.reshape(bottom_blob_unpacked.w * bottom_blob_unpacked.h * bottom_blob_unpacked.d * bottom_blob_unpacked.c, opt.workspace_allocator);
+        if (bottom_blob_flattened.empty())
+            return -100;
+    }
+
+    const int out_elempack = weight_data_tm.elempack;
+
+    top_blob.create(num_output / out_elempack, 2u * out_elempack, out_elempack, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    // gemv as a single row gemm
+    Mat bottom_blob_row(num_input, 1, bottom_blob_flattened.data, 2u, 1);
+    Mat top_blob_row(num_output, 1, top_blob.data, 2u, 1);
+
+    if (opt.profiler)
+        opt.profiler->note_kernel("gemv_bf16s");
+    innerproduct_gemm_bf16s_sse(bottom_blob_row, top_blob_row, weight_data_tm, bias_data, activation_type, activation_params, opt);
+
+    return 0;
+}
+#endif // NCNN_BF16
+
 #if NCNN_INT8
 int InnerProduct_x86::create_pipeline_int8_x86(const Option& opt)
 {
@@ -312,6 +449,9 @@ int InnerProduct_x86::forward_int8_x86(const Mat& bottom_blob, Mat& top_blob, co
     if (bottom_blob_int8.dims == 2 && bottom_blob_int8.w == num_input)
     {
         // gemm
+        if (opt.profiler)
+            opt.profiler->note_kernel("gemm_int8");
+
         Mat bottom_blob_int8_unpacked;
         Option opt_unpack = opt;
         opt_unpack.blob_allocator = opt.workspace_allocator;
@@ -632,6 +772,9 @@ int InnerProduct_x86::forward_int8_x86(const Mat& bottom_blob, Mat& top_blob, co
         return 0;
     }
 
+    if (opt.profiler)
+        opt.profiler->note_kernel("gemv_int8");
+
     Mat bottom_blob_int8_flattened = bottom_blob_int8;
     if (bottom_blob_int8.dims != 1)
     {
@@ -31,6 +31,9 @@ LayerNorm_x86::LayerNorm_x86()
 #if __SSE2__
     support_packing = true;
 #endif // __SSE2__
+#if NCNN_BF16
+    support_bf16_storage = true;
+#endif
 }
 
 static NCNN_FORCEINLINE void fast_mean(float* ptr, float* mean, int elempack, int elemcount, int size)
@@ -536,6 +539,11 @@ static NCNN_FORCEINLINE void fast_1d_layer_norm(float* ptr, int elempack, int el
 
 int LayerNorm_x86::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
 {
+#if NCNN_BF16
+    if (opt.use_bf16_storage && bottom_top_blob.elembits() == 16)
+        return forward_inplace_bf16s(bottom_top_blob, opt);
+#endif
+
     int dims = bottom_top_blob.dims;
     int elempack = bottom_top_blob.elempack;
     int w = bottom_top_blob.w;
@@ -591,4 +599,78 @@ int LayerNorm_x86::forward_inplace(Mat& bottom_top_blob, const Option& opt) cons
     return 0;
 }
 
+#if NCNN_BF16
+int LayerNorm_x86::forward_inplace_bf16s(Mat& bottom_top_blob, const Option& opt) const
+{
+    int dims = bottom_top_blob.dims;
+    int elempack = bottom_top_blob.elempack;
+    int w = bottom_top_blob.w;
+    int h = bottom_top_blob.h;
+    int channels = bottom_top_blob.c;
+
+    const float* gamma = gamma_data;
+    const float* beta = beta_data;
+
+    // each normalized span is widened into a per-thread fp32 scratch row and narrowed back in place
+    if (dims == 1)
+    {
+        int elemcount = w * elempack;
+
+        Mat tmp(elemcount, (size_t)4u, opt.workspace_allocator);
+        if (tmp.empty())
+            return -100;
+
+        unsigned short* ptr = bottom_top_blob;
+        bfloat2float_row(ptr, tmp, elemcount);
+        // 1D layer norm is special. Treat them as unpacked.
+        fast_1d_layer_norm(tmp, 1, elemcount, elemcount, gamma, beta, affine, eps);
+        float2bfloat_row(tmp, ptr, elemcount);
+    }
+
+    if (dims == 2)
+    {
+        Mat tmp(w * elempack, 1, opt.num_threads, (size_t)4u, opt.workspace_allocator);
+        if (tmp.empty())
+            return -100;
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int i = 0; i < h; ++i)
+        {
+            unsigned short* ptr = bottom_top_blob.row<unsigned short>(i);
+            float* tmpptr = tmp.channel(get_omp_thread_num());
+
+            bfloat2float_row(ptr, tmpptr, w * elempack);
+            fast_1d_layer_norm(tmpptr, elempack, w, w * elempack, gamma, beta, affine, eps);
+            float2bfloat_row(tmpptr, ptr, w * elempack);
+        }
+    }
+
+    if (dims == 3)
+    {
+        const int size = affine_size == w ? w : w * h;
+
+        Mat tmp(size * elempack, 1, opt.num_threads, (size_t)4u, opt.workspace_allocator);
+        if (tmp.empty())
+            return -100;
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int q = 0; q < channels; ++q)
+        {
+            float* tmpptr = tmp.channel(get_omp_thread_num());
+
+            for (int i = 0; i < w * h; i += size)
+            {
+                unsigned short* ptr = bottom_top_blob.channel(q).row<unsigned short>(0) + i * elempack;
+
+                bfloat2float_row(ptr, tmpptr, size * elempack);
+                fast_1d_layer_norm(tmpptr, elempack, size, size * elempack, gamma, beta, affine, eps);
+                float2bfloat_row(tmpptr, ptr, size * elempack);
+            }
+        }
+    }
+
+    return 0;
+}
+#endif // NCNN_BF16
+
 } // namespace ncnn
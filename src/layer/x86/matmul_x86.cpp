@@ -46,6 +46,10 @@ int MatMul_x86::create_pipeline(const Option& opt)
 
     gemm->create_pipeline(opt);
 
+#if NCNN_BF16
+    support_bf16_storage = gemm->support_bf16_storage;
+#endif
+
     return 0;
 }
 
@@ -0,0 +1,532 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+// fused attention with online softmax, the full qk score matrix is never materialized
+// each task takes a tile of queries and streams over key tiles
+//   s = q * k + mask
+//   m' = max(m, max(s))
+//   p = exp(s - m')
+//   l = l * exp(m - m') + sum(p)
+//   o = o * exp(m - m') + p * v
+// out = o / l
+
+static void flash_attention_qk(const float* qptr, const Mat& km, int embed_dim_per_head, int j0, int max_jj, float* sptr)
+{
+    // km is embed_dim_per_head rows of keys, each row contiguous along dst_seqlen
+    int jj = 0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    for (; jj + 15 < max_jj; jj += 16)
+    {
+        __m512 _sum = _mm512_setzero_ps();
+        for (int k = 0; k < embed_dim_per_head; k++)
+        {
+            __m512 _k = _mm512_loadu_ps(km.row(k) + j0 + jj);
+            _sum = _mm512_fmadd_ps(_mm512_set1_ps(qptr[k]), _k, _sum);
+        }
+        _mm512_storeu_ps(sptr + jj, _sum);
+    }
+#endif // __AVX512F__
+    for (; jj + 7 < max_jj; jj += 8)
+    {
+        __m256 _sum = _mm256_setzero_ps();
+        for (int k = 0; k < embed_dim_per_head; k++)
+        {
+            __m256 _k = _mm256_loadu_ps(km.row(k) + j0 + jj);
+            _sum = _mm256_comp_fmadd_ps(_mm256_set1_ps(qptr[k]), _k, _sum);
+        }
+        _mm256_storeu_ps(sptr + jj, _sum);
+    }
+#endif // __AVX__
+    for (; jj + 3 < max_jj; jj += 4)
+    {
+        __m128 _sum = _mm_setzero_ps();
+        for (int k = 0; k < embed_dim_per_head; k++)
+        {
+            __m128 _k = _mm_loadu_ps(km.row(k) + j0 + jj);
+            _sum = _mm_comp_fmadd_ps(_mm_set1_ps(qptr[k]), _k, _sum);
+        }
+        _mm_storeu_ps(sptr + jj, _sum);
+    }
+#endif // __SSE2__
+    for (; jj < max_jj; jj++)
+    {
+        float sum = 0.f;
+        for (int k = 0; k < embed_dim_per_head; k++)
+        {
+            sum += qptr[k] * km.row(k)[j0 + jj];
+        }
+        sptr[jj] = sum;
+    }
+}
+
+static void flash_attention_qk_4(const float* qptr, int qstride, const Mat& km, int embed_dim_per_head, int j0, int max_jj, float* sptr, int sstride)
+{
+    // four queries share each key load
+    const float* q0 = qptr;
+    const float* q1 = qptr + qstride;
+    const float* q2 = qptr + qstride * 2;
+    const float* q3 = qptr + qstride * 3;
+    float* s0 = sptr;
+    float* s1 = sptr + sstride;
+    float* s2 = sptr + sstride * 2;
+    float* s3 = sptr + sstride * 3;
+
+    int jj = 0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    for (; jj + 15 < max_jj; jj += 16)
+    {
+        __m512 _sum0 = _mm512_setzero_ps();
+        __m512 _sum1 = _mm512_setzero_ps();
+        __m512 _sum2 = _mm512_setzero_ps();
+        __m512 _sum3 = _mm512_setzero_ps();
+        for (int k = 0; k < embed_dim_per_head; k++)
+        {
+            __m512 _k = _mm512_loadu_ps(km.row(k) + j0 + jj);
+            _sum0 = _mm512_fmadd_ps(_mm512_set1_ps(q0[k]), _k, _sum0);
+            _sum1 = _mm512_fmadd_ps(_mm512_set1_ps(q1[k]), _k, _sum1);
+            _sum2 = _mm512_fmadd_ps(_mm512_set1_ps(q2[k]), _k, _sum2);
+            _sum3 = _mm512_fmadd_ps(_mm512_set1_ps(q3[k]), _k, _sum3);
+        }
+        _mm512_storeu_ps(s0 + jj, _sum0);
+        _mm512_storeu_ps(s1 + jj, _sum1);
+        _mm512_storeu_ps(s2 + jj, _sum2);
+        _mm512_storeu_ps(s3 + jj, _sum3);
+    }
+#endif // __AVX512F__
+    for (; jj + 7 < max_jj; jj += 8)
+    {
+        __m256 _sum0 = _mm256_setzero_ps();
+        __m256 _sum1 = _mm256_setzero_ps();
+        __m256 _sum2 = _mm256_setzero_ps();
+        __m256 _sum3 = _mm256_setzero_ps();
+        for (int k = 0; k < embed_dim_per_head; k++)
+        {
+            __m256 _k = _mm256_loadu_ps(km.row(k) + j0 + jj);
+            _sum0 = _mm256_comp_fmadd_ps(_mm256_set1_ps(q0[k]), _k, _sum0);
+            _sum1 = _mm256_comp_fmadd_ps(_mm256_set1_ps(q1[k]), _k, _sum1);
+            _sum2 = _mm256_comp_fmadd_ps(_mm256_set1_ps(q2[k]), _k, _sum2);
+            _sum3 = _mm256_comp_fmadd_ps(_mm256_set1_ps(q3[k]), _k, _sum3);
+        }
+        _mm256_storeu_ps(s0 + jj, _sum0);
+        _mm256_storeu_ps(s1 + jj, _sum1);
+        _mm256_storeu_ps(s2 + jj, _sum2);
+        _mm256_storeu_ps(s3 + jj, _sum3);
+    }
+#endif // __AVX__
+    for (; jj + 3 < max_jj; jj += 4)
+    {
+        __m128 _sum0 = _mm_setzero_ps();
+        __m128 _sum1 = _mm_setzero_ps();
+        __m128 _sum2 = _mm_setzero_ps();
+        __m128 _sum3 = _mm_setzero_ps();
+        for (int k = 0; k < embed_dim_per_head; k++)
+        {
+            __m128 _k = _mm_loadu_ps(km.row(k) + j0 + jj);
+            _sum0 = _mm_comp_fmadd_ps(_mm_set1_ps(q0[k]), _k, _sum0);
+            _sum1 = _mm_comp_fmadd_ps(_mm_set1_ps(q1[k]), _k, _sum1);
+            _sum2 = _mm_comp_fmadd_ps(_mm_set1_ps(q2[k]), _k, _sum2);
+            _sum3 = _mm_comp_fmadd_ps(_mm_set1_ps(q3[k]), _k, _sum3);
+        }
+        _mm_storeu_ps(s0 + jj, _sum0);
+        _mm_storeu_ps(s1 + jj, _sum1);
+        _mm_storeu_ps(s2 + jj, _sum2);
+        _mm_storeu_ps(s3 + jj, _sum3);
+    }
+#endif // __SSE2__
+    for (; jj < max_jj; jj++)
+    {
+        float sum0 = 0.f;
+        float sum1 = 0.f;
+        float sum2 = 0.f;
+        float sum3 = 0.f;
+        for (int k = 0; k < embed_dim_per_head; k++)
+        {
+            const float kv = km.row(k)[j0 + jj];
+            sum0 += q0[k] * kv;
+            sum1 += q1[k] * kv;
+            sum2 += q2[k] * kv;
+            sum3 += q3[k] * kv;
+        }
+        s0[jj] = sum0;
+        s1[jj] = sum1;
+        s2[jj] = sum2;
+        s3[jj] = sum3;
+    }
+}
+
+static float flash_attention_max(const float* sptr, int max_jj, float max)
+{
+    int jj = 0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    __m512 _max_avx512 = _mm512_set1_ps(max);
+    for (; jj + 15 < max_jj; jj += 16)
+    {
+        _max_avx512 = _mm512_max_ps(_max_avx512, _mm512_loadu_ps(sptr + jj));
+    }
+    max = std::max(max, _mm512_comp_reduce_max_ps(_max_avx512));
+#endif // __AVX512F__
+    __m256 _max_avx = _mm256_set1_ps(max);
+    for (; jj + 7 < max_jj; jj += 8)
+    {
+        _max_avx = _mm256_max_ps(_max_avx, _mm256_loadu_ps(sptr + jj));
+    }
+    max = std::max(max, _mm256_reduce_max_ps(_max_avx));
+#endif // __AVX__
+    __m128 _max = _mm_set1_ps(max);
+    for (; jj + 3 < max_jj; jj += 4)
+    {
+        _max = _mm_max_ps(_max, _mm_loadu_ps(sptr + jj));
+    }
+    max = std::max(max, _mm_reduce_max_ps(_max));
+#endif // __SSE2__
+    for (; jj < max_jj; jj++)
+    {
+        max = std::max(max, sptr[jj]);
+    }
+    return max;
+}
+
+static float flash_attention_exp_sum(float* sptr, int max_jj, float max)
+{
+    // sptr = exp(sptr - max), return the sum
+    float sum = 0.f;
+    int jj = 0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    __m512 _sum_avx512 = _mm512_setzero_ps();
+    for (; jj + 15 < max_jj; jj += 16)
+    {
+        __m512 _p = exp512_ps(_mm512_sub_ps(_mm512_loadu_ps(sptr + jj), _mm512_set1_ps(max)));
+        _mm512_storeu_ps(sptr + jj, _p);
+        _sum_avx512 = _mm512_add_ps(_sum_avx512, _p);
+    }
+    sum += _mm512_comp_reduce_add_ps(_sum_avx512);
+#endif // __AVX512F__
+    __m256 _sum_avx = _mm256_setzero_ps();
+    for (; jj + 7 < max_jj; jj += 8)
+    {
+        __m256 _p = exp256_ps(_mm256_sub_ps(_mm256_loadu_ps(sptr + jj), _mm256_set1_ps(max)));
+        _mm256_storeu_ps(sptr + jj, _p);
+        _sum_avx = _mm256_add_ps(_sum_avx, _p);
+    }
+    sum += _mm256_reduce_add_ps(_sum_avx);
+#endif // __AVX__
+    __m128 _sum = _mm_setzero_ps();
+    for (; jj + 3 < max_jj; jj += 4)
+    {
+        __m128 _p = exp_ps(_mm_sub_ps(_mm_loadu_ps(sptr + jj), _mm_set1_ps(max)));
+        _mm_storeu_ps(sptr + jj, _p);
+        _sum = _mm_add_ps(_sum, _p);
+    }
+    sum += _mm_reduce_add_ps(_sum);
+#endif // __SSE2__
+    for (; jj < max_jj; jj++)
+    {
+        sptr[jj] = expf(sptr[jj] - max);
+        sum += sptr[jj];
+    }
+    return sum;
+}
+
+static void flash_attention_pv(const float* pptr, const Mat& vtm, int embed_dim_per_head, int j0, int max_jj, float scale, float* optr)
+{
+    // optr = optr * scale + p * v
+    // vtm is dst_seqlen rows of values, each row contiguous along embed_dim_per_head
+    int kk = 0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    for (; kk + 15 < embed_dim_per_head; kk += 16)
+    {
+        __m512 _o = _mm512_mul_ps(_mm512_loadu_ps(optr + kk), _mm512_set1_ps(scale));
+        for (int jj = 0; jj < max_jj; jj++)
+        {
+            _o = _mm512_fmadd_ps(_mm512_set1_ps(pptr[jj]), _mm512_loadu_ps(vtm.row(j0 + jj) + kk), _o);
+        }
+        _mm512_storeu_ps(optr + kk, _o);
+    }
+#endif // __AVX512F__
+    for (; kk + 7 < embed_dim_per_head; kk += 8)
+    {
+        __m256 _o = _mm256_mul_ps(_mm256_loadu_ps(optr + kk), _mm256_set1_ps(scale));
+        for (int jj = 0; jj < max_jj; jj++)
+        {
+            _o = _mm256_comp_fmadd_ps(_mm256_set1_ps(pptr[jj]), _mm256_loadu_ps(vtm.row(j0 + jj) + kk), _o);
+        }
+        _mm256_storeu_ps(optr + kk, _o);
+    }
+#endif // __AVX__
+    for (; kk + 3 < embed_dim_per_head; kk += 4)
+    {
+        __m128 _o = _mm_mul_ps(_mm_loadu_ps(optr + kk), _mm_set1_ps(scale));
+        for (int jj = 0; jj < max_jj; jj++)
+        {
+            _o = _mm_comp_fmadd_ps(_mm_set1_ps(pptr[jj]), _mm_loadu_ps(vtm.row(j0 + jj) + kk), _o);
+        }
+        _mm_storeu_ps(optr + kk, _o);
+    }
+#endif // __SSE2__
+    for (; kk < embed_dim_per_head; kk++)
+    {
+        float o = optr[kk] * scale;
+        for (int jj = 0; jj < max_jj; jj++)
+        {
+            o += pptr[jj] * vtm.row(j0 + jj)[kk];
+        }
+        optr[kk] = o;
+    }
+}
+
+static void flash_attention_pv_4(const float* pptr, int pstride, const Mat& vtm, int embed_dim_per_head, int j0, int max_jj, const float* scales, float* optr, int ostride)
+{
+    // four queries share each value load
+    const float* p0 = pptr;
+    const float* p1 = pptr + pstride;
+    const float* p2 = pptr + pstride * 2;
+    const float* p3 = pptr + pstride * 3;
+    float* o0 = optr;
+    float* o1 = optr + ostride;
+    float* o2 = optr + ostride * 2;
+    float* o3 = optr + ostride * 3;
+
+    int kk = 0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    for (; kk + 15 < embed_dim_per_head; kk += 16)
+    {
+        __m512 _o0 = _mm512_mul_ps(_mm512_loadu_ps(o0 + kk), _mm512_set1_ps(scales[0]));
+        __m512 _o1 = _mm512_mul_ps(_mm512_loadu_ps(o1 + kk), _mm512_set1_ps(scales[1]));
+        __m512 _o2 = _mm512_mul_ps(_mm512_loadu_ps(o2 + kk), _mm512_set1_ps(scales[2]));
+        __m512 _o3 = _mm512_mul_ps(_mm512_loadu_ps(o3 + kk), _mm512_set1_ps(scales[3]));
+        for (int jj = 0; jj < max_jj; jj++)
+        {
+            __m512 _v = _mm512_loadu_ps(vtm.row(j0 + jj) + kk);
+            _o0 = _mm512_fmadd_ps(_mm512_set1_ps(p0[jj]), _v, _o0);
+            _o1 = _mm512_fmadd_ps(_mm512_set1_ps(p1[jj]), _v, _o1);
+            _o2 = _mm512_fmadd_ps(_mm512_set1_ps(p2[jj]), _v, _o2);
+            _o3 = _mm512_fmadd_ps(_mm512_set1_ps(p3[jj]), _v, _o3);
+        }
+        _mm512_storeu_ps(o0 + kk, _o0);
+        _mm512_storeu_ps(o1 + kk, _o1);
+        _mm512_storeu_ps(o2 + kk, _o2);
+        _mm512_storeu_ps(o3 + kk, _o3);
+    }
+#endif // __AVX512F__
+    for (; kk + 7 < embed_dim_per_head; kk += 8)
+    {
+        __m256 _o0 = _mm256_mul_ps(_mm256_loadu_ps(o0 + kk), _mm256_set1_ps(scales[0]));
+        __m256 _o1 = _mm256_mul_ps(_mm256_loadu_ps(o1 + kk), _mm256_set1_ps(scales[1]));
+        __m256 _o2 = _mm256_mul_ps(_mm256_loadu_ps(o2 + kk), _mm256_set1_ps(scales[2]));
+        __m256 _o3 = _mm256_mul_ps(_mm256_loadu_ps(o3 + kk), _mm256_set1_ps(scales[3]));
+        for (int jj = 0; jj < max_jj; jj++)
+        {
+            __m256 _v = _mm256_loadu_ps(vtm.row(j0 + jj) + kk);
+            _o0 = _mm256_comp_fmadd_ps(_mm256_set1_ps(p0[jj]), _v, _o0);
+            _o1 = _mm256_comp_fmadd_ps(_mm256_set1_ps(p1[jj]), _v, _o1);
+            _o2 = _mm256_comp_fmadd_ps(_mm256_set1_ps(p2[jj]), _v, _o2);
+            _o3 = _mm256_comp_fmadd_ps(_mm256_set1_ps(p3[jj]), _v, _o3);
+        }
+        _mm256_storeu_ps(o0 + kk, _o0);
+        _mm256_storeu_ps(o1 + kk, _o1);
+        _mm256_storeu_ps(o2 + kk, _o2);
+        _mm256_storeu_ps(o3 + kk, _o3);
+    }
+#endif // __AVX__
+    for (; kk + 3 < embed_dim_per_head; kk += 4)
+    {
+        __m128 _o0 = _mm_mul_ps(_mm_loadu_ps(o0 + kk), _mm_set1_ps(scales[0]));
+        __m128 _o1 = _mm_mul_ps(_mm_loadu_ps(o1 + kk), _mm_set1_ps(scales[1]));
+        __m128 _o2 = _mm_mul_ps(_mm_loadu_ps(o2 + kk), _mm_set1_ps(scales[2]));
+        __m128 _o3 = _mm_mul_ps(_mm_loadu_ps(o3 + kk), _mm_set1_ps(scales[3]));
+        for (int jj = 0; jj < max_jj; jj++)
+        {
+            __m128 _v = _mm_loadu_ps(vtm.row(j0 + jj) + kk);
+            _o0 = _mm_comp_fmadd_ps(_mm_set1_ps(p0[jj]), _v, _o0);
+            _o1 = _mm_comp_fmadd_ps(_mm_set1_ps(p1[jj]), _v, _o1);
+            _o2 = _mm_comp_fmadd_ps(_mm_set1_ps(p2[jj]), _v, _o2);
+            _o3 = _mm_comp_fmadd_ps(_mm_set1_ps(p3[jj]), _v, _o3);
+        }
+        _mm_storeu_ps(o0 + kk, _o0);
+        _mm_storeu_ps(o1 + kk, _o1);
+        _mm_storeu_ps(o2 + kk, _o2);
+        _mm_storeu_ps(o3 + kk, _o3);
+    }
+#endif // __SSE2__
+    for (; kk < embed_dim_per_head; kk++)
+    {
+        float sum0 = o0[kk] * scales[0];
+        float sum1 = o1[kk] * scales[1];
+        float sum2 = o2[kk] * scales[2];
+        float sum3 = o3[kk] * scales[3];
+        for (int jj = 0; jj < max_jj; jj++)
+        {
+            const float v = vtm.row(j0 + jj)[kk];
+            sum0 += p0[jj] * v;
+            sum1 += p1[jj] * v;
+            sum2 += p2[jj] * v;
+            sum3 += p3[jj] * v;
+        }
+        o0[kk] = sum0;
+        o1[kk] = sum1;
+        o2[kk] = sum2;
+        o3[kk] = sum3;
+    }
+}
+
+static int multiheadattention_flash(const Mat& q_affine, const Mat& k_affine, const Mat& v_affine, const Mat& attn_mask_blob, Mat& qkv_cross, int num_heads, const Option& opt)
+{
+    // q_affine  (src_seqlen, embed_dim) with scale applied
+    // k_affine  (dst_seqlen, embed_dim)
+    // v_affine  (dst_seqlen, embed_dim)
+    // qkv_cross (src_seqlen, embed_dim)
+    const int src_seqlen = q_affine.w;
+    const int dst_seqlen = k_affine.w;
+    const int embed_dim = q_affine.h;
+    const int embed_dim_per_head = embed_dim / num_heads;
+
+    const int TILE_M = 16;
+    const int TILE_N = 128;
+
+    // values transposed per head, so that p * v runs along embed_dim_per_head
+    Mat vt(embed_dim_per_head, dst_seqlen, num_heads, 4u, opt.workspace_allocator);
+    if (vt.empty())
+        return -100;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < num_heads; q++)
+    {
+        const Mat vm = v_affine.row_range(q * embed_dim_per_head, embed_dim_per_head);
+        Mat vtm = vt.channel(q);
+
+        for (int j = 0; j < dst_seqlen; j++)
+        {
+            float* outptr = vtm.row(j);
+            for (int k = 0; k < embed_dim_per_head; k++)
+            {
+                outptr[k] = vm.row(k)[j];
+            }
+        }
+    }
+
+    const int nn_M = (src_seqlen + TILE_M - 1) / TILE_M;
+
+    // per thread q tile, score tile, output accumulator and running max / sum / rescale
+    Mat qtileX(embed_dim_per_head, TILE_M, opt.num_threads, 4u, opt.workspace_allocator);
+    Mat stileX(TILE_N, TILE_M, opt.num_threads, 4u, opt.workspace_allocator);
+    Mat otileX(embed_dim_per_head, TILE_M, opt.num_threads, 4u, opt.workspace_allocator);
+    Mat mlX(TILE_M, 3, opt.num_threads, 4u, opt.workspace_allocator);
+    if (qtileX.empty() || stileX.empty() || otileX.empty() || mlX.empty())
+        return -100;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int ppi = 0; ppi < num_heads * nn_M; ppi++)
+    {
+        const int q = ppi / nn_M;
+        const int i0 = (ppi % nn_M) * TILE_M;
+        const int max_ii = std::min(src_seqlen - i0, TILE_M);
+
+        const Mat qm = q_affine.row_range(q * embed_dim_per_head, embed_dim_per_head);
+        const Mat km = k_affine.row_range(q * embed_dim_per_head, embed_dim_per_head);
+        const Mat vtm = vt.channel(q);
+        const Mat maskm = attn_mask_blob.empty() ? Mat() : attn_mask_blob.dims == 3 ? attn_mask_blob.channel(q) : attn_mask_blob;
+
+        Mat qtile = qtileX.channel(get_omp_thread_num());
+        Mat stile = stileX.channel(get_omp_thread_num());
+        Mat otile = otileX.channel(get_omp_thread_num());
+        float* maxptr = mlX.channel(get_omp_thread_num()).row(0);
+        float* sumptr = mlX.channel(get_omp_thread_num()).row(1);
+        float* scaleptr = mlX.channel(get_omp_thread_num()).row(2);
+
+        for (int ii = 0; ii < max_ii; ii++)
+        {
+            float* qptr = qtile.row(ii);
+            for (int k = 0; k < embed_dim_per_head; k++)
+            {
+                qptr[k] = qm.row(k)[i0 + ii];
+            }
+
+            memset(otile.row(ii), 0, embed_dim_per_head * sizeof(float));
+            maxptr[ii] = -FLT_MAX;
+            sumptr[ii] = 0.f;
+        }
+
+        for (int j0 = 0; j0 < dst_seqlen; j0 += TILE_N)
+        {
+            const int max_jj = std::min(dst_seqlen - j0, TILE_N);
+
+            // scores and online softmax statistics
+            int ii = 0;
+            for (; ii + 3 < max_ii; ii += 4)
+            {
+                flash_attention_qk_4(qtile.row(ii), qtile.w, km, embed_dim_per_head, j0, max_jj, stile.row(ii), stile.w);
+            }
+            for (; ii < max_ii; ii++)
+            {
+                flash_attention_qk(qtile.row(ii), km, embed_dim_per_head, j0, max_jj, stile.row(ii));
+            }
+
+            for (ii = 0; ii < max_ii; ii++)
+            {
+                float* sptr = stile.row(ii);
+
+                if (!maskm.empty())
+                {
+                    const float* mptr = maskm.row(i0 + ii) + j0;
+                    for (int jj = 0; jj < max_jj; jj++)
+                    {
+                        sptr[jj] += mptr[jj];
+                    }
+                }
+
+                const float max = flash_attention_max(sptr, max_jj, maxptr[ii]);
+                const float sum = flash_attention_exp_sum(sptr, max_jj, max);
+
+                scaleptr[ii] = expf(maxptr[ii] - max);
+                maxptr[ii] = max;
+                sumptr[ii] = sumptr[ii] * scaleptr[ii] + sum;
+            }
+
+            // rescale and accumulate the outputs
+            ii = 0;
+            for (; ii + 3 < max_ii; ii += 4)
+            {
+                flash_attention_pv_4(stile.row(ii), stile.w, vtm, embed_dim_per_head, j0, max_jj, scaleptr + ii, otile.row(ii), otile.w);
+            }
+            for (; ii < max_ii; ii++)
+            {
+                flash_attention_pv(stile.row(ii), vtm, embed_dim_per_head, j0, max_jj, scaleptr[ii], otile.row(ii));
+            }
+        }
+
+        for (int ii = 0; ii < max_ii; ii++)
+        {
+            const float* optr = otile.row(ii);
+            const float inv_sum = 1.f / sumptr[ii];
+            for (int k = 0; k < embed_dim_per_head; k++)
+            {
+                qkv_cross.row(q * embed_dim_per_head + k)[i0 + ii] = optr[k] * inv_sum;
+            }
+        }
+    }
+
+    return 0;
+}
@@ -14,10 +14,29 @@
 
 #include "multiheadattention_x86.h"
 
+#include <float.h>
+
+#if __SSE2__
+#include <emmintrin.h>
+#include "sse_mathfun.h"
+#if __AVX__
+#include <immintrin.h>
+#include "avx_mathfun.h"
+#if __AVX512F__
+#include "avx512_mathfun.h"
+#endif // __AVX512F__
+#endif // __AVX__
+#endif // __SSE2__
+
+#include "x86_usability.h"
+
+#include "cpu.h"
 #include "layer_type.h"
 
 namespace ncnn {
 
+#include "multiheadattention_flash.h"
+
 MultiHeadAttention_x86::MultiHeadAttention_x86()
 {
 #if __SSE2__
@@ -266,10 +285,12 @@ int MultiHeadAttention_x86::destroy_pipeline(const Option& opt)
 
 int MultiHeadAttention_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
 {
+    const int input_count = kv_cache ? (int)bottom_blobs.size() - 2 : (int)bottom_blobs.size();
+
     const Mat& q_blob = bottom_blobs[0];
-    const Mat& k_blob = (bottom_blobs.size() == 1 || (bottom_blobs.size() == 2 && attn_mask)) ? q_blob : bottom_blobs[1];
-    const Mat& v_blob = (bottom_blobs.size() == 1 || (bottom_blobs.size() == 2 && attn_mask)) ? q_blob : (bottom_blobs.size() == 2 || (bottom_blobs.size() == 3 && attn_mask)) ? k_blob : bottom_blobs[2];
-    const Mat& attn_mask_blob = attn_mask ? bottom_blobs[bottom_blobs.size() - 1] : Mat();
+    const Mat& k_blob = (input_count == 1 || (input_count == 2 && attn_mask)) ? q_blob : bottom_blobs[1];
+    const Mat& v_blob = (input_count == 1 || (input_count == 2 && attn_mask)) ? q_blob : (input_count == 2 || (input_count == 3 && attn_mask)) ? k_blob : bottom_blobs[2];
+    const Mat& attn_mask_blob = attn_mask ? bottom_blobs[input_count - 1] : Mat();
 
     Mat attn_mask_blob_unpacked;
     if (attn_mask && attn_mask_blob.elempack != 1)
@@ -285,7 +306,6 @@ int MultiHeadAttention_x86::forward(const std::vector<Mat>& bottom_blobs, std::v
 
     const int embed_dim_per_head = embed_dim / num_heads;
     const int src_seqlen = q_blob.h * q_blob.elempack;
-    const int dst_seqlen = k_blob.h * k_blob.elempack;
 
     Mat q_affine;
     int retq = q_gemm->forward(q_blob, q_affine, opt);
@@ -297,6 +317,49 @@ int MultiHeadAttention_x86::forward(const std::vector<Mat>& bottom_blobs, std::v
     if (retk != 0)
         return retk;
 
+    if (kv_cache)
+    {
+        int retkc = concat_kv_cache(bottom_blobs[input_count], k_affine, top_blobs[1], opt);
+        if (retkc != 0)
+            return retkc;
+
+        k_affine = top_blobs[1];
+    }
+
+    const int dst_seqlen = k_affine.w;
+
+    // fused attention when the score matrix of one head does not fit in l2 cache
+    if ((size_t)src_seqlen * dst_seqlen * sizeof(float) > (size_t)get_cpu_level2_cache_size())
+    {
+        Mat v_affine;
+        int retv = v_gemm->forward(v_blob, v_affine, opt);
+        if (retv != 0)
+            return retv;
+
+        if (kv_cache)
+        {
+            int retvc = concat_kv_cache(bottom_blobs[input_count + 1], v_affine, top_blobs[2], opt);
+            if (retvc != 0)
+                return retvc;
+
+            v_affine = top_blobs[2];
+        }
+
+        Mat qkv_cross(src_seqlen, embed_dim_per_head * num_heads, 4u, opt.blob_allocator);
+        if (qkv_cross.empty())
+            return -100;
+
+        int retqkv = multiheadattention_flash(q_affine, k_affine, v_affine, attn_mask ? attn_mask_blob_unpacked : Mat(), qkv_cross, num_heads, opt);
+        if (retqkv != 0)
+            return retqkv;
+
+        q_affine.release();
+        k_affine.release();
+        v_affine.release();
+
+        return o_gemm->forward(qkv_cross, top_blobs[0], opt);
+    }
+
     Mat qk_cross(dst_seqlen, src_seqlen * num_heads, 4u, opt.blob_allocator);
     if (qk_cross.empty())
         return -100;
@@ -338,6 +401,15 @@ int MultiHeadAttention_x86::forward(const std::vector<Mat>& bottom_blobs, std::v
     if (retv != 0)
         return retv;
 
+    if (kv_cache)
+    {
+        int retvc = concat_kv_cache(bottom_blobs[input_count + 1], v_affine, top_blobs[2], opt);
+        if (retvc != 0)
+            return retvc;
+
+        v_affine = top_blobs[2];
+    }
+
     Mat qkv_cross(src_seqlen, embed_dim_per_head * num_heads, 4u, opt.blob_allocator);
     if (qkv_cross.empty())
         return -100;
@@ -21,6 +21,8 @@
 #endif // __AVX__
 #endif // __SSE2__
 
+#include "x86_activation.h"
+
 namespace ncnn {
 
 ReLU_x86::ReLU_x86()
@@ -28,6 +30,9 @@ ReLU_x86::ReLU_x86()
 #if __SSE2__
     support_packing = true;
 #endif // __SSE2__
+#if NCNN_BF16
+    support_bf16_storage = true;
+#endif
 }
 
 int ReLU_x86::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
@@ -37,6 +42,11 @@ int ReLU_x86::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
     if (elembits == 8)
         return forward_inplace_int8(bottom_top_blob, opt);
 
+#if NCNN_BF16
+    if (opt.use_bf16_storage && elembits == 16)
+        return forward_inplace_bf16s(bottom_top_blob, opt);
+#endif
+
     int w = bottom_top_blob.w;
     int h = bottom_top_blob.h;
     int d = bottom_top_blob.d;
@@ -221,4 +231,22 @@ int ReLU_x86::forward_inplace_int8(Mat& bottom_top_blob, const Option& opt) cons
     return 0;
 }
 
+#if NCNN_BF16
+int ReLU_x86::forward_inplace_bf16s(Mat& bottom_top_blob, const Option& opt) const
+{
+    if (slope == 0.f)
+    {
+        activation_inplace_bf16s(bottom_top_blob, 1, Mat(), opt);
+    }
+    else
+    {
+        Mat activation_params(1);
+        activation_params[0] = slope;
+        activation_inplace_bf16s(bottom_top_blob, 2, activation_params, opt);
+    }
+
+    return 0;
+}
+#endif // NCNN_BF16
+
 } //namespace ncnn
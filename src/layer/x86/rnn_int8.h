@@ -0,0 +1,427 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#if NCNN_RUNTIME_CPU && NCNN_AVX512VNNI && __AVX512F__ && !__AVX512VNNI__
+void rnn_int8_avx512vnni(const Mat& bottom_blob_int8, const Mat& bottom_blob_int8_descales, Mat& top_blob, int reverse, const Mat& weight_data_tm, const Mat& weight_data_tm_int8_descales, const Mat& bias_c, Mat& hidden_state, const Option& opt);
+#endif
+
+#if NCNN_RUNTIME_CPU && NCNN_AVX2 && __AVX__ && !__AVX2__
+void rnn_transform_weight_int8_avx2(const Mat& weight_xc, const Mat& weight_xc_int8_scales, const Mat& weight_hc, const Mat& weight_hc_int8_scales, Mat& weight_data_tm, Mat& weight_data_tm_int8_descales, int size, int num_output, int num_directions, const Option& opt);
+void rnn_int8_avx2(const Mat& bottom_blob_int8, const Mat& bottom_blob_int8_descales, Mat& top_blob, int reverse, const Mat& weight_data_tm, const Mat& weight_data_tm_int8_descales, const Mat& bias_c, Mat& hidden_state, const Option& opt);
+#endif
+
+static int rnn_int8_group_width(int q, int num_output)
+{
+    // hidden units are packed in groups of the widest int32 vector that still fits
+#if __SSE2__
+#if __AVX2__
+#if __AVX512F__
+    if (q + 15 < num_output)
+        return 16;
+#endif // __AVX512F__
+    if (q + 7 < num_output)
+        return 8;
+#endif // __AVX2__
+    if (q + 3 < num_output)
+        return 4;
+#endif // __SSE2__
+    return 1;
+}
+
+static void rnn_transform_weight_int8(const Mat& weight_xc, const Mat& weight_xc_int8_scales, const Mat& weight_hc, const Mat& weight_hc_int8_scales, Mat& weight_data_tm, Mat& weight_data_tm_int8_descales, int size, int num_output, int num_directions, const Option& opt)
+{
+#if NCNN_RUNTIME_CPU && NCNN_AVX2 && __AVX__ && !__AVX2__
+    if (ncnn::cpu_support_x86_avx2())
+    {
+        rnn_transform_weight_int8_avx2(weight_xc, weight_xc_int8_scales, weight_hc, weight_hc_int8_scales, weight_data_tm, weight_data_tm_int8_descales, size, num_output, num_directions, opt);
+        return;
+    }
+#endif
+
+    // a group of n hidden units holds
+    //   xc  for each input pair    n*2
+    //   hc  for each hidden pair   n*2
+    // the two weights of one unit for neighbouring inputs sit together, which is the operand order of pmaddwd
+    const int size2 = (size + 1) / 2;
+    const int num_output2 = (num_output + 1) / 2;
+
+    weight_data_tm.create((size2 + num_output2) * 2, num_output, num_directions, 1u, 1);
+    weight_data_tm_int8_descales.create(2, num_output, num_directions);
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int dr = 0; dr < num_directions; dr++)
+    {
+        const Mat weight_xc_dr = weight_xc.channel(dr);
+        const Mat weight_hc_dr = weight_hc.channel(dr);
+        const float* weight_xc_int8_scales_ptr = weight_xc_int8_scales.row(dr);
+        const float* weight_hc_int8_scales_ptr = weight_hc_int8_scales.row(dr);
+
+        Mat weight_data_tm_dr = weight_data_tm.channel(dr);
+        Mat weight_data_tm_int8_descales_dr = weight_data_tm_int8_descales.channel(dr);
+
+        for (int q = 0; q < num_output;)
+        {
+            const int n = rnn_int8_group_width(q, num_output);
+
+            float* descales_ptr = weight_data_tm_int8_descales_dr.row(q);
+            signed char* kptr = weight_data_tm_dr.row<signed char>(q);
+
+            for (int j = 0; j < n; j++)
+            {
+                descales_ptr[j] = 1.f / weight_xc_int8_scales_ptr[q + j];
+                descales_ptr[n + j] = 1.f / weight_hc_int8_scales_ptr[q + j];
+            }
+
+            for (int i = 0; i < size2; i++)
+            {
+                for (int j = 0; j < n; j++)
+                {
+                    const signed char* weight_xc_ptr = weight_xc_dr.row<const signed char>(q + j);
+
+                    kptr[0] = weight_xc_ptr[i * 2];
+                    kptr[1] = i * 2 + 1 < size ? weight_xc_ptr[i * 2 + 1] : 0;
+                    kptr += 2;
+                }
+            }
+
+            for (int i = 0; i < num_output2; i++)
+            {
+                for (int j = 0; j < n; j++)
+                {
+                    const signed char* weight_hc_ptr = weight_hc_dr.row<const signed char>(q + j);
+
+                    kptr[0] = weight_hc_ptr[i * 2];
+                    kptr[1] = i * 2 + 1 < num_output ? weight_hc_ptr[i * 2 + 1] : 0;
+                    kptr += 2;
+                }
+            }
+
+            q += n;
+        }
+    }
+}
+
+static float rnn_dynamic_quantize_row(const float* ptr, int size, short* outptr)
+{
+    // quantize to int8 range and widen to int16, zero padded to an even length
+    // returns the descale
+    float absmax = 0.f;
+
+    int i = 0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    __m512 _absmax_avx512 = _mm512_setzero_ps();
+    for (; i + 15 < size; i += 16)
+    {
+        _absmax_avx512 = _mm512_max_ps(_absmax_avx512, abs512_ps(_mm512_loadu_ps(ptr + i)));
+    }
+    absmax = std::max(absmax, _mm512_comp_reduce_max_ps(_absmax_avx512));
+#endif // __AVX512F__
+    __m256 _absmax_avx = _mm256_setzero_ps();
+    for (; i + 7 < size; i += 8)
+    {
+        _absmax_avx = _mm256_max_ps(_absmax_avx, abs256_ps(_mm256_loadu_ps(ptr + i)));
+    }
+    absmax = std::max(absmax, _mm256_reduce_max_ps(_absmax_avx));
+#endif // __AVX__
+    __m128 _absmax = _mm_setzero_ps();
+    for (; i + 3 < size; i += 4)
+    {
+        _absmax = _mm_max_ps(_absmax, abs_ps(_mm_loadu_ps(ptr + i)));
+    }
+    absmax = std::max(absmax, _mm_reduce_max_ps(_absmax));
+#endif // __SSE2__
+    for (; i < size; i++)
+    {
+        absmax = std::max(absmax, (float)fabs(ptr[i]));
+    }
+
+    if (absmax == 0.f)
+    {
+        memset(outptr, 0, (size + 1) / 2 * 2 * sizeof(short));
+        return 1.f;
+    }
+
+    const float scale = 127.f / absmax;
+    for (i = 0; i < size; i++)
+    {
+        outptr[i] = float2int8(ptr[i] * scale);
+    }
+    if (size % 2)
+    {
+        outptr[size] = 0;
+    }
+
+    return absmax / 127.f;
+}
+
+static void rnn_gate_output(const Mat& gates, Mat& hidden_state, float* output_data)
+{
+    const int num_output = hidden_state.w;
+
+    const float* gates_H = gates;
+    float* hidden_ptr = hidden_state;
+
+    memcpy(hidden_ptr, gates_H, num_output * sizeof(float));
+    memcpy(output_data, gates_H, num_output * sizeof(float));
+}
+
+static void rnn_int8(const Mat& bottom_blob_int8, const Mat& bottom_blob_int8_descales, Mat& top_blob, int reverse, const Mat& weight_data_tm, const Mat& weight_data_tm_int8_descales, const Mat& bias_c, Mat& hidden_state, const Option& opt)
+{
+#if NCNN_RUNTIME_CPU && NCNN_AVX512VNNI && __AVX512F__ && !__AVX512VNNI__
+    if (ncnn::cpu_support_x86_avx512_vnni())
+    {
+        rnn_int8_avx512vnni(bottom_blob_int8, bottom_blob_int8_descales, top_blob, reverse, weight_data_tm, weight_data_tm_int8_descales, bias_c, hidden_state, opt);
+        return;
+    }
+#endif
+
+#if NCNN_RUNTIME_CPU && NCNN_AVX2 && __AVX__ && !__AVX2__
+    if (ncnn::cpu_support_x86_avx2())
+    {
+        rnn_int8_avx2(bottom_blob_int8, bottom_blob_int8_descales, top_blob, reverse, weight_data_tm, weight_data_tm_int8_descales, bias_c, hidden_state, opt);
+        return;
+    }
+#endif
+
+    // bottom_blob_int8 rows hold int8 range values widened to int16
+    const int size2 = bottom_blob_int8.w / 2;
+    const int T = bottom_blob_int8.h;
+
+    const int num_output = top_blob.w;
+    const int num_output2 = (num_output + 1) / 2;
+
+    // H of each hidden unit
+    Mat gates(num_output, 4u, opt.workspace_allocator);
+
+    Mat hidden_state_int8(num_output2 * 2, (size_t)2u, 1, opt.workspace_allocator);
+
+    // unroll
+    for (int t = 0; t < T; t++)
+    {
+        int ti = reverse ? T - 1 - t : t;
+
+        const float descale_h = rnn_dynamic_quantize_row(hidden_state, num_output, hidden_state_int8);
+
+        const int* x = bottom_blob_int8.row<const int>(ti);
+        const int* hs = hidden_state_int8;
+        const float descale_x = bottom_blob_int8_descales[ti];
+
+        const float* bias_c_ptr = bias_c;
+        float* gates_H = gates;
+
+        int remain_num_output_start = 0;
+#if __SSE2__
+#if __AVX2__
+#if __AVX512F__
+        int nn_num_output = num_output >> 4;
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int qq = 0; qq < nn_num_output; qq++)
+        {
+            const int q = qq * 16;
+
+            const signed char* kptr = weight_data_tm.row<const signed char>(q);
+            const float* descales_ptr = weight_data_tm_int8_descales.row(q);
+
+            __m512i _Hx0 = _mm512_setzero_si512();
+            __m512i _Hx1 = _mm512_setzero_si512();
+            int i = 0;
+            for (; i + 1 < size2; i += 2)
+            {
+                __m512i _w0 = _mm512_cvtepi8_epi16(_mm256_loadu_si256((const __m256i*)kptr));
+                __m512i _w1 = _mm512_cvtepi8_epi16(_mm256_loadu_si256((const __m256i*)(kptr + 32)));
+#if __AVX512VNNI__
+                _Hx0 = _mm512_dpwssd_epi32(_Hx0, _w0, _mm512_set1_epi32(x[i]));
+                _Hx1 = _mm512_dpwssd_epi32(_Hx1, _w1, _mm512_set1_epi32(x[i + 1]));
+#else
+                _Hx0 = _mm512_add_epi32(_Hx0, _mm512_madd_epi16(_w0, _mm512_set1_epi32(x[i])));
+                _Hx1 = _mm512_add_epi32(_Hx1, _mm512_madd_epi16(_w1, _mm512_set1_epi32(x[i + 1])));
+#endif // __AVX512VNNI__
+                kptr += 64;
+            }
+            for (; i < size2; i++)
+            {
+                __m512i _w0 = _mm512_cvtepi8_epi16(_mm256_loadu_si256((const __m256i*)kptr));
+                _Hx0 = _mm512_add_epi32(_Hx0, _mm512_madd_epi16(_w0, _mm512_set1_epi32(x[i])));
+                kptr += 32;
+            }
+
+            __m512i _Hh0 = _mm512_setzero_si512();
+            __m512i _Hh1 = _mm512_setzero_si512();
+            i = 0;
+            for (; i + 1 < num_output2; i += 2)
+            {
+                __m512i _w0 = _mm512_cvtepi8_epi16(_mm256_loadu_si256((const __m256i*)kptr));
+                __m512i _w1 = _mm512_cvtepi8_epi16(_mm256_loadu_si256((const __m256i*)(kptr + 32)));
+#if __AVX512VNNI__
+                _Hh0 = _mm512_dpwssd_epi32(_Hh0, _w0, _mm512_set1_epi32(hs[i]));
+                _Hh1 = _mm512_dpwssd_epi32(_Hh1, _w1, _mm512_set1_epi32(hs[i + 1]));
+#else
+                _Hh0 = _mm512_add_epi32(_Hh0, _mm512_madd_epi16(_w0, _mm512_set1_epi32(hs[i])));
+                _Hh1 = _mm512_add_epi32(_Hh1, _mm512_madd_epi16(_w1, _mm512_set1_epi32(hs[i + 1])));
+#endif // __AVX512VNNI__
+                kptr += 64;
+            }
+            for (; i < num_output2; i++)
+            {
+                __m512i _w0 = _mm512_cvtepi8_epi16(_mm256_loadu_si256((const __m256i*)kptr));
+                _Hh0 = _mm512_add_epi32(_Hh0, _mm512_madd_epi16(_w0, _mm512_set1_epi32(hs[i])));
+                kptr += 32;
+            }
+
+            __m512 _H = _mm512_loadu_ps(bias_c_ptr + q);
+            _H = _mm512_fmadd_ps(_mm512_cvtepi32_ps(_mm512_add_epi32(_Hx0, _Hx1)), _mm512_mul_ps(_mm512_set1_ps(descale_x), _mm512_loadu_ps(descales_ptr)), _H);
+            _H = _mm512_fmadd_ps(_mm512_cvtepi32_ps(_mm512_add_epi32(_Hh0, _Hh1)), _mm512_mul_ps(_mm512_set1_ps(descale_h), _mm512_loadu_ps(descales_ptr + 16)), _H);
+            _H = tanh_avx512(_H);
+
+            _mm512_storeu_ps(gates_H + q, _H);
+        }
+
+        remain_num_output_start += nn_num_output << 4;
+#endif // __AVX512F__
+        int nn_num_output_8 = (num_output - remain_num_output_start) >> 3;
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int qq = 0; qq < nn_num_output_8; qq++)
+        {
+            const int q = remain_num_output_start + qq * 8;
+
+            const signed char* kptr = weight_data_tm.row<const signed char>(q);
+            const float* descales_ptr = weight_data_tm_int8_descales.row(q);
+
+            __m256i _Hx0 = _mm256_setzero_si256();
+            __m256i _Hx1 = _mm256_setzero_si256();
+            int i = 0;
+            for (; i + 1 < size2; i += 2)
+            {
+                __m256i _w0 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)kptr));
+                __m256i _w1 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)(kptr + 16)));
+                _Hx0 = _mm256_add_epi32(_Hx0, _mm256_madd_epi16(_w0, _mm256_set1_epi32(x[i])));
+                _Hx1 = _mm256_add_epi32(_Hx1, _mm256_madd_epi16(_w1, _mm256_set1_epi32(x[i + 1])));
+                kptr += 32;
+            }
+            for (; i < size2; i++)
+            {
+                __m256i _w0 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)kptr));
+                _Hx0 = _mm256_add_epi32(_Hx0, _mm256_madd_epi16(_w0, _mm256_set1_epi32(x[i])));
+                kptr += 16;
+            }
+
+            __m256i _Hh0 = _mm256_setzero_si256();
+            __m256i _Hh1 = _mm256_setzero_si256();
+            i = 0;
+            for (; i + 1 < num_output2; i += 2)
+            {
+                __m256i _w0 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)kptr));
+                __m256i _w1 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)(kptr + 16)));
+                _Hh0 = _mm256_add_epi32(_Hh0, _mm256_madd_epi16(_w0, _mm256_set1_epi32(hs[i])));
+                _Hh1 = _mm256_add_epi32(_Hh1, _mm256_madd_epi16(_w1, _mm256_set1_epi32(hs[i + 1])));
+                kptr += 32;
+            }
+            for (; i < num_output2; i++)
+            {
+                __m256i _w0 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)kptr));
+                _Hh0 = _mm256_add_epi32(_Hh0, _mm256_madd_epi16(_w0, _mm256_set1_epi32(hs[i])));
+                kptr += 16;
+            }
+
+            __m256 _H = _mm256_loadu_ps(bias_c_ptr + q);
+            _H = _mm256_comp_fmadd_ps(_mm256_cvtepi32_ps(_mm256_add_epi32(_Hx0, _Hx1)), _mm256_mul_ps(_mm256_set1_ps(descale_x), _mm256_loadu_ps(descales_ptr)), _H);
+            _H = _mm256_comp_fmadd_ps(_mm256_cvtepi32_ps(_mm256_add_epi32(_Hh0, _Hh1)), _mm256_mul_ps(_mm256_set1_ps(descale_h), _mm256_loadu_ps(descales_ptr + 8)), _H);
+            _H = tanh_avx(_H);
+
+            _mm256_storeu_ps(gates_H + q, _H);
+        }
+
+        remain_num_output_start += nn_num_output_8 << 3;
+#endif // __AVX2__
+        int nn_num_output_4 = (num_output - remain_num_output_start) >> 2;
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int qq = 0; qq < nn_num_output_4; qq++)
+        {
+            const int q = remain_num_output_start + qq * 4;
+
+            const signed char* kptr = weight_data_tm.row<const signed char>(q);
+            const float* descales_ptr = weight_data_tm_int8_descales.row(q);
+
+            __m128i _Hx = _mm_setzero_si128();
+            for (int i = 0; i < size2; i++)
+            {
+                __m128i _w = _mm_loadl_epi64((const __m128i*)kptr);
+#if __SSE4_1__
+                _w = _mm_cvtepi8_epi16(_w);
+#else
+                _w = _mm_unpacklo_epi8(_w, _mm_cmpgt_epi8(_mm_setzero_si128(), _w));
+#endif
+                _Hx = _mm_add_epi32(_Hx, _mm_madd_epi16(_w, _mm_set1_epi32(x[i])));
+                kptr += 8;
+            }
+
+            __m128i _Hh = _mm_setzero_si128();
+            for (int i = 0; i < num_output2; i++)
+            {
+                __m128i _w = _mm_loadl_epi64((const __m128i*)kptr);
+#if __SSE4_1__
+                _w = _mm_cvtepi8_epi16(_w);
+#else
+                _w = _mm_unpacklo_epi8(_w, _mm_cmpgt_epi8(_mm_setzero_si128(), _w));
+#endif
+                _Hh = _mm_add_epi32(_Hh, _mm_madd_epi16(_w, _mm_set1_epi32(hs[i])));
+                kptr += 8;
+            }
+
+            __m128 _H = _mm_loadu_ps(bias_c_ptr + q);
+            _H = _mm_comp_fmadd_ps(_mm_cvtepi32_ps(_Hx), _mm_mul_ps(_mm_set1_ps(descale_x), _mm_loadu_ps(descales_ptr)), _H);
+            _H = _mm_comp_fmadd_ps(_mm_cvtepi32_ps(_Hh), _mm_mul_ps(_mm_set1_ps(descale_h), _mm_loadu_ps(descales_ptr + 4)), _H);
+            _H = tanh_sse(_H);
+
+            _mm_storeu_ps(gates_H + q, _H);
+        }
+
+        remain_num_output_start += nn_num_output_4 << 2;
+#endif // __SSE2__
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int q = remain_num_output_start; q < num_output; q++)
+        {
+            const signed char* kptr = weight_data_tm.row<const signed char>(q);
+            const float* descales_ptr = weight_data_tm_int8_descales.row(q);
+
+            const short* x16 = (const short*)x;
+            const short* hs16 = (const short*)hs;
+
+            int Hx = 0;
+            for (int i = 0; i < size2; i++)
+            {
+                Hx += kptr[0] * x16[i * 2] + kptr[1] * x16[i * 2 + 1];
+                kptr += 2;
+            }
+
+            int Hh = 0;
+            for (int i = 0; i < num_output2; i++)
+            {
+                Hh += kptr[0] * hs16[i * 2] + kptr[1] * hs16[i * 2 + 1];
+                kptr += 2;
+            }
+
+            float H = bias_c_ptr[q] + Hx * (descale_x * descales_ptr[0]) + Hh * (descale_h * descales_ptr[1]);
+
+            gates_H[q] = tanhf(H);
+        }
+
+        rnn_gate_output(gates, hidden_state, top_blob.row(ti));
+    }
+}
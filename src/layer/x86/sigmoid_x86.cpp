@@ -26,6 +26,8 @@
 #endif // __AVX__
 #endif // __SSE2__
 
+#include "x86_activation.h"
+
 namespace ncnn {
 
 Sigmoid_x86::Sigmoid_x86()
@@ -33,10 +35,18 @@ Sigmoid_x86::Sigmoid_x86()
 #if __SSE2__
     support_packing = true;
 #endif // __SSE2__
+#if NCNN_BF16
+    support_bf16_storage = true;
+#endif
 }
 
 int Sigmoid_x86::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
 {
+#if NCNN_BF16
+    if (opt.use_bf16_storage && bottom_top_blob.elembits() == 16)
+        return forward_inplace_bf16s(bottom_top_blob, opt);
+#endif
+
     int w = bottom_top_blob.w;
     int h = bottom_top_blob.h;
     int d = bottom_top_blob.d;
@@ -93,4 +103,13 @@ int Sigmoid_x86::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
     return 0;
 }
 
+#if NCNN_BF16
+int Sigmoid_x86::forward_inplace_bf16s(Mat& bottom_top_blob, const Option& opt) const
+{
+    activation_inplace_bf16s(bottom_top_blob, 4, Mat(), opt);
+
+    return 0;
+}
+#endif // NCNN_BF16
+
 } // namespace ncnn
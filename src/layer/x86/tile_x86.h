@@ -0,0 +1,35 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef LAYER_TILE_X86_H
+#define LAYER_TILE_X86_H
+
+#include "tile.h"
+
+namespace ncnn {
+
+class Tile_x86 : public Tile
+{
+public:
+    Tile_x86();
+
+    virtual int forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
+
+protected:
+    int forward_tile(const Mat& bottom_blob, Mat& top_blob, int outdims, const Option& opt) const;
+};
+
+} // namespace ncnn
+
+#endif // LAYER_TILE_X86_H
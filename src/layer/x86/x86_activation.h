@@ -324,4 +324,50 @@ static NCNN_FORCEINLINE __m512 activation_avx512(__m512 _v, int activation_type,
 #endif // __AVX__
 #endif // __SSE2__
 
+static void activation_inplace_bf16s(ncnn::Mat& bottom_top_blob, int activation_type, const ncnn::Mat& activation_params, const ncnn::Option& opt)
+{
+    const int channels = bottom_top_blob.c;
+    const int size = bottom_top_blob.w * bottom_top_blob.h * bottom_top_blob.d * bottom_top_blob.elempack;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < channels; q++)
+    {
+        unsigned short* ptr = bottom_top_blob.channel(q);
+
+        int i = 0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+        for (; i + 15 < size; i += 16)
+        {
+            __m512 _p = bfloat2float_avx512(_mm256_loadu_si256((const __m256i*)ptr));
+            _p = activation_avx512(_p, activation_type, activation_params);
+            _mm256_storeu_si256((__m256i*)ptr, float2bfloat_avx512(_p));
+            ptr += 16;
+        }
+#endif // __AVX512F__
+        for (; i + 7 < size; i += 8)
+        {
+            __m256 _p = bfloat2float_avx(_mm_loadu_si128((const __m128i*)ptr));
+            _p = activation_avx(_p, activation_type, activation_params);
+            _mm_storeu_si128((__m128i*)ptr, float2bfloat_avx(_p));
+            ptr += 8;
+        }
+#endif // __AVX__
+        for (; i + 3 < size; i += 4)
+        {
+            __m128 _p = bfloat2float_sse(_mm_loadl_epi64((const __m128i*)ptr));
+            _p = activation_sse(_p, activation_type, activation_params);
+            _mm_storel_epi64((__m128i*)ptr, float2bfloat_sse(_p, _p));
+            ptr += 4;
+        }
+#endif // __SSE2__
+        for (; i < size; i++)
+        {
+            *ptr = ncnn::float32_to_bfloat16(activation_ss(ncnn::bfloat16_to_float32(*ptr), activation_type, activation_params));
+            ptr++;
+        }
+    }
+}
+
 #endif // X86_ACTIVATION_H
@@ -1357,4 +1357,102 @@ static NCNN_FORCEINLINE __m512i float2bfloat_avx512(const __m512& v0, const __m5
 #endif // __AVX__
 #endif // __SSE2__
 
+static inline void bfloat2float_row(const unsigned short* ptr, float* outptr, int size)
+{
+    int i = 0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    for (; i + 15 < size; i += 16)
+    {
+        _mm512_storeu_ps(outptr, bfloat2float_avx512(_mm256_loadu_si256((const __m256i*)ptr)));
+        ptr += 16;
+        outptr += 16;
+    }
+#endif // __AVX512F__
+    for (; i + 7 < size; i += 8)
+    {
+        _mm256_storeu_ps(outptr, bfloat2float_avx(_mm_loadu_si128((const __m128i*)ptr)));
+        ptr += 8;
+        outptr += 8;
+    }
+#endif // __AVX__
+    for (; i + 3 < size; i += 4)
+    {
+        _mm_storeu_ps(outptr, bfloat2float_sse(_mm_loadl_epi64((const __m128i*)ptr)));
+        ptr += 4;
+        outptr += 4;
+    }
+#endif // __SSE2__
+    for (; i < size; i++)
+    {
+        *outptr++ = ncnn::bfloat16_to_float32(*ptr++);
+    }
+}
+
+static inline void float2bfloat_row(const float* ptr, unsigned short* outptr, int size)
+{
+    int i = 0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    for (; i + 15 < size; i += 16)
+    {
+        _mm256_storeu_si256((__m256i*)outptr, float2bfloat_avx512(_mm512_loadu_ps(ptr)));
+        ptr += 16;
+        outptr += 16;
+    }
+#endif // __AVX512F__
+    for (; i + 7 < size; i += 8)
+    {
+        _mm_storeu_si128((__m128i*)outptr, float2bfloat_avx(_mm256_loadu_ps(ptr)));
+        ptr += 8;
+        outptr += 8;
+    }
+#endif // __AVX__
+    for (; i + 3 < size; i += 4)
+    {
+        __m128 _p = _mm_loadu_ps(ptr);
+        _mm_storel_epi64((__m128i*)outptr, float2bfloat_sse(_p, _p));
+        ptr += 4;
+        outptr += 4;
+    }
+#endif // __SSE2__
+    for (; i < size; i++)
+    {
+        *outptr++ = ncnn::float32_to_bfloat16(*ptr++);
+    }
+}
+
+static inline void float16_to_float32_row(const unsigned short* ptr, float* outptr, int size)
+{
+    int i = 0;
+#if __F16C__
+#if __AVX512F__
+    for (; i + 15 < size; i += 16)
+    {
+        _mm512_storeu_ps(outptr, _mm512_cvtph_ps(_mm256_loadu_si256((const __m256i*)ptr)));
+        ptr += 16;
+        outptr += 16;
+    }
+#endif // __AVX512F__
+    for (; i + 7 < size; i += 8)
+    {
+        _mm256_storeu_ps(outptr, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)ptr)));
+        ptr += 8;
+        outptr += 8;
+    }
+    for (; i + 3 < size; i += 4)
+    {
+        _mm_storeu_ps(outptr, _mm_cvtph_ps(_mm_loadl_epi64((const __m128i*)ptr)));
+        ptr += 4;
+        outptr += 4;
+    }
+#endif // __F16C__
+    for (; i < size; i++)
+    {
+        *outptr++ = ncnn::float16_to_float32(*ptr++);
+    }
+}
+
 #endif // X86_USABILITY_H
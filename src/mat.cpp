@@ -1131,21 +1131,32 @@ void VkImageMat::create_like(const VkImageMat& im, VkAllocator* _allocator)
 
 void Mat::substract_mean_normalize(const float* mean_vals, const float* norm_vals)
 {
+    Option opt;
+    opt.num_threads = 1;
+
+    substract_mean_normalize(mean_vals, norm_vals, opt);
+}
+
+void Mat::substract_mean_normalize(const float* mean_vals, const float* norm_vals, const Option& opt)
+{
+    // the per-channel parameters are unpacked
+    const int channels = c * elempack;
+
     Layer* op;
 
-    if (mean_vals && !norm_vals)
+    if (mean_vals && !norm_vals && elempack == 1)
     {
         // substract mean only
         op = create_layer(LayerType::Bias);
 
         ParamDict pd;
-        pd.set(0, c);
+        pd.set(0, channels);
 
         op->load_param(pd);
 
         Mat weights[1];
-        weights[0] = Mat(c);
-        for (int q = 0; q < c; q++)
+        weights[0] = Mat(channels);
+        for (int q = 0; q < channels; q++)
         {
             weights[0][q] = -mean_vals[q];
         }
@@ -1158,37 +1169,39 @@ void Mat::substract_mean_normalize(const float* mean_vals, const float* norm_val
         op = create_layer(LayerType::Scale);
 
         ParamDict pd;
-        pd.set(0, c);
+        pd.set(0, channels);
 
         op->load_param(pd);
 
         Mat weights[1];
-        weights[0] = Mat(c);
-        for (int q = 0; q < c; q++)
+        weights[0] = Mat(channels);
+        for (int q = 0; q < channels; q++)
         {
             weights[0][q] = norm_vals[q];
         }
 
         op->load_model(ModelBinFromMatArray(weights));
     }
-    else if (mean_vals && norm_vals)
+    else if (mean_vals)
     {
         // substract mean and normalize
+        // bias layer handles elempack 1 only, so packed substract mean goes here with unit scale
         op = create_layer(LayerType::Scale);
 
         ParamDict pd;
-        pd.set(0, c);
+        pd.set(0, channels);
         pd.set(1, 1);
 
         op->load_param(pd);
 
         Mat weights[2];
-        weights[0] = Mat(c);
-        weights[1] = Mat(c);
-        for (int q = 0; q < c; q++)
+        weights[0] = Mat(channels);
+        weights[1] = Mat(channels);
+        for (int q = 0; q < channels; q++)
         {
-            weights[0][q] = norm_vals[q];
-            weights[1][q] = -mean_vals[q] * norm_vals[q];
+            const float norm = norm_vals ? norm_vals[q] : 1.f;
+            weights[0][q] = norm;
+            weights[1][q] = -mean_vals[q] * norm;
         }
 
         op->load_model(ModelBinFromMatArray(weights));
@@ -1198,12 +1211,28 @@ void Mat::substract_mean_normalize(const float* mean_vals, const float* norm_val
         return;
     }
 
-    Option opt;
-    opt.num_threads = 1; // TODO
-
     op->create_pipeline(opt);
 
-    op->forward_inplace(*this, opt);
+    if (elempack != 1 && !op->support_packing)
+    {
+        Mat unpacked;
+        convert_packing(*this, unpacked, 1, opt);
+
+        op->forward_inplace(unpacked, opt);
+
+        Mat packed;
+        convert_packing(unpacked, packed, elempack, opt);
+
+        // write back into the same storage, other references may share it
+        for (int q = 0; q < c; q++)
+        {
+            memcpy(channel(q), packed.channel(q), (size_t)w * h * d * elemsize);
+        }
+    }
+    else
+    {
+        op->forward_inplace(*this, opt);
+    }
 
     op->destroy_pipeline(opt);
 
@@ -1211,12 +1240,18 @@ void Mat::substract_mean_normalize(const float* mean_vals, const float* norm_val
 }
 
 Mat Mat::from_float16(const unsigned short* data, int size)
+{
+    Option opt;
+    opt.num_threads = 1;
+
+    return from_float16(data, size, opt);
+}
+
+Mat Mat::from_float16(const unsigned short* data, int size, const Option& opt)
 {
     Mat src(size, (void*)data, (size_t)2u);
     Mat dst;
 
-    Option opt;
-    opt.num_threads = 1; // TODO
     cast_float16_to_float32(src, dst, opt);
 
     return dst;
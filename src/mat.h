@@ -57,6 +57,42 @@ class VkMat;
 class VkImageMat;
 #endif // NCNN_VULKAN
 
+#if NCNN_PIXEL
+// parameters of Mat::from_pixels_preprocess
+class NCNN_EXPORT PixelPreprocess
+{
+public:
+    // default to stretch resize and no normalization
+    PixelPreprocess();
+
+    // letterbox placement of a w x h image inside the target size
+    // tensor coordinates map back to the image by (x - pad_left) * w / resize_w
+    void get_letterbox(int w, int h, int& resize_w, int& resize_h, int& pad_left, int& pad_top) const;
+
+public:
+    // output tensor size, 0 keeps the image size
+    int target_width;
+    int target_height;
+
+    // keep the aspect ratio and pad the border evenly
+    // stretch to the target size when disabled
+    bool letterbox;
+
+    // border pixel value before normalization
+    float pad_value;
+
+    // channel-wise (v - mean) * norm on the converted channels
+    float mean_vals[4];
+    float norm_vals[4];
+
+    // output elempack, 0 picks the widest supported one dividing the channel count
+    int elempack;
+
+    // store the tensor as fp16
+    bool use_fp16_storage;
+};
+#endif // NCNN_PIXEL
+
 // the three dimension matrix
 class NCNN_EXPORT Mat
 {
@@ -263,6 +299,16 @@ public:
         PIXEL_BGRA2BGR = PIXEL_BGRA | (PIXEL_BGR << PIXEL_CONVERT_SHIFT),
         PIXEL_BGRA2GRAY = PIXEL_BGRA | (PIXEL_GRAY << PIXEL_CONVERT_SHIFT),
         PIXEL_BGRA2RGBA = PIXEL_BGRA | (PIXEL_RGBA << PIXEL_CONVERT_SHIFT),
+
+        // yuv420sp sources, only accepted by from_pixels_preprocess
+        PIXEL_NV21 = 6,
+        PIXEL_NV12 = 7,
+
+        PIXEL_NV212RGB = PIXEL_NV21 | (PIXEL_RGB << PIXEL_CONVERT_SHIFT),
+        PIXEL_NV212BGR = PIXEL_NV21 | (PIXEL_BGR << PIXEL_CONVERT_SHIFT),
+
+        PIXEL_NV122RGB = PIXEL_NV12 | (PIXEL_RGB << PIXEL_CONVERT_SHIFT),
+        PIXEL_NV122BGR = PIXEL_NV12 | (PIXEL_BGR << PIXEL_CONVERT_SHIFT),
     };
     // convenient construct from pixel data
     static Mat from_pixels(const unsigned char* pixels, int type, int w, int h, Allocator* allocator = 0);
@@ -280,6 +326,10 @@ public:
     static Mat from_pixels_roi_resize(const unsigned char* pixels, int type, int w, int h, int roix, int roiy, int roiw, int roih, int target_width, int target_height, Allocator* allocator = 0);
     // convenient construct from pixel data roi and resize to specific size with stride(bytes-per-row) parameter
     static Mat from_pixels_roi_resize(const unsigned char* pixels, int type, int w, int h, int stride, int roix, int roiy, int roiw, int roih, int target_width, int target_height, Allocator* allocator = 0);
+    // convenient construct from pixel data with resize, letterbox, normalize, packing and fp16 storage fused in one pass
+    static Mat from_pixels_preprocess(const unsigned char* pixels, int type, int w, int h, const PixelPreprocess& pp, const Option& opt = Option());
+    // convenient construct from pixel data with resize, letterbox, normalize, packing and fp16 storage fused in one pass with stride(bytes-per-row) parameter
+    static Mat from_pixels_preprocess(const unsigned char* pixels, int type, int w, int h, int stride, const PixelPreprocess& pp, const Option& opt = Option());
 
     // convenient export to pixel data
     void to_pixels(unsigned char* pixels, int type) const;
@@ -308,9 +358,13 @@ public:
 
     // substract channel-wise mean values, then multiply by normalize values, pass 0 to skip
     void substract_mean_normalize(const float* mean_vals, const float* norm_vals);
+    // substract_mean_normalize with the threads of opt, works on packed layout too
+    void substract_mean_normalize(const float* mean_vals, const float* norm_vals, const Option& opt);
 
     // convenient construct from half precision floating point data
     static Mat from_float16(const unsigned short* data, int size);
+    // from_float16 with the threads and blob allocator of opt
+    static Mat from_float16(const unsigned short* data, int size, const Option& opt);
 
     // pointer to the data
     void* data;
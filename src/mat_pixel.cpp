@@ -19,11 +19,22 @@
 #if __ARM_NEON
 #include <arm_neon.h>
 #endif // __ARM_NEON
+#if __SSE2__
+#include <emmintrin.h>
+#if __AVX__
+#include <immintrin.h>
+#endif // __AVX__
+#endif // __SSE2__
+#include "cpu.h"
 #include "platform.h"
 
 namespace ncnn {
 
 #if NCNN_PIXEL
+#if __SSE2__
+#include "mat_pixel_x86.h"
+#endif // __SSE2__
+
 static int from_rgb(const unsigned char* rgb, int w, int h, int stride, Mat& m, Allocator* allocator)
 {
     m.create(w, h, 3, 4u, allocator);
@@ -119,6 +130,14 @@ static int from_rgb(const unsigned char* rgb, int w, int h, int stride, Mat& m,
         }
 #endif // __aarch64__
 #endif // __ARM_NEON
+#if __SSE2__
+        int nn = unpack_c3_x86(rgb, ptr0, ptr1, ptr2, remain);
+        rgb += 3 * nn;
+        ptr0 += nn;
+        ptr1 += nn;
+        ptr2 += nn;
+        remain -= nn;
+#endif // __SSE2__
         for (; remain > 0; remain--)
         {
             *ptr0 = rgb[0];
@@ -191,6 +210,14 @@ static void to_rgb(const Mat& m, unsigned char* rgb, int stride)
             ptr2 += 8;
         }
 #endif // __ARM_NEON
+#if __SSE2__
+        int nn = pack_c3_x86(ptr0, ptr1, ptr2, rgb, remain);
+        rgb += 3 * nn;
+        ptr0 += nn;
+        ptr1 += nn;
+        ptr2 += nn;
+        remain -= nn;
+#endif // __SSE2__
         for (; remain > 0; remain--)
         {
             rgb[0] = SATURATE_CAST_UCHAR(*ptr0);
@@ -284,6 +311,12 @@ static int from_gray(const unsigned char* gray, int w, int h, int stride, Mat& m
         }
 #endif // __aarch64__
 #endif // __ARM_NEON
+#if __SSE2__
+        int nn = unpack_c1_x86(gray, ptr, remain);
+        gray += nn;
+        ptr += nn;
+        remain -= nn;
+#endif // __SSE2__
         for (; remain > 0; remain--)
         {
             *ptr = *gray;
@@ -339,6 +372,12 @@ static void to_gray(const Mat& m, unsigned char* gray, int stride)
             ptr += 8;
         }
 #endif // __ARM_NEON
+#if __SSE2__
+        int nn = pack_c1_x86(ptr, gray, remain);
+        gray += nn;
+        ptr += nn;
+        remain -= nn;
+#endif // __SSE2__
         for (; remain > 0; remain--)
         {
             *gray = SATURATE_CAST_UCHAR(*ptr);
@@ -462,6 +501,15 @@ static int from_rgba(const unsigned char* rgba, int w, int h, int stride, Mat& m
         }
 #endif // __aarch64__
 #endif // __ARM_NEON
+#if __SSE2__
+        int nn = unpack_c4_x86(rgba, ptr0, ptr1, ptr2, ptr3, remain);
+        rgba += 4 * nn;
+        ptr0 += nn;
+        ptr1 += nn;
+        ptr2 += nn;
+        ptr3 += nn;
+        remain -= nn;
+#endif // __SSE2__
         for (; remain > 0; remain--)
         {
             *ptr0 = rgba[0];
@@ -542,6 +590,15 @@ static void to_rgba(const Mat& m, unsigned char* rgba, int stride)
             ptr3 += 8;
         }
 #endif // __ARM_NEON
+#if __SSE2__
+        int nn = pack_c4_x86(ptr0, ptr1, ptr2, ptr3, rgba, remain);
+        rgba += 4 * nn;
+        ptr0 += nn;
+        ptr1 += nn;
+        ptr2 += nn;
+        ptr3 += nn;
+        remain -= nn;
+#endif // __SSE2__
         for (; remain > 0; remain--)
         {
             rgba[0] = SATURATE_CAST_UCHAR(*ptr0);
@@ -656,6 +713,14 @@ static int from_rgb2bgr(const unsigned char* rgb, int w, int h, int stride, Mat&
         }
 #endif // __aarch64__
 #endif // __ARM_NEON
+#if __SSE2__
+        int nn = unpack_c3_x86(rgb, ptr2, ptr1, ptr0, remain);
+        rgb += 3 * nn;
+        ptr0 += nn;
+        ptr1 += nn;
+        ptr2 += nn;
+        remain -= nn;
+#endif // __SSE2__
         for (; remain > 0; remain--)
         {
             *ptr0 = rgb[2];
@@ -728,6 +793,14 @@ static void to_bgr2rgb(const Mat& m, unsigned char* rgb, int stride)
             ptr2 += 8;
         }
 #endif // __ARM_NEON
+#if __SSE2__
+        int nn = pack_c3_x86(ptr2, ptr1, ptr0, rgb, remain);
+        rgb += 3 * nn;
+        ptr0 += nn;
+        ptr1 += nn;
+        ptr2 += nn;
+        remain -= nn;
+#endif // __SSE2__
         for (; remain > 0; remain--)
         {
             rgb[2] = SATURATE_CAST_UCHAR(*ptr0);
@@ -917,6 +990,14 @@ static void to_rgb2rgba(const Mat& m, unsigned char* rgba, int stride)
             ptr2 += 8;
         }
 #endif // __ARM_NEON
+#if __SSE2__
+        int nn = pack_c4_x86(ptr0, ptr1, ptr2, 0, rgba, remain);
+        rgba += 4 * nn;
+        ptr0 += nn;
+        ptr1 += nn;
+        ptr2 += nn;
+        remain -= nn;
+#endif // __SSE2__
         for (; remain > 0; remain--)
         {
             rgba[0] = SATURATE_CAST_UCHAR(*ptr0);
@@ -1107,6 +1188,14 @@ static void to_bgr2rgba(const Mat& m, unsigned char* rgba, int stride)
             ptr2 += 8;
         }
 #endif // __ARM_NEON
+#if __SSE2__
+        int nn = pack_c4_x86(ptr2, ptr1, ptr0, 0, rgba, remain);
+        rgba += 4 * nn;
+        ptr0 += nn;
+        ptr1 += nn;
+        ptr2 += nn;
+        remain -= nn;
+#endif // __SSE2__
         for (; remain > 0; remain--)
         {
             rgba[0] = SATURATE_CAST_UCHAR(*ptr2);
@@ -1223,6 +1312,16 @@ static int from_gray2rgb(const unsigned char* gray, int w, int h, int stride, Ma
         }
 #endif // __aarch64__
 #endif // __ARM_NEON
+#if __SSE2__
+        int nn = unpack_c1_x86(gray, ptr0, remain);
+        unpack_c1_x86(gray, ptr1, nn);
+        unpack_c1_x86(gray, ptr2, nn);
+        gray += nn;
+        ptr0 += nn;
+        ptr1 += nn;
+        ptr2 += nn;
+        remain -= nn;
+#endif // __SSE2__
         for (; remain > 0; remain--)
         {
             *ptr0 = *gray;
@@ -1304,6 +1403,12 @@ static void to_gray2rgba(const Mat& m, unsigned char* rgba, int stride)
             ptr += 8;
         }
 #endif // __ARM_NEON
+#if __SSE2__
+        int nn = pack_c4_x86(ptr, ptr, ptr, 0, rgba, remain);
+        rgba += 4 * nn;
+        ptr += nn;
+        remain -= nn;
+#endif // __SSE2__
         for (; remain > 0; remain--)
         {
             unsigned char gray = SATURATE_CAST_UCHAR(*ptr);
@@ -1416,6 +1521,14 @@ static int from_rgba2rgb(const unsigned char* rgba, int w, int h, int stride, Ma
         }
 #endif // __aarch64__
 #endif // __ARM_NEON
+#if __SSE2__
+        int nn = unpack_c4_x86(rgba, ptr0, ptr1, ptr2, 0, remain);
+        rgba += 4 * nn;
+        ptr0 += nn;
+        ptr1 += nn;
+        ptr2 += nn;
+        remain -= nn;
+#endif // __SSE2__
         for (; remain > 0; remain--)
         {
             *ptr0 = rgba[0];
@@ -1529,6 +1642,14 @@ static int from_rgba2bgr(const unsigned char* rgba, int w, int h, int stride, Ma
         }
 #endif // __aarch64__
 #endif // __ARM_NEON
+#if __SSE2__
+        int nn = unpack_c4_x86(rgba, ptr2, ptr1, ptr0, 0, remain);
+        rgba += 4 * nn;
+        ptr0 += nn;
+        ptr1 += nn;
+        ptr2 += nn;
+        remain -= nn;
+#endif // __SSE2__
         for (; remain > 0; remain--)
         {
             *ptr0 = rgba[2];
@@ -1758,6 +1879,15 @@ static int from_rgba2bgra(const unsigned char* rgba, int w, int h, int stride, M
         }
 #endif // __aarch64__
 #endif // __ARM_NEON
+#if __SSE2__
+        int nn = unpack_c4_x86(rgba, ptr2, ptr1, ptr0, ptr3, remain);
+        rgba += 4 * nn;
+        ptr0 += nn;
+        ptr1 += nn;
+        ptr2 += nn;
+        ptr3 += nn;
+        remain -= nn;
+#endif // __SSE2__
         for (; remain > 0; remain--)
         {
             *ptr0 = rgba[2];
@@ -1838,6 +1968,15 @@ static void to_rgba2bgra(const Mat& m, unsigned char* bgra, int stride)
             ptr3 += 8;
         }
 #endif // __ARM_NEON
+#if __SSE2__
+        int nn = pack_c4_x86(ptr2, ptr1, ptr0, ptr3, bgra, remain);
+        bgra += 4 * nn;
+        ptr0 += nn;
+        ptr1 += nn;
+        ptr2 += nn;
+        ptr3 += nn;
+        remain -= nn;
+#endif // __SSE2__
         for (; remain > 0; remain--)
         {
             bgra[0] = SATURATE_CAST_UCHAR(*ptr2);
@@ -2086,6 +2225,16 @@ void yuv420sp2rgb(const unsigned char* yuv420sp, int w, int h, unsigned char* rg
 #endif // __aarch64__
 #endif // __ARM_NEON
 
+#if __SSE2__
+        int nn = yuv420sp2rgb_x86(yptr0, yptr1, vuptr, rgb0, rgb1, remain, 0);
+        yptr0 += nn;
+        yptr1 += nn;
+        vuptr += nn;
+        rgb0 += 3 * nn;
+        rgb1 += 3 * nn;
+        remain -= nn;
+#endif // __SSE2__
+
 #define SATURATE_CAST_UCHAR(X) (unsigned char)::std::min(::std::max((int)(X), 0), 255);
         for (; remain > 0; remain -= 2)
         {
@@ -2277,6 +2426,16 @@ void yuv420sp2rgb_nv12(const unsigned char* yuv420sp, int w, int h, unsigned cha
 #endif // __aarch64__
 #endif // __ARM_NEON
 
+#if __SSE2__
+        int nn = yuv420sp2rgb_x86(yptr0, yptr1, uvptr, rgb0, rgb1, remain, 1);
+        yptr0 += nn;
+        yptr1 += nn;
+        uvptr += nn;
+        rgb0 += 3 * nn;
+        rgb1 += 3 * nn;
+        remain -= nn;
+#endif // __SSE2__
+
 #define SATURATE_CAST_UCHAR(X) (unsigned char)::std::min(::std::max((int)(X), 0), 255);
         for (; remain > 0; remain -= 2)
         {
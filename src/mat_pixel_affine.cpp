@@ -16,6 +16,9 @@
 #if __ARM_NEON
 #include <arm_neon.h>
 #endif // __ARM_NEON
+#if __SSE2__
+#include <emmintrin.h>
+#endif // __SSE2__
 #include <limits.h>
 
 #include "platform.h"
@@ -151,6 +154,81 @@ void invert_affine_transform(const float* tm, float* tm_inv)
     tm_inv[5] = b2;
 }
 
+#if __SSE2__
+// bilinear sample 8 dst pixels whose source quads are all inside
+// the fixed-point rounding is identical to the scalar path
+static inline void warpaffine_bilinear_inside_8_sse2(const unsigned char* src0, int srcstride, int X0, int Y0, const int* adelta, const int* bdelta, unsigned char* dst0, int elempack)
+{
+    __m128i _Xl = _mm_add_epi32(_mm_set1_epi32(X0), _mm_loadu_si128((const __m128i*)adelta));
+    __m128i _Xh = _mm_add_epi32(_mm_set1_epi32(X0), _mm_loadu_si128((const __m128i*)(adelta + 4)));
+    __m128i _Yl = _mm_add_epi32(_mm_set1_epi32(Y0), _mm_loadu_si128((const __m128i*)bdelta));
+    __m128i _Yh = _mm_add_epi32(_mm_set1_epi32(Y0), _mm_loadu_si128((const __m128i*)(bdelta + 4)));
+
+    int sx[8];
+    int sy[8];
+    _mm_storeu_si128((__m128i*)sx, _mm_srai_epi32(_Xl, 10));
+    _mm_storeu_si128((__m128i*)(sx + 4), _mm_srai_epi32(_Xh, 10));
+    _mm_storeu_si128((__m128i*)sy, _mm_srai_epi32(_Yl, 10));
+    _mm_storeu_si128((__m128i*)(sy + 4), _mm_srai_epi32(_Yh, 10));
+
+    // (1024 - f, f) short pairs as madd weights
+    const __m128i _v1024 = _mm_set1_epi32(1 << 10);
+    const __m128i _v1024m1 = _mm_set1_epi32((1 << 10) - 1);
+    __m128i _fxl = _mm_and_si128(_Xl, _v1024m1);
+    __m128i _fxh = _mm_and_si128(_Xh, _v1024m1);
+    __m128i _fyl = _mm_and_si128(_Yl, _v1024m1);
+    __m128i _fyh = _mm_and_si128(_Yh, _v1024m1);
+
+    int alpha[8];
+    int beta[8];
+    _mm_storeu_si128((__m128i*)alpha, _mm_or_si128(_mm_sub_epi32(_v1024, _fxl), _mm_slli_epi32(_fxl, 16)));
+    _mm_storeu_si128((__m128i*)(alpha + 4), _mm_or_si128(_mm_sub_epi32(_v1024, _fxh), _mm_slli_epi32(_fxh, 16)));
+    _mm_storeu_si128((__m128i*)beta, _mm_or_si128(_mm_sub_epi32(_v1024, _fyl), _mm_slli_epi32(_fyl, 16)));
+    _mm_storeu_si128((__m128i*)(beta + 4), _mm_or_si128(_mm_sub_epi32(_v1024, _fyh), _mm_slli_epi32(_fyh, 16)));
+
+    // gather the left and right neighbors as short pairs, weights replicated per channel
+    short a01[8 * 4 * 2];
+    short b01[8 * 4 * 2];
+    int alphas[8 * 4];
+    int betas[8 * 4];
+    for (int i = 0; i < 8; i++)
+    {
+        const unsigned char* a0 = src0 + srcstride * sy[i] + sx[i] * elempack;
+        const unsigned char* b0 = a0 + srcstride;
+
+        for (int k = 0; k < elempack; k++)
+        {
+            const int j = i * elempack + k;
+            a01[j * 2] = a0[k];
+            a01[j * 2 + 1] = a0[k + elempack];
+            b01[j * 2] = b0[k];
+            b01[j * 2 + 1] = b0[k + elempack];
+            alphas[j] = alpha[i];
+            betas[j] = beta[i];
+        }
+    }
+
+    const int size = 8 * elempack;
+    for (int j = 0; j < size; j += 8)
+    {
+        __m128i _r[2];
+        for (int l = 0; l < 2; l++)
+        {
+            const int jj = j + l * 4;
+            __m128i _alpha = _mm_loadu_si128((const __m128i*)(alphas + jj));
+            __m128i _beta = _mm_loadu_si128((const __m128i*)(betas + jj));
+            __m128i _a = _mm_srai_epi32(_mm_madd_epi16(_mm_loadu_si128((const __m128i*)(a01 + jj * 2)), _alpha), 5);
+            __m128i _b = _mm_srai_epi32(_mm_madd_epi16(_mm_loadu_si128((const __m128i*)(b01 + jj * 2)), _alpha), 5);
+            __m128i _ab = _mm_or_si128(_a, _mm_slli_epi32(_b, 16));
+            _r[l] = _mm_srli_epi32(_mm_madd_epi16(_ab, _beta), 15);
+        }
+
+        __m128i _r01 = _mm_packs_epi32(_r[0], _r[1]);
+        _mm_storel_epi64((__m128i*)(dst0 + j), _mm_packus_epi16(_r01, _r01));
+    }
+}
+#endif // __SSE2__
+
 void warpaffine_bilinear_c1(const unsigned char* src, int srcw, int srch, unsigned char* dst, int w, int h, const float* tm, int type, unsigned int v)
 {
     return warpaffine_bilinear_c1(src, srcw, srch, srcw, dst, w, h, w, tm, type, v);
@@ -298,6 +376,10 @@ void warpaffine_bilinear_c1(const unsigned char* src, int srcw, int srch, int sr
 
                 vst1_u8(dst0, _dst);
 
+                dst0 += 8;
+#elif __SSE2__
+                warpaffine_bilinear_inside_8_sse2(src0, srcstride, X0, Y0, adelta.data() + x, bdelta.data() + x, dst0, 1);
+
                 dst0 += 8;
 #else
                 for (int xi = 0; xi < 8; xi++)
@@ -616,6 +698,10 @@ void warpaffine_bilinear_c2(const unsigned char* src, int srcw, int srch, int sr
 
                 vst2_u8(dst0, _dst);
 
+                dst0 += 2 * 8;
+#elif __SSE2__
+                warpaffine_bilinear_inside_8_sse2(src0, srcstride, X0, Y0, adelta.data() + x, bdelta.data() + x, dst0, 2);
+
                 dst0 += 2 * 8;
 #else
                 for (int xi = 0; xi < 8; xi++)
@@ -976,6 +1062,10 @@ void warpaffine_bilinear_c3(const unsigned char* src, int srcw, int srch, int sr
 
                 vst3_u8(dst0, _dst);
 
+                dst0 += 3 * 8;
+#elif __SSE2__
+                warpaffine_bilinear_inside_8_sse2(src0, srcstride, X0, Y0, adelta.data() + x, bdelta.data() + x, dst0, 3);
+
                 dst0 += 3 * 8;
 #else
                 for (int xi = 0; xi < 8; xi++)
@@ -1378,6 +1468,10 @@ void warpaffine_bilinear_c4(const unsigned char* src, int srcw, int srch, int sr
 
                 vst4_u8(dst0, _dst);
 
+                dst0 += 4 * 8;
+#elif __SSE2__
+                warpaffine_bilinear_inside_8_sse2(src0, srcstride, X0, Y0, adelta.data() + x, bdelta.data() + x, dst0, 4);
+
                 dst0 += 4 * 8;
 #else
                 for (int xi = 0; xi < 8; xi++)
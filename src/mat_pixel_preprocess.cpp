@@ -0,0 +1,600 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "mat.h"
+
+#include <limits.h>
+#include <math.h>
+
+#if __ARM_NEON
+#include <arm_neon.h>
+#endif // __ARM_NEON
+#if __SSE2__
+#include <emmintrin.h>
+#endif // __SSE2__
+#include "cpu.h"
+#include "platform.h"
+
+namespace ncnn {
+
+#if NCNN_PIXEL
+PixelPreprocess::PixelPreprocess()
+{
+    target_width = 0;
+    target_height = 0;
+    letterbox = false;
+    pad_value = 0.f;
+
+    for (int i = 0; i < 4; i++)
+    {
+        mean_vals[i] = 0.f;
+        norm_vals[i] = 1.f;
+    }
+
+    elempack = 0;
+    use_fp16_storage = false;
+}
+
+void PixelPreprocess::get_letterbox(int w, int h, int& resize_w, int& resize_h, int& pad_left, int& pad_top) const
+{
+    const int outw = target_width > 0 ? target_width : w;
+    const int outh = target_height > 0 ? target_height : h;
+
+    if (!letterbox)
+    {
+        resize_w = outw;
+        resize_h = outh;
+        pad_left = 0;
+        pad_top = 0;
+        return;
+    }
+
+    const float scale = std::min((float)outw / w, (float)outh / h);
+
+    resize_w = std::max(std::min((int)(w * scale + 0.5f), outw), 1);
+    resize_h = std::max(std::min((int)(h * scale + 0.5f), outh), 1);
+    pad_left = (outw - resize_w) / 2;
+    pad_top = (outh - resize_h) / 2;
+}
+
+// channel semantics of the pixel formats
+enum
+{
+    CHANNEL_R = 0,
+    CHANNEL_G = 1,
+    CHANNEL_B = 2,
+    CHANNEL_A = 3,
+    CHANNEL_Y = 4
+};
+
+static int pixel_format_channels(int format, int* semantics)
+{
+    switch (format)
+    {
+    case Mat::PIXEL_RGB:
+        semantics[0] = CHANNEL_R;
+        semantics[1] = CHANNEL_G;
+        semantics[2] = CHANNEL_B;
+        return 3;
+    case Mat::PIXEL_BGR:
+        semantics[0] = CHANNEL_B;
+        semantics[1] = CHANNEL_G;
+        semantics[2] = CHANNEL_R;
+        return 3;
+    case Mat::PIXEL_GRAY:
+        semantics[0] = CHANNEL_Y;
+        return 1;
+    case Mat::PIXEL_RGBA:
+        semantics[0] = CHANNEL_R;
+        semantics[1] = CHANNEL_G;
+        semantics[2] = CHANNEL_B;
+        semantics[3] = CHANNEL_A;
+        return 4;
+    case Mat::PIXEL_BGRA:
+        semantics[0] = CHANNEL_B;
+        semantics[1] = CHANNEL_G;
+        semantics[2] = CHANNEL_R;
+        semantics[3] = CHANNEL_A;
+        return 4;
+    }
+
+    return 0;
+}
+
+// express each destination channel as a weighted sum of source channels plus bias
+// with the mean and norm folded in, so that resize and normalize commute
+static void resolve_channel_transform(const int* src_semantics, int srcc, const int* dst_semantics, int dstc, const PixelPreprocess& pp, float* weights, float* bias)
+{
+    for (int q = 0; q < dstc; q++)
+    {
+        float* wq = weights + q * 4;
+        for (int k = 0; k < 4; k++)
+        {
+            wq[k] = 0.f;
+        }
+        bias[q] = 0.f;
+
+        const int dst_semantic = dst_semantics[q];
+
+        int found = 0;
+        for (int k = 0; k < srcc; k++)
+        {
+            if (src_semantics[k] == dst_semantic)
+            {
+                wq[k] = 1.f;
+                found = 1;
+            }
+        }
+
+        if (!found)
+        {
+            if (dst_semantic == CHANNEL_A)
+            {
+                bias[q] = 255.f;
+            }
+            else if (dst_semantic == CHANNEL_Y)
+            {
+                // same weights as the rgb2gray conversion
+                for (int k = 0; k < srcc; k++)
+                {
+                    if (src_semantics[k] == CHANNEL_R) wq[k] = 77 / 256.f;
+                    if (src_semantics[k] == CHANNEL_G) wq[k] = 150 / 256.f;
+                    if (src_semantics[k] == CHANNEL_B) wq[k] = 29 / 256.f;
+                }
+            }
+            else
+            {
+                // gray to color
+                wq[0] = 1.f;
+            }
+        }
+
+        const float mean = pp.mean_vals[q];
+        const float norm = pp.norm_vals[q];
+        for (int k = 0; k < 4; k++)
+        {
+            wq[k] *= norm;
+        }
+        bias[q] = (bias[q] - mean) * norm;
+    }
+}
+
+// linear interpolation coordinates shared with resize_bilinear
+static void resolve_resize_coords(int srcsize, int size, int* ofs0, int* ofs1, float* alpha)
+{
+    const double scale = (double)srcsize / size;
+
+    for (int dx = 0; dx < size; dx++)
+    {
+        float fx = (float)((dx + 0.5) * scale - 0.5);
+        int sx = static_cast<int>(floor(fx));
+        fx -= sx;
+
+        if (sx < 0)
+        {
+            sx = 0;
+            fx = 0.f;
+        }
+        if (sx >= srcsize - 1)
+        {
+            sx = std::max(srcsize - 2, 0);
+            fx = srcsize > 1 ? 1.f : 0.f;
+        }
+
+        ofs0[dx] = sx;
+        ofs1[dx] = std::min(sx + 1, srcsize - 1);
+        alpha[dx] = fx;
+    }
+}
+
+static void yuv420sp2rgb_row(const unsigned char* yptr, const unsigned char* uvptr, int w, int nv12, unsigned char* rgb)
+{
+#define SATURATE_CAST_UCHAR(X) (unsigned char)::std::min(::std::max((int)(X), 0), 255);
+    for (int x = 0; x < w; x++)
+    {
+        const unsigned char* uv = uvptr + x / 2 * 2;
+
+        int v = (nv12 ? uv[1] : uv[0]) - 128;
+        int u = (nv12 ? uv[0] : uv[1]) - 128;
+
+        int ruv = 90 * v;
+        int guv = -46 * v + -22 * u;
+        int buv = 113 * u;
+
+        int y = yptr[x] << 6;
+
+        rgb[0] = SATURATE_CAST_UCHAR((y + ruv) >> 6);
+        rgb[1] = SATURATE_CAST_UCHAR((y + guv) >> 6);
+        rgb[2] = SATURATE_CAST_UCHAR((y + buv) >> 6);
+
+        rgb += 3;
+    }
+#undef SATURATE_CAST_UCHAR
+}
+
+// fixed point scale of the horizontal interpolation coefficients
+#define PREPROCESS_COEF_BITS  11
+#define PREPROCESS_COEF_SCALE (1 << PREPROCESS_COEF_BITS)
+
+// horizontal interpolation of one source row into planar source channels
+// the integer rows are scaled by PREPROCESS_COEF_SCALE
+template<int srcc>
+static void hresample(const unsigned char* src, const int* xofs0, const int* xofs1, const short* ialpha, int size, int* rows)
+{
+    for (int dx = 0; dx < size; dx++)
+    {
+        const unsigned char* p0 = src + xofs0[dx] * srcc;
+        const unsigned char* p1 = src + xofs1[dx] * srcc;
+        const int a0 = ialpha[dx * 2];
+        const int a1 = ialpha[dx * 2 + 1];
+
+        for (int k = 0; k < srcc; k++)
+        {
+            rows[k * size + dx] = p0[k] * a0 + p1[k] * a1;
+        }
+    }
+}
+
+static void hresample(const unsigned char* src, int srcc, const int* xofs0, const int* xofs1, const short* ialpha, int size, int* rows)
+{
+    if (srcc == 1) hresample<1>(src, xofs0, xofs1, ialpha, size, rows);
+    if (srcc == 3) hresample<3>(src, xofs0, xofs1, ialpha, size, rows);
+    if (srcc == 4) hresample<4>(src, xofs0, xofs1, ialpha, size, rows);
+}
+
+// vertical interpolation of planar source rows, then channel conversion and normalization
+// into one planar destination row, source channels with zero weight are skipped
+static void vresample(const int* rows0, const int* rows1, int srcc, int size, float b0, float b1, const float* wq, float bias, float* outptr)
+{
+    float c0[4];
+    float c1[4];
+    int ks[4];
+    int nk = 0;
+    for (int k = 0; k < srcc; k++)
+    {
+        if (wq[k] == 0.f)
+            continue;
+
+        c0[nk] = wq[k] * b0 / PREPROCESS_COEF_SCALE;
+        c1[nk] = wq[k] * b1 / PREPROCESS_COEF_SCALE;
+        ks[nk] = k;
+        nk++;
+    }
+
+    int dx = 0;
+#if __ARM_NEON
+    float32x4_t _bias = vdupq_n_f32(bias);
+    for (; dx + 3 < size; dx += 4)
+    {
+        float32x4_t _sum = _bias;
+        for (int j = 0; j < nk; j++)
+        {
+            _sum = vmlaq_n_f32(_sum, vcvtq_f32_s32(vld1q_s32(rows0 + ks[j] * size + dx)), c0[j]);
+            _sum = vmlaq_n_f32(_sum, vcvtq_f32_s32(vld1q_s32(rows1 + ks[j] * size + dx)), c1[j]);
+        }
+        vst1q_f32(outptr + dx, _sum);
+    }
+#endif // __ARM_NEON
+#if __SSE2__
+    __m128 _bias = _mm_set1_ps(bias);
+    for (; dx + 3 < size; dx += 4)
+    {
+        __m128 _sum = _bias;
+        for (int j = 0; j < nk; j++)
+        {
+            __m128 _r0 = _mm_cvtepi32_ps(_mm_loadu_si128((const __m128i*)(rows0 + ks[j] * size + dx)));
+            __m128 _r1 = _mm_cvtepi32_ps(_mm_loadu_si128((const __m128i*)(rows1 + ks[j] * size + dx)));
+            _sum = _mm_add_ps(_sum, _mm_mul_ps(_r0, _mm_set1_ps(c0[j])));
+            _sum = _mm_add_ps(_sum, _mm_mul_ps(_r1, _mm_set1_ps(c1[j])));
+        }
+        _mm_storeu_ps(outptr + dx, _sum);
+    }
+#endif // __SSE2__
+    for (; dx < size; dx++)
+    {
+        float sum = bias;
+        for (int j = 0; j < nk; j++)
+        {
+            sum += rows0[ks[j] * size + dx] * c0[j] + rows1[ks[j] * size + dx] * c1[j];
+        }
+        outptr[dx] = sum;
+    }
+}
+
+// interleave elempack planar rows into one packed row
+static void pack_rows(const float* planar, int size, int elempack, float* outptr)
+{
+    int dx = 0;
+    if (elempack == 4)
+    {
+#if __ARM_NEON
+        for (; dx + 3 < size; dx += 4)
+        {
+            float32x4x4_t _r;
+            _r.val[0] = vld1q_f32(planar + dx);
+            _r.val[1] = vld1q_f32(planar + size + dx);
+            _r.val[2] = vld1q_f32(planar + size * 2 + dx);
+            _r.val[3] = vld1q_f32(planar + size * 3 + dx);
+            vst4q_f32(outptr + dx * 4, _r);
+        }
+#endif // __ARM_NEON
+#if __SSE2__
+        for (; dx + 3 < size; dx += 4)
+        {
+            __m128 _r0 = _mm_loadu_ps(planar + dx);
+            __m128 _r1 = _mm_loadu_ps(planar + size + dx);
+            __m128 _r2 = _mm_loadu_ps(planar + size * 2 + dx);
+            __m128 _r3 = _mm_loadu_ps(planar + size * 3 + dx);
+            _MM_TRANSPOSE4_PS(_r0, _r1, _r2, _r3);
+            _mm_storeu_ps(outptr + dx * 4, _r0);
+            _mm_storeu_ps(outptr + dx * 4 + 4, _r1);
+            _mm_storeu_ps(outptr + dx * 4 + 8, _r2);
+            _mm_storeu_ps(outptr + dx * 4 + 12, _r3);
+        }
+#endif // __SSE2__
+    }
+    for (; dx < size; dx++)
+    {
+        for (int i = 0; i < elempack; i++)
+        {
+            outptr[dx * elempack + i] = planar[i * size + dx];
+        }
+    }
+}
+
+Mat Mat::from_pixels_preprocess(const unsigned char* pixels, int type, int w, int h, const PixelPreprocess& pp, const Option& opt)
+{
+    int type_from = type & PIXEL_FORMAT_MASK;
+
+    if (type_from == PIXEL_RGB || type_from == PIXEL_BGR)
+    {
+        return Mat::from_pixels_preprocess(pixels, type, w, h, w * 3, pp, opt);
+    }
+    else if (type_from == PIXEL_GRAY || type_from == PIXEL_NV21 || type_from == PIXEL_NV12)
+    {
+        return Mat::from_pixels_preprocess(pixels, type, w, h, w * 1, pp, opt);
+    }
+    else if (type_from == PIXEL_RGBA || type_from == PIXEL_BGRA)
+    {
+        return Mat::from_pixels_preprocess(pixels, type, w, h, w * 4, pp, opt);
+    }
+
+    // unknown convert type
+    NCNN_LOGE("unknown convert type %d", type);
+    return Mat();
+}
+
+Mat Mat::from_pixels_preprocess(const unsigned char* pixels, int type, int w, int h, int stride, const PixelPreprocess& pp, const Option& opt)
+{
+    const int type_from = type & PIXEL_FORMAT_MASK;
+    const int type_to = (type & PIXEL_CONVERT_MASK) ? ((unsigned int)type >> PIXEL_CONVERT_SHIFT) : type_from;
+
+    // yuv420sp rows are converted to rgb before interpolation
+    const bool yuv420sp = type_from == PIXEL_NV21 || type_from == PIXEL_NV12;
+
+    int src_semantics[4];
+    int dst_semantics[4];
+    const int srcc = pixel_format_channels(yuv420sp ? (int)PIXEL_RGB : type_from, src_semantics);
+    const int dstc = pixel_format_channels(type_to, dst_semantics);
+    if (srcc == 0 || dstc == 0 || (yuv420sp && dstc != 3))
+    {
+        NCNN_LOGE("unknown convert type %d", type);
+        return Mat();
+    }
+
+    int elempack = pp.elempack;
+    if (elempack == 0)
+    {
+        elempack = opt.use_packing_layout && dstc % 4 == 0 ? 4 : 1;
+    }
+    if (elempack != 1 && elempack != 4 && elempack != 8 && elempack != 16)
+    {
+        NCNN_LOGE("unsupported elempack %d", elempack);
+        return Mat();
+    }
+    if (dstc % elempack != 0)
+    {
+        NCNN_LOGE("elempack %d does not divide %d channels", elempack, dstc);
+        return Mat();
+    }
+
+    const int outw = pp.target_width > 0 ? pp.target_width : w;
+    const int outh = pp.target_height > 0 ? pp.target_height : h;
+
+    int rw;
+    int rh;
+    int pad_left;
+    int pad_top;
+    pp.get_letterbox(w, h, rw, rh, pad_left, pad_top);
+
+    float weights[4 * 4];
+    float bias[4];
+    resolve_channel_transform(src_semantics, srcc, dst_semantics, dstc, pp, weights, bias);
+
+    // border value after conversion and normalization
+    float pad_vals[4];
+    for (int q = 0; q < dstc; q++)
+    {
+        pad_vals[q] = bias[q];
+        for (int k = 0; k < srcc; k++)
+        {
+            pad_vals[q] += weights[q * 4 + k] * pp.pad_value;
+        }
+    }
+
+    const size_t elemsize = (pp.use_fp16_storage ? 2u : 4u) * elempack;
+
+    Mat m;
+    m.create(outw, outh, dstc / elempack, elemsize, elempack, opt.blob_allocator);
+    if (m.empty())
+        return m;
+
+    std::vector<int> xofs0(rw);
+    std::vector<int> xofs1(rw);
+    std::vector<float> alpha(rw);
+    resolve_resize_coords(w, rw, xofs0.data(), xofs1.data(), alpha.data());
+
+    std::vector<short> ialpha(rw * 2);
+    for (int dx = 0; dx < rw; dx++)
+    {
+        const int a1 = (int)(alpha[dx] * PREPROCESS_COEF_SCALE + 0.5f);
+        ialpha[dx * 2] = (short)(PREPROCESS_COEF_SCALE - a1);
+        ialpha[dx * 2 + 1] = (short)a1;
+    }
+
+    std::vector<int> yofs0(rh);
+    std::vector<int> yofs1(rh);
+    std::vector<float> beta(rh);
+    resolve_resize_coords(h, rh, yofs0.data(), yofs1.data(), beta.data());
+
+    const int num_threads = std::max(opt.num_threads, 1);
+
+    // per thread: two cached source rows of planar channels, planar destination rows and one packed output row
+    const int rowsize = rw * srcc;
+    Mat rowsbuf(rowsize * 2 + rw * elempack + outw * elempack, 1, num_threads, 4u, opt.workspace_allocator);
+    if (rowsbuf.empty())
+        return Mat();
+
+    Mat yuvbuf;
+    if (yuv420sp)
+    {
+        yuvbuf.create(w * 3, 1, num_threads, 1u, opt.workspace_allocator);
+        if (yuvbuf.empty())
+            return Mat();
+    }
+
+    std::vector<int> cached_sy0(num_threads, -1);
+    std::vector<int> cached_sy1(num_threads, -1);
+    std::vector<int> cached_swap(num_threads, 0);
+
+    #pragma omp parallel for num_threads(num_threads)
+    for (int y = 0; y < outh; y++)
+    {
+        const int tid = get_omp_thread_num();
+
+        int* rowsptr = rowsbuf.channel(tid);
+        float* planar = (float*)(rowsptr + rowsize * 2);
+        float* outrow = planar + rw * elempack;
+
+        const int dy = y - pad_top;
+        const bool border_row = dy < 0 || dy >= rh;
+
+        int* rows0 = rowsptr + rowsize * cached_swap[tid];
+        int* rows1 = rowsptr + rowsize * (1 - cached_swap[tid]);
+
+        if (!border_row)
+        {
+            const int sy0 = yofs0[dy];
+            const int sy1 = yofs1[dy];
+
+            // walking down the image, the previous bottom row becomes the top row
+            if (sy0 != cached_sy0[tid] && sy0 == cached_sy1[tid])
+            {
+                int* tmp = rows0;
+                rows0 = rows1;
+                rows1 = tmp;
+                cached_swap[tid] = 1 - cached_swap[tid];
+                cached_sy0[tid] = sy0;
+                cached_sy1[tid] = -1;
+            }
+
+            for (int r = 0; r < 2; r++)
+            {
+                const int sy = r == 0 ? sy0 : sy1;
+                int& cached_sy = r == 0 ? cached_sy0[tid] : cached_sy1[tid];
+                if (sy == cached_sy)
+                    continue;
+
+                const unsigned char* srcrow = pixels + (size_t)stride * sy;
+                if (yuv420sp)
+                {
+                    const unsigned char* uvrow = pixels + (size_t)stride * h + (size_t)stride * (sy / 2);
+                    unsigned char* rgb = yuvbuf.channel(tid);
+                    yuv420sp2rgb_row(srcrow, uvrow, w, type_from == PIXEL_NV12, rgb);
+                    srcrow = rgb;
+                }
+
+                hresample(srcrow, srcc, xofs0.data(), xofs1.data(), ialpha.data(), rw, r == 0 ? rows0 : rows1);
+                cached_sy = sy;
+            }
+        }
+
+        for (int q = 0; q < dstc / elempack; q++)
+        {
+            const float* pad_q = pad_vals + q * elempack;
+
+            float* ptr = pp.use_fp16_storage ? outrow : m.channel(q).row(y);
+
+            if (border_row)
+            {
+                for (int x = 0; x < outw; x++)
+                {
+                    for (int i = 0; i < elempack; i++)
+                    {
+                        ptr[x * elempack + i] = pad_q[i];
+                    }
+                }
+            }
+            else
+            {
+                for (int x = 0; x < pad_left; x++)
+                {
+                    for (int i = 0; i < elempack; i++)
+                    {
+                        ptr[x * elempack + i] = pad_q[i];
+                    }
+                }
+
+                const float b1 = beta[dy];
+                const float b0 = 1.f - b1;
+                if (elempack == 1)
+                {
+                    vresample(rows0, rows1, srcc, rw, b0, b1, weights + q * 4, bias[q], ptr + pad_left);
+                }
+                else
+                {
+                    for (int i = 0; i < elempack; i++)
+                    {
+                        const int qi = q * elempack + i;
+                        vresample(rows0, rows1, srcc, rw, b0, b1, weights + qi * 4, bias[qi], planar + i * rw);
+                    }
+
+                    pack_rows(planar, rw, elempack, ptr + pad_left * elempack);
+                }
+
+                for (int x = pad_left + rw; x < outw; x++)
+                {
+                    for (int i = 0; i < elempack; i++)
+                    {
+                        ptr[x * elempack + i] = pad_q[i];
+                    }
+                }
+            }
+
+            if (pp.use_fp16_storage)
+            {
+                unsigned short* outptr = m.channel(q).row<unsigned short>(y);
+                for (int i = 0; i < outw * elempack; i++)
+                {
+                    outptr[i] = float32_to_float16(ptr[i]);
+                }
+            }
+        }
+    }
+
+    return m;
+}
+#endif // NCNN_PIXEL
+
+} // namespace ncnn
@@ -16,6 +16,9 @@
 #if __ARM_NEON
 #include <arm_neon.h>
 #endif // __ARM_NEON
+#if __SSE2__
+#include <emmintrin.h>
+#endif // __SSE2__
 #include "platform.h"
 
 namespace ncnn {
@@ -25,6 +28,217 @@ namespace ncnn {
 // but we shall ask the original art author for permission first ...
 // https://www.reddit.com/r/anime/comments/5uxjn4/i_recreated_the_kanna_ascii_art_from_kobayashisan/
 
+#if __SSE2__
+static inline __m128i reverse_epi8_sse2(__m128i _v)
+{
+    _v = _mm_shuffle_epi32(_v, _MM_SHUFFLE(0, 1, 2, 3));
+    _v = _mm_shufflelo_epi16(_v, _MM_SHUFFLE(2, 3, 0, 1));
+    _v = _mm_shufflehi_epi16(_v, _MM_SHUFFLE(2, 3, 0, 1));
+    return _mm_or_si128(_mm_slli_epi16(_v, 8), _mm_srli_epi16(_v, 8));
+}
+
+static inline __m128i reverse_epi16_sse2(__m128i _v)
+{
+    _v = _mm_shuffle_epi32(_v, _MM_SHUFFLE(0, 1, 2, 3));
+    _v = _mm_shufflelo_epi16(_v, _MM_SHUFFLE(2, 3, 0, 1));
+    return _mm_shufflehi_epi16(_v, _MM_SHUFFLE(2, 3, 0, 1));
+}
+
+static inline __m128i reverse_epi32_sse2(__m128i _v)
+{
+    return _mm_shuffle_epi32(_v, _MM_SHUFFLE(0, 1, 2, 3));
+}
+
+// write 8 source rows as 8 consecutive dst pixels per source column
+// dst advances by dst_step for each source column
+// the bottom source row goes first when reverse is set
+static void kanna_rotate_transpose_c1_sse2(const unsigned char* src, int srcw, int srcstride, unsigned char* dst, int dst_step, int reverse)
+{
+    const unsigned char* r[8];
+    for (int i = 0; i < 8; i++)
+    {
+        r[i] = src + (reverse ? 7 - i : i) * srcstride;
+    }
+
+    int x = 0;
+    for (; x + 7 < srcw; x += 8)
+    {
+        __m128i _r0 = _mm_loadl_epi64((const __m128i*)(r[0] + x));
+        __m128i _r1 = _mm_loadl_epi64((const __m128i*)(r[1] + x));
+        __m128i _r2 = _mm_loadl_epi64((const __m128i*)(r[2] + x));
+        __m128i _r3 = _mm_loadl_epi64((const __m128i*)(r[3] + x));
+        __m128i _r4 = _mm_loadl_epi64((const __m128i*)(r[4] + x));
+        __m128i _r5 = _mm_loadl_epi64((const __m128i*)(r[5] + x));
+        __m128i _r6 = _mm_loadl_epi64((const __m128i*)(r[6] + x));
+        __m128i _r7 = _mm_loadl_epi64((const __m128i*)(r[7] + x));
+
+        __m128i _t0 = _mm_unpacklo_epi8(_r0, _r1);
+        __m128i _t1 = _mm_unpacklo_epi8(_r2, _r3);
+        __m128i _t2 = _mm_unpacklo_epi8(_r4, _r5);
+        __m128i _t3 = _mm_unpacklo_epi8(_r6, _r7);
+
+        __m128i _u0 = _mm_unpacklo_epi16(_t0, _t1);
+        __m128i _u1 = _mm_unpackhi_epi16(_t0, _t1);
+        __m128i _u2 = _mm_unpacklo_epi16(_t2, _t3);
+        __m128i _u3 = _mm_unpackhi_epi16(_t2, _t3);
+
+        __m128i _v0 = _mm_unpacklo_epi32(_u0, _u2);
+        __m128i _v1 = _mm_unpackhi_epi32(_u0, _u2);
+        __m128i _v2 = _mm_unpacklo_epi32(_u1, _u3);
+        __m128i _v3 = _mm_unpackhi_epi32(_u1, _u3);
+
+        _mm_storel_epi64((__m128i*)dst, _v0);
+        dst += dst_step;
+        _mm_storel_epi64((__m128i*)dst, _mm_unpackhi_epi64(_v0, _v0));
+        dst += dst_step;
+        _mm_storel_epi64((__m128i*)dst, _v1);
+        dst += dst_step;
+        _mm_storel_epi64((__m128i*)dst, _mm_unpackhi_epi64(_v1, _v1));
+        dst += dst_step;
+        _mm_storel_epi64((__m128i*)dst, _v2);
+        dst += dst_step;
+        _mm_storel_epi64((__m128i*)dst, _mm_unpackhi_epi64(_v2, _v2));
+        dst += dst_step;
+        _mm_storel_epi64((__m128i*)dst, _v3);
+        dst += dst_step;
+        _mm_storel_epi64((__m128i*)dst, _mm_unpackhi_epi64(_v3, _v3));
+        dst += dst_step;
+    }
+    for (; x < srcw; x++)
+    {
+        for (int i = 0; i < 8; i++)
+        {
+            dst[i] = r[i][x];
+        }
+
+        dst += dst_step;
+    }
+}
+
+static void kanna_rotate_transpose_c2_sse2(const unsigned char* src, int srcw, int srcstride, unsigned char* dst, int dst_step, int reverse)
+{
+    const unsigned char* r[8];
+    for (int i = 0; i < 8; i++)
+    {
+        r[i] = src + (reverse ? 7 - i : i) * srcstride;
+    }
+
+    int x = 0;
+    for (; x + 7 < srcw; x += 8)
+    {
+        __m128i _r0 = _mm_loadu_si128((const __m128i*)(r[0] + x * 2));
+        __m128i _r1 = _mm_loadu_si128((const __m128i*)(r[1] + x * 2));
+        __m128i _r2 = _mm_loadu_si128((const __m128i*)(r[2] + x * 2));
+        __m128i _r3 = _mm_loadu_si128((const __m128i*)(r[3] + x * 2));
+        __m128i _r4 = _mm_loadu_si128((const __m128i*)(r[4] + x * 2));
+        __m128i _r5 = _mm_loadu_si128((const __m128i*)(r[5] + x * 2));
+        __m128i _r6 = _mm_loadu_si128((const __m128i*)(r[6] + x * 2));
+        __m128i _r7 = _mm_loadu_si128((const __m128i*)(r[7] + x * 2));
+
+        __m128i _t0 = _mm_unpacklo_epi16(_r0, _r1);
+        __m128i _t1 = _mm_unpackhi_epi16(_r0, _r1);
+        __m128i _t2 = _mm_unpacklo_epi16(_r2, _r3);
+        __m128i _t3 = _mm_unpackhi_epi16(_r2, _r3);
+        __m128i _t4 = _mm_unpacklo_epi16(_r4, _r5);
+        __m128i _t5 = _mm_unpackhi_epi16(_r4, _r5);
+        __m128i _t6 = _mm_unpacklo_epi16(_r6, _r7);
+        __m128i _t7 = _mm_unpackhi_epi16(_r6, _r7);
+
+        __m128i _u0 = _mm_unpacklo_epi32(_t0, _t2);
+        __m128i _u1 = _mm_unpackhi_epi32(_t0, _t2);
+        __m128i _u2 = _mm_unpacklo_epi32(_t1, _t3);
+        __m128i _u3 = _mm_unpackhi_epi32(_t1, _t3);
+        __m128i _u4 = _mm_unpacklo_epi32(_t4, _t6);
+        __m128i _u5 = _mm_unpackhi_epi32(_t4, _t6);
+        __m128i _u6 = _mm_unpacklo_epi32(_t5, _t7);
+        __m128i _u7 = _mm_unpackhi_epi32(_t5, _t7);
+
+        _mm_storeu_si128((__m128i*)dst, _mm_unpacklo_epi64(_u0, _u4));
+        dst += dst_step;
+        _mm_storeu_si128((__m128i*)dst, _mm_unpackhi_epi64(_u0, _u4));
+        dst += dst_step;
+        _mm_storeu_si128((__m128i*)dst, _mm_unpacklo_epi64(_u1, _u5));
+        dst += dst_step;
+        _mm_storeu_si128((__m128i*)dst, _mm_unpackhi_epi64(_u1, _u5));
+        dst += dst_step;
+        _mm_storeu_si128((__m128i*)dst, _mm_unpacklo_epi64(_u2, _u6));
+        dst += dst_step;
+        _mm_storeu_si128((__m128i*)dst, _mm_unpackhi_epi64(_u2, _u6));
+        dst += dst_step;
+        _mm_storeu_si128((__m128i*)dst, _mm_unpacklo_epi64(_u3, _u7));
+        dst += dst_step;
+        _mm_storeu_si128((__m128i*)dst, _mm_unpackhi_epi64(_u3, _u7));
+        dst += dst_step;
+    }
+    for (; x < srcw; x++)
+    {
+        for (int i = 0; i < 8; i++)
+        {
+            dst[i * 2] = r[i][x * 2];
+            dst[i * 2 + 1] = r[i][x * 2 + 1];
+        }
+
+        dst += dst_step;
+    }
+}
+
+static void kanna_rotate_transpose_c4_sse2(const unsigned char* src, int srcw, int srcstride, unsigned char* dst, int dst_step, int reverse)
+{
+    const unsigned char* r[8];
+    for (int i = 0; i < 8; i++)
+    {
+        r[i] = src + (reverse ? 7 - i : i) * srcstride;
+    }
+
+    int x = 0;
+    for (; x + 3 < srcw; x += 4)
+    {
+        __m128i _r0 = _mm_loadu_si128((const __m128i*)(r[0] + x * 4));
+        __m128i _r1 = _mm_loadu_si128((const __m128i*)(r[1] + x * 4));
+        __m128i _r2 = _mm_loadu_si128((const __m128i*)(r[2] + x * 4));
+        __m128i _r3 = _mm_loadu_si128((const __m128i*)(r[3] + x * 4));
+        __m128i _r4 = _mm_loadu_si128((const __m128i*)(r[4] + x * 4));
+        __m128i _r5 = _mm_loadu_si128((const __m128i*)(r[5] + x * 4));
+        __m128i _r6 = _mm_loadu_si128((const __m128i*)(r[6] + x * 4));
+        __m128i _r7 = _mm_loadu_si128((const __m128i*)(r[7] + x * 4));
+
+        __m128i _t0 = _mm_unpacklo_epi32(_r0, _r1);
+        __m128i _t1 = _mm_unpackhi_epi32(_r0, _r1);
+        __m128i _t2 = _mm_unpacklo_epi32(_r2, _r3);
+        __m128i _t3 = _mm_unpackhi_epi32(_r2, _r3);
+        __m128i _t4 = _mm_unpacklo_epi32(_r4, _r5);
+        __m128i _t5 = _mm_unpackhi_epi32(_r4, _r5);
+        __m128i _t6 = _mm_unpacklo_epi32(_r6, _r7);
+        __m128i _t7 = _mm_unpackhi_epi32(_r6, _r7);
+
+        _mm_storeu_si128((__m128i*)dst, _mm_unpacklo_epi64(_t0, _t2));
+        _mm_storeu_si128((__m128i*)(dst + 16), _mm_unpacklo_epi64(_t4, _t6));
+        dst += dst_step;
+        _mm_storeu_si128((__m128i*)dst, _mm_unpackhi_epi64(_t0, _t2));
+        _mm_storeu_si128((__m128i*)(dst + 16), _mm_unpackhi_epi64(_t4, _t6));
+        dst += dst_step;
+        _mm_storeu_si128((__m128i*)dst, _mm_unpacklo_epi64(_t1, _t3));
+        _mm_storeu_si128((__m128i*)(dst + 16), _mm_unpacklo_epi64(_t5, _t7));
+        dst += dst_step;
+        _mm_storeu_si128((__m128i*)dst, _mm_unpackhi_epi64(_t1, _t3));
+        _mm_storeu_si128((__m128i*)(dst + 16), _mm_unpackhi_epi64(_t5, _t7));
+        dst += dst_step;
+    }
+    for (; x < srcw; x++)
+    {
+        for (int i = 0; i < 8; i++)
+        {
+            dst[i * 4] = r[i][x * 4];
+            dst[i * 4 + 1] = r[i][x * 4 + 1];
+            dst[i * 4 + 2] = r[i][x * 4 + 2];
+            dst[i * 4 + 3] = r[i][x * 4 + 3];
+        }
+
+        dst += dst_step;
+    }
+}
+#endif // __SSE2__
+
 static void kanna_rotate_1_c1(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int /*h*/, int stride)
 {
     const int srcwgap = srcstride - srcw;
@@ -586,6 +800,22 @@ static void kanna_rotate_2_c1(const unsigned char* src, int srcw, int srch, int
         }
 #endif // __aarch64__
 
+        dst0 += 15;
+#elif __SSE2__
+        dst0 -= 15;
+
+        int nn = srcw >> 4;
+        int remain = srcw - (nn << 4);
+
+        for (; nn > 0; nn--)
+        {
+            __m128i _src = _mm_loadu_si128((const __m128i*)src0);
+            _mm_storeu_si128((__m128i*)dst0, reverse_epi8_sse2(_src));
+
+            src0 += 16;
+            dst0 -= 16;
+        }
+
         dst0 += 15;
 #else
         int remain = srcw;
@@ -667,6 +897,22 @@ static void kanna_rotate_2_c2(const unsigned char* src, int srcw, int srch, int
         }
 #endif // __aarch64__
 
+        dst0 += 7 * 2;
+#elif __SSE2__
+        dst0 -= 7 * 2;
+
+        int nn = srcw >> 3;
+        int remain = srcw - (nn << 3);
+
+        for (; nn > 0; nn--)
+        {
+            __m128i _src = _mm_loadu_si128((const __m128i*)src0);
+            _mm_storeu_si128((__m128i*)dst0, reverse_epi16_sse2(_src));
+
+            src0 += 16;
+            dst0 -= 16;
+        }
+
         dst0 += 7 * 2;
 #else
         int remain = srcw;
@@ -845,6 +1091,22 @@ static void kanna_rotate_2_c4(const unsigned char* src, int srcw, int srch, int
 #endif // __aarch64__
 
         dst0 += 7 * 4;
+#elif __SSE2__
+        dst0 -= 3 * 4;
+
+        int nn = srcw >> 2;
+        int remain = srcw - (nn << 2);
+
+        for (; nn > 0; nn--)
+        {
+            __m128i _src = _mm_loadu_si128((const __m128i*)src0);
+            _mm_storeu_si128((__m128i*)dst0, reverse_epi32_sse2(_src));
+
+            src0 += 16;
+            dst0 -= 16;
+        }
+
+        dst0 += 3 * 4;
 #else
         int remain = srcw;
 #endif // __ARM_NEON
@@ -923,6 +1185,22 @@ static void kanna_rotate_3_c1(const unsigned char* src, int srcw, int srch, int
         }
 #endif // __aarch64__
 
+        dst0 += 15;
+#elif __SSE2__
+        dst0 -= 15;
+
+        int nn = srcw >> 4;
+        int remain = srcw - (nn << 4);
+
+        for (; nn > 0; nn--)
+        {
+            __m128i _src = _mm_loadu_si128((const __m128i*)src0);
+            _mm_storeu_si128((__m128i*)dst0, reverse_epi8_sse2(_src));
+
+            src0 += 16;
+            dst0 -= 16;
+        }
+
         dst0 += 15;
 #else
         int remain = srcw;
@@ -1007,6 +1285,22 @@ static void kanna_rotate_3_c2(const unsigned char* src, int srcw, int srch, int
         }
 #endif // __aarch64__
 
+        dst0 += 7 * 2;
+#elif __SSE2__
+        dst0 -= 7 * 2;
+
+        int nn = srcw >> 3;
+        int remain = srcw - (nn << 3);
+
+        for (; nn > 0; nn--)
+        {
+            __m128i _src = _mm_loadu_si128((const __m128i*)src0);
+            _mm_storeu_si128((__m128i*)dst0, reverse_epi16_sse2(_src));
+
+            src0 += 16;
+            dst0 -= 16;
+        }
+
         dst0 += 7 * 2;
 #else
         int remain = srcw;
@@ -1191,6 +1485,22 @@ static void kanna_rotate_3_c4(const unsigned char* src, int srcw, int srch, int
 #endif // __aarch64__
 
         dst0 += 7 * 4;
+#elif __SSE2__
+        dst0 -= 3 * 4;
+
+        int nn = srcw >> 2;
+        int remain = srcw - (nn << 2);
+
+        for (; nn > 0; nn--)
+        {
+            __m128i _src = _mm_loadu_si128((const __m128i*)src0);
+            _mm_storeu_si128((__m128i*)dst0, reverse_epi32_sse2(_src));
+
+            src0 += 16;
+            dst0 -= 16;
+        }
+
+        dst0 += 3 * 4;
 #else
         int remain = srcw;
 #endif // __ARM_NEON
@@ -1903,6 +2213,13 @@ static void kanna_rotate_5_c1(const unsigned char* src, int srcw, int srch, int
 
         src0 += srcwgap + 7 * srcstride;
     }
+#elif __SSE2__
+    for (; y + 7 < srch; y += 8)
+    {
+        kanna_rotate_transpose_c1_sse2(src0, srcw, srcstride, dst + y, stride, 0);
+
+        src0 += 8 * srcstride;
+    }
 #endif // __ARM_NEON
     for (; y < srch; y++)
     {
@@ -2144,6 +2461,13 @@ static void kanna_rotate_5_c2(const unsigned char* src, int srcw, int srch, int
 
         src0 += srcwgap + 7 * srcstride;
     }
+#elif __SSE2__
+    for (; y + 7 < srch; y += 8)
+    {
+        kanna_rotate_transpose_c2_sse2(src0, srcw, srcstride, dst + y * 2, stride, 0);
+
+        src0 += 8 * srcstride;
+    }
 #endif // __ARM_NEON
     for (; y < srch; y++)
     {
@@ -2749,6 +3073,13 @@ static void kanna_rotate_5_c4(const unsigned char* src, int srcw, int srch, int
 
         src0 += srcwgap + 7 * srcstride;
     }
+#elif __SSE2__
+    for (; y + 7 < srch; y += 8)
+    {
+        kanna_rotate_transpose_c4_sse2(src0, srcw, srcstride, dst + y * 4, stride, 0);
+
+        src0 += 8 * srcstride;
+    }
 #endif // __ARM_NEON
     for (; y < srch; y++)
     {
@@ -2947,6 +3278,13 @@ static void kanna_rotate_6_c1(const unsigned char* src, int srcw, int srch, int
 
         src0 += srcwgap + 7 * srcstride;
     }
+#elif __SSE2__
+    for (; y + 7 < srch; y += 8)
+    {
+        kanna_rotate_transpose_c1_sse2(src0, srcw, srcstride, dstend - y - 8, stride, 1);
+
+        src0 += 8 * srcstride;
+    }
 #endif // __ARM_NEON
     for (; y < srch; y++)
     {
@@ -3191,6 +3529,13 @@ static void kanna_rotate_6_c2(const unsigned char* src, int srcw, int srch, int
 
         src0 += srcwgap + 7 * srcstride;
     }
+#elif __SSE2__
+    for (; y + 7 < srch; y += 8)
+    {
+        kanna_rotate_transpose_c2_sse2(src0, srcw, srcstride, dstend - y * 2 - 8 * 2, stride, 1);
+
+        src0 += 8 * srcstride;
+    }
 #endif // __ARM_NEON
     for (; y < srch; y++)
     {
@@ -3802,6 +4147,13 @@ static void kanna_rotate_6_c4(const unsigned char* src, int srcw, int srch, int
 
         src0 += srcwgap + 7 * srcstride;
     }
+#elif __SSE2__
+    for (; y + 7 < srch; y += 8)
+    {
+        kanna_rotate_transpose_c4_sse2(src0, srcw, srcstride, dstend - y * 4 - 8 * 4, stride, 1);
+
+        src0 += 8 * srcstride;
+    }
 #endif // __ARM_NEON
     for (; y < srch; y++)
     {
@@ -4000,6 +4352,13 @@ static void kanna_rotate_7_c1(const unsigned char* src, int srcw, int srch, int
 
         src0 += srcwgap + 7 * srcstride;
     }
+#elif __SSE2__
+    for (; y + 7 < srch; y += 8)
+    {
+        kanna_rotate_transpose_c1_sse2(src0, srcw, srcstride, dstend - y - 8, -stride, 1);
+
+        src0 += 8 * srcstride;
+    }
 #endif // __ARM_NEON
     for (; y < srch; y++)
     {
@@ -4244,6 +4603,13 @@ static void kanna_rotate_7_c2(const unsigned char* src, int srcw, int srch, int
 
         src0 += srcwgap + 7 * srcstride;
     }
+#elif __SSE2__
+    for (; y + 7 < srch; y += 8)
+    {
+        kanna_rotate_transpose_c2_sse2(src0, srcw, srcstride, dstend - y * 2 - 8 * 2, -stride, 1);
+
+        src0 += 8 * srcstride;
+    }
 #endif // __ARM_NEON
     for (; y < srch; y++)
     {
@@ -4855,6 +5221,13 @@ static void kanna_rotate_7_c4(const unsigned char* src, int srcw, int srch, int
 
         src0 += srcwgap + 7 * srcstride;
     }
+#elif __SSE2__
+    for (; y + 7 < srch; y += 8)
+    {
+        kanna_rotate_transpose_c4_sse2(src0, srcw, srcstride, dstend - y * 4 - 8 * 4, -stride, 1);
+
+        src0 += 8 * srcstride;
+    }
 #endif // __ARM_NEON
     for (; y < srch; y++)
     {
@@ -5053,6 +5426,13 @@ static void kanna_rotate_8_c1(const unsigned char* src, int srcw, int srch, int
 
         src0 += srcwgap + 7 * srcstride;
     }
+#elif __SSE2__
+    for (; y + 7 < srch; y += 8)
+    {
+        kanna_rotate_transpose_c1_sse2(src0, srcw, srcstride, dstend + y, -stride, 0);
+
+        src0 += 8 * srcstride;
+    }
 #endif // __ARM_NEON
     for (; y < srch; y++)
     {
@@ -5297,6 +5677,13 @@ static void kanna_rotate_8_c2(const unsigned char* src, int srcw, int srch, int
 
         src0 += srcwgap + 7 * srcstride;
     }
+#elif __SSE2__
+    for (; y + 7 < srch; y += 8)
+    {
+        kanna_rotate_transpose_c2_sse2(src0, srcw, srcstride, dstend + y * 2, -stride, 0);
+
+        src0 += 8 * srcstride;
+    }
 #endif // __ARM_NEON
     for (; y < srch; y++)
     {
@@ -5908,6 +6295,13 @@ static void kanna_rotate_8_c4(const unsigned char* src, int srcw, int srch, int
 
         src0 += srcwgap + 7 * srcstride;
     }
+#elif __SSE2__
+    for (; y + 7 < srch; y += 8)
+    {
+        kanna_rotate_transpose_c4_sse2(src0, srcw, srcstride, dstend + y * 4, -stride, 0);
+
+        src0 += 8 * srcstride;
+    }
 #endif // __ARM_NEON
     for (; y < srch; y++)
     {
@@ -0,0 +1,615 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+// pixel row kernels shared by mat_pixel.cpp and its isa optimized variants
+// each one converts a run of n pixels and returns how many it handled,
+// the caller finishes the tail with scalar code
+
+#if NCNN_RUNTIME_CPU && NCNN_AVX512 && __SSE2__ && !__AVX2__
+int unpack_c1_x86_avx512(const unsigned char* src, float* ptr0, int n);
+int unpack_c3_x86_avx512(const unsigned char* src, float* ptr0, float* ptr1, float* ptr2, int n);
+int unpack_c4_x86_avx512(const unsigned char* src, float* ptr0, float* ptr1, float* ptr2, float* ptr3, int n);
+int pack_c1_x86_avx512(const float* ptr0, unsigned char* dst, int n);
+int pack_c3_x86_avx512(const float* ptr0, const float* ptr1, const float* ptr2, unsigned char* dst, int n);
+int pack_c4_x86_avx512(const float* ptr0, const float* ptr1, const float* ptr2, const float* ptr3, unsigned char* dst, int n);
+int yuv420sp2rgb_x86_avx512(const unsigned char* yptr0, const unsigned char* yptr1, const unsigned char* vuptr, unsigned char* rgb0, unsigned char* rgb1, int n, int uv);
+#endif
+
+#if NCNN_RUNTIME_CPU && NCNN_AVX2 && __SSE2__ && !__AVX2__
+int unpack_c1_x86_avx2(const unsigned char* src, float* ptr0, int n);
+int unpack_c3_x86_avx2(const unsigned char* src, float* ptr0, float* ptr1, float* ptr2, int n);
+int unpack_c4_x86_avx2(const unsigned char* src, float* ptr0, float* ptr1, float* ptr2, float* ptr3, int n);
+int pack_c1_x86_avx2(const float* ptr0, unsigned char* dst, int n);
+int pack_c3_x86_avx2(const float* ptr0, const float* ptr1, const float* ptr2, unsigned char* dst, int n);
+int pack_c4_x86_avx2(const float* ptr0, const float* ptr1, const float* ptr2, const float* ptr3, unsigned char* dst, int n);
+int yuv420sp2rgb_x86_avx2(const unsigned char* yptr0, const unsigned char* yptr1, const unsigned char* vuptr, unsigned char* rgb0, unsigned char* rgb1, int n, int uv);
+#endif
+
+// r0 g0 b0 r1 | g1 b1 r2 g2 | b2 r3 g3 b3  ->  r0 r1 r2 r3 | g0 g1 g2 g3 | b0 b1 b2 b3
+static NCNN_FORCEINLINE void deinterleave3_ps(const __m128& _a, const __m128& _b, const __m128& _c, __m128& _r, __m128& _g, __m128& _bb)
+{
+    __m128 _t0 = _mm_shuffle_ps(_b, _c, _MM_SHUFFLE(0, 1, 3, 2));
+    __m128 _t1 = _mm_shuffle_ps(_a, _b, _MM_SHUFFLE(0, 0, 1, 1));
+    __m128 _t2 = _mm_shuffle_ps(_b, _c, _MM_SHUFFLE(2, 2, 3, 3));
+    __m128 _t3 = _mm_shuffle_ps(_a, _b, _MM_SHUFFLE(1, 1, 2, 2));
+    _r = _mm_shuffle_ps(_a, _t0, _MM_SHUFFLE(2, 0, 3, 0));
+    _g = _mm_shuffle_ps(_t1, _t2, _MM_SHUFFLE(2, 0, 2, 0));
+    _bb = _mm_shuffle_ps(_t3, _c, _MM_SHUFFLE(3, 0, 2, 0));
+}
+
+// r0 r1 r2 r3 | g0 g1 g2 g3 | b0 b1 b2 b3  ->  r0 g0 b0 r1 | g1 b1 r2 g2 | b2 r3 g3 b3
+static NCNN_FORCEINLINE void interleave3_ps(const __m128& _r, const __m128& _g, const __m128& _bb, __m128& _a, __m128& _b, __m128& _c)
+{
+    __m128 _t0 = _mm_shuffle_ps(_r, _g, _MM_SHUFFLE(0, 0, 0, 0));
+    __m128 _u0 = _mm_shuffle_ps(_bb, _r, _MM_SHUFFLE(1, 1, 0, 0));
+    __m128 _t1 = _mm_shuffle_ps(_g, _bb, _MM_SHUFFLE(1, 1, 1, 1));
+    __m128 _u1 = _mm_shuffle_ps(_r, _g, _MM_SHUFFLE(2, 2, 2, 2));
+    __m128 _t2 = _mm_shuffle_ps(_bb, _r, _MM_SHUFFLE(3, 3, 2, 2));
+    __m128 _u2 = _mm_shuffle_ps(_g, _bb, _MM_SHUFFLE(3, 3, 3, 3));
+    _a = _mm_shuffle_ps(_t0, _u0, _MM_SHUFFLE(2, 0, 2, 0));
+    _b = _mm_shuffle_ps(_t1, _u1, _MM_SHUFFLE(2, 0, 2, 0));
+    _c = _mm_shuffle_ps(_t2, _u2, _MM_SHUFFLE(2, 0, 2, 0));
+}
+
+// 16 pixels of r g b in 0~255 int32, four per register, stored as 48 interleaved bytes
+static NCNN_FORCEINLINE void store_rgb16_epi32_sse2(const __m128i* _r, const __m128i* _g, const __m128i* _b, unsigned char* dst)
+{
+    __m128i _p[12];
+    for (int q = 0; q < 4; q++)
+    {
+        __m128 _a;
+        __m128 _bb;
+        __m128 _c;
+        interleave3_ps(_mm_castsi128_ps(_r[q]), _mm_castsi128_ps(_g[q]), _mm_castsi128_ps(_b[q]), _a, _bb, _c);
+        _p[q * 3] = _mm_castps_si128(_a);
+        _p[q * 3 + 1] = _mm_castps_si128(_bb);
+        _p[q * 3 + 2] = _mm_castps_si128(_c);
+    }
+
+    for (int q = 0; q < 3; q++)
+    {
+        __m128i _p01 = _mm_packs_epi32(_p[q * 4], _p[q * 4 + 1]);
+        __m128i _p23 = _mm_packs_epi32(_p[q * 4 + 2], _p[q * 4 + 3]);
+        _mm_storeu_si128((__m128i*)(dst + q * 16), _mm_packus_epi16(_p01, _p23));
+    }
+}
+
+static NCNN_FORCEINLINE __m128i float2uint8_epi32_sse2(const float* ptr)
+{
+    __m128 _v = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(ptr), _mm_setzero_ps()), _mm_set1_ps(255.f));
+    return _mm_cvttps_epi32(_v);
+}
+
+#if __AVX2__
+// 8 pixels of rgb packed in the low 3 bytes of int32 <-> 24 interleaved bytes
+static NCNN_FORCEINLINE void store_rgb8_epi32_avx2(const __m256i& _rgb, unsigned char* dst)
+{
+    const __m256i _shuffle = _mm256_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1, 0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+    __m256i _v = _mm256_shuffle_epi8(_rgb, _shuffle);
+    _v = _mm256_permutevar8x32_epi32(_v, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7));
+    _mm256_maskstore_epi32((int*)dst, _mm256_setr_epi32(-1, -1, -1, -1, -1, -1, 0, 0), _v);
+}
+
+static NCNN_FORCEINLINE __m256i load_rgb8_epi32_avx2(const unsigned char* src)
+{
+    const __m256i _shuffle = _mm256_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+    __m256i _v = _mm256_maskload_epi32((const int*)src, _mm256_setr_epi32(-1, -1, -1, -1, -1, -1, 0, 0));
+    _v = _mm256_permutevar8x32_epi32(_v, _mm256_setr_epi32(0, 1, 2, 0, 3, 4, 5, 0));
+    return _mm256_shuffle_epi8(_v, _shuffle);
+}
+
+static NCNN_FORCEINLINE __m256i float2uint8_epi32_avx2(const float* ptr)
+{
+    __m256 _v = _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(ptr), _mm256_setzero_ps()), _mm256_set1_ps(255.f));
+    return _mm256_cvttps_epi32(_v);
+}
+#endif // __AVX2__
+
+#if __AVX512F__
+static NCNN_FORCEINLINE void store_rgb16_epi32_avx512(const __m512i& _rgb, unsigned char* dst)
+{
+    const __m512i _shuffle = _mm512_broadcast_i32x4(_mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1));
+    __m512i _v = _mm512_shuffle_epi8(_rgb, _shuffle);
+    _v = _mm512_permutexvar_epi32(_mm512_setr_epi32(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, 15, 15, 15, 15), _v);
+    _mm512_mask_storeu_epi32(dst, (__mmask16)0x0fff, _v);
+}
+
+static NCNN_FORCEINLINE __m512i load_rgb16_epi32_avx512(const unsigned char* src)
+{
+    const __m512i _shuffle = _mm512_broadcast_i32x4(_mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1));
+    __m512i _v = _mm512_maskz_loadu_epi32((__mmask16)0x0fff, src);
+    _v = _mm512_permutexvar_epi32(_mm512_setr_epi32(0, 1, 2, 0, 3, 4, 5, 0, 6, 7, 8, 0, 9, 10, 11, 0), _v);
+    return _mm512_shuffle_epi8(_v, _shuffle);
+}
+
+static NCNN_FORCEINLINE __m512i float2uint8_epi32_avx512(const float* ptr)
+{
+    __m512 _v = _mm512_min_ps(_mm512_max_ps(_mm512_loadu_ps(ptr), _mm512_setzero_ps()), _mm512_set1_ps(255.f));
+    return _mm512_cvttps_epi32(_v);
+}
+#endif // __AVX512F__
+
+static int unpack_c1_x86(const unsigned char* src, float* ptr0, int n)
+{
+#if NCNN_RUNTIME_CPU && NCNN_AVX512 && __SSE2__ && !__AVX2__
+    if (ncnn::cpu_support_x86_avx512())
+    {
+        return unpack_c1_x86_avx512(src, ptr0, n);
+    }
+#endif
+
+#if NCNN_RUNTIME_CPU && NCNN_AVX2 && __SSE2__ && !__AVX2__
+    if (ncnn::cpu_support_x86_avx2())
+    {
+        return unpack_c1_x86_avx2(src, ptr0, n);
+    }
+#endif
+
+    int i = 0;
+#if __AVX512F__
+    for (; i + 15 < n; i += 16)
+    {
+        __m512i _p = _mm512_cvtepu8_epi32(_mm_loadu_si128((const __m128i*)(src + i)));
+        _mm512_storeu_ps(ptr0 + i, _mm512_cvtepi32_ps(_p));
+    }
+#endif // __AVX512F__
+#if __AVX2__
+    for (; i + 7 < n; i += 8)
+    {
+        __m256i _p = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(src + i)));
+        _mm256_storeu_ps(ptr0 + i, _mm256_cvtepi32_ps(_p));
+    }
+#else
+    const __m128i _zero = _mm_setzero_si128();
+    for (; i + 15 < n; i += 16)
+    {
+        __m128i _p = _mm_loadu_si128((const __m128i*)(src + i));
+        __m128i _pl = _mm_unpacklo_epi8(_p, _zero);
+        __m128i _ph = _mm_unpackhi_epi8(_p, _zero);
+        _mm_storeu_ps(ptr0 + i, _mm_cvtepi32_ps(_mm_unpacklo_epi16(_pl, _zero)));
+        _mm_storeu_ps(ptr0 + i + 4, _mm_cvtepi32_ps(_mm_unpackhi_epi16(_pl, _zero)));
+        _mm_storeu_ps(ptr0 + i + 8, _mm_cvtepi32_ps(_mm_unpacklo_epi16(_ph, _zero)));
+        _mm_storeu_ps(ptr0 + i + 12, _mm_cvtepi32_ps(_mm_unpackhi_epi16(_ph, _zero)));
+    }
+#endif // __AVX2__
+
+    return i;
+}
+
+static int unpack_c3_x86(const unsigned char* src, float* ptr0, float* ptr1, float* ptr2, int n)
+{
+#if NCNN_RUNTIME_CPU && NCNN_AVX512 && __SSE2__ && !__AVX2__
+    if (ncnn::cpu_support_x86_avx512())
+    {
+        return unpack_c3_x86_avx512(src, ptr0, ptr1, ptr2, n);
+    }
+#endif
+
+#if NCNN_RUNTIME_CPU && NCNN_AVX2 && __SSE2__ && !__AVX2__
+    if (ncnn::cpu_support_x86_avx2())
+    {
+        return unpack_c3_x86_avx2(src, ptr0, ptr1, ptr2, n);
+    }
+#endif
+
+    int i = 0;
+#if __AVX512F__
+    const __m512i _mask512 = _mm512_set1_epi32(0xff);
+    for (; i + 15 < n; i += 16)
+    {
+        __m512i _rgb = load_rgb16_epi32_avx512(src + i * 3);
+        _mm512_storeu_ps(ptr0 + i, _mm512_cvtepi32_ps(_mm512_and_si512(_rgb, _mask512)));
+        _mm512_storeu_ps(ptr1 + i, _mm512_cvtepi32_ps(_mm512_and_si512(_mm512_srli_epi32(_rgb, 8), _mask512)));
+        _mm512_storeu_ps(ptr2 + i, _mm512_cvtepi32_ps(_mm512_srli_epi32(_rgb, 16)));
+    }
+#endif // __AVX512F__
+#if __AVX2__
+    const __m256i _mask256 = _mm256_set1_epi32(0xff);
+    for (; i + 7 < n; i += 8)
+    {
+        __m256i _rgb = load_rgb8_epi32_avx2(src + i * 3);
+        _mm256_storeu_ps(ptr0 + i, _mm256_cvtepi32_ps(_mm256_and_si256(_rgb, _mask256)));
+        _mm256_storeu_ps(ptr1 + i, _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(_rgb, 8), _mask256)));
+        _mm256_storeu_ps(ptr2 + i, _mm256_cvtepi32_ps(_mm256_srli_epi32(_rgb, 16)));
+    }
+#else
+    const __m128i _zero = _mm_setzero_si128();
+    for (; i + 15 < n; i += 16)
+    {
+        // widen 48 bytes to 12 float registers in memory order
+        __m128 _p[12];
+        for (int q = 0; q < 3; q++)
+        {
+            __m128i _v = _mm_loadu_si128((const __m128i*)(src + i * 3 + q * 16));
+            __m128i _vl = _mm_unpacklo_epi8(_v, _zero);
+            __m128i _vh = _mm_unpackhi_epi8(_v, _zero);
+            _p[q * 4] = _mm_cvtepi32_ps(_mm_unpacklo_epi16(_vl, _zero));
+            _p[q * 4 + 1] = _mm_cvtepi32_ps(_mm_unpackhi_epi16(_vl, _zero));
+            _p[q * 4 + 2] = _mm_cvtepi32_ps(_mm_unpacklo_epi16(_vh, _zero));
+            _p[q * 4 + 3] = _mm_cvtepi32_ps(_mm_unpackhi_epi16(_vh, _zero));
+        }
+
+        for (int q = 0; q < 4; q++)
+        {
+            __m128 _r;
+            __m128 _g;
+            __m128 _b;
+            deinterleave3_ps(_p[q * 3], _p[q * 3 + 1], _p[q * 3 + 2], _r, _g, _b);
+            _mm_storeu_ps(ptr0 + i + q * 4, _r);
+            _mm_storeu_ps(ptr1 + i + q * 4, _g);
+            _mm_storeu_ps(ptr2 + i + q * 4, _b);
+        }
+    }
+#endif // __AVX2__
+
+    return i;
+}
+
+static int unpack_c4_x86(const unsigned char* src, float* ptr0, float* ptr1, float* ptr2, float* ptr3, int n)
+{
+    // alpha is dropped if ptr3 is null
+#if NCNN_RUNTIME_CPU && NCNN_AVX512 && __SSE2__ && !__AVX2__
+    if (ncnn::cpu_support_x86_avx512())
+    {
+        return unpack_c4_x86_avx512(src, ptr0, ptr1, ptr2, ptr3, n);
+    }
+#endif
+
+#if NCNN_RUNTIME_CPU && NCNN_AVX2 && __SSE2__ && !__AVX2__
+    if (ncnn::cpu_support_x86_avx2())
+    {
+        return unpack_c4_x86_avx2(src, ptr0, ptr1, ptr2, ptr3, n);
+    }
+#endif
+
+    int i = 0;
+#if __AVX512F__
+    const __m512i _mask512 = _mm512_set1_epi32(0xff);
+    for (; i + 15 < n; i += 16)
+    {
+        __m512i _rgba = _mm512_loadu_si512((const __m512i*)(src + i * 4));
+        _mm512_storeu_ps(ptr0 + i, _mm512_cvtepi32_ps(_mm512_and_si512(_rgba, _mask512)));
+        _mm512_storeu_ps(ptr1 + i, _mm512_cvtepi32_ps(_mm512_and_si512(_mm512_srli_epi32(_rgba, 8), _mask512)));
+        _mm512_storeu_ps(ptr2 + i, _mm512_cvtepi32_ps(_mm512_and_si512(_mm512_srli_epi32(_rgba, 16), _mask512)));
+        if (ptr3)
+            _mm512_storeu_ps(ptr3 + i, _mm512_cvtepi32_ps(_mm512_srli_epi32(_rgba, 24)));
+    }
+#endif // __AVX512F__
+#if __AVX2__
+    const __m256i _mask256 = _mm256_set1_epi32(0xff);
+    for (; i + 7 < n; i += 8)
+    {
+        __m256i _rgba = _mm256_loadu_si256((const __m256i*)(src + i * 4));
+        _mm256_storeu_ps(ptr0 + i, _mm256_cvtepi32_ps(_mm256_and_si256(_rgba, _mask256)));
+        _mm256_storeu_ps(ptr1 + i, _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(_rgba, 8), _mask256)));
+        _mm256_storeu_ps(ptr2 + i, _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(_rgba, 16), _mask256)));
+        if (ptr3)
+            _mm256_storeu_ps(ptr3 + i, _mm256_cvtepi32_ps(_mm256_srli_epi32(_rgba, 24)));
+    }
+#endif // __AVX2__
+    const __m128i _mask = _mm_set1_epi32(0xff);
+    for (; i + 3 < n; i += 4)
+    {
+        __m128i _rgba = _mm_loadu_si128((const __m128i*)(src + i * 4));
+        _mm_storeu_ps(ptr0 + i, _mm_cvtepi32_ps(_mm_and_si128(_rgba, _mask)));
+        _mm_storeu_ps(ptr1 + i, _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(_rgba, 8), _mask)));
+        _mm_storeu_ps(ptr2 + i, _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(_rgba, 16), _mask)));
+        if (ptr3)
+            _mm_storeu_ps(ptr3 + i, _mm_cvtepi32_ps(_mm_srli_epi32(_rgba, 24)));
+    }
+
+    return i;
+}
+
+static int pack_c1_x86(const float* ptr0, unsigned char* dst, int n)
+{
+#if NCNN_RUNTIME_CPU && NCNN_AVX512 && __SSE2__ && !__AVX2__
+    if (ncnn::cpu_support_x86_avx512())
+    {
+        return pack_c1_x86_avx512(ptr0, dst, n);
+    }
+#endif
+
+#if NCNN_RUNTIME_CPU && NCNN_AVX2 && __SSE2__ && !__AVX2__
+    if (ncnn::cpu_support_x86_avx2())
+    {
+        return pack_c1_x86_avx2(ptr0, dst, n);
+    }
+#endif
+
+    int i = 0;
+#if __AVX512F__
+    for (; i + 15 < n; i += 16)
+    {
+        _mm_storeu_si128((__m128i*)(dst + i), _mm512_cvtepi32_epi8(float2uint8_epi32_avx512(ptr0 + i)));
+    }
+#endif // __AVX512F__
+    for (; i + 15 < n; i += 16)
+    {
+        __m128i _p01 = _mm_packs_epi32(float2uint8_epi32_sse2(ptr0 + i), float2uint8_epi32_sse2(ptr0 + i + 4));
+        __m128i _p23 = _mm_packs_epi32(float2uint8_epi32_sse2(ptr0 + i + 8), float2uint8_epi32_sse2(ptr0 + i + 12));
+        _mm_storeu_si128((__m128i*)(dst + i), _mm_packus_epi16(_p01, _p23));
+    }
+
+    return i;
+}
+
+static int pack_c3_x86(const float* ptr0, const float* ptr1, const float* ptr2, unsigned char* dst, int n)
+{
+#if NCNN_RUNTIME_CPU && NCNN_AVX512 && __SSE2__ && !__AVX2__
+    if (ncnn::cpu_support_x86_avx512())
+    {
+        return pack_c3_x86_avx512(ptr0, ptr1, ptr2, dst, n);
+    }
+#endif
+
+#if NCNN_RUNTIME_CPU && NCNN_AVX2 && __SSE2__ && !__AVX2__
+    if (ncnn::cpu_support_x86_avx2())
+    {
+        return pack_c3_x86_avx2(ptr0, ptr1, ptr2, dst, n);
+    }
+#endif
+
+    int i = 0;
+#if __AVX512F__
+    for (; i + 15 < n; i += 16)
+    {
+        __m512i _r = float2uint8_epi32_avx512(ptr0 + i);
+        __m512i _g = float2uint8_epi32_avx512(ptr1 + i);
+        __m512i _b = float2uint8_epi32_avx512(ptr2 + i);
+        __m512i _rgb = _mm512_or_si512(_mm512_or_si512(_r, _mm512_slli_epi32(_g, 8)), _mm512_slli_epi32(_b, 16));
+        store_rgb16_epi32_avx512(_rgb, dst + i * 3);
+    }
+#endif // __AVX512F__
+#if __AVX2__
+    for (; i + 7 < n; i += 8)
+    {
+        __m256i _r = float2uint8_epi32_avx2(ptr0 + i);
+        __m256i _g = float2uint8_epi32_avx2(ptr1 + i);
+        __m256i _b = float2uint8_epi32_avx2(ptr2 + i);
+        __m256i _rgb = _mm256_or_si256(_mm256_or_si256(_r, _mm256_slli_epi32(_g, 8)), _mm256_slli_epi32(_b, 16));
+        store_rgb8_epi32_avx2(_rgb, dst + i * 3);
+    }
+#else
+    for (; i + 15 < n; i += 16)
+    {
+        __m128i _r[4];
+        __m128i _g[4];
+        __m128i _b[4];
+        for (int q = 0; q < 4; q++)
+        {
+            _r[q] = float2uint8_epi32_sse2(ptr0 + i + q * 4);
+            _g[q] = float2uint8_epi32_sse2(ptr1 + i + q * 4);
+            _b[q] = float2uint8_epi32_sse2(ptr2 + i + q * 4);
+        }
+
+        store_rgb16_epi32_sse2(_r, _g, _b, dst + i * 3);
+    }
+#endif // __AVX2__
+
+    return i;
+}
+
+static int pack_c4_x86(const float* ptr0, const float* ptr1, const float* ptr2, const float* ptr3, unsigned char* dst, int n)
+{
+    // alpha is 255 if ptr3 is null
+#if NCNN_RUNTIME_CPU && NCNN_AVX512 && __SSE2__ && !__AVX2__
+    if (ncnn::cpu_support_x86_avx512())
+    {
+        return pack_c4_x86_avx512(ptr0, ptr1, ptr2, ptr3, dst, n);
+    }
+#endif
+
+#if NCNN_RUNTIME_CPU && NCNN_AVX2 && __SSE2__ && !__AVX2__
+    if (ncnn::cpu_support_x86_avx2())
+    {
+        return pack_c4_x86_avx2(ptr0, ptr1, ptr2, ptr3, dst, n);
+    }
+#endif
+
+    int i = 0;
+#if __AVX512F__
+    for (; i + 15 < n; i += 16)
+    {
+        __m512i _r = float2uint8_epi32_avx512(ptr0 + i);
+        __m512i _g = float2uint8_epi32_avx512(ptr1 + i);
+        __m512i _b = float2uint8_epi32_avx512(ptr2 + i);
+        __m512i _a = ptr3 ? float2uint8_epi32_avx512(ptr3 + i) : _mm512_set1_epi32(255);
+        __m512i _rgba = _mm512_or_si512(_mm512_or_si512(_r, _mm512_slli_epi32(_g, 8)), _mm512_or_si512(_mm512_slli_epi32(_b, 16), _mm512_slli_epi32(_a, 24)));
+        _mm512_storeu_si512((__m512i*)(dst + i * 4), _rgba);
+    }
+#endif // __AVX512F__
+#if __AVX2__
+    for (; i + 7 < n; i += 8)
+    {
+        __m256i _r = float2uint8_epi32_avx2(ptr0 + i);
+        __m256i _g = float2uint8_epi32_avx2(ptr1 + i);
+        __m256i _b = float2uint8_epi32_avx2(ptr2 + i);
+        __m256i _a = ptr3 ? float2uint8_epi32_avx2(ptr3 + i) : _mm256_set1_epi32(255);
+        __m256i _rgba = _mm256_or_si256(_mm256_or_si256(_r, _mm256_slli_epi32(_g, 8)), _mm256_or_si256(_mm256_slli_epi32(_b, 16), _mm256_slli_epi32(_a, 24)));
+        _mm256_storeu_si256((__m256i*)(dst + i * 4), _rgba);
+    }
+#endif // __AVX2__
+    for (; i + 3 < n; i += 4)
+    {
+        __m128i _r = float2uint8_epi32_sse2(ptr0 + i);
+        __m128i _g = float2uint8_epi32_sse2(ptr1 + i);
+        __m128i _b = float2uint8_epi32_sse2(ptr2 + i);
+        __m128i _a = ptr3 ? float2uint8_epi32_sse2(ptr3 + i) : _mm_set1_epi32(255);
+        __m128i _rgba = _mm_or_si128(_mm_or_si128(_r, _mm_slli_epi32(_g, 8)), _mm_or_si128(_mm_slli_epi32(_b, 16), _mm_slli_epi32(_a, 24)));
+        _mm_storeu_si128((__m128i*)(dst + i * 4), _rgba);
+    }
+
+    return i;
+}
+
+static int yuv420sp2rgb_x86(const unsigned char* yptr0, const unsigned char* yptr1, const unsigned char* vuptr, unsigned char* rgb0, unsigned char* rgb1, int n, int uv)
+{
+    // two rows sharing one vu row, uv = 1 for nv12
+    // same fixed point math as the scalar path
+    // R = (yy + 90 * vv) >> 6
+    // G = (yy - 46 * vv - 22 * uu) >> 6
+    // B = (yy + 113 * uu) >> 6
+#if NCNN_RUNTIME_CPU && NCNN_AVX512 && __SSE2__ && !__AVX2__
+    if (ncnn::cpu_support_x86_avx512())
+    {
+        return yuv420sp2rgb_x86_avx512(yptr0, yptr1, vuptr, rgb0, rgb1, n, uv);
+    }
+#endif
+
+#if NCNN_RUNTIME_CPU && NCNN_AVX2 && __SSE2__ && !__AVX2__
+    if (ncnn::cpu_support_x86_avx2())
+    {
+        return yuv420sp2rgb_x86_avx2(yptr0, yptr1, vuptr, rgb0, rgb1, n, uv);
+    }
+#endif
+
+    const __m128i _vshift = _mm_cvtsi32_si128(uv ? 8 : 0);
+    const __m128i _ushift = _mm_cvtsi32_si128(uv ? 0 : 8);
+
+    int i = 0;
+#if __AVX512F__
+    {
+        const __m512i _v128 = _mm512_set1_epi32(128);
+        const __m512i _vff = _mm512_set1_epi32(0xff);
+        const __m512i _v255 = _mm512_set1_epi32(255);
+        const __m512i _zero = _mm512_setzero_si512();
+        for (; i + 15 < n; i += 16)
+        {
+            __m128i _vu8 = _mm_loadu_si128((const __m128i*)(vuptr + i));
+            __m256i _vu16 = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_unpacklo_epi16(_vu8, _vu8)), _mm_unpackhi_epi16(_vu8, _vu8), 1);
+            __m512i _vu = _mm512_cvtepu16_epi32(_vu16);
+
+            __m512i _vv = _mm512_sub_epi32(_mm512_and_si512(_mm512_srl_epi32(_vu, _vshift), _vff), _v128);
+            __m512i _uu = _mm512_sub_epi32(_mm512_and_si512(_mm512_srl_epi32(_vu, _ushift), _vff), _v128);
+
+            __m512i _ruv = _mm512_mullo_epi32(_vv, _mm512_set1_epi32(90));
+            __m512i _guv = _mm512_add_epi32(_mm512_mullo_epi32(_vv, _mm512_set1_epi32(-46)), _mm512_mullo_epi32(_uu, _mm512_set1_epi32(-22)));
+            __m512i _buv = _mm512_mullo_epi32(_uu, _mm512_set1_epi32(113));
+
+            for (int k = 0; k < 2; k++)
+            {
+                const unsigned char* yptr = k == 0 ? yptr0 : yptr1;
+                unsigned char* rgb = k == 0 ? rgb0 : rgb1;
+
+                __m512i _yy = _mm512_slli_epi32(_mm512_cvtepu8_epi32(_mm_loadu_si128((const __m128i*)(yptr + i))), 6);
+
+                __m512i _r = _mm512_min_epi32(_mm512_max_epi32(_mm512_srai_epi32(_mm512_add_epi32(_yy, _ruv), 6), _zero), _v255);
+                __m512i _g = _mm512_min_epi32(_mm512_max_epi32(_mm512_srai_epi32(_mm512_add_epi32(_yy, _guv), 6), _zero), _v255);
+                __m512i _b = _mm512_min_epi32(_mm512_max_epi32(_mm512_srai_epi32(_mm512_add_epi32(_yy, _buv), 6), _zero), _v255);
+
+                __m512i _rgb = _mm512_or_si512(_mm512_or_si512(_r, _mm512_slli_epi32(_g, 8)), _mm512_slli_epi32(_b, 16));
+                store_rgb16_epi32_avx512(_rgb, rgb + i * 3);
+            }
+        }
+    }
+#endif // __AVX512F__
+#if __AVX2__
+    {
+        const __m256i _v128 = _mm256_set1_epi32(128);
+        const __m256i _vff = _mm256_set1_epi32(0xff);
+        const __m256i _v255 = _mm256_set1_epi32(255);
+        const __m256i _zero = _mm256_setzero_si256();
+        for (; i + 7 < n; i += 8)
+        {
+            __m128i _vu8 = _mm_loadl_epi64((const __m128i*)(vuptr + i));
+            __m256i _vu = _mm256_cvtepu16_epi32(_mm_unpacklo_epi16(_vu8, _vu8));
+
+            __m256i _vv = _mm256_sub_epi32(_mm256_and_si256(_mm256_srl_epi32(_vu, _vshift), _vff), _v128);
+            __m256i _uu = _mm256_sub_epi32(_mm256_and_si256(_mm256_srl_epi32(_vu, _ushift), _vff), _v128);
+
+            __m256i _ruv = _mm256_mullo_epi32(_vv, _mm256_set1_epi32(90));
+            __m256i _guv = _mm256_add_epi32(_mm256_mullo_epi32(_vv, _mm256_set1_epi32(-46)), _mm256_mullo_epi32(_uu, _mm256_set1_epi32(-22)));
+            __m256i _buv = _mm256_mullo_epi32(_uu, _mm256_set1_epi32(113));
+
+            for (int k = 0; k < 2; k++)
+            {
+                const unsigned char* yptr = k == 0 ? yptr0 : yptr1;
+                unsigned char* rgb = k == 0 ? rgb0 : rgb1;
+
+                __m256i _yy = _mm256_slli_epi32(_mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(yptr + i))), 6);
+
+                __m256i _r = _mm256_min_epi32(_mm256_max_epi32(_mm256_srai_epi32(_mm256_add_epi32(_yy, _ruv), 6), _zero), _v255);
+                __m256i _g = _mm256_min_epi32(_mm256_max_epi32(_mm256_srai_epi32(_mm256_add_epi32(_yy, _guv), 6), _zero), _v255);
+                __m256i _b = _mm256_min_epi32(_mm256_max_epi32(_mm256_srai_epi32(_mm256_add_epi32(_yy, _buv), 6), _zero), _v255);
+
+                __m256i _rgb = _mm256_or_si256(_mm256_or_si256(_r, _mm256_slli_epi32(_g, 8)), _mm256_slli_epi32(_b, 16));
+                store_rgb8_epi32_avx2(_rgb, rgb + i * 3);
+            }
+        }
+    }
+#else
+    {
+        // int16 is enough for the fixed point math
+        const __m128i _v128 = _mm_set1_epi16(128);
+        const __m128i _vff = _mm_set1_epi16(0xff);
+        const __m128i _v255 = _mm_set1_epi16(255);
+        const __m128i _zero = _mm_setzero_si128();
+        for (; i + 15 < n; i += 16)
+        {
+            __m128i _vu = _mm_loadu_si128((const __m128i*)(vuptr + i));
+
+            __m128i _vv = _mm_sub_epi16(_mm_and_si128(_mm_srl_epi16(_vu, _vshift), _vff), _v128);
+            __m128i _uu = _mm_sub_epi16(_mm_and_si128(_mm_srl_epi16(_vu, _ushift), _vff), _v128);
+
+            // one vu pair for two pixels
+            __m128i _vvl = _mm_unpacklo_epi16(_vv, _vv);
+            __m128i _vvh = _mm_unpackhi_epi16(_vv, _vv);
+            __m128i _uul = _mm_unpacklo_epi16(_uu, _uu);
+            __m128i _uuh = _mm_unpackhi_epi16(_uu, _uu);
+
+            __m128i _ruv[2];
+            __m128i _guv[2];
+            __m128i _buv[2];
+            _ruv[0] = _mm_mullo_epi16(_vvl, _mm_set1_epi16(90));
+            _ruv[1] = _mm_mullo_epi16(_vvh, _mm_set1_epi16(90));
+            _guv[0] = _mm_add_epi16(_mm_mullo_epi16(_vvl, _mm_set1_epi16(-46)), _mm_mullo_epi16(_uul, _mm_set1_epi16(-22)));
+            _guv[1] = _mm_add_epi16(_mm_mullo_epi16(_vvh, _mm_set1_epi16(-46)), _mm_mullo_epi16(_uuh, _mm_set1_epi16(-22)));
+            _buv[0] = _mm_mullo_epi16(_uul, _mm_set1_epi16(113));
+            _buv[1] = _mm_mullo_epi16(_uuh, _mm_set1_epi16(113));
+
+            for (int k = 0; k < 2; k++)
+            {
+                const unsigned char* yptr = k == 0 ? yptr0 : yptr1;
+                unsigned char* rgb = k == 0 ? rgb0 : rgb1;
+
+                __m128i _y8 = _mm_loadu_si128((const __m128i*)(yptr + i));
+
+                __m128i _r[4];
+                __m128i _g[4];
+                __m128i _b[4];
+                for (int q = 0; q < 2; q++)
+                {
+                    __m128i _yy = _mm_slli_epi16(q == 0 ? _mm_unpacklo_epi8(_y8, _zero) : _mm_unpackhi_epi8(_y8, _zero), 6);
+
+                    __m128i _r16 = _mm_min_epi16(_mm_max_epi16(_mm_srai_epi16(_mm_add_epi16(_yy, _ruv[q]), 6), _zero), _v255);
+                    __m128i _g16 = _mm_min_epi16(_mm_max_epi16(_mm_srai_epi16(_mm_add_epi16(_yy, _guv[q]), 6), _zero), _v255);
+                    __m128i _b16 = _mm_min_epi16(_mm_max_epi16(_mm_srai_epi16(_mm_add_epi16(_yy, _buv[q]), 6), _zero), _v255);
+
+                    _r[q * 2] = _mm_unpacklo_epi16(_r16, _zero);
+                    _r[q * 2 + 1] = _mm_unpackhi_epi16(_r16, _zero);
+                    _g[q * 2] = _mm_unpacklo_epi16(_g16, _zero);
+                    _g[q * 2 + 1] = _mm_unpackhi_epi16(_g16, _zero);
+                    _b[q * 2] = _mm_unpacklo_epi16(_b16, _zero);
+                    _b[q * 2 + 1] = _mm_unpackhi_epi16(_b16, _zero);
+                }
+
+                store_rgb16_epi32_sse2(_r, _g, _b, rgb + i * 3);
+            }
+        }
+    }
+#endif // __AVX2__
+
+    return i;
+}
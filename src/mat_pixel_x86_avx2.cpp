@@ -0,0 +1,62 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "cpu.h"
+#include "mat.h"
+
+#include <emmintrin.h>
+#include <immintrin.h>
+
+namespace ncnn {
+
+#if NCNN_PIXEL
+#include "mat_pixel_x86.h"
+
+int unpack_c1_x86_avx2(const unsigned char* src, float* ptr0, int n)
+{
+    return unpack_c1_x86(src, ptr0, n);
+}
+
+int unpack_c3_x86_avx2(const unsigned char* src, float* ptr0, float* ptr1, float* ptr2, int n)
+{
+    return unpack_c3_x86(src, ptr0, ptr1, ptr2, n);
+}
+
+int unpack_c4_x86_avx2(const unsigned char* src, float* ptr0, float* ptr1, float* ptr2, float* ptr3, int n)
+{
+    return unpack_c4_x86(src, ptr0, ptr1, ptr2, ptr3, n);
+}
+
+int pack_c1_x86_avx2(const float* ptr0, unsigned char* dst, int n)
+{
+    return pack_c1_x86(ptr0, dst, n);
+}
+
+int pack_c3_x86_avx2(const float* ptr0, const float* ptr1, const float* ptr2, unsigned char* dst, int n)
+{
+    return pack_c3_x86(ptr0, ptr1, ptr2, dst, n);
+}
+
+int pack_c4_x86_avx2(const float* ptr0, const float* ptr1, const float* ptr2, const float* ptr3, unsigned char* dst, int n)
+{
+    return pack_c4_x86(ptr0, ptr1, ptr2, ptr3, dst, n);
+}
+
+int yuv420sp2rgb_x86_avx2(const unsigned char* yptr0, const unsigned char* yptr1, const unsigned char* vuptr, unsigned char* rgb0, unsigned char* rgb1, int n, int uv)
+{
+    return yuv420sp2rgb_x86(yptr0, yptr1, vuptr, rgb0, rgb1, n, uv);
+}
+#endif // NCNN_PIXEL
+
+} // namespace ncnn
@@ -19,6 +19,7 @@
 #include "layer_type.h"
 #include "modelbin.h"
 #include "paramdict.h"
+#include "profiler.h"
 
 #include <stdarg.h>
 #include <stdint.h>
@@ -35,6 +36,11 @@
 
 namespace ncnn {
 
+#if NCNN_THREADS
+class ParallelGraphWorkerPool;
+class AsyncExtractWorkerPool;
+#endif // NCNN_THREADS
+
 class NetPrivate
 {
 public:
@@ -51,6 +57,14 @@ public:
     friend class Extractor;
     int forward_layer(int layer_index, std::vector<Mat>& blob_mats, const Option& opt) const;
 
+    // forward this layer only, all bottom blobs must be ready
+    int forward_layer_nonrecursive(int layer_index, std::vector<Mat>& blob_mats, const Option& opt) const;
+
+#if NCNN_THREADS
+    // dispatch the dependency graph of layer_index onto graph_worker_pool
+    int forward_layer_parallel(int layer_index, std::vector<Mat>& blob_mats, const Option& opt) const;
+#endif // NCNN_THREADS
+
 #if NCNN_VULKAN
     int forward_layer(int layer_index, std::vector<Mat>& blob_mats, std::vector<VkMat>& blob_mats_gpu, VkCompute& cmd, const Option& opt) const;
     int forward_layer(int layer_index, std::vector<Mat>& blob_mats, std::vector<VkMat>& blob_mats_gpu, std::vector<VkImageMat>& blob_mats_gpu_image, VkCompute& cmd, const Option& opt) const;
@@ -59,6 +73,10 @@ public:
     int convert_layout(Mat& bottom_blob, const Layer* layer, const Option& opt) const;
 
     int do_forward_layer(const Layer* layer, std::vector<Mat>& blob_mats, const Option& opt) const;
+
+    // batch_blob_mats holds one blob_mats for each sample
+    int forward_layer_batch(int layer_index, std::vector<std::vector<Mat> >& batch_blob_mats, const Option& opt) const;
+    int do_forward_layer_batch(const Layer* layer, std::vector<std::vector<Mat> >& batch_blob_mats, const Option& opt) const;
 #if NCNN_VULKAN
     int do_forward_layer(const Layer* layer, std::vector<VkMat>& blob_mats_gpu, VkCompute& cmd, const Option& opt) const;
     int do_forward_layer(const Layer* layer, std::vector<VkImageMat>& blob_mats_gpu_image, VkCompute& cmd, const Option& opt) const;
@@ -69,6 +87,13 @@ public:
     void update_input_output_names();
 #endif // NCNN_STRING
 
+    // the max number of layers that could run concurrently
+    // estimated as the widest level of the topological order
+    void update_graph_max_width();
+
+    MemoryPlanAllocator* acquire_memory_plan_allocator() const;
+    void reclaim_memory_plan_allocator(MemoryPlanAllocator* allocator) const;
+
     std::vector<Blob> blobs;
     std::vector<Layer*> layers;
 
@@ -85,6 +110,25 @@ public:
     PoolAllocator* local_blob_allocator;
     PoolAllocator* local_workspace_allocator;
 
+#if NCNN_STDIO
+    // weight data references this mapping
+    DataReaderFromMmap* model_mmap_reader;
+#endif // NCNN_STDIO
+
+    int graph_max_width;
+#if NCNN_THREADS
+    ParallelGraphWorkerPool* graph_worker_pool;
+
+    // created on the first extract_async
+    Mutex async_worker_pool_lock;
+    AsyncExtractWorkerPool* async_worker_pool;
+#endif // NCNN_THREADS
+
+    // one memory plan for each extractor running concurrently
+    mutable Mutex memory_plan_allocators_lock;
+    mutable std::vector<MemoryPlanAllocator*> memory_plan_allocators;
+    mutable std::vector<MemoryPlanAllocator*> idle_memory_plan_allocators;
+
 #if NCNN_VULKAN
     const VulkanDevice* vkdev;
 
@@ -101,6 +145,16 @@ NetPrivate::NetPrivate(Option& _opt)
     local_blob_allocator = 0;
     local_workspace_allocator = 0;
 
+#if NCNN_STDIO
+    model_mmap_reader = 0;
+#endif // NCNN_STDIO
+
+    graph_max_width = 1;
+#if NCNN_THREADS
+    graph_worker_pool = 0;
+    async_worker_pool = 0;
+#endif // NCNN_THREADS
+
 #if NCNN_VULKAN
     vkdev = 0;
     weight_vkallocator = 0;
@@ -132,6 +186,31 @@ static Option get_masked_option(const Option& opt, int featmask)
     return opt1;
 }
 
+// bind the calling thread to a numa node for the scope, -1 for no binding
+class CpuThreadNumaNodeGuard
+{
+public:
+    CpuThreadNumaNodeGuard(int numa_node)
+        : old_numa_node(-1), bound(numa_node >= 0)
+    {
+        if (bound)
+        {
+            old_numa_node = get_cpu_thread_numa_node();
+            set_cpu_thread_numa_node(numa_node);
+        }
+    }
+
+    ~CpuThreadNumaNodeGuard()
+    {
+        if (bound)
+            set_cpu_thread_numa_node(old_numa_node);
+    }
+
+private:
+    int old_numa_node;
+    bool bound;
+};
+
 #if NCNN_VULKAN
 int NetPrivate::upload_model()
 {
@@ -190,6 +269,13 @@ int NetPrivate::forward_layer(int layer_index, std::vector<Mat>& blob_mats, cons
         }
     }
 
+    return forward_layer_nonrecursive(layer_index, blob_mats, opt);
+}
+
+int NetPrivate::forward_layer_nonrecursive(int layer_index, std::vector<Mat>& blob_mats, const Option& opt) const
+{
+    const Layer* layer = layers[layer_index];
+
 #if NCNN_BENCHMARK
     double start = get_current_time();
     Mat bottom_blob;
@@ -205,6 +291,7 @@ int NetPrivate::forward_layer(int layer_index, std::vector<Mat>& blob_mats, cons
         bottom_blob.elemsize = blob_mats[bottom_blob_index].elemsize;
     }
 #endif
+    ProfilerRecord* record = opt.profiler ? opt.profiler->begin_layer(layer, layer_index, blob_mats) : 0;
     int ret = 0;
     if (layer->featmask)
     {
@@ -214,6 +301,8 @@ int NetPrivate::forward_layer(int layer_index, std::vector<Mat>& blob_mats, cons
     {
         ret = do_forward_layer(layer, blob_mats, opt);
     }
+    if (record)
+        opt.profiler->end_layer(record, layer, blob_mats);
 #if NCNN_BENCHMARK
     double end = get_current_time();
     if (layer->one_blob_only)
@@ -236,6 +325,437 @@ int NetPrivate::forward_layer(int layer_index, std::vector<Mat>& blob_mats, cons
     return 0;
 }
 
+#if NCNN_THREADS
+class ParallelGraphTask
+{
+public:
+    ParallelGraphTask(const NetPrivate* _net, std::vector<Mat>& _blob_mats, const Option& _opt)
+        : net(_net), blob_mats(_blob_mats), opt(_opt)
+    {
+        remaining_count = 0;
+        running_count = 0;
+        max_concurrency = 1;
+        ret = 0;
+        participant_count = 0;
+    }
+
+    // execute ready layers until the task is finished or failed
+    void run();
+
+public:
+    const NetPrivate* net;
+    std::vector<Mat>& blob_mats;
+    Option opt;
+
+    // -1 = layer not required by this task
+    // otherwise the count of bottom blobs not produced yet
+    std::vector<int> pending_bottom_count;
+    std::vector<int> ready_layer_indexes;
+
+    int remaining_count;
+    int running_count;
+    int max_concurrency;
+    int ret;
+
+    Mutex lock;
+    ConditionVariable cond;
+
+    // guarded by worker pool lock
+    int participant_count;
+};
+
+void ParallelGraphTask::run()
+{
+    lock.lock();
+    for (;;)
+    {
+        while (ready_layer_indexes.empty() && running_count > 0 && remaining_count > 0 && ret == 0)
+        {
+            cond.wait(lock);
+        }
+
+        if (remaining_count == 0 || ret != 0)
+            break;
+
+        if (ready_layer_indexes.empty())
+        {
+            // nothing running and nothing ready, the graph is broken
+            NCNN_LOGE("parallel graph stalled with %d layers remaining", remaining_count);
+            ret = -1;
+            cond.broadcast();
+            break;
+        }
+
+        const int layer_index = ready_layer_indexes[ready_layer_indexes.size() - 1];
+        ready_layer_indexes.resize(ready_layer_indexes.size() - 1);
+
+        running_count++;
+
+        // partition threads between the running layers and the ready ones
+        const int concurrency = std::min(running_count + (int)ready_layer_indexes.size(), max_concurrency);
+        Option opt1 = opt;
+        opt1.num_threads = std::max(opt.num_threads / concurrency, 1);
+
+        lock.unlock();
+
+        int lret = net->forward_layer_nonrecursive(layer_index, blob_mats, opt1);
+
+        lock.lock();
+
+        running_count--;
+        remaining_count--;
+
+        if (lret != 0)
+        {
+            ret = lret;
+        }
+        else
+        {
+            // wake up the consumers
+            const Layer* layer = net->layers[layer_index];
+            for (size_t i = 0; i < layer->tops.size(); i++)
+            {
+                int consumer = net->blobs[layer->tops[i]].consumer;
+                if (consumer == -1 || pending_bottom_count[consumer] <= 0)
+                    continue;
+
+                pending_bottom_count[consumer]--;
+                if (pending_bottom_count[consumer] == 0)
+                {
+                    ready_layer_indexes.push_back(consumer);
+                }
+            }
+        }
+
+        cond.broadcast();
+    }
+    lock.unlock();
+}
+
+class ParallelGraphWorkerPool
+{
+public:
+    ParallelGraphWorkerPool(int worker_count);
+    ~ParallelGraphWorkerPool();
+
+    int worker_count() const
+    {
+        return (int)workers.size();
+    }
+
+    // let at most count workers join the task
+    void submit(ParallelGraphTask* task, int count);
+
+    // revoke the pending submissions and wait for all joined workers to leave
+    void wait(ParallelGraphTask* task);
+
+private:
+    static void* worker_main(void* args);
+
+    Mutex lock;
+    ConditionVariable task_cond;
+    ConditionVariable finish_cond;
+    std::vector<ParallelGraphTask*> task_queue;
+    std::vector<Thread*> workers;
+    bool quit;
+};
+
+ParallelGraphWorkerPool::ParallelGraphWorkerPool(int worker_count)
+{
+    quit = false;
+
+    workers.resize(worker_count);
+    for (int i = 0; i < worker_count; i++)
+    {
+        workers[i] = new Thread(worker_main, (void*)this);
+    }
+}
+
+ParallelGraphWorkerPool::~ParallelGraphWorkerPool()
+{
+    lock.lock();
+    quit = true;
+    task_cond.broadcast();
+    lock.unlock();
+
+    for (size_t i = 0; i < workers.size(); i++)
+    {
+        workers[i]->join();
+        delete workers[i];
+    }
+}
+
+void ParallelGraphWorkerPool::submit(ParallelGraphTask* task, int count)
+{
+    if (count <= 0)
+        return;
+
+    lock.lock();
+    for (int i = 0; i < count; i++)
+    {
+        task_queue.push_back(task);
+    }
+    task_cond.broadcast();
+    lock.unlock();
+}
+
+void ParallelGraphWorkerPool::wait(ParallelGraphTask* task)
+{
+    lock.lock();
+    for (size_t i = 0; i < task_queue.size();)
+    {
+        if (task_queue[i] == task)
+        {
+            task_queue.erase(task_queue.begin() + i);
+            continue;
+        }
+        i++;
+    }
+    while (task->participant_count > 0)
+    {
+        finish_cond.wait(lock);
+    }
+    lock.unlock();
+}
+
+void* ParallelGraphWorkerPool::worker_main(void* args)
+{
+    ParallelGraphWorkerPool* pool = (ParallelGraphWorkerPool*)args;
+
+    pool->lock.lock();
+    for (;;)
+    {
+        while (pool->task_queue.empty() && !pool->quit)
+        {
+            pool->task_cond.wait(pool->lock);
+        }
+
+        if (pool->quit)
+            break;
+
+        ParallelGraphTask* task = pool->task_queue[0];
+        pool->task_queue.erase(pool->task_queue.begin());
+        task->participant_count++;
+
+        pool->lock.unlock();
+
+        // these are thread specific
+        set_kmp_blocktime(task->opt.openmp_blocktime);
+        set_flush_denormals(task->opt.flush_denormals);
+        if (task->opt.numa_node >= 0)
+            set_cpu_thread_numa_node(task->opt.numa_node);
+
+        task->run();
+
+        pool->lock.lock();
+
+        task->participant_count--;
+        pool->finish_cond.broadcast();
+    }
+    pool->lock.unlock();
+
+    return 0;
+}
+
+struct AsyncExtractTask
+{
+    Extractor* ex;
+    int blob_index;
+    int type;
+    extract_callback_func callback;
+    void* userdata;
+};
+
+// runs the extract_async requests of one net in submission order
+class AsyncExtractWorkerPool
+{
+public:
+    AsyncExtractWorkerPool(int worker_count);
+
+    // finish all queued requests, then stop the workers
+    ~AsyncExtractWorkerPool();
+
+    void submit(const AsyncExtractTask& task);
+
+private:
+    struct WorkerContext
+    {
+        AsyncExtractWorkerPool* pool;
+        int index;
+    };
+
+    static void* worker_main(void* args);
+
+    Mutex lock;
+    ConditionVariable task_cond;
+    std::vector<AsyncExtractTask> task_queue;
+    std::vector<WorkerContext> worker_contexts;
+    std::vector<Thread*> workers;
+    bool quit;
+};
+
+// the context of the current worker thread, cleared when a callback destroys its pool
+static ThreadLocalStorage tls_async_worker_context;
+
+AsyncExtractWorkerPool::AsyncExtractWorkerPool(int worker_count)
+{
+    quit = false;
+
+    worker_contexts.resize(worker_count);
+    workers.resize(worker_count);
+    for (int i = 0; i < worker_count; i++)
+    {
+        worker_contexts[i].pool = this;
+        worker_contexts[i].index = i;
+        workers[i] = new Thread(worker_main, (void*)&worker_contexts[i]);
+    }
+}
+
+AsyncExtractWorkerPool::~AsyncExtractWorkerPool()
+{
+    lock.lock();
+    quit = true;
+    task_cond.broadcast();
+    lock.unlock();
+
+    // a callback releasing the last reference of the net ends up here on a worker thread
+    // that worker could not join itself, it is detached and leaves once the callback returns
+    int self_index = -1;
+    const WorkerContext* ctx = (const WorkerContext*)tls_async_worker_context.get();
+    if (ctx && ctx->pool == this)
+    {
+        self_index = ctx->index;
+        tls_async_worker_context.set(0);
+    }
+
+    for (size_t i = 0; i < workers.size(); i++)
+    {
+        if ((int)i == self_index)
+            workers[i]->detach();
+        else
+            workers[i]->join();
+        delete workers[i];
+    }
+
+    // the other workers are gone, finish what is left here
+    while (!task_queue.empty())
+    {
+        AsyncExtractTask task = task_queue[0];
+        task_queue.erase(task_queue.begin());
+
+        Mat feat;
+        int ret = task.ex->extract(task.blob_index, feat, task.type);
+        task.callback(ret, feat, task.userdata);
+    }
+}
+
+void AsyncExtractWorkerPool::submit(const AsyncExtractTask& task)
+{
+    lock.lock();
+    task_queue.push_back(task);
+    task_cond.signal();
+    lock.unlock();
+}
+
+void* AsyncExtractWorkerPool::worker_main(void* args)
+{
+    WorkerContext* ctx = (WorkerContext*)args;
+    AsyncExtractWorkerPool* pool = ctx->pool;
+
+    tls_async_worker_context.set((void*)ctx);
+
+    pool->lock.lock();
+    for (;;)
+    {
+        while (pool->task_queue.empty() && !pool->quit)
+        {
+            pool->task_cond.wait(pool->lock);
+        }
+
+        // drain the queue before quit
+        if (pool->task_queue.empty())
+            break;
+
+        AsyncExtractTask task = pool->task_queue[0];
+        pool->task_queue.erase(pool->task_queue.begin());
+
+        pool->lock.unlock();
+
+        Mat feat;
+        int ret = task.ex->extract(task.blob_index, feat, task.type);
+
+        // the extractor belongs to the caller again, the callback may destroy it
+        task.callback(ret, feat, task.userdata);
+
+        if (tls_async_worker_context.get() != (void*)ctx)
+        {
+            // the pool is gone
+            return 0;
+        }
+
+        pool->lock.lock();
+    }
+    pool->lock.unlock();
+
+    return 0;
+}
+
+int NetPrivate::forward_layer_parallel(int layer_index, std::vector<Mat>& blob_mats, const Option& opt) const
+{
+    ParallelGraphTask task(this, blob_mats, opt);
+
+    // collect the layers required to produce layer_index
+    task.pending_bottom_count.resize(layers.size(), -1);
+    task.pending_bottom_count[layer_index] = 0;
+
+    std::vector<int> layer_stack(1, layer_index);
+    while (!layer_stack.empty())
+    {
+        const int i = layer_stack[layer_stack.size() - 1];
+        layer_stack.resize(layer_stack.size() - 1);
+
+        const Layer* layer = layers[i];
+
+        int pending_count = 0;
+        for (size_t j = 0; j < layer->bottoms.size(); j++)
+        {
+            int bottom_blob_index = layer->bottoms[j];
+            if (blob_mats[bottom_blob_index].dims != 0)
+                continue;
+
+            pending_count++;
+
+            int producer = blobs[bottom_blob_index].producer;
+            if (task.pending_bottom_count[producer] == -1)
+            {
+                task.pending_bottom_count[producer] = 0;
+                layer_stack.push_back(producer);
+            }
+        }
+
+        task.pending_bottom_count[i] = pending_count;
+        task.remaining_count++;
+
+        if (pending_count == 0)
+        {
+            task.ready_layer_indexes.push_back(i);
+        }
+    }
+
+    // the calling thread always works on the task
+    const int helper_count = std::min(graph_worker_pool->worker_count(), task.remaining_count - 1);
+    task.max_concurrency = helper_count + 1;
+
+    graph_worker_pool->submit(&task, helper_count);
+
+    task.run();
+
+    graph_worker_pool->wait(&task);
+
+    return task.ret;
+}
+#endif // NCNN_THREADS
+
 #if NCNN_VULKAN
 int NetPrivate::forward_layer(int layer_index, std::vector<Mat>& blob_mats, std::vector<VkMat>& blob_mats_gpu, VkCompute& cmd, const Option& opt) const
 {
@@ -345,6 +865,7 @@ int NetPrivate::forward_layer(int layer_index, std::vector<Mat>& blob_mats, std:
             bottom_blob = blob_mats[bottom_blob_index].shape();
         }
 #endif
+        ProfilerRecord* record = opt.profiler ? opt.profiler->begin_layer(layer, layer_index, blob_mats) : 0;
         if (layer->featmask)
         {
             ret = do_forward_layer(layer, blob_mats, get_masked_option(opt, layer->featmask));
@@ -353,6 +874,8 @@ int NetPrivate::forward_layer(int layer_index, std::vector<Mat>& blob_mats, std:
         {
             ret = do_forward_layer(layer, blob_mats, opt);
         }
+        if (record)
+            opt.profiler->end_layer(record, layer, blob_mats);
 #if NCNN_BENCHMARK
         double end = get_current_time();
         if (layer->one_blob_only)
@@ -584,6 +1107,7 @@ IMAGE_ALLOCATION_FAILED:
             bottom_blob = blob_mats[bottom_blob_index].shape();
         }
 #endif
+        ProfilerRecord* record = opt.profiler ? opt.profiler->begin_layer(layer, layer_index, blob_mats) : 0;
         if (layer->featmask)
         {
             ret = do_forward_layer(layer, blob_mats, get_masked_option(opt, layer->featmask));
@@ -592,6 +1116,8 @@ IMAGE_ALLOCATION_FAILED:
         {
             ret = do_forward_layer(layer, blob_mats, opt);
         }
+        if (record)
+            opt.profiler->end_layer(record, layer, blob_mats);
 #if NCNN_BENCHMARK
         double end = get_current_time();
         if (layer->one_blob_only)
@@ -616,6 +1142,12 @@ IMAGE_ALLOCATION_FAILED:
 
 int NetPrivate::convert_layout(Mat& bottom_blob, const Layer* layer, const Option& opt) const
 {
+    if (bottom_blob.dims != 0 && bottom_blob.total() == 0)
+    {
+        // zero sized blob passes through, like the empty past kv cache of the first decoding step
+        return 0;
+    }
+
     if (bottom_blob.elembits() == 32)
     {
         // clang-format off
@@ -715,6 +1247,18 @@ int NetPrivate::convert_layout(Mat& bottom_blob, const Layer* layer, const Optio
                 const int packn = ncnn::cpu_riscv_vlenb() / 2;
                 if (elemcount % packn == 0)
                     dst_elempack = packn;
+#elif NCNN_AVX512
+                if (elemcount % 16 == 0 && ncnn::cpu_support_x86_avx512())
+                    dst_elempack = 16;
+                else if (elemcount % 8 == 0 && ncnn::cpu_support_x86_avx())
+                    dst_elempack = 8;
+                else if (elemcount % 4 == 0)
+                    dst_elempack = 4;
+#elif NCNN_AVX
+                if (elemcount % 8 == 0 && ncnn::cpu_support_x86_avx())
+                    dst_elempack = 8;
+                else if (elemcount % 4 == 0)
+                    dst_elempack = 4;
 #else
                 if (elemcount % 4 == 0)
                     dst_elempack = 4;
@@ -932,24 +1476,111 @@ int NetPrivate::do_forward_layer(const Layer* layer, std::vector<Mat>& blob_mats
     return 0;
 }
 
-#if NCNN_VULKAN
-int NetPrivate::do_forward_layer(const Layer* layer, std::vector<VkMat>& blob_mats_gpu, VkCompute& cmd, const Option& opt) const
+int NetPrivate::forward_layer_batch(int layer_index, std::vector<std::vector<Mat> >& batch_blob_mats, const Option& opt) const
 {
-    if (layer->one_blob_only)
-    {
-        // load bottom blob
-        int bottom_blob_index = layer->bottoms[0];
-        int top_blob_index = layer->tops[0];
+    const Layer* layer = layers[layer_index];
 
-        VkMat& bottom_blob_ref = blob_mats_gpu[bottom_blob_index];
-        VkMat bottom_blob;
+    // load bottom blobs, all samples advance together
+    for (size_t i = 0; i < layer->bottoms.size(); i++)
+    {
+        int bottom_blob_index = layer->bottoms[i];
 
-        if (opt.lightmode)
+        if (batch_blob_mats[0][bottom_blob_index].dims == 0)
         {
-            // deep copy for inplace forward if data is shared
-            if (layer->support_inplace && *bottom_blob_ref.refcount != 1)
-            {
-                cmd.record_clone(bottom_blob_ref, bottom_blob, opt);
+            int ret = forward_layer_batch(blobs[bottom_blob_index].producer, batch_blob_mats, opt);
+            if (ret != 0)
+                return ret;
+        }
+    }
+
+    // the first sample stands for the whole batch in profiling
+    ProfilerRecord* record = opt.profiler ? opt.profiler->begin_layer(layer, layer_index, batch_blob_mats[0]) : 0;
+    int ret = 0;
+    if (layer->featmask)
+    {
+        ret = do_forward_layer_batch(layer, batch_blob_mats, get_masked_option(opt, layer->featmask));
+    }
+    else
+    {
+        ret = do_forward_layer_batch(layer, batch_blob_mats, opt);
+    }
+    if (record)
+        opt.profiler->end_layer(record, layer, batch_blob_mats[0]);
+
+    return ret;
+}
+
+int NetPrivate::do_forward_layer_batch(const Layer* layer, std::vector<std::vector<Mat> >& batch_blob_mats, const Option& opt) const
+{
+    const int batch = (int)batch_blob_mats.size();
+
+    if (!layer->one_blob_only || !layer->support_batch || batch == 1)
+    {
+        // forward each sample in turn
+        for (int i = 0; i < batch; i++)
+        {
+            int ret = do_forward_layer(layer, batch_blob_mats[i], opt);
+            if (ret != 0)
+                return ret;
+        }
+
+        return 0;
+    }
+
+    int bottom_blob_index = layer->bottoms[0];
+    int top_blob_index = layer->tops[0];
+
+    std::vector<Mat> bottom_blobs(batch);
+    for (int i = 0; i < batch; i++)
+    {
+        bottom_blobs[i] = batch_blob_mats[i][bottom_blob_index];
+
+        int ret = convert_layout(bottom_blobs[i], layer, opt);
+        if (ret != 0)
+            return ret;
+    }
+
+    if (opt.lightmode)
+    {
+        // delete after taken in light mode
+        for (int i = 0; i < batch; i++)
+        {
+            batch_blob_mats[i][bottom_blob_index].release();
+        }
+    }
+
+    std::vector<Mat> top_blobs(batch);
+    int ret = layer->forward_batch(bottom_blobs, top_blobs, opt);
+    if (ret != 0)
+        return ret;
+
+    // store top blobs
+    for (int i = 0; i < batch; i++)
+    {
+        batch_blob_mats[i][top_blob_index] = top_blobs[i];
+    }
+
+    return 0;
+}
+
+#if NCNN_VULKAN
+int NetPrivate::do_forward_layer(const Layer* layer, std::vector<VkMat>& blob_mats_gpu, VkCompute& cmd, const Option& opt) const
+{
+    if (layer->one_blob_only)
+    {
+        // load bottom blob
+        int bottom_blob_index = layer->bottoms[0];
+        int top_blob_index = layer->tops[0];
+
+        VkMat& bottom_blob_ref = blob_mats_gpu[bottom_blob_index];
+        VkMat bottom_blob;
+
+        if (opt.lightmode)
+        {
+            // deep copy for inplace forward if data is shared
+            if (layer->support_inplace && *bottom_blob_ref.refcount != 1)
+            {
+                cmd.record_clone(bottom_blob_ref, bottom_blob, opt);
                 //                     NCNN_LOGE("clone %p[+%lu] %p[+%lu]", bottom_blob_ref.buffer(), bottom_blob_ref.buffer_offset(), bottom_blob.buffer(), bottom_blob.buffer_offset());
             }
         }
@@ -1228,6 +1859,65 @@ void NetPrivate::update_input_output_names()
 }
 #endif // NCNN_STRING
 
+void NetPrivate::update_graph_max_width()
+{
+    // layers are stored in topological order
+    std::vector<int> layer_level(layers.size(), 0);
+    std::vector<int> level_width;
+
+    for (size_t i = 0; i < layers.size(); i++)
+    {
+        const Layer* layer = layers[i];
+
+        int level = 0;
+        for (size_t j = 0; j < layer->bottoms.size(); j++)
+        {
+            int producer = blobs[layer->bottoms[j]].producer;
+            if (producer < 0 || producer >= (int)i)
+                continue;
+
+            level = std::max(level, layer_level[producer] + 1);
+        }
+
+        layer_level[i] = level;
+
+        if (level >= (int)level_width.size())
+            level_width.resize(level + 1, 0);
+
+        level_width[level]++;
+    }
+
+    graph_max_width = 1;
+    for (size_t i = 0; i < level_width.size(); i++)
+    {
+        graph_max_width = std::max(graph_max_width, level_width[i]);
+    }
+}
+
+MemoryPlanAllocator* NetPrivate::acquire_memory_plan_allocator() const
+{
+    MutexLockGuard lock(memory_plan_allocators_lock);
+
+    if (!idle_memory_plan_allocators.empty())
+    {
+        MemoryPlanAllocator* allocator = idle_memory_plan_allocators[idle_memory_plan_allocators.size() - 1];
+        idle_memory_plan_allocators.resize(idle_memory_plan_allocators.size() - 1);
+        return allocator;
+    }
+
+    // all plans are in use, create new
+    MemoryPlanAllocator* allocator = new MemoryPlanAllocator;
+    memory_plan_allocators.push_back(allocator);
+    return allocator;
+}
+
+void NetPrivate::reclaim_memory_plan_allocator(MemoryPlanAllocator* allocator) const
+{
+    MutexLockGuard lock(memory_plan_allocators_lock);
+
+    idle_memory_plan_allocators.push_back(allocator);
+}
+
 Net::Net()
     : d(new NetPrivate(opt))
 {
@@ -1912,6 +2602,10 @@ int Net::load_model(const DataReader& dr)
 
     int layer_count = (int)d->layers.size();
 
+    // weights and packed pipelines are first touched on the numa node
+    // the previous binding is restored on return
+    CpuThreadNumaNodeGuard numa_node_guard(opt.numa_node);
+
     // load file
     int ret = 0;
 
@@ -1987,6 +2681,20 @@ int Net::load_model(const DataReader& dr)
         }
     }
 
+#if NCNN_THREADS
+    if (ret == 0 && opt.use_parallel_graph && !opt.use_vulkan_compute && !d->graph_worker_pool)
+    {
+        d->update_graph_max_width();
+
+        // the extracting thread works as well
+        int worker_count = std::min(opt.num_threads, d->graph_max_width) - 1;
+        if (worker_count > 0)
+        {
+            d->graph_worker_pool = new ParallelGraphWorkerPool(worker_count);
+        }
+    }
+#endif // NCNN_THREADS
+
 #if NCNN_VULKAN
     if (ret == 0 && opt.use_vulkan_compute)
     {
@@ -2066,6 +2774,26 @@ int Net::load_model(const char* modelpath)
     fclose(fp);
     return ret;
 }
+
+int Net::load_model_mmap(const char* modelpath)
+{
+    DataReaderFromMmap* dr = new DataReaderFromMmap(modelpath);
+    if (!dr->is_mapped())
+    {
+        NCNN_LOGE("mmap %s failed", modelpath);
+        delete dr;
+        return -1;
+    }
+
+    int ret = load_model(*dr);
+
+    // keep the mapping alive, layers may still reference it even on failure
+    if (d->model_mmap_reader)
+        delete d->model_mmap_reader;
+    d->model_mmap_reader = dr;
+
+    return ret;
+}
 #endif // NCNN_STDIO
 
 int Net::load_param(const unsigned char* _mem)
@@ -2152,6 +2880,15 @@ int Net::load_model(AAssetManager* mgr, const char* assetpath)
 
 void Net::clear()
 {
+#if NCNN_THREADS
+    // pending extract_async requests still use the layers
+    if (d->async_worker_pool)
+    {
+        delete d->async_worker_pool;
+        d->async_worker_pool = 0;
+    }
+#endif // NCNN_THREADS
+
     d->blobs.clear();
     for (size_t i = 0; i < d->layers.size(); i++)
     {
@@ -2221,6 +2958,35 @@ void Net::clear()
         d->local_workspace_allocator = 0;
     }
 
+#if NCNN_STDIO
+    if (d->model_mmap_reader)
+    {
+        // unmap after all layers referencing it are gone
+        delete d->model_mmap_reader;
+        d->model_mmap_reader = 0;
+    }
+#endif // NCNN_STDIO
+
+#if NCNN_THREADS
+    if (d->graph_worker_pool)
+    {
+        delete d->graph_worker_pool;
+        d->graph_worker_pool = 0;
+    }
+#endif // NCNN_THREADS
+    d->graph_max_width = 1;
+
+    if (d->idle_memory_plan_allocators.size() != d->memory_plan_allocators.size())
+    {
+        NCNN_LOGE("FATAL ERROR! net cleared while extractors still use memory plan");
+    }
+    for (size_t i = 0; i < d->memory_plan_allocators.size(); i++)
+    {
+        delete d->memory_plan_allocators[i];
+    }
+    d->memory_plan_allocators.clear();
+    d->idle_memory_plan_allocators.clear();
+
 #if NCNN_VULKAN
     if (d->weight_vkallocator)
     {
@@ -2414,10 +3180,39 @@ public:
         : net(_net)
     {
     }
+    // pick memory plan or local pool allocator for unset cpu allocators
+    void use_local_allocators(const NetPrivate* net_d);
+
+    // unpack and cast the extracted blob, and detach it from local allocators
+    int convert_extracted(Mat& feat, int type, const NetPrivate* net_d) const;
+
+    // bind the extracting thread to the scheduler share, cpu affinity or numa node
+    void acquire_cpus();
+    void release_cpus();
+
     const Net* net;
     std::vector<Mat> blob_mats;
     Option opt;
 
+    // one blob_mats for each sample of batch inference
+    std::vector<std::vector<Mat> > batch_blob_mats;
+
+    MemoryPlanAllocator* local_memory_plan_allocator;
+
+    bool use_thread_affinity_mask;
+    CpuSet thread_affinity_mask;
+
+    CpuScheduler* cpu_scheduler;
+    // the share taken from cpu_scheduler and the thread count it replaced
+    CpuSet scheduled_thread_affinity_mask;
+    int unscheduled_num_threads;
+
+    // the binding of the extracting thread before acquire_cpus, put back by release_cpus
+    bool restore_thread_affinity;
+    CpuSet prev_thread_affinity_mask;
+    int prev_numa_node;
+    int prev_omp_num_threads;
+
 #if NCNN_VULKAN
     VkAllocator* local_blob_vkallocator;
     VkAllocator* local_staging_vkallocator;
@@ -2427,12 +3222,142 @@ public:
 #endif // NCNN_VULKAN
 };
 
+void ExtractorPrivate::use_local_allocators(const NetPrivate* net_d)
+{
+    // use memory plan
+    // the allocation order of parallel graph is not deterministic, skip it
+    if (opt.use_memory_plan && !opt.use_parallel_graph && !opt.blob_allocator && !opt.workspace_allocator)
+    {
+        local_memory_plan_allocator = net_d->acquire_memory_plan_allocator();
+        local_memory_plan_allocator->begin();
+
+        opt.blob_allocator = local_memory_plan_allocator;
+        opt.workspace_allocator = local_memory_plan_allocator;
+    }
+
+    // use local allocator
+    if (opt.use_local_pool_allocator)
+    {
+        if (!opt.blob_allocator)
+        {
+            opt.blob_allocator = net_d->local_blob_allocator;
+        }
+        if (!opt.workspace_allocator)
+        {
+            opt.workspace_allocator = net_d->local_workspace_allocator;
+        }
+    }
+}
+
+int ExtractorPrivate::convert_extracted(Mat& feat, int type, const NetPrivate* net_d) const
+{
+    // empty is valid for outputs
+    if (feat.empty())
+        return 0;
+
+    if (type == 0)
+    {
+        // unpack and cast fp16/bf16 back to fp32, as for a consumer without any packing or storage support
+        Layer fp32_consumer;
+        int ret = net_d->convert_layout(feat, &fp32_consumer, opt);
+        if (ret != 0)
+            return ret;
+
+        if (feat.elembits() == 8)
+        {
+            Mat feat_fp32;
+            cast_int8_to_float32(feat, feat_fp32, opt);
+            feat = feat_fp32;
+            if (feat.empty())
+                return -100;
+        }
+    }
+
+    if (opt.use_local_pool_allocator && feat.allocator == net_d->local_blob_allocator)
+    {
+        // detach the returned mat from local pool allocator
+        // so we could destroy net instance much earlier
+        feat = feat.clone();
+        if (feat.empty())
+            return -100;
+    }
+
+    if (local_memory_plan_allocator && feat.allocator == local_memory_plan_allocator)
+    {
+        // detach the returned mat from memory plan
+        // as the arena is reused by the next inference
+        feat = feat.clone();
+        if (feat.empty())
+            return -100;
+    }
+
+    return 0;
+}
+
+void ExtractorPrivate::acquire_cpus()
+{
+    restore_thread_affinity = false;
+
+    if (cpu_scheduler || use_thread_affinity_mask)
+    {
+        restore_thread_affinity = get_cpu_thread_affinity(prev_thread_affinity_mask) == 0;
+        prev_numa_node = get_cpu_thread_numa_node();
+        prev_omp_num_threads = get_omp_num_threads();
+    }
+
+    if (cpu_scheduler)
+    {
+        unscheduled_num_threads = opt.num_threads;
+        opt.num_threads = cpu_scheduler->acquire(scheduled_thread_affinity_mask, unscheduled_num_threads);
+        set_cpu_thread_affinity(scheduled_thread_affinity_mask);
+        return;
+    }
+
+    if (use_thread_affinity_mask)
+    {
+        set_cpu_thread_affinity(thread_affinity_mask);
+        return;
+    }
+
+    // the binding stays on this thread, extracting again on the same node is cheap
+    if (opt.numa_node >= 0)
+        set_cpu_thread_numa_node(opt.numa_node);
+}
+
+void ExtractorPrivate::release_cpus()
+{
+    if (cpu_scheduler)
+    {
+        cpu_scheduler->release(scheduled_thread_affinity_mask);
+        opt.num_threads = unscheduled_num_threads;
+    }
+
+    if (restore_thread_affinity)
+    {
+        // a numa bound thread goes back to its node so that the binding is still remembered
+        if (prev_numa_node >= 0)
+            set_cpu_thread_numa_node(prev_numa_node);
+        else
+            set_cpu_thread_affinity(prev_thread_affinity_mask);
+
+        set_omp_num_threads(prev_omp_num_threads);
+
+        restore_thread_affinity = false;
+    }
+}
+
 Extractor::Extractor(const Net* _net, size_t blob_count)
     : d(new ExtractorPrivate(_net))
 {
     d->blob_mats.resize(blob_count);
     d->opt = d->net->opt;
 
+    d->local_memory_plan_allocator = 0;
+
+    d->use_thread_affinity_mask = false;
+    d->cpu_scheduler = 0;
+    d->restore_thread_affinity = false;
+
 #if NCNN_VULKAN
     if (d->net->opt.use_vulkan_compute)
     {
@@ -2457,8 +3382,22 @@ Extractor::Extractor(const Extractor& rhs)
 {
     d->net = rhs.d->net;
     d->blob_mats = rhs.d->blob_mats;
+    d->batch_blob_mats = rhs.d->batch_blob_mats;
     d->opt = rhs.d->opt;
 
+    d->use_thread_affinity_mask = rhs.d->use_thread_affinity_mask;
+    d->thread_affinity_mask = rhs.d->thread_affinity_mask;
+    d->cpu_scheduler = rhs.d->cpu_scheduler;
+    d->restore_thread_affinity = false;
+
+    d->local_memory_plan_allocator = 0;
+    if (rhs.d->local_memory_plan_allocator)
+    {
+        // the memory plan stays with rhs
+        d->opt.blob_allocator = d->net->opt.blob_allocator;
+        d->opt.workspace_allocator = d->net->opt.workspace_allocator;
+    }
+
 #if NCNN_VULKAN
     d->local_blob_vkallocator = 0;
     d->local_staging_vkallocator = 0;
@@ -2475,8 +3414,21 @@ Extractor& Extractor::operator=(const Extractor& rhs)
 
     d->net = rhs.d->net;
     d->blob_mats = rhs.d->blob_mats;
+    d->batch_blob_mats = rhs.d->batch_blob_mats;
     d->opt = rhs.d->opt;
 
+    d->use_thread_affinity_mask = rhs.d->use_thread_affinity_mask;
+    d->thread_affinity_mask = rhs.d->thread_affinity_mask;
+    d->cpu_scheduler = rhs.d->cpu_scheduler;
+
+    d->local_memory_plan_allocator = 0;
+    if (rhs.d->local_memory_plan_allocator)
+    {
+        // the memory plan stays with rhs
+        d->opt.blob_allocator = d->net->opt.blob_allocator;
+        d->opt.workspace_allocator = d->net->opt.workspace_allocator;
+    }
+
 #if NCNN_VULKAN
     d->local_blob_vkallocator = 0;
     d->local_staging_vkallocator = 0;
@@ -2491,6 +3443,17 @@ Extractor& Extractor::operator=(const Extractor& rhs)
 void Extractor::clear()
 {
     d->blob_mats.clear();
+    d->batch_blob_mats.clear();
+
+    if (d->local_memory_plan_allocator)
+    {
+        d->local_memory_plan_allocator->end();
+        d->net->d->reclaim_memory_plan_allocator(d->local_memory_plan_allocator);
+        d->local_memory_plan_allocator = 0;
+
+        d->opt.blob_allocator = d->net->opt.blob_allocator;
+        d->opt.workspace_allocator = d->net->opt.workspace_allocator;
+    }
 
 #if NCNN_VULKAN
     if (d->opt.use_vulkan_compute)
@@ -2517,8 +3480,25 @@ void Extractor::set_light_mode(bool enable)
 
 void Extractor::set_num_threads(int num_threads)
 {
-    NCNN_LOGE("ex.set_num_threads() is no-op, please set net.opt.num_threads=N before net.load_param()");
-    NCNN_LOGE("If you want to use single thread for only some layer, see https://github.com/Tencent/ncnn/wiki/layer-feat-mask");
+    if (num_threads > d->net->opt.num_threads)
+    {
+        // pre-packed weights come from the tile config of the load-time thread count
+        NCNN_LOGE("ex.set_num_threads(%d) exceeds net.opt.num_threads %d, clamped", num_threads, d->net->opt.num_threads);
+        num_threads = d->net->opt.num_threads;
+    }
+
+    d->opt.num_threads = num_threads;
+}
+
+void Extractor::set_cpu_affinity(const CpuSet& thread_affinity_mask)
+{
+    d->use_thread_affinity_mask = true;
+    d->thread_affinity_mask = thread_affinity_mask;
+}
+
+void Extractor::set_cpu_scheduler(CpuScheduler* scheduler)
+{
+    d->cpu_scheduler = scheduler;
 }
 
 void Extractor::set_blob_allocator(Allocator* allocator)
@@ -2531,6 +3511,11 @@ void Extractor::set_workspace_allocator(Allocator* allocator)
     d->opt.workspace_allocator = allocator;
 }
 
+void Extractor::set_profiler(Profiler* profiler)
+{
+    d->opt.profiler = profiler;
+}
+
 #if NCNN_VULKAN
 void Extractor::set_vulkan_compute(bool enable)
 {
@@ -2613,24 +3598,15 @@ int Extractor::extract(int blob_index, Mat& feat, int type)
     int old_flush_denormals = get_flush_denormals();
     set_flush_denormals(d->opt.flush_denormals);
 
+    d->acquire_cpus();
+
     int ret = 0;
 
     if (d->blob_mats[blob_index].dims == 0)
     {
         int layer_index = d->net->blobs()[blob_index].producer;
 
-        // use local allocator
-        if (d->opt.use_local_pool_allocator)
-        {
-            if (!d->opt.blob_allocator)
-            {
-                d->opt.blob_allocator = d->net->d->local_blob_allocator;
-            }
-            if (!d->opt.workspace_allocator)
-            {
-                d->opt.workspace_allocator = d->net->d->local_workspace_allocator;
-            }
-        }
+        d->use_local_allocators(d->net->d);
 
 #if NCNN_VULKAN
         if (d->opt.use_vulkan_compute)
@@ -2713,98 +3689,210 @@ int Extractor::extract(int blob_index, Mat& feat, int type)
             }
         }
         else
+#endif // NCNN_VULKAN
+#if NCNN_THREADS
+        if (d->opt.use_parallel_graph && d->net->d->graph_worker_pool)
+        {
+            ret = d->net->d->forward_layer_parallel(layer_index, d->blob_mats, d->opt);
+        }
+        else
+#endif // NCNN_THREADS
         {
             ret = d->net->d->forward_layer(layer_index, d->blob_mats, d->opt);
         }
-#else
-        ret = d->net->d->forward_layer(layer_index, d->blob_mats, d->opt);
-#endif // NCNN_VULKAN
     }
 
     feat = d->blob_mats[blob_index];
 
-    // empty is valid for outputs
-    if (!feat.empty())
+    int convert_ret = d->convert_extracted(feat, type, d->net->d);
+    if (convert_ret != 0)
+        ret = convert_ret;
+
+    d->release_cpus();
+
+    set_kmp_blocktime(old_blocktime);
+    set_flush_denormals(old_flush_denormals);
+
+    return ret;
+}
+
+#if NCNN_STRING
+int Extractor::extract_async(const char* blob_name, extract_callback_func callback, void* userdata, int type)
+{
+    int blob_index = d->net->find_blob_index_by_name(blob_name);
+    if (blob_index == -1)
     {
-        if (d->opt.use_packing_layout && (type == 0) && feat.elempack != 1)
+        NCNN_LOGE("Try");
+        const std::vector<const char*>& output_names = d->net->output_names();
+        for (size_t i = 0; i < output_names.size(); i++)
         {
-            Mat bottom_blob_unpacked;
-            convert_packing(feat, bottom_blob_unpacked, 1, d->opt);
-            feat = bottom_blob_unpacked;
-            if (feat.empty())
-                return -100;
+            NCNN_LOGE("    ex.extract_async(\"%s\", callback);", output_names[i]);
         }
 
-        // clang-format off
-        // *INDENT-OFF*
-#if NCNN_ARM82
-        if (d->opt.use_fp16_storage && cpu_support_arm_asimdhp() && (type == 0))
-        {
-            if (feat.elembits() == 16)
-            {
-                Mat feat_fp32;
-                cast_float16_to_float32(feat, feat_fp32, d->opt);
-                feat = feat_fp32;
-            }
-        }
-        else
-#endif // NCNN_ARM82
-#if NCNN_VFPV4
-        if (d->opt.use_fp16_storage && !d->opt.use_bf16_storage && cpu_support_arm_vfpv4() && (type == 0))
-        {
-            if (feat.elembits() == 16)
-            {
-                Mat feat_fp32;
-                cast_float16_to_float32(feat, feat_fp32, d->opt);
-                feat = feat_fp32;
-            }
-        }
-        else
-#endif // NCNN_VFPV4
-#if NCNN_RVV
-        if (d->opt.use_fp16_storage && cpu_support_riscv_v() && cpu_support_riscv_zfh() && (type == 0))
-        {
-            if (feat.elembits() == 16)
-            {
-                Mat feat_fp32;
-                cast_float16_to_float32(feat, feat_fp32, d->opt);
-                feat = feat_fp32;
-            }
-        }
-        else
-#endif // NCNN_RVV
-#if NCNN_BF16
-        if (d->opt.use_bf16_storage && (type == 0))
-        {
-            if (feat.elembits() == 16)
-            {
-                Mat feat_fp32;
-                cast_bfloat16_to_float32(feat, feat_fp32, d->opt);
-                feat = feat_fp32;
-            }
-        }
-        else
-#endif // NCNN_BF16
-        if (feat.elembits() == 8 && (type == 0))
+        return -1;
+    }
+
+    return extract_async(blob_index, callback, userdata, type);
+}
+#endif // NCNN_STRING
+
+int Extractor::extract_async(int blob_index, extract_callback_func callback, void* userdata, int type)
+{
+    if (blob_index < 0 || blob_index >= (int)d->blob_mats.size())
+        return -1;
+
+    if (!callback)
+    {
+        NCNN_LOGE("extract_async without callback");
+        return -1;
+    }
+
+#if NCNN_THREADS
+    NetPrivate* net_d = d->net->d;
+
+    net_d->async_worker_pool_lock.lock();
+    if (!net_d->async_worker_pool)
+    {
+        // every request extracts with opt.num_threads, run as many as the big cores could hold
+        int worker_count = std::max(get_physical_big_cpu_count() / std::max(d->net->opt.num_threads, 1), 1);
+        net_d->async_worker_pool = new AsyncExtractWorkerPool(worker_count);
+    }
+    net_d->async_worker_pool_lock.unlock();
+
+    AsyncExtractTask task;
+    task.ex = this;
+    task.blob_index = blob_index;
+    task.type = type;
+    task.callback = callback;
+    task.userdata = userdata;
+
+    net_d->async_worker_pool->submit(task);
+#else
+    // no worker thread, extract on the calling thread
+    Mat feat;
+    int ret = extract(blob_index, feat, type);
+    callback(ret, feat, userdata);
+#endif // NCNN_THREADS
+
+    return 0;
+}
+
+#if NCNN_STRING
+int Extractor::input_batch(const char* blob_name, const std::vector<Mat>& in)
+{
+    int blob_index = d->net->find_blob_index_by_name(blob_name);
+    if (blob_index == -1)
+    {
+        NCNN_LOGE("Try");
+        const std::vector<const char*>& input_names = d->net->input_names();
+        for (size_t i = 0; i < input_names.size(); i++)
         {
-            Mat feat_fp32;
-            cast_int8_to_float32(feat, feat_fp32, d->opt);
-            feat = feat_fp32;
+            NCNN_LOGE("    ex.input_batch(\"%s\", in%d);", input_names[i], (int)i);
         }
-        // *INDENT-ON*
-        // clang-format on
-        if (feat.empty())
-            return -100;
 
-        if (d->opt.use_local_pool_allocator && feat.allocator == d->net->d->local_blob_allocator)
+        return -1;
+    }
+
+    return input_batch(blob_index, in);
+}
+
+int Extractor::extract_batch(const char* blob_name, std::vector<Mat>& feats, int type)
+{
+    int blob_index = d->net->find_blob_index_by_name(blob_name);
+    if (blob_index == -1)
+    {
+        NCNN_LOGE("Try");
+        const std::vector<const char*>& output_names = d->net->output_names();
+        for (size_t i = 0; i < output_names.size(); i++)
         {
-            // detach the returned mat from local pool allocator
-            // so we could destroy net instance much earlier
-            feat = feat.clone();
-            if (feat.empty())
-                return -100;
+            NCNN_LOGE("    ex.extract_batch(\"%s\", out%d);", output_names[i], (int)i);
         }
+
+        return -1;
+    }
+
+    return extract_batch(blob_index, feats, type);
+}
+#endif // NCNN_STRING
+
+int Extractor::input_batch(int blob_index, const std::vector<Mat>& in)
+{
+    if (blob_index < 0 || blob_index >= (int)d->blob_mats.size())
+        return -1;
+
+    if (in.empty())
+        return -1;
+
+    if (d->batch_blob_mats.empty())
+    {
+        d->batch_blob_mats.resize(in.size(), std::vector<Mat>(d->blob_mats.size()));
+    }
+
+    if (d->batch_blob_mats.size() != in.size())
+    {
+        NCNN_LOGE("input_batch got %d samples but %d expected", (int)in.size(), (int)d->batch_blob_mats.size());
+        return -1;
+    }
+
+    for (size_t i = 0; i < in.size(); i++)
+    {
+        d->batch_blob_mats[i][blob_index] = in[i];
+    }
+
+    return 0;
+}
+
+int Extractor::extract_batch(int blob_index, std::vector<Mat>& feats, int type)
+{
+    if (blob_index < 0 || blob_index >= (int)d->blob_mats.size())
+        return -1;
+
+    if (d->batch_blob_mats.empty())
+    {
+        NCNN_LOGE("extract_batch without input_batch");
+        return -1;
+    }
+
+#if NCNN_VULKAN
+    if (d->opt.use_vulkan_compute)
+    {
+        NCNN_LOGE("extract_batch does not support vulkan compute");
+        return -1;
     }
+#endif // NCNN_VULKAN
+
+    int old_blocktime = get_kmp_blocktime();
+    set_kmp_blocktime(d->opt.openmp_blocktime);
+
+    int old_flush_denormals = get_flush_denormals();
+    set_flush_denormals(d->opt.flush_denormals);
+
+    d->acquire_cpus();
+
+    int ret = 0;
+
+    if (d->batch_blob_mats[0][blob_index].dims == 0)
+    {
+        int layer_index = d->net->blobs()[blob_index].producer;
+
+        d->use_local_allocators(d->net->d);
+
+        ret = d->net->d->forward_layer_batch(layer_index, d->batch_blob_mats, d->opt);
+    }
+
+    const size_t batch = d->batch_blob_mats.size();
+
+    feats.resize(batch);
+    for (size_t i = 0; i < batch; i++)
+    {
+        feats[i] = d->batch_blob_mats[i][blob_index];
+
+        int convert_ret = d->convert_extracted(feats[i], type, d->net->d);
+        if (convert_ret != 0)
+            ret = convert_ret;
+    }
+
+    d->release_cpus();
 
     set_kmp_blocktime(old_blocktime);
     set_flush_denormals(old_flush_denormals);
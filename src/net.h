@@ -33,6 +33,8 @@ namespace ncnn {
 class VkCompute;
 #endif // NCNN_VULKAN
 class DataReader;
+class CpuSet;
+class CpuScheduler;
 class Extractor;
 class NetPrivate;
 class NCNN_EXPORT Net
@@ -92,6 +94,13 @@ public:
     // return 0 if success
     int load_model(FILE* fp);
     int load_model(const char* modelpath);
+
+    // load network weight data from model file with read-only memory mapping
+    // weight data is not copied but referenced from the mapping
+    // so processes loading the same model share the physical pages
+    // the mapping is retained until clear()
+    // return 0 if success
+    int load_model_mmap(const char* modelpath);
 #endif // NCNN_STDIO
 
     // load network structure from external memory
@@ -162,6 +171,10 @@ private:
     NetPrivate* const d;
 };
 
+// completion callback of Extractor::extract_async
+// ret and feat are what Extractor::extract would give
+typedef void (*extract_callback_func)(int ret, const Mat& feat, void* userdata);
+
 class ExtractorPrivate;
 class NCNN_EXPORT Extractor
 {
@@ -182,16 +195,30 @@ public:
     // enabled by default
     void set_light_mode(bool enable);
 
-    // deprecated, no-op
-    // instead, set net.opt.num_threads before net.load_param()
+    // set thread count for this extractor only
+    // weights are tiled for net.opt.num_threads at load time, so it is the upper limit
     void set_num_threads(int num_threads);
 
+    // pin the extracting thread and its workers to the cpus of thread_affinity_mask
+    // the thread count is not changed, see set_num_threads
+    void set_cpu_affinity(const CpuSet& thread_affinity_mask);
+
+    // take a cpu share from scheduler for each extraction
+    // thread count and affinity follow the share, overriding set_cpu_affinity
+    // the share never exceeds the set_num_threads value
+    // null for scheduling disabled
+    void set_cpu_scheduler(CpuScheduler* scheduler);
+
     // set blob memory allocator
     void set_blob_allocator(Allocator* allocator);
 
     // set workspace memory allocator
     void set_workspace_allocator(Allocator* allocator);
 
+    // record per-layer timing into profiler
+    // null for profiling disabled
+    void set_profiler(Profiler* profiler);
+
 #if NCNN_VULKAN
     // deprecated, no-op
     // instead, set net.opt.use_vulkan_compute before net.load_param()
@@ -226,6 +253,49 @@ public:
     // type = 1, do not convert fp16/bf16 or / and packing
     int extract(int blob_index, Mat& feat, int type = 0);
 
+#if NCNN_STRING
+    // get result by blob name without blocking
+    // extraction runs on the worker threads of the net and callback is called there when done
+    // up to physical big cpu count / net.opt.num_threads requests run at the same time, the rest are queued
+    // the extractor must stay untouched until the callback, which may destroy the extractor
+    // return 0 if queued
+    int extract_async(const char* blob_name, extract_callback_func callback, void* userdata = 0, int type = 0);
+#endif // NCNN_STRING
+
+    // get result by blob index without blocking
+    // return 0 if queued
+    int extract_async(int blob_index, extract_callback_func callback, void* userdata = 0, int type = 0);
+
+#if NCNN_STRING
+    // set batch input by blob name, one mat for each sample
+    // all batch inputs must have the same sample count
+    // return 0 if success
+    int input_batch(const char* blob_name, const std::vector<Mat>& in);
+
+    // get batch result by blob name, one mat for each sample
+    // layers supporting batch forward process all samples in one call
+    // the others, including kxk convolution, forward each sample in turn
+    // cpu only
+    // return 0 if success
+    // type = 0, default
+    // type = 1, do not convert fp16/bf16 or / and packing
+    int extract_batch(const char* blob_name, std::vector<Mat>& feats, int type = 0);
+#endif // NCNN_STRING
+
+    // set batch input by blob index, one mat for each sample
+    // all batch inputs must have the same sample count
+    // return 0 if success
+    int input_batch(int blob_index, const std::vector<Mat>& in);
+
+    // get batch result by blob index, one mat for each sample
+    // layers supporting batch forward process all samples in one call
+    // the others, including kxk convolution, forward each sample in turn
+    // cpu only
+    // return 0 if success
+    // type = 0, default
+    // type = 1, do not convert fp16/bf16 or / and packing
+    int extract_batch(int blob_index, std::vector<Mat>& feats, int type = 0);
+
 #if NCNN_VULKAN
 #if NCNN_STRING
     // set input by blob name
@@ -77,6 +77,15 @@ Option::Option()
 
     use_fp16_uniform = true;
     use_int8_uniform = true;
+
+    use_parallel_graph = false;
+    use_memory_plan = false;
+    use_fp16_weight_storage = false;
+
+    numa_node = -1;
+
+    cpu_pipeline_cache = 0;
+    profiler = 0;
 }
 
 } // namespace ncnn
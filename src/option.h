@@ -25,6 +25,8 @@ class PipelineCache;
 #endif // NCNN_VULKAN
 
 class Allocator;
+class CpuPipelineCache;
+class Profiler;
 class NCNN_EXPORT Option
 {
 public:
@@ -148,9 +150,43 @@ public:
     bool use_fp16_uniform;
     bool use_int8_uniform;
 
-    bool use_reserved_9;
-    bool use_reserved_10;
-    bool use_reserved_11;
+    // enable inter-layer parallel graph scheduling
+    // independent branches are dispatched concurrently on a worker pool
+    // and num_threads is partitioned between the layers running at the same time
+    // blob and workspace allocator must be thread-safe when enabled
+    // changes should be applied before loading network structure and weight
+    // disabled by default
+    bool use_parallel_graph;
+
+    // plan intermediate blob and workspace memory into one arena per extractor
+    // the first inference is traced and every allocation gets a lifetime-aware offset
+    // later inferences with the same input shapes run without heap allocation
+    // takes effect only when blob_allocator and workspace_allocator are not set
+    // and use_parallel_graph is off
+    // disabled by default
+    bool use_memory_plan;
+
+    // keep the packed convolution and gemm weights in fp16 on x86 with f16c
+    // halves weight memory and bandwidth of weight-bound layers
+    // weights are rounded to fp16, blobs and accumulation stay fp32
+    // takes effect together with use_fp16_storage
+    // disabled by default
+    bool use_fp16_weight_storage;
+
+    // bind to the cpus of one numa node, see get_cpu_numa_node_count()
+    // load_model runs on the node so weights are placed there by first touch
+    // extract pins the calling thread and its openmp workers to the node
+    // load one net per node for per-node weight replicas
+    // -1 = no binding (default)
+    int numa_node;
+
+    // transformed weight cache for cpu layers
+    // null for transforming weights every time
+    CpuPipelineCache* cpu_pipeline_cache;
+
+    // per-layer profiler
+    // null for profiling disabled
+    Profiler* profiler;
 };
 
 } // namespace ncnn
@@ -0,0 +1,353 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "profiler.h"
+
+#include "benchmark.h"
+#include "layer.h"
+
+#if NCNN_STDIO
+#include <stdio.h>
+#include <string.h>
+#endif // NCNN_STDIO
+
+namespace ncnn {
+
+ProfilerRecord::ProfilerRecord()
+{
+    layer_index = -1;
+    kernel = "";
+    start = 0;
+    end = 0;
+    thread = 0;
+    bytes_allocated = 0;
+}
+
+class ProfilerPrivate
+{
+public:
+    int get_thread_index();
+
+    double time_origin;
+
+    mutable Mutex lock;
+    std::vector<ProfilerRecord> records;
+
+    // thread index + 1 for each thread seen
+    ThreadLocalStorage thread_index;
+    int thread_count;
+
+    // the record of the layer running in this thread
+    ThreadLocalStorage current_record;
+};
+
+int ProfilerPrivate::get_thread_index()
+{
+    size_t index = (size_t)thread_index.get();
+    if (index == 0)
+    {
+        MutexLockGuard guard(lock);
+        index = ++thread_count;
+        thread_index.set((void*)index);
+    }
+
+    return (int)index - 1;
+}
+
+Profiler::Profiler()
+    : d(new ProfilerPrivate)
+{
+    d->time_origin = get_current_time();
+    d->thread_count = 0;
+}
+
+Profiler::~Profiler()
+{
+    delete d;
+}
+
+Profiler::Profiler(const Profiler&)
+    : d(0)
+{
+}
+
+Profiler& Profiler::operator=(const Profiler&)
+{
+    return *this;
+}
+
+void Profiler::clear()
+{
+    MutexLockGuard guard(d->lock);
+
+    d->records.clear();
+    d->time_origin = get_current_time();
+}
+
+std::vector<ProfilerRecord> Profiler::records() const
+{
+    MutexLockGuard guard(d->lock);
+
+    return d->records;
+}
+
+ProfilerRecord* Profiler::begin_layer(const Layer* layer, int layer_index, const std::vector<Mat>& blob_mats)
+{
+    ProfilerRecord* record = new ProfilerRecord;
+    record->layer_index = layer_index;
+#if NCNN_STRING
+    record->type = layer->type;
+    record->name = layer->name;
+#endif // NCNN_STRING
+    record->thread = d->get_thread_index();
+
+    record->bottom_shapes.resize(layer->bottoms.size());
+    record->bottom_datas.resize(layer->bottoms.size());
+    for (size_t i = 0; i < layer->bottoms.size(); i++)
+    {
+        const Mat& m = blob_mats[layer->bottoms[i]];
+        record->bottom_shapes[i] = m.shape();
+        record->bottom_datas[i] = m.data;
+    }
+
+    d->current_record.set(record);
+
+    record->start = get_current_time() - d->time_origin;
+
+    return record;
+}
+
+void Profiler::end_layer(ProfilerRecord* record, const Layer* layer, const std::vector<Mat>& blob_mats)
+{
+    record->end = get_current_time() - d->time_origin;
+
+    d->current_record.set(0);
+
+    record->top_shapes.resize(layer->tops.size());
+    for (size_t i = 0; i < layer->tops.size(); i++)
+    {
+        const Mat& m = blob_mats[layer->tops[i]];
+        record->top_shapes[i] = m.shape();
+
+        bool inplace = false;
+        for (size_t j = 0; j < record->bottom_datas.size(); j++)
+        {
+            if (m.data && m.data == record->bottom_datas[j])
+            {
+                inplace = true;
+                break;
+            }
+        }
+
+        if (!inplace && m.data)
+            record->bytes_allocated += m.total() * m.elemsize;
+    }
+
+    record->bottom_datas.clear();
+
+    {
+        MutexLockGuard guard(d->lock);
+        d->records.push_back(*record);
+    }
+
+    delete record;
+}
+
+void Profiler::note_kernel(const char* kernel)
+{
+    // the first report wins, the sub-layers of a composite layer do not override it
+    ProfilerRecord* record = (ProfilerRecord*)d->current_record.get();
+    if (record && record->kernel[0] == '\0')
+        record->kernel = kernel;
+}
+
+#if NCNN_STDIO
+static void fprint_json_string(FILE* fp, const char* s)
+{
+    fputc('"', fp);
+    for (; *s; s++)
+    {
+        const unsigned char c = (unsigned char)*s;
+        if (c == '"' || c == '\\')
+            fprintf(fp, "\\%c", c);
+        else if (c < 0x20)
+            fprintf(fp, "\\u%04x", c);
+        else
+            fputc(c, fp);
+    }
+    fputc('"', fp);
+}
+
+static void fprint_shapes(FILE* fp, const std::vector<Mat>& shapes)
+{
+    for (size_t i = 0; i < shapes.size(); i++)
+    {
+        const Mat& m = shapes[i];
+        if (i != 0)
+            fprintf(fp, " ");
+
+        if (m.dims == 1)
+            fprintf(fp, "[%d", m.w);
+        else if (m.dims == 2)
+            fprintf(fp, "[%d,%d", m.w, m.h);
+        else if (m.dims == 3)
+            fprintf(fp, "[%d,%d,%d", m.w, m.h, m.c);
+        else if (m.dims == 4)
+            fprintf(fp, "[%d,%d,%d,%d", m.w, m.h, m.d, m.c);
+        else
+            fprintf(fp, "[");
+
+        fprintf(fp, " pack%d %dB]", m.elempack, (int)m.elemsize);
+    }
+}
+
+int Profiler::save_chrome_trace(const char* path) const
+{
+    FILE* fp = fopen(path, "wb");
+    if (!fp)
+    {
+        NCNN_LOGE("fopen %s failed", path);
+        return -1;
+    }
+
+    const std::vector<ProfilerRecord> rs = records();
+
+    fprintf(fp, "{\"traceEvents\":[\n");
+    for (size_t i = 0; i < rs.size(); i++)
+    {
+        const ProfilerRecord& r = rs[i];
+
+        fprintf(fp, "{\"name\":");
+#if NCNN_STRING
+        fprint_json_string(fp, r.name.c_str());
+        fprintf(fp, ",\"cat\":");
+        fprint_json_string(fp, r.type.c_str());
+#else
+        fprintf(fp, "\"%d\",\"cat\":\"layer\"", r.layer_index);
+#endif // NCNN_STRING
+        fprintf(fp, ",\"ph\":\"X\",\"pid\":0,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f", r.thread, r.start * 1000, (r.end - r.start) * 1000);
+
+        fprintf(fp, ",\"args\":{\"layer_index\":%d,\"kernel\":", r.layer_index);
+        fprint_json_string(fp, r.kernel);
+        fprintf(fp, ",\"bottom\":\"");
+        fprint_shapes(fp, r.bottom_shapes);
+        fprintf(fp, "\",\"top\":\"");
+        fprint_shapes(fp, r.top_shapes);
+        fprintf(fp, "\",\"bytes_allocated\":%lu}}%s\n", (unsigned long)r.bytes_allocated, i + 1 == rs.size() ? "" : ",");
+    }
+    fprintf(fp, "],\"displayTimeUnit\":\"ms\"}\n");
+
+    fclose(fp);
+
+    return 0;
+}
+
+struct profiler_summary_row
+{
+    std::string key;
+    int count;
+    double total;
+    double min;
+    double max;
+    size_t bytes;
+};
+
+static bool profiler_summary_row_greater(const profiler_summary_row& a, const profiler_summary_row& b)
+{
+    return a.total > b.total;
+}
+
+static void fprint_summary(FILE* fp, const std::vector<ProfilerRecord>& rs)
+{
+    std::vector<profiler_summary_row> rows;
+    double total = 0;
+    for (size_t i = 0; i < rs.size(); i++)
+    {
+        const ProfilerRecord& r = rs[i];
+
+#if NCNN_STRING
+        std::string key = r.type;
+#else
+        std::string key = "layer";
+#endif // NCNN_STRING
+        if (r.kernel[0] != '\0')
+        {
+            key += "/";
+            key += r.kernel;
+        }
+
+        const double t = r.end - r.start;
+        total += t;
+
+        size_t j = 0;
+        for (; j < rows.size(); j++)
+        {
+            if (rows[j].key == key)
+                break;
+        }
+
+        if (j == rows.size())
+        {
+            profiler_summary_row row;
+            row.key = key;
+            row.count = 0;
+            row.total = 0;
+            row.min = t;
+            row.max = t;
+            row.bytes = 0;
+            rows.push_back(row);
+        }
+
+        profiler_summary_row& row = rows[j];
+        row.count++;
+        row.total += t;
+        row.min = std::min(row.min, t);
+        row.max = std::max(row.max, t);
+        row.bytes += r.bytes_allocated;
+    }
+
+    std::partial_sort(rows.begin(), rows.end(), rows.end(), profiler_summary_row_greater);
+
+    fprintf(fp, "%-40s %6s %10s %10s %10s %10s %7s %12s\n", "type/kernel", "count", "total_ms", "avg_ms", "min_ms", "max_ms", "%", "bytes");
+    for (size_t i = 0; i < rows.size(); i++)
+    {
+        const profiler_summary_row& row = rows[i];
+        fprintf(fp, "%-40s %6d %10.3f %10.3f %10.3f %10.3f %6.2f%% %12lu\n", row.key.c_str(), row.count, row.total, row.total / row.count, row.min, row.max, total > 0 ? row.total * 100 / total : 0.0, (unsigned long)row.bytes);
+    }
+    fprintf(fp, "%-40s %6d %10.3f\n", "total", (int)rs.size(), total);
+}
+
+int Profiler::save_summary(const char* path) const
+{
+    FILE* fp = fopen(path, "wb");
+    if (!fp)
+    {
+        NCNN_LOGE("fopen %s failed", path);
+        return -1;
+    }
+
+    fprint_summary(fp, records());
+
+    fclose(fp);
+
+    return 0;
+}
+
+void Profiler::print_summary() const
+{
+    fprint_summary(stderr, records());
+}
+#endif // NCNN_STDIO
+
+} // namespace ncnn
@@ -0,0 +1,112 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef NCNN_PROFILER_H
+#define NCNN_PROFILER_H
+
+#include "platform.h"
+
+#include "mat.h"
+
+namespace ncnn {
+
+class Layer;
+
+// timing of one layer forward
+class NCNN_EXPORT ProfilerRecord
+{
+public:
+    ProfilerRecord();
+
+    int layer_index;
+#if NCNN_STRING
+    std::string type;
+    std::string name;
+#endif // NCNN_STRING
+
+    // kernel path reported by the layer, like winograd43 or im2col_gemm
+    // reported by the x86 Convolution, ConvolutionDepthWise, InnerProduct and Gemm
+    // a composite layer shows the first kernel of its sub-layers
+    // empty if the layer does not report one, as all layers on other architectures
+    const char* kernel;
+
+    // milliseconds since the profiler was created or cleared
+    double start;
+    double end;
+
+    // index of the thread running the layer, 0 for the first seen
+    int thread;
+
+    // shapes only, carrying dims w h d c elempack elemsize
+    std::vector<Mat> bottom_shapes;
+    std::vector<Mat> top_shapes;
+
+    // bytes of the top blobs produced by the layer, inplace outputs excluded
+    size_t bytes_allocated;
+
+    // bottom blob data before forward, for telling inplace outputs apart
+    std::vector<const void*> bottom_datas;
+};
+
+// runtime per-layer profiler
+// attach it with Extractor::set_profiler() or Option::profiler
+// the network records every layer forward into it, layers report their kernel path
+// one profiler could be shared by concurrently running extractors
+class ProfilerPrivate;
+class NCNN_EXPORT Profiler
+{
+public:
+    Profiler();
+    virtual ~Profiler();
+
+    // drop all records and restart the clock
+    void clear();
+
+    // records in completion order
+    std::vector<ProfilerRecord> records() const;
+
+    // called by the network around each layer forward
+    ProfilerRecord* begin_layer(const Layer* layer, int layer_index, const std::vector<Mat>& blob_mats);
+    void end_layer(ProfilerRecord* record, const Layer* layer, const std::vector<Mat>& blob_mats);
+
+    // called by layers inside forward to report the chosen kernel path
+    // only the first report of one layer forward is kept
+    // kernel must be a string literal
+    void note_kernel(const char* kernel);
+
+#if NCNN_STDIO
+    // write all records as chrome trace event json
+    // open it in chrome://tracing or https://ui.perfetto.dev
+    // return 0 if success
+    int save_chrome_trace(const char* path) const;
+
+    // write the time aggregated by layer type and kernel path as text table
+    // return 0 if success
+    int save_summary(const char* path) const;
+
+    // print the aggregated table to stderr
+    void print_summary() const;
+#endif // NCNN_STDIO
+
+private:
+    Profiler(const Profiler&);
+    Profiler& operator=(const Profiler&);
+
+private:
+    ProfilerPrivate* const d;
+};
+
+} // namespace ncnn
+
+#endif // NCNN_PROFILER_H
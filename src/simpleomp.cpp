@@ -17,13 +17,15 @@
 #if NCNN_SIMPLEOMP
 
 #include "simpleomp.h"
-#include "cpu.h" // ncnn::get_cpu_count()
+#include "benchmark.h" // ncnn::get_current_time()
+#include "cpu.h"       // ncnn::get_cpu_count()
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdint.h>
 #include <stdarg.h>
+#include <sched.h>
 
 #if __clang__
 extern "C" typedef void (*kmpc_micro)(int32_t* gtid, int32_t* tid, ...);
@@ -74,10 +76,10 @@ static void* kmp_threadfunc(void* args);
 
 namespace ncnn {
 
-class KMPTask
+// one parallel region
+class KMPTeam
 {
 public:
-    // per-team
 #if __clang__
     // libomp abi
     kmpc_micro fn;
@@ -90,214 +92,249 @@ public:
 #endif
     int num_threads;
 
-    // per-task
-    int thread_num;
+    // thread numbers not owned by any worker, taken by whoever is free first
+    int next_thread_num;
 
     // finish status
-    int* num_threads_to_wait;
-    Mutex* finish_lock;
-    ConditionVariable* finish_condition;
+    int num_workers_left;
+    int master_parked;
+    Mutex finish_lock;
+    ConditionVariable finish_condition;
+};
+
+// pooled worker thread with a single slot mailbox
+class KMPWorker
+{
+public:
+    // owned by a master that is dispatching a team
+    int claimed;
+
+    // the team to join and the thread number to run first
+    KMPTeam* team;
+    int thread_num;
+
+    // sleeping on condition after blocktime spinning
+    int parked;
+    Mutex lock;
+    ConditionVariable condition;
+
+    int tid;
+    Thread* thread;
 };
 
-class KMPTaskQueue
+class KMPGlobal
 {
 public:
-    KMPTaskQueue(int _max_size)
+    KMPGlobal()
     {
-        max_size = _max_size;
-        tasks = new KMPTask*[max_size];
-        size = 0;
-        front = 0;
-        back = 0;
+        kmp_max_threads = 0;
+        kmp_workers = 0;
+        kmp_blocktime = 0;
     }
 
-    ~KMPTaskQueue()
+    ~KMPGlobal()
     {
-        delete[] tasks;
+        deinit();
     }
 
-    void dispatch(KMPTask* v, int n)
+    void try_init()
     {
-        lock.lock();
+        pthread_once(&is_initialized, init_g_kmp_global);
+    }
 
-        if (size + n > max_size)
-        {
-            lock.unlock();
+public:
+    static pthread_once_t is_initialized;
 
-            for (int i = 0; i < n; i++)
-            {
-                put(&v[i]);
-            }
-            return;
-        }
+    void init();
 
-        for (int i = 0; i < n; i++)
-        {
-            tasks[back] = &v[i];
-            back++;
-            if (back == max_size)
-                back = 0;
-        }
+    void deinit();
 
-        size += n;
+public:
+    int kmp_max_threads;
+    KMPWorker* kmp_workers;
 
-        lock.unlock();
+    // milliseconds to spin before sleeping
+    int kmp_blocktime;
+};
 
-        condition.signal();
-    }
+} // namespace ncnn
+
+pthread_once_t ncnn::KMPGlobal::is_initialized = PTHREAD_ONCE_INIT;
+
+static ncnn::KMPGlobal g_kmp_global;
+
+static ncnn::ThreadLocalStorage tls_num_threads;
+static ncnn::ThreadLocalStorage tls_thread_num;
+
+static void init_g_kmp_global()
+{
+    g_kmp_global.init();
+}
+
+// the llvm and gnu openmp abi imply gcc or clang, so the __atomic builtins are always there
+static inline int kmp_atomic_load(const int* ptr)
+{
+    return __atomic_load_n(ptr, __ATOMIC_SEQ_CST);
+}
+
+static inline void kmp_atomic_store(int* ptr, int value)
+{
+    __atomic_store_n(ptr, value, __ATOMIC_SEQ_CST);
+}
+
+static inline int kmp_atomic_fetch_add(int* ptr, int delta)
+{
+    return __atomic_fetch_add(ptr, delta, __ATOMIC_SEQ_CST);
+}
 
-    void put(KMPTask* v)
+static inline bool kmp_atomic_cas(int* ptr, int expected, int desired)
+{
+    return __atomic_compare_exchange_n(ptr, &expected, desired, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+}
+
+static inline void kmp_cpu_relax()
+{
+#if defined(__i386__) || defined(__x86_64__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || (defined(__arm__) && __ARM_ARCH >= 7)
+    asm volatile("yield" ::
+                     : "memory");
+#endif
+}
+
+// spin until pred is true or blocktime elapsed, return true if pred became true
+template<typename Pred>
+static bool kmp_spin_wait(const Pred& pred)
+{
+    const int blocktime = kmp_atomic_load(&g_kmp_global.kmp_blocktime);
+    if (blocktime <= 0)
+        return pred();
+
+    double start = ncnn::get_current_time();
+    for (int i = 1;; i++)
     {
-        lock.lock();
-        while (size >= max_size)
+        if (pred())
+            return true;
+
+        kmp_cpu_relax();
+
+        // the clock is expensive compared to the pause
+        if (i % 1024 == 0)
         {
-            condition.wait(lock);
+            if (ncnn::get_current_time() - start >= blocktime)
+                return pred();
+
+            // let the thread we wait for run when cores are oversubscribed
+            sched_yield();
         }
-        tasks[back] = v;
-        back++;
-        if (back == max_size)
-            back = 0;
-        size++;
-        lock.unlock();
-
-        condition.signal();
     }
+}
 
-    void get(KMPTask*& v)
+struct kmp_worker_has_team
+{
+    const ncnn::KMPWorker* worker;
+    bool operator()() const
     {
-        lock.lock();
-        while (size == 0)
-        {
-            condition.wait(lock);
-        }
-        v = tasks[front];
-        front++;
-        if (front == max_size)
-            front = 0;
-        size--;
-        lock.unlock();
-
-        condition.signal();
+        return __atomic_load_n(&worker->team, __ATOMIC_SEQ_CST) != 0;
     }
-
-private:
-    Mutex lock;
-    ConditionVariable condition;
-
-    // ring buffer queue
-    int max_size;
-    KMPTask** tasks;
-    int size;
-    int front;
-    int back;
 };
 
-class KMPGlobal
+struct kmp_team_workers_left
 {
-public:
-    KMPGlobal()
+    ncnn::KMPTeam* team;
+    int num_workers;
+    bool operator()() const
     {
-        kmp_max_threads = 0;
-        kmp_threads = 0;
-        kmp_threads_tid = 0;
-        kmp_task_queue = 0;
+        return kmp_atomic_load(&team->num_workers_left) == num_workers;
     }
+};
 
-    ~KMPGlobal()
+static void kmp_worker_post(ncnn::KMPWorker* worker, ncnn::KMPTeam* team, int thread_num)
+{
+    worker->thread_num = thread_num;
+    __atomic_store_n(&worker->team, team, __ATOMIC_SEQ_CST);
+
+    // pairs with the parked store and team load in kmp_worker_wait
+    if (kmp_atomic_load(&worker->parked))
     {
-        deinit();
+        worker->lock.lock();
+        worker->condition.signal();
+        worker->lock.unlock();
     }
+}
 
-    void try_init()
+static ncnn::KMPTeam* kmp_worker_wait(ncnn::KMPWorker* worker)
+{
+    kmp_worker_has_team has_team = {worker};
+    if (!kmp_spin_wait(has_team))
     {
-        pthread_once(&is_initialized, init_g_kmp_global);
+        worker->lock.lock();
+        kmp_atomic_store(&worker->parked, 1);
+        while (!has_team())
+        {
+            worker->condition.wait(worker->lock);
+        }
+        kmp_atomic_store(&worker->parked, 0);
+        worker->lock.unlock();
     }
 
-public:
-    static pthread_once_t is_initialized;
-
-    void init()
-    {
-        // NCNN_LOGE("KMPGlobal init");
-        kmp_max_threads = ncnn::get_cpu_count();
+    return __atomic_exchange_n(&worker->team, (ncnn::KMPTeam*)0, __ATOMIC_SEQ_CST);
+}
 
-        kmp_task_queue = new ncnn::KMPTaskQueue(std::max(kmp_max_threads * 4, 16));
+void ncnn::KMPGlobal::init()
+{
+    // NCNN_LOGE("KMPGlobal init");
+    kmp_max_threads = ncnn::get_cpu_count();
 
-        if (kmp_max_threads > 1)
+    if (kmp_max_threads > 1)
+    {
+        kmp_workers = new ncnn::KMPWorker[kmp_max_threads - 1];
+        for (int i = 0; i < kmp_max_threads - 1; i++)
         {
-            kmp_threads = new ncnn::Thread*[kmp_max_threads - 1];
-            kmp_threads_tid = new int[kmp_max_threads - 1];
-            for (int i = 0; i < kmp_max_threads - 1; i++)
-            {
-                kmp_threads_tid[i] = i + 1;
-                kmp_threads[i] = new ncnn::Thread(kmp_threadfunc, (void*)&kmp_threads_tid[i]);
-            }
+            ncnn::KMPWorker& worker = kmp_workers[i];
+            worker.claimed = 0;
+            worker.team = 0;
+            worker.thread_num = 0;
+            worker.parked = 0;
+            worker.tid = i + 1;
+            worker.thread = new ncnn::Thread(kmp_threadfunc, (void*)&worker);
         }
     }
+}
 
-    void deinit()
+void ncnn::KMPGlobal::deinit()
+{
+    // NCNN_LOGE("KMPGlobal deinit");
+    if (kmp_max_threads > 1)
     {
-        // NCNN_LOGE("KMPGlobal deinit");
-        if (kmp_max_threads > 1)
+        // null fn tells workers to exit
+        ncnn::KMPTeam quit_team;
+        quit_team.fn = 0;
+        quit_team.num_threads = 0;
+
+        for (int i = 0; i < kmp_max_threads - 1; i++)
         {
-            // TODO portable stack allocation
-            ncnn::KMPTask* tasks = (ncnn::KMPTask*)alloca((kmp_max_threads - 1) * sizeof(ncnn::KMPTask));
-            for (int i = 0; i < kmp_max_threads - 1; i++)
+            ncnn::KMPWorker& worker = kmp_workers[i];
+            while (!kmp_atomic_cas(&worker.claimed, 0, 1))
             {
-#if __clang__
-                tasks[i].fn = 0;
-                tasks[i].argc = 0;
-                tasks[i].argv = (void**)0;
-#else
-                tasks[i].fn = 0;
-                tasks[i].data = 0;
-#endif
-                tasks[i].num_threads = kmp_max_threads;
-                tasks[i].thread_num = i + 1;
-                tasks[i].num_threads_to_wait = 0;
-                tasks[i].finish_lock = 0;
-                tasks[i].finish_condition = 0;
+                kmp_cpu_relax();
             }
 
-            // dispatch 1 ~ kmp_max_threads
-            kmp_task_queue->dispatch(tasks, kmp_max_threads - 1);
+            kmp_worker_post(&worker, &quit_team, 0);
+        }
 
-            for (int i = 0; i < kmp_max_threads - 1; i++)
-            {
+        for (int i = 0; i < kmp_max_threads - 1; i++)
+        {
 #ifndef __EMSCRIPTEN__
-                // FIXME emscripten complains
-                // pthread_join attempted on thread 12345678,
-                // which does not point to a valid thread, or does not exist anymore!
-                kmp_threads[i]->join();
+            // FIXME emscripten complains
+            // pthread_join attempted on thread 12345678,
+            // which does not point to a valid thread, or does not exist anymore!
+            kmp_workers[i].thread->join();
 #endif
-                delete kmp_threads[i];
-            }
-            delete[] kmp_threads;
-            delete[] kmp_threads_tid;
+            delete kmp_workers[i].thread;
         }
-
-        delete kmp_task_queue;
+        delete[] kmp_workers;
     }
-
-public:
-    int kmp_max_threads;
-    ncnn::Thread** kmp_threads;
-    int* kmp_threads_tid;
-    ncnn::KMPTaskQueue* kmp_task_queue;
-};
-
-} // namespace ncnn
-
-pthread_once_t ncnn::KMPGlobal::is_initialized = PTHREAD_ONCE_INIT;
-
-static ncnn::KMPGlobal g_kmp_global;
-
-static ncnn::ThreadLocalStorage tls_num_threads;
-static ncnn::ThreadLocalStorage tls_thread_num;
-
-static void init_g_kmp_global()
-{
-    g_kmp_global.init();
 }
 
 #ifdef __cplusplus
@@ -334,17 +371,18 @@ int omp_get_thread_num()
     return (int)reinterpret_cast<size_t>(tls_thread_num.get());
 }
 
-#if __clang__
 int kmp_get_blocktime()
 {
-    return 0;
+    return kmp_atomic_load(&g_kmp_global.kmp_blocktime);
 }
 
-void kmp_set_blocktime(int /*blocktime*/)
+void kmp_set_blocktime(int blocktime)
 {
-    // always passive, ignore
+    // shared by the whole pool
+    kmp_atomic_store(&g_kmp_global.kmp_blocktime, std::max(blocktime, 0));
 }
 
+#if __clang__
 static int kmp_invoke_microtask(kmpc_micro fn, int gtid, int tid, int argc, void** argv)
 {
     // fprintf(stderr, "__kmp_invoke_microtask %d %d %d\n", gtid, tid, argc);
@@ -456,43 +494,114 @@ static int kmp_invoke_microtask(kmpc_micro fn, int gtid, int tid, int argc, void
 }
 #endif // __clang__
 
-static void* kmp_threadfunc(void* args)
+static void kmp_team_invoke(ncnn::KMPTeam* team, int thread_num, int tid)
 {
+    tls_num_threads.set(reinterpret_cast<void*>((size_t)team->num_threads));
+    tls_thread_num.set(reinterpret_cast<void*>((size_t)thread_num));
+
 #if __clang__
-    int tid = *(int*)args;
+    kmp_invoke_microtask(team->fn, thread_num, tid, team->argc, team->argv);
 #else
-    (void)args;
+    (void)tid;
+    team->fn(team->data);
 #endif
+}
 
+static void kmp_team_run(ncnn::KMPTeam* team, int thread_num, int tid)
+{
+    // own thread number first, so that every participant gets a distinct one
+    if (thread_num >= 0)
+        kmp_team_invoke(team, thread_num, tid);
+
+    // then steal the ones no worker was available for
     for (;;)
     {
-        ncnn::KMPTask* task;
-        g_kmp_global.kmp_task_queue->get(task);
+        int next_thread_num = kmp_atomic_fetch_add(&team->next_thread_num, 1);
+        if (next_thread_num >= team->num_threads)
+            break;
+
+        kmp_team_invoke(team, next_thread_num, tid);
+    }
+}
+
+static void kmp_team_leave(ncnn::KMPTeam* team)
+{
+    // the team lives on the master stack, nothing may touch it after unlock
+    team->finish_lock.lock();
+    kmp_atomic_fetch_add(&team->num_workers_left, 1);
+    if (team->master_parked)
+    {
+        team->finish_condition.signal();
+    }
+    team->finish_lock.unlock();
+}
+
+// claim idle workers without blocking, fewer than requested when other teams are running
+static int kmp_team_dispatch(ncnn::KMPTeam* team, ncnn::KMPWorker** workers)
+{
+    const int max_workers = team->num_threads - 1;
+
+    int num_workers = 0;
+    for (int i = 0; i < g_kmp_global.kmp_max_threads - 1 && num_workers < max_workers; i++)
+    {
+        ncnn::KMPWorker* worker = &g_kmp_global.kmp_workers[i];
+        if (kmp_atomic_load(&worker->claimed) || !kmp_atomic_cas(&worker->claimed, 0, 1))
+            continue;
+
+        workers[num_workers] = worker;
+        num_workers++;
+    }
 
-        // fprintf(stderr, "get %d\n", tid);
+    // thread 0 is the master, 1 ~ num_workers go to the workers, the rest are stolen
+    team->next_thread_num = num_workers + 1;
+    team->num_workers_left = 0;
+    team->master_parked = 0;
 
-        if (!task->fn)
+    for (int i = 0; i < num_workers; i++)
+    {
+        kmp_worker_post(workers[i], team, i + 1);
+    }
+
+    return num_workers;
+}
+
+static void kmp_team_join(ncnn::KMPTeam* team, int num_workers)
+{
+    if (num_workers == 0)
+        return;
+
+    kmp_team_workers_left workers_left = {team, num_workers};
+    kmp_spin_wait(workers_left);
+
+    // always take the lock, a worker may still be inside kmp_team_leave
+    team->finish_lock.lock();
+    team->master_parked = 1;
+    while (!workers_left())
+    {
+        team->finish_condition.wait(team->finish_lock);
+    }
+    team->finish_lock.unlock();
+}
+
+static void* kmp_threadfunc(void* args)
+{
+    ncnn::KMPWorker* worker = (ncnn::KMPWorker*)args;
+
+    for (;;)
+    {
+        ncnn::KMPTeam* team = kmp_worker_wait(worker);
+
+        // fprintf(stderr, "get %d\n", worker->tid);
+
+        if (!team->fn)
             break;
 
-        tls_num_threads.set(reinterpret_cast<void*>((size_t)task->num_threads));
-        tls_thread_num.set(reinterpret_cast<void*>((size_t)task->thread_num));
+        kmp_team_run(team, worker->thread_num, worker->tid);
 
-#if __clang__
-        kmp_invoke_microtask(task->fn, task->thread_num, tid, task->argc, task->argv);
-#else
-        task->fn(task->data);
-#endif
+        kmp_team_leave(team);
 
-        // update finished
-        {
-            task->finish_lock->lock();
-            *task->num_threads_to_wait = *task->num_threads_to_wait - 1;
-            if (*task->num_threads_to_wait == 0)
-            {
-                task->finish_condition->signal();
-            }
-            task->finish_lock->unlock();
-        }
+        // ready for the next team
+        kmp_atomic_store(&worker->claimed, 0);
     }
 
     // fprintf(stderr, "exit\n");
@@ -541,44 +650,25 @@ void __kmpc_fork_call(void* /*loc*/, int32_t argc, kmpc_micro fn, ...)
         return;
     }
 
-    int num_threads_to_wait = num_threads - 1;
-    ncnn::Mutex finish_lock;
-    ncnn::ConditionVariable finish_condition;
+    // nested region inside a worker keeps its outer thread number
+    void* outer_thread_num = tls_thread_num.get();
 
-    // TODO portable stack allocation
-    ncnn::KMPTask* tasks = (ncnn::KMPTask*)alloca((num_threads - 1) * sizeof(ncnn::KMPTask));
-    for (int i = 0; i < num_threads - 1; i++)
-    {
-        tasks[i].fn = fn;
-        tasks[i].argc = argc;
-        tasks[i].argv = (void**)argv;
-        tasks[i].num_threads = num_threads;
-        tasks[i].thread_num = i + 1;
-        tasks[i].num_threads_to_wait = &num_threads_to_wait;
-        tasks[i].finish_lock = &finish_lock;
-        tasks[i].finish_condition = &finish_condition;
-    }
+    ncnn::KMPTeam team;
+    team.fn = fn;
+    team.argc = argc;
+    team.argv = (void**)argv;
+    team.num_threads = num_threads;
 
-    // dispatch 1 ~ num_threads
-    g_kmp_global.kmp_task_queue->dispatch(tasks, num_threads - 1);
+    // TODO portable stack allocation
+    ncnn::KMPWorker** workers = (ncnn::KMPWorker**)alloca((num_threads - 1) * sizeof(ncnn::KMPWorker*));
+    int num_workers = kmp_team_dispatch(&team, workers);
 
-    // dispatch 0
-    {
-        tls_num_threads.set(reinterpret_cast<void*>((size_t)num_threads));
-        tls_thread_num.set(reinterpret_cast<void*>((size_t)0));
+    kmp_team_run(&team, 0, 0);
 
-        kmp_invoke_microtask(fn, 0, 0, argc, argv);
-    }
+    kmp_team_join(&team, num_workers);
 
-    // wait for finished
-    {
-        finish_lock.lock();
-        if (num_threads_to_wait != 0)
-        {
-            finish_condition.wait(finish_lock);
-        }
-        finish_lock.unlock();
-    }
+    tls_num_threads.set(reinterpret_cast<void*>((size_t)num_threads));
+    tls_thread_num.set(outer_thread_num);
 }
 
 void __kmpc_for_static_init_4(void* /*loc*/, int32_t gtid, int32_t /*sched*/, int32_t* last, int32_t* lower, int32_t* upper, int32_t* /*stride*/, int32_t /*incr*/, int32_t /*chunk*/)
@@ -656,10 +746,10 @@ static ncnn::ThreadLocalStorage tls_parallel_context;
 
 struct parallel_context
 {
-    int num_threads_to_wait;
-    ncnn::Mutex finish_lock;
-    ncnn::ConditionVariable finish_condition;
-    ncnn::KMPTask* tasks;
+    ncnn::KMPTeam team;
+    ncnn::KMPWorker** workers;
+    int num_workers;
+    void* outer_thread_num;
 };
 
 void GOMP_parallel_start(void (*fn)(void*), void* data, unsigned num_threads)
@@ -689,24 +779,16 @@ void GOMP_parallel_start(void (*fn)(void*), void* data, unsigned num_threads)
 
     tls_parallel_context.set(pc);
 
-    pc->num_threads_to_wait = num_threads - 1;
+    pc->outer_thread_num = tls_thread_num.get();
 
-    pc->tasks = new ncnn::KMPTask[num_threads - 1];
-    for (unsigned i = 0; i < num_threads - 1; i++)
-    {
-        pc->tasks[i].fn = fn;
-        pc->tasks[i].data = data;
-        pc->tasks[i].num_threads = num_threads;
-        pc->tasks[i].thread_num = i + 1;
-        pc->tasks[i].num_threads_to_wait = &pc->num_threads_to_wait;
-        pc->tasks[i].finish_lock = &pc->finish_lock;
-        pc->tasks[i].finish_condition = &pc->finish_condition;
-    }
+    pc->team.fn = fn;
+    pc->team.data = data;
+    pc->team.num_threads = num_threads;
 
-    // dispatch 1 ~ num_threads
-    g_kmp_global.kmp_task_queue->dispatch(pc->tasks, num_threads - 1);
+    pc->workers = new ncnn::KMPWorker*[num_threads - 1];
+    pc->num_workers = kmp_team_dispatch(&pc->team, pc->workers);
 
-    // dispatch 0
+    // the caller runs thread 0 until GOMP_parallel_end
     {
         tls_num_threads.set(reinterpret_cast<void*>((size_t)num_threads));
         tls_thread_num.set(reinterpret_cast<void*>((size_t)0));
@@ -719,17 +801,17 @@ void GOMP_parallel_end()
     parallel_context* pc = (parallel_context*)tls_parallel_context.get();
     tls_parallel_context.set(0);
 
-    // wait for finished
-    {
-        pc->finish_lock.lock();
-        if (pc->num_threads_to_wait != 0)
-        {
-            pc->finish_condition.wait(pc->finish_lock);
-        }
-        pc->finish_lock.unlock();
-    }
+    if (!pc)
+        return;
+
+    kmp_team_run(&pc->team, -1, 0);
+
+    kmp_team_join(&pc->team, pc->num_workers);
+
+    tls_num_threads.set(reinterpret_cast<void*>((size_t)pc->team.num_threads));
+    tls_thread_num.set(pc->outer_thread_num);
 
-    delete[] pc->tasks;
+    delete[] pc->workers;
     delete pc;
 }
 
@@ -756,46 +838,28 @@ void GOMP_parallel(void (*fn)(void*), void* data, unsigned num_threads, unsigned
         return;
     }
 
-    int num_threads_to_wait = num_threads - 1;
-    ncnn::Mutex finish_lock;
-    ncnn::ConditionVariable finish_condition;
+    // nested region inside a worker keeps its outer thread number
+    void* outer_thread_num = tls_thread_num.get();
+
+    ncnn::KMPTeam team;
+    team.fn = fn;
+    team.data = data;
+    team.num_threads = num_threads;
 
     // TODO portable stack allocation
-    ncnn::KMPTask* tasks = (ncnn::KMPTask*)alloca((num_threads - 1) * sizeof(ncnn::KMPTask));
-    for (unsigned i = 0; i < num_threads - 1; i++)
-    {
-        tasks[i].fn = fn;
-        tasks[i].data = data;
-        tasks[i].num_threads = num_threads;
-        tasks[i].thread_num = i + 1;
-        tasks[i].num_threads_to_wait = &num_threads_to_wait;
-        tasks[i].finish_lock = &finish_lock;
-        tasks[i].finish_condition = &finish_condition;
-    }
+    ncnn::KMPWorker** workers = (ncnn::KMPWorker**)alloca((num_threads - 1) * sizeof(ncnn::KMPWorker*));
+    int num_workers = kmp_team_dispatch(&team, workers);
 
-    // dispatch 1 ~ num_threads
-    g_kmp_global.kmp_task_queue->dispatch(tasks, num_threads - 1);
+    kmp_team_run(&team, 0, 0);
 
-    // dispatch 0
-    {
-        tls_num_threads.set(reinterpret_cast<void*>((size_t)num_threads));
-        tls_thread_num.set(reinterpret_cast<void*>((size_t)0));
+    kmp_team_join(&team, num_workers);
 
-        fn(data);
-    }
-
-    // wait for finished
-    {
-        finish_lock.lock();
-        if (num_threads_to_wait != 0)
-        {
-            finish_condition.wait(finish_lock);
-        }
-        finish_lock.unlock();
-    }
+    tls_num_threads.set(reinterpret_cast<void*>((size_t)num_threads));
+    tls_thread_num.set(outer_thread_num);
 }
 #endif // __clang__
 
+
 #ifdef __cplusplus
 } // extern "C"
 #endif
@@ -0,0 +1,174 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "allocator.h"
+
+#include <stdio.h>
+#include <string.h>
+
+struct AllocatorTestArgs
+{
+    ncnn::SizeClassPoolAllocator* allocator;
+    int seed;
+    int malloc_count;
+    int errors;
+
+    // blocks handed over to the next thread for freeing
+    void* handover[64];
+};
+
+static void* allocator_test_thread(void* _args)
+{
+    AllocatorTestArgs* args = (AllocatorTestArgs*)_args;
+
+    unsigned int seed = args->seed;
+
+    for (int i = 0; i < 200; i++)
+    {
+        void* ptrs[16];
+        size_t sizes[16];
+        for (int j = 0; j < 16; j++)
+        {
+            seed = seed * 1664525 + 1013904223;
+            sizes[j] = 1 + (seed >> 8) % (1 << (4 + j));
+            ptrs[j] = args->allocator->fastMalloc(sizes[j]);
+            args->malloc_count++;
+
+            if (!ptrs[j] || (size_t)ptrs[j] % NCNN_MALLOC_ALIGN != 0)
+            {
+                args->errors++;
+                return 0;
+            }
+
+            memset(ptrs[j], j, sizes[j]);
+        }
+
+        for (int j = 15; j >= 0; j--)
+        {
+            const unsigned char* p = (const unsigned char*)ptrs[j];
+            if (p[0] != j || p[sizes[j] - 1] != j)
+                args->errors++;
+
+            args->allocator->fastFree(ptrs[j]);
+        }
+    }
+
+    for (int i = 0; i < 64; i++)
+    {
+        args->handover[i] = args->allocator->fastMalloc(4096 * (i + 1));
+        args->malloc_count++;
+    }
+
+    return 0;
+}
+
+static void* allocator_test_free_thread(void* _args)
+{
+    AllocatorTestArgs* args = (AllocatorTestArgs*)_args;
+
+    for (int i = 0; i < 64; i++)
+    {
+        args->allocator->fastFree(args->handover[i]);
+    }
+
+    return 0;
+}
+
+static int test_allocator_sizeclass()
+{
+    ncnn::SizeClassPoolAllocator allocator;
+
+    const int thread_count = 4;
+
+    AllocatorTestArgs args[thread_count];
+    ncnn::Thread* threads[thread_count];
+
+    for (int i = 0; i < thread_count; i++)
+    {
+        args[i].allocator = &allocator;
+        args[i].seed = 7767517 + i;
+        args[i].malloc_count = 0;
+        args[i].errors = 0;
+        threads[i] = new ncnn::Thread(allocator_test_thread, &args[i]);
+    }
+
+    for (int i = 0; i < thread_count; i++)
+    {
+        threads[i]->join();
+        delete threads[i];
+    }
+
+    // free in another thread than the one allocated
+    for (int i = 0; i < thread_count; i++)
+    {
+        threads[i] = new ncnn::Thread(allocator_test_free_thread, &args[(i + 1) % thread_count]);
+    }
+
+    for (int i = 0; i < thread_count; i++)
+    {
+        threads[i]->join();
+        delete threads[i];
+    }
+
+    int errors = 0;
+    size_t malloc_count = 0;
+    for (int i = 0; i < thread_count; i++)
+    {
+        errors += args[i].errors;
+        malloc_count += args[i].malloc_count;
+    }
+
+    if (errors != 0)
+    {
+        fprintf(stderr, "test_allocator_sizeclass corrupted %d\n", errors);
+        return -1;
+    }
+
+    if (allocator.hit_count() + allocator.miss_count() != malloc_count)
+    {
+        fprintf(stderr, "test_allocator_sizeclass hit %lu + miss %lu != %lu\n", (unsigned long)allocator.hit_count(), (unsigned long)allocator.miss_count(), (unsigned long)malloc_count);
+        return -1;
+    }
+
+    if (allocator.bytes_in_use() != 0)
+    {
+        fprintf(stderr, "test_allocator_sizeclass bytes_in_use %lu\n", (unsigned long)allocator.bytes_in_use());
+        return -1;
+    }
+
+    if (allocator.hit_count() == 0 || allocator.bytes_cached() == 0)
+    {
+        fprintf(stderr, "test_allocator_sizeclass nothing reused\n");
+        return -1;
+    }
+
+    allocator.clear();
+
+    if (allocator.bytes_cached() != 0)
+    {
+        fprintf(stderr, "test_allocator_sizeclass bytes_cached %lu after clear\n", (unsigned long)allocator.bytes_cached());
+        return -1;
+    }
+
+    // zero sized requests still get the smallest class
+    void* ptr = allocator.fastMalloc(0);
+    allocator.fastFree(ptr);
+
+    return 0;
+}
+
+int main()
+{
+    return test_allocator_sizeclass();
+}
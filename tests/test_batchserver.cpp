@@ -0,0 +1,190 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "batchserver.h"
+#include "datareader.h"
+#include "net.h"
+#include "testutil.h"
+
+#include <stdio.h>
+
+#if NCNN_THREADS
+
+class DataReaderFromRandom : public ncnn::DataReader
+{
+public:
+    virtual size_t read(void* buf, size_t size) const
+    {
+        // weights as small floats, flags as zero
+        float* p = (float*)buf;
+        for (size_t i = 0; i < size / sizeof(float); i++)
+        {
+            p[i] = i == 0 ? 0.f : RandomFloat(-0.1f, 0.1f);
+        }
+        return size;
+    }
+};
+
+struct Request
+{
+    ncnn::Mat in;
+    ncnn::Mat expect;
+    ncnn::Mat out;
+    int ret;
+};
+
+struct Results
+{
+    ncnn::Mutex lock;
+    ncnn::ConditionVariable cond;
+    int done_count;
+};
+
+struct Submission
+{
+    Request* request;
+    Results* results;
+};
+
+static void on_done(int ret, const ncnn::Mat& feat, void* userdata)
+{
+    Submission* s = (Submission*)userdata;
+
+    s->results->lock.lock();
+    s->request->ret = ret;
+    s->request->out = feat;
+    s->results->done_count++;
+    s->results->cond.signal();
+    s->results->lock.unlock();
+}
+
+static int test_batchserver(int max_batch_size, double max_delay, int worker_count)
+{
+    static const char* param = "7767517\n"
+                               "3 3\n"
+                               "Input data 0 1 data\n"
+                               "Convolution conv 1 1 data conv 0=16 1=3 4=1 5=1 6=2304\n"
+                               "ReLU relu 1 1 conv out\n";
+
+    ncnn::Net net;
+    net.opt.num_threads = 1;
+
+    int ret = net.load_param_mem(param);
+    if (ret != 0)
+    {
+        fprintf(stderr, "load_param_mem failed\n");
+        return -1;
+    }
+
+    DataReaderFromRandom dr;
+    net.load_model(dr);
+
+    // two shapes interleaved, batches must not mix them
+    const int request_count = 24;
+    std::vector<Request> requests(request_count);
+    for (int i = 0; i < request_count; i++)
+    {
+        requests[i].in = i % 3 == 0 ? RandomMat(12, 10, 16) : RandomMat(16, 16, 16);
+        requests[i].ret = -1;
+
+        ncnn::Extractor ex = net.create_extractor();
+        ex.input("data", requests[i].in);
+        ex.extract("out", requests[i].expect);
+    }
+
+    ncnn::BatchServer server(&net);
+    server.set_max_batch_size(max_batch_size);
+    server.set_max_delay(max_delay);
+    server.set_worker_count(worker_count);
+    if (server.set_input_output("data", "out") != 0 || server.start() != 0)
+    {
+        fprintf(stderr, "BatchServer start failed\n");
+        return -1;
+    }
+
+    Results results;
+    results.done_count = 0;
+
+    std::vector<Submission> submissions(request_count);
+    for (int i = 0; i < request_count; i++)
+    {
+        submissions[i].request = &requests[i];
+        submissions[i].results = &results;
+        if (server.submit(requests[i].in, on_done, &submissions[i]) != 0)
+        {
+            fprintf(stderr, "BatchServer submit failed\n");
+            return -1;
+        }
+    }
+
+    results.lock.lock();
+    while (results.done_count < request_count)
+    {
+        results.cond.wait(results.lock);
+    }
+    results.lock.unlock();
+
+    for (int i = 0; i < request_count; i++)
+    {
+        if (requests[i].ret != 0 || CompareMat(requests[i].out, requests[i].expect, 0.001) != 0)
+        {
+            fprintf(stderr, "test_batchserver failed max_batch_size=%d max_delay=%f worker_count=%d request %d\n", max_batch_size, max_delay, worker_count, i);
+            return -1;
+        }
+    }
+
+    // blocking run
+    ncnn::Mat out;
+    ret = server.run(requests[0].in, out);
+    if (ret != 0 || CompareMat(out, requests[0].expect, 0.001) != 0)
+    {
+        fprintf(stderr, "test_batchserver run failed\n");
+        return -1;
+    }
+
+    ncnn::BatchServerStats stats = server.stats();
+    if (stats.request_count != request_count + 1 || stats.batch_count < 2 || stats.batch_count > request_count + 1)
+    {
+        fprintf(stderr, "test_batchserver stats request_count=%d batch_count=%d\n", stats.request_count, stats.batch_count);
+        return -1;
+    }
+
+    if (stats.latency_p50 > stats.latency_p99 || stats.latency_p99 > stats.latency_max || stats.throughput <= 0)
+    {
+        fprintf(stderr, "test_batchserver stats p50=%f p99=%f max=%f throughput=%f\n", stats.latency_p50, stats.latency_p99, stats.latency_max, stats.throughput);
+        return -1;
+    }
+
+    return 0;
+}
+
+int main()
+{
+    SRAND(7767517);
+
+    return 0
+           || test_batchserver(1, 0.0, 1)
+           || test_batchserver(4, 2.0, 1)
+           || test_batchserver(8, 5.0, 2)
+           || test_batchserver(16, 100.0, 3);
+}
+
+#else // NCNN_THREADS
+
+int main()
+{
+    return 0;
+}
+
+#endif // NCNN_THREADS
@@ -340,7 +340,149 @@ static int test_c_api_2()
     return success ? 0 : -1;
 }
 
+struct async_result_t
+{
+    ncnn::Mutex lock;
+    ncnn::ConditionVariable cond;
+    int done_count;
+    int rets[4];
+    ncnn_mat_t mats[4];
+};
+
+struct async_request_t
+{
+    async_result_t* result;
+    int i;
+};
+
+static void extract_async_callback(int ret, ncnn_mat_t mat, void* userdata)
+{
+    async_request_t* request = (async_request_t*)userdata;
+    async_result_t* result = request->result;
+
+    result->lock.lock();
+    result->rets[request->i] = ret;
+    result->mats[request->i] = mat;
+    result->done_count++;
+    result->cond.signal();
+    result->lock.unlock();
+}
+
+static int test_c_api_3()
+{
+    // datareader from empty
+    ncnn_datareader_t emptydr = ncnn_datareader_create();
+    {
+        emptydr->read = emptydr_read;
+    }
+
+    ncnn_option_t opt = ncnn_option_create();
+    {
+        ncnn_option_set_num_threads(opt, 1);
+    }
+
+    ncnn_net_t net = ncnn_net_create();
+    {
+        ncnn_net_set_option(net, opt);
+
+        ncnn_net_register_custom_layer_by_type(net, "MyLayer", mylayer_creator, mylayer_destroyer, 0);
+
+        const char param_txt[] = "7767517\n2 2\nInput input 0 1 data\nMyLayer mylayer 1 1 data output\n";
+
+        ncnn_net_load_param_memory(net, param_txt);
+        ncnn_net_load_model_datareader(net, emptydr);
+    }
+
+    async_result_t result;
+    result.done_count = 0;
+
+    // queue more requests than workers
+    ncnn_mat_t inputs[4];
+    ncnn_extractor_t exs[4];
+    async_request_t requests[4];
+    for (int i = 0; i < 4; i++)
+    {
+        inputs[i] = ncnn_mat_create_3d(4, 2, 3, NULL);
+        ncnn_mat_fill_float(inputs[i], (float)i);
+
+        result.rets[i] = -1;
+        result.mats[i] = 0;
+
+        requests[i].result = &result;
+        requests[i].i = i;
+
+        exs[i] = ncnn_extractor_create(net);
+        ncnn_extractor_input(exs[i], "data", inputs[i]);
+    }
+
+    bool success = true;
+    for (int i = 0; i < 4; i++)
+    {
+        int ret = i % 2 == 0 ? ncnn_extractor_extract_async(exs[i], "output", extract_async_callback, &requests[i])
+                  : ncnn_extractor_extract_index_async(exs[i], 1, extract_async_callback, &requests[i]);
+        if (ret != 0)
+        {
+            fprintf(stderr, "ncnn_extractor_extract_async %d failed\n", i);
+            return -1;
+        }
+    }
+
+    result.lock.lock();
+    while (result.done_count < 4)
+    {
+        result.cond.wait(result.lock);
+    }
+    result.lock.unlock();
+
+    for (int i = 0; i < 4; i++)
+    {
+        ncnn_mat_t c = result.mats[i];
+        if (result.rets[i] != 0 || !c)
+        {
+            success = false;
+            continue;
+        }
+
+        if (ncnn_mat_get_dims(c) != 3 || ncnn_mat_get_w(c) != 4 || ncnn_mat_get_h(c) != 2 || ncnn_mat_get_c(c) != 3)
+        {
+            success = false;
+            continue;
+        }
+
+        for (int q = 0; q < 3; q++)
+        {
+            const float* ptr = (const float*)ncnn_mat_get_channel_data(c, q);
+            for (int j = 0; j < 8; j++)
+            {
+                if (ptr[j] != 100.f + i)
+                    success = false;
+            }
+        }
+    }
+
+    for (int i = 0; i < 4; i++)
+    {
+        ncnn_extractor_destroy(exs[i]);
+        ncnn_mat_destroy(inputs[i]);
+        if (result.mats[i])
+            ncnn_mat_destroy(result.mats[i]);
+    }
+
+    ncnn_net_destroy(net);
+
+    ncnn_option_destroy(opt);
+
+    ncnn_datareader_destroy(emptydr);
+
+    if (!success)
+    {
+        fprintf(stderr, "test_c_api_3 failed\n");
+    }
+
+    return success ? 0 : -1;
+}
+
 int main()
 {
-    return test_c_api_0() || test_c_api_1() || test_c_api_2();
+    return test_c_api_0() || test_c_api_1() || test_c_api_2() || test_c_api_3();
 }
@@ -1,6 +1,7 @@
 #include <stdio.h>
 
 #include "cpu.h"
+#include "net.h"
 
 #if defined __ANDROID__ || defined __linux__ || defined __APPLE__
 
@@ -101,6 +102,144 @@ static int test_cpu_powersave()
     }
 }
 
+static int test_cpu_scheduler()
+{
+    const ncnn::CpuSet& mask_all = ncnn::get_cpu_thread_affinity_mask(0);
+    const int cpu_count = mask_all.num_enabled();
+
+    ncnn::CpuScheduler scheduler(mask_all);
+
+    // the first extraction takes every cpu
+    ncnn::CpuSet mask0;
+    int n0 = scheduler.acquire(mask0);
+    if (n0 != cpu_count || mask0.num_enabled() != n0)
+    {
+        fprintf(stderr, "CpuScheduler first share %d / %d, expect %d\n", n0, mask0.num_enabled(), cpu_count);
+        return 1;
+    }
+
+    // nothing idle, share one cpu
+    ncnn::CpuSet mask1;
+    int n1 = scheduler.acquire(mask1);
+    if (n1 != 1 || mask1.num_enabled() != 1)
+    {
+        fprintf(stderr, "CpuScheduler busy share %d / %d, expect 1\n", n1, mask1.num_enabled());
+        return 1;
+    }
+
+    // half of the cpus, avoiding the one still held
+    scheduler.release(mask0);
+    ncnn::CpuSet mask2;
+    int n2 = scheduler.acquire(mask2);
+    int expect2 = std::max(1, std::min(cpu_count / 2, cpu_count - 1));
+    if (n2 != expect2 || mask2.num_enabled() != n2)
+    {
+        fprintf(stderr, "CpuScheduler fair share %d / %d, expect %d\n", n2, mask2.num_enabled(), expect2);
+        return 1;
+    }
+    for (int i = 0; cpu_count > 1 && i < cpu_count; i++)
+    {
+        if (mask1.is_enabled(i) && mask2.is_enabled(i))
+        {
+            fprintf(stderr, "CpuScheduler shares overlap on cpu %d\n", i);
+            return 1;
+        }
+    }
+
+    scheduler.release(mask1);
+    scheduler.release(mask2);
+
+    // everything returned
+    ncnn::CpuSet mask3;
+    int n3 = scheduler.acquire(mask3);
+    scheduler.release(mask3);
+    if (n3 != cpu_count)
+    {
+        fprintf(stderr, "CpuScheduler share %d after release, expect %d\n", n3, cpu_count);
+        return 1;
+    }
+
+    // capped by max_threads
+    ncnn::CpuSet mask4;
+    int n4 = scheduler.acquire(mask4, 1);
+    scheduler.release(mask4);
+    if (n4 != 1 || mask4.num_enabled() != 1)
+    {
+        fprintf(stderr, "CpuScheduler share %d / %d with max_threads 1\n", n4, mask4.num_enabled());
+        return 1;
+    }
+
+    return 0;
+}
+
+static int compare_cpu_set(const ncnn::CpuSet& a, const ncnn::CpuSet& b)
+{
+    for (int i = 0; i < ncnn::get_cpu_count(); i++)
+    {
+        if (a.is_enabled(i) != b.is_enabled(i))
+            return 1;
+    }
+
+    return 0;
+}
+
+static int test_cpu_thread_affinity()
+{
+    ncnn::CpuSet prev_mask;
+    if (ncnn::get_cpu_thread_affinity(prev_mask) != 0 || prev_mask.num_enabled() == 0)
+    {
+        fprintf(stderr, "get_cpu_thread_affinity failed\n");
+        return 1;
+    }
+
+    const int prev_num_threads = ncnn::get_omp_num_threads();
+
+    int cpu = 0;
+    while (!prev_mask.is_enabled(cpu))
+        cpu++;
+
+    ncnn::CpuSet one_mask;
+    one_mask.enable(cpu);
+
+    // the extractor pins the calling thread during extract and restores it afterwards
+    ncnn::Net net;
+    net.load_param_mem("7767517\n2 2\nInput input 0 1 data\nReLU relu 1 1 data out\n");
+    net.load_model((const unsigned char*)"");
+
+    {
+        ncnn::Extractor ex = net.create_extractor();
+        ex.set_cpu_affinity(one_mask);
+
+        ncnn::Mat in(16);
+        in.fill(-1.f);
+        ex.input("data", in);
+
+        ncnn::Mat out;
+        ex.extract("out", out);
+        if (out.w != 16 || out[0] != 0.f)
+        {
+            fprintf(stderr, "extract with cpu affinity failed\n");
+            return 1;
+        }
+    }
+
+    ncnn::CpuSet mask;
+    ncnn::get_cpu_thread_affinity(mask);
+    if (compare_cpu_set(mask, prev_mask) != 0)
+    {
+        fprintf(stderr, "thread affinity %d cpus after extract, expect %d\n", mask.num_enabled(), prev_mask.num_enabled());
+        return 1;
+    }
+
+    if (ncnn::get_omp_num_threads() != prev_num_threads)
+    {
+        fprintf(stderr, "omp num threads %d after extract, expect %d\n", ncnn::get_omp_num_threads(), prev_num_threads);
+        return 1;
+    }
+
+    return 0;
+}
+
 #else
 
 static int test_cpu_info()
@@ -118,6 +257,16 @@ static int test_cpu_powersave()
     return 0;
 }
 
+static int test_cpu_scheduler()
+{
+    return 0;
+}
+
+static int test_cpu_thread_affinity()
+{
+    return 0;
+}
+
 #endif
 
 int main()
@@ -126,5 +275,7 @@ int main()
            || test_cpu_set()
            || test_cpu_info()
            || test_cpu_omp()
-           || test_cpu_powersave();
+           || test_cpu_powersave()
+           || test_cpu_scheduler()
+           || test_cpu_thread_affinity();
 }
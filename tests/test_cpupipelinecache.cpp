@@ -0,0 +1,196 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "cpupipelinecache.h"
+#include "modelbin.h"
+#include "testutil.h"
+
+static int forward_convolution(const ncnn::ParamDict& pd, const std::vector<ncnn::Mat>& weights, const ncnn::Option& opt, const ncnn::Mat& a, ncnn::Mat& b)
+{
+    ncnn::Layer* op = ncnn::create_layer_cpu("Convolution");
+
+    op->load_param(pd);
+
+    ncnn::ModelBinFromMatArray mb(&weights[0]);
+    op->load_model(mb);
+
+    int ret = op->create_pipeline(opt);
+    if (ret == 0)
+        ret = op->forward(a, b, opt);
+
+    op->destroy_pipeline(opt);
+
+    delete op;
+
+    return ret;
+}
+
+static int test_cpupipelinecache(int w, int h, int c, int outch, int kernel, int stride)
+{
+    ncnn::Mat a = RandomMat(w, h, c);
+
+    ncnn::ParamDict pd;
+    pd.set(0, outch);  // num_output
+    pd.set(1, kernel); // kernel_w
+    pd.set(3, stride); // stride_w
+    pd.set(4, kernel / 2);
+    pd.set(5, 1); // bias_term
+    pd.set(6, outch * c * kernel * kernel);
+
+    std::vector<ncnn::Mat> weights(2);
+    weights[0] = RandomMat(outch * c * kernel * kernel);
+    weights[1] = RandomMat(outch);
+
+    ncnn::Option opt;
+    opt.num_threads = 1;
+    opt.use_packing_layout = false;
+
+    const char* path = "test_cpupipelinecache.bin";
+
+    ncnn::Mat b0;
+    ncnn::Mat b1;
+    ncnn::Mat b2;
+    ncnn::Mat b3;
+    int ret = forward_convolution(pd, weights, opt, a, b0);
+
+    // transform and store
+    {
+        ncnn::CpuPipelineCache cache;
+        opt.cpu_pipeline_cache = &cache;
+
+        ret = ret || forward_convolution(pd, weights, opt, a, b1);
+        ret = ret || cache.save(path);
+
+        // the first transform misses and stores, running again hits
+        ret = ret || cache.hit_count() != 0 || cache.miss_count() != 1;
+
+        ncnn::Mat b5;
+        ret = ret || forward_convolution(pd, weights, opt, a, b5);
+        ret = ret || cache.hit_count() != 1;
+        ret = ret || CompareMat(b0, b5, 0.001);
+    }
+
+    // load back from the mapped file
+    {
+        ncnn::CpuPipelineCache cache;
+        opt.cpu_pipeline_cache = &cache;
+
+        ret = ret || cache.load(path);
+        ret = ret || forward_convolution(pd, weights, opt, a, b2);
+        ret = ret || cache.hit_count() != 1 || cache.miss_count() != 0;
+
+        // different weights must not hit
+        std::vector<ncnn::Mat> weights2(2);
+        weights2[0] = weights[0].clone();
+        weights2[0][0] += 1.f;
+        weights2[1] = weights[1];
+
+        opt.cpu_pipeline_cache = 0;
+        ncnn::Mat b4;
+        ret = ret || forward_convolution(pd, weights2, opt, a, b4);
+
+        opt.cpu_pipeline_cache = &cache;
+        ret = ret || forward_convolution(pd, weights2, opt, a, b3);
+        ret = ret || cache.hit_count() != 1 || cache.miss_count() != 1;
+
+        ret = ret || CompareMat(b3, b4, 0.001);
+    }
+
+    remove(path);
+
+    if (ret != 0 || CompareMat(b0, b1, 0.001) != 0 || CompareMat(b0, b2, 0.001) != 0)
+    {
+        fprintf(stderr, "test_cpupipelinecache failed w=%d h=%d c=%d outch=%d kernel=%d stride=%d\n", w, h, c, outch, kernel, stride);
+        return -1;
+    }
+
+    return 0;
+}
+
+#if NCNN_BF16
+static int test_cpupipelinecache_bf16(int w, int h, int c, int outch, int kernel, int stride)
+{
+    ncnn::Mat a;
+    ncnn::cast_float32_to_bfloat16(RandomMat(w, h, c), a);
+
+    ncnn::ParamDict pd;
+    pd.set(0, outch);  // num_output
+    pd.set(1, kernel); // kernel_w
+    pd.set(3, stride); // stride_w
+    pd.set(4, kernel / 2);
+    pd.set(5, 1); // bias_term
+    pd.set(6, outch * c * kernel * kernel);
+
+    std::vector<ncnn::Mat> weights(2);
+    weights[0] = RandomMat(outch * c * kernel * kernel);
+    weights[1] = RandomMat(outch);
+
+    ncnn::Option opt;
+    opt.num_threads = 1;
+    opt.use_packing_layout = false;
+    opt.use_bf16_storage = true;
+
+    ncnn::Mat b0;
+    ncnn::Mat b1;
+    ncnn::Mat b2;
+    int ret = forward_convolution(pd, weights, opt, a, b0);
+
+    // bf16 storage shares the fp32 transformed weights, so it goes through the cache too
+    {
+        ncnn::CpuPipelineCache cache;
+        opt.cpu_pipeline_cache = &cache;
+
+        ret = ret || forward_convolution(pd, weights, opt, a, b1);
+        ret = ret || cache.hit_count() != 0 || cache.miss_count() != 1;
+
+        ret = ret || forward_convolution(pd, weights, opt, a, b2);
+        ret = ret || cache.hit_count() != 1 || cache.miss_count() != 1;
+    }
+
+    if (ret == 0)
+    {
+        ncnn::Mat c0;
+        ncnn::Mat c1;
+        ncnn::Mat c2;
+        ncnn::cast_bfloat16_to_float32(b0, c0);
+        ncnn::cast_bfloat16_to_float32(b1, c1);
+        ncnn::cast_bfloat16_to_float32(b2, c2);
+        ret = CompareMat(c0, c1, 0.001) || CompareMat(c0, c2, 0.001);
+    }
+
+    if (ret != 0)
+    {
+        fprintf(stderr, "test_cpupipelinecache_bf16 failed w=%d h=%d c=%d outch=%d kernel=%d stride=%d\n", w, h, c, outch, kernel, stride);
+        return -1;
+    }
+
+    return 0;
+}
+#endif // NCNN_BF16
+
+int main()
+{
+    SRAND(7767517);
+
+    return 0
+           || test_cpupipelinecache(13, 11, 16, 24, 3, 1)
+           || test_cpupipelinecache(13, 11, 16, 24, 1, 1)
+           || test_cpupipelinecache(13, 11, 3, 4, 3, 2)
+           || test_cpupipelinecache(13, 11, 32, 40, 3, 1)
+#if NCNN_BF16
+           || test_cpupipelinecache_bf16(13, 11, 16, 24, 3, 1)
+           || test_cpupipelinecache_bf16(13, 11, 16, 24, 1, 1)
+#endif
+           ;
+}
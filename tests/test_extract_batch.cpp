@@ -0,0 +1,184 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "benchmark.h"
+#include "datareader.h"
+#include "net.h"
+#include "testutil.h"
+
+#include <stdio.h>
+
+class DataReaderFromRandom : public ncnn::DataReader
+{
+public:
+    virtual size_t read(void* buf, size_t size) const
+    {
+        // weights as small floats, flags as zero
+        float* p = (float*)buf;
+        for (size_t i = 0; i < size / sizeof(float); i++)
+        {
+            p[i] = i == 0 ? 0.f : RandomFloat(-0.1f, 0.1f);
+        }
+        return size;
+    }
+};
+
+// the three layers with a batch forward, each fed by its own input
+// conv is 1x1 stride 1, fc takes 1d samples, gemm has constant B
+static const char* param = "7767517\n"
+                           "6 6\n"
+                           "Input in0 0 1 in0\n"
+                           "Input in1 0 1 in1\n"
+                           "Input in2 0 1 in2\n"
+                           "Convolution conv 1 1 in0 out0 0=64 1=1 5=1 6=4096\n"
+                           "InnerProduct fc 1 1 in1 out1 0=128 1=1 2=32768\n"
+                           "Gemm gemm 1 1 in2 out2 5=1 6=1 8=64 9=64 10=-1\n";
+
+static const char* outputs[3] = {"out0", "out1", "out2"};
+
+static int extract_per_sample(const ncnn::Net& net, const std::vector<ncnn::Mat>* ins, std::vector<ncnn::Mat>* outs)
+{
+    const int batch = (int)ins[0].size();
+
+    for (int i = 0; i < batch; i++)
+    {
+        ncnn::Extractor ex = net.create_extractor();
+        ex.input("in0", ins[0][i]);
+        ex.input("in1", ins[1][i]);
+        ex.input("in2", ins[2][i]);
+
+        for (int q = 0; q < 3; q++)
+        {
+            ncnn::Mat out;
+            int ret = ex.extract(outputs[q], out);
+            if (ret != 0)
+                return ret;
+
+            outs[q][i] = out;
+        }
+    }
+
+    return 0;
+}
+
+static int extract_batch(const ncnn::Net& net, const std::vector<ncnn::Mat>* ins, std::vector<ncnn::Mat>* outs)
+{
+    ncnn::Extractor ex = net.create_extractor();
+    ex.input_batch("in0", ins[0]);
+    ex.input_batch("in1", ins[1]);
+    ex.input_batch("in2", ins[2]);
+
+    for (int q = 0; q < 3; q++)
+    {
+        int ret = ex.extract_batch(outputs[q], outs[q]);
+        if (ret != 0)
+            return ret;
+    }
+
+    return 0;
+}
+
+static int test_extract_batch(const ncnn::Option& opt, int batch)
+{
+    ncnn::Net net;
+    net.opt = opt;
+
+    int ret = net.load_param_mem(param);
+    if (ret != 0)
+    {
+        fprintf(stderr, "load_param_mem failed\n");
+        return -1;
+    }
+
+    DataReaderFromRandom dr;
+    net.load_model(dr);
+
+    std::vector<ncnn::Mat> ins[3];
+    for (int i = 0; i < batch; i++)
+    {
+        ins[0].push_back(RandomMat(14, 14, 64));
+        ins[1].push_back(RandomMat(256));
+        ins[2].push_back(RandomMat(64, 16));
+    }
+
+    std::vector<ncnn::Mat> expects[3];
+    std::vector<ncnn::Mat> outs[3];
+    for (int q = 0; q < 3; q++)
+    {
+        expects[q].resize(batch);
+    }
+
+    ret = extract_per_sample(net, ins, expects) || extract_batch(net, ins, outs);
+    if (ret != 0)
+    {
+        fprintf(stderr, "test_extract_batch extract failed batch=%d use_packing_layout=%d\n", batch, opt.use_packing_layout);
+        return -1;
+    }
+
+    for (int q = 0; q < 3; q++)
+    {
+        if ((int)outs[q].size() != batch)
+        {
+            fprintf(stderr, "test_extract_batch %s expect %d outputs but got %d\n", outputs[q], batch, (int)outs[q].size());
+            return -1;
+        }
+
+        for (int i = 0; i < batch; i++)
+        {
+            if (CompareMat(outs[q][i], expects[q][i], 0.001) != 0)
+            {
+                fprintf(stderr, "test_extract_batch %s sample %d mismatch batch=%d use_packing_layout=%d\n", outputs[q], i, batch, opt.use_packing_layout);
+                return -1;
+            }
+        }
+    }
+
+    // throughput, informational only
+    const int loop = 50;
+
+    double t0 = ncnn::get_current_time();
+    for (int l = 0; l < loop; l++)
+    {
+        extract_per_sample(net, ins, expects);
+    }
+
+    double t1 = ncnn::get_current_time();
+    for (int l = 0; l < loop; l++)
+    {
+        extract_batch(net, ins, outs);
+    }
+
+    double t2 = ncnn::get_current_time();
+
+    fprintf(stderr, "batch=%d use_packing_layout=%d  per-sample %.2f samples/s  batched %.2f samples/s\n", batch, opt.use_packing_layout, batch * loop * 1000.0 / (t1 - t0), batch * loop * 1000.0 / (t2 - t1));
+
+    return 0;
+}
+
+int main()
+{
+    SRAND(7767517);
+
+    ncnn::Option opt;
+    opt.num_threads = 1;
+
+    ncnn::Option opt_unpacked = opt;
+    opt_unpacked.use_packing_layout = false;
+
+    return 0
+           || test_extract_batch(opt, 1)
+           || test_extract_batch(opt, 4)
+           || test_extract_batch(opt, 8)
+           || test_extract_batch(opt_unpacked, 4);
+}
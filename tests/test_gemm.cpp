@@ -58,6 +58,51 @@ static int test_gemm(int M, int N, int K, float alpha, int transA, int transB, i
     return ret;
 }
 
+static int test_gemm_fp16_weight(int M, int N, int K, int transA, int transB, int constantA, int constantB)
+{
+    ncnn::ParamDict pd;
+    pd.set(0, 1.f); // alpha
+    pd.set(1, 1.f); // beta
+    pd.set(2, transA);
+    pd.set(3, transB);
+    pd.set(4, constantA);
+    pd.set(5, constantB);
+    pd.set(6, 1);
+    pd.set(7, M);
+    pd.set(8, N);
+    pd.set(9, K);
+    pd.set(10, -1);
+    // small tiles for several M, N and K panels
+    pd.set(20, 16);
+    pd.set(21, 16);
+    pd.set(22, 16);
+
+    std::vector<ncnn::Mat> weights;
+    if (constantA) weights.push_back(transA ? RandomMat(M, K) : RandomMat(K, M));
+    if (constantB) weights.push_back(transB ? RandomMat(K, N) : RandomMat(N, K));
+
+    std::vector<ncnn::Mat> a;
+    if (!constantA) a.push_back(transA ? RandomMat(M, K) : RandomMat(K, M));
+    if (!constantB) a.push_back(transB ? RandomMat(K, N) : RandomMat(N, K));
+
+    ncnn::Option opt;
+    opt.num_threads = 1;
+    opt.use_packing_layout = true;
+    opt.use_fp16_packed = false;
+    opt.use_fp16_storage = true;
+    opt.use_fp16_arithmetic = false;
+    opt.use_bf16_storage = false;
+    opt.use_fp16_weight_storage = true;
+
+    int ret = test_layer_opt("Gemm", pd, weights, opt, a);
+    if (ret != 0)
+    {
+        fprintf(stderr, "test_gemm_fp16_weight failed M=%d N=%d K=%d transA=%d transB=%d constantA=%d constantB=%d\n", M, N, K, transA, transB, constantA, constantB);
+    }
+
+    return ret;
+}
+
 static int test_gemm_bias(int M, int N, int K, const ncnn::Mat& C, float alpha, float beta, int transA, int transB, int output_transpose, int constantA, int constantB, int constantC)
 {
     int broadcast_type_C = 0;
@@ -303,5 +348,12 @@ int main()
             return 0;
     }
 
-    return 0;
+    // fp16 weight storage
+    return 0
+           || test_gemm_fp16_weight(40, 35, 47, 0, 1, 1, 0)
+           || test_gemm_fp16_weight(40, 35, 47, 1, 0, 1, 0)
+           || test_gemm_fp16_weight(40, 35, 47, 0, 1, 0, 1)
+           || test_gemm_fp16_weight(40, 35, 47, 1, 0, 0, 1)
+           || test_gemm_fp16_weight(40, 35, 47, 0, 1, 1, 1)
+           || test_gemm_fp16_weight(1, 35, 47, 0, 1, 0, 1);
 }
@@ -0,0 +1,342 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "testutil.h"
+
+#if NCNN_INT8
+static float absmax_mat(const ncnn::Mat& m)
+{
+    float absmax = 0.f;
+    const float* ptr = m;
+    for (int i = 0; i < (int)m.total(); i++)
+    {
+        absmax = std::max(absmax, (float)fabs(ptr[i]));
+    }
+    return absmax;
+}
+
+static ncnn::Mat scale_mat(const ncnn::Mat& m)
+{
+    ncnn::Mat scale(1);
+    scale[0] = 127.f / absmax_mat(m);
+    return scale;
+}
+
+static ncnn::Mat A_int8_scales(const ncnn::Mat& A, int M, int K, int transA)
+{
+    const int A_hstep = A.dims == 3 ? (int)A.cstep : A.w;
+
+    ncnn::Mat scales(M);
+    for (int i = 0; i < M; i++)
+    {
+        float absmax = 0.f;
+        for (int k = 0; k < K; k++)
+        {
+            const float v = transA ? A[k * A_hstep + i] : A[i * A_hstep + k];
+            absmax = std::max(absmax, (float)fabs(v));
+        }
+        scales[i] = absmax == 0.f ? 1.f : 127.f / absmax;
+    }
+    return scales;
+}
+
+static int test_gemm_int8(int M, int N, int K, float alpha, int transA, int transB, int output_transpose, int constantA, int constantB, int output_N1M, int int8_scale_term)
+{
+    ncnn::ParamDict pd;
+    pd.set(0, alpha);
+    pd.set(1, 1.f); // beta
+    pd.set(2, transA);
+    pd.set(3, transB);
+    pd.set(4, constantA);
+    pd.set(5, constantB);
+    pd.set(6, 1);
+    pd.set(7, M);
+    pd.set(8, N);
+    pd.set(9, K);
+    pd.set(10, -1);
+    pd.set(11, output_N1M);
+    pd.set(14, output_transpose);
+    pd.set(18, int8_scale_term);
+
+    ncnn::Mat A = transA ? (output_N1M ? ncnn::Mat(M, 1, K) : ncnn::Mat(M, K)) : (output_N1M ? ncnn::Mat(K, 1, M) : ncnn::Mat(K, M));
+    ncnn::Mat B = transB ? (output_N1M ? ncnn::Mat(K, 1, N) : ncnn::Mat(K, N)) : (output_N1M ? ncnn::Mat(N, 1, K) : ncnn::Mat(N, K));
+
+    Randomize(A);
+    Randomize(B);
+
+    std::vector<ncnn::Mat> weights;
+    if (constantA) weights.push_back(A);
+    if (constantB) weights.push_back(B);
+    if (constantA) weights.push_back(A_int8_scales(A, M, K, transA));
+    if (constantB) weights.push_back(scale_mat(B));
+    if (int8_scale_term == 3)
+    {
+        // calibrated input scales
+        if (!constantA) weights.push_back(scale_mat(A));
+        if (!constantB) weights.push_back(scale_mat(B));
+    }
+
+    std::vector<ncnn::Mat> a;
+    if (!constantA) a.push_back(A);
+    if (!constantB) a.push_back(B);
+
+    int flag = TEST_LAYER_DISABLE_GPU_TESTING;
+    int ret = test_layer("Gemm", pd, weights, a, 1, 0.001f, 0, flag);
+    if (ret != 0)
+    {
+        fprintf(stderr, "test_gemm_int8 failed M=%d N=%d K=%d alpha=%f transA=%d transB=%d output_transpose=%d constantA=%d constantB=%d output_N1M=%d int8_scale_term=%d\n", M, N, K, alpha, transA, transB, output_transpose, constantA, constantB, output_N1M, int8_scale_term);
+    }
+
+    return ret;
+}
+
+static int test_gemm_int8_disabled(int M, int N, int K, int transA, int transB, int constantA, int constantB)
+{
+    ncnn::ParamDict pd;
+    pd.set(2, transA);
+    pd.set(3, transB);
+    pd.set(4, constantA);
+    pd.set(5, constantB);
+    pd.set(6, 1);
+    pd.set(7, M);
+    pd.set(8, N);
+    pd.set(9, K);
+    pd.set(10, -1);
+
+    ncnn::Mat A = transA ? ncnn::Mat(M, K) : ncnn::Mat(K, M);
+    ncnn::Mat B = transB ? ncnn::Mat(K, N) : ncnn::Mat(N, K);
+
+    Randomize(A);
+    Randomize(B);
+
+    std::vector<ncnn::Mat> weights;
+    if (constantA) weights.push_back(A);
+    if (constantB) weights.push_back(B);
+
+    std::vector<ncnn::Mat> a;
+    if (!constantA) a.push_back(A);
+    if (!constantB) a.push_back(B);
+
+    // fp32 reference
+    std::vector<ncnn::Mat> b;
+    test_layer_naive(ncnn::layer_to_index("Gemm"), pd, weights, a, 1, b, 0, 0);
+
+    // the same gemm marked int8, with int8 inference turned off
+    pd.set(18, 2);
+    if (constantA) weights.push_back(A_int8_scales(A, M, K, transA));
+    if (constantB) weights.push_back(scale_mat(B));
+
+    ncnn::Option opt;
+    opt.num_threads = 1;
+    opt.use_packing_layout = true;
+    opt.use_fp16_packed = false;
+    opt.use_fp16_storage = false;
+    opt.use_fp16_arithmetic = false;
+    opt.use_bf16_storage = false;
+    opt.use_int8_inference = false;
+
+    std::vector<ncnn::Mat> c;
+    test_layer_cpu(ncnn::layer_to_index("Gemm"), pd, weights, opt, a, 1, c, std::vector<ncnn::Mat>(), 0, 0);
+
+    int ret = CompareMat(b, c, 0.001);
+    if (ret != 0)
+    {
+        fprintf(stderr, "test_gemm_int8_disabled failed M=%d N=%d K=%d transA=%d transB=%d constantA=%d constantB=%d\n", M, N, K, transA, transB, constantA, constantB);
+    }
+
+    return ret;
+}
+
+static int test_gemm_int8_bias(int M, int N, int K, const ncnn::Mat& C, float alpha, float beta, int transA, int transB, int output_transpose, int constantA, int constantB, int constantC)
+{
+    int broadcast_type_C = 0;
+    if (C.dims == 1 && C.w == 1)
+    {
+        // scalar
+        broadcast_type_C = 0;
+    }
+    if (C.dims == 1 && C.w == M)
+    {
+        // M
+        // auto broadcast from h to w is the ncnn-style convention
+        broadcast_type_C = 1;
+    }
+    if (C.dims == 1 && C.w == N)
+    {
+        // N
+        broadcast_type_C = 4;
+    }
+    if (C.dims == 2 && C.w == 1 && C.h == M)
+    {
+        // Mx1
+        broadcast_type_C = 2;
+    }
+    if (C.dims == 2 && C.w == N && C.h == M)
+    {
+        // MxN
+        broadcast_type_C = 3;
+    }
+    if (C.dims == 2 && C.w == N && C.h == 1)
+    {
+        // 1xN
+        broadcast_type_C = 4;
+    }
+
+    ncnn::ParamDict pd;
+    pd.set(0, alpha);
+    pd.set(1, beta);
+    pd.set(2, transA);
+    pd.set(3, transB);
+    pd.set(4, constantA);
+    pd.set(5, constantB);
+    pd.set(6, constantC);
+    pd.set(7, M);
+    pd.set(8, N);
+    pd.set(9, K);
+    pd.set(10, broadcast_type_C);
+    pd.set(14, output_transpose);
+    pd.set(18, 2); // int8_scale_term
+
+    ncnn::Mat A = transA ? ncnn::Mat(M, K) : ncnn::Mat(K, M);
+    ncnn::Mat B = transB ? ncnn::Mat(K, N) : ncnn::Mat(N, K);
+
+    Randomize(A);
+    Randomize(B);
+
+    std::vector<ncnn::Mat> weights;
+    if (constantA) weights.push_back(A);
+    if (constantB) weights.push_back(B);
+    if (constantC) weights.push_back(C);
+    if (constantA) weights.push_back(A_int8_scales(A, M, K, transA));
+    if (constantB) weights.push_back(scale_mat(B));
+
+    std::vector<ncnn::Mat> a;
+    if (!constantA) a.push_back(A);
+    if (!constantB) a.push_back(B);
+    if (!constantC) a.push_back(C);
+
+    int flag = TEST_LAYER_DISABLE_GPU_TESTING;
+    int ret = test_layer("Gemm", pd, weights, a, 1, 0.001f, 0, flag);
+    if (ret != 0)
+    {
+        fprintf(stderr, "test_gemm_int8_bias failed M=%d N=%d K=%d C.dims=%d C=(%d %d %d) alpha=%f beta=%f transA=%d transB=%d output_transpose=%d constantA=%d constantB=%d constantC=%d\n", M, N, K, C.dims, C.w, C.h, C.c, alpha, beta, transA, transB, output_transpose, constantA, constantB, constantC);
+    }
+
+    return ret;
+}
+
+static int test_gemm_0(int M, int N, int K)
+{
+    return 0
+           || test_gemm_int8(M, N, K, 2.1f, 0, 0, 0, 0, 0, 0, 2)
+           || test_gemm_int8(M, N, K, 3.1f, 0, 1, 0, 0, 0, 0, 2)
+           || test_gemm_int8(M, N, K, 4.1f, 1, 0, 1, 0, 0, 0, 2)
+           || test_gemm_int8(M, N, K, 5.1f, 1, 1, 1, 0, 0, 0, 2)
+
+           || test_gemm_int8(M, N, K, 2.1f, 0, 0, 0, 1, 0, 0, 2)
+           || test_gemm_int8(M, N, K, 3.1f, 0, 1, 1, 1, 0, 0, 2)
+           || test_gemm_int8(M, N, K, 4.1f, 1, 0, 0, 1, 0, 0, 2)
+           || test_gemm_int8(M, N, K, 5.1f, 1, 1, 1, 1, 0, 0, 2)
+
+           || test_gemm_int8(M, N, K, 2.1f, 0, 0, 1, 0, 1, 0, 2)
+           || test_gemm_int8(M, N, K, 3.1f, 0, 1, 0, 0, 1, 0, 2)
+           || test_gemm_int8(M, N, K, 4.1f, 1, 0, 1, 0, 1, 0, 2)
+           || test_gemm_int8(M, N, K, 5.1f, 1, 1, 0, 0, 1, 0, 2)
+
+           || test_gemm_int8(M, N, K, 2.1f, 0, 0, 0, 1, 1, 0, 2)
+           || test_gemm_int8(M, N, K, 3.1f, 1, 1, 1, 1, 1, 0, 2)
+
+           || test_gemm_int8(M, N, K, 1.7f, 0, 1, 0, 0, 0, 1, 2)
+           || test_gemm_int8(M, N, K, 1.9f, 1, 0, 1, 1, 0, 1, 2)
+           || test_gemm_int8(M, N, K, 1.7f, 0, 0, 0, 0, 1, 1, 2)
+
+           || test_gemm_int8(M, N, K, 2.1f, 0, 0, 0, 0, 0, 0, 3)
+           || test_gemm_int8(M, N, K, 3.1f, 0, 1, 1, 1, 0, 0, 3)
+           || test_gemm_int8(M, N, K, 4.1f, 1, 0, 0, 0, 1, 0, 3);
+}
+
+static int test_gemm_1(int M, int N, int K)
+{
+    return 0
+           || test_gemm_int8_bias(M, N, K, RandomMat(1), 2.1f, 0.5f, 0, 0, 0, 0, 0, 0)
+           || test_gemm_int8_bias(M, N, K, RandomMat(M), 3.1f, 0.6f, 0, 1, 0, 1, 0, 0)
+           || test_gemm_int8_bias(M, N, K, RandomMat(1, M), 4.1f, 0.7f, 1, 0, 1, 0, 1, 0)
+           || test_gemm_int8_bias(M, N, K, RandomMat(N, M), 5.1f, 0.8f, 1, 1, 1, 1, 0, 1)
+           || test_gemm_int8_bias(M, N, K, RandomMat(N, 1), 2.1f, 0.5f, 0, 0, 0, 0, 1, 1)
+           || test_gemm_int8_bias(M, N, K, RandomMat(N), 3.1f, 0.6f, 0, 1, 1, 1, 1, 1);
+}
+
+static int test_gemm_2(int M, int N, int K)
+{
+    // int8 gemm must stay in fp32 when use_int8_inference is off
+    return 0
+           || test_gemm_int8_disabled(M, N, K, 0, 0, 1, 0)
+           || test_gemm_int8_disabled(M, N, K, 1, 1, 1, 0)
+           || test_gemm_int8_disabled(M, N, K, 0, 1, 0, 1)
+           || test_gemm_int8_disabled(M, N, K, 1, 0, 0, 1)
+           || test_gemm_int8_disabled(M, N, K, 0, 0, 0, 0);
+}
+#endif // NCNN_INT8
+
+int main()
+{
+    SRAND(7767517);
+
+#if NCNN_INT8
+    int mnk[][3] = {
+        {1, 1, 1},
+        {2, 2, 2},
+        {3, 3, 3},
+        {4, 4, 4},
+        {5, 5, 5},
+        {8, 8, 8},
+        {15, 15, 15},
+        {16, 16, 16},
+        {31, 31, 31},
+        {1, 1, 23},
+        {1, 31, 1},
+        {23, 1, 1},
+        {12, 31, 12},
+        {24, 35, 24},
+        {47, 24, 24},
+        {23, 31, 23},
+        {32, 32, 9},
+        {47, 35, 48},
+        {48, 35, 47},
+        {64, 33, 128},
+        {67, 64, 96}
+    };
+
+    int mnk_count = sizeof(mnk) / sizeof(int) / 3;
+
+    for (int i = 0; i < mnk_count; i++)
+    {
+        int M = mnk[i][0];
+        int N = mnk[i][1];
+        int K = mnk[i][2];
+
+        int ret = 0
+                  || test_gemm_0(M, N, K)
+                  || test_gemm_1(M, N, K)
+                  || test_gemm_2(M, N, K);
+
+        if (ret != 0)
+            return ret;
+    }
+#else
+    // test nothing for non-int8 build
+#endif
+
+    return 0;
+}
@@ -0,0 +1,132 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "cpu.h"
+#include "testutil.h"
+
+static int test_mat_normalize(int w, int h, int c, int elempack, int num_threads, bool with_mean, bool with_norm)
+{
+    ncnn::Mat a = RandomMat(w, h, c);
+
+    std::vector<float> mean_vals(c);
+    std::vector<float> norm_vals(c);
+    for (int q = 0; q < c; q++)
+    {
+        mean_vals[q] = RandomFloat(-1.f, 1.f);
+        norm_vals[q] = RandomFloat(0.5f, 2.f);
+    }
+
+    const float* mean = with_mean ? mean_vals.data() : 0;
+    const float* norm = with_norm ? norm_vals.data() : 0;
+
+    // naive reference
+    ncnn::Mat b = a.clone();
+    for (int q = 0; q < c; q++)
+    {
+        float* ptr = b.channel(q);
+        for (int i = 0; i < w * h; i++)
+        {
+            if (mean) ptr[i] -= mean[q];
+            if (norm) ptr[i] *= norm[q];
+        }
+    }
+
+    ncnn::Option opt;
+    opt.num_threads = num_threads;
+
+    ncnn::Mat ap;
+    ncnn::convert_packing(a, ap, elempack, opt);
+    ap.substract_mean_normalize(mean, norm, opt);
+
+    ncnn::Mat c1;
+    ncnn::convert_packing(ap, c1, 1, opt);
+
+    if (CompareMat(b, c1, 0.001) != 0)
+    {
+        fprintf(stderr, "test_mat_normalize failed w=%d h=%d c=%d elempack=%d num_threads=%d mean=%d norm=%d\n", w, h, c, elempack, num_threads, with_mean, with_norm);
+        return -1;
+    }
+
+    return 0;
+}
+
+static int test_mat_from_float16(int size, int num_threads)
+{
+    ncnn::Mat a = RandomMat(size);
+
+    std::vector<unsigned short> data(size);
+    for (int i = 0; i < size; i++)
+    {
+        data[i] = ncnn::float32_to_float16(a[i]);
+    }
+
+    ncnn::Option opt;
+    opt.num_threads = num_threads;
+
+    ncnn::Mat b = ncnn::Mat::from_float16(data.data(), size);
+    ncnn::Mat c = ncnn::Mat::from_float16(data.data(), size, opt);
+
+    if (CompareMat(a, b, 0.01) != 0 || CompareMat(b, c, 0.f) != 0)
+    {
+        fprintf(stderr, "test_mat_from_float16 failed size=%d num_threads=%d\n", size, num_threads);
+        return -1;
+    }
+
+    return 0;
+}
+
+static int test_mat_normalize_0()
+{
+    // layers only take the packed layout native to the cpu
+    int elempacks[4] = {1, 4, 1, 1};
+#if NCNN_AVX
+    if (ncnn::cpu_support_x86_avx()) elempacks[2] = 8;
+#endif
+#if NCNN_AVX512
+    if (ncnn::cpu_support_x86_avx512()) elempacks[3] = 16;
+#endif
+
+    for (int i = 0; i < 4; i++)
+    {
+        int ret = 0
+                  || test_mat_normalize(13, 7, 16, elempacks[i], 1, true, true)
+                  || test_mat_normalize(13, 7, 16, elempacks[i], 4, true, false)
+                  || test_mat_normalize(13, 7, 16, elempacks[i], 4, false, true)
+                  || test_mat_normalize(5, 3, 32, elempacks[i], 2, true, true);
+
+        if (ret != 0)
+            return ret;
+    }
+
+    return 0
+           || test_mat_normalize(19, 11, 3, 1, 1, true, true)
+           || test_mat_normalize(19, 11, 3, 1, 4, true, false);
+}
+
+static int test_mat_normalize_1()
+{
+    return 0
+           || test_mat_from_float16(1, 1)
+           || test_mat_from_float16(35, 1)
+           || test_mat_from_float16(1024, 4);
+}
+
+int main()
+{
+    SRAND(7767517);
+
+    return 0
+           || test_mat_normalize_0()
+           || test_mat_normalize_1();
+}
@@ -370,6 +370,41 @@ static int test_mat_pixel_yuv420sp2rgb(int w, int h)
     return 0;
 }
 
+static int test_mat_pixel_yuv420sp2rgb_naive(int w, int h)
+{
+    ncnn::Mat nv21 = RandomMat(w, h / 2 * 3, 1);
+
+    ncnn::Mat rgb(w, h, (size_t)3u, 3);
+    yuv420sp2rgb(nv21, w, h, rgb);
+
+    const unsigned char* yptr = nv21;
+    const unsigned char* vuptr = (const unsigned char*)nv21 + w * h;
+    const unsigned char* p = rgb;
+    for (int y = 0; y < h; y++)
+    {
+        for (int x = 0; x < w; x++)
+        {
+            const int yy = yptr[y * w + x] << 6;
+            const int v = vuptr[y / 2 * w + x / 2 * 2] - 128;
+            const int u = vuptr[y / 2 * w + x / 2 * 2 + 1] - 128;
+
+            const int r = std::min(std::max((yy + 90 * v) >> 6, 0), 255);
+            const int g = std::min(std::max((yy - 46 * v - 22 * u) >> 6, 0), 255);
+            const int b = std::min(std::max((yy + 113 * u) >> 6, 0), 255);
+
+            if (p[0] != r || p[1] != g || p[2] != b)
+            {
+                fprintf(stderr, "test_mat_pixel_yuv420sp2rgb_naive failed w=%d h=%d at %d %d\n", w, h, x, y);
+                return -1;
+            }
+
+            p += 3;
+        }
+    }
+
+    return 0;
+}
+
 static int test_mat_pixel_0()
 {
     return 0
@@ -439,6 +474,21 @@ static int test_mat_pixel_6()
            || test_mat_pixel_yuv420sp2rgb(6, 6);
 }
 
+static int test_mat_pixel_7()
+{
+    return 0
+           || test_mat_pixel_gray(67, 21)
+           || test_mat_pixel_rgb(67, 21)
+           || test_mat_pixel_bgr(67, 21)
+           || test_mat_pixel_rgba(67, 21)
+           || test_mat_pixel_bgra(67, 21)
+           || test_mat_pixel_roi_rgb(67, 21, 5, 3, 41, 13)
+           || test_mat_pixel_roi_rgba(67, 21, 3, 5, 33, 11)
+           || test_mat_pixel_yuv420sp2rgb(70, 34)
+           || test_mat_pixel_yuv420sp2rgb_naive(70, 34)
+           || test_mat_pixel_yuv420sp2rgb_naive(16, 2);
+}
+
 int main()
 {
     SRAND(7767517);
@@ -450,5 +500,6 @@ int main()
            || test_mat_pixel_3()
            || test_mat_pixel_4()
            || test_mat_pixel_5()
-           || test_mat_pixel_6();
+           || test_mat_pixel_6()
+           || test_mat_pixel_7();
 }
@@ -0,0 +1,236 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "mat.h"
+#include "prng.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+static struct prng_rand_t g_prng_rand_state;
+#define SRAND(seed) prng_srand(seed, &g_prng_rand_state)
+#define RAND()      prng_rand(&g_prng_rand_state)
+
+static ncnn::Mat RandomPixels(int w, int h, int elempack)
+{
+    ncnn::Mat m(w, h, (size_t)elempack, elempack);
+
+    unsigned char* p = m;
+    for (int i = 0; i < w * h * elempack; i++)
+    {
+        p[i] = RAND() % 256;
+    }
+
+    return m;
+}
+
+static float tensor_value(const ncnn::Mat& m, int x, int y, int q)
+{
+    const int i = q % m.elempack;
+    const ncnn::Mat mq = m.channel(q / m.elempack);
+
+    if (m.elemsize / m.elempack == 2)
+        return ncnn::float16_to_float32(mq.row<const unsigned short>(y)[x * m.elempack + i]);
+
+    return mq.row(y)[x * m.elempack + i];
+}
+
+// the unfused pipeline, resize on u8 then normalize
+static int compare_reference(const ncnn::Mat& out, const ncnn::Mat& ref, int pad_left, int pad_top, const ncnn::PixelPreprocess& pp, float tolerance)
+{
+    const int channels = out.c * out.elempack;
+
+    if (ref.c != channels)
+    {
+        fprintf(stderr, "channels %d mismatch reference %d\n", channels, ref.c);
+        return -1;
+    }
+
+    for (int q = 0; q < channels; q++)
+    {
+        const float pad = (pp.pad_value - pp.mean_vals[q]) * pp.norm_vals[q];
+
+        for (int y = 0; y < out.h; y++)
+        {
+            for (int x = 0; x < out.w; x++)
+            {
+                const int rx = x - pad_left;
+                const int ry = y - pad_top;
+
+                float expect = pad;
+                if (rx >= 0 && rx < ref.w && ry >= 0 && ry < ref.h)
+                    expect = (ref.channel(q).row(ry)[rx] - pp.mean_vals[q]) * pp.norm_vals[q];
+
+                const float v = tensor_value(out, x, y, q);
+                if (fabs(v - expect) > tolerance * fabs(pp.norm_vals[q]) + 0.01f)
+                {
+                    fprintf(stderr, "value mismatch at %d %d %d got %f expect %f\n", x, y, q, v, expect);
+                    return -1;
+                }
+            }
+        }
+    }
+
+    return 0;
+}
+
+static int test_mat_pixel_preprocess_resize(int w, int h, int type, int channels, int target_width, int target_height, int elempack, bool fp16)
+{
+    ncnn::Mat a = RandomPixels(w, h, channels);
+
+    ncnn::PixelPreprocess pp;
+    pp.target_width = target_width;
+    pp.target_height = target_height;
+    pp.elempack = elempack;
+    pp.use_fp16_storage = fp16;
+    for (int q = 0; q < 4; q++)
+    {
+        pp.mean_vals[q] = 100.f + q * 10;
+        pp.norm_vals[q] = 1 / (50.f + q * 10);
+    }
+
+    ncnn::Mat out = ncnn::Mat::from_pixels_preprocess(a, type, w, h, pp);
+    ncnn::Mat ref = ncnn::Mat::from_pixels_resize(a, type, w, h, target_width, target_height);
+
+    if (out.w != target_width || out.h != target_height || out.elempack != elempack)
+    {
+        fprintf(stderr, "test_mat_pixel_preprocess_resize shape failed type=%d w=%d h=%d\n", type, w, h);
+        return -1;
+    }
+
+    // rgb2gray rounds twice in the reference
+    const float tolerance = ((type >> ncnn::Mat::PIXEL_CONVERT_SHIFT) == ncnn::Mat::PIXEL_GRAY ? 2.f : 1.f) + (fp16 ? 0.05f : 0.f);
+    if (compare_reference(out, ref, 0, 0, pp, tolerance) != 0)
+    {
+        fprintf(stderr, "test_mat_pixel_preprocess_resize failed type=%d w=%d h=%d target=%d %d elempack=%d fp16=%d\n", type, w, h, target_width, target_height, elempack, fp16);
+        return -1;
+    }
+
+    return 0;
+}
+
+static int test_mat_pixel_preprocess_letterbox(int w, int h, int target_width, int target_height)
+{
+    ncnn::Mat a = RandomPixels(w, h, 3);
+
+    ncnn::PixelPreprocess pp;
+    pp.target_width = target_width;
+    pp.target_height = target_height;
+    pp.letterbox = true;
+    pp.pad_value = 114.f;
+    pp.norm_vals[0] = 1 / 255.f;
+    pp.norm_vals[1] = 1 / 255.f;
+    pp.norm_vals[2] = 1 / 255.f;
+
+    int resize_w;
+    int resize_h;
+    int pad_left;
+    int pad_top;
+    pp.get_letterbox(w, h, resize_w, resize_h, pad_left, pad_top);
+
+    ncnn::Option opt;
+    opt.num_threads = 1;
+    ncnn::Mat out = ncnn::Mat::from_pixels_preprocess(a, ncnn::Mat::PIXEL_RGB2BGR, w, h, pp, opt);
+    ncnn::Mat ref = ncnn::Mat::from_pixels_resize(a, ncnn::Mat::PIXEL_RGB2BGR, w, h, resize_w, resize_h);
+
+    if (compare_reference(out, ref, pad_left, pad_top, pp, 1.f) != 0)
+    {
+        fprintf(stderr, "test_mat_pixel_preprocess_letterbox failed w=%d h=%d target=%d %d\n", w, h, target_width, target_height);
+        return -1;
+    }
+
+    // rows are split across threads, the result must not change
+    opt.num_threads = 4;
+    ncnn::Mat out4 = ncnn::Mat::from_pixels_preprocess(a, ncnn::Mat::PIXEL_RGB2BGR, w, h, pp, opt);
+
+    for (int q = 0; q < out.c; q++)
+    {
+        if (memcmp(out.channel(q), out4.channel(q), out.w * out.h * out.elemsize) != 0)
+        {
+            fprintf(stderr, "test_mat_pixel_preprocess_letterbox threads mismatch w=%d h=%d\n", w, h);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+static int test_mat_pixel_preprocess_yuv420sp(int w, int h, int target_width, int target_height, int nv12)
+{
+    ncnn::Mat yuv = RandomPixels(w, h / 2 * 3, 1);
+
+    ncnn::Mat rgb(w, h, (size_t)3u, 3);
+    if (nv12)
+        ncnn::yuv420sp2rgb_nv12(yuv, w, h, rgb);
+    else
+        ncnn::yuv420sp2rgb(yuv, w, h, rgb);
+
+    ncnn::PixelPreprocess pp;
+    pp.target_width = target_width;
+    pp.target_height = target_height;
+    pp.mean_vals[0] = 127.5f;
+    pp.mean_vals[1] = 127.5f;
+    pp.mean_vals[2] = 127.5f;
+
+    const int type = nv12 ? ncnn::Mat::PIXEL_NV122BGR : ncnn::Mat::PIXEL_NV212BGR;
+    ncnn::Mat out = ncnn::Mat::from_pixels_preprocess(yuv, type, w, h, pp);
+    ncnn::Mat ref = ncnn::Mat::from_pixels_resize(rgb, ncnn::Mat::PIXEL_RGB2BGR, w, h, target_width, target_height);
+
+    if (compare_reference(out, ref, 0, 0, pp, 1.f) != 0)
+    {
+        fprintf(stderr, "test_mat_pixel_preprocess_yuv420sp failed w=%d h=%d nv12=%d\n", w, h, nv12);
+        return -1;
+    }
+
+    return 0;
+}
+
+static int test_mat_pixel_preprocess_0()
+{
+    return 0
+           || test_mat_pixel_preprocess_resize(67, 45, ncnn::Mat::PIXEL_RGB, 3, 32, 24, 1, false)
+           || test_mat_pixel_preprocess_resize(67, 45, ncnn::Mat::PIXEL_BGR2RGB, 3, 80, 61, 1, false)
+           || test_mat_pixel_preprocess_resize(16, 16, ncnn::Mat::PIXEL_GRAY, 1, 7, 9, 1, true)
+           || test_mat_pixel_preprocess_resize(33, 17, ncnn::Mat::PIXEL_RGB2GRAY, 3, 20, 20, 1, false)
+           || test_mat_pixel_preprocess_resize(33, 17, ncnn::Mat::PIXEL_RGBA, 4, 21, 13, 4, false)
+           || test_mat_pixel_preprocess_resize(33, 17, ncnn::Mat::PIXEL_BGRA2RGBA, 4, 40, 30, 4, true)
+           || test_mat_pixel_preprocess_resize(33, 17, ncnn::Mat::PIXEL_RGBA2BGR, 4, 12, 12, 1, false);
+}
+
+static int test_mat_pixel_preprocess_1()
+{
+    return 0
+           || test_mat_pixel_preprocess_letterbox(64, 32, 48, 48)
+           || test_mat_pixel_preprocess_letterbox(30, 50, 64, 64)
+           || test_mat_pixel_preprocess_letterbox(31, 31, 32, 16);
+}
+
+static int test_mat_pixel_preprocess_2()
+{
+    return 0
+           || test_mat_pixel_preprocess_yuv420sp(32, 24, 20, 14, 0)
+           || test_mat_pixel_preprocess_yuv420sp(32, 24, 20, 14, 1)
+           || test_mat_pixel_preprocess_yuv420sp(18, 10, 40, 30, 0);
+}
+
+int main()
+{
+    SRAND(7767517);
+
+    return 0
+           || test_mat_pixel_preprocess_0()
+           || test_mat_pixel_preprocess_1()
+           || test_mat_pixel_preprocess_2();
+}
@@ -172,7 +172,11 @@ static int test_mat_pixel_rotate_0()
            || test_mat_pixel_rotate_c1(22, 33)
            || test_mat_pixel_rotate_c2(22, 33)
            || test_mat_pixel_rotate_c3(22, 33)
-           || test_mat_pixel_rotate_c4(22, 33);
+           || test_mat_pixel_rotate_c4(22, 33)
+           || test_mat_pixel_rotate_c1(67, 45)
+           || test_mat_pixel_rotate_c2(67, 45)
+           || test_mat_pixel_rotate_c3(67, 45)
+           || test_mat_pixel_rotate_c4(67, 45);
 }
 
 static int test_mat_pixel_rotate_yuv420sp(int w, int h)
@@ -132,6 +132,164 @@ static int test_multiheadattention_sameqkv(const ncnn::Mat& a, int embed_dim, in
     return ret;
 }
 
+static int test_multiheadattention_kvcache(const ncnn::Mat& q, const ncnn::Mat& kv, int past_seqlen, int embed_dim, int num_heads, int attn_mask)
+{
+    const int qdim = q.w;
+    const int kvdim = kv.w;
+
+    ncnn::ParamDict pd;
+    pd.set(0, embed_dim);
+    pd.set(1, num_heads);
+    pd.set(2, embed_dim * qdim);
+    pd.set(3, kvdim);
+    pd.set(4, kvdim);
+    pd.set(5, attn_mask);
+    pd.set(7, 1);
+
+    std::vector<ncnn::Mat> weights(8);
+    weights[0] = RandomMat(embed_dim * qdim);
+    weights[1] = RandomMat(embed_dim);
+    weights[2] = RandomMat(embed_dim * kvdim);
+    weights[3] = RandomMat(embed_dim);
+    weights[4] = RandomMat(embed_dim * kvdim);
+    weights[5] = RandomMat(embed_dim);
+    weights[6] = RandomMat(qdim * embed_dim);
+    weights[7] = RandomMat(qdim);
+
+    std::vector<ncnn::Mat> as(2);
+    as[0] = q;
+    as[1] = kv;
+
+    if (attn_mask)
+    {
+        as.push_back(RandomMat(past_seqlen + kv.h, q.h));
+    }
+
+    as.push_back(RandomMat(past_seqlen, embed_dim));
+    as.push_back(RandomMat(past_seqlen, embed_dim));
+
+    float epsilon = 0.005;
+
+    int ret = test_layer("MultiHeadAttention", pd, weights, as, 3, epsilon);
+    if (ret != 0)
+    {
+        fprintf(stderr, "test_multiheadattention_kvcache failed q=(%d %d) kv=(%d %d) past_seqlen=%d embed_dim=%d num_heads=%d attn_mask=%d\n", q.w, q.h, kv.w, kv.h, past_seqlen, embed_dim, num_heads, attn_mask);
+    }
+
+    return ret;
+}
+
+// decoding token by token with kv cache must match the full sequence with causal mask
+static int test_multiheadattention_kvcache_decode(const ncnn::Mat& a, int embed_dim, int num_heads)
+{
+    const int qdim = a.w;
+    const int seqlen = a.h;
+
+    std::vector<ncnn::Mat> weights(8);
+    weights[0] = RandomMat(embed_dim * qdim);
+    weights[1] = RandomMat(embed_dim);
+    weights[2] = RandomMat(embed_dim * qdim);
+    weights[3] = RandomMat(embed_dim);
+    weights[4] = RandomMat(embed_dim * qdim);
+    weights[5] = RandomMat(embed_dim);
+    weights[6] = RandomMat(qdim * embed_dim);
+    weights[7] = RandomMat(qdim);
+
+    ncnn::Option opt;
+    opt.num_threads = 1;
+    opt.use_packing_layout = false;
+    opt.use_fp16_packed = false;
+    opt.use_fp16_storage = false;
+    opt.use_fp16_arithmetic = false;
+    opt.use_bf16_storage = false;
+
+    ncnn::Mat causal_mask(seqlen, seqlen);
+    for (int i = 0; i < seqlen; i++)
+    {
+        float* ptr = causal_mask.row(i);
+        for (int j = 0; j < seqlen; j++)
+        {
+            ptr[j] = j <= i ? 0.f : -1e9f;
+        }
+    }
+
+    ncnn::Mat full_out;
+    {
+        ncnn::ParamDict pd;
+        pd.set(0, embed_dim);
+        pd.set(1, num_heads);
+        pd.set(2, embed_dim * qdim);
+        pd.set(3, qdim);
+        pd.set(4, qdim);
+        pd.set(5, 1);
+
+        ncnn::Layer* op = ncnn::create_layer_cpu("MultiHeadAttention");
+        op->load_param(pd);
+        op->load_model(ncnn::ModelBinFromMatArray(weights.data()));
+        op->create_pipeline(opt);
+
+        std::vector<ncnn::Mat> bottom_blobs(2);
+        bottom_blobs[0] = a;
+        bottom_blobs[1] = causal_mask;
+        std::vector<ncnn::Mat> top_blobs(1);
+        op->forward(bottom_blobs, top_blobs, opt);
+        full_out = top_blobs[0];
+
+        op->destroy_pipeline(opt);
+        delete op;
+    }
+
+    ncnn::Mat decode_out(qdim, seqlen);
+    {
+        ncnn::ParamDict pd;
+        pd.set(0, embed_dim);
+        pd.set(1, num_heads);
+        pd.set(2, embed_dim * qdim);
+        pd.set(3, qdim);
+        pd.set(4, qdim);
+        pd.set(7, 1);
+
+        ncnn::Layer* op = ncnn::create_layer_cpu("MultiHeadAttention");
+        op->load_param(pd);
+        op->load_model(ncnn::ModelBinFromMatArray(weights.data()));
+        op->create_pipeline(opt);
+
+        ncnn::Mat k_cache(0, embed_dim);
+        ncnn::Mat v_cache(0, embed_dim);
+        for (int i = 0; i < seqlen; i++)
+        {
+            std::vector<ncnn::Mat> bottom_blobs(3);
+            bottom_blobs[0] = a.row_range(i, 1).clone();
+            bottom_blobs[1] = k_cache;
+            bottom_blobs[2] = v_cache;
+            std::vector<ncnn::Mat> top_blobs(3);
+            int ret = op->forward(bottom_blobs, top_blobs, opt);
+            if (ret != 0 || top_blobs[1].w != i + 1 || top_blobs[2].w != i + 1)
+            {
+                fprintf(stderr, "test_multiheadattention_kvcache_decode step %d failed\n", i);
+                op->destroy_pipeline(opt);
+                delete op;
+                return -1;
+            }
+
+            memcpy(decode_out.row(i), top_blobs[0], qdim * sizeof(float));
+            k_cache = top_blobs[1];
+            v_cache = top_blobs[2];
+        }
+
+        op->destroy_pipeline(opt);
+        delete op;
+    }
+
+    if (CompareMat(full_out, decode_out, 0.005) != 0)
+    {
+        fprintf(stderr, "test_multiheadattention_kvcache_decode failed a=(%d %d) embed_dim=%d num_heads=%d\n", a.w, a.h, embed_dim, num_heads);
+        return -1;
+    }
+
+    return 0;
+}
+
 static int test_multiheadattention_0()
 {
     return 0
@@ -163,6 +321,35 @@ static int test_multiheadattention_2()
            || test_multiheadattention_sameqkv(RandomMat(48, 127), 64, 8);
 }
 
+static int test_multiheadattention_3()
+{
+    return 0
+           || test_multiheadattention_kvcache(RandomMat(64, 1), RandomMat(64, 1), 127, 64, 4, 0)
+           || test_multiheadattention_kvcache(RandomMat(48, 3), RandomMat(32, 3), 17, 32, 8, 1)
+           || test_multiheadattention_kvcache(RandomMat(12, 5), RandomMat(28, 5), 32, 12, 3, 0)
+           || test_multiheadattention_kvcache_decode(RandomMat(32, 13), 32, 4)
+           || test_multiheadattention_kvcache_decode(RandomMat(24, 16), 48, 3);
+}
+
+static int test_multiheadattention_4()
+{
+    // long sequences take the fused attention path on x86
+    // the score matrix of one head is sized past the l2 cache so that every host takes it
+    const int l2_cache_size = ncnn::get_cpu_level2_cache_size();
+
+    const int src_seqlen = 128;
+    const int dst_seqlen = l2_cache_size / (src_seqlen * (int)sizeof(float)) + 5;
+
+    int seqlen = 256;
+    while (seqlen * seqlen * (int)sizeof(float) <= l2_cache_size)
+        seqlen += 256;
+
+    return 0
+           || test_multiheadattention(RandomMat(16, src_seqlen + 3), RandomMat(24, dst_seqlen), RandomMat(20, dst_seqlen), 16, 2, 1)
+           || test_multiheadattention(RandomMat(36, src_seqlen), RandomMat(36, dst_seqlen + 7), RandomMat(36, dst_seqlen + 7), 36, 3, 0)
+           || test_multiheadattention_sameqkv(RandomMat(40, seqlen), 40, 5);
+}
+
 int main()
 {
     SRAND(7767517);
@@ -170,5 +357,7 @@ int main()
     return 0
            || test_multiheadattention_0()
            || test_multiheadattention_1()
-           || test_multiheadattention_2();
+           || test_multiheadattention_2()
+           || test_multiheadattention_3()
+           || test_multiheadattention_4();
 }
@@ -42,7 +42,9 @@ static int test_pixelshuffle_0()
            || test_pixelshuffle(RandomMat(7, 7, 48), 2, 0)
            || test_pixelshuffle(RandomMat(7, 7, 36), 3, 0)
            || test_pixelshuffle(RandomMat(7, 7, 72), 3, 0)
-           || test_pixelshuffle(RandomMat(7, 7, 90), 3, 0);
+           || test_pixelshuffle(RandomMat(7, 7, 90), 3, 0)
+           || test_pixelshuffle(RandomMat(5, 6, 128), 4, 0)
+           || test_pixelshuffle(RandomMat(5, 6, 256), 4, 0);
 }
 
 static int test_pixelshuffle_1()
@@ -55,7 +57,9 @@ static int test_pixelshuffle_1()
            || test_pixelshuffle(RandomMat(7, 7, 32), 2, 1)
            || test_pixelshuffle(RandomMat(7, 7, 48), 2, 1)
            || test_pixelshuffle(RandomMat(7, 7, 36), 3, 1)
-           || test_pixelshuffle(RandomMat(7, 7, 90), 3, 1);
+           || test_pixelshuffle(RandomMat(7, 7, 90), 3, 1)
+           || test_pixelshuffle(RandomMat(5, 6, 128), 4, 1)
+           || test_pixelshuffle(RandomMat(5, 6, 256), 4, 1);
 }
 
 int main()
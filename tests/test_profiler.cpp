@@ -0,0 +1,148 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "datareader.h"
+#include "net.h"
+#include "profiler.h"
+#include "testutil.h"
+
+#include <stdio.h>
+#include <string.h>
+
+class DataReaderFromRandom : public ncnn::DataReader
+{
+public:
+    virtual size_t read(void* buf, size_t size) const
+    {
+        // weights as small floats, flags as zero
+        float* p = (float*)buf;
+        for (size_t i = 0; i < size / sizeof(float); i++)
+        {
+            p[i] = i == 0 ? 0.f : RandomFloat(-0.1f, 0.1f);
+        }
+        return size;
+    }
+};
+
+static int test_profiler(int use_profiler)
+{
+    static const char* param = "7767517\n"
+                               "3 3\n"
+                               "Input data 0 1 data 0=16 1=16 2=16\n"
+                               "Convolution conv 1 1 data conv 0=16 1=3 4=1 5=1 6=2304\n"
+                               "ReLU relu 1 1 conv out\n";
+
+    ncnn::Net net;
+    net.opt.num_threads = 1;
+
+    int ret = net.load_param_mem(param);
+    if (ret != 0)
+    {
+        fprintf(stderr, "load_param_mem failed\n");
+        return -1;
+    }
+
+    DataReaderFromRandom dr;
+    net.load_model(dr);
+
+    ncnn::Profiler profiler;
+
+    for (int i = 0; i < 2; i++)
+    {
+        ncnn::Extractor ex = net.create_extractor();
+        if (use_profiler)
+            ex.set_profiler(&profiler);
+
+        ex.input("data", RandomMat(16, 16, 16));
+
+        ncnn::Mat out;
+        ret = ex.extract("out", out);
+        if (ret != 0)
+        {
+            fprintf(stderr, "extract failed\n");
+            return -1;
+        }
+    }
+
+    const std::vector<ncnn::ProfilerRecord> records = profiler.records();
+
+    if (!use_profiler)
+    {
+        if (!records.empty())
+        {
+            fprintf(stderr, "test_profiler recorded %d layers while disabled\n", (int)records.size());
+            return -1;
+        }
+
+        return 0;
+    }
+
+    // conv and relu for each extract
+    if (records.size() != 4)
+    {
+        fprintf(stderr, "test_profiler expect 4 records but got %d\n", (int)records.size());
+        return -1;
+    }
+
+    for (size_t i = 0; i < records.size(); i++)
+    {
+        const ncnn::ProfilerRecord& r = records[i];
+
+        if (r.end < r.start || r.bottom_shapes.size() != 1 || r.top_shapes.size() != 1)
+        {
+            fprintf(stderr, "test_profiler record %d malformed\n", (int)i);
+            return -1;
+        }
+
+        const ncnn::Mat& top = r.top_shapes[0];
+        if (top.w != 16 || top.h != 16 || top.c * top.elempack != 16)
+        {
+            fprintf(stderr, "test_profiler record %d top shape %d %d %d\n", (int)i, top.w, top.h, top.c * top.elempack);
+            return -1;
+        }
+
+        if (r.type == "Convolution" && r.bytes_allocated < 16 * 16 * 16 * top.elemsize / top.elempack)
+        {
+            fprintf(stderr, "test_profiler convolution bytes_allocated %d\n", (int)r.bytes_allocated);
+            return -1;
+        }
+    }
+
+    if (profiler.save_chrome_trace("test_profiler.json") != 0 || profiler.save_summary("test_profiler.txt") != 0)
+    {
+        fprintf(stderr, "test_profiler save failed\n");
+        return -1;
+    }
+
+    remove("test_profiler.json");
+    remove("test_profiler.txt");
+
+    profiler.clear();
+    if (!profiler.records().empty())
+    {
+        fprintf(stderr, "test_profiler clear failed\n");
+        return -1;
+    }
+
+    return 0;
+}
+
+int main()
+{
+    SRAND(7767517);
+
+    return 0
+           || test_profiler(0)
+           || test_profiler(1);
+}
@@ -361,6 +361,17 @@ static int test_reduction_3()
            || test_reduction(RandomMat(127), 1.f, 1, IntArrayMat(0));
 }
 
+static int test_reduction_4()
+{
+    // large blobs exercise the chunked and tree merged paths
+    return 0
+           || test_reduction(RandomMat(40000), 1.f, 0)
+           || test_reduction(RandomMat(139, 160), 1.f, 0)
+           || test_reduction(RandomMat(139, 160), 1.f, 1, IntArrayMat(0))
+           || test_reduction(RandomMat(113, 151, 3), 2.f, 0)
+           || test_reduction(RandomMat(113, 151, 16), 1.f, 0, IntArrayMat(0));
+}
+
 int main()
 {
     SRAND(7767517);
@@ -371,7 +382,8 @@ int main()
                   || test_reduction_0()
                   || test_reduction_1()
                   || test_reduction_2()
-                  || test_reduction_3();
+                  || test_reduction_3()
+                  || test_reduction_4();
 
         if (ret != 0)
             return ret;
@@ -211,6 +211,12 @@ static int test_squeezenet(const ncnn::Option& opt, int load_model_type, float e
         squeezenet.load_param((const unsigned char*)param_data);
         squeezenet.load_model((const unsigned char*)model_data);
     }
+    if (load_model_type == 4)
+    {
+        // reference model file mapping
+        squeezenet.load_param(MODEL_DIR "/squeezenet_v1.1.param");
+        squeezenet.load_model_mmap(MODEL_DIR "/squeezenet_v1.1.bin");
+    }
 
     ncnn::Mat in = generate_ncnn_logo(ncnn::Mat::PIXEL_BGR, 227, 227);
 
@@ -220,7 +226,7 @@ static int test_squeezenet(const ncnn::Option& opt, int load_model_type, float e
     ncnn::Extractor ex = squeezenet.create_extractor();
 
     ncnn::Mat out;
-    if (load_model_type == 0 || load_model_type == 1)
+    if (load_model_type == 0 || load_model_type == 1 || load_model_type == 4)
     {
         ex.input("data", in);
         ex.extract("prob", out);
@@ -416,6 +422,157 @@ static int test_squeezenet_overwrite_softmax(const ncnn::Option& opt, int load_m
     return check_top2(cls_scores, epsilon);
 }
 
+static int test_squeezenet_memory_plan(const ncnn::Option& opt, float epsilon = 0.001)
+{
+    ncnn::Net squeezenet;
+
+    squeezenet.opt = opt;
+    squeezenet.opt.use_memory_plan = true;
+    squeezenet.opt.blob_allocator = 0;
+    squeezenet.opt.workspace_allocator = 0;
+
+    squeezenet.load_param(MODEL_DIR "/squeezenet_v1.1.param");
+    squeezenet.load_model(MODEL_DIR "/squeezenet_v1.1.bin");
+
+    ncnn::Mat in = generate_ncnn_logo(ncnn::Mat::PIXEL_BGR, 227, 227);
+
+    const float mean_vals[3] = {104.f, 117.f, 123.f};
+    in.substract_mean_normalize(mean_vals, 0);
+
+    // the first run records the plan, the following ones replay it
+    for (int i = 0; i < 3; i++)
+    {
+        ncnn::Mat out;
+        {
+            ncnn::Extractor ex = squeezenet.create_extractor();
+
+            ex.input("data", in);
+            ex.extract("prob", out);
+        }
+
+        std::vector<float> cls_scores;
+        cls_scores.resize(out.w);
+        for (int j = 0; j < out.w; j++)
+        {
+            cls_scores[j] = out[j];
+        }
+
+        int ret = check_top2(cls_scores, epsilon);
+        if (ret != 0)
+            return ret;
+    }
+
+    // drive a planner directly, so that its statistics are visible
+    ncnn::MemoryPlanAllocator planner;
+
+    squeezenet.opt.use_memory_plan = false;
+
+    for (int i = 0; i < 3; i++)
+    {
+        planner.begin();
+
+        std::vector<float> cls_scores;
+        {
+            ncnn::Extractor ex = squeezenet.create_extractor();
+            ex.set_blob_allocator(&planner);
+            ex.set_workspace_allocator(&planner);
+
+            ncnn::Mat out;
+            ex.input("data", in);
+            ex.extract("prob", out);
+
+            cls_scores.resize(out.w);
+            for (int j = 0; j < out.w; j++)
+            {
+                cls_scores[j] = out[j];
+            }
+        }
+
+        planner.end();
+
+        int ret = check_top2(cls_scores, epsilon);
+        if (ret != 0)
+            return ret;
+
+        if (i == 0)
+        {
+            fprintf(stderr, "test_squeezenet_memory_plan planned peak %zu bytes\n", planner.arena_size());
+
+            if (planner.arena_size() == 0)
+            {
+                fprintf(stderr, "test_squeezenet_memory_plan got an empty arena\n");
+                return -1;
+            }
+        }
+        else if (planner.heap_allocation_count() != 0)
+        {
+            // a replayed inference must be served from the arena entirely
+            fprintf(stderr, "test_squeezenet_memory_plan replay %d made %zu heap allocations\n", i, planner.heap_allocation_count());
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+static int test_squeezenet_batch(const ncnn::Option& opt, float epsilon = 0.001)
+{
+    ncnn::Net squeezenet;
+
+    squeezenet.opt = opt;
+
+    squeezenet.load_param(MODEL_DIR "/squeezenet_v1.1.param");
+    squeezenet.load_model(MODEL_DIR "/squeezenet_v1.1.bin");
+
+    ncnn::Mat in = generate_ncnn_logo(ncnn::Mat::PIXEL_BGR, 227, 227);
+
+    const float mean_vals[3] = {104.f, 117.f, 123.f};
+    in.substract_mean_normalize(mean_vals, 0);
+
+    const int batch = 3;
+
+    std::vector<ncnn::Mat> ins(batch);
+    for (int i = 0; i < batch; i++)
+    {
+        ins[i] = in.clone();
+    }
+
+    std::vector<ncnn::Mat> outs;
+    {
+        ncnn::Extractor ex = squeezenet.create_extractor();
+
+        int ret = ex.input_batch("data", ins);
+        if (ret != 0)
+            return ret;
+
+        ret = ex.extract_batch("prob", outs);
+        if (ret != 0)
+            return ret;
+    }
+
+    if ((int)outs.size() != batch)
+    {
+        fprintf(stderr, "extract_batch expect %d outputs but got %d\n", batch, (int)outs.size());
+        return -1;
+    }
+
+    for (int i = 0; i < batch; i++)
+    {
+        std::vector<float> cls_scores;
+        cls_scores.resize(outs[i].w);
+        for (int j = 0; j < outs[i].w; j++)
+        {
+            cls_scores[j] = outs[i][j];
+        }
+
+        int ret = check_top2(cls_scores, epsilon);
+        if (ret != 0)
+            return ret;
+    }
+
+    return 0;
+}
+
 int main()
 {
     SRAND(7767517);
@@ -525,5 +682,56 @@ int main()
 #endif // NCNN_VULKAN
     }
 
+    {
+        // run fire module branches concurrently
+        ncnn::PoolAllocator g_blob_locked_pool_allocator;
+
+        ncnn::Option opt_cpu = opts[1];
+        opt_cpu.num_threads = 4;
+        opt_cpu.use_parallel_graph = true;
+        opt_cpu.blob_allocator = &g_blob_locked_pool_allocator;
+        opt_cpu.workspace_allocator = &g_workspace_pool_allocator;
+
+        for (int i = 0; i < 4; i++)
+        {
+            int ret = test_squeezenet(opt_cpu, load_model_types[i], 0.01);
+            if (ret != 0)
+            {
+                fprintf(stderr, "test_squeezenet cpu failed use_parallel_graph=1 load_model_type=%d\n", load_model_types[i]);
+                return ret;
+            }
+        }
+    }
+
+    for (int i = 0; i < 4; i++)
+    {
+        const ncnn::Option& opt = opts[i];
+
+        float epsilon = opt.use_fp16_packed || opt.use_fp16_storage ? 0.1 : 0.01;
+
+        ncnn::Option opt_cpu = opt;
+        opt_cpu.use_vulkan_compute = false;
+        int ret = test_squeezenet_memory_plan(opt_cpu, epsilon);
+        if (ret != 0)
+        {
+            fprintf(stderr, "test_squeezenet_memory_plan cpu failed use_packing_layout=%d use_fp16_packed=%d use_fp16_storage=%d\n", opt.use_packing_layout, opt.use_fp16_packed, opt.use_fp16_storage);
+            return ret;
+        }
+
+        ret = test_squeezenet_batch(opt_cpu, epsilon);
+        if (ret != 0)
+        {
+            fprintf(stderr, "test_squeezenet_batch cpu failed use_packing_layout=%d use_fp16_packed=%d use_fp16_storage=%d\n", opt.use_packing_layout, opt.use_fp16_packed, opt.use_fp16_storage);
+            return ret;
+        }
+
+        ret = test_squeezenet(opt_cpu, 4, epsilon);
+        if (ret != 0)
+        {
+            fprintf(stderr, "test_squeezenet cpu failed load_model_mmap use_packing_layout=%d use_fp16_packed=%d use_fp16_storage=%d\n", opt.use_packing_layout, opt.use_fp16_packed, opt.use_fp16_storage);
+            return ret;
+        }
+    }
+
     return 0;
 }
@@ -211,7 +211,7 @@ public:
     ncnn::ParamDict mpd;
 };
 
-DEFINE_LAYER_CREATOR(CustomLayer)
+static DEFINE_LAYER_CREATOR(CustomLayer)
 
 class ModelWriter : public ncnn::Net
 {
@@ -251,7 +251,7 @@ public:
     int save(const char* parampath, const char* binpath);
 };
 
-ModelWriter::ModelWriter()
+inline ModelWriter::ModelWriter()
     : blobs(mutable_blobs()), layers(mutable_layers())
 {
     opt.lightmode = false;
@@ -263,7 +263,7 @@ ModelWriter::ModelWriter()
     SRAND(7767517);
 }
 
-ncnn::Layer* ModelWriter::create_custom_layer(const char* type)
+inline ncnn::Layer* ModelWriter::create_custom_layer(const char* type)
 {
     ncnn::Layer* layer = Net::create_custom_layer(type);
     if (layer)
@@ -278,7 +278,7 @@ ncnn::Layer* ModelWriter::create_custom_layer(const char* type)
     return Net::create_custom_layer(type);
 }
 
-int ModelWriter::set_cutparam(const char* cutstartname, const char* cutendname)
+inline int ModelWriter::set_cutparam(const char* cutstartname, const char* cutendname)
 {
     if (cutstartname != nullptr)
     {
@@ -313,7 +313,7 @@ int ModelWriter::set_cutparam(const char* cutstartname, const char* cutendname)
     return 0;
 }
 
-int ModelWriter::shape_inference()
+inline int ModelWriter::shape_inference()
 {
     if (has_custom_layer)
     {
@@ -450,7 +450,7 @@ int ModelWriter::shape_inference()
     return 0;
 }
 
-int ModelWriter::estimate_memory_footprint()
+inline int ModelWriter::estimate_memory_footprint()
 {
     if (has_custom_layer)
     {
@@ -532,7 +532,7 @@ int ModelWriter::estimate_memory_footprint()
     return 0;
 }
 
-int ModelWriter::fprintf_param_int_array(int id, const ncnn::Mat& m, FILE* pp)
+inline int ModelWriter::fprintf_param_int_array(int id, const ncnn::Mat& m, FILE* pp)
 {
     const int count = m.w;
     const int* ptr = m;
@@ -546,7 +546,7 @@ int ModelWriter::fprintf_param_int_array(int id, const ncnn::Mat& m, FILE* pp)
     return 0;
 }
 
-int ModelWriter::fprintf_param_float_array(int id, const ncnn::Mat& m, FILE* pp)
+inline int ModelWriter::fprintf_param_float_array(int id, const ncnn::Mat& m, FILE* pp)
 {
     const int count = m.w;
     const float* ptr = m;
@@ -614,7 +614,7 @@ static void Randomize(ncnn::Mat& m, float a = -1.2f, float b = 1.2f)
     }
 }
 
-int ModelWriter::fwrite_weight_tag_data(const ncnn::Mat& data, FILE* bp, float a, float b)
+inline int ModelWriter::fwrite_weight_tag_data(const ncnn::Mat& data, FILE* bp, float a, float b)
 {
     int p0 = ftell(bp);
 
@@ -666,7 +666,7 @@ int ModelWriter::fwrite_weight_tag_data(const ncnn::Mat& data, FILE* bp, float a
     return 0;
 }
 
-int ModelWriter::fwrite_weight_data(const ncnn::Mat& data, FILE* bp, float a, float b)
+inline int ModelWriter::fwrite_weight_data(const ncnn::Mat& data, FILE* bp, float a, float b)
 {
     int p0 = ftell(bp);
 
@@ -690,7 +690,7 @@ int ModelWriter::fwrite_weight_data(const ncnn::Mat& data, FILE* bp, float a, fl
     return 0;
 }
 
-int ModelWriter::save(const char* parampath, const char* binpath)
+inline int ModelWriter::save(const char* parampath, const char* binpath)
 {
     uint64_t mac = 0;
 
@@ -1773,6 +1773,7 @@ int ModelWriter::save(const char* parampath, const char* binpath)
             fprintf_param_value(" 12=%d", output_elempack)
             fprintf_param_value(" 13=%d", output_elemtype)
             fprintf_param_value(" 14=%d", output_transpose)
+            fprintf_param_value(" 18=%d", int8_scale_term)
             fprintf_param_value(" 20=%d", constant_TILE_M)
             fprintf_param_value(" 21=%d", constant_TILE_N)
             fprintf_param_value(" 22=%d", constant_TILE_K)
@@ -1789,6 +1790,34 @@ int ModelWriter::save(const char* parampath, const char* binpath)
             {
                 fwrite_weight_tag_data(op->C_data, bp);
             }
+
+#if NCNN_INT8
+            // write int8_scale data
+            if (op->int8_scale_term)
+            {
+                ncnn::Mat B_data_int8_scales(1, (void*)&op->B_data_int8_scale);
+
+                if (op->constantA == 1)
+                {
+                    fwrite_weight_data(op->A_data_int8_scales, bp, 90, 100);
+                }
+                if (op->constantB == 1)
+                {
+                    fwrite_weight_data(B_data_int8_scales, bp, 90, 100);
+                }
+                if (op->int8_scale_term == 3)
+                {
+                    if (op->constantA == 0)
+                    {
+                        fwrite_weight_data(op->A_data_int8_scales, bp, 0.001, 1);
+                    }
+                    if (op->constantB == 0)
+                    {
+                        fwrite_weight_data(B_data_int8_scales, bp, 0.001, 1);
+                    }
+                }
+            }
+#endif // NCNN_INT8
         }
         else if (layer->type == "GLU")
         {
@@ -2503,6 +2532,11 @@ int ModelWriter::save(const char* parampath, const char* binpath)
 
 #undef fprintf_param_value
 
+        if (layer->featmask != 0)
+        {
+            fprintf(pp, " 31=%d", layer->featmask);
+        }
+
         fprintf(pp, "\n");
 
         delete layer_default;
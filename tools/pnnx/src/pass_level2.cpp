@@ -745,7 +745,17 @@ static bool match(const Operator* anchor, const Operator* pattern, std::map<std:
 
     for (size_t i = 0; i < pattern->outputs.size(); i++)
     {
-        if (pattern->outputs[i]->consumers.size() == 1 && pattern->outputs[i]->consumers[0]->type == "pnnx.Output")
+        bool is_pattern_output = false;
+        for (const Operator* x : pattern->outputs[i]->consumers)
+        {
+            if (x->type == "pnnx.Output")
+            {
+                is_pattern_output = true;
+                break;
+            }
+        }
+
+        if (is_pattern_output)
         {
             if (matched_outputs.find(pattern->outputs[i]->name) == matched_outputs.end())
             {
@@ -755,6 +765,11 @@ static bool match(const Operator* anchor, const Operator* pattern, std::map<std:
             {
                 return false;
             }
+
+            // output also consumed inside pattern, like the updated kv cache feeding attention
+            if (anchor->outputs[i]->consumers.size() < pattern->outputs[i]->consumers.size() - 1)
+                return false;
+
             continue;
         }
 
@@ -954,7 +969,17 @@ void pnnx_graph_rewrite(Graph& graph, const GraphRewriterPass* pass, int& opinde
                     }
                 }
 
-                if (!is_input)
+                bool is_output = false;
+                for (auto& r2 : matched_outputs)
+                {
+                    if (r2.second == r)
+                    {
+                        is_output = true;
+                        break;
+                    }
+                }
+
+                if (!is_input && !is_output)
                     operands_to_remove[r->name] = r;
             }
 
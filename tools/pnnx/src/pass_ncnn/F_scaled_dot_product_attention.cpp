@@ -218,6 +218,134 @@ pnnx.Output             output      1 0 out
 
 REGISTER_GLOBAL_PNNX_NCNN_GRAPH_REWRITER_PASS(F_scaled_dot_product_attention_3, 10)
 
+class F_scaled_dot_product_attention_4 : public F_scaled_dot_product_attention
+{
+public:
+    // self attention decoding step with past key value cache
+    // the updated caches become the second and third outputs of MultiHeadAttention
+    const char* match_pattern_graph() const
+    {
+        return R"PNNXIR(7767517
+19 18
+pnnx.Input              input_0     0 1 input
+pnnx.Input              input_1     0 1 past_k
+pnnx.Input              input_2     0 1 past_v
+nn.Linear               op_0        1 1 input q bias=%qbias in_features=%qdim out_features=%embed_dim @bias @weight
+nn.Linear               op_1        1 1 input k bias=%kbias in_features=%kdim out_features=%embed_dim @bias @weight
+nn.Linear               op_2        1 1 input v bias=%vbias in_features=%vdim out_features=%embed_dim @bias @weight
+Tensor.reshape          op_3        1 1 q 10 shape=(%batch,%size,%num_heads,%feat_per_head)
+Tensor.reshape          op_4        1 1 k 12 shape=(%batch,%size,%num_heads,%feat_per_head)
+Tensor.reshape          op_5        1 1 v 14 shape=(%batch,%size,%num_heads,%feat_per_head)
+Tensor.permute          op_6        1 1 10 16 dims=(0,2,1,3)
+Tensor.permute          op_7        1 1 12 17 dims=(0,2,1,3)
+Tensor.permute          op_8        1 1 14 18 dims=(0,2,1,3)
+torch.cat               op_9        2 1 past_k 17 k_cache dim=2
+torch.cat               op_10       2 1 past_v 18 v_cache dim=2
+F.scaled_dot_product_attention op_11 3 1 16 k_cache v_cache 19 dropout_p=0.0 is_causal=False attn_mask=None scale=%scale
+Tensor.permute          op_12       1 1 19 20 dims=(0,2,1,3)
+Tensor.reshape          op_13       1 1 20 21 shape=(%batch,%size,%embed_dim)
+nn.Linear               out_proj    1 1 21 out bias=%outbias in_features=%embed_dim out_features=%qdim @bias @weight
+pnnx.Output             output      3 0 out k_cache v_cache
+)PNNXIR";
+    }
+
+    const char* replace_pattern_graph() const
+    {
+        // torch caches are (batch,num_heads,seqlen,feat_per_head) while MultiHeadAttention caches are w=seqlen h=embed_dim
+        return R"PNNXIR(7767517
+13 14
+pnnx.Input              input_0     0 1 input
+pnnx.Input              input_1     0 1 past_k
+pnnx.Input              input_2     0 1 past_v
+Permute                 past_k_permute 1 1 past_k 22 0=1
+Reshape                 past_k_reshape 1 1 22 23 0=-1 1=%embed_dim
+Permute                 past_v_permute 1 1 past_v 24 0=1
+Reshape                 past_v_reshape 1 1 24 25 0=-1 1=%embed_dim
+MultiHeadAttention      sdpa_attention 3 3 input 23 25 out 26 27
+Reshape                 k_cache_reshape 1 1 26 28 0=-1 1=%feat_per_head 2=%num_heads
+Permute                 k_cache_permute 1 1 28 k_cache 0=1
+Reshape                 v_cache_reshape 1 1 27 29 0=-1 1=%feat_per_head 2=%num_heads
+Permute                 v_cache_permute 1 1 29 v_cache 0=1
+pnnx.Output             output      3 0 out k_cache v_cache
+)PNNXIR";
+    }
+
+    void write(const std::map<std::string, Operator*>& ops, const std::map<std::string, Parameter>& captured_params, const std::map<std::string, Attribute>& captured_attrs) const
+    {
+        GraphRewriterPass::write(ops, captured_params, captured_attrs);
+
+        Operator* op = ops.at("sdpa_attention");
+        F_scaled_dot_product_attention::write(op, captured_params, captured_attrs);
+        op->params["5"] = 0;
+        op->params["7"] = 1;
+    }
+};
+
+REGISTER_GLOBAL_PNNX_NCNN_GRAPH_REWRITER_PASS(F_scaled_dot_product_attention_4, 10)
+
+class F_scaled_dot_product_attention_5 : public F_scaled_dot_product_attention
+{
+public:
+    const char* match_pattern_graph() const
+    {
+        return R"PNNXIR(7767517
+20 19
+pnnx.Input              input_0     0 1 input
+pnnx.Input              input_1     0 1 attn_mask
+pnnx.Input              input_2     0 1 past_k
+pnnx.Input              input_3     0 1 past_v
+nn.Linear               op_0        1 1 input q bias=%qbias in_features=%qdim out_features=%embed_dim @bias @weight
+nn.Linear               op_1        1 1 input k bias=%kbias in_features=%kdim out_features=%embed_dim @bias @weight
+nn.Linear               op_2        1 1 input v bias=%vbias in_features=%vdim out_features=%embed_dim @bias @weight
+Tensor.reshape          op_3        1 1 q 10 shape=(%batch,%size,%num_heads,%feat_per_head)
+Tensor.reshape          op_4        1 1 k 12 shape=(%batch,%size,%num_heads,%feat_per_head)
+Tensor.reshape          op_5        1 1 v 14 shape=(%batch,%size,%num_heads,%feat_per_head)
+Tensor.permute          op_6        1 1 10 16 dims=(0,2,1,3)
+Tensor.permute          op_7        1 1 12 17 dims=(0,2,1,3)
+Tensor.permute          op_8        1 1 14 18 dims=(0,2,1,3)
+torch.cat               op_9        2 1 past_k 17 k_cache dim=2
+torch.cat               op_10       2 1 past_v 18 v_cache dim=2
+F.scaled_dot_product_attention op_11 4 1 16 k_cache v_cache attn_mask 19 dropout_p=0.0 is_causal=False scale=%scale
+Tensor.permute          op_12       1 1 19 20 dims=(0,2,1,3)
+Tensor.reshape          op_13       1 1 20 21 shape=(%batch,%size,%embed_dim)
+nn.Linear               out_proj    1 1 21 out bias=%outbias in_features=%embed_dim out_features=%qdim @bias @weight
+pnnx.Output             output      3 0 out k_cache v_cache
+)PNNXIR";
+    }
+
+    const char* replace_pattern_graph() const
+    {
+        return R"PNNXIR(7767517
+14 15
+pnnx.Input              input_0     0 1 input
+pnnx.Input              input_1     0 1 attn_mask
+pnnx.Input              input_2     0 1 past_k
+pnnx.Input              input_3     0 1 past_v
+Permute                 past_k_permute 1 1 past_k 22 0=1
+Reshape                 past_k_reshape 1 1 22 23 0=-1 1=%embed_dim
+Permute                 past_v_permute 1 1 past_v 24 0=1
+Reshape                 past_v_reshape 1 1 24 25 0=-1 1=%embed_dim
+MultiHeadAttention      sdpa_attention 4 3 input attn_mask 23 25 out 26 27
+Reshape                 k_cache_reshape 1 1 26 28 0=-1 1=%feat_per_head 2=%num_heads
+Permute                 k_cache_permute 1 1 28 k_cache 0=1
+Reshape                 v_cache_reshape 1 1 27 29 0=-1 1=%feat_per_head 2=%num_heads
+Permute                 v_cache_permute 1 1 29 v_cache 0=1
+pnnx.Output             output      3 0 out k_cache v_cache
+)PNNXIR";
+    }
+
+    void write(const std::map<std::string, Operator*>& ops, const std::map<std::string, Parameter>& captured_params, const std::map<std::string, Attribute>& captured_attrs) const
+    {
+        GraphRewriterPass::write(ops, captured_params, captured_attrs);
+
+        Operator* op = ops.at("sdpa_attention");
+        F_scaled_dot_product_attention::write(op, captured_params, captured_attrs);
+        op->params["7"] = 1;
+    }
+};
+
+REGISTER_GLOBAL_PNNX_NCNN_GRAPH_REWRITER_PASS(F_scaled_dot_product_attention_5, 10)
+
 } // namespace ncnn
 
 } // namespace pnnx
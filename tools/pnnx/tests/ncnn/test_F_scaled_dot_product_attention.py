@@ -0,0 +1,121 @@
+# Tencent is pleased to support the open source community by making ncnn available.
+#
+# Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+#
+# Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+# in compliance with the License. You may obtain a copy of the License at
+#
+# https://opensource.org/licenses/BSD-3-Clause
+#
+# Unless required by applicable law or agreed to in writing, software distributed
+# under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+# CONDITIONS OF ANY KIND, either express or implied. See the License for the
+# specific language governing permissions and limitations under the License.
+
+import torch
+import torch.nn as nn
+import torch.nn.functional as F
+from packaging import version
+
+class CachedAttention(nn.Module):
+    def __init__(self, embed_dim, num_heads):
+        super(CachedAttention, self).__init__()
+
+        self.num_heads = num_heads
+        self.feat_per_head = embed_dim // num_heads
+        self.scale = 1.0 / (self.feat_per_head ** 0.5)
+
+        self.q_proj = nn.Linear(embed_dim, embed_dim)
+        self.k_proj = nn.Linear(embed_dim, embed_dim)
+        self.v_proj = nn.Linear(embed_dim, embed_dim)
+        self.out_proj = nn.Linear(embed_dim, embed_dim)
+
+    def forward(self, x, past_k, past_v, attn_mask=None):
+        batch, size, embed_dim = x.shape
+
+        q = self.q_proj(x).reshape(batch, size, self.num_heads, self.feat_per_head).permute(0, 2, 1, 3)
+        k = self.k_proj(x).reshape(batch, size, self.num_heads, self.feat_per_head).permute(0, 2, 1, 3)
+        v = self.v_proj(x).reshape(batch, size, self.num_heads, self.feat_per_head).permute(0, 2, 1, 3)
+
+        k = torch.cat((past_k, k), dim=2)
+        v = torch.cat((past_v, v), dim=2)
+
+        if attn_mask is None:
+            o = F.scaled_dot_product_attention(q, k, v, scale=self.scale)
+        else:
+            o = F.scaled_dot_product_attention(q, k, v, attn_mask=attn_mask, scale=self.scale)
+
+        o = o.permute(0, 2, 1, 3).reshape(batch, size, embed_dim)
+        o = self.out_proj(o)
+
+        return o, k, v
+
+class Model(nn.Module):
+    def __init__(self):
+        super(Model, self).__init__()
+
+        self.attention_0 = CachedAttention(embed_dim=64, num_heads=4)
+        self.attention_1 = CachedAttention(embed_dim=32, num_heads=2)
+        self.attention_2 = CachedAttention(embed_dim=64, num_heads=8)
+
+    def forward(self, x, xk, xv, y, yk, yv, ymask, z, zk, zv):
+        x, xk, xv = self.attention_0(x, xk, xv)
+        y, yk, yv = self.attention_1(y, yk, yv, ymask)
+
+        # the updated cache also feeds an op outside the attention pattern
+        z, zk, zv = self.attention_2(z, zk, zv)
+        zk2 = zk * 2 - 1
+
+        return x, xk, xv, y, yk, yv, z, zk, zv, zk2
+
+def test():
+    if version.parse(torch.__version__) < version.parse('2.1'):
+        return True
+
+    net = Model()
+    net.eval()
+
+    torch.manual_seed(0)
+    x = torch.rand(1, 3, 64)
+    xk = torch.rand(1, 4, 8, 16)
+    xv = torch.rand(1, 4, 8, 16)
+    y = torch.rand(1, 5, 32)
+    yk = torch.rand(1, 2, 7, 16)
+    yv = torch.rand(1, 2, 7, 16)
+    ymask = torch.rand(5, 12)
+    z = torch.rand(1, 2, 64)
+    zk = torch.rand(1, 8, 9, 8)
+    zv = torch.rand(1, 8, 9, 8)
+
+    a = net(x, xk, xv, y, yk, yv, ymask, z, zk, zv)
+
+    # export torchscript
+    mod = torch.jit.trace(net, (x, xk, xv, y, yk, yv, ymask, z, zk, zv))
+    mod.save("test_F_scaled_dot_product_attention.pt")
+
+    # torchscript to pnnx
+    import os
+    os.system("../../src/pnnx test_F_scaled_dot_product_attention.pt inputshape=[1,3,64],[1,4,8,16],[1,4,8,16],[1,5,32],[1,2,7,16],[1,2,7,16],[5,12],[1,2,64],[1,8,9,8],[1,8,9,8]")
+
+    # the kv cache patterns must be fused into MultiHeadAttention with kv_cache=1
+    with open("test_F_scaled_dot_product_attention.ncnn.param") as f:
+        param = f.read()
+        if param.count("MultiHeadAttention") != 3 or param.count(" 7=1") != 3:
+            return False
+
+    # ncnn inference
+    import test_F_scaled_dot_product_attention_ncnn
+    b = test_F_scaled_dot_product_attention_ncnn.test_inference()
+
+    for a0, b0 in zip(a, b):
+        if not torch.allclose(a0, b0, 1e-4, 1e-4):
+            print(a0)
+            print(b0)
+            return False
+    return True
+
+if __name__ == "__main__":
+    if test():
+        exit(0)
+    else:
+        exit(1)
@@ -0,0 +1,369 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// author:BUG1989 (https://github.com/BUG1989/) Long-term support.
+// author:JansonZhu (https://github.com/JansonZhu) Implemented the function of entropy calibration.
+//
+// Copyright (C) 2019 BUG1989. All rights reserved.
+// Copyright (C) 2021 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef NCNN_QUANTIZE_CALIBRATION_H
+#define NCNN_QUANTIZE_CALIBRATION_H
+
+// calibration image list and preprocessing arguments shared by the quantize tools
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(USE_NCNN_SIMPLEOCV)
+#include "simpleocv.h"
+#elif defined(USE_LOCAL_IMREADWRITE)
+#include "imreadwrite.h"
+#else
+#include <opencv2/core/core.hpp>
+#include <opencv2/highgui/highgui.hpp>
+#endif
+#include <string>
+#include <vector>
+
+#include "mat.h"
+
+/**
+ * Read and resize image
+ * shape is input as [w,h,...]
+ * if w and h both are given, image will be resized to exactly size.
+ * if w and h both are zero or negative, image will not be resized.
+ * if only h is zero or negative, image's width will scaled resize to w, keeping aspect ratio.
+ * if only w is zero or negative, image's height will scaled resize to h
+ * @return ncnn::Mat
+ */
+
+inline ncnn::Mat read_and_resize_image(const std::vector<int>& shape, const std::string& imagepath, int pixel_convert_type)
+{
+    int target_w = shape[0];
+    int target_h = shape[1];
+    cv::Mat bgr = cv::imread(imagepath, 1);
+    if (bgr.empty())
+    {
+        return ncnn::Mat();
+    }
+    if (target_h <= 0 && target_w <= 0)
+    {
+        return ncnn::Mat::from_pixels(bgr.data, pixel_convert_type, bgr.cols, bgr.rows);
+    }
+    if (target_h <= 0 || target_w <= 0)
+    {
+        float scale = 1.0;
+        if (target_h <= 0)
+        {
+            scale = 1.0 * bgr.cols / target_w;
+            target_h = int(1.0 * bgr.rows / scale);
+        }
+        if (target_w <= 0)
+        {
+            scale = 1.0 * bgr.rows / target_h;
+            target_w = int(1.0 * bgr.cols / scale);
+        }
+    }
+    return ncnn::Mat::from_pixels_resize(bgr.data, pixel_convert_type, bgr.cols, bgr.rows, target_w, target_h);
+}
+
+static inline std::vector<std::vector<std::string> > parse_comma_path_list(char* s)
+{
+    std::vector<std::vector<std::string> > aps;
+
+    char* pch = strtok(s, ",");
+    while (pch != NULL)
+    {
+        FILE* fp = fopen(pch, "rb");
+        if (!fp)
+        {
+            fprintf(stderr, "fopen %s failed\n", pch);
+            break;
+        }
+
+        std::vector<std::string> paths;
+
+        // one filepath per line
+        char line[1024];
+        while (!feof(fp))
+        {
+            char* ss = fgets(line, 1024, fp);
+            if (!ss)
+                break;
+
+            char filepath[256];
+            int nscan = sscanf(line, "%255s", filepath);
+            if (nscan != 1)
+                continue;
+
+            paths.push_back(std::string(filepath));
+        }
+
+        fclose(fp);
+
+        aps.push_back(paths);
+
+        pch = strtok(NULL, ",");
+    }
+
+    return aps;
+}
+
+static inline float vstr_to_float(const char vstr[20])
+{
+    double v = 0.0;
+
+    const char* p = vstr;
+
+    // sign
+    bool sign = *p != '-';
+    if (*p == '+' || *p == '-')
+    {
+        p++;
+    }
+
+    // digits before decimal point or exponent
+    uint64_t v1 = 0;
+    while (isdigit(*p))
+    {
+        v1 = v1 * 10 + (*p - '0');
+        p++;
+    }
+
+    v = (double)v1;
+
+    // digits after decimal point
+    if (*p == '.')
+    {
+        p++;
+
+        uint64_t pow10 = 1;
+        uint64_t v2 = 0;
+
+        while (isdigit(*p))
+        {
+            v2 = v2 * 10 + (*p - '0');
+            pow10 *= 10;
+            p++;
+        }
+
+        v += v2 / (double)pow10;
+    }
+
+    // exponent
+    if (*p == 'e' || *p == 'E')
+    {
+        p++;
+
+        // sign of exponent
+        bool fact = *p != '-';
+        if (*p == '+' || *p == '-')
+        {
+            p++;
+        }
+
+        // digits of exponent
+        uint64_t expon = 0;
+        while (isdigit(*p))
+        {
+            expon = expon * 10 + (*p - '0');
+            p++;
+        }
+
+        double scale = 1.0;
+        while (expon >= 8)
+        {
+            scale *= 1e8;
+            expon -= 8;
+        }
+        while (expon > 0)
+        {
+            scale *= 10.0;
+            expon -= 1;
+        }
+
+        v = fact ? v * scale : v / scale;
+    }
+
+    //     fprintf(stderr, "v = %f\n", v);
+    return sign ? (float)v : (float)-v;
+}
+
+static inline std::vector<std::vector<float> > parse_comma_float_array_list(char* s)
+{
+    std::vector<std::vector<float> > aaf;
+
+    char* pch = strtok(s, "[]");
+    while (pch != NULL)
+    {
+        // parse a,b,c
+        char vstr[20];
+        int nconsumed = 0;
+        int nscan = sscanf(pch, "%19[^,]%n", vstr, &nconsumed);
+        if (nscan == 1)
+        {
+            // ok we get array
+            pch += nconsumed;
+
+            std::vector<float> af;
+            float v = vstr_to_float(vstr);
+            af.push_back(v);
+
+            nscan = sscanf(pch, ",%19[^,]%n", vstr, &nconsumed);
+            while (nscan == 1)
+            {
+                pch += nconsumed;
+
+                float v = vstr_to_float(vstr);
+                af.push_back(v);
+
+                nscan = sscanf(pch, ",%19[^,]%n", vstr, &nconsumed);
+            }
+
+            // array end
+            aaf.push_back(af);
+        }
+
+        pch = strtok(NULL, "[]");
+    }
+
+    return aaf;
+}
+
+static inline std::vector<std::vector<int> > parse_comma_int_array_list(char* s)
+{
+    std::vector<std::vector<int> > aai;
+
+    char* pch = strtok(s, "[]");
+    while (pch != NULL)
+    {
+        // parse a,b,c
+        int v;
+        int nconsumed = 0;
+        int nscan = sscanf(pch, "%d%n", &v, &nconsumed);
+        if (nscan == 1)
+        {
+            // ok we get array
+            pch += nconsumed;
+
+            std::vector<int> ai;
+            ai.push_back(v);
+
+            nscan = sscanf(pch, ",%d%n", &v, &nconsumed);
+            while (nscan == 1)
+            {
+                pch += nconsumed;
+
+                ai.push_back(v);
+
+                nscan = sscanf(pch, ",%d%n", &v, &nconsumed);
+            }
+
+            // array end
+            aai.push_back(ai);
+        }
+
+        pch = strtok(NULL, "[]");
+    }
+
+    return aai;
+}
+
+static inline std::vector<int> parse_comma_pixel_type_list(char* s)
+{
+    std::vector<int> aps;
+
+    char* pch = strtok(s, ",");
+    while (pch != NULL)
+    {
+        // RAW/RGB/BGR/GRAY/RGBA/BGRA
+        if (strcmp(pch, "RAW") == 0)
+            aps.push_back(-233);
+        if (strcmp(pch, "RGB") == 0)
+            aps.push_back(ncnn::Mat::PIXEL_RGB);
+        if (strcmp(pch, "BGR") == 0)
+            aps.push_back(ncnn::Mat::PIXEL_BGR);
+        if (strcmp(pch, "GRAY") == 0)
+            aps.push_back(ncnn::Mat::PIXEL_GRAY);
+        if (strcmp(pch, "RGBA") == 0)
+            aps.push_back(ncnn::Mat::PIXEL_RGBA);
+        if (strcmp(pch, "BGRA") == 0)
+            aps.push_back(ncnn::Mat::PIXEL_BGRA);
+
+        pch = strtok(NULL, ",");
+    }
+
+    return aps;
+}
+
+static inline void print_float_array_list(const std::vector<std::vector<float> >& list)
+{
+    for (size_t i = 0; i < list.size(); i++)
+    {
+        const std::vector<float>& array = list[i];
+        fprintf(stderr, "[");
+        for (size_t j = 0; j < array.size(); j++)
+        {
+            fprintf(stderr, "%f", array[j]);
+            if (j != array.size() - 1)
+                fprintf(stderr, ",");
+        }
+        fprintf(stderr, "]");
+        if (i != list.size() - 1)
+            fprintf(stderr, ",");
+    }
+}
+
+static inline void print_int_array_list(const std::vector<std::vector<int> >& list)
+{
+    for (size_t i = 0; i < list.size(); i++)
+    {
+        const std::vector<int>& array = list[i];
+        fprintf(stderr, "[");
+        for (size_t j = 0; j < array.size(); j++)
+        {
+            fprintf(stderr, "%d", array[j]);
+            if (j != array.size() - 1)
+                fprintf(stderr, ",");
+        }
+        fprintf(stderr, "]");
+        if (i != list.size() - 1)
+            fprintf(stderr, ",");
+    }
+}
+
+static inline void print_pixel_type_list(const std::vector<int>& list)
+{
+    for (size_t i = 0; i < list.size(); i++)
+    {
+        const int type = list[i];
+        if (type == -233)
+            fprintf(stderr, "RAW");
+        if (type == ncnn::Mat::PIXEL_RGB)
+            fprintf(stderr, "RGB");
+        if (type == ncnn::Mat::PIXEL_BGR)
+            fprintf(stderr, "BGR");
+        if (type == ncnn::Mat::PIXEL_GRAY)
+            fprintf(stderr, "GRAY");
+        if (type == ncnn::Mat::PIXEL_RGBA)
+            fprintf(stderr, "RGBA");
+        if (type == ncnn::Mat::PIXEL_BGRA)
+            fprintf(stderr, "BGRA");
+        if (i != list.size() - 1)
+            fprintf(stderr, ",");
+    }
+}
+
+#endif // NCNN_QUANTIZE_CALIBRATION_H
@@ -0,0 +1,650 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2024 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifdef _MSC_VER
+#define _CRT_SECURE_NO_DEPRECATE
+#endif
+
+#include <float.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+// ncnn public header
+#include "benchmark.h"
+#include "cpu.h"
+#include "net.h"
+
+#include "calibration.h"
+#include "netquantize.h"
+
+// mixed precision search
+//
+// every layer runs in one of fp32, reduced precision (fp16 or bf16 storage) or int8
+// the accuracy cost and the latency gain of each layer choice are measured one at a time
+// on the calibration images with the real cpu kernels, against the all fp32 net
+// then the cheapest choices are combined greedily under the accuracy budget
+// and the combination is verified end to end, backing off the worst layers if needed
+//
+// fp32 layers get featmask 31=7 (no fp16 arithmetic / fp16 storage / bf16 storage)
+// int8 layers are quantized with the calibration table in the written model
+
+enum
+{
+    PRECISION_FP32 = 0,
+    PRECISION_LOWP = 1,
+    PRECISION_INT8 = 2
+};
+
+static const char* precision_name(int precision, int lowp)
+{
+    if (precision == PRECISION_INT8)
+        return "int8";
+    if (precision == PRECISION_LOWP)
+        return lowp == 2 ? "bf16" : "fp16";
+    return "fp32";
+}
+
+struct PrecisionChoice
+{
+    int layer_index;
+    int precision;
+
+    // 1 - cosine similarity of the net outputs against fp32
+    float error;
+
+    // latency saved against the all fp32 net in ms
+    double gain;
+};
+
+static bool compare_choice_efficiency(const PrecisionChoice& a, const PrecisionChoice& b)
+{
+    // the most latency saved per accuracy lost first
+    return a.gain * (b.error + 1e-6f) > b.gain * (a.error + 1e-6f);
+}
+
+class MixedPrecisionSearch
+{
+public:
+    MixedPrecisionSearch();
+
+public:
+    // fp32 model
+    std::string inparam;
+    std::string inbin;
+
+    // where the candidate models are written, and the final one
+    std::string outparam;
+    std::string outbin;
+
+    std::map<std::string, ncnn::Mat> blob_int8scale_table;
+    std::map<std::string, ncnn::Mat> weight_int8scale_table;
+
+    std::vector<std::vector<std::string> > listspaths;
+    std::vector<std::vector<float> > means;
+    std::vector<std::vector<float> > norms;
+    std::vector<std::vector<int> > shapes;
+    std::vector<int> type_to_pixels;
+
+    int num_threads;
+    // 0=none 1=fp16 2=bf16
+    int lowp;
+    float accuracy;
+    int image_count;
+    int loop_count;
+
+public:
+    int init();
+    int search();
+    int save_result();
+
+protected:
+    int evaluate(const std::vector<int>& precisions, float& similarity, double& latency);
+    int write_model(const std::vector<int>& precisions) const;
+
+protected:
+    std::vector<std::string> layer_names;
+    std::vector<std::string> layer_types;
+    std::vector<bool> layer_int8_capable;
+    std::vector<bool> layer_lowp_capable;
+
+    std::vector<std::string> input_names;
+    std::vector<std::string> output_names;
+
+    std::vector<std::vector<ncnn::Mat> > image_inputs;
+    std::vector<std::vector<ncnn::Mat> > reference_outputs;
+
+    std::vector<int> result_precisions;
+    float result_similarity;
+    double result_latency;
+    double fp32_latency;
+};
+
+MixedPrecisionSearch::MixedPrecisionSearch()
+{
+    num_threads = ncnn::get_physical_big_cpu_count();
+    lowp = ncnn::cpu_support_x86_f16c() || ncnn::cpu_support_arm_asimdhp() ? 1 : 0;
+    accuracy = 0.99f;
+    image_count = 20;
+    loop_count = 4;
+
+    result_similarity = 0.f;
+    result_latency = 0;
+    fp32_latency = 0;
+}
+
+static float cosine_similarity(const ncnn::Mat& a, const ncnn::Mat& b)
+{
+    if (a.w != b.w || a.h != b.h || a.d != b.d || a.c != b.c)
+        return 0.f;
+
+    double sum_ab = 0;
+    double sum_aa = 0;
+    double sum_bb = 0;
+
+    for (int q = 0; q < a.c; q++)
+    {
+        const float* pa = a.channel(q);
+        const float* pb = b.channel(q);
+
+        const int size = a.w * a.h * a.d;
+        for (int i = 0; i < size; i++)
+        {
+            sum_ab += (double)pa[i] * pb[i];
+            sum_aa += (double)pa[i] * pa[i];
+            sum_bb += (double)pb[i] * pb[i];
+        }
+    }
+
+    if (sum_aa == 0 && sum_bb == 0)
+        return 1.f;
+
+    if (sum_aa == 0 || sum_bb == 0)
+        return 0.f;
+
+    return (float)(sum_ab / sqrt(sum_aa * sum_bb));
+}
+
+int MixedPrecisionSearch::init()
+{
+    ncnn::Net net;
+    net.opt.num_threads = num_threads;
+    net.opt.use_fp16_packed = false;
+    net.opt.use_fp16_storage = false;
+    net.opt.use_fp16_arithmetic = false;
+    net.opt.use_bf16_storage = false;
+
+    if (net.load_param(inparam.c_str()) != 0 || net.load_model(inbin.c_str()) != 0)
+    {
+        fprintf(stderr, "load model %s %s failed\n", inparam.c_str(), inbin.c_str());
+        return -1;
+    }
+
+    const std::vector<ncnn::Layer*>& layers = net.layers();
+    const std::vector<ncnn::Blob>& blobs = net.blobs();
+
+    for (size_t i = 0; i < layers.size(); i++)
+    {
+        const ncnn::Layer* layer = layers[i];
+
+        layer_names.push_back(layer->name);
+        layer_types.push_back(layer->type);
+
+        if (layer->type == "Input")
+        {
+            input_names.push_back(blobs[layer->tops[0]].name);
+        }
+
+        // the layers ncnn2int8 quantizes with the calibration table
+        const bool int8_type = layer->type == "Convolution" || layer->type == "ConvolutionDepthWise" || layer->type == "InnerProduct" || layer->type == "Gemm";
+        const bool in_table = blob_int8scale_table.find(layer->name) != blob_int8scale_table.end() && weight_int8scale_table.find(layer->name + "_param_0") != weight_int8scale_table.end();
+        layer_int8_capable.push_back(int8_type && in_table);
+
+        // data movement layers follow their neighbours
+        const bool lowp_type = layer->type != "Input" && layer->type != "Split" && layer->type != "MemoryData" && layer->type != "Noop";
+        layer_lowp_capable.push_back(lowp_type);
+    }
+
+    for (size_t i = 0; i < blobs.size(); i++)
+    {
+        if (blobs[i].consumer == -1)
+            output_names.push_back(blobs[i].name);
+    }
+
+    if (input_names.size() != listspaths.size())
+    {
+        fprintf(stderr, "expect %d lists, but got %d\n", (int)input_names.size(), (int)listspaths.size());
+        return -1;
+    }
+
+    // decode the calibration images once
+    image_count = std::min(image_count, (int)listspaths[0].size());
+    for (int i = 0; i < image_count; i++)
+    {
+        std::vector<ncnn::Mat> inputs(input_names.size());
+
+        bool ok = true;
+        for (size_t j = 0; j < input_names.size(); j++)
+        {
+            const int type_to_pixel = type_to_pixels[j];
+
+            int pixel_convert_type = ncnn::Mat::PIXEL_BGR;
+            if (type_to_pixel != pixel_convert_type)
+            {
+                pixel_convert_type = pixel_convert_type | (type_to_pixel << ncnn::Mat::PIXEL_CONVERT_SHIFT);
+            }
+
+            ncnn::Mat in = read_and_resize_image(shapes[j], listspaths[j][i], pixel_convert_type);
+            if (in.empty())
+            {
+                fprintf(stderr, "read image %s failed\n", listspaths[j][i].c_str());
+                ok = false;
+                break;
+            }
+
+            in.substract_mean_normalize(means[j].data(), norms[j].data());
+
+            inputs[j] = in;
+        }
+
+        if (ok)
+            image_inputs.push_back(inputs);
+    }
+
+    if (image_inputs.empty())
+    {
+        fprintf(stderr, "no calibration image\n");
+        return -1;
+    }
+
+    // fp32 reference outputs
+    for (size_t i = 0; i < image_inputs.size(); i++)
+    {
+        ncnn::Extractor ex = net.create_extractor();
+
+        for (size_t j = 0; j < input_names.size(); j++)
+        {
+            ex.input(input_names[j].c_str(), image_inputs[i][j]);
+        }
+
+        std::vector<ncnn::Mat> outputs(output_names.size());
+        for (size_t j = 0; j < output_names.size(); j++)
+        {
+            ex.extract(output_names[j].c_str(), outputs[j]);
+        }
+
+        reference_outputs.push_back(outputs);
+    }
+
+    return 0;
+}
+
+int MixedPrecisionSearch::write_model(const std::vector<int>& precisions) const
+{
+    NetQuantize quantizer;
+    quantizer.opt.num_threads = 1;
+
+    // only the int8 layers keep their calibration scales
+    for (size_t i = 0; i < precisions.size(); i++)
+    {
+        if (precisions[i] != PRECISION_INT8)
+            continue;
+
+        const std::string& name = layer_names[i];
+        quantizer.blob_int8scale_table[name] = blob_int8scale_table.find(name)->second;
+        quantizer.weight_int8scale_table[name + "_param_0"] = weight_int8scale_table.find(name + "_param_0")->second;
+    }
+
+    if (quantizer.load_param(inparam.c_str()) != 0 || quantizer.load_model(inbin.c_str()) != 0)
+        return -1;
+
+    quantizer.quantize_convolution();
+    quantizer.quantize_convolutiondepthwise();
+    quantizer.quantize_innerproduct();
+    quantizer.quantize_gemm();
+
+    quantizer.fuse_requantize();
+
+    for (size_t i = 0; i < precisions.size(); i++)
+    {
+        if (precisions[i] == PRECISION_FP32 && layer_lowp_capable[i])
+        {
+            // no fp16 arithmetic, no fp16 storage, no bf16 storage
+            quantizer.layers[i]->featmask |= (1 << 0) | (1 << 1) | (1 << 2);
+        }
+    }
+
+    return quantizer.save(outparam.c_str(), outbin.c_str());
+}
+
+int MixedPrecisionSearch::evaluate(const std::vector<int>& precisions, float& similarity, double& latency)
+{
+    int ret = write_model(precisions);
+    if (ret != 0)
+    {
+        fprintf(stderr, "write model failed\n");
+        return ret;
+    }
+
+    ncnn::Net net;
+    net.opt.num_threads = num_threads;
+    net.opt.use_fp16_packed = lowp == 1;
+    net.opt.use_fp16_storage = lowp == 1;
+    net.opt.use_fp16_arithmetic = false;
+    net.opt.use_bf16_storage = lowp == 2;
+    net.opt.use_int8_inference = true;
+
+    if (net.load_param(outparam.c_str()) != 0 || net.load_model(outbin.c_str()) != 0)
+    {
+        fprintf(stderr, "load model %s %s failed\n", outparam.c_str(), outbin.c_str());
+        return -1;
+    }
+
+    double similarity_sum = 0;
+    latency = 0;
+
+    for (size_t i = 0; i < image_inputs.size(); i++)
+    {
+        std::vector<ncnn::Mat> outputs(output_names.size());
+
+        // the fastest run of each image, the first one also warms up
+        double time_min = DBL_MAX;
+        for (int k = 0; k < loop_count + 1; k++)
+        {
+            double start = ncnn::get_current_time();
+
+            ncnn::Extractor ex = net.create_extractor();
+
+            for (size_t j = 0; j < input_names.size(); j++)
+            {
+                ex.input(input_names[j].c_str(), image_inputs[i][j]);
+            }
+
+            for (size_t j = 0; j < output_names.size(); j++)
+            {
+                ex.extract(output_names[j].c_str(), outputs[j]);
+            }
+
+            double end = ncnn::get_current_time();
+
+            if (k > 0 || loop_count == 0)
+                time_min = std::min(time_min, end - start);
+        }
+
+        latency += time_min;
+
+        for (size_t j = 0; j < output_names.size(); j++)
+        {
+            similarity_sum += cosine_similarity(reference_outputs[i][j], outputs[j]);
+        }
+    }
+
+    similarity = (float)(similarity_sum / (image_inputs.size() * output_names.size()));
+    latency /= image_inputs.size();
+
+    return 0;
+}
+
+int MixedPrecisionSearch::search()
+{
+    const int layer_count = (int)layer_names.size();
+    const float error_budget = 1.f - accuracy;
+
+    std::vector<int> precisions(layer_count, PRECISION_FP32);
+
+    float similarity;
+    int ret = evaluate(precisions, similarity, fp32_latency);
+    if (ret != 0)
+        return ret;
+
+    fprintf(stderr, "fp32 latency = %.2f ms\n", fp32_latency);
+
+    // measure every single layer choice on top of the fp32 net
+    std::vector<PrecisionChoice> choices;
+    for (int i = 0; i < layer_count; i++)
+    {
+        for (int precision = PRECISION_LOWP; precision <= PRECISION_INT8; precision++)
+        {
+            if (precision == PRECISION_LOWP && (lowp == 0 || !layer_lowp_capable[i]))
+                continue;
+            if (precision == PRECISION_INT8 && !layer_int8_capable[i])
+                continue;
+
+            precisions[i] = precision;
+
+            double latency;
+            ret = evaluate(precisions, similarity, latency);
+            if (ret != 0)
+                return ret;
+
+            precisions[i] = PRECISION_FP32;
+
+            PrecisionChoice choice;
+            choice.layer_index = i;
+            choice.precision = precision;
+            choice.error = std::max(1.f - similarity, 0.f);
+            choice.gain = fp32_latency - latency;
+
+            fprintf(stderr, "%-24s %-24s %s  error = %f  gain = %.3f ms\n", layer_types[i].c_str(), layer_names[i].c_str(), precision_name(precision, lowp), choice.error, choice.gain);
+
+            // slower than fp32, nothing to win
+            if (choice.gain > 0)
+                choices.push_back(choice);
+        }
+    }
+
+    // take the most efficient choices while the summed error fits the budget
+    std::sort(choices.begin(), choices.end(), compare_choice_efficiency);
+
+    std::vector<float> layer_errors(layer_count, 0.f);
+    float error_sum = 0.f;
+    for (size_t i = 0; i < choices.size(); i++)
+    {
+        const PrecisionChoice& choice = choices[i];
+        const int layer_index = choice.layer_index;
+
+        if (precisions[layer_index] != PRECISION_FP32)
+            continue;
+
+        if (error_sum + choice.error > error_budget)
+            continue;
+
+        precisions[layer_index] = choice.precision;
+        layer_errors[layer_index] = choice.error;
+        error_sum += choice.error;
+    }
+
+    // errors do not add up exactly, verify and back off the worst layer until the budget holds
+    for (;;)
+    {
+        ret = evaluate(precisions, result_similarity, result_latency);
+        if (ret != 0)
+            return ret;
+
+        fprintf(stderr, "mixed similarity = %f  latency = %.2f ms\n", result_similarity, result_latency);
+
+        if (result_similarity >= accuracy)
+            break;
+
+        int worst = -1;
+        for (int i = 0; i < layer_count; i++)
+        {
+            if (precisions[i] == PRECISION_FP32)
+                continue;
+
+            if (worst == -1 || layer_errors[i] > layer_errors[worst])
+                worst = i;
+        }
+
+        if (worst == -1)
+            break;
+
+        fprintf(stderr, "back off %s from %s\n", layer_names[worst].c_str(), precision_name(precisions[worst], lowp));
+
+        precisions[worst] = PRECISION_FP32;
+        layer_errors[worst] = 0.f;
+    }
+
+    result_precisions = precisions;
+
+    return 0;
+}
+
+int MixedPrecisionSearch::save_result()
+{
+    const int layer_count = (int)layer_names.size();
+
+    int count[3] = {0, 0, 0};
+    for (int i = 0; i < layer_count; i++)
+    {
+        if (!layer_lowp_capable[i] && !layer_int8_capable[i])
+            continue;
+
+        const int precision = result_precisions[i];
+        count[precision]++;
+
+        fprintf(stderr, "%-24s %-24s %s\n", layer_types[i].c_str(), layer_names[i].c_str(), precision_name(precision, lowp));
+    }
+
+    fprintf(stderr, "---------------------------------------\n");
+    fprintf(stderr, "layers int8 = %d  %s = %d  fp32 = %d\n", count[PRECISION_INT8], precision_name(PRECISION_LOWP, lowp), count[PRECISION_LOWP], count[PRECISION_FP32]);
+    fprintf(stderr, "similarity = %f  latency = %.2f ms  fp32 latency = %.2f ms\n", result_similarity, result_latency, fp32_latency);
+
+    if (lowp == 2)
+        fprintf(stderr, "enable opt.use_bf16_storage for the bf16 layers\n");
+
+    return write_model(result_precisions);
+}
+
+static void show_usage()
+{
+    fprintf(stderr, "Usage: ncnn2mixed [inparam] [inbin] [list,...] [calibration table] [outparam] [outbin] [(key=value)...]\n");
+    fprintf(stderr, "  mean=[104.0,117.0,123.0],...\n");
+    fprintf(stderr, "  norm=[1.0,1.0,1.0],...\n");
+    fprintf(stderr, "  shape=[224,224,3],...[w,h,c] or [w,h] **[0,0] will not resize\n");
+    fprintf(stderr, "  pixel=RAW/RGB/BGR/GRAY/RGBA/BGRA,...\n");
+    fprintf(stderr, "  thread=8\n");
+    fprintf(stderr, "  lowp=fp16/bf16/none **reduced precision tried besides int8\n");
+    fprintf(stderr, "  accuracy=0.99 **minimum cosine similarity of the outputs against fp32\n");
+    fprintf(stderr, "  images=20 **number of calibration images\n");
+    fprintf(stderr, "  loop=4 **repeated forwards for the latency\n");
+    fprintf(stderr, "Sample usage: ncnn2mixed mobilenet.param mobilenet.bin imagelist.txt mobilenet.table mobilenet-mixed.param mobilenet-mixed.bin mean=[104,117,123] norm=[0.017,0.017,0.017] shape=[224,224,3] pixel=BGR accuracy=0.995\n");
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 7)
+    {
+        show_usage();
+        return -1;
+    }
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (argv[i][0] == '-')
+        {
+            show_usage();
+            return -1;
+        }
+    }
+
+    MixedPrecisionSearch search;
+    search.inparam = argv[1];
+    search.inbin = argv[2];
+    search.listspaths = parse_comma_path_list(argv[3]);
+    const char* tablepath = argv[4];
+    search.outparam = argv[5];
+    search.outbin = argv[6];
+
+    if (!read_int8scale_table(tablepath, search.blob_int8scale_table, search.weight_int8scale_table))
+    {
+        fprintf(stderr, "read_int8scale_table failed\n");
+        return -1;
+    }
+
+    for (int i = 7; i < argc; i++)
+    {
+        // key=value
+        char* kv = argv[i];
+
+        char* eqs = strchr(kv, '=');
+        if (eqs == NULL)
+        {
+            fprintf(stderr, "unrecognized arg %s\n", kv);
+            continue;
+        }
+
+        // split k v
+        eqs[0] = '\0';
+        const char* key = kv;
+        char* value = eqs + 1;
+
+        if (strcmp(key, "mean") == 0)
+            search.means = parse_comma_float_array_list(value);
+        if (strcmp(key, "norm") == 0)
+            search.norms = parse_comma_float_array_list(value);
+        if (strcmp(key, "shape") == 0)
+            search.shapes = parse_comma_int_array_list(value);
+        if (strcmp(key, "pixel") == 0)
+            search.type_to_pixels = parse_comma_pixel_type_list(value);
+        if (strcmp(key, "thread") == 0)
+            search.num_threads = atoi(value);
+        if (strcmp(key, "lowp") == 0)
+            search.lowp = strcmp(value, "fp16") == 0 ? 1 : strcmp(value, "bf16") == 0 ? 2 : 0;
+        if (strcmp(key, "accuracy") == 0)
+            search.accuracy = (float)atof(value);
+        if (strcmp(key, "images") == 0)
+            search.image_count = atoi(value);
+        if (strcmp(key, "loop") == 0)
+            search.loop_count = atoi(value);
+    }
+
+    // sanity check
+    const size_t list_count = search.listspaths.size();
+    if (search.means.size() != list_count || search.norms.size() != list_count || search.shapes.size() != list_count || search.type_to_pixels.size() != list_count)
+    {
+        fprintf(stderr, "expect %d mean, norm, shape and pixel\n", (int)list_count);
+        return -1;
+    }
+    if (search.num_threads <= 0 || search.image_count <= 0 || search.loop_count < 0)
+    {
+        fprintf(stderr, "malformed thread, images or loop\n");
+        return -1;
+    }
+    if (search.accuracy <= 0.f || search.accuracy > 1.f)
+    {
+        fprintf(stderr, "malformed accuracy %f\n", search.accuracy);
+        return -1;
+    }
+
+    fprintf(stderr, "thread = %d\n", search.num_threads);
+    fprintf(stderr, "lowp = %s\n", search.lowp == 1 ? "fp16" : search.lowp == 2 ? "bf16" : "none");
+    fprintf(stderr, "accuracy = %f\n", search.accuracy);
+    fprintf(stderr, "images = %d\n", search.image_count);
+    fprintf(stderr, "loop = %d\n", search.loop_count);
+    fprintf(stderr, "---------------------------------------\n");
+
+    if (search.init() != 0)
+        return -1;
+
+    if (search.search() != 0)
+        return -1;
+
+    return search.save_result();
+}
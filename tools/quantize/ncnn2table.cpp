@@ -28,14 +28,13 @@
 #include <stdlib.h>
 #include <string.h>
 
-#if defined(USE_NCNN_SIMPLEOCV)
-#include "simpleocv.h"
-#elif defined(USE_LOCAL_IMREADWRITE)
-#include "imreadwrite.h"
-#else
-#include <opencv2/core/core.hpp>
-#include <opencv2/highgui/highgui.hpp>
-#endif
+#if __ARM_NEON
+#include <arm_neon.h>
+#endif // __ARM_NEON
+#if __SSE2__
+#include <emmintrin.h>
+#endif // __SSE2__
+
 #include <string>
 #include <vector>
 
@@ -44,9 +43,12 @@
 #include "cpu.h"
 #include "net.h"
 
+#include "calibration.h"
+
 // ncnn private header
 #include "layer/convolution.h"
 #include "layer/convolutiondepthwise.h"
+#include "layer/gemm.h"
 #include "layer/innerproduct.h"
 
 class QuantBlobStat
@@ -69,6 +71,36 @@ public:
     // KL
     std::vector<uint64_t> histogram;
     std::vector<float> histogram_normed;
+
+public:
+    // accumulate the statistics collected by another thread
+    void merge(const QuantBlobStat& other)
+    {
+        absmax = std::max(absmax, other.absmax);
+        total = std::max(total, other.total);
+
+        if (histogram.size() < other.histogram.size())
+            histogram.resize(other.histogram.size(), 0);
+
+        for (size_t i = 0; i < other.histogram.size(); i++)
+        {
+            histogram[i] += other.histogram[i];
+        }
+    }
+};
+
+// the statistics gathered by one pass over the calibration images
+enum
+{
+    CALIBRATION_ABSMAX = 0,
+    CALIBRATION_HISTOGRAM = 1
+};
+
+// method id recorded in the checkpoint
+enum
+{
+    CALIBRATION_METHOD_KL = 0,
+    CALIBRATION_METHOD_ACIQ = 1
 };
 
 class QuantNet : public ncnn::Net
@@ -87,6 +119,13 @@ public:
     std::vector<int> type_to_pixels;
     int quantize_num_threads;
 
+    // images decoded ahead of the forward passes, 0 = decode on the forward threads
+    int decode_num_threads;
+
+    // resumable statistics, saved after every checkpoint_interval images
+    std::string checkpoint_path;
+    int checkpoint_interval;
+
 public:
     int init();
     void print_quant_info() const;
@@ -95,6 +134,15 @@ public:
     int quantize_ACIQ();
     int quantize_EQ();
 
+public:
+    // decode and preprocess the inputs of one calibration image
+    int read_inputs(int image_index, std::vector<ncnn::Mat>& inputs) const;
+
+protected:
+    int collect_blob_stats(int method, int phase, int num_histogram_bins);
+    int save_checkpoint(int method, int phase, int num_histogram_bins, int next_image_index) const;
+    int load_checkpoint(int method, int phase, int num_histogram_bins, int& next_image_index);
+
 public:
     std::vector<int> input_blobs;
     std::vector<int> conv_layers;
@@ -111,6 +159,8 @@ QuantNet::QuantNet()
     : blobs(mutable_blobs()), layers(mutable_layers())
 {
     quantize_num_threads = ncnn::get_cpu_count();
+    decode_num_threads = 2;
+    checkpoint_interval = 500;
 }
 
 int QuantNet::init()
@@ -135,6 +185,18 @@ int QuantNet::init()
             conv_bottom_blobs.push_back(layer->bottoms[0]);
             conv_top_blobs.push_back(layer->tops[0]);
         }
+
+        // gemm with one constant operand, the other one is the only input
+        if (layer->type == "Gemm")
+        {
+            const ncnn::Gemm* gemm = (const ncnn::Gemm*)layer;
+            if (layer->bottoms.size() == 1 && gemm->constantA + gemm->constantB == 1)
+            {
+                conv_layers.push_back(i);
+                conv_bottom_blobs.push_back(layer->bottoms[0]);
+                conv_top_blobs.push_back(layer->tops[0]);
+            }
+        }
     }
 
     const int conv_layer_count = (int)conv_layers.size();
@@ -202,67 +264,623 @@ void QuantNet::print_quant_info() const
     }
 }
 
-/**
- * Read and resize image
- * shape is input as [w,h,...]
- * if w and h both are given, image will be resized to exactly size.
- * if w and h both are zero or negative, image will not be resized.
- * if only h is zero or negative, image's width will scaled resize to w, keeping aspect ratio.
- * if only w is zero or negative, image's height will scaled resize to h
- * @return ncnn::Mat
- */
-
-inline ncnn::Mat read_and_resize_image(const std::vector<int>& shape, const std::string& imagepath, int pixel_convert_type)
+static float compute_kl_divergence(const std::vector<float>& a, const std::vector<float>& b)
 {
-    int target_w = shape[0];
-    int target_h = shape[1];
-    cv::Mat bgr = cv::imread(imagepath, 1);
-    if (target_h <= 0 && target_w <= 0)
+    const size_t length = a.size();
+
+    float result = 0;
+    for (size_t i = 0; i < length; i++)
     {
-        return ncnn::Mat::from_pixels(bgr.data, pixel_convert_type, bgr.cols, bgr.rows);
+        result += a[i] * log(a[i] / b[i]);
     }
-    if (target_h <= 0 || target_w <= 0)
+
+    return result;
+}
+
+int QuantNet::read_inputs(int image_index, std::vector<ncnn::Mat>& inputs) const
+{
+    const int input_blob_count = (int)input_blobs.size();
+
+    inputs.resize(input_blob_count);
+
+    for (int j = 0; j < input_blob_count; j++)
     {
-        float scale = 1.0;
-        if (target_h <= 0)
+        const int type_to_pixel = type_to_pixels[j];
+        const std::vector<float>& mean_vals = means[j];
+        const std::vector<float>& norm_vals = norms[j];
+
+        int pixel_convert_type = ncnn::Mat::PIXEL_BGR;
+        if (type_to_pixel != pixel_convert_type)
         {
-            scale = 1.0 * bgr.cols / target_w;
-            target_h = int(1.0 * bgr.rows / scale);
+            pixel_convert_type = pixel_convert_type | (type_to_pixel << ncnn::Mat::PIXEL_CONVERT_SHIFT);
         }
-        if (target_w <= 0)
+
+        ncnn::Mat in = read_and_resize_image(shapes[j], listspaths[j][image_index], pixel_convert_type);
+        if (in.empty())
         {
-            scale = 1.0 * bgr.rows / target_h;
-            target_w = int(1.0 * bgr.cols / scale);
+            fprintf(stderr, "read image %s failed\n", listspaths[j][image_index].c_str());
+            return -1;
         }
+
+        in.substract_mean_normalize(mean_vals.data(), norm_vals.data());
+
+        inputs[j] = in;
     }
-    return ncnn::Mat::from_pixels_resize(bgr.data, pixel_convert_type, bgr.cols, bgr.rows, target_w, target_h);
+
+    return 0;
 }
 
-static float compute_kl_divergence(const std::vector<float>& a, const std::vector<float>& b)
+// decode and preprocess calibration images in background threads
+// so that image decoding overlaps with the forward passes
+class CalibrationLoader
 {
-    const size_t length = a.size();
+public:
+    CalibrationLoader(const QuantNet* net, int begin, int end, int num_decode_threads, int capacity);
+    ~CalibrationLoader();
 
-    float result = 0;
-    for (size_t i = 0; i < length; i++)
+    // fetch the inputs of any not yet consumed image, return the image index or -1 when exhausted
+    int get(std::vector<ncnn::Mat>& inputs);
+
+protected:
+    static void* decode_thread(void* args);
+
+    // return the image index to decode next or -1
+    int take_next();
+
+protected:
+    const QuantNet* net;
+    int end;
+
+    int next_image_index;
+    int consumed_count;
+    int total_count;
+
+    // decoded images waiting for a forward thread, failed images are queued with empty inputs
+    std::vector<int> ready_indexes;
+    std::vector<std::vector<ncnn::Mat> > ready_inputs;
+    int capacity;
+
+    ncnn::Mutex lock;
+    ncnn::ConditionVariable condition_ready;
+    ncnn::ConditionVariable condition_space;
+
+    std::vector<ncnn::Thread*> decode_threads;
+};
+
+CalibrationLoader::CalibrationLoader(const QuantNet* _net, int begin, int _end, int num_decode_threads, int _capacity)
+    : net(_net), end(_end), capacity(std::max(_capacity, 1))
+{
+    next_image_index = begin;
+    consumed_count = 0;
+    total_count = std::max(_end - begin, 0);
+
+#if NCNN_THREADS
+    for (int i = 0; i < num_decode_threads; i++)
     {
-        result += a[i] * log(a[i] / b[i]);
+        decode_threads.push_back(new ncnn::Thread(decode_thread, (void*)this));
     }
+#else
+    (void)num_decode_threads;
+#endif
+}
 
-    return result;
+CalibrationLoader::~CalibrationLoader()
+{
+    // wake up the decoders blocked on a full queue
+    lock.lock();
+    next_image_index = end;
+    capacity = INT_MAX;
+    condition_space.broadcast();
+    lock.unlock();
+
+    for (size_t i = 0; i < decode_threads.size(); i++)
+    {
+        decode_threads[i]->join();
+        delete decode_threads[i];
+    }
 }
 
-int QuantNet::quantize_KL()
+int CalibrationLoader::take_next()
 {
-    const int input_blob_count = (int)input_blobs.size();
-    const int conv_layer_count = (int)conv_layers.size();
+    ncnn::MutexLockGuard g(lock);
+
+    if (next_image_index >= end)
+        return -1;
+
+    return next_image_index++;
+}
+
+void* CalibrationLoader::decode_thread(void* args)
+{
+    CalibrationLoader* loader = (CalibrationLoader*)args;
+
+    for (;;)
+    {
+        const int image_index = loader->take_next();
+        if (image_index < 0)
+            break;
+
+        std::vector<ncnn::Mat> inputs;
+        if (loader->net->read_inputs(image_index, inputs) != 0)
+            inputs.clear();
+
+        loader->lock.lock();
+        while ((int)loader->ready_indexes.size() >= loader->capacity)
+        {
+            loader->condition_space.wait(loader->lock);
+        }
+        loader->ready_indexes.push_back(image_index);
+        loader->ready_inputs.push_back(inputs);
+        loader->condition_ready.signal();
+        loader->lock.unlock();
+    }
+
+    return 0;
+}
+
+int CalibrationLoader::get(std::vector<ncnn::Mat>& inputs)
+{
+    for (;;)
+    {
+        if (decode_threads.empty())
+        {
+            // synchronous decoding on the calling thread
+            const int image_index = take_next();
+            if (image_index < 0)
+                return -1;
+
+            if (net->read_inputs(image_index, inputs) == 0)
+                return image_index;
+
+            continue;
+        }
+
+        lock.lock();
+        while (ready_indexes.empty() && consumed_count < total_count)
+        {
+            condition_ready.wait(lock);
+        }
+
+        if (consumed_count >= total_count)
+        {
+            lock.unlock();
+            return -1;
+        }
+
+        const int image_index = ready_indexes.back();
+        inputs = ready_inputs.back();
+        ready_indexes.pop_back();
+        ready_inputs.pop_back();
+        consumed_count++;
+
+        // the last image wakes up all the other waiting forward threads
+        if (consumed_count == total_count)
+            condition_ready.broadcast();
+
+        condition_space.signal();
+        lock.unlock();
+
+        if (!inputs.empty())
+            return image_index;
+    }
+}
+
+static float compute_absmax(const ncnn::Mat& m)
+{
+    float absmax = 0.f;
+
+    for (int q = 0; q < m.c; q++)
+    {
+        const float* ptr = m.channel(q);
+        const int size = m.w * m.h * m.d * m.elempack;
+
+        int i = 0;
+#if __SSE2__
+        __m128 _absmax = _mm_setzero_ps();
+        const __m128 _sign_mask = _mm_set1_ps(-0.f);
+        for (; i + 3 < size; i += 4)
+        {
+            __m128 _p = _mm_loadu_ps(ptr + i);
+            _absmax = _mm_max_ps(_absmax, _mm_andnot_ps(_sign_mask, _p));
+        }
+        float tmp[4];
+        _mm_storeu_ps(tmp, _absmax);
+        absmax = std::max(absmax, std::max(std::max(tmp[0], tmp[1]), std::max(tmp[2], tmp[3])));
+#elif __ARM_NEON
+        float32x4_t _absmax = vdupq_n_f32(0.f);
+        for (; i + 3 < size; i += 4)
+        {
+            float32x4_t _p = vld1q_f32(ptr + i);
+            _absmax = vmaxq_f32(_absmax, vabsq_f32(_p));
+        }
+        float32x2_t _absmax2 = vmax_f32(vget_low_f32(_absmax), vget_high_f32(_absmax));
+        _absmax2 = vpmax_f32(_absmax2, _absmax2);
+        absmax = std::max(absmax, vget_lane_f32(_absmax2, 0));
+#endif
+        for (; i < size; i++)
+        {
+            absmax = std::max(absmax, (float)fabs(ptr[i]));
+        }
+    }
+
+    return absmax;
+}
+
+// histogram has num_histogram_bins + 1 bins, the extra one counts the zeros that are not part of the distribution
+static void accumulate_histogram(const ncnn::Mat& m, float absmax, int num_histogram_bins, uint64_t* histogram)
+{
+    for (int q = 0; q < m.c; q++)
+    {
+        const float* ptr = m.channel(q);
+        const int size = m.w * m.h * m.d * m.elempack;
+
+        int i = 0;
+#if __SSE2__
+        const __m128 _sign_mask = _mm_set1_ps(-0.f);
+        const __m128 _absmax = _mm_set1_ps(absmax);
+        const __m128 _bins = _mm_set1_ps((float)num_histogram_bins);
+        const __m128 _last_bin = _mm_set1_ps((float)(num_histogram_bins - 1));
+        const __m128i _zero_bin = _mm_set1_epi32(num_histogram_bins);
+        for (; i + 3 < size; i += 4)
+        {
+            __m128 _p = _mm_loadu_ps(ptr + i);
+            __m128 _v = _mm_mul_ps(_mm_div_ps(_mm_andnot_ps(_sign_mask, _p), _absmax), _bins);
+            __m128i _index = _mm_cvttps_epi32(_mm_min_ps(_v, _last_bin));
+            __m128i _is_zero = _mm_castps_si128(_mm_cmpeq_ps(_p, _mm_setzero_ps()));
+            _index = _mm_or_si128(_mm_andnot_si128(_is_zero, _index), _mm_and_si128(_is_zero, _zero_bin));
+
+            int index[4];
+            _mm_storeu_si128((__m128i*)index, _index);
+            histogram[index[0]] += 1;
+            histogram[index[1]] += 1;
+            histogram[index[2]] += 1;
+            histogram[index[3]] += 1;
+        }
+#elif __aarch64__
+        const float32x4_t _absmax = vdupq_n_f32(absmax);
+        const float32x4_t _bins = vdupq_n_f32((float)num_histogram_bins);
+        const float32x4_t _last_bin = vdupq_n_f32((float)(num_histogram_bins - 1));
+        const uint32x4_t _zero_bin = vdupq_n_u32(num_histogram_bins);
+        for (; i + 3 < size; i += 4)
+        {
+            float32x4_t _p = vld1q_f32(ptr + i);
+            float32x4_t _v = vmulq_f32(vdivq_f32(vabsq_f32(_p), _absmax), _bins);
+            uint32x4_t _index = vcvtq_u32_f32(vminq_f32(_v, _last_bin));
+            uint32x4_t _is_zero = vceqq_f32(_p, vdupq_n_f32(0.f));
+            _index = vbslq_u32(_is_zero, _zero_bin, _index);
+
+            unsigned int index[4];
+            vst1q_u32(index, _index);
+            histogram[index[0]] += 1;
+            histogram[index[1]] += 1;
+            histogram[index[2]] += 1;
+            histogram[index[3]] += 1;
+        }
+#endif
+        for (; i < size; i++)
+        {
+            if (ptr[i] == 0.f)
+            {
+                histogram[num_histogram_bins] += 1;
+                continue;
+            }
+
+            const int index = std::min((int)(fabs(ptr[i]) / absmax * num_histogram_bins), (num_histogram_bins - 1));
+
+            histogram[index] += 1;
+        }
+    }
+}
+
+// checkpoint file layout
+//   magic, method, phase, image count, blob count, histogram bins, next image index
+//   then for each conv bottom blob: absmax, total, histogram bins in CALIBRATION_HISTOGRAM phase
+static const char g_checkpoint_magic[8] = {'n', 'c', 'n', 'n', 'q', 'c', 'k', '1'};
+
+int QuantNet::save_checkpoint(int method, int phase, int num_histogram_bins, int next_image_index) const
+{
+    const int image_count = (int)listspaths[0].size();
     const int conv_bottom_blob_count = (int)conv_bottom_blobs.size();
+
+    // write aside and rename, so that an interrupted write keeps the previous checkpoint
+    const std::string tmppath = checkpoint_path + ".tmp";
+
+    FILE* fp = fopen(tmppath.c_str(), "wb");
+    if (!fp)
+    {
+        fprintf(stderr, "fopen %s failed\n", tmppath.c_str());
+        return -1;
+    }
+
+    const int header[6] = {method, phase, image_count, conv_bottom_blob_count, num_histogram_bins, next_image_index};
+
+    size_t nwrite = fwrite(g_checkpoint_magic, 1, 8, fp);
+    nwrite += fwrite(header, sizeof(int), 6, fp);
+
+    size_t nexpect = 8 + 6;
+    for (int i = 0; i < conv_bottom_blob_count; i++)
+    {
+        const QuantBlobStat& stat = quant_blob_stats[i];
+
+        nwrite += fwrite(&stat.absmax, sizeof(float), 1, fp);
+        nwrite += fwrite(&stat.total, sizeof(int), 1, fp);
+        nexpect += 2;
+
+        if (phase == CALIBRATION_HISTOGRAM)
+        {
+            nwrite += fwrite(stat.histogram.data(), sizeof(uint64_t), num_histogram_bins, fp);
+            nexpect += num_histogram_bins;
+        }
+    }
+
+    fclose(fp);
+
+    if (nwrite != nexpect)
+    {
+        fprintf(stderr, "write checkpoint %s failed\n", tmppath.c_str());
+        return -1;
+    }
+
+    remove(checkpoint_path.c_str());
+    if (rename(tmppath.c_str(), checkpoint_path.c_str()) != 0)
+    {
+        fprintf(stderr, "rename %s failed\n", tmppath.c_str());
+        return -1;
+    }
+
+    return 0;
+}
+
+int QuantNet::load_checkpoint(int method, int phase, int num_histogram_bins, int& next_image_index)
+{
+    next_image_index = 0;
+
+    FILE* fp = fopen(checkpoint_path.c_str(), "rb");
+    if (!fp)
+    {
+        // no checkpoint yet, start over
+        return 0;
+    }
+
     const int image_count = (int)listspaths[0].size();
+    const int conv_bottom_blob_count = (int)conv_bottom_blobs.size();
 
-    const int num_histogram_bins = 2048;
+    char magic[8];
+    int header[6];
+    if (fread(magic, 1, 8, fp) != 8 || memcmp(magic, g_checkpoint_magic, 8) != 0 || fread(header, sizeof(int), 6, fp) != 6)
+    {
+        fprintf(stderr, "invalid checkpoint %s\n", checkpoint_path.c_str());
+        fclose(fp);
+        return -1;
+    }
+
+    if (header[0] != method || header[2] != image_count || header[3] != conv_bottom_blob_count || header[4] != num_histogram_bins)
+    {
+        fprintf(stderr, "checkpoint %s does not match the model, image list or method\n", checkpoint_path.c_str());
+        fclose(fp);
+        return -1;
+    }
+
+    // the checkpoint of an earlier phase only carries the absmax
+    const int saved_phase = header[1];
+    if (saved_phase > phase)
+    {
+        next_image_index = image_count;
+    }
+    else if (saved_phase == phase)
+    {
+        next_image_index = header[5];
+    }
+
+    for (int i = 0; i < conv_bottom_blob_count; i++)
+    {
+        QuantBlobStat& stat = quant_blob_stats[i];
+
+        size_t nread = fread(&stat.absmax, sizeof(float), 1, fp);
+        nread += fread(&stat.total, sizeof(int), 1, fp);
+        size_t nexpect = 2;
+
+        if (saved_phase == CALIBRATION_HISTOGRAM)
+        {
+            std::vector<uint64_t> histogram(num_histogram_bins);
+            nread += fread(histogram.data(), sizeof(uint64_t), num_histogram_bins, fp);
+            nexpect += num_histogram_bins;
+
+            if (phase == CALIBRATION_HISTOGRAM)
+            {
+                for (int k = 0; k < num_histogram_bins; k++)
+                {
+                    stat.histogram[k] = histogram[k];
+                }
+            }
+        }
+
+        if (nread != nexpect)
+        {
+            fprintf(stderr, "truncated checkpoint %s\n", checkpoint_path.c_str());
+            fclose(fp);
+            return -1;
+        }
+    }
+
+    fclose(fp);
+
+    if (saved_phase < phase)
+    {
+        // the previous phase is complete, this one starts over
+        if (header[5] != image_count)
+        {
+            fprintf(stderr, "checkpoint %s stopped in an earlier phase\n", checkpoint_path.c_str());
+            return -1;
+        }
+
+        next_image_index = 0;
+    }
+
+    fprintf(stderr, "resume from checkpoint %s at image %d\n", checkpoint_path.c_str(), next_image_index);
+
+    return 0;
+}
+
+// stream all calibration images through the net and collect the absmax or the histogram of conv bottom blobs
+// every forward thread owns its statistics, merged after each checkpoint interval
+int QuantNet::collect_blob_stats(int method, int phase, int num_histogram_bins)
+{
+    const int conv_bottom_blob_count = (int)conv_bottom_blobs.size();
+    const int image_count = (int)listspaths[0].size();
+
+    const char* phase_name = phase == CALIBRATION_ABSMAX ? "count the absmax" : "build histogram";
+
+    int begin = 0;
+    if (!checkpoint_path.empty())
+    {
+        int ret = load_checkpoint(method, phase, num_histogram_bins, begin);
+        if (ret != 0)
+            return ret;
+    }
 
     std::vector<ncnn::UnlockedPoolAllocator> blob_allocators(quantize_num_threads);
     std::vector<ncnn::UnlockedPoolAllocator> workspace_allocators(quantize_num_threads);
 
+    const int interval = checkpoint_path.empty() ? image_count : std::max(checkpoint_interval, 1);
+
+    for (int chunk_begin = begin; chunk_begin < image_count; chunk_begin += interval)
+    {
+        const int chunk_end = std::min(chunk_begin + interval, image_count);
+
+        std::vector<std::vector<QuantBlobStat> > thread_stats(quantize_num_threads);
+        for (int t = 0; t < quantize_num_threads; t++)
+        {
+            thread_stats[t].resize(conv_bottom_blob_count);
+
+            if (phase == CALIBRATION_HISTOGRAM)
+            {
+                for (int j = 0; j < conv_bottom_blob_count; j++)
+                {
+                    thread_stats[t][j].histogram.resize(num_histogram_bins + 1, 0);
+                }
+            }
+        }
+
+        CalibrationLoader loader(this, chunk_begin, chunk_end, decode_num_threads, quantize_num_threads * 2);
+
+        // one long running loop per forward thread, pulling images until the chunk is drained
+        #pragma omp parallel for num_threads(quantize_num_threads) schedule(static, 1)
+        for (int t = 0; t < quantize_num_threads; t++)
+        {
+            std::vector<QuantBlobStat>& stats = thread_stats[t];
+
+            std::vector<ncnn::Mat> inputs;
+            for (;;)
+            {
+                const int i = loader.get(inputs);
+                if (i < 0)
+                    break;
+
+                if (i % 100 == 0)
+                {
+                    fprintf(stderr, "%s %.2f%% [ %d / %d ]\n", phase_name, i * 100.f / image_count, i, image_count);
+                }
+
+                ncnn::Extractor ex = create_extractor();
+                ex.set_light_mode(true);
+                ex.set_blob_allocator(&blob_allocators[t]);
+                ex.set_workspace_allocator(&workspace_allocators[t]);
+
+                for (int j = 0; j < (int)input_blobs.size(); j++)
+                {
+                    ex.input(input_blobs[j], inputs[j]);
+                }
+
+                for (int j = 0; j < conv_bottom_blob_count; j++)
+                {
+                    ncnn::Mat out;
+                    ex.extract(conv_bottom_blobs[j], out);
+
+                    QuantBlobStat& stat = stats[j];
+
+                    if (phase == CALIBRATION_ABSMAX)
+                    {
+                        stat.absmax = std::max(stat.absmax, compute_absmax(out));
+                        stat.total = out.w * out.h * out.d * out.c * out.elempack;
+                    }
+                    else
+                    {
+                        accumulate_histogram(out, quant_blob_stats[j].absmax, num_histogram_bins, stat.histogram.data());
+                    }
+                }
+            }
+        }
+
+        // merge the per-thread statistics, dropping the zero bin
+        for (int t = 0; t < quantize_num_threads; t++)
+        {
+            for (int j = 0; j < conv_bottom_blob_count; j++)
+            {
+                QuantBlobStat& stat = thread_stats[t][j];
+                if (phase == CALIBRATION_HISTOGRAM)
+                    stat.histogram.resize(num_histogram_bins);
+
+                quant_blob_stats[j].merge(stat);
+            }
+        }
+
+        if (!checkpoint_path.empty())
+        {
+            save_checkpoint(method, phase, num_histogram_bins, chunk_end);
+        }
+    }
+
+    return 0;
+}
+
+static ncnn::Mat get_gemm_weight_scales(const ncnn::Gemm* gemm)
+{
+    ncnn::Mat weight_scales;
+
+    if (gemm->constantA)
+    {
+        // per-row scales of A
+        const int M = gemm->constantM;
+        const int K = gemm->constantK;
+
+        weight_scales.create(M);
+
+        for (int m = 0; m < M; m++)
+        {
+            float absmax = 0.f;
+            for (int k = 0; k < K; k++)
+            {
+                const float v = gemm->transA ? gemm->A_data.row(k)[m] : gemm->A_data.row(m)[k];
+                absmax = std::max(absmax, (float)fabs(v));
+            }
+
+            weight_scales[m] = absmax == 0.f ? 1.f : 127 / absmax;
+        }
+    }
+    else
+    {
+        // one scale of B
+        float absmax = 0.f;
+        for (int k = 0; k < (int)gemm->B_data.total(); k++)
+        {
+            absmax = std::max(absmax, (float)fabs(gemm->B_data[k]));
+        }
+
+        weight_scales.create(1);
+        weight_scales[0] = absmax == 0.f ? 1.f : 127 / absmax;
+    }
+
+    return weight_scales;
+}
+
+int QuantNet::quantize_KL()
+{
+    const int conv_layer_count = (int)conv_layers.size();
+    const int conv_bottom_blob_count = (int)conv_bottom_blobs.size();
+
+    const int num_histogram_bins = 2048;
+
     // initialize conv weight scales
     #pragma omp parallel for num_threads(quantize_num_threads)
     for (int i = 0; i < conv_layer_count; i++)
@@ -330,101 +948,47 @@ int QuantNet::quantize_KL()
                 float absmax = 0.f;
                 for (int k = 0; k < weight_data_size_output; k++)
                 {
-                    absmax = std::max(absmax, (float)fabs(weight_data_n[k]));
-                }
-
-                weight_scales[i][n] = 127 / absmax;
-            }
-        }
-
-        if (layer->type == "InnerProduct")
-        {
-            const ncnn::InnerProduct* innerproduct = (const ncnn::InnerProduct*)layer;
-
-            const int num_output = innerproduct->num_output;
-            const int weight_data_size_output = innerproduct->weight_data_size / num_output;
-
-            weight_scales[i].create(num_output);
-
-            for (int n = 0; n < num_output; n++)
-            {
-                const ncnn::Mat weight_data_n = innerproduct->weight_data.range(weight_data_size_output * n, weight_data_size_output);
-
-                float absmax = 0.f;
-                for (int k = 0; k < weight_data_size_output; k++)
-                {
-                    absmax = std::max(absmax, (float)fabs(weight_data_n[k]));
-                }
-
-                weight_scales[i][n] = 127 / absmax;
-            }
-        }
-    }
-
-    // count the absmax
-    #pragma omp parallel for num_threads(quantize_num_threads) schedule(static, 1)
-    for (int i = 0; i < image_count; i++)
-    {
-        if (i % 100 == 0)
-        {
-            fprintf(stderr, "count the absmax %.2f%% [ %d / %d ]\n", i * 100.f / image_count, i, image_count);
-        }
-
-        ncnn::Extractor ex = create_extractor();
-        ex.set_light_mode(true);
-
-        const int thread_num = ncnn::get_omp_thread_num();
-        ex.set_blob_allocator(&blob_allocators[thread_num]);
-        ex.set_workspace_allocator(&workspace_allocators[thread_num]);
-
-        for (int j = 0; j < input_blob_count; j++)
-        {
-            const int type_to_pixel = type_to_pixels[j];
-            const std::vector<float>& mean_vals = means[j];
-            const std::vector<float>& norm_vals = norms[j];
-
-            int pixel_convert_type = ncnn::Mat::PIXEL_BGR;
-            if (type_to_pixel != pixel_convert_type)
-            {
-                pixel_convert_type = pixel_convert_type | (type_to_pixel << ncnn::Mat::PIXEL_CONVERT_SHIFT);
-            }
-
-            ncnn::Mat in = read_and_resize_image(shapes[j], listspaths[j][i], pixel_convert_type);
-
-            in.substract_mean_normalize(mean_vals.data(), norm_vals.data());
+                    absmax = std::max(absmax, (float)fabs(weight_data_n[k]));
+                }
 
-            ex.input(input_blobs[j], in);
+                weight_scales[i][n] = 127 / absmax;
+            }
         }
 
-        for (int j = 0; j < conv_bottom_blob_count; j++)
+        if (layer->type == "InnerProduct")
         {
-            ncnn::Mat out;
-            ex.extract(conv_bottom_blobs[j], out);
+            const ncnn::InnerProduct* innerproduct = (const ncnn::InnerProduct*)layer;
+
+            const int num_output = innerproduct->num_output;
+            const int weight_data_size_output = innerproduct->weight_data_size / num_output;
+
+            weight_scales[i].create(num_output);
 
-            // count absmax
+            for (int n = 0; n < num_output; n++)
             {
-                float absmax = 0.f;
+                const ncnn::Mat weight_data_n = innerproduct->weight_data.range(weight_data_size_output * n, weight_data_size_output);
 
-                const int outc = out.c;
-                const int outsize = out.w * out.h;
-                for (int p = 0; p < outc; p++)
+                float absmax = 0.f;
+                for (int k = 0; k < weight_data_size_output; k++)
                 {
-                    const float* ptr = out.channel(p);
-                    for (int k = 0; k < outsize; k++)
-                    {
-                        absmax = std::max(absmax, (float)fabs(ptr[k]));
-                    }
+                    absmax = std::max(absmax, (float)fabs(weight_data_n[k]));
                 }
 
-                #pragma omp critical
-                {
-                    QuantBlobStat& stat = quant_blob_stats[j];
-                    stat.absmax = std::max(stat.absmax, absmax);
-                }
+                weight_scales[i][n] = 127 / absmax;
             }
         }
+
+        if (layer->type == "Gemm")
+        {
+            weight_scales[i] = get_gemm_weight_scales((const ncnn::Gemm*)layer);
+        }
     }
 
+    // count the absmax
+    int ret = collect_blob_stats(CALIBRATION_METHOD_KL, CALIBRATION_ABSMAX, num_histogram_bins);
+    if (ret != 0)
+        return ret;
+
     // initialize histogram
     #pragma omp parallel for num_threads(quantize_num_threads)
     for (int i = 0; i < conv_bottom_blob_count; i++)
@@ -436,81 +1000,10 @@ int QuantNet::quantize_KL()
     }
 
     // build histogram
-    #pragma omp parallel for num_threads(quantize_num_threads) schedule(static, 1)
-    for (int i = 0; i < image_count; i++)
-    {
-        if (i % 100 == 0)
-        {
-            fprintf(stderr, "build histogram %.2f%% [ %d / %d ]\n", i * 100.f / image_count, i, image_count);
-        }
-
-        ncnn::Extractor ex = create_extractor();
-        ex.set_light_mode(true);
-
-        const int thread_num = ncnn::get_omp_thread_num();
-        ex.set_blob_allocator(&blob_allocators[thread_num]);
-        ex.set_workspace_allocator(&workspace_allocators[thread_num]);
-
-        for (int j = 0; j < input_blob_count; j++)
-        {
-            const int type_to_pixel = type_to_pixels[j];
-            const std::vector<float>& mean_vals = means[j];
-            const std::vector<float>& norm_vals = norms[j];
-
-            int pixel_convert_type = ncnn::Mat::PIXEL_BGR;
-            if (type_to_pixel != pixel_convert_type)
-            {
-                pixel_convert_type = pixel_convert_type | (type_to_pixel << ncnn::Mat::PIXEL_CONVERT_SHIFT);
-            }
-
-            ncnn::Mat in = read_and_resize_image(shapes[j], listspaths[j][i], pixel_convert_type);
-
-            in.substract_mean_normalize(mean_vals.data(), norm_vals.data());
-
-            ex.input(input_blobs[j], in);
-        }
-
-        for (int j = 0; j < conv_bottom_blob_count; j++)
-        {
-            ncnn::Mat out;
-            ex.extract(conv_bottom_blobs[j], out);
-
-            // count histogram bin
-            {
-                const float absmax = quant_blob_stats[j].absmax;
-
-                std::vector<uint64_t> histogram(num_histogram_bins, 0);
-
-                const int outc = out.c;
-                const int outsize = out.w * out.h;
-                for (int p = 0; p < outc; p++)
-                {
-                    const float* ptr = out.channel(p);
-                    for (int k = 0; k < outsize; k++)
-                    {
-                        if (ptr[k] == 0.f)
-                            continue;
-
-                        const int index = std::min((int)(fabs(ptr[k]) / absmax * num_histogram_bins), (num_histogram_bins - 1));
-
-                        histogram[index] += 1;
-                    }
-                }
-
-                #pragma omp critical
-                {
-                    QuantBlobStat& stat = quant_blob_stats[j];
-
-                    for (int k = 0; k < num_histogram_bins; k++)
-                    {
-                        stat.histogram[k] += histogram[k];
-                    }
-                }
-            }
-        }
-    }
+    ret = collect_blob_stats(CALIBRATION_METHOD_KL, CALIBRATION_HISTOGRAM, num_histogram_bins);
+    if (ret != 0)
+        return ret;
 
-    // using kld to find the best threshold value
     #pragma omp parallel for num_threads(quantize_num_threads)
     for (int i = 0; i < conv_bottom_blob_count; i++)
     {
@@ -717,13 +1210,8 @@ static float compute_aciq_gaussian_clip(float absmax, int N, int num_bits = 8)
 
 int QuantNet::quantize_ACIQ()
 {
-    const int input_blob_count = (int)input_blobs.size();
     const int conv_layer_count = (int)conv_layers.size();
     const int conv_bottom_blob_count = (int)conv_bottom_blobs.size();
-    const int image_count = (int)listspaths[0].size();
-
-    std::vector<ncnn::UnlockedPoolAllocator> blob_allocators(quantize_num_threads);
-    std::vector<ncnn::UnlockedPoolAllocator> workspace_allocators(quantize_num_threads);
 
     // initialize conv weight scales
     #pragma omp parallel for num_threads(quantize_num_threads)
@@ -825,73 +1313,18 @@ int QuantNet::quantize_ACIQ()
                 weight_scales[i][n] = 127 / threshold;
             }
         }
-    }
-
-    // count the absmax
-    #pragma omp parallel for num_threads(quantize_num_threads) schedule(static, 1)
-    for (int i = 0; i < image_count; i++)
-    {
-        if (i % 100 == 0)
-        {
-            fprintf(stderr, "count the absmax %.2f%% [ %d / %d ]\n", i * 100.f / image_count, i, image_count);
-        }
-
-        ncnn::Extractor ex = create_extractor();
-        ex.set_light_mode(true);
-
-        const int thread_num = ncnn::get_omp_thread_num();
-        ex.set_blob_allocator(&blob_allocators[thread_num]);
-        ex.set_workspace_allocator(&workspace_allocators[thread_num]);
-
-        for (int j = 0; j < input_blob_count; j++)
-        {
-            const int type_to_pixel = type_to_pixels[j];
-            const std::vector<float>& mean_vals = means[j];
-            const std::vector<float>& norm_vals = norms[j];
-
-            int pixel_convert_type = ncnn::Mat::PIXEL_BGR;
-            if (type_to_pixel != pixel_convert_type)
-            {
-                pixel_convert_type = pixel_convert_type | (type_to_pixel << ncnn::Mat::PIXEL_CONVERT_SHIFT);
-            }
-
-            ncnn::Mat in = read_and_resize_image(shapes[j], listspaths[j][i], pixel_convert_type);
-
-            in.substract_mean_normalize(mean_vals.data(), norm_vals.data());
-
-            ex.input(input_blobs[j], in);
-        }
 
-        for (int j = 0; j < conv_bottom_blob_count; j++)
+        if (layer->type == "Gemm")
         {
-            ncnn::Mat out;
-            ex.extract(conv_bottom_blobs[j], out);
-
-            // count absmax
-            {
-                float absmax = 0.f;
-
-                const int outc = out.c;
-                const int outsize = out.w * out.h;
-                for (int p = 0; p < outc; p++)
-                {
-                    const float* ptr = out.channel(p);
-                    for (int k = 0; k < outsize; k++)
-                    {
-                        absmax = std::max(absmax, (float)fabs(ptr[k]));
-                    }
-                }
-
-                #pragma omp critical
-                {
-                    QuantBlobStat& stat = quant_blob_stats[j];
-                    stat.absmax = std::max(stat.absmax, absmax);
-                    stat.total = outc * outsize;
-                }
-            }
+            weight_scales[i] = get_gemm_weight_scales((const ncnn::Gemm*)layer);
         }
     }
 
+    // count the absmax
+    int ret = collect_blob_stats(CALIBRATION_METHOD_ACIQ, CALIBRATION_ABSMAX, 0);
+    if (ret != 0)
+        return ret;
+
     // alpha gaussian
     #pragma omp parallel for num_threads(quantize_num_threads)
     for (int i = 0; i < conv_bottom_blob_count; i++)
@@ -993,6 +1426,25 @@ static int get_layer_param(const ncnn::Layer* layer, ncnn::ParamDict& pd)
         pd.set(9, innerproduct->activation_type);
         pd.set(10, innerproduct->activation_params);
     }
+    else if (layer->type == "Gemm")
+    {
+        ncnn::Gemm* gemm = (ncnn::Gemm*)layer;
+
+        pd.set(0, gemm->alpha);
+        pd.set(1, gemm->beta);
+        pd.set(2, gemm->transA);
+        pd.set(3, gemm->transB);
+        pd.set(4, gemm->constantA);
+        pd.set(5, gemm->constantB);
+        pd.set(6, gemm->constantC);
+        pd.set(7, gemm->constantM);
+        pd.set(8, gemm->constantN);
+        pd.set(9, gemm->constantK);
+        pd.set(10, gemm->constant_broadcast_type_C);
+        pd.set(11, gemm->output_N1M);
+        pd.set(14, gemm->output_transpose);
+        pd.set(18, gemm->int8_scale_term);
+    }
     else
     {
         fprintf(stderr, "unexpected layer type %s in get_layer_param\n", layer->type.c_str());
@@ -1025,6 +1477,16 @@ static int get_layer_weights(const ncnn::Layer* layer, std::vector<ncnn::Mat>& w
         if (innerproduct->bias_term)
             weights.push_back(innerproduct->bias_data);
     }
+    else if (layer->type == "Gemm")
+    {
+        ncnn::Gemm* gemm = (ncnn::Gemm*)layer;
+        if (gemm->constantA)
+            weights.push_back(gemm->A_data);
+        if (gemm->constantB)
+            weights.push_back(gemm->B_data);
+        if (gemm->constantC && gemm->constant_broadcast_type_C != -1)
+            weights.push_back(gemm->C_data);
+    }
     else
     {
         fprintf(stderr, "unexpected layer type %s in get_layer_weights\n", layer->type.c_str());
@@ -1037,7 +1499,9 @@ static int get_layer_weights(const ncnn::Layer* layer, std::vector<ncnn::Mat>& w
 int QuantNet::quantize_EQ()
 {
     // find the initial scale via KL
-    quantize_KL();
+    int ret = quantize_KL();
+    if (ret != 0)
+        return ret;
 
     print_quant_info();
 
@@ -1051,6 +1515,22 @@ int QuantNet::quantize_EQ()
     // max 50 images for EQ
     const int image_count = std::min((int)listspaths[0].size(), 50);
 
+    // every search step runs over the same images, decode them only once
+    std::vector<std::vector<ncnn::Mat> > image_inputs(image_count);
+    {
+        CalibrationLoader loader(this, 0, image_count, decode_num_threads, image_count);
+
+        std::vector<ncnn::Mat> inputs;
+        for (;;)
+        {
+            const int ii = loader.get(inputs);
+            if (ii < 0)
+                break;
+
+            image_inputs[ii] = inputs;
+        }
+    }
+
     const float scale_range_lower = 0.5f;
     const float scale_range_upper = 2.0f;
     const int search_steps = 100;
@@ -1080,6 +1560,10 @@ int QuantNet::quantize_EQ()
                     fprintf(stderr, "search weight scale %.2f%% [ %d / %d ] for %d / %d of %d / %d\n", ii * 100.f / image_count, ii, image_count, j, weight_scale.w, i, conv_layer_count);
                 }
 
+                // unreadable image
+                if (image_inputs[ii].empty())
+                    continue;
+
                 ncnn::Extractor ex = create_extractor();
                 ex.set_light_mode(true);
 
@@ -1089,21 +1573,7 @@ int QuantNet::quantize_EQ()
 
                 for (int jj = 0; jj < input_blob_count; jj++)
                 {
-                    const int type_to_pixel = type_to_pixels[jj];
-                    const std::vector<float>& mean_vals = means[jj];
-                    const std::vector<float>& norm_vals = norms[jj];
-
-                    int pixel_convert_type = ncnn::Mat::PIXEL_BGR;
-                    if (type_to_pixel != pixel_convert_type)
-                    {
-                        pixel_convert_type = pixel_convert_type | (type_to_pixel << ncnn::Mat::PIXEL_CONVERT_SHIFT);
-                    }
-
-                    ncnn::Mat in = read_and_resize_image(shapes[jj], listspaths[jj][ii], pixel_convert_type);
-
-                    in.substract_mean_normalize(mean_vals.data(), norm_vals.data());
-
-                    ex.input(input_blobs[jj], in);
+                    ex.input(input_blobs[jj], image_inputs[ii][jj]);
                 }
 
                 ncnn::Mat in;
@@ -1116,7 +1586,10 @@ int QuantNet::quantize_EQ()
 
                 ncnn::ParamDict pd;
                 get_layer_param(layer, pd);
-                pd.set(8, 1); //int8_scale_term
+                if (layer->type == "Gemm")
+                    pd.set(18, 3); //int8_scale_term
+                else
+                    pd.set(8, 1); //int8_scale_term
                 layer_int8->load_param(pd);
 
                 std::vector<float> sims(search_steps);
@@ -1190,6 +1663,10 @@ int QuantNet::quantize_EQ()
                     fprintf(stderr, "search bottom blob scale %.2f%% [ %d / %d ] for %d / %d of %d / %d\n", ii * 100.f / image_count, ii, image_count, j, bottom_blob_scale.w, i, conv_layer_count);
                 }
 
+                // unreadable image
+                if (image_inputs[ii].empty())
+                    continue;
+
                 ncnn::Extractor ex = create_extractor();
                 ex.set_light_mode(true);
 
@@ -1199,21 +1676,7 @@ int QuantNet::quantize_EQ()
 
                 for (int jj = 0; jj < input_blob_count; jj++)
                 {
-                    const int type_to_pixel = type_to_pixels[jj];
-                    const std::vector<float>& mean_vals = means[jj];
-                    const std::vector<float>& norm_vals = norms[jj];
-
-                    int pixel_convert_type = ncnn::Mat::PIXEL_BGR;
-                    if (type_to_pixel != pixel_convert_type)
-                    {
-                        pixel_convert_type = pixel_convert_type | (type_to_pixel << ncnn::Mat::PIXEL_CONVERT_SHIFT);
-                    }
-
-                    ncnn::Mat in = read_and_resize_image(shapes[jj], listspaths[jj][ii], pixel_convert_type);
-
-                    in.substract_mean_normalize(mean_vals.data(), norm_vals.data());
-
-                    ex.input(input_blobs[jj], in);
+                    ex.input(input_blobs[jj], image_inputs[ii][jj]);
                 }
 
                 ncnn::Mat in;
@@ -1226,7 +1689,10 @@ int QuantNet::quantize_EQ()
 
                 ncnn::ParamDict pd;
                 get_layer_param(layer, pd);
-                pd.set(8, 1); //int8_scale_term
+                if (layer->type == "Gemm")
+                    pd.set(18, 3); //int8_scale_term
+                else
+                    pd.set(8, 1); //int8_scale_term
                 layer_int8->load_param(pd);
 
                 std::vector<float> sims(search_steps);
@@ -1290,293 +1756,6 @@ int QuantNet::quantize_EQ()
     return 0;
 }
 
-static std::vector<std::vector<std::string> > parse_comma_path_list(char* s)
-{
-    std::vector<std::vector<std::string> > aps;
-
-    char* pch = strtok(s, ",");
-    while (pch != NULL)
-    {
-        FILE* fp = fopen(pch, "rb");
-        if (!fp)
-        {
-            fprintf(stderr, "fopen %s failed\n", pch);
-            break;
-        }
-
-        std::vector<std::string> paths;
-
-        // one filepath per line
-        char line[1024];
-        while (!feof(fp))
-        {
-            char* ss = fgets(line, 1024, fp);
-            if (!ss)
-                break;
-
-            char filepath[256];
-            int nscan = sscanf(line, "%255s", filepath);
-            if (nscan != 1)
-                continue;
-
-            paths.push_back(std::string(filepath));
-        }
-
-        fclose(fp);
-
-        aps.push_back(paths);
-
-        pch = strtok(NULL, ",");
-    }
-
-    return aps;
-}
-
-static float vstr_to_float(const char vstr[20])
-{
-    double v = 0.0;
-
-    const char* p = vstr;
-
-    // sign
-    bool sign = *p != '-';
-    if (*p == '+' || *p == '-')
-    {
-        p++;
-    }
-
-    // digits before decimal point or exponent
-    uint64_t v1 = 0;
-    while (isdigit(*p))
-    {
-        v1 = v1 * 10 + (*p - '0');
-        p++;
-    }
-
-    v = (double)v1;
-
-    // digits after decimal point
-    if (*p == '.')
-    {
-        p++;
-
-        uint64_t pow10 = 1;
-        uint64_t v2 = 0;
-
-        while (isdigit(*p))
-        {
-            v2 = v2 * 10 + (*p - '0');
-            pow10 *= 10;
-            p++;
-        }
-
-        v += v2 / (double)pow10;
-    }
-
-    // exponent
-    if (*p == 'e' || *p == 'E')
-    {
-        p++;
-
-        // sign of exponent
-        bool fact = *p != '-';
-        if (*p == '+' || *p == '-')
-        {
-            p++;
-        }
-
-        // digits of exponent
-        uint64_t expon = 0;
-        while (isdigit(*p))
-        {
-            expon = expon * 10 + (*p - '0');
-            p++;
-        }
-
-        double scale = 1.0;
-        while (expon >= 8)
-        {
-            scale *= 1e8;
-            expon -= 8;
-        }
-        while (expon > 0)
-        {
-            scale *= 10.0;
-            expon -= 1;
-        }
-
-        v = fact ? v * scale : v / scale;
-    }
-
-    //     fprintf(stderr, "v = %f\n", v);
-    return sign ? (float)v : (float)-v;
-}
-
-static std::vector<std::vector<float> > parse_comma_float_array_list(char* s)
-{
-    std::vector<std::vector<float> > aaf;
-
-    char* pch = strtok(s, "[]");
-    while (pch != NULL)
-    {
-        // parse a,b,c
-        char vstr[20];
-        int nconsumed = 0;
-        int nscan = sscanf(pch, "%19[^,]%n", vstr, &nconsumed);
-        if (nscan == 1)
-        {
-            // ok we get array
-            pch += nconsumed;
-
-            std::vector<float> af;
-            float v = vstr_to_float(vstr);
-            af.push_back(v);
-
-            nscan = sscanf(pch, ",%19[^,]%n", vstr, &nconsumed);
-            while (nscan == 1)
-            {
-                pch += nconsumed;
-
-                float v = vstr_to_float(vstr);
-                af.push_back(v);
-
-                nscan = sscanf(pch, ",%19[^,]%n", vstr, &nconsumed);
-            }
-
-            // array end
-            aaf.push_back(af);
-        }
-
-        pch = strtok(NULL, "[]");
-    }
-
-    return aaf;
-}
-
-static std::vector<std::vector<int> > parse_comma_int_array_list(char* s)
-{
-    std::vector<std::vector<int> > aai;
-
-    char* pch = strtok(s, "[]");
-    while (pch != NULL)
-    {
-        // parse a,b,c
-        int v;
-        int nconsumed = 0;
-        int nscan = sscanf(pch, "%d%n", &v, &nconsumed);
-        if (nscan == 1)
-        {
-            // ok we get array
-            pch += nconsumed;
-
-            std::vector<int> ai;
-            ai.push_back(v);
-
-            nscan = sscanf(pch, ",%d%n", &v, &nconsumed);
-            while (nscan == 1)
-            {
-                pch += nconsumed;
-
-                ai.push_back(v);
-
-                nscan = sscanf(pch, ",%d%n", &v, &nconsumed);
-            }
-
-            // array end
-            aai.push_back(ai);
-        }
-
-        pch = strtok(NULL, "[]");
-    }
-
-    return aai;
-}
-
-static std::vector<int> parse_comma_pixel_type_list(char* s)
-{
-    std::vector<int> aps;
-
-    char* pch = strtok(s, ",");
-    while (pch != NULL)
-    {
-        // RAW/RGB/BGR/GRAY/RGBA/BGRA
-        if (strcmp(pch, "RAW") == 0)
-            aps.push_back(-233);
-        if (strcmp(pch, "RGB") == 0)
-            aps.push_back(ncnn::Mat::PIXEL_RGB);
-        if (strcmp(pch, "BGR") == 0)
-            aps.push_back(ncnn::Mat::PIXEL_BGR);
-        if (strcmp(pch, "GRAY") == 0)
-            aps.push_back(ncnn::Mat::PIXEL_GRAY);
-        if (strcmp(pch, "RGBA") == 0)
-            aps.push_back(ncnn::Mat::PIXEL_RGBA);
-        if (strcmp(pch, "BGRA") == 0)
-            aps.push_back(ncnn::Mat::PIXEL_BGRA);
-
-        pch = strtok(NULL, ",");
-    }
-
-    return aps;
-}
-
-static void print_float_array_list(const std::vector<std::vector<float> >& list)
-{
-    for (size_t i = 0; i < list.size(); i++)
-    {
-        const std::vector<float>& array = list[i];
-        fprintf(stderr, "[");
-        for (size_t j = 0; j < array.size(); j++)
-        {
-            fprintf(stderr, "%f", array[j]);
-            if (j != array.size() - 1)
-                fprintf(stderr, ",");
-        }
-        fprintf(stderr, "]");
-        if (i != list.size() - 1)
-            fprintf(stderr, ",");
-    }
-}
-
-static void print_int_array_list(const std::vector<std::vector<int> >& list)
-{
-    for (size_t i = 0; i < list.size(); i++)
-    {
-        const std::vector<int>& array = list[i];
-        fprintf(stderr, "[");
-        for (size_t j = 0; j < array.size(); j++)
-        {
-            fprintf(stderr, "%d", array[j]);
-            if (j != array.size() - 1)
-                fprintf(stderr, ",");
-        }
-        fprintf(stderr, "]");
-        if (i != list.size() - 1)
-            fprintf(stderr, ",");
-    }
-}
-
-static void print_pixel_type_list(const std::vector<int>& list)
-{
-    for (size_t i = 0; i < list.size(); i++)
-    {
-        const int type = list[i];
-        if (type == -233)
-            fprintf(stderr, "RAW");
-        if (type == ncnn::Mat::PIXEL_RGB)
-            fprintf(stderr, "RGB");
-        if (type == ncnn::Mat::PIXEL_BGR)
-            fprintf(stderr, "BGR");
-        if (type == ncnn::Mat::PIXEL_GRAY)
-            fprintf(stderr, "GRAY");
-        if (type == ncnn::Mat::PIXEL_RGBA)
-            fprintf(stderr, "RGBA");
-        if (type == ncnn::Mat::PIXEL_BGRA)
-            fprintf(stderr, "BGRA");
-        if (i != list.size() - 1)
-            fprintf(stderr, ",");
-    }
-}
-
 static void show_usage()
 {
     fprintf(stderr, "Usage: ncnn2table [ncnnparam] [ncnnbin] [list,...] [ncnntable] [(key=value)...]\n");
@@ -1586,6 +1765,9 @@ static void show_usage()
     fprintf(stderr, "  pixel=RAW/RGB/BGR/GRAY/RGBA/BGRA,...\n");
     fprintf(stderr, "  thread=8\n");
     fprintf(stderr, "  method=kl/aciq/eq\n");
+    fprintf(stderr, "  decode=2 **number of image decoding threads, 0 decodes on the forward threads\n");
+    fprintf(stderr, "  checkpoint=calib.ckpt **save and resume the kl/aciq statistics\n");
+    fprintf(stderr, "  checkpoint_interval=500\n");
     fprintf(stderr, "Sample usage: ncnn2table squeezenet.param squeezenet.bin imagelist.txt squeezenet.table mean=[104.0,117.0,123.0] norm=[1.0,1.0,1.0] shape=[227,227,3] pixel=BGR method=kl\n");
 }
 
@@ -1660,6 +1842,12 @@ int main(int argc, char** argv)
             net.quantize_num_threads = atoi(value);
         if (memcmp(key, "method", 6) == 0)
             method = std::string(value);
+        if (memcmp(key, "decode", 6) == 0)
+            net.decode_num_threads = atoi(value);
+        if (strcmp(key, "checkpoint") == 0)
+            net.checkpoint_path = std::string(value);
+        if (strcmp(key, "checkpoint_interval") == 0)
+            net.checkpoint_interval = atoi(value);
     }
 
     // sanity check
@@ -1694,6 +1882,16 @@ int main(int argc, char** argv)
         fprintf(stderr, "malformed thread %d\n", net.quantize_num_threads);
         return -1;
     }
+    if (net.decode_num_threads < 0)
+    {
+        fprintf(stderr, "malformed decode %d\n", net.decode_num_threads);
+        return -1;
+    }
+    if (net.checkpoint_interval <= 0)
+    {
+        fprintf(stderr, "malformed checkpoint_interval %d\n", net.checkpoint_interval);
+        return -1;
+    }
 
     // print quantnet config
     {
@@ -1711,20 +1909,24 @@ int main(int argc, char** argv)
         fprintf(stderr, "\n");
         fprintf(stderr, "thread = %d\n", net.quantize_num_threads);
         fprintf(stderr, "method = %s\n", method.c_str());
+        fprintf(stderr, "decode = %d\n", net.decode_num_threads);
+        if (!net.checkpoint_path.empty())
+            fprintf(stderr, "checkpoint = %s every %d images\n", net.checkpoint_path.c_str(), net.checkpoint_interval);
         fprintf(stderr, "---------------------------------------\n");
     }
 
+    int ret = 0;
     if (method == "kl")
     {
-        net.quantize_KL();
+        ret = net.quantize_KL();
     }
     else if (method == "aciq")
     {
-        net.quantize_ACIQ();
+        ret = net.quantize_ACIQ();
     }
     else if (method == "eq")
     {
-        net.quantize_EQ();
+        ret = net.quantize_EQ();
     }
     else
     {
@@ -1733,6 +1935,12 @@ int main(int argc, char** argv)
         return -1;
     }
 
+    if (ret != 0)
+    {
+        fprintf(stderr, "quantize failed\n");
+        return -1;
+    }
+
     net.print_quant_info();
 
     net.save_table(outtable);
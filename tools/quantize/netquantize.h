@@ -0,0 +1,54 @@
+// BUG1989 is pleased to support the open source community by supporting ncnn available.
+//
+// Copyright (C) 2019 BUG1989. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef NCNN_NETQUANTIZE_H
+#define NCNN_NETQUANTIZE_H
+
+#include <map>
+#include <string>
+
+// ncnn public header
+#include "mat.h"
+
+// ncnn private header
+#include "../modelwriter.h"
+
+// parse the blob and weight scales written by ncnn2table
+// return true if success
+bool read_int8scale_table(const char* filepath, std::map<std::string, ncnn::Mat>& blob_int8scale_table, std::map<std::string, ncnn::Mat>& weight_int8scale_table);
+
+class NetQuantize : public ModelWriter
+{
+public:
+    NetQuantize();
+
+    std::map<std::string, ncnn::Mat> blob_int8scale_table;
+    std::map<std::string, ncnn::Mat> weight_int8scale_table;
+
+public:
+    int quantize_convolution();
+    int quantize_convolutiondepthwise();
+    int quantize_innerproduct();
+    int quantize_gemm();
+
+    int quantize_rnn();
+    int quantize_lstm();
+    int quantize_gru();
+
+    int quantize_embed();
+
+    int fuse_requantize();
+};
+
+#endif // NCNN_NETQUANTIZE_H